@@ -57,7 +57,7 @@ void ezGizmoRenderer::RenderBatch(
   ezResourceLock<ezMeshResource> pMesh(hMesh, ezResourceAcquireMode::AllowLoadingFallback);
 
   // This can happen when the resource has been reloaded and now has fewer submeshes.
-  const auto& subMeshes = pMesh->GetSubMeshes();
+  const auto& subMeshes = pMesh->GetAllSubMeshes();
   if (subMeshes.GetCount() <= uiSubMeshIndex)
   {
     return;
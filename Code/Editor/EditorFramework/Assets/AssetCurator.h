@@ -123,11 +123,19 @@ struct EZ_EDITORFRAMEWORK_DLL ezFileStatus
   ezFileStatus()
   {
     m_uiHash = 0;
+    m_uiFileSize = 0;
     m_Status = Status::Unknown;
   }
 
+  /// \brief Returns whether the stored hash still describes a file with the given modification time and size.
+  bool IsUpToDate(const ezTimestamp& timestamp, ezUInt64 uiFileSize) const
+  {
+    return m_Timestamp.Compare(timestamp, ezTimestamp::CompareMode::Identical) && m_uiFileSize == uiFileSize;
+  }
+
   ezTimestamp m_Timestamp;
   ezUInt64 m_uiHash;
+  ezUInt64 m_uiFileSize;
   ezUuid m_AssetGuid; ///< If the file is linked to an asset, the GUID is valid, otherwise not.
   Status m_Status;
 };
@@ -166,6 +174,12 @@ public:
   void WaitForInitialize();
   void Deinitialize();
 
+  /// \brief By default the curator cache is only written by the editor, not by headless processors.
+  ///
+  /// Standalone processors that are the only ones operating on a project (e.g. 'EditorProcessor -transform')
+  /// can enable this, so that subsequent runs start with a warm cache and don't need to re-hash unchanged files.
+  void SetWriteCachesInHeadlessMode(bool bEnable) { m_bWriteCachesInHeadlessMode = bEnable; }
+
   void MainThreadTick(bool bTopLevel);
 
   ///@}
@@ -368,6 +382,10 @@ private:
   void RemoveStaleFileInfos();
   static void BuildFileExtensionSet(ezSet<ezString>& AllExtensions);
   void IterateDataDirectory(const char* szDataDir, ezSet<ezString>* pFoundFiles = nullptr);
+  /// \brief Reads the document info of all given asset files that are not up to date yet in parallel and stores them in the serialized cache.
+  void PrefetchAssetDocumentInfos(const ezDynamicArray<std::pair<ezString, ezFileStats>>& files);
+  /// \brief Hashes all tracked dependency and reference files that have no valid hash yet in parallel. The curator is not locked while the files are read.
+  void HashTrackedFiles();
   void LoadCaches();
   void SaveCaches();
 
@@ -408,6 +426,7 @@ private:
   mutable ezCuratorMutex m_CachedAssetsMutex; ///< Only locks m_CachedAssets
   ezMap<ezString, ezUniquePtr<ezAssetDocumentInfo>> m_CachedAssets;
   ezMap<ezString, ezFileStatus> m_CachedFiles;
+  bool m_bWriteCachesInHeadlessMode = false;
 
   // Immutable data after StartInitialize
   ezApplicationFileSystemConfig m_FileSystemConfig;
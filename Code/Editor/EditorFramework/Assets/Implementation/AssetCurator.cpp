@@ -20,7 +20,7 @@
 #include <atomic>
 
 #define EZ_CURATOR_CACHE_VERSION 2
-#define EZ_CURATOR_CACHE_FILE_VERSION 6
+#define EZ_CURATOR_CACHE_FILE_VERSION 7
 
 EZ_IMPLEMENT_SINGLETON(ezAssetCurator);
 
@@ -55,12 +55,13 @@ EZ_END_SUBSYSTEM_DECLARATION;
 // clang-format on
 
 // clang-format off
-EZ_BEGIN_STATIC_REFLECTED_TYPE(ezFileStatus, ezNoBase, 3, ezRTTIDefaultAllocator<ezFileStatus>)
+EZ_BEGIN_STATIC_REFLECTED_TYPE(ezFileStatus, ezNoBase, 4, ezRTTIDefaultAllocator<ezFileStatus>)
 {
   EZ_BEGIN_PROPERTIES
   {
     EZ_MEMBER_PROPERTY("Timestamp", m_Timestamp),
     EZ_MEMBER_PROPERTY("Hash", m_uiHash),
+    EZ_MEMBER_PROPERTY("FileSize", m_uiFileSize),
     EZ_MEMBER_PROPERTY("AssetGuid", m_AssetGuid),
   }
   EZ_END_PROPERTIES;
@@ -1020,23 +1021,31 @@ void ezAssetCurator::CheckFileSystem()
   // make sure the hashing task has finished
   ShutdownUpdateTask();
 
-  EZ_LOCK(m_CuratorMutex);
+  {
+    EZ_LOCK(m_CuratorMutex);
 
-  SetAllAssetStatusUnknown();
+    SetAllAssetStatusUnknown();
 
-  // check every data directory
-  for (auto& dd : m_FileSystemConfig.m_DataDirs)
-  {
-    ezStringBuilder sTemp;
-    ezFileSystem::ResolveSpecialDirectory(dd.m_sDataDirSpecialPath, sTemp);
+    // check every data directory
+    for (auto& dd : m_FileSystemConfig.m_DataDirs)
+    {
+      ezStringBuilder sTemp;
+      ezFileSystem::ResolveSpecialDirectory(dd.m_sDataDirSpecialPath, sTemp);
 
-    if (ezThreadUtils::IsMainThread())
-      range->BeginNextStep(dd.m_sDataDirSpecialPath);
+      if (ezThreadUtils::IsMainThread())
+        range->BeginNextStep(dd.m_sDataDirSpecialPath);
 
-    IterateDataDirectory(sTemp);
+      IterateDataDirectory(sTemp);
+    }
+
+    RemoveStaleFileInfos();
   }
 
-  RemoveStaleFileInfos();
+  // On a cold cache this is where most of the file reads happen, do them all at once instead of one by one on the update task.
+  // This only locks the curator to gather the files and to store the results.
+  HashTrackedFiles();
+
+  EZ_LOCK(m_CuratorMutex);
 
   if (ezThreadUtils::IsMainThread())
   {
@@ -1306,7 +1315,7 @@ void ezAssetCurator::HandleSingleFile(const ezString& sAbsolutePath, const ezFil
   // mark the file as valid (i.e. we saw it on disk, so it hasn't been deleted or such)
   RefFile.m_Status = ezFileStatus::Status::Valid;
 
-  bool fileChanged = !RefFile.m_Timestamp.Compare(FileStat.m_LastModificationTime, ezTimestamp::CompareMode::Identical);
+  bool fileChanged = !RefFile.IsUpToDate(FileStat.m_LastModificationTime, FileStat.m_uiFileSize);
   if (fileChanged)
   {
     RefFile.m_Timestamp.Invalidate();
@@ -1664,6 +1673,7 @@ void ezAssetCurator::IterateDataDirectory(const char* szDataDir, ezSet<ezString>
     return;
 
   ezStringBuilder sPath;
+  ezDynamicArray<std::pair<ezString, ezFileStats>> files;
 
   while (true)
   {
@@ -1681,15 +1691,23 @@ void ezAssetCurator::IterateDataDirectory(const char* szDataDir, ezSet<ezString>
     sPath.AppendPath(iterator.GetStats().m_sName);
     sPath.MakeCleanPath();
 
-    HandleSingleFile(sPath, iterator.GetStats());
-    if (pFoundFiles)
-    {
-      pFoundFiles->Insert(sPath);
-    }
+    files.PushBack(std::make_pair(ezString(sPath), iterator.GetStats()));
 
     if (iterator.Next().Failed())
       break;
   }
+
+  // read all new and modified assets in parallel, HandleSingleFile will then pick up the results from the serialized cache
+  PrefetchAssetDocumentInfos(files);
+
+  for (const auto& file : files)
+  {
+    HandleSingleFile(file.first, file.second);
+    if (pFoundFiles)
+    {
+      pFoundFiles->Insert(file.first);
+    }
+  }
 }
 
 void ezAssetCurator::LoadCaches()
@@ -1786,11 +1804,14 @@ void ezAssetCurator::LoadCaches()
 void ezAssetCurator::SaveCaches()
 {
   EZ_PROFILE_SCOPE("SaveCaches");
-  m_CachedAssets.Clear();
-  m_CachedFiles.Clear();
+  {
+    EZ_LOCK(m_CachedAssetsMutex);
+    m_CachedAssets.Clear();
+    m_CachedFiles.Clear();
+  }
 
-  // Do not save cache on processors.
-  if (ezQtUiServices::IsHeadless())
+  // Do not save cache on processors, unless they are the only ones working on the project.
+  if (ezQtUiServices::IsHeadless() && !m_bWriteCachesInHeadlessMode)
     return;
 
   EZ_LOCK(m_CuratorMutex);
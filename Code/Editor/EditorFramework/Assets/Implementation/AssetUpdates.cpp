@@ -4,7 +4,9 @@
 #include <EditorFramework/Assets/AssetDocumentManager.h>
 #include <EditorFramework/EditorApp/EditorApp.moc.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/IO/OSFile.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <GuiFoundation/UIServices/ImageCache.moc.h>
 
 ////////////////////////////////////////////////////////////////////////
@@ -110,7 +112,7 @@ bool ezAssetCurator::AddAssetHash(ezString& sPath, bool bIsReference, ezUInt64&
   }
 
   // if the file has been modified, make sure to get updated data
-  if (!fileStatus.m_Timestamp.Compare(statDep.m_LastModificationTime, ezTimestamp::CompareMode::Identical))
+  if (!fileStatus.IsUpToDate(statDep.m_LastModificationTime, statDep.m_uiFileSize))
   {
     CURATOR_PROFILE(sPath);
     ezFileReader file;
@@ -120,6 +122,7 @@ bool ezAssetCurator::AddAssetHash(ezString& sPath, bool bIsReference, ezUInt64&
       return false;
     }
     fileStatus.m_Timestamp = statDep.m_LastModificationTime;
+    fileStatus.m_uiFileSize = statDep.m_uiFileSize;
     fileStatus.m_uiHash = ezAssetCurator::HashFile(file, nullptr);
     fileStatus.m_Status = ezFileStatus::Status::Valid;
   }
@@ -193,7 +196,7 @@ ezResult ezAssetCurator::EnsureAssetInfoUpdated(const char* szAbsFilePath)
   {
     // If the file stat matches our stored timestamp, we are still up to date.
     EZ_LOCK(m_CuratorMutex);
-    if (m_ReferencedFiles[szAbsFilePath].m_Timestamp.Compare(fs.m_LastModificationTime, ezTimestamp::CompareMode::Identical))
+    if (m_ReferencedFiles[szAbsFilePath].IsUpToDate(fs.m_LastModificationTime, fs.m_uiFileSize))
       return EZ_SUCCESS;
   }
 
@@ -441,33 +444,29 @@ ezResult ezAssetCurator::ReadAssetDocumentInfo(const char* szAbsFilePath, ezFile
   if (ezOSFile::GetFileStats(szAbsFilePath, fs).Failed())
     return EZ_FAILURE;
   stat.m_Timestamp = fs.m_LastModificationTime;
+  stat.m_uiFileSize = fs.m_uiFileSize;
   stat.m_Status = ezFileStatus::Status::Valid;
 
-  // try to read the asset file
-  ezFileReader file;
-  if (file.Open(szAbsFilePath) == EZ_FAILURE)
-  {
-    stat.m_Timestamp.Invalidate();
-    stat.m_uiHash = 0;
-    stat.m_Status = ezFileStatus::Status::FileLocked;
-
-    ezLog::Error("Failed to open asset file '{0}'", szAbsFilePath);
-    return EZ_FAILURE;
-  }
-
-  out_assetInfo = EZ_DEFAULT_NEW(ezAssetInfo);
+  // if the serialized cache has data for this exact file, we don't need to touch the file at all
   ezUniquePtr<ezAssetDocumentInfo> docInfo;
-  auto itFile = m_CachedFiles.Find(szAbsFilePath);
   {
     EZ_LOCK(m_CachedAssetsMutex);
+    auto itFile = m_CachedFiles.Find(szAbsFilePath);
     auto itAsset = m_CachedAssets.Find(szAbsFilePath);
-    if (itAsset.IsValid())
+    if (itFile.IsValid() && itAsset.IsValid() && itFile.Value().IsUpToDate(stat.m_Timestamp, stat.m_uiFileSize))
     {
       docInfo = std::move(itAsset.Value());
-      m_CachedAssets.Remove(itAsset);
+      stat.m_uiHash = itFile.Value().m_uiHash;
     }
+
+    if (itAsset.IsValid())
+      m_CachedAssets.Remove(itAsset);
+    if (itFile.IsValid())
+      m_CachedFiles.Remove(itFile);
   }
 
+  out_assetInfo = EZ_DEFAULT_NEW(ezAssetInfo);
+
   // update the paths
   {
     ezStringBuilder sDataDir = GetSingleton()->FindDataDirectoryForAsset(szAbsFilePath);
@@ -494,45 +493,239 @@ ezResult ezAssetCurator::ReadAssetDocumentInfo(const char* szAbsFilePath, ezFile
     }
   }
 
+  if (docInfo)
+  {
+    out_assetInfo->m_Info = std::move(docInfo);
+    stat.m_AssetGuid = out_assetInfo->m_Info->m_DocumentID;
+    return EZ_SUCCESS;
+  }
+
+  // try to read the asset file
+  ezFileReader file;
+  if (file.Open(szAbsFilePath) == EZ_FAILURE)
+  {
+    stat.m_Timestamp.Invalidate();
+    stat.m_uiHash = 0;
+    stat.m_Status = ezFileStatus::Status::FileLocked;
+
+    ezLog::Error("Failed to open asset file '{0}'", szAbsFilePath);
+    return EZ_FAILURE;
+  }
+
   ezMemoryStreamStorage storage;
   ezMemoryStreamReader MemReader(&storage);
   MemReader.SetDebugSourceInformation(out_assetInfo->m_sAbsolutePath);
 
   ezMemoryStreamWriter MemWriter(&storage);
 
-  if (docInfo && itFile.IsValid() && itFile.Value().m_Timestamp.Compare(stat.m_Timestamp, ezTimestamp::CompareMode::Identical))
-  {
-    stat.m_uiHash = itFile.Value().m_uiHash;
-  }
-  else
-  {
-    // compute the hash for the asset file
-    stat.m_uiHash = ezAssetCurator::HashFile(file, &MemWriter);
-  }
+  // compute the hash for the asset file
+  stat.m_uiHash = ezAssetCurator::HashFile(file, &MemWriter);
   file.Close();
 
   // and finally actually read the asset file (header only) and store the information in the ezAssetDocumentInfo member
-  if (docInfo && itFile.IsValid() && itFile.Value().m_Timestamp.Compare(stat.m_Timestamp, ezTimestamp::CompareMode::Identical))
+  ezStatus ret = out_assetInfo->GetManager()->ReadAssetDocumentInfo(out_assetInfo->m_Info, MemReader);
+  if (ret.Failed())
   {
-    out_assetInfo->m_Info = std::move(docInfo);
-    stat.m_AssetGuid = out_assetInfo->m_Info->m_DocumentID;
+    ezLog::Error("Failed to read asset document info for asset file '{0}'", szAbsFilePath);
+    return EZ_FAILURE;
   }
-  else
+  EZ_ASSERT_DEV(out_assetInfo->m_Info != nullptr, "Info should be valid on suceess.");
+
+  // here we get the GUID out of the document
+  // this links the 'file' to the 'asset'
+  stat.m_AssetGuid = out_assetInfo->m_Info->m_DocumentID;
+
+  return EZ_SUCCESS;
+}
+
+void ezAssetCurator::PrefetchAssetDocumentInfos(const ezDynamicArray<std::pair<ezString, ezFileStats>>& files)
+{
+  CURATOR_PROFILE("PrefetchAssetDocumentInfos");
+
+  struct PrefetchItem
   {
-    ezStatus ret = out_assetInfo->GetManager()->ReadAssetDocumentInfo(out_assetInfo->m_Info, MemReader);
-    if (ret.Failed())
+    const ezString* m_pPath = nullptr;
+    const ezFileStats* m_pStats = nullptr;
+    const ezAssetDocumentManager* m_pManager = nullptr;
+    ezFileStatus m_Status;
+    ezUniquePtr<ezAssetDocumentInfo> m_pInfo;
+  };
+
+  ezDynamicArray<PrefetchItem> items;
+  {
+    EZ_LOCK(m_CuratorMutex);
+    EZ_LOCK(m_CachedAssetsMutex);
+
+    ezStringBuilder sExt;
+    for (const auto& file : files)
     {
-      ezLog::Error("Failed to read asset document info for asset file '{0}'", szAbsFilePath);
-      return EZ_FAILURE;
+      const ezString& sPath = file.first;
+      const ezFileStats& stats = file.second;
+
+      // same filter as HandleSingleFile: assets are never inside an AssetCache folder
+      const char* szNeedle = sPath.FindSubString("AssetCache/");
+      if (szNeedle != nullptr && sPath.GetData() != szNeedle && szNeedle[-1] == '/')
+        continue;
+
+      sExt = ezPathUtils::GetFileExtension(sPath);
+      sExt.ToLower();
+      if (!m_ValidAssetExtensions.Contains(sExt))
+        continue;
+
+      const ezFileStatus* pRefFile = m_ReferencedFiles.GetValue(sPath);
+      if (pRefFile != nullptr && pRefFile->m_AssetGuid.IsValid() && pRefFile->IsUpToDate(stats.m_LastModificationTime, stats.m_uiFileSize))
+        continue;
+
+      const ezFileStatus* pCachedFile = m_CachedFiles.GetValue(sPath);
+      if (pCachedFile != nullptr && m_CachedAssets.Contains(sPath) && pCachedFile->IsUpToDate(stats.m_LastModificationTime, stats.m_uiFileSize))
+        continue;
+
+      const ezDocumentTypeDescriptor* pTypeDesc = nullptr;
+      if (ezDocumentManager::FindDocumentTypeFromPath(sPath, false, pTypeDesc).Failed())
+        continue;
+
+      auto& item = items.ExpandAndGetRef();
+      item.m_pPath = &sPath;
+      item.m_pStats = &stats;
+      item.m_pManager = static_cast<const ezAssetDocumentManager*>(pTypeDesc->m_pManager);
     }
-    EZ_ASSERT_DEV(out_assetInfo->m_Info != nullptr, "Info should be valid on suceess.");
+  }
 
-    // here we get the GUID out of the document
-    // this links the 'file' to the 'asset'
-    stat.m_AssetGuid = out_assetInfo->m_Info->m_DocumentID;
+  // a single file is not worth the task overhead, EnsureAssetInfoUpdated will read it directly
+  if (items.GetCount() < 2)
+    return;
+
+  ezTaskSystem::ParallelForIndexed(
+    0, items.GetCount(),
+    [&items](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        PrefetchItem& item = items[i];
+
+        ezFileReader file;
+        if (file.Open(*item.m_pPath).Failed())
+          continue;
+
+        ezMemoryStreamStorage storage;
+        ezMemoryStreamReader MemReader(&storage);
+        MemReader.SetDebugSourceInformation(*item.m_pPath);
+        ezMemoryStreamWriter MemWriter(&storage);
+
+        item.m_Status.m_uiHash = ezAssetCurator::HashFile(file, &MemWriter);
+        file.Close();
+
+        if (item.m_pManager->ReadAssetDocumentInfo(item.m_pInfo, MemReader).Failed())
+        {
+          // leave the error reporting to the regular code path
+          item.m_pInfo.Clear();
+          continue;
+        }
+
+        item.m_Status.m_Timestamp = item.m_pStats->m_LastModificationTime;
+        item.m_Status.m_uiFileSize = item.m_pStats->m_uiFileSize;
+        item.m_Status.m_AssetGuid = item.m_pInfo->m_DocumentID;
+        item.m_Status.m_Status = ezFileStatus::Status::Valid;
+      }
+    },
+    "PrefetchAssetDocumentInfos");
+
+  EZ_LOCK(m_CachedAssetsMutex);
+  for (PrefetchItem& item : items)
+  {
+    if (item.m_pInfo == nullptr)
+      continue;
+
+    m_CachedFiles[*item.m_pPath] = item.m_Status;
+    m_CachedAssets[*item.m_pPath] = std::move(item.m_pInfo);
   }
+}
 
-  return EZ_SUCCESS;
+void ezAssetCurator::HashTrackedFiles()
+{
+  CURATOR_PROFILE("HashTrackedFiles");
+
+  struct HashItem
+  {
+    ezString m_sPath;
+    ezFileStatus m_NewStatus;
+  };
+
+  ezDynamicArray<HashItem> items;
+
+  // only gather the files under the lock, reading them would block every other curator access for the whole time
+  {
+    EZ_LOCK(m_CuratorMutex);
+
+    ezHashSet<ezString> visited;
+    auto addTrackedFiles = [&](const ezMap<ezString, ezHybridArray<ezUuid, 1>>& inverseTracker) {
+      for (auto it = inverseTracker.GetIterator(); it.IsValid(); ++it)
+      {
+        if (it.Value().IsEmpty())
+          continue;
+
+        // asset outputs are tracked for invalidation only, they never contribute to a hash
+        const char* szNeedle = it.Key().FindSubString("AssetCache/");
+        if (szNeedle != nullptr && it.Key().GetData() != szNeedle && szNeedle[-1] == '/')
+          continue;
+
+        auto itFile = m_ReferencedFiles.Find(it.Key());
+        if (!itFile.IsValid() || itFile.Value().m_Status != ezFileStatus::Status::Valid || itFile.Value().m_AssetGuid.IsValid() || itFile.Value().m_Timestamp.IsValid())
+          continue;
+
+        // files can be tracked as dependency and reference at the same time
+        if (visited.Insert(it.Key()))
+          continue;
+
+        auto& item = items.ExpandAndGetRef();
+        item.m_sPath = itFile.Key();
+      }
+    };
+
+    addTrackedFiles(m_InverseDependency);
+    addTrackedFiles(m_InverseReferences);
+  }
+
+  if (items.IsEmpty())
+    return;
+
+  ezTaskSystem::ParallelForIndexed(
+    0, items.GetCount(),
+    [&items](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        HashItem& item = items[i];
+
+        ezFileStats stats;
+        if (ezOSFile::GetFileStats(item.m_sPath, stats).Failed())
+          continue;
+
+        ezFileReader file;
+        if (file.Open(item.m_sPath).Failed())
+          continue;
+
+        item.m_NewStatus.m_Timestamp = stats.m_LastModificationTime;
+        item.m_NewStatus.m_uiFileSize = stats.m_uiFileSize;
+        item.m_NewStatus.m_uiHash = ezAssetCurator::HashFile(file, nullptr);
+      }
+    },
+    "HashTrackedFiles");
+
+  EZ_LOCK(m_CuratorMutex);
+
+  for (const HashItem& item : items)
+  {
+    if (!item.m_NewStatus.m_Timestamp.IsValid())
+      continue;
+
+    // Same as in AddAssetHash: only store the result if nobody else updated or removed the entry in the meantime.
+    auto itFile = m_ReferencedFiles.Find(item.m_sPath);
+    if (!itFile.IsValid() || itFile.Value().m_Status != ezFileStatus::Status::Valid || itFile.Value().m_Timestamp.IsValid())
+      continue;
+
+    itFile.Value().m_Timestamp = item.m_NewStatus.m_Timestamp;
+    itFile.Value().m_uiFileSize = item.m_NewStatus.m_uiFileSize;
+    itFile.Value().m_uiHash = item.m_NewStatus.m_uiHash;
+  }
 }
 
 void ezAssetCurator::UpdateSubAssets(ezAssetInfo& assetInfo)
@@ -134,6 +134,8 @@ public:
 
     if (!ezStringUtils::IsNullOrEmpty(ezCommandLineUtils::GetGlobalInstance()->GetStringOption("-transform")))
     {
+      // we are the only process working on this project, so keep the curator cache warm for the next run
+      ezAssetCurator::GetSingleton()->SetWriteCachesInHeadlessMode(true);
       ezQtEditorApp::GetSingleton()->OpenProject(sProject);
 
       bool bTransform = true;
@@ -11,7 +11,7 @@
 #include <RendererCore/Meshes/MeshResourceDescriptor.h>
 
 // clang-format off
-EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezMeshAssetDocument, 10, ezRTTINoAllocator)
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezMeshAssetDocument, 12, ezRTTINoAllocator)
 EZ_END_DYNAMIC_REFLECTED_TYPE;
 // clang-format on
 
@@ -33,7 +33,7 @@ ezMeshAssetDocument::ezMeshAssetDocument(const char* szDocumentPath)
 ezStatus ezMeshAssetDocument::InternalTransformAsset(ezStreamWriter& stream, const char* szOutputTag,
   const ezPlatformProfile* pAssetProfile, const ezAssetFileHeader& AssetHeader, ezBitflags<ezTransformFlags> transformFlags)
 {
-  ezProgressRange range("Transforming Asset", 2, false);
+  ezProgressRange range("Transforming Asset", 3, false);
 
   ezMeshAssetProperties* pProp = GetProperties();
 
@@ -51,6 +51,20 @@ ezStatus ezMeshAssetDocument::InternalTransformAsset(ezStreamWriter& stream, con
     CreateMeshFromGeom(pProp, desc);
   }
 
+  range.BeginNextStep("Generating LODs");
+
+  if (!pProp->m_LodScreenSizes.IsEmpty())
+  {
+    // LODs are sorted from the most to the least detailed one
+    ezHybridArray<float, 4> lodScreenSizes = pProp->m_LodScreenSizes;
+    lodScreenSizes.Sort([](float lhs, float rhs) { return lhs > rhs; });
+
+    if (desc.GenerateLods(lodScreenSizes, pProp->m_fLodTriangleRatio).Failed())
+    {
+      return ezStatus("Mesh LODs could not be generated. The LOD screen sizes must be distinct and between 0 and 1, exclusively.");
+    }
+  }
+
   range.BeginNextStep("Writing Result");
   desc.Save(stream);
 
@@ -33,6 +33,8 @@ EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezMeshAssetProperties, 3, ezRTTIDefaultAllocator
     EZ_MEMBER_PROPERTY("ImportMaterials", m_bImportMaterials)->AddAttributes(new ezDefaultValueAttribute(true)),
     EZ_MEMBER_PROPERTY("UseSubfolderForMaterialImport", m_bUseSubFolderForImportedMaterials)->AddAttributes(new ezDefaultValueAttribute(true)),
     EZ_ARRAY_MEMBER_PROPERTY("Materials", m_Slots)->AddAttributes(new ezContainerAttribute(false, true, true)),
+    EZ_ARRAY_MEMBER_PROPERTY("LodScreenSizes", m_LodScreenSizes)->AddAttributes(new ezClampValueAttribute(0.0f, 1.0f)),
+    EZ_MEMBER_PROPERTY("LodTriangleRatio", m_fLodTriangleRatio)->AddAttributes(new ezDefaultValueAttribute(0.5f), new ezClampValueAttribute(0.05f, 0.95f)),
   }
   EZ_END_PROPERTIES;
 }
@@ -96,6 +98,7 @@ ezMeshAssetProperties::ezMeshAssetProperties()
   m_bCap2 = true;
   m_Angle = ezAngle::Degree(360.0f);
   m_bImportMaterials = true;
+  m_fLodTriangleRatio = 0.5f;
 }
 
 
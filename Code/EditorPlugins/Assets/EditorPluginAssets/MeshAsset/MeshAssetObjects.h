@@ -69,6 +69,9 @@ public:
   bool m_bUseSubFolderForImportedMaterials;
   ezHybridArray<ezMaterialResourceSlot, 8> m_Slots;
 
+  ezHybridArray<float, 4> m_LodScreenSizes;
+  float m_fLodTriangleRatio;
+
   ezUInt32 m_uiVertices;
   ezUInt32 m_uiTriangles;
 };
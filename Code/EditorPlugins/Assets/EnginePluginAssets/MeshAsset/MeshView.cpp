@@ -57,9 +57,15 @@ void ezMeshViewContext::SetCamera(const ezViewRedrawMsgToEngine* pMsg)
     auto& bufferDesc = ezGALDevice::GetDefaultDevice()->GetBuffer(pMeshBuffer->GetVertexBuffer())->GetDescription();
 
     ezUInt32 uiNumVertices = bufferDesc.m_uiTotalSize / bufferDesc.m_uiStructSize;
-    ezUInt32 uiNumTriangles = pMeshBuffer->GetPrimitiveCount();
     const ezBoundingBox& bbox = pMeshBuffer->GetBounds().GetBox();
 
+    // the mesh buffer also contains the triangles of the simplified LODs, only count the full detail mesh
+    ezUInt32 uiNumTriangles = 0;
+    for (const auto& subMesh : pMesh->GetSubMeshes())
+    {
+      uiNumTriangles += subMesh.m_uiPrimitiveCount;
+    }
+
     ezUInt32 uiNumUVs = 0;
     ezUInt32 uiNumColors = 0;
     for (auto& vertexStream : pMeshBuffer->GetVertexDeclaration().m_VertexStreams)
@@ -76,6 +82,7 @@ void ezMeshViewContext::SetCamera(const ezViewRedrawMsgToEngine* pMsg)
 
     ezStringBuilder sText;
     sText.AppendFormat("Triangles: {}\\n", uiNumTriangles);
+    sText.AppendFormat("LODs: {}\\n", pMesh->GetLods().GetCount());
     sText.AppendFormat("Vertices: {}\\n", uiNumVertices);
     sText.AppendFormat("UV Channels: {}\\n", uiNumUVs);
     sText.AppendFormat("Color Channels: {}\\n", uiNumColors);
@@ -413,6 +413,18 @@ void ezQtFileserveWidget::FileserverEventHandler(const ezFileserverEvent& e)
       LogActivity("Client searching for Server", ezFileserveActivityType::Other);
     }
     break;
+
+    case ezFileserverEvent::Type::PrefetchRequest:
+    {
+      LogActivity(ezFmt("Prefetch request for {0} files", e.m_uiSizeTotal), ezFileserveActivityType::Other);
+    }
+    break;
+
+    case ezFileserverEvent::Type::PrefetchFinished:
+    {
+      LogActivity(ezFmt("Prefetch finished, {0} bytes sent", e.m_uiSentTotal), ezFileserveActivityType::Other);
+    }
+    break;
   }
 }
 
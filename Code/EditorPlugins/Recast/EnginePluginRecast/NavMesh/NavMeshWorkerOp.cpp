@@ -4,6 +4,7 @@
 
 #include <Core/Assets/AssetFileHeader.h>
 #include <EditorEngineProcessFramework/EngineProcess/EngineProcessDocumentContext.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/Utilities/Progress.h>
 #include <ToolsFoundation/Document/DocumentManager.h>
@@ -41,10 +42,26 @@ ezResult ezLongOpWorker_BuildNavMesh::Execute(ezProgress& progress, ezStreamWrit
   ezRecastNavMeshBuilder NavMeshBuilder;
   ezRecastNavMeshResourceDescriptor desc;
 
+  // for tiled navmeshes, the previous result allows to only rebuild the tiles whose geometry changed
+  ezRecastNavMeshResourceDescriptor previousDesc;
+  bool bHasPrevious = false;
+
+  if (m_NavMeshConfig.m_fTileSize > 0.0f)
+  {
+    ezFileReader file;
+    if (file.Open(m_sOutputPath).Succeeded())
+    {
+      ezAssetFileHeader header;
+      header.Read(file);
+
+      bHasPrevious = previousDesc.Deserialize(file).Succeeded();
+    }
+  }
+
   if (!pgRange.BeginNextStep("Building NavMesh"))
     return EZ_FAILURE;
 
-  EZ_SUCCEED_OR_RETURN(NavMeshBuilder.Build(m_NavMeshConfig, m_ExtractedWorldGeometry, desc, progress));
+  EZ_SUCCEED_OR_RETURN(NavMeshBuilder.Build(m_NavMeshConfig, m_ExtractedWorldGeometry, desc, progress, bHasPrevious ? &previousDesc : nullptr));
 
   if (!pgRange.BeginNextStep("Writing Result"))
     return EZ_FAILURE;
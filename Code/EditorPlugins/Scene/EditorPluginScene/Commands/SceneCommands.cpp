@@ -172,10 +172,11 @@ void ezDuplicateObjectsCommand::CreateOneDuplicate(ezAbstractObjectGraph& graph,
     ParentGuids[guidObj] = ezConversionUtils::ConvertStringToUuid(sNextParentGuid);
   }
 
-  auto& nodes = graph.GetAllNodes();
-  for (auto it = nodes.GetIterator(); it.IsValid(); ++it)
+  // the objects are pasted in this order, so it has to be stable
+  ezDynamicArray<const ezAbstractObjectNode*> nodes;
+  graph.GetAllNodesSortedByGuid(nodes);
+  for (auto* pNode : nodes)
   {
-    auto* pNode = it.Value();
     if (ezStringUtils::IsEqual(pNode->GetNodeName(), "root"))
     {
       auto* pNewObject = reader.CreateObjectFromNode(pNode);
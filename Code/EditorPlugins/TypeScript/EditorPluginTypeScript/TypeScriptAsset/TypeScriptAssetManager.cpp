@@ -348,6 +348,23 @@ ezResult ezTypeScriptAssetDocumentManager::GenerateScriptCompendium(ezBitflags<e
 
       it.Value() = sTranspiledJs;
 
+      // precompile the module, so that the runtime doesn't have to parse it every time it is loaded
+      // if this fails for some reason, the runtime just falls back to compiling the source
+      {
+        auto& bytecode = compendium.m_PathToBytecode[it.Key()];
+
+        if (m_Transpiler.CompileModuleToBytecode(sTranspiledJs, it.Key(), bytecode.m_Bytecode).Succeeded())
+        {
+          bytecode.m_uiSourceHash = ezHashingUtils::xxHash64(sTranspiledJs.GetData(), sTranspiledJs.GetElementCount());
+          bytecode.m_uiBytecodeVersion = ezDuktapeHelper::GetBytecodeVersion();
+        }
+        else
+        {
+          ezLog::Warning("Failed to precompile '{}', it will be compiled at runtime", it.Key());
+          compendium.m_PathToBytecode.Remove(it.Key());
+        }
+      }
+
       sFilename = ezPathUtils::GetFileName(it.Key());
       filenameToSourceTsPath[sFilename] = it.Key();
     }
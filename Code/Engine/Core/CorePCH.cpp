@@ -26,6 +26,7 @@ EZ_STATICLINK_LIBRARY(Core)
   EZ_STATICLINK_REFERENCE(Core_ResourceManager_Implementation_ResourceHandle);
   EZ_STATICLINK_REFERENCE(Core_ResourceManager_Implementation_ResourceLoading);
   EZ_STATICLINK_REFERENCE(Core_ResourceManager_Implementation_ResourceManager);
+  EZ_STATICLINK_REFERENCE(Core_ResourceManager_Implementation_ResourceMemoryBudget);
   EZ_STATICLINK_REFERENCE(Core_ResourceManager_Implementation_ResourceTypeLoader);
   EZ_STATICLINK_REFERENCE(Core_ResourceManager_Implementation_WorkerTasks);
   EZ_STATICLINK_REFERENCE(Core_Scripting_Duktape_DuktapeContext);
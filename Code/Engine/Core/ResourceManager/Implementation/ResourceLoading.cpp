@@ -127,29 +127,6 @@ void ezResourceManager::RunWorkerTask(ezResource* pResource)
   }
 }
 
-void ezResourceManager::ReverseBubbleSortStep(ezDeque<LoadingInfo>& data)
-{
-  // Yep, it's really bubble sort!
-  // This will move the entry with the smallest value to the front and move all other values closer to their correct position,
-  // which is exactly what we need for the priority queue.
-  // We do this once a frame, which gives us nice iterative sorting, with relatively deterministic performance characteristics.
-
-  EZ_ASSERT_DEBUG(s_ResourceMutex.IsLocked(), "Calling code must acquire s_ResourceMutex");
-
-  const ezUInt32 uiCount = data.GetCount();
-
-  for (ezUInt32 i = uiCount; i > 1; --i)
-  {
-    const ezUInt32 idx2 = i - 1;
-    const ezUInt32 idx1 = i - 2;
-
-    if (data[idx1].m_fPriority > data[idx1].m_fPriority)
-    {
-      ezMath::Swap(data[idx1], data[idx2]);
-    }
-  }
-}
-
 void ezResourceManager::UpdateLoadingDeadlines()
 {
   if (s_State->s_LoadingQueue.IsEmpty())
@@ -177,18 +154,20 @@ void ezResourceManager::UpdateLoadingDeadlines()
 
       const ezTime tNow = ezTime::Now();
 
+      // re-prioritizing moves resources around in the queue, so some may be evaluated twice or skipped until the next round
       for (ezUInt32 i = 0; i < uiUpdateCount; ++i)
       {
-        auto& element = s_State->s_LoadingQueue[s_State->s_uiLastResourcePriorityUpdateIdx];
-        element.m_fPriority = element.m_pResource->GetLoadingPriority(tNow);
+        const ezUInt32 uiIndex = s_State->s_uiLastResourcePriorityUpdateIdx;
+        const float fPriority = s_State->s_LoadingQueue[uiIndex].m_Value->GetLoadingPriority(tNow);
+
+        if (fPriority != s_State->s_LoadingQueue[uiIndex].m_Key)
+        {
+          s_State->s_LoadingQueue.SetKey(uiIndex, fPriority);
+        }
+
         ++s_State->s_uiLastResourcePriorityUpdateIdx;
       }
     }
-
-    {
-      EZ_PROFILE_SCOPE("SortLoadingDeadlines");
-      ReverseBubbleSortStep(s_State->s_LoadingQueue);
-    }
   }
 }
 
@@ -220,16 +199,13 @@ ezResult ezResourceManager::RemoveFromLoadingQueue(ezResource* pResource)
   if (!IsQueuedForLoading(pResource))
     return EZ_SUCCESS;
 
-  LoadingInfo li;
-  li.m_pResource = pResource;
+  // the resource is flagged as queued, but a task has already taken it out of the queue to load it
+  if (pResource->m_uiLoadingQueueIndex == ezInvalidIndex)
+    return EZ_FAILURE;
 
-  if (s_State->s_LoadingQueue.RemoveAndSwap(li))
-  {
-    pResource->m_Flags.Remove(ezResourceFlags::IsQueuedForLoading);
-    return EZ_SUCCESS;
-  }
-
-  return EZ_FAILURE;
+  s_State->s_LoadingQueue.Remove(pResource->m_uiLoadingQueueIndex);
+  pResource->m_Flags.Remove(ezResourceFlags::IsQueuedForLoading);
+  return EZ_SUCCESS;
 }
 
 void ezResourceManager::AddToLoadingQueue(ezResource* pResource, bool bHighestPriority)
@@ -239,19 +215,16 @@ void ezResourceManager::AddToLoadingQueue(ezResource* pResource, bool bHighestPr
 
   pResource->m_Flags.Add(ezResourceFlags::IsQueuedForLoading);
 
-  LoadingInfo li;
-  li.m_pResource = pResource;
-
   if (bHighestPriority)
   {
     pResource->SetPriority(ezResourcePriority::Critical);
-    li.m_fPriority = 0.0f;
-    s_State->s_LoadingQueue.PushFront(li);
+
+    // lower than any regular loading priority, so that it gets picked up next
+    s_State->s_LoadingQueue.Insert(-1.0f, pResource);
   }
   else
   {
-    li.m_fPriority = pResource->GetLoadingPriority(s_State->s_LastFrameUpdate);
-    s_State->s_LoadingQueue.PushBack(li);
+    s_State->s_LoadingQueue.Insert(pResource->GetLoadingPriority(s_State->s_LastFrameUpdate), pResource);
   }
 }
 
@@ -284,10 +257,7 @@ bool ezResourceManager::ReloadResource(ezResource* pResource, bool bForce)
   {
     bAllowPreloading = false;
 
-    LoadingInfo li;
-    li.m_pResource = pResource;
-
-    if (s_State->s_LoadingQueue.IndexOf(li) == ezInvalidIndex)
+    if (pResource->m_uiLoadingQueueIndex == ezInvalidIndex)
     {
       // the resource is marked as 'loading' but it is not in the queue anymore
       // that means some task is already working on loading it
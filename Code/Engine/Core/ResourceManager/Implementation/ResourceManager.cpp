@@ -23,7 +23,7 @@
 ///   Requires No File Access -> on non-File Thread
 
 ezUniquePtr<ezResourceManagerState> ezResourceManager::s_State;
-ezMutex ezResourceManager::s_ResourceMutex;
+ezMutex ezResourceManager::s_ResourceMutex("ezResourceManager");
 
 // clang-format off
 EZ_BEGIN_SUBSYSTEM_DECLARATION(Core, ResourceManager)
@@ -404,6 +404,7 @@ ezResult ezResourceManager::DeallocateResource(ezResource* pResource)
   }
 
   pResource->CallUnloadData(ezResource::Unload::AllQualityLevels);
+  RemoveFromMemoryBudget(pResource);
 
   EZ_ASSERT_DEBUG(pResource->GetLoadingState() <= ezResourceState::LoadedResourceMissing,
     "Resource '{0}' should be in an unloaded state now.", pResource->GetResourceID());
@@ -444,10 +445,15 @@ void ezResourceManager::ResetAllResources()
 }
 
 void ezResourceManager::PerFrameUpdate()
+{
+  PerFrameUpdate(ezTime::Now());
+}
+
+void ezResourceManager::PerFrameUpdate(ezTime frameTime)
 {
   EZ_PROFILE_SCOPE("ezResourceManagerUpdate");
 
-  s_State->s_LastFrameUpdate = ezTime::Now();
+  s_State->s_LastFrameUpdate = frameTime;
 
   if (s_State->s_bBroadcastExistsEvent)
   {
@@ -500,6 +506,8 @@ void ezResourceManager::PerFrameUpdate()
     s_State->s_ResourcesToUnloadOnMainThread.Clear();
   }
 
+  UpdateMemoryBudgets();
+
   if (s_State->m_AutoFreeUnusedTimeout.IsPositive())
   {
     FreeUnusedResources(s_State->m_AutoFreeUnusedTimeout, s_State->m_AutoFreeUnusedThreshold);
@@ -577,9 +585,9 @@ void ezResourceManager::EngineAboutToShutdown()
   {
     EZ_LOCK(s_ResourceMutex);
 
-    for (auto entry : s_State->s_LoadingQueue)
+    for (ezUInt32 i = 0; i < s_State->s_LoadingQueue.GetCount(); ++i)
     {
-      entry.m_pResource->m_Flags.Remove(ezResourceFlags::IsQueuedForLoading);
+      s_State->s_LoadingQueue[i].m_Value->m_Flags.Remove(ezResourceFlags::IsQueuedForLoading);
     }
 
     s_State->s_LoadingQueue.Clear();
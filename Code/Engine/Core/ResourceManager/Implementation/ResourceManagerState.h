@@ -32,6 +32,24 @@ private:
 
   ezMap<const ezRTTI*, ezResourcePriority> s_ResourceTypePriorities;
 
+  ///@}
+  /// \name Memory budgets
+  ///@{
+
+  struct ReducedQualityLevels
+  {
+    ezResource::MemoryUsage m_DiscardedMemory; ///< Memory freed by the quality levels that are still discarded
+    ezResource::MemoryUsage m_PendingMemory;   ///< Estimated memory of a quality level that is currently being loaded again
+    ezUInt32 m_uiNumDiscarded = 0;
+    ezTime m_DiscardTime;
+  };
+
+  bool s_bMemoryBudgetsEnabled = false;
+  ezResourceManager::MemoryBudgetStats s_GlobalMemoryBudget;
+  ezMap<const ezRTTI*, ezResourceManager::MemoryBudgetStats> s_TypeMemoryBudgets;
+  ezHashTable<ezResource*, ReducedQualityLevels> s_ReducedByMemoryBudget;
+  ezDynamicArray<ezResource*> s_MemoryBudgetTempContainer;
+
   ///@}
 
   struct TaskDataUpdateContent
@@ -50,8 +68,8 @@ private:
   bool s_bBroadcastExistsEvent = false;
   ezUInt32 s_uiForceNoFallbackAcquisition = 0;
 
-  // resources in this queue are waiting for a task to load them
-  ezDeque<ezResourceManager::LoadingInfo> s_LoadingQueue;
+  // resources in this queue are waiting for a task to load them, the one with the lowest loading priority value is loaded first
+  ezResourceManager::LoadingQueue s_LoadingQueue;
 
   ezHashTable<const ezRTTI*, ezResourceManager::LoadedResources> s_LoadedResources;
 
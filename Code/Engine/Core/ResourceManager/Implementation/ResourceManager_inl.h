@@ -124,7 +124,9 @@ ResourceType* ezResourceManager::BeginAcquireResource(const ezTypedResourceHandl
     if (out_AcquireResult)
       *out_AcquireResult = ezResourceAcquireResult::Final;
 
-    pResource->m_iLockCount.Increment();
+    if (pResource->m_iLockCount.Increment() < 0)
+      WaitWhileDiscardingQualityLevels(pResource);
+
     return pResource;
   }
 
@@ -167,7 +169,9 @@ ResourceType* ezResourceManager::BeginAcquireResource(const ezTypedResourceHandl
       // as long as there are more quality levels available, schedule the resource for more loading
       // accessing IsQueuedForLoading without a lock here is save because InternalPreloadResource() will lock and early out if necessary
       // and accidentally skipping InternalPreloadResource() is no problem
-      if (IsQueuedForLoading(pResource) == false && pResource->GetNumQualityLevelsLoadable() > 0)
+      // resources that were reduced to fit into a memory budget get their quality levels back through UpdateMemoryBudgets()
+      if (IsQueuedForLoading(pResource) == false && pResource->GetNumQualityLevelsLoadable() > 0 &&
+          !pResource->m_Flags.IsSet(ezResourceFlags::ReducedByMemoryBudget))
         InternalPreloadResource(pResource, false);
     }
   }
@@ -201,7 +205,9 @@ ResourceType* ezResourceManager::BeginAcquireResource(const ezTypedResourceHandl
   if (out_AcquireResult)
     *out_AcquireResult = ezResourceAcquireResult::Final;
 
-  pResource->m_iLockCount.Increment();
+  if (pResource->m_iLockCount.Increment() < 0)
+    WaitWhileDiscardingQualityLevels(pResource);
+
   return pResource;
 }
 
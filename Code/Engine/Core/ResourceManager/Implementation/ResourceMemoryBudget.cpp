@@ -0,0 +1,310 @@
+#include <CorePCH.h>
+
+#include <Core/ResourceManager/Implementation/ResourceManagerState.h>
+#include <Core/ResourceManager/ResourceManager.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/ThreadUtils.h>
+
+namespace
+{
+  void AddMemoryUsage(ezResourceManager::MemoryBudgetStats& inout_Stats, const ezResource::MemoryUsage& usage)
+  {
+    inout_Stats.m_uiMemoryCPU += usage.m_uiMemoryCPU;
+    inout_Stats.m_uiMemoryGPU += usage.m_uiMemoryGPU;
+  }
+
+  void SubtractMemoryUsage(ezResourceManager::MemoryBudgetStats& inout_Stats, const ezResource::MemoryUsage& usage)
+  {
+    inout_Stats.m_uiMemoryCPU -= ezMath::Min(inout_Stats.m_uiMemoryCPU, usage.m_uiMemoryCPU);
+    inout_Stats.m_uiMemoryGPU -= ezMath::Min(inout_Stats.m_uiMemoryGPU, usage.m_uiMemoryGPU);
+  }
+
+  bool FitsIntoBudget(const ezResourceManager::MemoryBudgetStats& stats, const ezResource::MemoryUsage& additionalUsage)
+  {
+    if (stats.m_uiBudgetCPU != 0 && stats.m_uiMemoryCPU + additionalUsage.m_uiMemoryCPU > stats.m_uiBudgetCPU)
+      return false;
+
+    if (stats.m_uiBudgetGPU != 0 && stats.m_uiMemoryGPU + additionalUsage.m_uiMemoryGPU > stats.m_uiBudgetGPU)
+      return false;
+
+    return true;
+  }
+} // namespace
+
+void ezResourceManager::SetMemoryBudget(ezUInt64 uiBudgetCPU, ezUInt64 uiBudgetGPU)
+{
+  EZ_LOCK(s_ResourceMutex);
+
+  s_State->s_GlobalMemoryBudget.m_uiBudgetCPU = uiBudgetCPU;
+  s_State->s_GlobalMemoryBudget.m_uiBudgetGPU = uiBudgetGPU;
+
+  UpdateMemoryBudgetsEnabled();
+}
+
+void ezResourceManager::SetMemoryBudgetForResourceType(const ezRTTI* pResourceType, ezUInt64 uiBudgetCPU, ezUInt64 uiBudgetGPU)
+{
+  EZ_LOCK(s_ResourceMutex);
+
+  MemoryBudgetStats& stats = s_State->s_TypeMemoryBudgets[pResourceType];
+  stats.m_uiBudgetCPU = uiBudgetCPU;
+  stats.m_uiBudgetGPU = uiBudgetGPU;
+
+  UpdateMemoryBudgetsEnabled();
+}
+
+ezResourceManager::MemoryBudgetStats ezResourceManager::GetMemoryBudgetStats(const ezRTTI* pResourceType)
+{
+  EZ_LOCK(s_ResourceMutex);
+
+  if (pResourceType == nullptr)
+    return s_State->s_GlobalMemoryBudget;
+
+  return s_State->s_TypeMemoryBudgets.GetValueOrDefault(pResourceType, MemoryBudgetStats());
+}
+
+void ezResourceManager::UpdateMemoryBudgetsEnabled()
+{
+  bool bEnabled = s_State->s_GlobalMemoryBudget.m_uiBudgetCPU != 0 || s_State->s_GlobalMemoryBudget.m_uiBudgetGPU != 0;
+
+  for (auto it = s_State->s_TypeMemoryBudgets.GetIterator(); it.IsValid(); ++it)
+  {
+    bEnabled |= it.Value().m_uiBudgetCPU != 0 || it.Value().m_uiBudgetGPU != 0;
+  }
+
+  s_State->s_bMemoryBudgetsEnabled = bEnabled;
+
+  if (!bEnabled)
+  {
+    // without a budget, the reduced resources load their remaining quality levels on acquire again
+    for (auto it = s_State->s_ReducedByMemoryBudget.GetIterator(); it.IsValid(); ++it)
+    {
+      it.Key()->m_Flags.Remove(ezResourceFlags::ReducedByMemoryBudget);
+    }
+
+    s_State->s_ReducedByMemoryBudget.Clear();
+  }
+}
+
+void ezResourceManager::RemoveFromMemoryBudget(ezResource* pResource)
+{
+  pResource->m_Flags.Remove(ezResourceFlags::ReducedByMemoryBudget);
+  s_State->s_ReducedByMemoryBudget.Remove(pResource);
+}
+
+void ezResourceManager::WaitWhileDiscardingQualityLevels(ezResource* pResource)
+{
+  // UpdateMemoryBudgets() removes the offset from the lock count once it is done with the resource
+  while (pResource->m_iLockCount < 0)
+  {
+    ezThreadUtils::YieldTimeSlice();
+  }
+}
+
+void ezResourceManager::UpdateMemoryBudgets()
+{
+  EZ_LOCK(s_ResourceMutex);
+
+  if (!s_State->s_bMemoryBudgetsEnabled)
+    return;
+
+  EZ_PROFILE_SCOPE("UpdateMemoryBudgets");
+
+  MemoryBudgetStats& globalStats = s_State->s_GlobalMemoryBudget;
+  auto& typeBudgets = s_State->s_TypeMemoryBudgets;
+
+  // only types with a budget have stats, the usage of all other types only goes into the global stats
+  MemoryBudgetStats unbudgetedTypeStats;
+  auto GetTypeStats = [&](const ezRTTI* pType) -> MemoryBudgetStats& {
+    auto it = typeBudgets.Find(pType);
+    return it.IsValid() ? it.Value() : unbudgetedTypeStats;
+  };
+
+  auto ResetStats = [](MemoryBudgetStats& stats) {
+    stats.m_uiMemoryCPU = 0;
+    stats.m_uiMemoryGPU = 0;
+    stats.m_uiQualityLevelsDiscarded = 0;
+    stats.m_uiQualityLevelsRequested = 0;
+  };
+
+  ResetStats(globalStats);
+  for (auto it = typeBudgets.GetIterator(); it.IsValid(); ++it)
+  {
+    ResetStats(it.Value());
+  }
+
+  // sum up the memory usage per type and of all resources
+  bool bAnyOverBudget = false;
+
+  for (auto itType = s_State->s_LoadedResources.GetIterator(); itType.IsValid(); ++itType)
+  {
+    MemoryBudgetStats& typeStats = GetTypeStats(itType.Key());
+    ResetStats(unbudgetedTypeStats);
+
+    for (auto it = itType.Value().m_Resources.GetIterator(); it.IsValid(); ++it)
+    {
+      AddMemoryUsage(typeStats, it.Value()->GetMemoryUsage());
+    }
+
+    globalStats.m_uiMemoryCPU += typeStats.m_uiMemoryCPU;
+    globalStats.m_uiMemoryGPU += typeStats.m_uiMemoryGPU;
+    bAnyOverBudget |= typeStats.IsOverBudget();
+  }
+
+  // quality levels that are currently being loaded again are not yet part of the memory usage, but they will be soon
+  for (auto it = s_State->s_ReducedByMemoryBudget.GetIterator(); it.IsValid(); ++it)
+  {
+    if (!IsQueuedForLoading(it.Key()))
+    {
+      it.Value().m_PendingMemory = ezResource::MemoryUsage();
+      continue;
+    }
+
+    AddMemoryUsage(globalStats, it.Value().m_PendingMemory);
+    AddMemoryUsage(GetTypeStats(it.Key()->GetDynamicRTTI()), it.Value().m_PendingMemory);
+  }
+
+  bAnyOverBudget |= globalStats.IsOverBudget();
+
+  auto& resources = s_State->s_MemoryBudgetTempContainer;
+  resources.Clear();
+
+  if (bAnyOverBudget)
+  {
+    const bool bGlobalOverBudget = globalStats.IsOverBudget();
+
+    for (auto itType = s_State->s_LoadedResources.GetIterator(); itType.IsValid(); ++itType)
+    {
+      if (!bGlobalOverBudget && !GetTypeStats(itType.Key()).IsOverBudget())
+        continue;
+
+      for (auto it = itType.Value().m_Resources.GetIterator(); it.IsValid(); ++it)
+      {
+        ezResource* pResource = it.Value();
+
+        // resources that are in use or being loaded right now cannot be modified
+        if (pResource->GetLoadingState() == ezResourceState::Loaded && pResource->GetNumQualityLevelsDiscardable() > 0 &&
+            !IsQueuedForLoading(pResource) && pResource->m_iLockCount == 0)
+        {
+          resources.PushBack(pResource);
+        }
+      }
+    }
+
+    // discard from the least important resources first: lowest priority, then least recently acquired
+    resources.Sort([](const ezResource* lhs, const ezResource* rhs) -> bool {
+      if (lhs->GetPriority() != rhs->GetPriority())
+        return lhs->GetPriority() > rhs->GetPriority();
+
+      return lhs->GetLastAcquireTime() < rhs->GetLastAcquireTime();
+    });
+
+    for (ezResource* pResource : resources)
+    {
+      MemoryBudgetStats& typeStats = GetTypeStats(pResource->GetDynamicRTTI());
+
+      if (!globalStats.IsOverBudget() && !typeStats.IsOverBudget())
+        continue;
+
+      // another thread may have acquired the resource in the meantime, the offset makes any new acquire wait until the levels are gone
+      if (!pResource->m_iLockCount.TestAndSet(0, s_iDiscardingLockCount))
+        continue;
+
+      while ((globalStats.IsOverBudget() || typeStats.IsOverBudget()) && pResource->GetNumQualityLevelsDiscardable() > 0)
+      {
+        const ezResource::MemoryUsage usageBefore = pResource->GetMemoryUsage();
+        const ezUInt8 uiDiscardableBefore = pResource->GetNumQualityLevelsDiscardable();
+
+        pResource->CallUnloadData(ezResource::Unload::OneQualityLevel);
+
+        const ezResource::MemoryUsage& usageAfter = pResource->GetMemoryUsage();
+
+        ezResource::MemoryUsage freed;
+        freed.m_uiMemoryCPU = usageBefore.m_uiMemoryCPU - ezMath::Min(usageBefore.m_uiMemoryCPU, usageAfter.m_uiMemoryCPU);
+        freed.m_uiMemoryGPU = usageBefore.m_uiMemoryGPU - ezMath::Min(usageBefore.m_uiMemoryGPU, usageAfter.m_uiMemoryGPU);
+
+        SubtractMemoryUsage(globalStats, freed);
+        SubtractMemoryUsage(typeStats, freed);
+
+        ++globalStats.m_uiQualityLevelsDiscarded;
+        ++typeStats.m_uiQualityLevelsDiscarded;
+
+        pResource->m_Flags.Add(ezResourceFlags::ReducedByMemoryBudget);
+
+        auto& reduced = s_State->s_ReducedByMemoryBudget[pResource];
+        reduced.m_DiscardedMemory.m_uiMemoryCPU += freed.m_uiMemoryCPU;
+        reduced.m_DiscardedMemory.m_uiMemoryGPU += freed.m_uiMemoryGPU;
+        reduced.m_uiNumDiscarded++;
+        reduced.m_DiscardTime = s_State->s_LastFrameUpdate;
+
+        // do not rely on every resource type reporting its quality levels correctly
+        if (pResource->GetLoadingState() != ezResourceState::Loaded || pResource->GetNumQualityLevelsDiscardable() >= uiDiscardableBefore)
+          break;
+      }
+
+      pResource->m_iLockCount.Add(-s_iDiscardingLockCount);
+    }
+
+    return;
+  }
+
+  // there is room in the budgets, so give the discarded quality levels back to the most important resources
+  for (auto it = s_State->s_ReducedByMemoryBudget.GetIterator(); it.IsValid(); ++it)
+  {
+    resources.PushBack(it.Key());
+  }
+
+  resources.Sort([](const ezResource* lhs, const ezResource* rhs) -> bool {
+    if (lhs->GetPriority() != rhs->GetPriority())
+      return lhs->GetPriority() < rhs->GetPriority();
+
+    return lhs->GetLastAcquireTime() > rhs->GetLastAcquireTime();
+  });
+
+  for (ezResource* pResource : resources)
+  {
+    if (IsQueuedForLoading(pResource))
+      continue;
+
+    auto& reduced = *s_State->s_ReducedByMemoryBudget.GetValue(pResource);
+
+    // the resource was unloaded or reloaded in the meantime, or all its levels were requested again
+    if (pResource->GetLoadingState() != ezResourceState::Loaded || pResource->GetNumQualityLevelsLoadable() == 0 || reduced.m_uiNumDiscarded == 0)
+    {
+      RemoveFromMemoryBudget(pResource);
+      continue;
+    }
+
+    // only resources that are still in use deserve their memory back
+    if (pResource->GetLastAcquireTime() <= reduced.m_DiscardTime)
+      continue;
+
+    // the levels are given back in the order they were discarded, estimate each one with the average size
+    ezResource::MemoryUsage estimate;
+    estimate.m_uiMemoryCPU = reduced.m_DiscardedMemory.m_uiMemoryCPU / reduced.m_uiNumDiscarded;
+    estimate.m_uiMemoryGPU = reduced.m_DiscardedMemory.m_uiMemoryGPU / reduced.m_uiNumDiscarded;
+
+    MemoryBudgetStats& typeStats = GetTypeStats(pResource->GetDynamicRTTI());
+
+    if (!FitsIntoBudget(globalStats, estimate) || !FitsIntoBudget(typeStats, estimate))
+      continue;
+
+    AddMemoryUsage(globalStats, estimate);
+    AddMemoryUsage(typeStats, estimate);
+
+    ++globalStats.m_uiQualityLevelsRequested;
+    ++typeStats.m_uiQualityLevelsRequested;
+
+    reduced.m_DiscardedMemory.m_uiMemoryCPU -= estimate.m_uiMemoryCPU;
+    reduced.m_DiscardedMemory.m_uiMemoryGPU -= estimate.m_uiMemoryGPU;
+    reduced.m_PendingMemory = estimate;
+    reduced.m_uiNumDiscarded--;
+
+    // once the last level is requested, the resource manages its quality levels on its own again
+    if (reduced.m_uiNumDiscarded == 0)
+      pResource->m_Flags.Remove(ezResourceFlags::ReducedByMemoryBudget);
+
+    InternalPreloadResource(pResource, false);
+  }
+}
+
+EZ_STATICLINK_FILE(Core, Core_ResourceManager_Implementation_ResourceMemoryBudget);
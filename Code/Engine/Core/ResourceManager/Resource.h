@@ -224,6 +224,7 @@ private:
   ezString m_sResourceDescription;
   MemoryUsage m_MemoryUsage;
   ezBitflags<ezResourceFlags> m_Flags;
+  ezUInt32 m_uiLoadingQueueIndex = ezInvalidIndex; ///< Position in the resource manager's loading queue, ezInvalidIndex if not in the queue.
 
   ezTime m_LastAcquire;
   ezResourcePriority m_Priority = ezResourcePriority::Medium;
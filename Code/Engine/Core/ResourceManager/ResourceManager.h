@@ -6,6 +6,7 @@
 #include <Core/ResourceManager/ResourceTypeLoader.h>
 #include <Foundation/Configuration/Plugin.h>
 #include <Foundation/Containers/HashTable.h>
+#include <Foundation/Containers/IndexedPriorityQueue.h>
 #include <Foundation/Threading/LockedObject.h>
 #include <Foundation/Types/UniquePtr.h>
 
@@ -217,6 +218,11 @@ public:
   /// \brief Must be called once per frame for some bookkeeping.
   static void PerFrameUpdate();
 
+  /// \brief Same as PerFrameUpdate(), but uses the given time as the frame time instead of the current time.
+  ///
+  /// The frame time is what resources store as their last acquire time. Mostly useful for tests that need well defined frame times.
+  static void PerFrameUpdate(ezTime frameTime);
+
   /// \brief Makes sure that no further resource loading will take place.
   static void EngineAboutToShutdown();
 
@@ -386,6 +392,63 @@ public:
 private:
   static ezMap<const ezRTTI*, ezResourcePriority>& GetResourceTypePriorities();
   ///@}
+  /// \name Memory budgets
+  ///@{
+
+public:
+  /// \brief Memory usage and budget of all resources or of one resource type, as computed by the last PerFrameUpdate().
+  struct MemoryBudgetStats
+  {
+    ezUInt64 m_uiBudgetCPU = 0; ///< Zero means there is no budget.
+    ezUInt64 m_uiBudgetGPU = 0; ///< Zero means there is no budget.
+    ezUInt64 m_uiMemoryCPU = 0;
+    ezUInt64 m_uiMemoryGPU = 0;
+    ezUInt32 m_uiQualityLevelsDiscarded = 0; ///< How many quality levels were discarded in the last frame to get within the budget.
+    ezUInt32 m_uiQualityLevelsRequested = 0; ///< How many previously discarded quality levels were scheduled for loading again in the last frame.
+
+    bool IsOverBudget() const
+    {
+      return (m_uiBudgetCPU != 0 && m_uiMemoryCPU > m_uiBudgetCPU) || (m_uiBudgetGPU != 0 && m_uiMemoryGPU > m_uiBudgetGPU);
+    }
+  };
+
+  /// \brief Sets how much CPU and GPU memory all resources together may use. Zero means no limit.
+  ///
+  /// Once per frame PerFrameUpdate() checks the memory usage of all resources. When a budget is exceeded, quality levels are discarded
+  /// from the resources with the lowest priority that have not been acquired for the longest time, until the usage fits into the budget
+  /// again. Resources that are reduced this way do not load their quality levels again on acquire. Instead PerFrameUpdate() schedules them
+  /// for loading, once the budget has room for them and they have been acquired since.
+  static void SetMemoryBudget(ezUInt64 uiBudgetCPU, ezUInt64 uiBudgetGPU);
+
+  /// \brief Sets how much memory all resources of the given type may use. Zero means no limit. Derived types are budgeted separately.
+  ///
+  /// \sa SetMemoryBudget()
+  template <typename ResourceType>
+  static void SetMemoryBudgetForResourceType(ezUInt64 uiBudgetCPU, ezUInt64 uiBudgetGPU)
+  {
+    SetMemoryBudgetForResourceType(ezGetStaticRTTI<ResourceType>(), uiBudgetCPU, uiBudgetGPU);
+  }
+
+  /// \sa SetMemoryBudgetForResourceType()
+  static void SetMemoryBudgetForResourceType(const ezRTTI* pResourceType, ezUInt64 uiBudgetCPU, ezUInt64 uiBudgetGPU);
+
+  /// \brief Returns the memory usage and budget enforcement statistics of the last frame, for all resources or for the given type.
+  ///
+  /// The statistics are only computed while at least one budget is set. Resource types without a budget have no statistics of their own,
+  /// their memory usage only shows up in the global statistics.
+  static MemoryBudgetStats GetMemoryBudgetStats(const ezRTTI* pResourceType = nullptr);
+
+private:
+  /// \brief While UpdateMemoryBudgets() discards quality levels of a resource, its lock count is offset by this value.
+  ///
+  /// The discarding only starts if the lock count is zero, and BeginAcquireResource() waits while the lock count is negative.
+  static constexpr ezInt32 s_iDiscardingLockCount = -(1 << 30);
+
+  static void UpdateMemoryBudgets();
+  static void UpdateMemoryBudgetsEnabled();
+  static void RemoveFromMemoryBudget(ezResource* pResource);
+  static void WaitWhileDiscardingQualityLevels(ezResource* pResource);
+  ///@}
 
   //////////////////////////////////////////////////////////////////////////
   //////////////////////////////////////////////////////////////////////////
@@ -420,14 +483,14 @@ private:
     ezHashTable<ezTempHashedString, ezResource*> m_Resources;
   };
 
-  struct LoadingInfo
+  /// \brief Stores the position of a resource in the loading queue on the resource itself.
+  struct LoadingQueueIndex
   {
-    float m_fPriority = 0;
-    ezResource* m_pResource = nullptr;
-
-    EZ_ALWAYS_INLINE bool operator==(const LoadingInfo& rhs) const { return m_pResource == rhs.m_pResource; }
-    EZ_ALWAYS_INLINE bool operator<(const LoadingInfo& rhs) const { return m_fPriority < rhs.m_fPriority; }
+    EZ_ALWAYS_INLINE static void SetIndex(ezResource* pResource, ezUInt32 uiIndex) { pResource->m_uiLoadingQueueIndex = uiIndex; }
   };
+
+  using LoadingQueue = ezIndexedPriorityQueue<float, ezResource*, LoadingQueueIndex>;
+
   static void EnsureResourceLoadingState(ezResource* pResource, const ezResourceState RequestedState);
   static void PreloadResource(ezResource* pResource);
   static void InternalPreloadResource(ezResource* pResource, bool bHighestPriority);
@@ -437,7 +500,6 @@ private:
   static ezResource* GetResource(const ezRTTI* pRtti, const char* szResourceID, bool bIsReloadable);
   static void RunWorkerTask(ezResource* pResource);
   static void UpdateLoadingDeadlines();
-  static void ReverseBubbleSortStep(ezDeque<LoadingInfo>& data);
   static bool ReloadResource(ezResource* pResource, bool bForce);
 
   static void SetupWorkerTasks();
@@ -5,6 +5,7 @@
 #ifdef BUILDSYSTEM_ENABLE_DUKTAPE_SUPPORT
 
 #  include <Duktape/duktape.h>
+#  include <Foundation/Algorithm/HashingUtils.h>
 #  include <Foundation/IO/FileSystem/FileReader.h>
 
 EZ_CHECK_AT_COMPILETIME(ezDuktapeTypeMask::None == DUK_TYPE_MASK_NONE);
@@ -635,6 +636,103 @@ ezResult ezDuktapeHelper::ExecuteFile(const char* szFile)
   return ExecuteStream(file, szFile);
 }
 
+ezResult ezDuktapeHelper::CompileStringToBytecode(
+  const char* szString, ezDynamicArray<ezUInt8>& out_Bytecode, const char* szDebugName /*= "eval"*/, bool bCompileAsEval /*= false*/)
+{
+  const duk_uint_t uiFlags = bCompileAsEval ? DUK_COMPILE_EVAL : 0;
+
+  duk_push_string(m_pContext, szDebugName);                             // [ filename ]
+  if (duk_pcompile_string_filename(m_pContext, uiFlags, szString) != 0) // [ function/error ]
+  {
+    EZ_LOG_BLOCK("DukTape::CompileStringToBytecode", "Compilation failed");
+
+    ezLog::Error("[duktape]{}", duk_safe_to_string(m_pContext, -1)); // [ error ]
+
+    duk_pop(m_pContext); // [ ]
+    return EZ_FAILURE;
+  }
+
+  duk_dump_function(m_pContext); // [ buffer ]
+
+  duk_size_t uiSize = 0;
+  const void* pBytecode = duk_get_buffer(m_pContext, -1, &uiSize);
+
+  out_Bytecode.SetCountUninitialized(static_cast<ezUInt32>(uiSize));
+  ezMemoryUtils::Copy(out_Bytecode.GetData(), static_cast<const ezUInt8*>(pBytecode), static_cast<size_t>(uiSize));
+
+  duk_pop(m_pContext); // [ ]
+  return EZ_SUCCESS;
+}
+
+static duk_ret_t LoadFunctionSafe(duk_context* pContext, void* pUserData)
+{
+  duk_load_function(pContext);
+  return 1;
+}
+
+ezResult ezDuktapeHelper::ExecuteBytecode(ezArrayPtr<const ezUInt8> bytecode, const char* szDebugName /*= "bytecode"*/)
+{
+  void* pBuffer = duk_push_fixed_buffer(m_pContext, bytecode.GetCount()); // [ buffer ]
+  ezMemoryUtils::Copy(static_cast<ezUInt8*>(pBuffer), bytecode.GetPtr(), bytecode.GetCount());
+
+  // duk_load_function() throws on buffers that don't look like bytecode, which must not end up in the fatal error handler
+  if (duk_safe_call(m_pContext, LoadFunctionSafe, nullptr, 1, 1) != DUK_EXEC_SUCCESS) // [ function/error ]
+  {
+    EZ_LOG_BLOCK("DukTape::ExecuteBytecode", "Loading failed");
+
+    ezLog::Error("[duktape]{}: {}", szDebugName, duk_safe_to_string(m_pContext, -1)); // [ error ]
+
+    duk_pop(m_pContext); // [ ]
+    return EZ_FAILURE;
+  }
+
+  if (duk_pcall(m_pContext, 0) != DUK_EXEC_SUCCESS) // [ result/error ]
+  {
+    EZ_LOG_BLOCK("DukTape::ExecuteBytecode", "Execution failed");
+
+    ezLog::Error("[duktape]{}: {}", szDebugName, duk_safe_to_string(m_pContext, -1)); // [ error ]
+
+    LogStackTrace(-1);
+
+    duk_pop(m_pContext); // [ ]
+    return EZ_FAILURE;
+  }
+
+  duk_pop(m_pContext); // [ ]
+  return EZ_SUCCESS;
+}
+
+// static
+ezUInt32 ezDuktapeHelper::GetBytecodeVersion()
+{
+  // the options that decide which optional data ends up in a dump, see duk_api_bytecode.c
+  static const char s_szConfig[] = ""
+#  if defined(DUK_USE_FASTINT)
+                                   "FASTINT;"
+#  endif
+#  if defined(DUK_USE_DEBUGGER_SUPPORT)
+                                   "DEBUGGER_SUPPORT;"
+#  endif
+#  if defined(DUK_USE_INTEGER_BE)
+                                   "INTEGER_BE;"
+#  endif
+#  if defined(DUK_USE_FUNC_NAME_PROPERTY)
+                                   "FUNC_NAME_PROPERTY;"
+#  endif
+#  if defined(DUK_USE_FUNC_FILENAME_PROPERTY)
+                                   "FUNC_FILENAME_PROPERTY;"
+#  endif
+#  if defined(DUK_USE_PC2LINE)
+                                   "PC2LINE;"
+#  endif
+    ;
+
+  // the opcodes depend on the Duktape version
+  const ezUInt32 uiBuild[] = {static_cast<ezUInt32>(DUK_VERSION), static_cast<ezUInt32>(sizeof(void*))};
+
+  return ezHashingUtils::xxHash32(s_szConfig, sizeof(s_szConfig) - 1, ezHashingUtils::xxHash32(uiBuild, sizeof(uiBuild)));
+}
+
 #endif
 
 
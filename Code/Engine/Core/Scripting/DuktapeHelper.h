@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Core/CoreDLL.h>
+#include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Strings/String.h>
 
@@ -207,6 +208,24 @@ public:
 
   ezResult ExecuteFile(const char* szFile);
 
+  /// \brief Compiles the string and stores its bytecode in out_Bytecode, without executing it.
+  ///
+  /// By default the string is compiled as a program. With bCompileAsEval it is compiled like code passed to eval(), which is what
+  /// Duktape does with module sources.
+  /// Bytecode can only be loaded by the same Duktape build, so it should be stored together with GetBytecodeVersion().
+  ezResult CompileStringToBytecode(const char* szString, ezDynamicArray<ezUInt8>& out_Bytecode, const char* szDebugName = "eval", bool bCompileAsEval = false);
+
+  /// \brief Executes bytecode that was created with CompileStringToBytecode().
+  ///
+  /// Duktape only rejects buffers that don't start like bytecode at all, it does not validate the content.
+  /// So this must only be called with bytecode that matches GetBytecodeVersion().
+  ezResult ExecuteBytecode(ezArrayPtr<const ezUInt8> bytecode, const char* szDebugName = "bytecode");
+
+  /// \brief Returns a value that changes whenever bytecode compiled by a different Duktape build can't be loaded anymore.
+  ///
+  /// This covers the Duktape version, the pointer size and the configuration options that change the bytecode format.
+  static ezUInt32 GetBytecodeVersion();
+
   ///@}
 
 public:
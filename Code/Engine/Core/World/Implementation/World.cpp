@@ -7,7 +7,6 @@
 #include <Core/World/WorldModule.h>
 #include <Foundation/Memory/FrameAllocator.h>
 #include <Foundation/Profiling/Profiling.h>
-#include <Foundation/Utilities/Stats.h>
 
 ezStaticArray<ezWorld*, ezWorld::GetMaxNumWorlds()> ezWorld::s_Worlds;
 
@@ -449,13 +448,7 @@ void ezWorld::Update()
 
   EZ_LOG_BLOCK(m_Data.m_sName.GetData());
 
-  {
-    ezStringBuilder sStatName;
-    sStatName.Format("World Update/{0}/Game Object Count", m_Data.m_sName);
-
-    ezStringBuilder sStatValue;
-    ezStats::SetStat(sStatName, GetObjectCount());
-  }
+  m_Data.m_GameObjectCountMetric.Set(GetObjectCount());
 
   m_Data.m_Clock.SetPaused(!m_Data.m_bSimulateWorld);
   m_Data.m_Clock.Update();
@@ -104,12 +104,18 @@ namespace ezInternal
     }
 
     m_Clock.SetTimeStepSmoothing(m_pTimeStepSmoothing.Borrow());
+
+    ezStringBuilder sStatName;
+    sStatName.Format("World Update/{0}/Game Object Count", m_sName);
+    m_GameObjectCountMetric = ezMetrics::RegisterGauge(sStatName);
   }
 
   WorldData::~WorldData()
   {
     EZ_ASSERT_DEV(m_Modules.IsEmpty(), "Modules should be cleaned up already.");
 
+    ezMetrics::Unregister(m_GameObjectCountMetric);
+
     // delete all transformation data
     for (ezUInt32 uiHierarchyIndex = 0; uiHierarchyIndex < HierarchyType::COUNT; ++uiHierarchyIndex)
     {
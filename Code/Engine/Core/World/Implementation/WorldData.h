@@ -6,6 +6,7 @@
 #include <Foundation/Memory/FrameAllocator.h>
 #include <Foundation/Threading/DelegateTask.h>
 #include <Foundation/Time/Clock.h>
+#include <Foundation/Utilities/Metrics.h>
 
 #include <Core/World/GameObject.h>
 #include <Core/World/WorldDesc.h>
@@ -201,6 +202,8 @@ namespace ezInternal
     ezClock m_Clock;
     ezRandom m_Random;
 
+    ezMetricGauge m_GameObjectCountMetric;
+
     struct QueuedMsgMetaData
     {
       EZ_DECLARE_POD_TYPE();
@@ -71,6 +71,7 @@
 
 // Other Features
 #define EZ_USE_PROFILING EZ_OFF
+#define EZ_USE_MUTEX_PROFILING EZ_OFF
 
 // Hashed String
 /// \brief Ref counting on hashed strings adds the possibility to cleanup unused strings. Since ref counting has a performance overhead it is disabled by default.
@@ -22,9 +22,10 @@ ezIpcChannelEnet::ezIpcChannelEnet(const char* szAddress, Mode::Enum mode)
 
 ezIpcChannelEnet::~ezIpcChannelEnet()
 {
-  m_Network->ShutdownConnection();
-
+  // make sure the message loop doesn't tick the channel anymore, before the connection is shut down
   m_pOwner->RemoveChannel(this);
+
+  m_Network->ShutdownConnection();
 }
 
 void ezIpcChannelEnet::InternalConnect()
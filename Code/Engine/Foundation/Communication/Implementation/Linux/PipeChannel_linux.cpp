@@ -0,0 +1,581 @@
+#include <FoundationPCH.h>
+
+#if EZ_ENABLED(EZ_PLATFORM_LINUX)
+
+#include <Foundation/Communication/Implementation/Linux/PipeChannel_linux.h>
+#include <Foundation/Communication/Implementation/MessageLoop.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/Thread.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace
+{
+  enum : ezUInt32
+  {
+    SHARED_MEMORY_MAGIC = 'EZSM',
+    SHARED_MEMORY_VERSION = 2,
+  };
+
+  struct RecordHeader
+  {
+    enum Type : ezUInt32
+    {
+      Inline, ///< The message follows directly after the header.
+      Arena,  ///< The message is stored in the arena, only its position in the arena follows after the header.
+    };
+
+    ezUInt32 m_uiMessageSize;
+    Type m_Type;
+  };
+
+  // Records always start at a multiple of the header size, so a header is never split at the end of the ring buffer.
+  EZ_ALWAYS_INLINE ezUInt32 GetRecordSize(ezUInt32 uiPayloadSize)
+  {
+    return ezMemoryUtils::AlignSize<ezUInt32>(sizeof(RecordHeader) + uiPayloadSize, sizeof(RecordHeader));
+  }
+
+  void FutexWait(volatile ezInt32& iFutex, ezInt32 iExpectedValue, ezTime timeout)
+  {
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(timeout.GetSeconds());
+    ts.tv_nsec = static_cast<long>((timeout.GetSeconds() - ts.tv_sec) * 1000000000.0);
+
+    // not FUTEX_PRIVATE_FLAG, the futex is shared with the other process
+    syscall(SYS_futex, &iFutex, FUTEX_WAIT, iExpectedValue, &ts, nullptr, 0);
+  }
+
+  void FutexWake(volatile ezInt32& iFutex)
+  {
+    syscall(SYS_futex, &iFutex, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+  }
+
+  bool IsProcessAlive(ezInt32 iProcessID)
+  {
+    return iProcessID != 0 && (kill(iProcessID, 0) == 0 || errno != ESRCH);
+  }
+} // namespace
+
+/// \brief State of one side of the channel, only written by that side, except for m_iWakeUp.
+struct ezPipeChannel_linux::SharedSide
+{
+  volatile ezInt32 m_iProcessID; ///< Zero while the side is not connected.
+  volatile ezInt32 m_iWakeUp;    ///< Futex that is incremented whenever there is new work for this side.
+  volatile ezInt32 m_iSleeping;  ///< Whether this side waits on m_iWakeUp, so that the other side only needs a syscall when necessary.
+  volatile ezInt32 m_iReadPos;   ///< Number of bytes consumed from the incoming ring buffer, wraps around.
+  volatile ezInt32 m_iWritePos;  ///< Number of bytes written into the outgoing ring buffer, wraps around.
+  volatile ezInt32 m_iArenaReadPos; ///< Number of bytes released in the incoming arena, wraps around.
+};
+
+struct ezPipeChannel_linux::SharedMemory
+{
+  ezUInt32 m_uiMagic;
+  ezUInt32 m_uiVersion;
+  EZ_ALIGN_64(SharedSide m_Sides[2]);
+  EZ_ALIGN_64(ezUInt8 m_RingBuffers[2][RING_BUFFER_SIZE]); ///< Ring buffer i is written by side i.
+  EZ_ALIGN_64(ezUInt8 m_Arenas[2][ARENA_SIZE]);            ///< Arena i is written by side i, pages are only allocated once they are used.
+};
+
+class ezPipeChannelThread_linux : public ezThread
+{
+public:
+  ezPipeChannelThread_linux(ezPipeChannel_linux* pChannel)
+    : ezThread("ezPipeChannelThread")
+    , m_pChannel(pChannel)
+  {
+  }
+
+  virtual ezUInt32 Run() override
+  {
+    m_pChannel->RunThread();
+    return 0;
+  }
+
+private:
+  ezPipeChannel_linux* m_pChannel;
+};
+
+ezPipeChannel_linux::ezPipeChannel_linux(const char* szAddress, Mode::Enum mode)
+  : ezIpcChannel(szAddress, mode)
+{
+  m_iSide = (mode == Mode::Server) ? 0 : 1;
+
+  ezStringBuilder sAddress = szAddress;
+  sAddress.ReplaceAll("/", "_");
+
+  ezStringBuilder sName;
+  sName.Set("/ez-ipc-", sAddress);
+  m_sName = sName;
+
+  // the client waits for the server when it connects
+  if (m_Mode == Mode::Server)
+  {
+    OpenSharedMemory(true);
+  }
+
+  m_pOwner->AddChannel(this);
+}
+
+ezPipeChannel_linux::~ezPipeChannel_linux()
+{
+  if (m_Connected)
+  {
+    Disconnect();
+  }
+  while (m_Connected)
+  {
+    ezThreadUtils::Sleep(ezTime::Milliseconds(10));
+  }
+
+  m_pOwner->RemoveChannel(this);
+
+  // in case the channel was never connected, the queued disconnect has just been removed again
+  StopThread();
+  CloseSharedMemory();
+}
+
+// static
+void ezPipeChannel_linux::WakeUpSide(SharedSide& side)
+{
+  ezAtomicUtils::Increment(side.m_iWakeUp);
+
+  if (ezAtomicUtils::Read(side.m_iSleeping) != 0)
+  {
+    FutexWake(side.m_iWakeUp);
+  }
+}
+
+bool ezPipeChannel_linux::OpenSharedMemory(bool bReportErrors)
+{
+  const char* szName = m_sName.GetData();
+
+  int fd = -1;
+  if (m_Mode == Mode::Server)
+  {
+    // an object with the same name can only be a leftover of a crashed process
+    shm_unlink(szName);
+
+    fd = shm_open(szName, O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd >= 0 && ftruncate(fd, sizeof(SharedMemory)) != 0)
+    {
+      close(fd);
+      shm_unlink(szName);
+      fd = -1;
+    }
+  }
+  else
+  {
+    fd = shm_open(szName, O_RDWR, 0);
+  }
+
+  if (fd < 0)
+  {
+    // a missing object only means that the server is not there yet
+    if (bReportErrors && (m_Mode == Mode::Server || errno != ENOENT))
+    {
+      ezLog::Error("Could not open shared memory '{0}': {1}", szName, strerror(errno));
+    }
+    return false;
+  }
+
+  void* pMemory = mmap(nullptr, sizeof(SharedMemory), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+
+  if (pMemory == MAP_FAILED)
+  {
+    if (bReportErrors)
+    {
+      ezLog::Error("Could not map shared memory '{0}': {1}", szName, strerror(errno));
+    }
+    if (m_Mode == Mode::Server)
+      shm_unlink(szName);
+    return false;
+  }
+
+  SharedMemory* pShared = static_cast<SharedMemory*>(pMemory);
+
+  if (m_Mode == Mode::Server)
+  {
+    // the object is zero initialized by ftruncate
+    pShared->m_uiMagic = SHARED_MEMORY_MAGIC;
+    pShared->m_uiVersion = SHARED_MEMORY_VERSION;
+  }
+  else if (pShared->m_uiMagic != SHARED_MEMORY_MAGIC || pShared->m_uiVersion != SHARED_MEMORY_VERSION)
+  {
+    if (bReportErrors)
+    {
+      ezLog::Error("Shared memory '{0}' has an unknown format", szName);
+    }
+    munmap(pMemory, sizeof(SharedMemory));
+    return false;
+  }
+
+  m_pShared = pShared;
+  return true;
+}
+
+void ezPipeChannel_linux::CloseSharedMemory()
+{
+  if (m_pShared == nullptr)
+    return;
+
+  ezAtomicUtils::Set(m_pShared->m_Sides[m_iSide].m_iProcessID, 0);
+  WakeUpSide(m_pShared->m_Sides[1 - m_iSide]);
+
+  munmap(m_pShared, sizeof(SharedMemory));
+  m_pShared = nullptr;
+
+  if (m_Mode == Mode::Server)
+  {
+    shm_unlink(m_sName);
+  }
+}
+
+void ezPipeChannel_linux::StartThread()
+{
+  if (m_pThread != nullptr)
+    return;
+
+  m_bQuitThread = false;
+  m_pThread = EZ_DEFAULT_NEW(ezPipeChannelThread_linux, this);
+  m_pThread->Start();
+}
+
+void ezPipeChannel_linux::StopThread()
+{
+  if (m_pThread == nullptr)
+    return;
+
+  m_bQuitThread = true;
+
+  // a client that still waits for the server doesn't sleep on the futex
+  if (m_Mode == Mode::Server || m_Connected)
+  {
+    WakeUpSide(m_pShared->m_Sides[m_iSide]);
+  }
+
+  m_pThread->Join();
+  EZ_DEFAULT_DELETE(m_pThread);
+}
+
+void ezPipeChannel_linux::InternalConnect()
+{
+  if (m_pThread != nullptr)
+    return;
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+  if (m_ThreadId == 0)
+    m_ThreadId = ezThreadUtils::GetCurrentThreadID();
+#endif
+
+  if (m_Mode == Mode::Server)
+  {
+    if (m_pShared == nullptr)
+      return;
+
+    ezAtomicUtils::Set(m_pShared->m_Sides[0].m_iProcessID, static_cast<ezInt32>(getpid()));
+  }
+
+  // the server is connected by the channel thread as soon as a client shows up, the client waits for the server there
+  StartThread();
+}
+
+void ezPipeChannel_linux::InternalDisconnect()
+{
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+  if (m_ThreadId != 0)
+    EZ_ASSERT_DEBUG(m_ThreadId == ezThreadUtils::GetCurrentThreadID(), "Function must be called from worker thread!");
+#endif
+
+  StopThread();
+  CloseSharedMemory();
+
+  bool bWasConnected = false;
+  {
+    EZ_LOCK(m_OutputQueueMutex);
+    m_OutputQueue.Clear();
+    bWasConnected = m_Connected;
+    m_Connected = false;
+  }
+
+  // the channel thread already reported it, if the other side disconnected first
+  if (bWasConnected)
+  {
+    m_Events.Broadcast(ezIpcChannelEvent(m_Mode == Mode::Client ? ezIpcChannelEvent::DisconnectedFromServer : ezIpcChannelEvent::DisconnectedFromClient, this));
+  }
+
+  // Raise in case another thread is waiting for new messages (as we would sleep forever otherwise).
+  m_IncomingMessages.RaiseSignal();
+}
+
+void ezPipeChannel_linux::InternalSend()
+{
+  // messages that are queued before the connection is established are sent right after connecting
+  if (m_Connected)
+  {
+    WakeUpSide(m_pShared->m_Sides[m_iSide]);
+  }
+}
+
+bool ezPipeChannel_linux::NeedWakeup() const
+{
+  return true;
+}
+
+void ezPipeChannel_linux::RunThread()
+{
+  if (m_Mode == Mode::Client && !WaitForServer())
+    return;
+
+  SharedSide& self = m_pShared->m_Sides[m_iSide];
+  ezTime lastConnectionCheck;
+
+  while (!m_bQuitThread)
+  {
+    const ezInt32 iWakeUp = ezAtomicUtils::Read(self.m_iWakeUp);
+
+    bool bDidWork = false;
+    if (m_Connected)
+    {
+      bDidWork |= ProcessIncomingMessages();
+      bDidWork |= ProcessOutgoingMessages();
+    }
+
+    if (bDidWork)
+      continue;
+
+    // checking whether the other process is still alive needs a syscall, so it is only done from time to time
+    const ezTime now = ezTime::Now();
+    const bool bCheckProcess = (now - lastConnectionCheck) >= ezTime::Milliseconds(100);
+    if (bCheckProcess)
+      lastConnectionCheck = now;
+
+    const bool bWasConnected = m_Connected;
+    if (!UpdateConnection(bCheckProcess))
+      break;
+
+    // send the messages that were queued before the client connected
+    if (m_Connected != bWasConnected)
+      continue;
+
+    ezAtomicUtils::Set(self.m_iSleeping, 1);
+    FutexWait(self.m_iWakeUp, iWakeUp, ezTime::Milliseconds(100));
+    ezAtomicUtils::Set(self.m_iSleeping, 0);
+  }
+}
+
+bool ezPipeChannel_linux::WaitForServer()
+{
+  bool bReportErrors = true;
+
+  // the server may not exist yet or not have called Connect() yet, so keep trying until it shows up
+  while (!m_bQuitThread)
+  {
+    if (OpenSharedMemory(bReportErrors))
+    {
+      if (IsProcessAlive(ezAtomicUtils::Read(m_pShared->m_Sides[0].m_iProcessID)))
+      {
+        ezAtomicUtils::Set(m_pShared->m_Sides[1].m_iProcessID, static_cast<ezInt32>(getpid()));
+
+        // publishes m_pShared to the other threads
+        m_Connected = true;
+        m_Events.Broadcast(ezIpcChannelEvent(ezIpcChannelEvent::ConnectedToServer, this));
+
+        WakeUpSide(m_pShared->m_Sides[0]);
+        return true;
+      }
+
+      // this may also be the leftover of a crashed server, which the next server replaces with a new object
+      CloseSharedMemory();
+    }
+
+    bReportErrors = false;
+    ezThreadUtils::Sleep(ezTime::Milliseconds(50));
+  }
+
+  return false;
+}
+
+bool ezPipeChannel_linux::UpdateConnection(bool bCheckProcess)
+{
+  const ezInt32 iOtherProcessID = ezAtomicUtils::Read(m_pShared->m_Sides[1 - m_iSide].m_iProcessID);
+
+  if (!m_Connected)
+  {
+    if (iOtherProcessID != 0)
+    {
+      EZ_ASSERT_DEBUG(m_Mode == Mode::Server, "Only the server waits for the other side to connect.");
+      m_Connected = true;
+      m_Events.Broadcast(ezIpcChannelEvent(ezIpcChannelEvent::ConnectedToClient, this));
+    }
+
+    return true;
+  }
+
+  if (iOtherProcessID != 0 && (!bCheckProcess || IsProcessAlive(iOtherProcessID)))
+    return true;
+
+  // the other side has disconnected or crashed, a channel cannot be reconnected, so the thread stops here
+  {
+    EZ_LOCK(m_OutputQueueMutex);
+    m_OutputQueue.Clear();
+    m_Connected = false;
+  }
+
+  m_Events.Broadcast(ezIpcChannelEvent(m_Mode == Mode::Client ? ezIpcChannelEvent::DisconnectedFromServer : ezIpcChannelEvent::DisconnectedFromClient, this));
+  m_IncomingMessages.RaiseSignal();
+  return false;
+}
+
+bool ezPipeChannel_linux::ProcessIncomingMessages()
+{
+  SharedSide& self = m_pShared->m_Sides[m_iSide];
+  SharedSide& other = m_pShared->m_Sides[1 - m_iSide];
+  const ezUInt8* pRingBuffer = m_pShared->m_RingBuffers[1 - m_iSide];
+  const ezUInt8* pArena = m_pShared->m_Arenas[1 - m_iSide];
+
+  ezUInt32 uiReadPos = static_cast<ezUInt32>(self.m_iReadPos);
+  const ezUInt32 uiWritePos = static_cast<ezUInt32>(ezAtomicUtils::Read(other.m_iWritePos));
+
+  if (uiReadPos == uiWritePos)
+    return false;
+
+  while (uiReadPos != uiWritePos)
+  {
+    const ezUInt32 uiOffset = uiReadPos % RING_BUFFER_SIZE;
+    const RecordHeader header = *reinterpret_cast<const RecordHeader*>(pRingBuffer + uiOffset);
+    const ezUInt32 uiPayloadOffset = (uiOffset + sizeof(RecordHeader)) % RING_BUFFER_SIZE;
+
+    ezUInt32 uiPayloadSize = header.m_uiMessageSize;
+
+    if (header.m_Type == RecordHeader::Inline)
+    {
+      // the message is de-serialized directly from the ring buffer, only a message that wraps around goes through the accumulator
+      const ezUInt32 uiFirstPart = ezMath::Min<ezUInt32>(uiPayloadSize, RING_BUFFER_SIZE - uiPayloadOffset);
+      ReceiveMessageData(ezArrayPtr<const ezUInt8>(pRingBuffer + uiPayloadOffset, uiFirstPart));
+
+      if (uiFirstPart < uiPayloadSize)
+      {
+        ReceiveMessageData(ezArrayPtr<const ezUInt8>(pRingBuffer, uiPayloadSize - uiFirstPart));
+      }
+    }
+    else
+    {
+      // messages never wrap around in the arena, so they are always de-serialized in place
+      const ezUInt32 uiArenaPos = *reinterpret_cast<const ezUInt32*>(pRingBuffer + uiPayloadOffset);
+      uiPayloadSize = sizeof(ezUInt32);
+
+      ReceiveMessageData(ezArrayPtr<const ezUInt8>(pArena + uiArenaPos % ARENA_SIZE, header.m_uiMessageSize));
+
+      ezAtomicUtils::Set(self.m_iArenaReadPos, static_cast<ezInt32>(uiArenaPos + ezMemoryUtils::AlignSize<ezUInt32>(header.m_uiMessageSize, ARENA_ALIGNMENT)));
+    }
+
+    uiReadPos += GetRecordSize(uiPayloadSize);
+
+    // release the space right away, so that the sender can continue while the next message is de-serialized
+    ezAtomicUtils::Set(self.m_iReadPos, static_cast<ezInt32>(uiReadPos));
+    WakeUpSide(other);
+  }
+
+  return true;
+}
+
+bool ezPipeChannel_linux::ProcessOutgoingMessages()
+{
+  SharedSide& self = m_pShared->m_Sides[m_iSide];
+  SharedSide& other = m_pShared->m_Sides[1 - m_iSide];
+  ezUInt8* pRingBuffer = m_pShared->m_RingBuffers[m_iSide];
+  ezUInt8* pArena = m_pShared->m_Arenas[m_iSide];
+
+  ezUInt32 uiWritePos = static_cast<ezUInt32>(self.m_iWritePos);
+  const ezUInt32 uiReadPos = static_cast<ezUInt32>(ezAtomicUtils::Read(other.m_iReadPos));
+  const ezUInt32 uiArenaReadPos = static_cast<ezUInt32>(ezAtomicUtils::Read(other.m_iArenaReadPos));
+
+  bool bDidWork = false;
+
+  while (true)
+  {
+    const ezMemoryStreamStorage* pStorage = nullptr;
+    {
+      EZ_LOCK(m_OutputQueueMutex);
+      if (m_OutputQueue.IsEmpty())
+        break;
+
+      pStorage = &m_OutputQueue.PeekFront();
+    }
+
+    const ezUInt32 uiMessageSize = pStorage->GetStorageSize();
+    const bool bArena = uiMessageSize > ARENA_THRESHOLD;
+    const ezUInt32 uiPayloadSize = bArena ? sizeof(ezUInt32) : uiMessageSize;
+    const ezUInt32 uiRecordSize = GetRecordSize(uiPayloadSize);
+
+    if (uiMessageSize > ARENA_SIZE)
+    {
+      ezLog::Error("Message of {0} bytes is too large for pipe channel '{1}'", uiMessageSize, m_sName);
+
+      EZ_LOCK(m_OutputQueueMutex);
+      m_OutputQueue.PopFront();
+      continue;
+    }
+
+    // wait until the other side has made room, it wakes us up after reading
+    if (uiRecordSize > RING_BUFFER_SIZE - (uiWritePos - uiReadPos))
+      break;
+
+    const ezUInt32 uiOffset = uiWritePos % RING_BUFFER_SIZE;
+    const ezUInt32 uiPayloadOffset = (uiOffset + sizeof(RecordHeader)) % RING_BUFFER_SIZE;
+
+    if (bArena)
+    {
+      // a message that doesn't fit before the end of the arena starts at the beginning again, the gap is released along with it
+      const ezUInt32 uiAllocationSize = ezMemoryUtils::AlignSize<ezUInt32>(uiMessageSize, ARENA_ALIGNMENT);
+      const ezUInt32 uiArenaOffset = m_uiArenaWritePos % ARENA_SIZE;
+      const ezUInt32 uiArenaPos = (uiArenaOffset + uiAllocationSize <= ARENA_SIZE) ? m_uiArenaWritePos : m_uiArenaWritePos + (ARENA_SIZE - uiArenaOffset);
+
+      if (uiArenaPos + uiAllocationSize - uiArenaReadPos > ARENA_SIZE)
+        break;
+
+      ezMemoryUtils::Copy(pArena + uiArenaPos % ARENA_SIZE, pStorage->GetData(), uiMessageSize);
+      *reinterpret_cast<ezUInt32*>(pRingBuffer + uiPayloadOffset) = uiArenaPos;
+
+      m_uiArenaWritePos = uiArenaPos + uiAllocationSize;
+    }
+    else
+    {
+      const ezUInt32 uiFirstPart = ezMath::Min<ezUInt32>(uiMessageSize, RING_BUFFER_SIZE - uiPayloadOffset);
+      ezMemoryUtils::Copy(pRingBuffer + uiPayloadOffset, pStorage->GetData(), uiFirstPart);
+      ezMemoryUtils::Copy(pRingBuffer, pStorage->GetData() + uiFirstPart, uiMessageSize - uiFirstPart);
+    }
+
+    RecordHeader& header = *reinterpret_cast<RecordHeader*>(pRingBuffer + uiOffset);
+    header.m_uiMessageSize = uiMessageSize;
+    header.m_Type = bArena ? RecordHeader::Arena : RecordHeader::Inline;
+
+    uiWritePos += uiRecordSize;
+
+    // publishes the record, the atomic operation is a full barrier
+    ezAtomicUtils::Set(self.m_iWritePos, static_cast<ezInt32>(uiWritePos));
+    WakeUpSide(other);
+
+    {
+      EZ_LOCK(m_OutputQueueMutex);
+      m_OutputQueue.PopFront();
+    }
+
+    bDidWork = true;
+  }
+
+  return bDidWork;
+}
+
+#endif
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Communication_Implementation_Linux_PipeChannel_linux);
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <Foundation/FoundationInternal.h>
+EZ_FOUNDATION_INTERNAL_HEADER
+
+#if EZ_ENABLED(EZ_PLATFORM_LINUX)
+
+#include <Foundation/Basics.h>
+#include <Foundation/Communication/IpcChannel.h>
+#include <Foundation/Strings/String.h>
+
+class ezPipeChannelThread_linux;
+
+/// \brief IPC channel that exchanges messages through a pair of ring buffers in shared memory.
+///
+/// The server creates a shared memory object named after the address, the client maps the existing object.
+/// Each direction has its own ring buffer. Messages are copied into the ring buffer by the sender and de-serialized in place
+/// by the receiver, so no data goes through the kernel. Both sides sleep on a futex in the shared memory while there is
+/// nothing to do and wake each other up after writing data or freeing space.
+///
+/// Large messages (e.g. viewport images, mesh data or document snapshots) are written into a second, larger ring buffer per
+/// direction, the arena, in which every message is stored contiguously. Only its offset is passed through the ring buffer and the
+/// receiver de-serializes the message directly from the arena. Everything lives in the one shared memory object of the channel,
+/// which the server removes again when it closes the channel, or when it is started again after a crash.
+///
+/// Reading and writing is done on a thread owned by the channel, the message loop only forwards new work to it.
+/// A client that is created before the server keeps trying to connect from that thread.
+class EZ_FOUNDATION_DLL ezPipeChannel_linux : public ezIpcChannel
+{
+public:
+  ezPipeChannel_linux(const char* szAddress, Mode::Enum mode);
+  ~ezPipeChannel_linux();
+
+private:
+  friend class ezPipeChannelThread_linux;
+
+  struct SharedMemory;
+  struct SharedSide;
+
+  static void WakeUpSide(SharedSide& side);
+
+  bool OpenSharedMemory(bool bReportErrors);
+  void CloseSharedMemory();
+  void StartThread();
+  void StopThread();
+
+  // All functions from here on down are run from worker thread only
+  virtual void InternalConnect() override;
+  virtual void InternalDisconnect() override;
+  virtual void InternalSend() override;
+  virtual bool NeedWakeup() const override;
+
+  // All functions from here on down are run from the channel thread only
+  void RunThread();
+  bool WaitForServer();
+  bool ProcessIncomingMessages();
+  bool ProcessOutgoingMessages();
+  bool UpdateConnection(bool bCheckProcess);
+
+  enum Constants : ezUInt32
+  {
+    RING_BUFFER_SIZE = 1024 * 1024, ///< Size of the ring buffer for each direction.
+    ARENA_SIZE = MAX_MESSAGE_SIZE,  ///< Size of the arena for each direction, every message that the receiver accepts fits into it.
+    ARENA_THRESHOLD = 1024 * 64,    ///< Messages that are larger than this are sent through the arena.
+    ARENA_ALIGNMENT = 64,           ///< Alignment of the messages in the arena.
+  };
+
+  // Setup in ctor
+  ezString m_sName; ///< Name of the shared memory object.
+  int m_iSide = 0;  ///< Index of this side in the shared memory, 0 for the server and 1 for the client.
+
+  /// The server maps the shared memory in the ctor. The client maps it from the channel thread once the server is there,
+  /// other threads only access it while the client is connected.
+  SharedMemory* m_pShared = nullptr;
+
+  // Owned by the channel thread while it is running
+  ezPipeChannelThread_linux* m_pThread = nullptr;
+  ezAtomicInteger32 m_bQuitThread = false;
+  ezUInt32 m_uiArenaWritePos = 0; ///< Number of bytes allocated in the outgoing arena, wraps around.
+};
+
+#endif
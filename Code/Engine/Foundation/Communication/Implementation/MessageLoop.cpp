@@ -93,7 +93,17 @@ void ezMessageLoop::RunLoop()
   {
     if (m_bCallTickFunction)
     {
-      for (ezIpcChannel* pChannel : m_AllAddedChannels)
+      // RemoveChannel() waits for this lock, so a channel can't be ticked while it is destroyed
+      EZ_LOCK(m_TickMutex);
+
+      // ticking may take a while, it must not block threads that queue new tasks
+      ezHybridArray<ezIpcChannel*, 8> channels;
+      {
+        EZ_LOCK(m_TasksMutex);
+        channels = m_AllAddedChannels;
+      }
+
+      for (ezIpcChannel* pChannel : channels)
       {
         if (pChannel->RequiresRegularTick())
         {
@@ -178,6 +188,7 @@ void ezMessageLoop::AddChannel(ezIpcChannel* pChannel)
 
 void ezMessageLoop::RemoveChannel(ezIpcChannel* pChannel)
 {
+  EZ_LOCK(m_TickMutex);
   EZ_LOCK(m_TasksMutex);
 
   m_AllAddedChannels.RemoveAndSwap(pChannel);
@@ -54,6 +54,7 @@ protected:
   bool m_bCallTickFunction = false;
   class ezLoopThread* m_pUpdateThread = nullptr;
 
+  ezMutex m_TickMutex; ///< Held while the channels are ticked.
   ezMutex m_TasksMutex;
   ezDynamicArray<ezIpcChannel*> m_ConnectQueue;
   ezDynamicArray<ezIpcChannel*> m_DisconnectQueue;
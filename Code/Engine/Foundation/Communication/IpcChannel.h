@@ -43,6 +43,8 @@ public:
   };
   virtual ~ezIpcChannel();
   /// \brief Creates an IPC communication channel using pipes.
+  ///
+  /// On Windows this is a named pipe, on Linux the channel is a pair of ring buffers in shared memory.
   /// \param szAddress Name of the pipe, must be unique on a system and less than 200 characters.
   /// \param mode Whether to run in client or server mode.
   static ezIpcChannel* CreatePipeChannel(const char* szAddress, Mode::Enum mode);
@@ -93,6 +95,7 @@ protected:
   void FlushPendingOperations();
 
 private:
+  void DeserializeMessage(ezArrayPtr<const ezUInt8> messageData);
   void EnqueueMessage(ezUniquePtr<ezProcessMessage>&& msg);
   void SwapWorkQueue(ezDeque<ezUniquePtr<ezProcessMessage>>& messages);
 
@@ -0,0 +1,335 @@
+#pragma once
+
+#include <Foundation/Algorithm/HashingUtils.h>
+#include <Foundation/Math/Math.h>
+#include <Foundation/Memory/AllocatorWrapper.h>
+#include <Foundation/Types/ArrayPtr.h>
+
+/// \brief Implementation of a hashtable which stores key/value pairs, optimized for fast lookups.
+///
+/// The interface is the same as the one of ezHashTable, but the memory layout is different:
+/// Every slot has one control byte, which is either 'empty', 'deleted' or stores 7 bits of the hash of the key in that slot.
+/// The control bytes are grouped into blocks of 16, which are compared against the searched hash with a single SSE2 instruction,
+/// so that on average only one key has to be compared per lookup. Probing happens group by group instead of slot by slot.
+///
+/// Removed slots are marked as free again right away, if their group still has free slots, otherwise they are marked as deleted.
+/// Deleted slots are reused by insertions and removed whenever the table needs to be rehashed, which happens when there
+/// are no free slots left. A table that has lots of deleted slots is rehashed without growing, so deleted slots can't pile up.
+///
+/// All insertion/erasure/lookup functions take O(1) time on average. The table grows when the load gets greater than 87.5%.
+/// Insertions and removals invalidate iterators and pointers to values.
+///
+/// The hash function can be customized by providing a Hasher helper class like ezHashHelper. Just as with ezHashTable,
+/// lookups can be done with every key type that the Hasher supports (e.g. 'const char*' for ezString keys).
+///
+/// \see ezHashHelper
+template <typename KeyType, typename ValueType, typename Hasher>
+class ezFlatHashTableBase
+{
+public:
+  /// \brief Const iterator.
+  struct ConstIterator
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    /// \brief Checks whether this iterator points to a valid element.
+    bool IsValid() const;
+
+    /// \brief Checks whether the two iterators point to the same element.
+    bool operator==(const typename ezFlatHashTableBase<KeyType, ValueType, Hasher>::ConstIterator& rhs) const;
+
+    /// \brief Checks whether the two iterators point to the same element.
+    bool operator!=(const typename ezFlatHashTableBase<KeyType, ValueType, Hasher>::ConstIterator& rhs) const;
+
+    /// \brief Returns the 'key' of the element that this iterator points to.
+    const KeyType& Key() const;
+
+    /// \brief Returns the 'value' of the element that this iterator points to.
+    const ValueType& Value() const;
+
+    /// \brief Advances the iterator to the next element in the map. The iterator will not be valid anymore, if the end is reached.
+    void Next();
+
+    /// \brief Shorthand for 'Next'
+    void operator++();
+
+    /// \brief Returns '*this' to enable foreach
+    EZ_ALWAYS_INLINE ConstIterator& operator*() { return *this; }
+
+  protected:
+    friend class ezFlatHashTableBase<KeyType, ValueType, Hasher>;
+
+    explicit ConstIterator(const ezFlatHashTableBase<KeyType, ValueType, Hasher>& hashTable);
+    void SetToBegin();
+    void SetToEnd();
+
+    const ezFlatHashTableBase<KeyType, ValueType, Hasher>* m_hashTable = nullptr;
+    ezUInt32 m_uiCurrentIndex = 0; // current element index that this iterator points to.
+  };
+
+  /// \brief Iterator with write access.
+  struct Iterator : public ConstIterator
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    /// \brief Creates a new iterator from another.
+    EZ_ALWAYS_INLINE Iterator(const Iterator& rhs);
+
+    /// \brief Assigns one iterator no another.
+    EZ_ALWAYS_INLINE void operator=(const Iterator& rhs);
+
+    // this is required to pull in the const version of this function
+    using ConstIterator::Value;
+
+    /// \brief Returns the 'value' of the element that this iterator points to.
+    EZ_FORCE_INLINE ValueType& Value();
+
+    /// \brief Returns '*this' to enable foreach
+    EZ_ALWAYS_INLINE Iterator& operator*() { return *this; }
+
+  private:
+    friend class ezFlatHashTableBase<KeyType, ValueType, Hasher>;
+
+    explicit Iterator(const ezFlatHashTableBase<KeyType, ValueType, Hasher>& hashTable);
+  };
+
+protected:
+  /// \brief Creates an empty hashtable. Does not allocate any data yet.
+  ezFlatHashTableBase(ezAllocatorBase* pAllocator);
+
+  /// \brief Creates a copy of the given hashtable.
+  ezFlatHashTableBase(const ezFlatHashTableBase<KeyType, ValueType, Hasher>& rhs, ezAllocatorBase* pAllocator);
+
+  /// \brief Moves data from an existing hashtable into this one.
+  ezFlatHashTableBase(ezFlatHashTableBase<KeyType, ValueType, Hasher>&& rhs, ezAllocatorBase* pAllocator);
+
+  /// \brief Destructor.
+  ~ezFlatHashTableBase();
+
+  /// \brief Copies the data from another hashtable into this one.
+  void operator=(const ezFlatHashTableBase<KeyType, ValueType, Hasher>& rhs);
+
+  /// \brief Moves data from an existing hashtable into this one.
+  void operator=(ezFlatHashTableBase<KeyType, ValueType, Hasher>&& rhs);
+
+public:
+  /// \brief Compares this table to another table.
+  bool operator==(const ezFlatHashTableBase<KeyType, ValueType, Hasher>& rhs) const;
+
+  /// \brief Compares this table to another table.
+  bool operator!=(const ezFlatHashTableBase<KeyType, ValueType, Hasher>& rhs) const;
+
+  /// \brief Expands the hashtable by over-allocating the internal storage so that the given number of entries can be inserted
+  /// without growing the table again.
+  void Reserve(ezUInt32 uiCapacity);
+
+  /// \brief Tries to compact the hashtable to avoid wasting memory. This also removes all slots that are marked as deleted.
+  ///
+  /// The resulting capacity is at least 'GetCount' (no elements get removed).
+  /// Will deallocate all data, if the hashtable is empty.
+  void Compact();
+
+  /// \brief Returns the number of active entries in the table.
+  ezUInt32 GetCount() const;
+
+  /// \brief Returns true, if the hashtable does not contain any elements.
+  bool IsEmpty() const;
+
+  /// \brief Clears the table.
+  void Clear();
+
+  /// \brief Inserts the key value pair or replaces value if an entry with the given key already exists.
+  ///
+  /// Returns true if an existing value was replaced and optionally writes out the old value to out_oldValue.
+  template <typename CompatibleKeyType, typename CompatibleValueType>
+  bool Insert(CompatibleKeyType&& key, CompatibleValueType&& value, ValueType* out_oldValue = nullptr);
+
+  /// \brief Returns the value to the given key, or inserts a default constructed value, if the key doesn't exist yet.
+  ///
+  /// Optionally writes out whether the key already existed. The key is only converted to KeyType, if it is inserted.
+  template <typename CompatibleKeyType>
+  ValueType& FindOrAdd(CompatibleKeyType&& key, bool* out_pExisted = nullptr);
+
+  /// \brief Removes the entry with the given key. Returns whether an entry was removed and optionally writes out the old value to out_oldValue.
+  template <typename CompatibleKeyType>
+  bool Remove(const CompatibleKeyType& key, ValueType* out_oldValue = nullptr);
+
+  /// \brief Erases the key/value pair at the given Iterator. Returns an iterator to the element after the given iterator.
+  Iterator Remove(const Iterator& pos);
+
+  /// \brief Cannot remove an element with just a ConstIterator
+  void Remove(const ConstIterator& pos) = delete;
+
+  /// \brief Returns if an entry with the given key was found and if found writes out the corresponding value to out_value.
+  template <typename CompatibleKeyType>
+  bool TryGetValue(const CompatibleKeyType& key, ValueType& out_value) const;
+
+  /// \brief Returns if an entry with the given key was found and if found writes out the pointer to the corresponding value to out_pValue.
+  template <typename CompatibleKeyType>
+  bool TryGetValue(const CompatibleKeyType& key, const ValueType*& out_pValue) const;
+
+  /// \brief Returns if an entry with the given key was found and if found writes out the pointer to the corresponding value to out_pValue.
+  template <typename CompatibleKeyType>
+  bool TryGetValue(const CompatibleKeyType& key, ValueType*& out_pValue);
+
+  /// \brief Searches for key, returns a ConstIterator to it or an invalid iterator, if no such key is found. O(1) operation.
+  template <typename CompatibleKeyType>
+  ConstIterator Find(const CompatibleKeyType& key) const;
+
+  /// \brief Searches for key, returns an Iterator to it or an invalid iterator, if no such key is found. O(1) operation.
+  template <typename CompatibleKeyType>
+  Iterator Find(const CompatibleKeyType& key);
+
+  /// \brief Returns a pointer to the value of the entry with the given key if found, otherwise returns nullptr.
+  template <typename CompatibleKeyType>
+  const ValueType* GetValue(const CompatibleKeyType& key) const;
+
+  /// \brief Returns a pointer to the value of the entry with the given key if found, otherwise returns nullptr.
+  template <typename CompatibleKeyType>
+  ValueType* GetValue(const CompatibleKeyType& key);
+
+  /// \brief Returns the value to the given key if found or creates a new entry with the given key and a default constructed value.
+  ValueType& operator[](const KeyType& key);
+
+  /// \brief Returns if an entry with given key exists in the table.
+  template <typename CompatibleKeyType>
+  bool Contains(const CompatibleKeyType& key) const;
+
+  /// \brief Returns an Iterator to the very first element.
+  Iterator GetIterator();
+
+  /// \brief Returns an Iterator to the first element that is not part of the hash-table. Needed to support range based for loops.
+  Iterator GetEndIterator();
+
+  /// \brief Returns a constant Iterator to the very first element.
+  ConstIterator GetIterator() const;
+
+  /// \brief Returns a ConstIterator to the first element that is not part of the hash-table. Needed to support range based for loops.
+  ConstIterator GetEndIterator() const;
+
+  /// \brief Returns the allocator that is used by this instance.
+  ezAllocatorBase* GetAllocator() const;
+
+  /// \brief Returns the amount of bytes that are currently allocated on the heap.
+  ezUInt64 GetHeapMemoryUsage() const;
+
+  /// \brief Swaps this map with the other one.
+  void Swap(ezFlatHashTableBase<KeyType, ValueType, Hasher>& other);
+
+private:
+  struct Entry
+  {
+    KeyType key;
+    ValueType value;
+  };
+
+  /// The control bytes and the entries are stored in one allocation, the entries follow after the control bytes.
+  ezInt8* m_pControl;
+  Entry* m_pEntries;
+
+  ezUInt32 m_uiCount;
+  ezUInt32 m_uiCapacity;
+  ezUInt32 m_uiGrowthLeft; ///< How many free slots can still be filled before the table has to be rehashed.
+
+  ezAllocatorBase* m_pAllocator;
+
+  enum : ezInt8
+  {
+    FREE_SLOT = -128,  ///< 0b10000000, all control bytes of non-valid slots have the highest bit set.
+    DELETED_SLOT = -2, ///< 0b11111110
+  };
+
+  enum : ezUInt32
+  {
+    GROUP_SIZE = 16,
+  };
+
+  static ezUInt32 GetMaxLoad(ezUInt32 uiCapacity);
+  static ezUInt32 GetGroupIndex(ezUInt32 uiHash);
+  static ezInt8 GetControlHash(ezUInt32 uiHash);
+
+  /// \brief Returns a bit for every slot in the group of 16 control bytes that has the given value.
+  static ezUInt32 MatchGroup(const ezInt8* pGroup, ezInt8 iControl);
+  /// \brief Returns a bit for every slot in the group of 16 control bytes that is free or deleted.
+  static ezUInt32 MatchGroupFreeOrDeleted(const ezInt8* pGroup);
+
+  void SetCapacity(ezUInt32 uiCapacity);
+  void FreeStorage();
+
+  template <typename CompatibleKeyType>
+  ezUInt32 FindEntry(const CompatibleKeyType& key) const;
+
+  template <typename CompatibleKeyType>
+  ezUInt32 FindEntry(ezUInt32 uiHash, const CompatibleKeyType& key) const;
+
+  /// \brief Finds the slot for a new entry with the given hash, grows the table if necessary and marks the slot as valid.
+  ezUInt32 PrepareInsert(ezUInt32 uiHash);
+  ezUInt32 FindFreeSlot(ezUInt32 uiHash) const;
+
+  void RemoveInternal(ezUInt32 uiIndex);
+
+  bool IsValidEntry(ezUInt32 uiEntryIndex) const;
+};
+
+/// \brief \see ezFlatHashTableBase
+template <typename KeyType, typename ValueType, typename Hasher = ezHashHelper<KeyType>, typename AllocatorWrapper = ezDefaultAllocatorWrapper>
+class ezFlatHashTable : public ezFlatHashTableBase<KeyType, ValueType, Hasher>
+{
+public:
+  ezFlatHashTable();
+  ezFlatHashTable(ezAllocatorBase* pAllocator);
+
+  ezFlatHashTable(const ezFlatHashTable<KeyType, ValueType, Hasher, AllocatorWrapper>& other);
+  ezFlatHashTable(const ezFlatHashTableBase<KeyType, ValueType, Hasher>& other);
+
+  ezFlatHashTable(ezFlatHashTable<KeyType, ValueType, Hasher, AllocatorWrapper>&& other);
+  ezFlatHashTable(ezFlatHashTableBase<KeyType, ValueType, Hasher>&& other);
+
+
+  void operator=(const ezFlatHashTable<KeyType, ValueType, Hasher, AllocatorWrapper>& rhs);
+  void operator=(const ezFlatHashTableBase<KeyType, ValueType, Hasher>& rhs);
+
+  void operator=(ezFlatHashTable<KeyType, ValueType, Hasher, AllocatorWrapper>&& rhs);
+  void operator=(ezFlatHashTableBase<KeyType, ValueType, Hasher>&& rhs);
+};
+
+//////////////////////////////////////////////////////////////////////////
+// begin() /end() for range-based for-loop support
+
+template <typename KeyType, typename ValueType, typename Hasher>
+typename ezFlatHashTableBase<KeyType, ValueType, Hasher>::Iterator begin(ezFlatHashTableBase<KeyType, ValueType, Hasher>& container)
+{
+  return container.GetIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+typename ezFlatHashTableBase<KeyType, ValueType, Hasher>::ConstIterator begin(const ezFlatHashTableBase<KeyType, ValueType, Hasher>& container)
+{
+  return container.GetIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+typename ezFlatHashTableBase<KeyType, ValueType, Hasher>::ConstIterator cbegin(const ezFlatHashTableBase<KeyType, ValueType, Hasher>& container)
+{
+  return container.GetIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+typename ezFlatHashTableBase<KeyType, ValueType, Hasher>::Iterator end(ezFlatHashTableBase<KeyType, ValueType, Hasher>& container)
+{
+  return container.GetEndIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+typename ezFlatHashTableBase<KeyType, ValueType, Hasher>::ConstIterator end(const ezFlatHashTableBase<KeyType, ValueType, Hasher>& container)
+{
+  return container.GetEndIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+typename ezFlatHashTableBase<KeyType, ValueType, Hasher>::ConstIterator cend(const ezFlatHashTableBase<KeyType, ValueType, Hasher>& container)
+{
+  return container.GetEndIterator();
+}
+
+#include <Foundation/Containers/Implementation/FlatHashTable_inl.h>
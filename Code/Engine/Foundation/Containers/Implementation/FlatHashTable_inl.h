@@ -0,0 +1,843 @@
+#if EZ_ENABLED(EZ_PLATFORM_ARCH_X86)
+#  include <emmintrin.h>
+#endif
+
+/// \brief Value used by containers for indices to indicate an invalid index.
+#ifndef ezInvalidIndex
+#  define ezInvalidIndex 0xFFFFFFFF
+#endif
+
+// ***** Const Iterator *****
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBase<K, V, H>::ConstIterator::ConstIterator(const ezFlatHashTableBase<K, V, H>& hashTable)
+  : m_hashTable(&hashTable)
+{
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::ConstIterator::SetToBegin()
+{
+  if (m_hashTable->IsEmpty())
+  {
+    m_uiCurrentIndex = m_hashTable->m_uiCapacity;
+    return;
+  }
+
+  m_uiCurrentIndex = 0;
+  while (!m_hashTable->IsValidEntry(m_uiCurrentIndex))
+  {
+    ++m_uiCurrentIndex;
+  }
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE void ezFlatHashTableBase<K, V, H>::ConstIterator::SetToEnd()
+{
+  m_uiCurrentIndex = m_hashTable->m_uiCapacity;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE bool ezFlatHashTableBase<K, V, H>::ConstIterator::IsValid() const
+{
+  return m_uiCurrentIndex < m_hashTable->m_uiCapacity;
+}
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE bool ezFlatHashTableBase<K, V, H>::ConstIterator::operator==(const typename ezFlatHashTableBase<K, V, H>::ConstIterator& rhs) const
+{
+  return m_uiCurrentIndex == rhs.m_uiCurrentIndex && m_hashTable->m_pEntries == rhs.m_hashTable->m_pEntries;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE bool ezFlatHashTableBase<K, V, H>::ConstIterator::operator!=(const typename ezFlatHashTableBase<K, V, H>::ConstIterator& rhs) const
+{
+  return !(*this == rhs);
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE const K& ezFlatHashTableBase<K, V, H>::ConstIterator::Key() const
+{
+  return m_hashTable->m_pEntries[m_uiCurrentIndex].key;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE const V& ezFlatHashTableBase<K, V, H>::ConstIterator::Value() const
+{
+  return m_hashTable->m_pEntries[m_uiCurrentIndex].value;
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::ConstIterator::Next()
+{
+  const ezUInt32 uiCapacity = m_hashTable->m_uiCapacity;
+  if (m_uiCurrentIndex >= uiCapacity)
+    return;
+
+  ++m_uiCurrentIndex;
+
+  // valid slots are the only ones with a positive control byte
+  while (m_uiCurrentIndex < uiCapacity && !m_hashTable->IsValidEntry(m_uiCurrentIndex))
+  {
+    ++m_uiCurrentIndex;
+  }
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE void ezFlatHashTableBase<K, V, H>::ConstIterator::operator++()
+{
+  Next();
+}
+
+
+// ***** Iterator *****
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBase<K, V, H>::Iterator::Iterator(const ezFlatHashTableBase<K, V, H>& hashTable)
+  : ConstIterator(hashTable)
+{
+}
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBase<K, V, H>::Iterator::Iterator(const typename ezFlatHashTableBase<K, V, H>::Iterator& rhs)
+  : ConstIterator(*rhs.m_hashTable)
+{
+  this->m_uiCurrentIndex = rhs.m_uiCurrentIndex;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE void ezFlatHashTableBase<K, V, H>::Iterator::operator=(const Iterator& rhs)
+{
+  this->m_hashTable = rhs.m_hashTable;
+  this->m_uiCurrentIndex = rhs.m_uiCurrentIndex;
+}
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE V& ezFlatHashTableBase<K, V, H>::Iterator::Value()
+{
+  return this->m_hashTable->m_pEntries[this->m_uiCurrentIndex].value;
+}
+
+
+// ***** ezFlatHashTableBase *****
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBase<K, V, H>::ezFlatHashTableBase(ezAllocatorBase* pAllocator)
+{
+  m_pControl = nullptr;
+  m_pEntries = nullptr;
+  m_uiCount = 0;
+  m_uiCapacity = 0;
+  m_uiGrowthLeft = 0;
+  m_pAllocator = pAllocator;
+}
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBase<K, V, H>::ezFlatHashTableBase(const ezFlatHashTableBase<K, V, H>& other, ezAllocatorBase* pAllocator)
+  : ezFlatHashTableBase(pAllocator)
+{
+  *this = other;
+}
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBase<K, V, H>::ezFlatHashTableBase(ezFlatHashTableBase<K, V, H>&& other, ezAllocatorBase* pAllocator)
+  : ezFlatHashTableBase(pAllocator)
+{
+  *this = std::move(other);
+}
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBase<K, V, H>::~ezFlatHashTableBase()
+{
+  Clear();
+  FreeStorage();
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::operator=(const ezFlatHashTableBase<K, V, H>& rhs)
+{
+  if (this == &rhs)
+    return;
+
+  Clear();
+  Reserve(rhs.GetCount());
+
+  for (ezUInt32 i = 0; i < rhs.m_uiCapacity; ++i)
+  {
+    if (rhs.IsValidEntry(i))
+    {
+      const ezUInt32 uiIndex = PrepareInsert(H::Hash(rhs.m_pEntries[i].key));
+      ezMemoryUtils::CopyConstruct(&m_pEntries[uiIndex].key, rhs.m_pEntries[i].key, 1);
+      ezMemoryUtils::CopyConstruct(&m_pEntries[uiIndex].value, rhs.m_pEntries[i].value, 1);
+    }
+  }
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::operator=(ezFlatHashTableBase<K, V, H>&& rhs)
+{
+  if (this == &rhs)
+    return;
+
+  // Clear any existing data (calls destructors if necessary)
+  Clear();
+
+  if (m_pAllocator != rhs.m_pAllocator)
+  {
+    Reserve(rhs.GetCount());
+
+    for (ezUInt32 i = 0; i < rhs.m_uiCapacity; ++i)
+    {
+      if (rhs.IsValidEntry(i))
+      {
+        const ezUInt32 uiIndex = PrepareInsert(H::Hash(rhs.m_pEntries[i].key));
+        ezMemoryUtils::RelocateConstruct(&m_pEntries[uiIndex].key, &rhs.m_pEntries[i].key, 1);
+        ezMemoryUtils::RelocateConstruct(&m_pEntries[uiIndex].value, &rhs.m_pEntries[i].value, 1);
+        rhs.m_pControl[i] = FREE_SLOT;
+      }
+    }
+
+    rhs.m_uiCount = 0;
+    rhs.FreeStorage();
+  }
+  else
+  {
+    FreeStorage();
+
+    // Move all data over.
+    m_pControl = rhs.m_pControl;
+    m_pEntries = rhs.m_pEntries;
+    m_uiCount = rhs.m_uiCount;
+    m_uiCapacity = rhs.m_uiCapacity;
+    m_uiGrowthLeft = rhs.m_uiGrowthLeft;
+
+    // Temp copy forgets all its state.
+    rhs.m_pControl = nullptr;
+    rhs.m_pEntries = nullptr;
+    rhs.m_uiCount = 0;
+    rhs.m_uiCapacity = 0;
+    rhs.m_uiGrowthLeft = 0;
+  }
+}
+
+template <typename K, typename V, typename H>
+bool ezFlatHashTableBase<K, V, H>::operator==(const ezFlatHashTableBase<K, V, H>& rhs) const
+{
+  if (m_uiCount != rhs.m_uiCount)
+    return false;
+
+  for (ezUInt32 i = 0; i < m_uiCapacity; ++i)
+  {
+    if (IsValidEntry(i))
+    {
+      const V* pRhsValue = nullptr;
+      if (!rhs.TryGetValue(m_pEntries[i].key, pRhsValue))
+        return false;
+
+      if (m_pEntries[i].value != *pRhsValue)
+        return false;
+    }
+  }
+
+  return true;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE bool ezFlatHashTableBase<K, V, H>::operator!=(const ezFlatHashTableBase<K, V, H>& rhs) const
+{
+  return !(*this == rhs);
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::Reserve(ezUInt32 uiCapacity)
+{
+  ezUInt32 uiNewCapacity = GROUP_SIZE;
+  while (GetMaxLoad(uiNewCapacity) < uiCapacity)
+  {
+    EZ_ASSERT_DEV(uiNewCapacity < 0x80000000u, "ezFlatHashTable does not support more than 2 billion entries.");
+    uiNewCapacity *= 2;
+  }
+
+  if (uiNewCapacity > m_uiCapacity)
+  {
+    SetCapacity(uiNewCapacity);
+  }
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::Compact()
+{
+  if (IsEmpty())
+  {
+    FreeStorage();
+    return;
+  }
+
+  ezUInt32 uiNewCapacity = GROUP_SIZE;
+  while (GetMaxLoad(uiNewCapacity) < m_uiCount)
+  {
+    uiNewCapacity *= 2;
+  }
+
+  // rehashing at the same capacity still gets rid of all deleted slots
+  SetCapacity(uiNewCapacity);
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE ezUInt32 ezFlatHashTableBase<K, V, H>::GetCount() const
+{
+  return m_uiCount;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE bool ezFlatHashTableBase<K, V, H>::IsEmpty() const
+{
+  return m_uiCount == 0;
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::Clear()
+{
+  if (m_uiCapacity == 0)
+    return;
+
+  for (ezUInt32 i = 0; i < m_uiCapacity; ++i)
+  {
+    if (IsValidEntry(i))
+    {
+      ezMemoryUtils::Destruct(&m_pEntries[i].key, 1);
+      ezMemoryUtils::Destruct(&m_pEntries[i].value, 1);
+    }
+  }
+
+  ezMemoryUtils::PatternFill(reinterpret_cast<ezUInt8*>(m_pControl), static_cast<ezUInt8>(FREE_SLOT), m_uiCapacity);
+  m_uiCount = 0;
+  m_uiGrowthLeft = GetMaxLoad(m_uiCapacity);
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType, typename CompatibleValueType>
+bool ezFlatHashTableBase<K, V, H>::Insert(CompatibleKeyType&& key, CompatibleValueType&& value, V* out_oldValue /*= nullptr*/)
+{
+  const ezUInt32 uiHash = H::Hash(key);
+  ezUInt32 uiIndex = FindEntry(uiHash, key);
+
+  if (uiIndex != ezInvalidIndex)
+  {
+    if (out_oldValue != nullptr)
+      *out_oldValue = std::move(m_pEntries[uiIndex].value);
+
+    m_pEntries[uiIndex].value = std::forward<CompatibleValueType>(value); // Either move or copy assignment.
+    return true;
+  }
+
+  uiIndex = PrepareInsert(uiHash);
+
+  // Both constructions might either be a move or a copy.
+  ezMemoryUtils::CopyOrMoveConstruct(&m_pEntries[uiIndex].key, std::forward<CompatibleKeyType>(key));
+  ezMemoryUtils::CopyOrMoveConstruct(&m_pEntries[uiIndex].value, std::forward<CompatibleValueType>(value));
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+V& ezFlatHashTableBase<K, V, H>::FindOrAdd(CompatibleKeyType&& key, bool* out_pExisted /*= nullptr*/)
+{
+  const ezUInt32 uiHash = H::Hash(key);
+  ezUInt32 uiIndex = FindEntry(uiHash, key);
+
+  if (out_pExisted != nullptr)
+    *out_pExisted = uiIndex != ezInvalidIndex;
+
+  if (uiIndex == ezInvalidIndex)
+  {
+    uiIndex = PrepareInsert(uiHash);
+
+    ezMemoryUtils::CopyOrMoveConstruct(&m_pEntries[uiIndex].key, std::forward<CompatibleKeyType>(key));
+    ezMemoryUtils::DefaultConstruct(&m_pEntries[uiIndex].value, 1);
+  }
+
+  return m_pEntries[uiIndex].value;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+bool ezFlatHashTableBase<K, V, H>::Remove(const CompatibleKeyType& key, V* out_oldValue /*= nullptr*/)
+{
+  const ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    if (out_oldValue != nullptr)
+      *out_oldValue = std::move(m_pEntries[uiIndex].value);
+
+    RemoveInternal(uiIndex);
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+typename ezFlatHashTableBase<K, V, H>::Iterator ezFlatHashTableBase<K, V, H>::Remove(const typename ezFlatHashTableBase<K, V, H>::Iterator& pos)
+{
+  // removing never moves other entries, so the next iterator stays valid
+  Iterator it = pos;
+  const ezUInt32 uiIndex = pos.m_uiCurrentIndex;
+  ++it;
+  RemoveInternal(uiIndex);
+  return it;
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::RemoveInternal(ezUInt32 uiIndex)
+{
+  ezMemoryUtils::Destruct(&m_pEntries[uiIndex].key, 1);
+  ezMemoryUtils::Destruct(&m_pEntries[uiIndex].value, 1);
+
+  // A group that still has a free slot has never been full since the last rehash,
+  // so no lookup ever had to probe past it and the slot can be freed right away.
+  const ezInt8* pGroup = m_pControl + (uiIndex & ~(GROUP_SIZE - 1));
+  if (MatchGroup(pGroup, FREE_SLOT) != 0)
+  {
+    m_pControl[uiIndex] = FREE_SLOT;
+    ++m_uiGrowthLeft;
+  }
+  else
+  {
+    m_pControl[uiIndex] = DELETED_SLOT;
+  }
+
+  --m_uiCount;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline bool ezFlatHashTableBase<K, V, H>::TryGetValue(const CompatibleKeyType& key, V& out_value) const
+{
+  const ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    out_value = m_pEntries[uiIndex].value;
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline bool ezFlatHashTableBase<K, V, H>::TryGetValue(const CompatibleKeyType& key, const V*& out_pValue) const
+{
+  const ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    out_pValue = &m_pEntries[uiIndex].value;
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline bool ezFlatHashTableBase<K, V, H>::TryGetValue(const CompatibleKeyType& key, V*& out_pValue)
+{
+  const ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    out_pValue = &m_pEntries[uiIndex].value;
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline typename ezFlatHashTableBase<K, V, H>::ConstIterator ezFlatHashTableBase<K, V, H>::Find(const CompatibleKeyType& key) const
+{
+  ConstIterator it(*this);
+
+  const ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+    it.m_uiCurrentIndex = uiIndex;
+  else
+    it.SetToEnd();
+
+  return it;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline typename ezFlatHashTableBase<K, V, H>::Iterator ezFlatHashTableBase<K, V, H>::Find(const CompatibleKeyType& key)
+{
+  Iterator it(*this);
+
+  const ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+    it.m_uiCurrentIndex = uiIndex;
+  else
+    it.SetToEnd();
+
+  return it;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline const V* ezFlatHashTableBase<K, V, H>::GetValue(const CompatibleKeyType& key) const
+{
+  const ezUInt32 uiIndex = FindEntry(key);
+  return (uiIndex != ezInvalidIndex) ? &m_pEntries[uiIndex].value : nullptr;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline V* ezFlatHashTableBase<K, V, H>::GetValue(const CompatibleKeyType& key)
+{
+  const ezUInt32 uiIndex = FindEntry(key);
+  return (uiIndex != ezInvalidIndex) ? &m_pEntries[uiIndex].value : nullptr;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE V& ezFlatHashTableBase<K, V, H>::operator[](const K& key)
+{
+  return FindOrAdd(key);
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE bool ezFlatHashTableBase<K, V, H>::Contains(const CompatibleKeyType& key) const
+{
+  return FindEntry(key) != ezInvalidIndex;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE typename ezFlatHashTableBase<K, V, H>::Iterator ezFlatHashTableBase<K, V, H>::GetIterator()
+{
+  Iterator iterator(*this);
+  iterator.SetToBegin();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE typename ezFlatHashTableBase<K, V, H>::Iterator ezFlatHashTableBase<K, V, H>::GetEndIterator()
+{
+  Iterator iterator(*this);
+  iterator.SetToEnd();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE typename ezFlatHashTableBase<K, V, H>::ConstIterator ezFlatHashTableBase<K, V, H>::GetIterator() const
+{
+  ConstIterator iterator(*this);
+  iterator.SetToBegin();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE typename ezFlatHashTableBase<K, V, H>::ConstIterator ezFlatHashTableBase<K, V, H>::GetEndIterator() const
+{
+  ConstIterator iterator(*this);
+  iterator.SetToEnd();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE ezAllocatorBase* ezFlatHashTableBase<K, V, H>::GetAllocator() const
+{
+  return m_pAllocator;
+}
+
+template <typename K, typename V, typename H>
+ezUInt64 ezFlatHashTableBase<K, V, H>::GetHeapMemoryUsage() const
+{
+  return ((ezUInt64)m_uiCapacity * sizeof(Entry)) + m_uiCapacity;
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::Swap(ezFlatHashTableBase<K, V, H>& other)
+{
+  ezMath::Swap(this->m_pControl, other.m_pControl);
+  ezMath::Swap(this->m_pEntries, other.m_pEntries);
+  ezMath::Swap(this->m_uiCount, other.m_uiCount);
+  ezMath::Swap(this->m_uiCapacity, other.m_uiCapacity);
+  ezMath::Swap(this->m_uiGrowthLeft, other.m_uiGrowthLeft);
+  ezMath::Swap(this->m_pAllocator, other.m_pAllocator);
+}
+
+// private methods
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE ezUInt32 ezFlatHashTableBase<K, V, H>::GetMaxLoad(ezUInt32 uiCapacity)
+{
+  // 87.5% max load, SIMD probing still finds entries quickly at this load
+  return uiCapacity - uiCapacity / 8;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE ezUInt32 ezFlatHashTableBase<K, V, H>::GetGroupIndex(ezUInt32 uiHash)
+{
+  // the lowest 7 bits are stored in the control byte, the rest selects the group
+  return uiHash >> 7;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE ezInt8 ezFlatHashTableBase<K, V, H>::GetControlHash(ezUInt32 uiHash)
+{
+  return static_cast<ezInt8>(uiHash & 0x7F);
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE ezUInt32 ezFlatHashTableBase<K, V, H>::MatchGroup(const ezInt8* pGroup, ezInt8 iControl)
+{
+#if EZ_ENABLED(EZ_PLATFORM_ARCH_X86)
+  const __m128i group = _mm_load_si128(reinterpret_cast<const __m128i*>(pGroup));
+  return static_cast<ezUInt32>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(iControl))));
+#else
+  ezUInt32 uiMask = 0;
+  for (ezUInt32 i = 0; i < GROUP_SIZE; ++i)
+  {
+    uiMask |= static_cast<ezUInt32>(pGroup[i] == iControl) << i;
+  }
+  return uiMask;
+#endif
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE ezUInt32 ezFlatHashTableBase<K, V, H>::MatchGroupFreeOrDeleted(const ezInt8* pGroup)
+{
+#if EZ_ENABLED(EZ_PLATFORM_ARCH_X86)
+  // free and deleted slots are the only ones with the sign bit set
+  const __m128i group = _mm_load_si128(reinterpret_cast<const __m128i*>(pGroup));
+  return static_cast<ezUInt32>(_mm_movemask_epi8(group));
+#else
+  ezUInt32 uiMask = 0;
+  for (ezUInt32 i = 0; i < GROUP_SIZE; ++i)
+  {
+    uiMask |= static_cast<ezUInt32>(pGroup[i] < 0) << i;
+  }
+  return uiMask;
+#endif
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::SetCapacity(ezUInt32 uiCapacity)
+{
+  EZ_ASSERT_DEV(ezMath::IsPowerOf2(uiCapacity) && uiCapacity >= GROUP_SIZE, "uiCapacity must be a power of two and at least one group.");
+
+  ezInt8* pOldControl = m_pControl;
+  Entry* pOldEntries = m_pEntries;
+  const ezUInt32 uiOldCapacity = m_uiCapacity;
+
+  // control bytes and entries share one allocation, the control bytes need to be aligned for SIMD loads
+  const size_t uiAlignment = ezMath::Max<size_t>(GROUP_SIZE, EZ_ALIGNMENT_OF(Entry));
+  const size_t uiEntriesOffset = ezMemoryUtils::AlignSize<size_t>(uiCapacity, uiAlignment);
+  ezUInt8* pData = static_cast<ezUInt8*>(m_pAllocator->Allocate(uiEntriesOffset + (size_t)uiCapacity * sizeof(Entry), uiAlignment));
+
+  m_pControl = reinterpret_cast<ezInt8*>(pData);
+  m_pEntries = reinterpret_cast<Entry*>(pData + uiEntriesOffset);
+  m_uiCapacity = uiCapacity;
+  ezMemoryUtils::PatternFill(pData, static_cast<ezUInt8>(FREE_SLOT), uiCapacity);
+
+  // entries can't be equal to each other, so they only need a free slot and no key comparison
+  for (ezUInt32 i = 0; i < uiOldCapacity; ++i)
+  {
+    if (pOldControl[i] >= 0)
+    {
+      const ezUInt32 uiHash = H::Hash(pOldEntries[i].key);
+      const ezUInt32 uiIndex = FindFreeSlot(uiHash);
+      m_pControl[uiIndex] = GetControlHash(uiHash);
+      ezMemoryUtils::RelocateConstruct(&m_pEntries[uiIndex].key, &pOldEntries[i].key, 1);
+      ezMemoryUtils::RelocateConstruct(&m_pEntries[uiIndex].value, &pOldEntries[i].value, 1);
+    }
+  }
+
+  m_uiGrowthLeft = GetMaxLoad(m_uiCapacity) - m_uiCount;
+
+  if (pOldControl != nullptr)
+  {
+    m_pAllocator->Deallocate(pOldControl);
+  }
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::FreeStorage()
+{
+  EZ_ASSERT_DEBUG(m_uiCount == 0, "Entries have to be destructed before the storage is freed.");
+
+  if (m_pControl != nullptr)
+  {
+    m_pAllocator->Deallocate(m_pControl);
+  }
+
+  m_pControl = nullptr;
+  m_pEntries = nullptr;
+  m_uiCapacity = 0;
+  m_uiGrowthLeft = 0;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE ezUInt32 ezFlatHashTableBase<K, V, H>::FindEntry(const CompatibleKeyType& key) const
+{
+  return FindEntry(H::Hash(key), key);
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline ezUInt32 ezFlatHashTableBase<K, V, H>::FindEntry(ezUInt32 uiHash, const CompatibleKeyType& key) const
+{
+  if (m_uiCapacity == 0)
+    return ezInvalidIndex;
+
+  const ezInt8 iControlHash = GetControlHash(uiHash);
+  const ezUInt32 uiGroupMask = (m_uiCapacity / GROUP_SIZE) - 1;
+  ezUInt32 uiGroup = GetGroupIndex(uiHash) & uiGroupMask;
+
+  // triangular probing visits every group exactly once with a power of two group count
+  for (ezUInt32 uiProbe = 1; uiProbe <= uiGroupMask + 1; ++uiProbe)
+  {
+    const ezInt8* pGroup = m_pControl + uiGroup * GROUP_SIZE;
+
+    ezUInt32 uiMatches = MatchGroup(pGroup, iControlHash);
+    while (uiMatches != 0)
+    {
+      const ezUInt32 uiIndex = uiGroup * GROUP_SIZE + ezMath::FirstBitLow(uiMatches);
+      if (H::Equal(m_pEntries[uiIndex].key, key))
+        return uiIndex;
+
+      uiMatches &= uiMatches - 1;
+    }
+
+    // the key would have been inserted into this group, if it existed
+    if (MatchGroup(pGroup, FREE_SLOT) != 0)
+      return ezInvalidIndex;
+
+    uiGroup = (uiGroup + uiProbe) & uiGroupMask;
+  }
+
+  return ezInvalidIndex;
+}
+
+template <typename K, typename V, typename H>
+ezUInt32 ezFlatHashTableBase<K, V, H>::PrepareInsert(ezUInt32 uiHash)
+{
+  if (m_uiGrowthLeft == 0)
+  {
+    if (m_uiCapacity == 0)
+    {
+      SetCapacity(GROUP_SIZE);
+    }
+    else if (m_uiCount >= GetMaxLoad(m_uiCapacity) / 2)
+    {
+      SetCapacity(m_uiCapacity * 2);
+    }
+    else
+    {
+      // most of the used up slots are deleted ones, get rid of them without growing
+      SetCapacity(m_uiCapacity);
+    }
+  }
+
+  const ezUInt32 uiIndex = FindFreeSlot(uiHash);
+
+  // reusing a deleted slot does not bring the table closer to its max load
+  if (m_pControl[uiIndex] == FREE_SLOT)
+  {
+    --m_uiGrowthLeft;
+  }
+
+  m_pControl[uiIndex] = GetControlHash(uiHash);
+  ++m_uiCount;
+
+  return uiIndex;
+}
+
+template <typename K, typename V, typename H>
+ezUInt32 ezFlatHashTableBase<K, V, H>::FindFreeSlot(ezUInt32 uiHash) const
+{
+  const ezUInt32 uiGroupMask = (m_uiCapacity / GROUP_SIZE) - 1;
+  ezUInt32 uiGroup = GetGroupIndex(uiHash) & uiGroupMask;
+
+  for (ezUInt32 uiProbe = 1; uiProbe <= uiGroupMask + 1; ++uiProbe)
+  {
+    const ezUInt32 uiMatches = MatchGroupFreeOrDeleted(m_pControl + uiGroup * GROUP_SIZE);
+    if (uiMatches != 0)
+      return uiGroup * GROUP_SIZE + ezMath::FirstBitLow(uiMatches);
+
+    uiGroup = (uiGroup + uiProbe) & uiGroupMask;
+  }
+
+  EZ_REPORT_FAILURE("ezFlatHashTable has no free slot left, this should never happen.");
+  return ezInvalidIndex;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE bool ezFlatHashTableBase<K, V, H>::IsValidEntry(ezUInt32 uiEntryIndex) const
+{
+  EZ_ASSERT_DEBUG(uiEntryIndex < m_uiCapacity, "Out of bounds access");
+  return m_pControl[uiEntryIndex] >= 0;
+}
+
+
+template <typename K, typename V, typename H, typename A>
+ezFlatHashTable<K, V, H, A>::ezFlatHashTable()
+  : ezFlatHashTableBase<K, V, H>(A::GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezFlatHashTable<K, V, H, A>::ezFlatHashTable(ezAllocatorBase* pAllocator)
+  : ezFlatHashTableBase<K, V, H>(pAllocator)
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezFlatHashTable<K, V, H, A>::ezFlatHashTable(const ezFlatHashTable<K, V, H, A>& other)
+  : ezFlatHashTableBase<K, V, H>(other, A::GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezFlatHashTable<K, V, H, A>::ezFlatHashTable(const ezFlatHashTableBase<K, V, H>& other)
+  : ezFlatHashTableBase<K, V, H>(other, A::GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezFlatHashTable<K, V, H, A>::ezFlatHashTable(ezFlatHashTable<K, V, H, A>&& other)
+  : ezFlatHashTableBase<K, V, H>(std::move(other), other.GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezFlatHashTable<K, V, H, A>::ezFlatHashTable(ezFlatHashTableBase<K, V, H>&& other)
+  : ezFlatHashTableBase<K, V, H>(std::move(other), other.GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+void ezFlatHashTable<K, V, H, A>::operator=(const ezFlatHashTable<K, V, H, A>& rhs)
+{
+  ezFlatHashTableBase<K, V, H>::operator=(rhs);
+}
+
+template <typename K, typename V, typename H, typename A>
+void ezFlatHashTable<K, V, H, A>::operator=(const ezFlatHashTableBase<K, V, H>& rhs)
+{
+  ezFlatHashTableBase<K, V, H>::operator=(rhs);
+}
+
+template <typename K, typename V, typename H, typename A>
+void ezFlatHashTable<K, V, H, A>::operator=(ezFlatHashTable<K, V, H, A>&& rhs)
+{
+  ezFlatHashTableBase<K, V, H>::operator=(std::move(rhs));
+}
+
+template <typename K, typename V, typename H, typename A>
+void ezFlatHashTable<K, V, H, A>::operator=(ezFlatHashTableBase<K, V, H>&& rhs)
+{
+  ezFlatHashTableBase<K, V, H>::operator=(std::move(rhs));
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+template <typename K, typename V, typename P>
+ezIndexedPriorityQueue<K, V, P>::ezIndexedPriorityQueue(ezAllocatorBase* pAllocator)
+  : m_Entries(pAllocator)
+{
+}
+
+template <typename K, typename V, typename P>
+void ezIndexedPriorityQueue<K, V, P>::Clear()
+{
+  for (const Entry& entry : m_Entries)
+  {
+    P::SetIndex(entry.m_Value, ezInvalidIndex);
+  }
+
+  m_Entries.Clear();
+}
+
+template <typename K, typename V, typename P>
+void ezIndexedPriorityQueue<K, V, P>::Insert(const K& key, const V& value)
+{
+  Entry& entry = m_Entries.ExpandAndGetRef();
+  entry.m_Key = key;
+  entry.m_Value = value;
+
+  const ezUInt32 uiIndex = m_Entries.GetCount() - 1;
+  P::SetIndex(value, uiIndex);
+
+  MoveUp(uiIndex);
+}
+
+template <typename K, typename V, typename P>
+const typename ezIndexedPriorityQueue<K, V, P>::Entry& ezIndexedPriorityQueue<K, V, P>::PeekTop() const
+{
+  EZ_ASSERT_DEBUG(!m_Entries.IsEmpty(), "The queue is empty.");
+
+  return m_Entries[0];
+}
+
+template <typename K, typename V, typename P>
+void ezIndexedPriorityQueue<K, V, P>::PopTop()
+{
+  Remove(0);
+}
+
+template <typename K, typename V, typename P>
+void ezIndexedPriorityQueue<K, V, P>::Remove(ezUInt32 uiIndex)
+{
+  EZ_ASSERT_DEBUG(uiIndex < m_Entries.GetCount(), "Out of bounds access. Queue has {0} elements, trying to remove element at index {1}.",
+    m_Entries.GetCount(), uiIndex);
+
+  P::SetIndex(m_Entries[uiIndex].m_Value, ezInvalidIndex);
+
+  const ezUInt32 uiLastIndex = m_Entries.GetCount() - 1;
+
+  if (uiIndex != uiLastIndex)
+  {
+    // fill the gap with the last entry and restore the heap property from there
+    const bool bMoveUp = m_Entries[uiLastIndex].m_Key < m_Entries[uiIndex].m_Key;
+
+    SetEntry(uiIndex, std::move(m_Entries[uiLastIndex]));
+    m_Entries.PopBack();
+
+    if (bMoveUp)
+      MoveUp(uiIndex);
+    else
+      MoveDown(uiIndex);
+  }
+  else
+  {
+    m_Entries.PopBack();
+  }
+}
+
+template <typename K, typename V, typename P>
+void ezIndexedPriorityQueue<K, V, P>::SetKey(ezUInt32 uiIndex, const K& key)
+{
+  EZ_ASSERT_DEBUG(uiIndex < m_Entries.GetCount(), "Out of bounds access. Queue has {0} elements, trying to access element at index {1}.",
+    m_Entries.GetCount(), uiIndex);
+
+  const bool bMoveUp = key < m_Entries[uiIndex].m_Key;
+  m_Entries[uiIndex].m_Key = key;
+
+  if (bMoveUp)
+    MoveUp(uiIndex);
+  else
+    MoveDown(uiIndex);
+}
+
+template <typename K, typename V, typename P>
+void ezIndexedPriorityQueue<K, V, P>::MoveUp(ezUInt32 uiIndex)
+{
+  Entry entry = std::move(m_Entries[uiIndex]);
+
+  while (uiIndex > 0)
+  {
+    const ezUInt32 uiParent = (uiIndex - 1) / 2;
+
+    if (!(entry.m_Key < m_Entries[uiParent].m_Key))
+      break;
+
+    SetEntry(uiIndex, std::move(m_Entries[uiParent]));
+    uiIndex = uiParent;
+  }
+
+  SetEntry(uiIndex, std::move(entry));
+}
+
+template <typename K, typename V, typename P>
+void ezIndexedPriorityQueue<K, V, P>::MoveDown(ezUInt32 uiIndex)
+{
+  const ezUInt32 uiCount = m_Entries.GetCount();
+  Entry entry = std::move(m_Entries[uiIndex]);
+
+  while (true)
+  {
+    ezUInt32 uiChild = uiIndex * 2 + 1;
+
+    if (uiChild >= uiCount)
+      break;
+
+    if (uiChild + 1 < uiCount && m_Entries[uiChild + 1].m_Key < m_Entries[uiChild].m_Key)
+      ++uiChild;
+
+    if (!(m_Entries[uiChild].m_Key < entry.m_Key))
+      break;
+
+    SetEntry(uiIndex, std::move(m_Entries[uiChild]));
+    uiIndex = uiChild;
+  }
+
+  SetEntry(uiIndex, std::move(entry));
+}
+
+template <typename K, typename V, typename P>
+EZ_ALWAYS_INLINE void ezIndexedPriorityQueue<K, V, P>::SetEntry(ezUInt32 uiIndex, Entry&& entry)
+{
+  P::SetIndex(entry.m_Value, uiIndex);
+  m_Entries[uiIndex] = std::move(entry);
+}
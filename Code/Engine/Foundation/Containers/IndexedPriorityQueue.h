@@ -0,0 +1,66 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+
+/// \brief A priority queue (binary min-heap) that tells every value where it is stored, so that values can be removed or re-prioritized
+/// in O(log n) without searching for them.
+///
+/// The value with the smallest key is at the top of the queue. Whenever a value is moved inside the queue, IndexPolicy::SetIndex(value,
+/// uiIndex) is called with the new position. When a value leaves the queue, it is called with ezInvalidIndex. Typically the values are
+/// pointers to objects that store the index in a member, which can then be passed to Remove() and SetKey().
+///
+/// The elements can be accessed through operator[], but they are only ordered as far as the heap property requires.
+template <typename KeyType, typename ValueType, typename IndexPolicy>
+class ezIndexedPriorityQueue
+{
+public:
+  struct Entry
+  {
+    EZ_DETECT_TYPE_CLASS(KeyType, ValueType);
+
+    KeyType m_Key;
+    ValueType m_Value;
+  };
+
+  /// \brief Creates an empty queue.
+  ezIndexedPriorityQueue(ezAllocatorBase* pAllocator = ezFoundation::GetDefaultAllocator()); // [tested]
+
+  /// \brief Returns the number of values in the queue.
+  ezUInt32 GetCount() const { return m_Entries.GetCount(); } // [tested]
+
+  /// \brief Returns true if the queue contains no values.
+  bool IsEmpty() const { return m_Entries.IsEmpty(); } // [tested]
+
+  /// \brief Removes all values from the queue. Their index is set to ezInvalidIndex.
+  void Clear(); // [tested]
+
+  /// \brief Reserves memory for the given number of values.
+  void Reserve(ezUInt32 uiCapacity) { m_Entries.Reserve(uiCapacity); }
+
+  /// \brief Inserts a value with the given key.
+  void Insert(const KeyType& key, const ValueType& value); // [tested]
+
+  /// \brief Returns the entry with the smallest key. The queue must not be empty.
+  const Entry& PeekTop() const; // [tested]
+
+  /// \brief Removes the entry with the smallest key. The queue must not be empty.
+  void PopTop(); // [tested]
+
+  /// \brief Removes the value at the given index.
+  void Remove(ezUInt32 uiIndex); // [tested]
+
+  /// \brief Changes the key of the value at the given index and moves the value to its new position.
+  void SetKey(ezUInt32 uiIndex, const KeyType& key); // [tested]
+
+  /// \brief Returns the entry at the given index.
+  const Entry& operator[](ezUInt32 uiIndex) const { return m_Entries[uiIndex]; } // [tested]
+
+private:
+  void MoveUp(ezUInt32 uiIndex);
+  void MoveDown(ezUInt32 uiIndex);
+  void SetEntry(ezUInt32 uiIndex, Entry&& entry);
+
+  ezDynamicArray<Entry> m_Entries;
+};
+
+#include <Foundation/Containers/Implementation/IndexedPriorityQueue_inl.h>
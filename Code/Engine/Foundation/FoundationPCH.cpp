@@ -37,6 +37,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_GlobalEvent);
   EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_IpcChannel);
   EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_IpcChannelEnet);
+  EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_Linux_PipeChannel_linux);
   EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_Message);
   EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_MessageLoop);
   EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_Mobile_MessageLoop_mobile);
@@ -90,6 +91,8 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_StreamOperations);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_StreamOperationsOther);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_StringDeduplicationContext);
+  EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_TextInputBuffer);
+  EZ_STATICLINK_REFERENCE(Foundation_Logging_Implementation_AsyncLog);
   EZ_STATICLINK_REFERENCE(Foundation_Logging_Implementation_ConsoleWriter);
   EZ_STATICLINK_REFERENCE(Foundation_Logging_Implementation_ETWWriter);
   EZ_STATICLINK_REFERENCE(Foundation_Logging_Implementation_HTMLWriter);
@@ -112,6 +115,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_Memory_Implementation_PageAllocator);
   EZ_STATICLINK_REFERENCE(Foundation_Memory_Policies_GuardedAllocation);
   EZ_STATICLINK_REFERENCE(Foundation_Profiling_Implementation_Profiling);
+  EZ_STATICLINK_REFERENCE(Foundation_Profiling_Implementation_ProfilingStream);
   EZ_STATICLINK_REFERENCE(Foundation_Reflection_Implementation_PropertyAttributes);
   EZ_STATICLINK_REFERENCE(Foundation_Reflection_Implementation_PropertyPath);
   EZ_STATICLINK_REFERENCE(Foundation_Reflection_Implementation_RTTI);
@@ -125,6 +129,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_Serialization_Implementation_ReflectionSerializer);
   EZ_STATICLINK_REFERENCE(Foundation_Serialization_Implementation_RttiConverterReader);
   EZ_STATICLINK_REFERENCE(Foundation_Serialization_Implementation_RttiConverterWriter);
+  EZ_STATICLINK_REFERENCE(Foundation_Serialization_Implementation_SerializationPlan);
   EZ_STATICLINK_REFERENCE(Foundation_SimdMath_Implementation_SimdMat4f);
   EZ_STATICLINK_REFERENCE(Foundation_SimdMath_Implementation_SimdNoise);
   EZ_STATICLINK_REFERENCE(Foundation_SimdMath_Implementation_SimdQuat);
@@ -145,6 +150,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_System_Implementation_SystemInformation);
   EZ_STATICLINK_REFERENCE(Foundation_System_Implementation_UuidGenerator);
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_ConditionVariable);
+  EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_MutexProfiling);
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_OSThread);
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_ParallelFor);
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_Task);
@@ -177,6 +183,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_Utilities_Implementation_ConversionUtils);
   EZ_STATICLINK_REFERENCE(Foundation_Utilities_Implementation_DGMLWriter);
   EZ_STATICLINK_REFERENCE(Foundation_Utilities_Implementation_GraphicsUtils);
+  EZ_STATICLINK_REFERENCE(Foundation_Utilities_Implementation_Metrics);
   EZ_STATICLINK_REFERENCE(Foundation_Utilities_Implementation_Node);
   EZ_STATICLINK_REFERENCE(Foundation_Utilities_Implementation_Progress);
   EZ_STATICLINK_REFERENCE(Foundation_Utilities_Implementation_Stats);
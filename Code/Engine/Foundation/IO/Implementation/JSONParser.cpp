@@ -8,7 +8,6 @@ ezJSONParser::ezJSONParser()
 {
   m_uiCurByte = '\0';
   m_uiNextByte = '\0';
-  m_pInput = nullptr;
   m_bSkippingMode = false;
   m_pLogInterface = nullptr;
   m_uiCurLine = 1;
@@ -24,7 +23,7 @@ void ezJSONParser::SetInputStream(ezStreamReader& stream, ezUInt32 uiFirstLineOf
   m_uiCurLine = 1 + uiFirstLineOffset;
   m_uiCurColumn = 0;
 
-  m_pInput = &stream;
+  m_Input.SetInputStream(&stream);
 
   m_uiNextByte = ' ';
   ReadCharacter(true);
@@ -459,7 +458,7 @@ void ezJSONParser::ContinueSeparator()
 
 void ezJSONParser::ReadNextByte()
 {
-  m_pInput->ReadBytes(&m_uiNextByte, sizeof(ezUInt8));
+  m_uiNextByte = m_Input.ReadByte();
 
   if (m_uiNextByte == '\n')
   {
@@ -517,12 +516,24 @@ bool ezJSONParser::ReadCharacter(bool bSkipComments)
 
 void ezJSONParser::SkipWhitespace()
 {
-  EZ_ASSERT_DEBUG(m_pInput != nullptr, "Input Stream is not set up.");
+  EZ_ASSERT_DEBUG(m_Input.HasInputStream(), "Input Stream is not set up.");
 
   do
   {
     m_uiCurByte = '\0';
 
+    // skip runs of whitespace in one go, the last whitespace character of the run becomes the next byte
+    if (ezStringUtils::IsWhiteSpace(m_uiNextByte))
+    {
+      const ezUInt32 uiNumWhiteSpace = ezTextInputBuffer::ScanWhiteSpace(m_Input.GetBufferedData(), m_Input.GetNumBufferedBytes());
+
+      if (uiNumWhiteSpace > 0)
+      {
+        m_Input.SkipBufferedBytes(uiNumWhiteSpace - 1, m_uiCurLine, m_uiCurColumn);
+        ReadNextByte();
+      }
+    }
+
     if (!ReadCharacter(true))
       return; // stop when end of stream is encountered
   } while (ezStringUtils::IsWhiteSpace(m_uiCurByte));
@@ -530,7 +541,7 @@ void ezJSONParser::SkipWhitespace()
 
 void ezJSONParser::SkipString()
 {
-  EZ_ASSERT_DEBUG(m_pInput != nullptr, "Input Stream is not set up.");
+  EZ_ASSERT_DEBUG(m_Input.HasInputStream(), "Input Stream is not set up.");
 
   m_TempString.Clear();
   m_TempString.PushBack('\0');
@@ -541,6 +552,18 @@ void ezJSONParser::SkipString()
   {
     bEscapeSequence = (m_uiCurByte == '\\');
 
+    // skip runs of regular characters in one go, the last character of the run becomes the next byte
+    if (!bEscapeSequence && m_uiNextByte != '\"' && m_uiNextByte != '\\' && m_uiNextByte != '\0')
+    {
+      const ezUInt32 uiNumChars = ezTextInputBuffer::ScanStringCharacters(m_Input.GetBufferedData(), m_Input.GetNumBufferedBytes());
+
+      if (uiNumChars > 0)
+      {
+        m_Input.SkipBufferedBytes(uiNumChars - 1, m_uiCurLine, m_uiCurColumn);
+        ReadNextByte();
+      }
+    }
+
     m_uiCurByte = '\0';
 
     if (!ReadCharacter(false))
@@ -554,7 +577,7 @@ void ezJSONParser::SkipString()
 
 void ezJSONParser::ReadString()
 {
-  EZ_ASSERT_DEBUG(m_pInput != nullptr, "Input Stream is not set up.");
+  EZ_ASSERT_DEBUG(m_Input.HasInputStream(), "Input Stream is not set up.");
 
   m_TempString.Clear();
 
@@ -564,6 +587,21 @@ void ezJSONParser::ReadString()
   {
     bEscapeSequence = (m_uiCurByte == '\\');
 
+    // copy runs of regular characters in one go, the last character of the run becomes the next byte
+    if (!bEscapeSequence && m_uiNextByte != '\"' && m_uiNextByte != '\\' && m_uiNextByte != '\0')
+    {
+      const ezUInt32 uiNumChars = ezTextInputBuffer::ScanStringCharacters(m_Input.GetBufferedData(), m_Input.GetNumBufferedBytes());
+
+      if (uiNumChars > 0)
+      {
+        m_TempString.PushBack(m_uiNextByte);
+        m_TempString.PushBackRange(ezArrayPtr<const ezUInt8>(m_Input.GetBufferedData(), uiNumChars - 1));
+
+        m_Input.SkipBufferedBytes(uiNumChars - 1, m_uiCurLine, m_uiCurColumn);
+        ReadNextByte();
+      }
+    }
+
     m_uiCurByte = '\0';
 
     if (!ReadCharacter(false))
@@ -629,7 +667,7 @@ void ezJSONParser::ReadString()
 
 void ezJSONParser::ReadWord()
 {
-  EZ_ASSERT_DEBUG(m_pInput != nullptr, "Input Stream is not set up.");
+  EZ_ASSERT_DEBUG(m_Input.HasInputStream(), "Input Stream is not set up.");
 
   m_TempString.Clear();
 
@@ -648,7 +686,7 @@ void ezJSONParser::ReadWord()
 
 double ezJSONParser::ReadNumber()
 {
-  EZ_ASSERT_DEBUG(m_pInput != nullptr, "Input Stream is not set up.");
+  EZ_ASSERT_DEBUG(m_Input.HasInputStream(), "Input Stream is not set up.");
 
   m_TempString.Clear();
 
@@ -29,17 +29,11 @@ void ezOpenDdlParser::SetCacheSize(ezUInt32 uiSizeInKB)
 }
 
 
-// Extension to default OpenDDL: We allow ':' and '.' to appear in identifier names
-bool IsDdlIdentifierCharacter(ezUInt8 byte)
-{
-  return ((byte >= 'a' && byte <= 'z') || (byte >= 'A' && byte <= 'Z') || (byte == '_') || (byte >= '0' && byte <= '9') || (byte == ':') || (byte == '.'));
-}
-
 void ezOpenDdlParser::SetInputStream(ezStreamReader& stream, ezUInt32 uiFirstLineOffset /*= 0*/)
 {
   EZ_ASSERT_DEV(m_StateStack.IsEmpty(), "OpenDDL Parser cannot be restarted");
 
-  m_pInput = &stream;
+  m_Input.SetInputStream(&stream);
 
   m_bSkippingMode = false;
   m_uiCurLine = 1 + uiFirstLineOffset;
@@ -59,7 +53,7 @@ void ezOpenDdlParser::SetInputStream(ezStreamReader& stream, ezUInt32 uiFirstLin
     // document is empty
     m_StateStack.Clear();
   }
-  else if (IsDdlIdentifierCharacter(m_uiCurByte))
+  else if (IsIdentifierCharacter(m_uiCurByte))
   {
     m_StateStack.PushBack(State::Finished);
     m_StateStack.PushBack(State::Idle);
@@ -184,7 +178,7 @@ void ezOpenDdlParser::ParsingError(const char* szMessage, bool bFatal)
 
 void ezOpenDdlParser::ReadNextByte()
 {
-  m_pInput->ReadBytes(&m_uiNextByte, sizeof(ezUInt8));
+  m_uiNextByte = m_Input.ReadByte();
 
   if (m_uiNextByte == '\n')
   {
@@ -256,6 +250,18 @@ void ezOpenDdlParser::SkipWhitespace()
   {
     m_uiCurByte = '\0';
 
+    // skip runs of whitespace in one go, the last whitespace character of the run becomes the next byte
+    if (ezStringUtils::IsWhiteSpace(m_uiNextByte))
+    {
+      const ezUInt32 uiNumWhiteSpace = ezTextInputBuffer::ScanWhiteSpace(m_Input.GetBufferedData(), m_Input.GetNumBufferedBytes());
+
+      if (uiNumWhiteSpace > 0)
+      {
+        m_Input.SkipBufferedBytes(uiNumWhiteSpace - 1, m_uiCurLine, m_uiCurColumn);
+        ReadNextByte();
+      }
+    }
+
     if (!ReadCharacterSkipComments())
       return; // stop when end of stream is encountered
   } while (ezStringUtils::IsWhiteSpace(m_uiCurByte));
@@ -537,12 +543,12 @@ void ezOpenDdlParser::ReadIdentifier(ezUInt8* szString, ezUInt32& count)
   }
   else
   {
-    if (IsDdlIdentifierCharacter(m_uiCurByte))
+    if (IsIdentifierCharacter(m_uiCurByte))
     {
       szString[count] = m_uiCurByte;
       ++count;
 
-      while ((IsDdlIdentifierCharacter(m_uiNextByte)) && count < s_uiMaxIdentifierLength)
+      while ((IsIdentifierCharacter(m_uiNextByte)) && count < s_uiMaxIdentifierLength)
       {
         if (!ReadCharacterSkipComments())
         {
@@ -562,7 +568,7 @@ void ezOpenDdlParser::ReadIdentifier(ezUInt8* szString, ezUInt32& count)
       ParsingError("Object type name is longer than 31 characters", false);
 
       // skip the rest
-      while (IsDdlIdentifierCharacter(m_uiCurByte))
+      while (IsIdentifierCharacter(m_uiCurByte))
       {
         if (!ReadCharacterSkipComments())
         {
@@ -588,6 +594,27 @@ void ezOpenDdlParser::ReadString()
   {
     const bool bEscapeSequence = (m_uiCurByte == '\\');
 
+    // copy runs of regular characters in one go, the last character of the run becomes the next byte
+    if (!bEscapeSequence && m_uiNextByte != '\"' && m_uiNextByte != '\\' && m_uiNextByte != '\0')
+    {
+      const ezUInt32 uiNumChars = ezTextInputBuffer::ScanStringCharacters(m_Input.GetBufferedData(), m_Input.GetNumBufferedBytes());
+
+      if (uiNumChars > 0)
+      {
+        while (m_uiTempStringLength + uiNumChars + 2 >= m_TempString.GetCount())
+        {
+          m_TempString.SetCountUninitialized(m_TempString.GetCount() * 2);
+        }
+
+        m_TempString[m_uiTempStringLength] = m_uiNextByte;
+        ezMemoryUtils::Copy(&m_TempString[m_uiTempStringLength + 1], m_Input.GetBufferedData(), uiNumChars - 1);
+        m_uiTempStringLength += uiNumChars;
+
+        m_Input.SkipBufferedBytes(uiNumChars - 1, m_uiCurLine, m_uiCurColumn);
+        ReadNextByte();
+      }
+    }
+
     m_uiCurByte = '\0';
 
     if (!ReadCharacter())
@@ -826,6 +853,18 @@ void ezOpenDdlParser::SkipString()
   {
     bEscapeSequence = (m_uiCurByte == '\\');
 
+    // skip runs of regular characters in one go, the last character of the run becomes the next byte
+    if (!bEscapeSequence && m_uiNextByte != '\"' && m_uiNextByte != '\\' && m_uiNextByte != '\0')
+    {
+      const ezUInt32 uiNumChars = ezTextInputBuffer::ScanStringCharacters(m_Input.GetBufferedData(), m_Input.GetNumBufferedBytes());
+
+      if (uiNumChars > 0)
+      {
+        m_Input.SkipBufferedBytes(uiNumChars - 1, m_uiCurLine, m_uiCurColumn);
+        ReadNextByte();
+      }
+    }
+
     m_uiCurByte = '\0';
 
     if (!ReadCharacter())
@@ -283,8 +283,6 @@ void ezOpenDdlWriter::OutputObjectBeginning()
   m_iIndentation++;
 }
 
-bool IsDdlIdentifierCharacter(ezUInt8 byte);
-
 void ezOpenDdlWriter::OutputObjectName(const char* szName, bool bGlobalName)
 {
   if (!ezStringUtils::IsNullOrEmpty(szName))
@@ -296,7 +294,7 @@ void ezOpenDdlWriter::OutputObjectName(const char* szName, bool bGlobalName)
     bool bEscape = false;
     for (const char* szNameCpy = szName; *szNameCpy != '\0'; ++szNameCpy)
     {
-      if (!IsDdlIdentifierCharacter(*szNameCpy))
+      if (!ezOpenDdlParser::IsIdentifierCharacter(*szNameCpy))
       {
         bEscape = true;
         break;
@@ -0,0 +1,97 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/IO/TextInputBuffer.h>
+#include <Foundation/SimdMath/SimdTypes.h>
+
+void ezTextInputBuffer::SetInputStream(ezStreamReader* pStream, ezUInt32 uiBlockSize /*= 1024 * 16*/)
+{
+  m_pInput = pStream;
+  m_Data.SetCountUninitialized(ezMath::Max<ezUInt32>(uiBlockSize, 16));
+  m_pData = m_Data.GetData();
+  m_uiReadPos = 0;
+  m_uiDataSize = 0;
+}
+
+bool ezTextInputBuffer::ReadNextBlock()
+{
+  EZ_ASSERT_DEBUG(m_pInput != nullptr, "Input Stream is not set up.");
+
+  m_uiReadPos = 0;
+  m_uiDataSize = static_cast<ezUInt32>(m_pInput->ReadBytes(m_Data.GetData(), m_Data.GetCount()));
+
+  return m_uiDataSize > 0;
+}
+
+void ezTextInputBuffer::SkipBufferedBytes(ezUInt32 uiNumBytes, ezUInt32& inout_uiLine, ezUInt32& inout_uiColumn)
+{
+  EZ_ASSERT_DEBUG(uiNumBytes <= GetNumBufferedBytes(), "Cannot skip more bytes than are buffered");
+
+  const ezUInt8* pData = GetBufferedData();
+
+  for (ezUInt32 i = 0; i < uiNumBytes; ++i)
+  {
+    if (pData[i] == '\n')
+    {
+      ++inout_uiLine;
+      inout_uiColumn = 0;
+    }
+    else
+      ++inout_uiColumn;
+  }
+
+  m_uiReadPos += uiNumBytes;
+}
+
+ezUInt32 ezTextInputBuffer::ScanWhiteSpace(const ezUInt8* pData, ezUInt32 uiNumBytes)
+{
+  ezUInt32 i = 0;
+
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+  // whitespace is every character from 1 to 32, subtracting one moves that range to 0 to 31 (and 0 to 255)
+  const __m128i one = _mm_set1_epi8(1);
+  const __m128i maxWhiteSpace = _mm_set1_epi8(31);
+
+  for (; i + 16 <= uiNumBytes; i += 16)
+  {
+    const __m128i data = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i)), one);
+    const __m128i isWhiteSpace = _mm_cmpeq_epi8(_mm_min_epu8(data, maxWhiteSpace), data);
+
+    const ezUInt32 uiMask = static_cast<ezUInt32>(_mm_movemask_epi8(isWhiteSpace));
+    if (uiMask != 0xFFFF)
+      return i + ezMath::FirstBitLow(~uiMask);
+  }
+#endif
+
+  while (i < uiNumBytes && pData[i] >= 1 && pData[i] <= 32)
+    ++i;
+
+  return i;
+}
+
+ezUInt32 ezTextInputBuffer::ScanStringCharacters(const ezUInt8* pData, ezUInt32 uiNumBytes)
+{
+  ezUInt32 i = 0;
+
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+  const __m128i quote = _mm_set1_epi8('\"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i zero = _mm_setzero_si128();
+
+  for (; i + 16 <= uiNumBytes; i += 16)
+  {
+    const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i));
+    const __m128i isSpecial = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(data, quote), _mm_cmpeq_epi8(data, backslash)), _mm_cmpeq_epi8(data, zero));
+
+    const ezUInt32 uiMask = static_cast<ezUInt32>(_mm_movemask_epi8(isSpecial));
+    if (uiMask != 0)
+      return i + ezMath::FirstBitLow(uiMask);
+  }
+#endif
+
+  while (i < uiNumBytes && pData[i] != '\"' && pData[i] != '\\' && pData[i] != '\0')
+    ++i;
+
+  return i;
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_IO_Implementation_TextInputBuffer);
@@ -3,6 +3,7 @@
 #include <Foundation/Basics.h>
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/IO/Stream.h>
+#include <Foundation/IO/TextInputBuffer.h>
 
 class ezLogInterface;
 
@@ -142,7 +143,7 @@ private:
   ezUInt32 m_uiCurLine;
   ezUInt32 m_uiCurColumn;
 
-  ezStreamReader* m_pInput;
+  ezTextInputBuffer m_Input;
   ezHybridArray<JSONState, 32> m_StateStack;
   ezHybridArray<ezUInt8, 4096> m_TempString;
 
@@ -4,6 +4,7 @@
 #include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/IO/Stream.h>
+#include <Foundation/IO/TextInputBuffer.h>
 
 class ezLogInterface;
 
@@ -40,6 +41,15 @@ public:
   /// \brief Whether an error occured during parsing that resulted in cancelation of further parsing.
   bool HadFatalParsingError() const { return m_bHadFatalParsingError; } // [tested]
 
+  /// \brief Whether the character may appear in an identifier or name.
+  ///
+  /// Extension to default OpenDDL: We allow ':' and '.' to appear in identifier names.
+  EZ_ALWAYS_INLINE static bool IsIdentifierCharacter(ezUInt8 uiByte)
+  {
+    return ((uiByte >= 'a' && uiByte <= 'z') || (uiByte >= 'A' && uiByte <= 'Z') || (uiByte == '_') || (uiByte >= '0' && uiByte <= '9') ||
+            (uiByte == ':') || (uiByte == '.'));
+  }
+
 protected:
   /// \brief Sets an ezLogInterface through which errors and warnings are reported.
   void SetLogInterface(ezLogInterface* pLog) { m_pLogInterface = pLog; }
@@ -174,7 +184,7 @@ private:
   void ReadHexString();
 
   ezHybridArray<DdlState, 32> m_StateStack;
-  ezStreamReader* m_pInput;
+  ezTextInputBuffer m_Input;
   ezDynamicArray<ezUInt8> m_Cache;
 
   static const ezUInt32 s_uiMaxIdentifierLength = 64;
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/IO/Stream.h>
+
+/// \brief Reads a stream in large blocks and hands it out byte by byte. Used by the text parsers (ezOpenDdlParser, ezJSONParser).
+///
+/// Reading every character through ezStreamReader::ReadBytes() costs a virtual function call per byte. This buffer only calls into the
+/// stream once per block. Additionally the parsers can look at the buffered data directly to skip over runs of whitespace or string
+/// characters with SIMD instructions, see ScanWhiteSpace() and ScanStringCharacters().
+///
+/// Note that the buffer reads ahead, so the stream position is undefined once the parser has started.
+class EZ_FOUNDATION_DLL ezTextInputBuffer
+{
+public:
+  /// \brief Sets the stream to read from and resets the buffer. The block size is the number of bytes that are read at once.
+  void SetInputStream(ezStreamReader* pStream, ezUInt32 uiBlockSize = 1024 * 16);
+
+  /// \brief Returns whether SetInputStream() was called.
+  EZ_ALWAYS_INLINE bool HasInputStream() const { return m_pInput != nullptr; }
+
+  /// \brief Returns the next byte of the stream or '\0' once the end of the stream has been reached.
+  EZ_ALWAYS_INLINE ezUInt8 ReadByte()
+  {
+    if (m_uiReadPos == m_uiDataSize && !ReadNextBlock())
+      return '\0';
+
+    return m_pData[m_uiReadPos++];
+  }
+
+  /// \brief Returns a pointer to the bytes that have been read from the stream, but not handed out yet.
+  EZ_ALWAYS_INLINE const ezUInt8* GetBufferedData() const { return m_pData + m_uiReadPos; }
+
+  /// \brief Returns the number of bytes that have been read from the stream, but not handed out yet. May be zero, even if the end of the
+  /// stream hasn't been reached.
+  EZ_ALWAYS_INLINE ezUInt32 GetNumBufferedBytes() const { return m_uiDataSize - m_uiReadPos; }
+
+  /// \brief Skips the given number of buffered bytes and updates the line and column counters for the skipped bytes.
+  void SkipBufferedBytes(ezUInt32 uiNumBytes, ezUInt32& inout_uiLine, ezUInt32& inout_uiColumn);
+
+  /// \brief Returns the number of bytes at the start of the given data that are whitespace, as defined by ezStringUtils::IsWhiteSpace().
+  static ezUInt32 ScanWhiteSpace(const ezUInt8* pData, ezUInt32 uiNumBytes);
+
+  /// \brief Returns the number of bytes at the start of the given data that are neither a '"', a '\\' nor a '\0'.
+  static ezUInt32 ScanStringCharacters(const ezUInt8* pData, ezUInt32 uiNumBytes);
+
+private:
+  bool ReadNextBlock();
+
+  ezStreamReader* m_pInput = nullptr;
+  ezDynamicArray<ezUInt8> m_Data;
+  const ezUInt8* m_pData = nullptr;
+  ezUInt32 m_uiReadPos = 0;
+  ezUInt32 m_uiDataSize = 0;
+};
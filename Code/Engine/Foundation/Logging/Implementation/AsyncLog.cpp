@@ -0,0 +1,534 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Algorithm/HashingUtils.h>
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/Logging/Implementation/AsyncLog.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Threading/ThreadSignal.h>
+#include <Foundation/Threading/ThreadUtils.h>
+#include <Foundation/Types/ScopeExit.h>
+
+// clang-format off
+EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, AsyncLog)
+
+  // no dependencies
+
+  ON_CORESYSTEMS_SHUTDOWN
+  {
+    ezGlobalLog::StopAsyncLogging();
+  }
+
+EZ_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+namespace
+{
+  /// \brief Each message in a ring buffer starts with this header, followed by the null terminated text and tag.
+  struct RecordHeader
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiSize;        ///< Size of the whole record including padding. Zero means that the rest of the buffer was skipped.
+    ezUInt32 m_uiTextLength;
+    ezUInt32 m_uiRepetitions; ///< If non-zero, this is not a message but the number of suppressed repetitions of the previous message.
+    ezInt8 m_EventType;
+    ezUInt8 m_uiIndentation;
+    ezUInt8 m_uiTagLength;
+    ezUInt8 m_uiPadding;
+    double m_fSeconds;
+  };
+
+  static_assert(sizeof(RecordHeader) % 8 == 0, "Records are 8 byte aligned");
+
+  /// \brief Single producer / single consumer ring buffer that one thread writes its messages to.
+  ///
+  /// When a thread exits its buffer is marked as orphaned and reused by the next new thread. Orphaned buffers that don't have the
+  /// configured size anymore are freed the next time asynchronous logging is started.
+  struct ThreadBuffer
+  {
+    explicit ThreadBuffer(ezUInt32 uiCapacity)
+      : m_uiCapacity(uiCapacity)
+    {
+      // use new, not EZ_DEFAULT_NEW, to prevent tracking, most buffers live until the process exits
+      m_pData = new ezUInt8[uiCapacity];
+    }
+
+    ~ThreadBuffer() { delete[] m_pData; }
+
+    bool IsEmpty() const { return (ezInt32)m_WritePosition == (ezInt32)m_ReadPosition; }
+
+    bool Write(const RecordHeader& header, const char* szText, const char* szTag)
+    {
+      const ezUInt32 uiRecordSize = ezMemoryUtils::AlignSize<ezUInt32>(sizeof(RecordHeader) + header.m_uiTextLength + 1 + header.m_uiTagLength + 1, 8);
+
+      ezUInt32 uiWritePos = (ezUInt32)(ezInt32)m_WritePosition;
+      const ezUInt32 uiReadPos = (ezUInt32)(ezInt32)m_ReadPosition;
+
+      const ezUInt32 uiOffset = uiWritePos & (m_uiCapacity - 1);
+      const ezUInt32 uiContiguous = m_uiCapacity - uiOffset;
+      const ezUInt32 uiSkip = uiRecordSize > uiContiguous ? uiContiguous : 0;
+
+      // positions are running counters, unsigned wrap around keeps the difference correct
+      if (m_uiCapacity - (uiWritePos - uiReadPos) < uiSkip + uiRecordSize)
+        return false;
+
+      if (uiSkip > 0)
+      {
+        reinterpret_cast<RecordHeader*>(m_pData + uiOffset)->m_uiSize = 0;
+        uiWritePos += uiSkip;
+      }
+
+      ezUInt8* pRecord = m_pData + (uiWritePos & (m_uiCapacity - 1));
+      ezMemoryUtils::Copy(reinterpret_cast<RecordHeader*>(pRecord), &header, 1);
+      reinterpret_cast<RecordHeader*>(pRecord)->m_uiSize = uiRecordSize;
+
+      char* szDst = reinterpret_cast<char*>(pRecord + sizeof(RecordHeader));
+      ezMemoryUtils::Copy(szDst, szText, header.m_uiTextLength);
+      szDst[header.m_uiTextLength] = '\0';
+      szDst += header.m_uiTextLength + 1;
+      ezMemoryUtils::Copy(szDst, szTag, header.m_uiTagLength);
+      szDst[header.m_uiTagLength] = '\0';
+
+      // publishing the new position is a full barrier, so the consumer never sees a partially written record
+      m_WritePosition = (ezInt32)(uiWritePos + uiRecordSize);
+      return true;
+    }
+
+    bool IsMoreThanHalfFull() const
+    {
+      return ((ezUInt32)(ezInt32)m_WritePosition - (ezUInt32)(ezInt32)m_ReadPosition) > m_uiCapacity / 2;
+    }
+
+    ezUInt8* m_pData = nullptr;
+    const ezUInt32 m_uiCapacity;
+
+    ezAtomicInteger32 m_WritePosition; // written by the producer only
+    ezAtomicInteger32 m_ReadPosition;  // written by the consumer only
+
+    ezAtomicInteger32 m_DroppedMessages;
+    ezAtomicInteger32 m_PendingRepetitions;
+    ezAtomicInteger32 m_LastMessageType;
+
+    // only accessed by the producer
+    ezUInt32 m_uiLastMessageHash = 0;
+    ezTime m_LastMessageTime;
+
+    ezAtomicBool m_bOrphaned;
+    ThreadBuffer* m_pNext = nullptr;
+  };
+
+  struct ThreadBufferRef
+  {
+    ~ThreadBufferRef()
+    {
+      if (m_pBuffer != nullptr)
+      {
+        m_pBuffer->m_bOrphaned = true;
+      }
+    }
+
+    ThreadBuffer* m_pBuffer = nullptr;
+  };
+
+  static ezThreadSignal s_Signal;
+
+  class LoggingThread : public ezThread
+  {
+  public:
+    LoggingThread()
+      : ezThread("ezAsyncLog")
+    {
+    }
+
+    ezAtomicBool m_bStop;
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      while (!m_bStop)
+      {
+        s_Signal.WaitForSignal(ezTime::Milliseconds(20));
+        ezAsyncLog::Drain(false);
+      }
+
+      return 0;
+    }
+  };
+
+  static thread_local ThreadBufferRef s_ThreadBuffer;
+  static thread_local bool s_bIsDraining = false;
+
+  static ezAsyncLogSettings s_Settings;
+  static ezMutex s_BufferMutex;
+  static ThreadBuffer* s_pFirstBuffer = nullptr;
+  static ezMutex s_DrainMutex;
+  static LoggingThread* s_pLoggingThread = nullptr;
+
+  /// \brief Number of threads that are currently inside ezAsyncLog::Push(). Stop() waits for this to reach zero before the final drain.
+  static ezAtomicInteger32 s_iPushesInProgress;
+
+  ThreadBuffer* GetThreadBuffer()
+  {
+    if (s_ThreadBuffer.m_pBuffer != nullptr)
+      return s_ThreadBuffer.m_pBuffer;
+
+    EZ_LOCK(s_BufferMutex);
+
+    ThreadBuffer* pBuffer = s_pFirstBuffer;
+    for (; pBuffer != nullptr; pBuffer = pBuffer->m_pNext)
+    {
+      // the repetitions of the previous thread's last message are passed on by the next drain, until then the buffer can't be reused
+      if (pBuffer->m_bOrphaned && pBuffer->IsEmpty() && (ezInt32)pBuffer->m_PendingRepetitions == 0 &&
+          pBuffer->m_uiCapacity == s_Settings.m_uiBufferSizePerThread)
+      {
+        pBuffer->m_bOrphaned = false;
+        pBuffer->m_uiLastMessageHash = 0;
+        pBuffer->m_LastMessageTime.SetZero();
+        pBuffer->m_LastMessageType = ezLogMsgType::None;
+        break;
+      }
+    }
+
+    if (pBuffer == nullptr)
+    {
+      pBuffer = new ThreadBuffer(s_Settings.m_uiBufferSizePerThread);
+      pBuffer->m_pNext = s_pFirstBuffer;
+      s_pFirstBuffer = pBuffer;
+    }
+
+    s_ThreadBuffer.m_pBuffer = pBuffer;
+    return pBuffer;
+  }
+
+  void WriteRecord(ThreadBuffer* pBuffer, ezLogMsgType::Enum type, ezUInt8 uiIndentation, const char* szText, const char* szTag,
+    double fSeconds, ezUInt32 uiRepetitions)
+  {
+    RecordHeader header;
+    header.m_EventType = type;
+    header.m_uiIndentation = uiIndentation;
+    header.m_uiRepetitions = uiRepetitions;
+    header.m_fSeconds = fSeconds;
+    header.m_uiPadding = 0;
+
+    header.m_uiTextLength = ezStringUtils::GetStringElementCount(szText);
+    header.m_uiTagLength = static_cast<ezUInt8>(ezMath::Min(ezStringUtils::GetStringElementCount(szTag), 255u));
+
+    // very long messages are truncated to a quarter of the buffer, instead of being dropped
+    const ezUInt32 uiMaxTextLength = pBuffer->m_uiCapacity / 4;
+    if (header.m_uiTextLength > uiMaxTextLength)
+    {
+      header.m_uiTextLength = uiMaxTextLength;
+
+      // don't cut a multi-byte character in half
+      while (header.m_uiTextLength > 0 && ezUnicodeUtils::IsUtf8ContinuationByte(szText[header.m_uiTextLength]))
+        --header.m_uiTextLength;
+    }
+
+    if (!pBuffer->Write(header, szText, szTag))
+    {
+      pBuffer->m_DroppedMessages.Increment();
+      ezAsyncLog::s_DroppedMessages.Increment();
+    }
+  }
+
+  void Broadcast(const RecordHeader& header, const char* szText, const char* szTag)
+  {
+    ezLoggingEventData le;
+    le.m_EventType = static_cast<ezLogMsgType::Enum>(header.m_EventType);
+    le.m_uiIndentation = header.m_uiIndentation;
+    le.m_szText = le.m_EventType == ezLogMsgType::Flush ? nullptr : szText;
+    le.m_szTag = szTag;
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    le.m_fSeconds = header.m_fSeconds;
+#endif
+
+    ezStringBuilder sTemp;
+    if (header.m_uiRepetitions > 0)
+    {
+      sTemp.Format("Last message repeated {} more times.", header.m_uiRepetitions);
+      le.m_szText = sTemp;
+    }
+
+    ezAsyncLog::BroadcastEvent(le);
+  }
+
+  void BroadcastRepetitions(ezLogMsgType::Enum type, ezUInt32 uiRepetitions)
+  {
+    RecordHeader header = {};
+    header.m_EventType = type;
+    header.m_uiRepetitions = uiRepetitions;
+
+    Broadcast(header, "", "");
+  }
+
+  void DrainBuffer(ThreadBuffer* pBuffer)
+  {
+    ezUInt32 uiReadPos = (ezUInt32)(ezInt32)pBuffer->m_ReadPosition;
+
+    // only drain what was there when we started, log writers may log themselves
+    const ezUInt32 uiWritePos = (ezUInt32)(ezInt32)pBuffer->m_WritePosition;
+
+    while (uiReadPos != uiWritePos)
+    {
+      const ezUInt32 uiOffset = uiReadPos & (pBuffer->m_uiCapacity - 1);
+      const RecordHeader* pHeader = reinterpret_cast<const RecordHeader*>(pBuffer->m_pData + uiOffset);
+
+      if (pHeader->m_uiSize == 0)
+      {
+        uiReadPos += pBuffer->m_uiCapacity - uiOffset;
+        continue;
+      }
+
+      const char* szText = reinterpret_cast<const char*>(pHeader + 1);
+      const char* szTag = szText + pHeader->m_uiTextLength + 1;
+
+      Broadcast(*pHeader, szText, szTag);
+
+      uiReadPos += pHeader->m_uiSize;
+      pBuffer->m_ReadPosition = (ezInt32)uiReadPos;
+    }
+
+    pBuffer->m_ReadPosition = (ezInt32)uiReadPos;
+
+    const ezInt32 iDropped = pBuffer->m_DroppedMessages.Set(0);
+    if (iDropped > 0)
+    {
+      ezStringBuilder sTemp;
+      sTemp.Format("{} log messages were dropped, because the asynchronous log buffer of a thread was full.", iDropped);
+
+      ezLoggingEventData le;
+      le.m_EventType = ezLogMsgType::WarningMsg;
+      le.m_szText = sTemp;
+      ezAsyncLog::BroadcastEvent(le);
+    }
+  }
+} // namespace
+
+ezAtomicBool ezAsyncLog::s_bActive;
+ezAtomicInteger32 ezAsyncLog::s_DroppedMessages;
+ezAtomicInteger32 ezAsyncLog::s_SuppressedDuplicates;
+
+void ezAsyncLog::Start(const ezAsyncLogSettings& settings)
+{
+  EZ_LOCK(s_DrainMutex);
+
+  if (s_bActive)
+    return;
+
+  EZ_ASSERT_DEV(ezMath::IsPowerOf2(settings.m_uiBufferSizePerThread) && settings.m_uiBufferSizePerThread >= 1024,
+    "The log buffer size must be a power of two and at least 1KB");
+
+  {
+    EZ_LOCK(s_BufferMutex);
+    s_Settings = settings;
+
+    // Drain() only iterates the list while holding the drain mutex, so unused buffers of the wrong size can be freed here
+    ThreadBuffer** ppBuffer = &s_pFirstBuffer;
+    while (*ppBuffer != nullptr)
+    {
+      ThreadBuffer* pBuffer = *ppBuffer;
+
+      if (pBuffer->m_bOrphaned && pBuffer->IsEmpty() && (ezInt32)pBuffer->m_PendingRepetitions == 0 &&
+          pBuffer->m_uiCapacity != settings.m_uiBufferSizePerThread)
+      {
+        *ppBuffer = pBuffer->m_pNext;
+        delete pBuffer;
+      }
+      else
+      {
+        ppBuffer = &pBuffer->m_pNext;
+      }
+    }
+  }
+
+  s_pLoggingThread = EZ_DEFAULT_NEW(LoggingThread);
+  s_pLoggingThread->Start();
+
+  s_bActive = true;
+}
+
+void ezAsyncLog::Stop()
+{
+  LoggingThread* pThread = nullptr;
+
+  {
+    EZ_LOCK(s_DrainMutex);
+
+    if (!s_bActive)
+      return;
+
+    s_bActive = false;
+
+    pThread = s_pLoggingThread;
+    s_pLoggingThread = nullptr;
+  }
+
+  // a thread that saw s_bActive before it was reset may still be writing a message, which the final drain must not miss
+  while ((ezInt32)s_iPushesInProgress > 0)
+  {
+    ezThreadUtils::YieldTimeSlice();
+  }
+
+  // the logging thread needs the drain mutex, so it must not be held while joining
+  pThread->m_bStop = true;
+  s_Signal.RaiseSignal();
+  pThread->Join();
+  EZ_DEFAULT_DELETE(pThread);
+
+  Drain(true);
+}
+
+bool ezAsyncLog::Push(const ezLoggingEventData& le)
+{
+  // has to be announced before s_bActive is checked, see Stop()
+  s_iPushesInProgress.Increment();
+  EZ_SCOPE_EXIT(s_iPushesInProgress.Decrement());
+
+  if (!s_bActive)
+  {
+    // Stop() may still be draining, this thread's earlier messages have to be passed on before it logs synchronously
+    if (s_ThreadBuffer.m_pBuffer != nullptr && !s_ThreadBuffer.m_pBuffer->IsEmpty())
+    {
+      Drain(true);
+    }
+
+    return false;
+  }
+
+  ThreadBuffer* pBuffer = GetThreadBuffer();
+
+  const ezLogMsgType::Enum type = le.m_EventType;
+  const bool bIsMessage = type > ezLogMsgType::None && type < ezLogMsgType::All;
+
+  if (bIsMessage && s_Settings.m_DuplicateInterval.IsPositive())
+  {
+    const char* szText = le.m_szText != nullptr ? le.m_szText : "";
+    const ezUInt32 uiHash = ezHashingUtils::xxHash32(szText, ezStringUtils::GetStringElementCount(szText), static_cast<ezUInt32>(type));
+    const ezTime tNow = ezTime::Now();
+
+    if (uiHash == pBuffer->m_uiLastMessageHash && tNow - pBuffer->m_LastMessageTime < s_Settings.m_DuplicateInterval)
+    {
+      pBuffer->m_PendingRepetitions.Increment();
+      s_SuppressedDuplicates.Increment();
+      return true;
+    }
+
+    const ezInt32 iRepetitions = pBuffer->m_PendingRepetitions.Set(0);
+    if (iRepetitions > 0)
+    {
+      WriteRecord(pBuffer, static_cast<ezLogMsgType::Enum>((ezInt32)pBuffer->m_LastMessageType), le.m_uiIndentation, "", "", 0.0, iRepetitions);
+    }
+
+    pBuffer->m_uiLastMessageHash = uiHash;
+    pBuffer->m_LastMessageTime = tNow;
+    pBuffer->m_LastMessageType = type;
+  }
+
+  double fSeconds = 0.0;
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  fSeconds = le.m_fSeconds;
+#endif
+
+  WriteRecord(pBuffer, type, le.m_uiIndentation, le.m_szText != nullptr ? le.m_szText : "", le.m_szTag != nullptr ? le.m_szTag : "", fSeconds, 0);
+
+  // errors and explicit flushes should show up quickly, everything else is picked up periodically
+  if (type == ezLogMsgType::ErrorMsg || type == ezLogMsgType::SeriousWarningMsg || type == ezLogMsgType::Flush || pBuffer->IsMoreThanHalfFull())
+  {
+    s_Signal.RaiseSignal();
+  }
+
+  return true;
+}
+
+void ezAsyncLog::Drain(bool bFlushRepetitions)
+{
+  // a log writer that removes itself or flushes the log while it is called would otherwise process the same messages twice
+  if (s_bIsDraining)
+    return;
+
+  EZ_LOCK(s_DrainMutex);
+  s_bIsDraining = true;
+
+  ThreadBuffer* pFirstBuffer = nullptr;
+  {
+    // buffers are only ever added at the front of the list, so everything after the first one can be iterated without the lock
+    EZ_LOCK(s_BufferMutex);
+    pFirstBuffer = s_pFirstBuffer;
+  }
+
+  for (ThreadBuffer* pBuffer = pFirstBuffer; pBuffer != nullptr; pBuffer = pBuffer->m_pNext)
+  {
+    DrainBuffer(pBuffer);
+
+    ezInt32 iRepetitions = 0;
+    ezInt32 iLastMessageType = pBuffer->m_LastMessageType;
+
+    if (bFlushRepetitions)
+    {
+      iRepetitions = pBuffer->m_PendingRepetitions.Set(0);
+    }
+    else if (pBuffer->m_bOrphaned)
+    {
+      // the thread of an orphaned buffer won't log anything anymore, so its repetitions don't need to wait for the next message,
+      // the lock makes sure the buffer isn't reused by a new thread in the meantime
+      EZ_LOCK(s_BufferMutex);
+
+      if (pBuffer->m_bOrphaned)
+      {
+        iRepetitions = pBuffer->m_PendingRepetitions.Set(0);
+        iLastMessageType = pBuffer->m_LastMessageType;
+      }
+    }
+
+    if (iRepetitions > 0)
+    {
+      BroadcastRepetitions(static_cast<ezLogMsgType::Enum>(iLastMessageType), iRepetitions);
+    }
+  }
+
+  s_bIsDraining = false;
+}
+
+void ezAsyncLog::BroadcastEvent(const ezLoggingEventData& le)
+{
+  ezGlobalLog::s_LoggingEvent.Broadcast(le);
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+void ezGlobalLog::StartAsyncLogging(const ezAsyncLogSettings& settings)
+{
+  ezAsyncLog::Start(settings);
+}
+
+void ezGlobalLog::StopAsyncLogging()
+{
+  ezAsyncLog::Stop();
+}
+
+bool ezGlobalLog::IsAsyncLogging()
+{
+  return ezAsyncLog::IsActive();
+}
+
+void ezGlobalLog::FlushAsyncLogging()
+{
+  if (!ezAsyncLog::IsActive())
+    return;
+
+  ezAsyncLog::Drain(true);
+}
+
+ezUInt32 ezGlobalLog::GetDroppedMessageCount()
+{
+  return static_cast<ezUInt32>((ezInt32)ezAsyncLog::s_DroppedMessages);
+}
+
+ezUInt32 ezGlobalLog::GetSuppressedDuplicateCount()
+{
+  return static_cast<ezUInt32>((ezInt32)ezAsyncLog::s_SuppressedDuplicates);
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Logging_Implementation_AsyncLog);
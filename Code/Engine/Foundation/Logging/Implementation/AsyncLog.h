@@ -0,0 +1,33 @@
+#pragma once
+
+#include <Foundation/Logging/Log.h>
+
+/// \brief Internal implementation of the asynchronous mode of ezGlobalLog.
+///
+/// Every thread that logs gets its own single producer / single consumer ring buffer, so logging a message never takes a lock.
+/// The logging thread (or whoever calls Drain()) is the only consumer of all buffers.
+class ezAsyncLog
+{
+public:
+  static void Start(const ezAsyncLogSettings& settings);
+  static void Stop();
+
+  static bool IsActive() { return s_bActive; }
+
+  /// \brief Copies the message into the ring buffer of the calling thread. Returns false, if asynchronous logging is not active.
+  static bool Push(const ezLoggingEventData& le);
+
+  /// \brief Passes all messages that are in the ring buffers to the log writers.
+  ///
+  /// If bFlushRepetitions is set, the repetition counts of duplicate messages that were suppressed are passed on as well.
+  static void Drain(bool bFlushRepetitions);
+
+  /// \brief Passes the event to the log writers of ezGlobalLog.
+  static void BroadcastEvent(const ezLoggingEventData& le);
+
+  static ezAtomicInteger32 s_DroppedMessages;
+  static ezAtomicInteger32 s_SuppressedDuplicates;
+
+private:
+  static ezAtomicBool s_bActive;
+};
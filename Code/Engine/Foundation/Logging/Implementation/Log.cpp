@@ -1,5 +1,6 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/Logging/Implementation/AsyncLog.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Strings/StringBuilder.h>
 #include <Foundation/Time/Time.h>
@@ -31,11 +32,16 @@ ezEventSubscriptionID ezGlobalLog::AddLogWriter(ezLoggingEvent::Handler handler)
 
 void ezGlobalLog::RemoveLogWriter(ezLoggingEvent::Handler handler)
 {
+  // pass on everything that was logged so far, before the writer is gone
+  FlushAsyncLogging();
+
   s_LoggingEvent.RemoveEventHandler(handler);
 }
 
 void ezGlobalLog::RemoveLogWriter(ezEventSubscriptionID subscriptionID)
 {
+  FlushAsyncLogging();
+
   s_LoggingEvent.RemoveEventHandler(subscriptionID);
 }
 
@@ -76,7 +82,10 @@ void ezGlobalLog::HandleLogMessage(const ezLoggingEventData& le)
     if ((ThisType > ezLogMsgType::None) && (ThisType < ezLogMsgType::All))
       s_uiMessageCount[ThisType].Increment();
 
-    s_LoggingEvent.Broadcast(le);
+    if (!ezAsyncLog::Push(le))
+    {
+      s_LoggingEvent.Broadcast(le);
+    }
   }
 }
 
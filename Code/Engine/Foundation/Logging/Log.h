@@ -17,6 +17,7 @@
 
 // Forward declaration, class is at the end of this file
 class ezLogBlock;
+class ezAsyncLog;
 
 
 /// \brief Describes the types of events that ezLog sends.
@@ -103,10 +104,30 @@ public:
 };
 
 
+/// \brief Settings for asynchronous logging, see ezGlobalLog::StartAsyncLogging().
+struct ezAsyncLogSettings
+{
+  /// \brief Size of the ring buffer that each logging thread writes its messages to. Must be a power of two.
+  ///
+  /// Messages that do not fit into the buffer anymore are dropped and counted, until the logging thread has caught up.
+  /// The size only affects threads that log for the first time after asynchronous logging was started, existing buffers are reused.
+  ezUInt32 m_uiBufferSizePerThread = 64 * 1024;
+
+  /// \brief Identical messages that one thread logs again within this interval are only counted and not passed to the log writers.
+  ///
+  /// Once the interval has passed, the next occurrence is logged again, preceded by a message how often it was repeated.
+  /// Set to zero to pass on every message.
+  ezTime m_DuplicateInterval = ezTime::Seconds(1);
+};
+
 /// \brief This is the standard log system that ezLog sends all messages to.
 ///
 /// It allows to register log writers, such that you can be informed of all log messages and write them
 /// to different outputs.
+///
+/// By default the log writers are called synchronously on the thread that logs a message. After StartAsyncLogging() was called,
+/// messages are copied into a per thread ring buffer instead and a dedicated logging thread passes them on to the log writers.
+/// This keeps formatting and file I/O of the writers out of the calling code, which matters when messages are logged every frame.
 class EZ_FOUNDATION_DLL ezGlobalLog : public ezLogInterface
 {
 public:
@@ -132,7 +153,35 @@ public:
   /// override is set at the moment.
   static void SetGlobalLogOverride(ezLogInterface* pInterface);
 
+  /// \brief Starts passing messages to the log writers on a separate logging thread. See ezAsyncLogSettings.
+  ///
+  /// Log writers are then called on the logging thread, so they must not rely on being called on the thread that logged the message.
+  /// Messages of one thread (including log block begin and end events) keep their order, messages of different threads may be
+  /// interleaved differently than they were logged. Messages that go to the global log override are still handled synchronously.
+  static void StartAsyncLogging(const ezAsyncLogSettings& settings = ezAsyncLogSettings());
+
+  /// \brief Passes all pending messages to the log writers and returns to synchronous logging.
+  ///
+  /// This is also done automatically when the core systems are shut down.
+  static void StopAsyncLogging();
+
+  /// \brief Returns whether messages are currently passed to the log writers on the logging thread.
+  static bool IsAsyncLogging();
+
+  /// \brief Passes all messages that were logged so far to the log writers, on the calling thread. Blocks until that is done.
+  ///
+  /// Does nothing, if asynchronous logging is not active. Called by the crash handler, to not lose the messages that led to a crash.
+  static void FlushAsyncLogging();
+
+  /// \brief Returns how many messages were dropped in asynchronous mode, because the ring buffer of the logging thread was full.
+  static ezUInt32 GetDroppedMessageCount();
+
+  /// \brief Returns how many messages were not passed on in asynchronous mode, because they were duplicates of the previous message.
+  static ezUInt32 GetSuppressedDuplicateCount();
+
 private:
+  friend class ezAsyncLog;
+
   /// \brief Counts the number of messages of each type.
   static ezAtomicInteger32 s_uiMessageCount[ezLogMsgType::ENUM_COUNT];
 
@@ -3,10 +3,13 @@
 #include <Foundation/Communication/DataTransfer.h>
 #include <Foundation/Configuration/CVar.h>
 #include <Foundation/Configuration/Startup.h>
+#include <Foundation/Containers/HashTable.h>
 #include <Foundation/Containers/IdTable.h>
 #include <Foundation/Containers/StaticRingBuffer.h>
 #include <Foundation/IO/JSONWriter.h>
 #include <Foundation/Memory/CommonAllocators.h>
+#include <Foundation/Memory/MemoryTracker.h>
+#include <Foundation/Profiling/Implementation/ProfilingStream.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Threading/ThreadUtils.h>
 
@@ -137,6 +140,9 @@ void ezProfilingSystem::ProfilingData::Clear()
   m_FrameStartTimes.Clear();
   m_GPUScopes.Clear();
   m_ThreadInfos.Clear();
+  m_FlowEvents.Clear();
+  m_CounterValues.Clear();
+  m_Strings.Clear();
 }
 
 void ezProfilingSystem::ProfilingData::Merge(ProfilingData& out_Merged, ezArrayPtr<const ProfilingData*> inputs)
@@ -150,10 +156,13 @@ void ezProfilingSystem::ProfilingData::Merge(ProfilingData& out_Merged, ezArrayP
   out_Merged.m_uiFramesThreadID = inputs[0]->m_uiFramesThreadID;
   out_Merged.m_uiGPUThreadID = inputs[0]->m_uiGPUThreadID;
 
-  // concatenate m_FrameStartTimes and m_GPUScopes and m_uiFrameCount
+  // concatenate m_FrameStartTimes, m_GPUScopes, m_FlowEvents, m_CounterValues, m_Strings and m_uiFrameCount
   {
     ezUInt32 uiNumFrameStartTimes = 0;
     ezUInt32 uiNumGpuScopes = 0;
+    ezUInt32 uiNumFlowEvents = 0;
+    ezUInt32 uiNumCounterValues = 0;
+    ezUInt32 uiNumStrings = 0;
 
     for (const auto& pd : inputs)
     {
@@ -161,15 +170,48 @@ void ezProfilingSystem::ProfilingData::Merge(ProfilingData& out_Merged, ezArrayP
 
       uiNumFrameStartTimes += pd->m_FrameStartTimes.GetCount();
       uiNumGpuScopes += pd->m_GPUScopes.GetCount();
+      uiNumFlowEvents += pd->m_FlowEvents.GetCount();
+      uiNumCounterValues += pd->m_CounterValues.GetCount();
+      uiNumStrings += pd->m_Strings.GetCount();
     }
 
     out_Merged.m_FrameStartTimes.Reserve(uiNumFrameStartTimes);
     out_Merged.m_GPUScopes.Reserve(uiNumGpuScopes);
+    out_Merged.m_FlowEvents.Reserve(uiNumFlowEvents);
+    out_Merged.m_CounterValues.Reserve(uiNumCounterValues);
+    out_Merged.m_Strings.Reserve(uiNumStrings);
 
     for (const auto& pd : inputs)
     {
       out_Merged.m_FrameStartTimes.PushBackRange(pd->m_FrameStartTimes);
       out_Merged.m_GPUScopes.PushBackRange(pd->m_GPUScopes);
+      out_Merged.m_CounterValues.PushBackRange(pd->m_CounterValues);
+      out_Merged.m_Strings.PushBackRange(pd->m_Strings);
+    }
+  }
+
+  // merge m_FlowEvents
+  // flow IDs are only unique within a single capture, so every input gets its own range of IDs in the merged data
+  {
+    ezUInt64 uiNextFlowId = 1;
+    ezHashTable<ezUInt64, ezUInt64> flowIdMapping;
+
+    for (const auto& pd : inputs)
+    {
+      flowIdMapping.Clear();
+
+      for (FlowEvent flowEvent : pd->m_FlowEvents)
+      {
+        ezUInt64* pMappedId = nullptr;
+        if (!flowIdMapping.TryGetValue(flowEvent.m_uiFlowId, pMappedId))
+        {
+          pMappedId = &flowIdMapping[flowEvent.m_uiFlowId];
+          *pMappedId = uiNextFlowId++;
+        }
+
+        flowEvent.m_uiFlowId = *pMappedId;
+        out_Merged.m_FlowEvents.PushBack(flowEvent);
+      }
     }
   }
 
@@ -459,6 +501,62 @@ ezResult ezProfilingSystem::ProfilingData::Write(ezStreamWriter& outputStream) c
       }
     }
 
+    // flow events
+    {
+      for (const FlowEvent& e : m_FlowEvents)
+      {
+        writer.BeginObject();
+        writer.AddVariableString("name", e.m_szName);
+        writer.AddVariableString("cat", e.m_szName);
+        writer.AddVariableUInt64("id", e.m_uiFlowId);
+        writer.AddVariableUInt32("pid", m_uiProcessID);
+        writer.AddVariableUInt64("tid", e.m_uiThreadId + 2);
+        writer.AddVariableUInt64("ts", static_cast<ezUInt64>(e.m_Time.GetMicroseconds()));
+
+        switch (e.m_Type)
+        {
+          case FlowEventType::Start:
+            writer.AddVariableString("ph", "s");
+            break;
+          case FlowEventType::Step:
+            writer.AddVariableString("ph", "t");
+            break;
+          case FlowEventType::Finish:
+            writer.AddVariableString("ph", "f");
+            writer.AddVariableString("bp", "e");
+            break;
+        }
+
+        writer.EndObject();
+        if (writer.HadWriteError())
+        {
+          return EZ_FAILURE;
+        }
+      }
+    }
+
+    // counters
+    {
+      for (const CounterValue& e : m_CounterValues)
+      {
+        writer.BeginObject();
+        writer.AddVariableString("name", e.m_szName);
+        writer.AddVariableUInt32("pid", m_uiProcessID);
+        writer.AddVariableUInt64("ts", static_cast<ezUInt64>(e.m_Time.GetMicroseconds()));
+        writer.AddVariableString("ph", "C");
+
+        writer.BeginObject("args");
+        writer.AddVariableDouble("value", e.m_fValue);
+        writer.EndObject();
+
+        writer.EndObject();
+        if (writer.HadWriteError())
+        {
+          return EZ_FAILURE;
+        }
+      }
+    }
+
     writer.EndArray();
   }
 
@@ -589,7 +687,21 @@ void ezProfilingSystem::StartNewFrame()
     s_FrameStartTimes.PopFront();
   }
 
-  s_FrameStartTimes.PushBack(ezTime::Now());
+  const ezTime now = ezTime::Now();
+  s_FrameStartTimes.PushBack(now);
+
+  if (ezProfilingStream::IsActive())
+  {
+    ezProfilingStream::AddFrame(now);
+
+    // the allocator table of the memory tracker is not locked while iterating, so it is only sampled here on the main thread
+    ezStringBuilder sName;
+    for (auto it = ezMemoryTracker::GetIterator(); it.IsValid(); ++it)
+    {
+      sName.Set("Memory/", it.Name());
+      ezProfilingStream::AddCounterValue(sName, static_cast<double>(it.Stats().m_uiAllocationSize));
+    }
+  }
 }
 
 // static
@@ -599,6 +711,11 @@ void ezProfilingSystem::AddCPUScope(const char* szName, const char* szFunctionNa
   if (endTime - beginTime < ezTime::Milliseconds(CVarDiscardThresholdMs))
     return;
 
+  if (ezProfilingStream::IsActive())
+  {
+    ezProfilingStream::AddCPUScope(szName, szFunctionName, beginTime, endTime);
+  }
+
   ::CpuScopesBufferBase* pScopes = s_CpuScopes;
 
   if (pScopes == nullptr)
@@ -702,6 +819,11 @@ void ezProfilingSystem::SetThreadName(const char* szThreadName)
   ThreadInfo& info = s_ThreadInfos.ExpandAndGetRef();
   info.m_uiThreadId = (ezUInt64)ezThreadUtils::GetCurrentThreadID();
   info.m_sName = szThreadName;
+
+  if (ezProfilingStream::IsActive())
+  {
+    ezProfilingStream::AddThreadName(info.m_uiThreadId, szThreadName);
+  }
 }
 
 // static
@@ -727,6 +849,11 @@ void ezProfilingSystem::AddGPUScope(const char* szName, ezTime beginTime, ezTime
   if (endTime - beginTime < ezTime::Milliseconds(CVarDiscardThresholdMs))
     return;
 
+  if (ezProfilingStream::IsActive())
+  {
+    ezProfilingStream::AddGPUScope(szName, beginTime, endTime);
+  }
+
   if (!s_GPUScopes->CanAppend())
   {
     s_GPUScopes->PopFront();
@@ -740,6 +867,64 @@ void ezProfilingSystem::AddGPUScope(const char* szName, ezTime beginTime, ezTime
   s_GPUScopes->PushBack(scope);
 }
 
+// static
+ezResult ezProfilingSystem::StartStreamingCapture(ezStreamWriter& outputStream)
+{
+#  if EZ_ENABLED(EZ_SUPPORTS_PROCESSES)
+  const ezUInt32 uiProcessID = static_cast<ezUInt32>(ezProcess::GetCurrentProcessID());
+#  else
+  const ezUInt32 uiProcessID = 0;
+#  endif
+
+  EZ_LOCK(s_ThreadInfosMutex);
+  return ezProfilingStream::Start(outputStream, s_ThreadInfos, uiProcessID);
+}
+
+// static
+ezResult ezProfilingSystem::StopStreamingCapture()
+{
+  return ezProfilingStream::Stop();
+}
+
+// static
+bool ezProfilingSystem::IsStreamingCapture()
+{
+  return ezProfilingStream::IsActive();
+}
+
+// static
+ezResult ezProfilingSystem::ReadStreamingCapture(ezStreamReader& inputStream, ProfilingData& out_Capture)
+{
+  return ezProfilingStream::Read(inputStream, out_Capture);
+}
+
+// static
+void ezProfilingSystem::AddFlowEvent(FlowEventType type, ezUInt64 uiFlowId)
+{
+  if (ezProfilingStream::IsActive())
+  {
+    ezProfilingStream::AddFlowEvent(type, uiFlowId);
+  }
+}
+
+// static
+void ezProfilingSystem::AddFlowDependency(ezUInt64 uiFlowId, ezUInt64 uiDependsOnFlowId)
+{
+  if (ezProfilingStream::IsActive())
+  {
+    ezProfilingStream::AddFlowDependency(uiFlowId, uiDependsOnFlowId);
+  }
+}
+
+// static
+void ezProfilingSystem::AddCounterValue(const char* szName, double fValue)
+{
+  if (ezProfilingStream::IsActive())
+  {
+    ezProfilingStream::AddCounterValue(szName, fValue);
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 ezProfilingScope::ezProfilingScope(const char* szName, const char* szFunctionName)
@@ -819,6 +1004,32 @@ void ezProfilingSystem::InitializeGPUData() {}
 
 void ezProfilingSystem::AddGPUScope(const char* szName, ezTime beginTime, ezTime endTime) {}
 
+ezResult ezProfilingSystem::StartStreamingCapture(ezStreamWriter& outputStream)
+{
+  return EZ_FAILURE;
+}
+
+ezResult ezProfilingSystem::StopStreamingCapture()
+{
+  return EZ_FAILURE;
+}
+
+bool ezProfilingSystem::IsStreamingCapture()
+{
+  return false;
+}
+
+ezResult ezProfilingSystem::ReadStreamingCapture(ezStreamReader& inputStream, ProfilingData& out_Capture)
+{
+  return EZ_FAILURE;
+}
+
+void ezProfilingSystem::AddFlowEvent(FlowEventType type, ezUInt64 uiFlowId) {}
+
+void ezProfilingSystem::AddFlowDependency(ezUInt64 uiFlowId, ezUInt64 uiDependsOnFlowId) {}
+
+void ezProfilingSystem::AddCounterValue(const char* szName, double fValue) {}
+
 #endif
 
 EZ_STATICLINK_FILE(Foundation, Foundation_Profiling_Implementation_Profiling);
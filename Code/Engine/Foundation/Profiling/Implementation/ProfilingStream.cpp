@@ -0,0 +1,898 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Algorithm/HashingUtils.h>
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/IO/Stream.h>
+#include <Foundation/Profiling/Implementation/ProfilingStream.h>
+#include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Threading/ThreadSignal.h>
+#include <Foundation/Threading/ThreadUtils.h>
+#include <Foundation/Utilities/Stats.h>
+
+#if EZ_ENABLED(EZ_USE_PROFILING)
+
+// clang-format off
+EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, ProfilingStream)
+
+  // no dependencies
+
+  ON_CORESYSTEMS_SHUTDOWN
+  {
+    ezProfilingSystem::StopStreamingCapture().IgnoreResult();
+  }
+
+EZ_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+namespace
+{
+  constexpr ezUInt8 FORMAT_VERSION = 1;
+  constexpr ezUInt64 GPU_THREAD_ID = 0xFFFFFFFFFFFFFFFFull;
+
+  enum class BlockType : ezUInt8
+  {
+    Name = 1,       ///< varint name ID, followed by the name
+    ThreadName = 2, ///< varint thread ID, followed by the name
+    Events = 3,     ///< varint thread ID, followed by events of type EventType
+  };
+
+  enum class EventType : ezUInt8
+  {
+    Scope = 1,      ///< varint name ID, varint function name ID (0 for none), time delta of the begin time, varint duration in ns
+    Frame,          ///< time delta of the frame start
+    FlowStart,      ///< varint flow ID, time delta
+    FlowStep,       ///< varint flow ID, time delta
+    FlowFinish,     ///< varint flow ID, time delta
+    FlowDependency, ///< varint flow ID, varint flow ID of the dependency
+    Counter,        ///< varint name ID, time delta, 8 byte double value
+  };
+
+  void WriteVarUInt(ezDynamicArray<ezUInt8>& ref_data, ezUInt64 uiValue)
+  {
+    while (uiValue >= 0x80)
+    {
+      ref_data.PushBack(static_cast<ezUInt8>(uiValue | 0x80));
+      uiValue >>= 7;
+    }
+
+    ref_data.PushBack(static_cast<ezUInt8>(uiValue));
+  }
+
+  void WriteVarInt(ezDynamicArray<ezUInt8>& ref_data, ezInt64 iValue)
+  {
+    // zigzag encoding, so that small negative values also only need few bytes
+    WriteVarUInt(ref_data, (static_cast<ezUInt64>(iValue) << 1) ^ static_cast<ezUInt64>(iValue >> 63));
+  }
+
+  ezUInt32 GetVarUIntSize(ezUInt64 uiValue)
+  {
+    ezUInt32 uiSize = 1;
+    while (uiValue >= 0x80)
+    {
+      ++uiSize;
+      uiValue >>= 7;
+    }
+    return uiSize;
+  }
+
+  ezInt64 ToNanoseconds(ezTime time)
+  {
+    return static_cast<ezInt64>(time.GetNanoseconds());
+  }
+
+  void WriteNameBlock(ezDynamicArray<ezUInt8>& ref_data, BlockType type, ezUInt64 uiId, const char* szName, ezUInt32 uiLength)
+  {
+    ref_data.PushBack(static_cast<ezUInt8>(type));
+    WriteVarUInt(ref_data, GetVarUIntSize(uiId) + uiLength);
+    WriteVarUInt(ref_data, uiId);
+    ref_data.PushBackRange(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(szName), uiLength));
+  }
+
+  /// \brief The events of one thread, that were not written to the stream yet.
+  ///
+  /// Buffers are never deallocated, when a thread exits its buffer is marked as orphaned and reused by the next new thread.
+  /// The memory of the event data is released when the streaming capture is stopped.
+  struct EventBuffer
+  {
+    void WriteTime(ezTime time)
+    {
+      const ezInt64 iTimestamp = ToNanoseconds(time);
+      WriteVarInt(m_Data, iTimestamp - m_iLastTimestamp);
+      m_iLastTimestamp = iTimestamp;
+    }
+
+    ezMutex m_Mutex;
+    ezUInt64 m_uiThreadId = 0;
+    ezInt64 m_iLastTimestamp = 0;
+    ezDynamicArray<ezUInt8> m_Data;
+    ezHashTable<ezUInt64, ezUInt32> m_KnownNames; ///< Names of the global name table that this thread used already, to not need a lock for them.
+
+    ezAtomicBool m_bOrphaned;
+    EventBuffer* m_pNext = nullptr;
+  };
+
+  struct EventBufferRef
+  {
+    ~EventBufferRef()
+    {
+      if (m_pBuffer != nullptr)
+      {
+        m_pBuffer->m_bOrphaned = true;
+      }
+    }
+
+    EventBuffer* m_pBuffer = nullptr;
+  };
+
+  static ezThreadSignal s_Signal;
+
+  class StreamingThread : public ezThread
+  {
+  public:
+    StreamingThread()
+      : ezThread("ezProfilingStream")
+    {
+    }
+
+    ezAtomicBool m_bStop;
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      while (!m_bStop)
+      {
+        s_Signal.WaitForSignal(ezTime::Milliseconds(50));
+        ezProfilingStream::Flush();
+      }
+
+      return 0;
+    }
+  };
+
+  static thread_local EventBufferRef s_EventBuffer;
+
+  static ezMutex s_BufferMutex;
+  static EventBuffer* s_pFirstBuffer = nullptr;
+  static EventBuffer* s_pGPUBuffer = nullptr;
+
+  static ezMutex s_NameMutex;
+  static ezHashTable<ezUInt64, ezUInt32> s_NameIds;
+  static ezDynamicArray<ezUInt8> s_PendingNames; ///< Already encoded name blocks that were not written to the stream yet.
+
+  static ezMutex s_StreamMutex;
+  static ezStreamWriter* s_pOutputStream = nullptr;
+  static ezDynamicArray<ezUInt8> s_FlushData;
+  static bool s_bWriteFailed = false;
+  static StreamingThread* s_pStreamingThread = nullptr;
+
+  EventBuffer* CreateEventBuffer(ezUInt64 uiThreadId)
+  {
+    EZ_LOCK(s_BufferMutex);
+
+    // use new, not EZ_DEFAULT_NEW, to prevent tracking, the buffers live until the process exits
+    EventBuffer* pBuffer = new EventBuffer();
+    pBuffer->m_uiThreadId = uiThreadId;
+    pBuffer->m_pNext = s_pFirstBuffer;
+    s_pFirstBuffer = pBuffer;
+    return pBuffer;
+  }
+
+  EventBuffer* GetEventBuffer()
+  {
+    if (s_EventBuffer.m_pBuffer != nullptr)
+      return s_EventBuffer.m_pBuffer;
+
+    const ezUInt64 uiThreadId = (ezUInt64)ezThreadUtils::GetCurrentThreadID();
+
+    {
+      EZ_LOCK(s_BufferMutex);
+
+      for (EventBuffer* pBuffer = s_pFirstBuffer; pBuffer != nullptr; pBuffer = pBuffer->m_pNext)
+      {
+        if (pBuffer->m_bOrphaned)
+        {
+          EZ_LOCK(pBuffer->m_Mutex);
+
+          // the events of the previous thread have to be written first
+          if (pBuffer->m_Data.IsEmpty())
+          {
+            pBuffer->m_bOrphaned = false;
+            pBuffer->m_uiThreadId = uiThreadId;
+            pBuffer->m_iLastTimestamp = 0;
+
+            s_EventBuffer.m_pBuffer = pBuffer;
+            return pBuffer;
+          }
+        }
+      }
+    }
+
+    s_EventBuffer.m_pBuffer = CreateEventBuffer(uiThreadId);
+    return s_EventBuffer.m_pBuffer;
+  }
+
+  /// \brief Returns the ID of the given name and adds it to the name table if necessary. The event buffer must be locked.
+  ezUInt32 GetNameId(EventBuffer* pBuffer, const char* szName)
+  {
+    if (szName == nullptr)
+      return 0;
+
+    const ezUInt32 uiLength = ezStringUtils::GetStringElementCount(szName);
+    const ezUInt64 uiHash = ezHashingUtils::xxHash64(szName, uiLength);
+
+    ezUInt32 uiId = 0;
+    if (pBuffer->m_KnownNames.TryGetValue(uiHash, uiId))
+      return uiId;
+
+    {
+      EZ_LOCK(s_NameMutex);
+
+      if (!s_NameIds.TryGetValue(uiHash, uiId))
+      {
+        uiId = s_NameIds.GetCount() + 1;
+        s_NameIds.Insert(uiHash, uiId);
+
+        WriteNameBlock(s_PendingNames, BlockType::Name, uiId, szName, uiLength);
+      }
+    }
+
+    pBuffer->m_KnownNames.Insert(uiHash, uiId);
+    return uiId;
+  }
+
+  void WriteFlowEvent(EventType type, ezUInt64 uiFlowId)
+  {
+    EventBuffer* pBuffer = GetEventBuffer();
+    EZ_LOCK(pBuffer->m_Mutex);
+
+    if (!ezProfilingStream::IsActive())
+      return;
+
+    pBuffer->m_Data.PushBack(static_cast<ezUInt8>(type));
+    WriteVarUInt(pBuffer->m_Data, uiFlowId);
+    pBuffer->WriteTime(ezTime::Now());
+  }
+
+  void StatsEventHandler(const ezStats::StatsEventData& e)
+  {
+    if (e.m_EventType != ezStats::StatsEventData::Remove && e.m_NewStatValue.IsNumber())
+    {
+      ezProfilingStream::AddCounterValue(e.m_szStatName, e.m_NewStatValue.ConvertTo<double>());
+    }
+  }
+} // namespace
+
+ezAtomicBool ezProfilingStream::s_bActive;
+
+ezResult ezProfilingStream::Start(ezStreamWriter& outputStream, ezArrayPtr<const ezProfilingSystem::ThreadInfo> threadInfos, ezUInt32 uiProcessID)
+{
+  {
+    EZ_LOCK(s_StreamMutex);
+
+    if (s_pOutputStream != nullptr)
+      return EZ_FAILURE;
+
+    s_pOutputStream = &outputStream;
+
+    const char szTag[] = {'E', 'Z', 'P', 'S'};
+    s_bWriteFailed = outputStream.WriteBytes(szTag, 4).Failed();
+    outputStream << FORMAT_VERSION;
+    outputStream << uiProcessID;
+  }
+
+  {
+    EZ_LOCK(s_NameMutex);
+
+    for (const auto& info : threadInfos)
+    {
+      WriteNameBlock(s_PendingNames, BlockType::ThreadName, info.m_uiThreadId, info.m_sName.GetData(), info.m_sName.GetElementCount());
+    }
+  }
+
+  if (s_pGPUBuffer == nullptr)
+  {
+    s_pGPUBuffer = CreateEventBuffer(GPU_THREAD_ID);
+  }
+
+  s_bActive = true;
+
+  ezStats::AddEventHandler(&StatsEventHandler);
+
+  s_pStreamingThread = EZ_DEFAULT_NEW(StreamingThread);
+  s_pStreamingThread->Start();
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezProfilingStream::Stop()
+{
+  {
+    EZ_LOCK(s_StreamMutex);
+
+    if (s_pOutputStream == nullptr || !s_bActive)
+      return EZ_FAILURE;
+
+    s_bActive = false;
+  }
+
+  ezStats::RemoveEventHandler(&StatsEventHandler);
+
+  // the streaming thread needs the stream mutex, so it must not be held while joining
+  s_pStreamingThread->m_bStop = true;
+  s_Signal.RaiseSignal();
+  s_pStreamingThread->Join();
+  EZ_DEFAULT_DELETE(s_pStreamingThread);
+
+  Flush();
+
+  EZ_LOCK(s_StreamMutex);
+
+  // release all memory, the name table starts from scratch with the next capture
+  {
+    EZ_LOCK(s_BufferMutex);
+
+    for (EventBuffer* pBuffer = s_pFirstBuffer; pBuffer != nullptr; pBuffer = pBuffer->m_pNext)
+    {
+      EZ_LOCK(pBuffer->m_Mutex);
+      pBuffer->m_Data.Clear();
+      pBuffer->m_Data.Compact();
+      pBuffer->m_KnownNames.Clear();
+      pBuffer->m_KnownNames.Compact();
+    }
+  }
+
+  {
+    EZ_LOCK(s_NameMutex);
+    s_NameIds.Clear();
+    s_NameIds.Compact();
+    s_PendingNames.Clear();
+    s_PendingNames.Compact();
+  }
+
+  s_FlushData.Clear();
+  s_FlushData.Compact();
+
+  s_pOutputStream = nullptr;
+  return s_bWriteFailed ? EZ_FAILURE : EZ_SUCCESS;
+}
+
+void ezProfilingStream::AddCPUScope(const char* szName, const char* szFunctionName, ezTime beginTime, ezTime endTime)
+{
+  EventBuffer* pBuffer = GetEventBuffer();
+  EZ_LOCK(pBuffer->m_Mutex);
+
+  // checked again while the buffer is locked, after Stop() has flushed the buffers, nothing may be added anymore
+  if (!s_bActive)
+    return;
+
+  const ezUInt32 uiNameId = GetNameId(pBuffer, szName);
+  const ezUInt32 uiFunctionId = GetNameId(pBuffer, szFunctionName);
+
+  pBuffer->m_Data.PushBack(static_cast<ezUInt8>(EventType::Scope));
+  WriteVarUInt(pBuffer->m_Data, uiNameId);
+  WriteVarUInt(pBuffer->m_Data, uiFunctionId);
+  pBuffer->WriteTime(beginTime);
+  WriteVarUInt(pBuffer->m_Data, static_cast<ezUInt64>(ezMath::Max<ezInt64>(ToNanoseconds(endTime) - ToNanoseconds(beginTime), 0)));
+}
+
+void ezProfilingStream::AddGPUScope(const char* szName, ezTime beginTime, ezTime endTime)
+{
+  EventBuffer* pBuffer = s_pGPUBuffer;
+  EZ_LOCK(pBuffer->m_Mutex);
+
+  if (!s_bActive)
+    return;
+
+  const ezUInt32 uiNameId = GetNameId(pBuffer, szName);
+
+  pBuffer->m_Data.PushBack(static_cast<ezUInt8>(EventType::Scope));
+  WriteVarUInt(pBuffer->m_Data, uiNameId);
+  WriteVarUInt(pBuffer->m_Data, 0);
+  pBuffer->WriteTime(beginTime);
+  WriteVarUInt(pBuffer->m_Data, static_cast<ezUInt64>(ezMath::Max<ezInt64>(ToNanoseconds(endTime) - ToNanoseconds(beginTime), 0)));
+}
+
+void ezProfilingStream::AddFrame(ezTime startTime)
+{
+  EventBuffer* pBuffer = GetEventBuffer();
+  EZ_LOCK(pBuffer->m_Mutex);
+
+  if (!s_bActive)
+    return;
+
+  pBuffer->m_Data.PushBack(static_cast<ezUInt8>(EventType::Frame));
+  pBuffer->WriteTime(startTime);
+}
+
+void ezProfilingStream::AddThreadName(ezUInt64 uiThreadId, const char* szName)
+{
+  EZ_LOCK(s_NameMutex);
+
+  if (!s_bActive)
+    return;
+
+  WriteNameBlock(s_PendingNames, BlockType::ThreadName, uiThreadId, szName, ezStringUtils::GetStringElementCount(szName));
+}
+
+void ezProfilingStream::AddFlowEvent(ezProfilingSystem::FlowEventType type, ezUInt64 uiFlowId)
+{
+  switch (type)
+  {
+    case ezProfilingSystem::FlowEventType::Start:
+      WriteFlowEvent(EventType::FlowStart, uiFlowId);
+      break;
+    case ezProfilingSystem::FlowEventType::Step:
+      WriteFlowEvent(EventType::FlowStep, uiFlowId);
+      break;
+    case ezProfilingSystem::FlowEventType::Finish:
+      WriteFlowEvent(EventType::FlowFinish, uiFlowId);
+      break;
+  }
+}
+
+void ezProfilingStream::AddFlowDependency(ezUInt64 uiFlowId, ezUInt64 uiDependsOnFlowId)
+{
+  EventBuffer* pBuffer = GetEventBuffer();
+  EZ_LOCK(pBuffer->m_Mutex);
+
+  if (!s_bActive)
+    return;
+
+  pBuffer->m_Data.PushBack(static_cast<ezUInt8>(EventType::FlowDependency));
+  WriteVarUInt(pBuffer->m_Data, uiFlowId);
+  WriteVarUInt(pBuffer->m_Data, uiDependsOnFlowId);
+}
+
+void ezProfilingStream::AddCounterValue(const char* szName, double fValue)
+{
+  EventBuffer* pBuffer = GetEventBuffer();
+  EZ_LOCK(pBuffer->m_Mutex);
+
+  if (!s_bActive)
+    return;
+
+  const ezUInt32 uiNameId = GetNameId(pBuffer, szName);
+
+  pBuffer->m_Data.PushBack(static_cast<ezUInt8>(EventType::Counter));
+  WriteVarUInt(pBuffer->m_Data, uiNameId);
+  pBuffer->WriteTime(ezTime::Now());
+  pBuffer->m_Data.PushBackRange(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(&fValue), sizeof(double)));
+}
+
+void ezProfilingStream::Flush()
+{
+  EZ_LOCK(s_StreamMutex);
+
+  if (s_pOutputStream == nullptr)
+    return;
+
+  // gather the events first and the names afterwards, names are always added before an event that uses them,
+  // so this way all names that are referenced by the written events are part of the same flush
+  s_FlushData.Clear();
+
+  {
+    EZ_LOCK(s_BufferMutex);
+
+    for (EventBuffer* pBuffer = s_pFirstBuffer; pBuffer != nullptr; pBuffer = pBuffer->m_pNext)
+    {
+      EZ_LOCK(pBuffer->m_Mutex);
+
+      if (pBuffer->m_Data.IsEmpty())
+        continue;
+
+      s_FlushData.PushBack(static_cast<ezUInt8>(BlockType::Events));
+      WriteVarUInt(s_FlushData, GetVarUIntSize(pBuffer->m_uiThreadId) + pBuffer->m_Data.GetCount());
+      WriteVarUInt(s_FlushData, pBuffer->m_uiThreadId);
+      s_FlushData.PushBackRange(pBuffer->m_Data);
+
+      pBuffer->m_Data.Clear();
+      pBuffer->m_iLastTimestamp = 0;
+    }
+  }
+
+  {
+    EZ_LOCK(s_NameMutex);
+
+    if (!s_bWriteFailed && !s_PendingNames.IsEmpty())
+    {
+      s_bWriteFailed = s_pOutputStream->WriteBytes(s_PendingNames.GetData(), s_PendingNames.GetCount()).Failed();
+    }
+
+    s_PendingNames.Clear();
+  }
+
+  if (!s_bWriteFailed && !s_FlushData.IsEmpty())
+  {
+    s_bWriteFailed = s_pOutputStream->WriteBytes(s_FlushData.GetData(), s_FlushData.GetCount()).Failed();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+  struct PayloadReader
+  {
+    bool IsAtEnd() const { return m_uiPos >= m_Data.GetCount(); }
+
+    ezResult ReadVarUInt(ezUInt64& out_uiValue)
+    {
+      out_uiValue = 0;
+
+      for (ezUInt32 uiShift = 0; uiShift < 64; uiShift += 7)
+      {
+        if (IsAtEnd())
+          return EZ_FAILURE;
+
+        const ezUInt8 uiByte = m_Data[m_uiPos++];
+        out_uiValue |= static_cast<ezUInt64>(uiByte & 0x7F) << uiShift;
+
+        if ((uiByte & 0x80) == 0)
+          return EZ_SUCCESS;
+      }
+
+      return EZ_FAILURE;
+    }
+
+    ezResult ReadTime(ezTime& out_time)
+    {
+      ezUInt64 uiValue = 0;
+      EZ_SUCCEED_OR_RETURN(ReadVarUInt(uiValue));
+
+      const ezInt64 iDelta = static_cast<ezInt64>(uiValue >> 1) ^ -static_cast<ezInt64>(uiValue & 1);
+      m_iLastTimestamp += iDelta;
+
+      out_time = ezTime::Nanoseconds(static_cast<double>(m_iLastTimestamp));
+      return EZ_SUCCESS;
+    }
+
+    ezResult ReadDouble(double& out_fValue)
+    {
+      if (m_uiPos + sizeof(double) > m_Data.GetCount())
+        return EZ_FAILURE;
+
+      ezMemoryUtils::Copy(reinterpret_cast<ezUInt8*>(&out_fValue), m_Data.GetPtr() + m_uiPos, sizeof(double));
+      m_uiPos += sizeof(double);
+      return EZ_SUCCESS;
+    }
+
+    ezArrayPtr<const ezUInt8> GetRemaining() const { return m_Data.GetSubArray(m_uiPos); }
+
+    ezArrayPtr<const ezUInt8> m_Data;
+    ezUInt32 m_uiPos = 0;
+    ezInt64 m_iLastTimestamp = 0;
+  };
+
+  ezResult ReadVarUInt(ezStreamReader& stream, ezUInt64& out_uiValue)
+  {
+    out_uiValue = 0;
+
+    for (ezUInt32 uiShift = 0; uiShift < 64; uiShift += 7)
+    {
+      ezUInt8 uiByte = 0;
+      if (stream.ReadBytes(&uiByte, 1) != 1)
+        return EZ_FAILURE;
+
+      out_uiValue |= static_cast<ezUInt64>(uiByte & 0x7F) << uiShift;
+
+      if ((uiByte & 0x80) == 0)
+        return EZ_SUCCESS;
+    }
+
+    return EZ_FAILURE;
+  }
+
+  struct RawScope
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiBufferIndex;
+    ezUInt32 m_uiNameId;
+    ezUInt32 m_uiFunctionId;
+    ezTime m_BeginTime;
+    ezTime m_EndTime;
+  };
+
+  struct RawCounter
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiNameId;
+    ezTime m_Time;
+    double m_fValue;
+  };
+
+  struct FlowInfo
+  {
+    ezUInt32 m_uiFirstStep = ezInvalidIndex;
+    ezUInt32 m_uiFinish = ezInvalidIndex;
+  };
+} // namespace
+
+ezResult ezProfilingStream::Read(ezStreamReader& inputStream, ezProfilingSystem::ProfilingData& out_Capture)
+{
+  using ProfilingData = ezProfilingSystem::ProfilingData;
+
+  out_Capture.Clear();
+
+  char szTag[4] = {};
+  if (inputStream.ReadBytes(szTag, 4) != 4 || szTag[0] != 'E' || szTag[1] != 'Z' || szTag[2] != 'P' || szTag[3] != 'S')
+  {
+    ezLog::Error("Not a streaming profiling capture.");
+    return EZ_FAILURE;
+  }
+
+  ezUInt8 uiVersion = 0;
+  inputStream >> uiVersion;
+
+  if (uiVersion != FORMAT_VERSION)
+  {
+    ezLog::Error("Unsupported version {} of streaming profiling capture.", uiVersion);
+    return EZ_FAILURE;
+  }
+
+  ezUInt32 uiProcessID = 0;
+  inputStream >> uiProcessID;
+
+  out_Capture.m_uiFramesThreadID = 1;
+  out_Capture.m_uiGPUThreadID = 0;
+  out_Capture.m_uiProcessID = uiProcessID;
+
+  ezDynamicArray<ezHashedString> names;
+  ezDynamicArray<RawScope> scopes;
+  ezDynamicArray<RawScope> gpuScopes;
+  ezDynamicArray<RawCounter> counters;
+  ezDynamicArray<ezUInt64> dependencies;
+  ezHashTable<ezUInt64, FlowInfo> flows;
+  ezHashTable<ezUInt64, ezUInt32> threadIdToBufferIndex;
+
+  ezDynamicArray<ezUInt8> payload;
+  ezStringBuilder sName;
+
+  while (true)
+  {
+    ezUInt8 uiBlockType = 0;
+    if (inputStream.ReadBytes(&uiBlockType, 1) != 1)
+      break;
+
+    ezUInt64 uiPayloadSize = 0;
+    if (ReadVarUInt(inputStream, uiPayloadSize).Failed() || uiPayloadSize > ezInvalidIndex)
+      return EZ_FAILURE;
+
+    payload.SetCountUninitialized(static_cast<ezUInt32>(uiPayloadSize));
+    if (inputStream.ReadBytes(payload.GetData(), uiPayloadSize) != uiPayloadSize)
+    {
+      ezLog::Error("Streaming profiling capture is truncated.");
+      return EZ_FAILURE;
+    }
+
+    PayloadReader reader;
+    reader.m_Data = payload;
+
+    ezUInt64 uiId = 0;
+    EZ_SUCCEED_OR_RETURN(reader.ReadVarUInt(uiId));
+
+    switch (static_cast<BlockType>(uiBlockType))
+    {
+      case BlockType::Name:
+      {
+        const ezArrayPtr<const ezUInt8> text = reader.GetRemaining();
+        sName.SetSubString_ElementCount(reinterpret_cast<const char*>(text.GetPtr()), text.GetCount());
+
+        if (uiId >= names.GetCount())
+        {
+          names.SetCount(static_cast<ezUInt32>(uiId) + 1);
+        }
+
+        names[static_cast<ezUInt32>(uiId)].Assign(sName.GetData());
+        break;
+      }
+
+      case BlockType::ThreadName:
+      {
+        const ezArrayPtr<const ezUInt8> text = reader.GetRemaining();
+        sName.SetSubString_ElementCount(reinterpret_cast<const char*>(text.GetPtr()), text.GetCount());
+
+        ezProfilingSystem::ThreadInfo& info = out_Capture.m_ThreadInfos.ExpandAndGetRef();
+        info.m_uiThreadId = uiId;
+        info.m_sName = sName;
+        break;
+      }
+
+      case BlockType::Events:
+      {
+        const ezUInt64 uiThreadId = uiId;
+
+        ezUInt32 uiBufferIndex = ezInvalidIndex;
+        if (uiThreadId != GPU_THREAD_ID && !threadIdToBufferIndex.TryGetValue(uiThreadId, uiBufferIndex))
+        {
+          uiBufferIndex = out_Capture.m_AllEventBuffers.GetCount();
+          out_Capture.m_AllEventBuffers.ExpandAndGetRef().m_uiThreadId = uiThreadId;
+          threadIdToBufferIndex.Insert(uiThreadId, uiBufferIndex);
+        }
+
+        while (!reader.IsAtEnd())
+        {
+          const EventType eventType = static_cast<EventType>(reader.m_Data[reader.m_uiPos++]);
+
+          switch (eventType)
+          {
+            case EventType::Scope:
+            {
+              ezUInt64 uiNameId = 0, uiFunctionId = 0, uiDuration = 0;
+              RawScope scope;
+              EZ_SUCCEED_OR_RETURN(reader.ReadVarUInt(uiNameId));
+              EZ_SUCCEED_OR_RETURN(reader.ReadVarUInt(uiFunctionId));
+              EZ_SUCCEED_OR_RETURN(reader.ReadTime(scope.m_BeginTime));
+              EZ_SUCCEED_OR_RETURN(reader.ReadVarUInt(uiDuration));
+
+              scope.m_uiBufferIndex = uiBufferIndex;
+              scope.m_uiNameId = static_cast<ezUInt32>(uiNameId);
+              scope.m_uiFunctionId = static_cast<ezUInt32>(uiFunctionId);
+              scope.m_EndTime = ezTime::Nanoseconds(static_cast<double>(ToNanoseconds(scope.m_BeginTime) + static_cast<ezInt64>(uiDuration)));
+
+              if (uiThreadId == GPU_THREAD_ID)
+                gpuScopes.PushBack(scope);
+              else
+                scopes.PushBack(scope);
+              break;
+            }
+
+            case EventType::Frame:
+            {
+              ezTime startTime;
+              EZ_SUCCEED_OR_RETURN(reader.ReadTime(startTime));
+              out_Capture.m_FrameStartTimes.PushBack(startTime);
+              break;
+            }
+
+            case EventType::FlowStart:
+            case EventType::FlowStep:
+            case EventType::FlowFinish:
+            {
+              ProfilingData::FlowEvent flowEvent;
+              EZ_SUCCEED_OR_RETURN(reader.ReadVarUInt(flowEvent.m_uiFlowId));
+              EZ_SUCCEED_OR_RETURN(reader.ReadTime(flowEvent.m_Time));
+              flowEvent.m_uiThreadId = uiThreadId;
+              flowEvent.m_szName = "Task Group";
+
+              FlowInfo& flow = flows[flowEvent.m_uiFlowId];
+
+              if (eventType == EventType::FlowStart)
+              {
+                flowEvent.m_Type = ezProfilingSystem::FlowEventType::Start;
+              }
+              else if (eventType == EventType::FlowStep)
+              {
+                flowEvent.m_Type = ezProfilingSystem::FlowEventType::Step;
+
+                if (flow.m_uiFirstStep == ezInvalidIndex)
+                  flow.m_uiFirstStep = out_Capture.m_FlowEvents.GetCount();
+              }
+              else
+              {
+                flowEvent.m_Type = ezProfilingSystem::FlowEventType::Finish;
+                flow.m_uiFinish = out_Capture.m_FlowEvents.GetCount();
+              }
+
+              out_Capture.m_FlowEvents.PushBack(flowEvent);
+              break;
+            }
+
+            case EventType::FlowDependency:
+            {
+              ezUInt64 uiFlowId = 0, uiDependsOnFlowId = 0;
+              EZ_SUCCEED_OR_RETURN(reader.ReadVarUInt(uiFlowId));
+              EZ_SUCCEED_OR_RETURN(reader.ReadVarUInt(uiDependsOnFlowId));
+              dependencies.PushBack(uiFlowId);
+              dependencies.PushBack(uiDependsOnFlowId);
+              break;
+            }
+
+            case EventType::Counter:
+            {
+              ezUInt64 uiNameId = 0;
+              RawCounter counter;
+              EZ_SUCCEED_OR_RETURN(reader.ReadVarUInt(uiNameId));
+              EZ_SUCCEED_OR_RETURN(reader.ReadTime(counter.m_Time));
+              EZ_SUCCEED_OR_RETURN(reader.ReadDouble(counter.m_fValue));
+              counter.m_uiNameId = static_cast<ezUInt32>(uiNameId);
+              counters.PushBack(counter);
+              break;
+            }
+
+            default:
+              ezLog::Error("Invalid event type {} in streaming profiling capture.", static_cast<ezUInt32>(eventType));
+              return EZ_FAILURE;
+          }
+        }
+        break;
+      }
+
+      default:
+        // unknown blocks are skipped, to allow adding new block types without breaking older readers
+        break;
+    }
+  }
+
+  // names may be defined after the events that use them, so they are only resolved once everything is read
+  auto getName = [&](ezUInt32 uiNameId) -> const char* {
+    if (uiNameId == 0 || uiNameId >= names.GetCount())
+      return nullptr;
+
+    return names[uiNameId].GetData();
+  };
+
+  for (const RawScope& raw : scopes)
+  {
+    const char* szName = getName(raw.m_uiNameId);
+
+    ezProfilingSystem::CPUScope& scope = out_Capture.m_AllEventBuffers[raw.m_uiBufferIndex].m_Data.ExpandAndGetRef();
+    scope.m_szFunctionName = getName(raw.m_uiFunctionId);
+    scope.m_BeginTime = raw.m_BeginTime;
+    scope.m_EndTime = raw.m_EndTime;
+    ezStringUtils::Copy(scope.m_szName, ezProfilingSystem::CPUScope::NAME_SIZE, szName != nullptr ? szName : "");
+  }
+
+  for (const RawScope& raw : gpuScopes)
+  {
+    const char* szName = getName(raw.m_uiNameId);
+
+    ezProfilingSystem::GPUScope& scope = out_Capture.m_GPUScopes.ExpandAndGetRef();
+    scope.m_BeginTime = raw.m_BeginTime;
+    scope.m_EndTime = raw.m_EndTime;
+    ezStringUtils::Copy(scope.m_szName, ezProfilingSystem::GPUScope::NAME_SIZE, szName != nullptr ? szName : "");
+  }
+
+  for (const RawCounter& raw : counters)
+  {
+    const char* szName = getName(raw.m_uiNameId);
+
+    ProfilingData::CounterValue& value = out_Capture.m_CounterValues.ExpandAndGetRef();
+    value.m_szName = szName != nullptr ? szName : "";
+    value.m_Time = raw.m_Time;
+    value.m_fValue = raw.m_fValue;
+  }
+
+  // a dependency becomes a separate flow from the end of the group it depends on to the first task of the dependent group
+  // task group flow IDs never have the highest bit set (see ezTaskGroupID::GetProfilingFlowId), so dependency flows can't collide with them
+  constexpr ezUInt64 uiDependencyFlowIdBit = 1ull << 63;
+  ezUInt64 uiNextDependencyFlowId = uiDependencyFlowIdBit | 1;
+  for (ezUInt32 i = 0; i < dependencies.GetCount(); i += 2)
+  {
+    const FlowInfo* pFlow = flows.GetValue(dependencies[i]);
+    const FlowInfo* pDependsOnFlow = flows.GetValue(dependencies[i + 1]);
+
+    if (pFlow == nullptr || pDependsOnFlow == nullptr || pFlow->m_uiFirstStep == ezInvalidIndex || pDependsOnFlow->m_uiFinish == ezInvalidIndex)
+      continue;
+
+    ProfilingData::FlowEvent start = out_Capture.m_FlowEvents[pDependsOnFlow->m_uiFinish];
+    start.m_uiFlowId = uiNextDependencyFlowId;
+    start.m_Type = ezProfilingSystem::FlowEventType::Start;
+    start.m_szName = "Task Group Dependency";
+
+    ProfilingData::FlowEvent finish = out_Capture.m_FlowEvents[pFlow->m_uiFirstStep];
+    finish.m_uiFlowId = uiNextDependencyFlowId;
+    finish.m_Type = ezProfilingSystem::FlowEventType::Finish;
+    finish.m_szName = "Task Group Dependency";
+
+    out_Capture.m_FlowEvents.PushBack(start);
+    out_Capture.m_FlowEvents.PushBack(finish);
+
+    ++uiNextDependencyFlowId;
+  }
+
+  out_Capture.m_uiFrameCount = out_Capture.m_FrameStartTimes.GetCount();
+
+  // keep the strings alive that the function names and counters point to
+  out_Capture.m_Strings = std::move(names);
+
+  return EZ_SUCCESS;
+}
+
+#endif
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Profiling_Implementation_ProfilingStream);
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <Foundation/Profiling/Profiling.h>
+
+class ezStreamReader;
+
+/// \brief Internal implementation of the streaming capture of ezProfilingSystem.
+///
+/// Every thread appends its events to its own buffer, in a compact binary format. A background thread regularly moves the content of
+/// all buffers to the output stream, so a streaming capture can run for any length of time without losing events.
+///
+/// The stream starts with a header (ezUInt32 'EZPS', ezUInt8 version, ezUInt32 process ID), followed by blocks. Every block starts with an
+/// ezUInt8 block type and the varint encoded size of its payload. Names are interned, events only store the ID of a name and all timestamps
+/// are stored as zigzag varint encoded differences in nanoseconds to the previous timestamp of the same block.
+class ezProfilingStream
+{
+public:
+  static ezResult Start(ezStreamWriter& outputStream, ezArrayPtr<const ezProfilingSystem::ThreadInfo> threadInfos, ezUInt32 uiProcessID);
+  static ezResult Stop();
+
+  static bool IsActive() { return s_bActive; }
+
+  static void AddCPUScope(const char* szName, const char* szFunctionName, ezTime beginTime, ezTime endTime);
+  static void AddGPUScope(const char* szName, ezTime beginTime, ezTime endTime);
+  static void AddFrame(ezTime startTime);
+  static void AddThreadName(ezUInt64 uiThreadId, const char* szName);
+  static void AddFlowEvent(ezProfilingSystem::FlowEventType type, ezUInt64 uiFlowId);
+  static void AddFlowDependency(ezUInt64 uiFlowId, ezUInt64 uiDependsOnFlowId);
+  static void AddCounterValue(const char* szName, double fValue);
+
+  /// \brief Moves all buffered events to the output stream.
+  static void Flush();
+
+  static ezResult Read(ezStreamReader& inputStream, ezProfilingSystem::ProfilingData& out_Capture);
+
+private:
+  static ezAtomicBool s_bActive;
+};
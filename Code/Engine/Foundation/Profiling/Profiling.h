@@ -3,9 +3,11 @@
 #include <Foundation/Basics.h>
 #include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Containers/StaticRingBuffer.h>
+#include <Foundation/Strings/HashedString.h>
 #include <Foundation/System/Process.h>
 #include <Foundation/Time/Time.h>
 
+class ezStreamReader;
 class ezStreamWriter;
 class ezThread;
 
@@ -57,6 +59,14 @@ protected:
 class EZ_FOUNDATION_DLL ezProfilingSystem
 {
 public:
+  /// \brief The type of an event of a flow, see AddFlowEvent().
+  enum class FlowEventType : ezUInt8
+  {
+    Start,
+    Step,
+    Finish
+  };
+
   struct ThreadInfo
   {
     ezUInt64 m_uiThreadId;
@@ -108,6 +118,34 @@ public:
 
     ezDynamicArray<GPUScope> m_GPUScopes;
 
+    /// \brief An event of a flow, which connects scopes across threads, e.g. the tasks of a task group.
+    struct FlowEvent
+    {
+      EZ_DECLARE_POD_TYPE();
+
+      ezUInt64 m_uiFlowId;
+      ezUInt64 m_uiThreadId;
+      ezTime m_Time;
+      const char* m_szName;
+      FlowEventType m_Type;
+    };
+
+    struct CounterValue
+    {
+      EZ_DECLARE_POD_TYPE();
+
+      const char* m_szName;
+      ezTime m_Time;
+      double m_fValue;
+    };
+
+    /// \brief Flow events and counter values are only recorded by streaming captures, see ezProfilingSystem::StartStreamingCapture().
+    ezDynamicArray<FlowEvent> m_FlowEvents;
+    ezDynamicArray<CounterValue> m_CounterValues;
+
+    /// \brief Keeps the names alive that function names and counters point to, when the data was read from a streaming capture.
+    ezDynamicArray<ezHashedString> m_Strings;
+
     /// \brief Writes profiling data as JSON to the output stream.
     ezResult Write(ezStreamWriter& outputStream) const;
 
@@ -131,6 +169,37 @@ public:
   /// \brief Adds a new scoped event for the calling thread in the profiling system
   static void AddCPUScope(const char* szName, const char* szFunctionName, ezTime beginTime, ezTime endTime);
 
+  /// \brief Starts writing all profiling events continuously to the given stream, until StopStreamingCapture() is called.
+  ///
+  /// In contrast to Capture(), which only returns the events that still fit into the ring buffers, a streaming capture records everything
+  /// for as long as it runs, plus flow events of task groups and counter values of ezStats and the allocators. The data is written in a
+  /// compact binary format by a background thread, so the stream must stay valid until StopStreamingCapture() returns.
+  /// Use ReadStreamingCapture() to convert it back to ProfilingData, e.g. to write it as JSON.
+  static ezResult StartStreamingCapture(ezStreamWriter& outputStream);
+
+  /// \brief Writes all remaining events to the stream and stops the streaming capture.
+  ///
+  /// Returns EZ_FAILURE if no streaming capture was running or if writing to the stream failed at any point.
+  static ezResult StopStreamingCapture();
+
+  /// \brief Returns whether a streaming capture is currently running.
+  static bool IsStreamingCapture();
+
+  /// \brief Reads the data that was written by a streaming capture.
+  static ezResult ReadStreamingCapture(ezStreamReader& inputStream, ProfilingData& out_Capture);
+
+  /// \brief Adds an event to the flow with the given ID for the calling thread. Only recorded by streaming captures.
+  ///
+  /// Flows connect events across threads, e.g. a task group is started on one thread and its tasks are executed on others.
+  /// Step events should be added inside of a profiling scope, so that viewers can connect them to the scope.
+  static void AddFlowEvent(FlowEventType type, ezUInt64 uiFlowId);
+
+  /// \brief Records that the flow uiFlowId can only continue after the flow uiDependsOnFlowId has finished. Only recorded by streaming captures.
+  static void AddFlowDependency(ezUInt64 uiFlowId, ezUInt64 uiDependsOnFlowId);
+
+  /// \brief Records the current value of a counter. Only recorded by streaming captures.
+  static void AddCounterValue(const char* szName, double fValue);
+
 private:
   EZ_MAKE_SUBSYSTEM_STARTUP_FRIEND(Foundation, ProfilingSystem);
   friend ezUInt32 RunThread(ezThread* pThread);
@@ -3,8 +3,10 @@
 /// \file
 
 #include <Foundation/Basics.h>
+#include <Foundation/Containers/HashTable.h>
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/Containers/Set.h>
+#include <Foundation/Memory/StackAllocator.h>
 #include <Foundation/Reflection/Reflection.h>
 #include <Foundation/Strings/HashedString.h>
 #include <Foundation/Types/Enum.h>
@@ -30,6 +32,15 @@ public:
   {
   }
 
+  explicit ezAbstractObjectNode(ezAllocatorBase* pAllocator)
+      : m_pOwner(nullptr)
+      , m_uiTypeVersion(0)
+      , m_szType(nullptr)
+      , m_szNodeName(nullptr)
+      , m_Properties(pAllocator)
+  {
+  }
+
   const ezHybridArray<Property, 16>& GetProperties() const { return m_Properties; }
 
   void AddProperty(const char* szName, const ezVariant& value);
@@ -110,10 +121,15 @@ struct EZ_FOUNDATION_DLL ezDiffOperation
 EZ_DECLARE_REFLECTABLE_TYPE(EZ_FOUNDATION_DLL, ezDiffOperation);
 
 
+/// \brief Generic graph of nodes and properties that all serializers read from and write to.
+///
+/// All nodes, their property arrays and all registered strings are allocated from a bump allocator owned by the graph,
+/// so building a graph costs very few heap allocations and Clear() releases everything at once. Memory of removed nodes is only
+/// reclaimed by Clear(). Nodes are indexed by hash tables, so GetAllNodes() does not iterate in any particular order.
 class EZ_FOUNDATION_DLL ezAbstractObjectGraph
 {
 public:
-  ezAbstractObjectGraph() {}
+  ezAbstractObjectGraph();
   ~ezAbstractObjectGraph();
 
   void Clear();
@@ -130,8 +146,13 @@ public:
   ezAbstractObjectNode* AddNode(const ezUuid& guid, const char* szType, ezUInt32 uiTypeVersion, const char* szNodeName = nullptr);
   void RemoveNode(const ezUuid& guid);
 
-  const ezMap<ezUuid, ezAbstractObjectNode*>& GetAllNodes() const { return m_Nodes; }
-  ezMap<ezUuid, ezAbstractObjectNode*>& GetAllNodes() { return m_Nodes; }
+  const ezHashTable<ezUuid, ezAbstractObjectNode*>& GetAllNodes() const { return m_Nodes; }
+  ezHashTable<ezUuid, ezAbstractObjectNode*>& GetAllNodes() { return m_Nodes; }
+
+  /// \brief Returns all nodes sorted by guid. Use this instead of GetAllNodes() where the order of the nodes is observable,
+  ///   or to iterate over the nodes while nodes are added to the graph.
+  void GetAllNodesSortedByGuid(ezDynamicArray<const ezAbstractObjectNode*>& out_Nodes) const;
+  void GetAllNodesSortedByGuid(ezDynamicArray<ezAbstractObjectNode*>& out_Nodes);
 
   /// \brief Remaps all node guids by adding the given seed, or if bRemapInverse is true, by subtracting it/
   ///   This is mostly used to remap prefab instance graphs to their prefab template graph.
@@ -152,6 +173,9 @@ public:
   /// \brief Allows to copy a node from another graph into this graph.
   ezAbstractObjectNode* CopyNodeIntoGraph(const ezAbstractObjectNode* pNode);
 
+  /// \brief Computes the operations that turn \a base into this graph.
+  ///
+  /// Nodes are matched by guid, properties by name. Property values are compared in place without copying them.
   void CreateDiffWithBaseGraph(const ezAbstractObjectGraph& base, ezDeque<ezAbstractGraphDiffOperation>& out_DiffResult) const;
 
   void ApplyDiff(ezDeque<ezAbstractGraphDiffOperation>& Diff);
@@ -168,8 +192,9 @@ private:
   void ReMapNodeGuidsToMatchGraphRecursive(ezHashTable<ezUuid, ezUuid>& guidMap, ezAbstractObjectNode* lhs, const ezAbstractObjectGraph& rhsGraph,
                                            const ezAbstractObjectNode* rhs);
 
-  ezSet<ezString> m_Strings;
-  ezMap<ezUuid, ezAbstractObjectNode*> m_Nodes;
-  ezMap<const char*, ezAbstractObjectNode*, CompareConstChar> m_NodesByName;
+  ezStackAllocator<ezMemoryTrackingFlags::None> m_Allocator;
+  ezHashTable<const char*, const char*> m_Strings; ///< Maps any string to its registered copy inside m_Allocator.
+  ezHashTable<ezUuid, ezAbstractObjectNode*> m_Nodes;
+  ezHashTable<const char*, ezAbstractObjectNode*> m_NodesByName;
 };
 
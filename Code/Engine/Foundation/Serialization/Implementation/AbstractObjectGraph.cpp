@@ -1,5 +1,6 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/Containers/HashSet.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Serialization/AbstractObjectGraph.h>
 
@@ -27,6 +28,11 @@ EZ_BEGIN_STATIC_REFLECTED_TYPE(ezDiffOperation, ezNoBase, 1, ezRTTIDefaultAlloca
 EZ_END_STATIC_REFLECTED_TYPE;
 // clang-format on
 
+ezAbstractObjectGraph::ezAbstractObjectGraph()
+  : m_Allocator("ezAbstractObjectGraph", ezFoundation::GetAlignedAllocator())
+{
+}
+
 ezAbstractObjectGraph::~ezAbstractObjectGraph()
 {
   Clear();
@@ -34,19 +40,19 @@ ezAbstractObjectGraph::~ezAbstractObjectGraph()
 
 void ezAbstractObjectGraph::Clear()
 {
-  for (auto it = m_Nodes.GetIterator(); it.IsValid(); ++it)
-  {
-    EZ_DEFAULT_DELETE(it.Value());
-  }
   m_Nodes.Clear();
   m_NodesByName.Clear();
   m_Strings.Clear();
+
+  // runs the destructors of all remaining nodes and releases the strings and property arrays with them
+  m_Allocator.Reset();
 }
 
 
 void ezAbstractObjectGraph::Clone(ezAbstractObjectGraph& cloneTarget) const
 {
   cloneTarget.Clear();
+  cloneTarget.m_Nodes.Reserve(m_Nodes.GetCount());
 
   for (auto it = m_Nodes.GetIterator(); it.IsValid(); ++it)
   {
@@ -56,14 +62,26 @@ void ezAbstractObjectGraph::Clone(ezAbstractObjectGraph& cloneTarget) const
 
 const char* ezAbstractObjectGraph::RegisterString(const char* szString)
 {
-  auto it = m_Strings.Insert(szString);
-  EZ_ASSERT_DEV(it.IsValid(), "");
-  return it.Key().GetData();
+  if (szString == nullptr)
+    szString = "";
+
+  const char* szRegistered = nullptr;
+  if (m_Strings.TryGetValue(szString, szRegistered))
+    return szRegistered;
+
+  const size_t uiSize = ezStringUtils::GetStringElementCount(szString) + 1;
+  char* szCopy = static_cast<char*>(m_Allocator.Allocate(uiSize, 1, nullptr));
+  ezMemoryUtils::Copy(szCopy, szString, uiSize);
+
+  m_Strings.Insert(szCopy, szCopy);
+  return szCopy;
 }
 
 ezAbstractObjectNode* ezAbstractObjectGraph::GetNode(const ezUuid& guid)
 {
-  return m_Nodes.GetValueOrDefault(guid, nullptr);
+  ezAbstractObjectNode* pNode = nullptr;
+  m_Nodes.TryGetValue(guid, pNode);
+  return pNode;
 }
 
 const ezAbstractObjectNode* ezAbstractObjectGraph::GetNode(const ezUuid& guid) const
@@ -78,7 +96,9 @@ const ezAbstractObjectNode* ezAbstractObjectGraph::GetNodeByName(const char* szN
 
 ezAbstractObjectNode* ezAbstractObjectGraph::GetNodeByName(const char* szName)
 {
-  return m_NodesByName.GetValueOrDefault(szName, nullptr);
+  ezAbstractObjectNode* pNode = nullptr;
+  m_NodesByName.TryGetValue(szName, pNode);
+  return pNode;
 }
 
 ezAbstractObjectNode* ezAbstractObjectGraph::AddNode(const ezUuid& guid, const char* szType, ezUInt32 uiTypeVersion, const char* szNodeName)
@@ -93,14 +113,14 @@ ezAbstractObjectNode* ezAbstractObjectGraph::AddNode(const ezUuid& guid, const c
     szNodeName = nullptr;
   }
 
-  ezAbstractObjectNode* pNode = EZ_DEFAULT_NEW(ezAbstractObjectNode);
+  ezAbstractObjectNode* pNode = EZ_NEW(&m_Allocator, ezAbstractObjectNode, &m_Allocator);
   pNode->m_Guid = guid;
   pNode->m_pOwner = this;
   pNode->m_szType = RegisterString(szType);
   pNode->m_uiTypeVersion = uiTypeVersion;
   pNode->m_szNodeName = szNodeName;
 
-  m_Nodes[guid] = pNode;
+  m_Nodes.Insert(guid, pNode);
 
   if (!ezStringUtils::IsNullOrEmpty(szNodeName))
   {
@@ -112,16 +132,13 @@ ezAbstractObjectNode* ezAbstractObjectGraph::AddNode(const ezUuid& guid, const c
 
 void ezAbstractObjectGraph::RemoveNode(const ezUuid& guid)
 {
-  auto it = m_Nodes.Find(guid);
-
-  if (it.IsValid())
+  ezAbstractObjectNode* pNode = nullptr;
+  if (m_Nodes.Remove(guid, &pNode))
   {
-    ezAbstractObjectNode* pNode = it.Value();
     if (pNode->m_szNodeName != nullptr)
       m_NodesByName.Remove(pNode->m_szNodeName);
 
-    m_Nodes.Remove(guid);
-    EZ_DEFAULT_DELETE(pNode);
+    EZ_DELETE(&m_Allocator, pNode);
   }
 }
 
@@ -201,6 +218,33 @@ ezAbstractObjectNode::Property* ezAbstractObjectNode::FindProperty(const char* s
   return nullptr;
 }
 
+namespace
+{
+  template <typename NODE>
+  void GetNodesSortedByGuid(const ezHashTable<ezUuid, ezAbstractObjectNode*>& nodes, ezDynamicArray<NODE*>& out_Nodes)
+  {
+    out_Nodes.Clear();
+    out_Nodes.Reserve(nodes.GetCount());
+
+    for (auto it = nodes.GetIterator(); it.IsValid(); ++it)
+    {
+      out_Nodes.PushBack(it.Value());
+    }
+
+    out_Nodes.Sort([](const NODE* lhs, const NODE* rhs) -> bool { return lhs->GetGuid() < rhs->GetGuid(); });
+  }
+} // namespace
+
+void ezAbstractObjectGraph::GetAllNodesSortedByGuid(ezDynamicArray<const ezAbstractObjectNode*>& out_Nodes) const
+{
+  GetNodesSortedByGuid(m_Nodes, out_Nodes);
+}
+
+void ezAbstractObjectGraph::GetAllNodesSortedByGuid(ezDynamicArray<ezAbstractObjectNode*>& out_Nodes)
+{
+  GetNodesSortedByGuid(m_Nodes, out_Nodes);
+}
+
 void ezAbstractObjectGraph::ReMapNodeGuids(const ezUuid& seedGuid, bool bRemapInverse /*= false*/)
 {
   ezHybridArray<ezAbstractObjectNode*, 16> nodes;
@@ -223,6 +267,7 @@ void ezAbstractObjectGraph::ReMapNodeGuids(const ezUuid& seedGuid, bool bRemapIn
   }
 
   m_Nodes.Clear();
+  m_Nodes.Reserve(nodes.GetCount());
 
   // go through all nodes to remap guids
   for (auto* pNode : nodes)
@@ -234,7 +279,7 @@ void ezAbstractObjectGraph::ReMapNodeGuids(const ezUuid& seedGuid, bool bRemapIn
     {
       RemapVariant(prop.m_Value, guidMap);
     }
-    m_Nodes[pNode->m_Guid] = pNode;
+    m_Nodes.Insert(pNode->m_Guid, pNode);
   }
 }
 
@@ -255,7 +300,6 @@ void ezAbstractObjectGraph::ReMapNodeGuidsToMatchGraph(ezAbstractObjectNode* roo
     {
       RemapVariant(prop.m_Value, guidMap);
     }
-    m_Nodes[it.Value()->m_Guid] = it.Value();
   }
 }
 
@@ -372,60 +416,63 @@ void ezAbstractObjectGraph::ReMapNodeGuidsToMatchGraphRecursive(ezHashTable<ezUu
 
 void ezAbstractObjectGraph::PruneGraph(const ezUuid& rootGuid)
 {
-  ezSet<ezUuid> reachableNodes;
-  ezSet<ezUuid> inProgress;
-  inProgress.Insert(rootGuid);
+  ezHashSet<ezUuid> reachableNodes;
+  reachableNodes.Reserve(m_Nodes.GetCount());
+  ezDynamicArray<ezUuid> inProgress;
+
+  // Even if a guid is not in the graph add it anyway to early out if it is found again.
+  reachableNodes.Insert(rootGuid);
+  inProgress.PushBack(rootGuid);
 
   while (!inProgress.IsEmpty())
   {
-    ezUuid current = *inProgress.GetIterator();
-    auto it = m_Nodes.Find(current);
-    if (it.IsValid())
+    const ezAbstractObjectNode* pNode = GetNode(inProgress.PeekBack());
+    inProgress.PopBack();
+
+    if (pNode == nullptr)
+      continue;
+
+    for (auto& prop : pNode->m_Properties)
     {
-      ezAbstractObjectNode* pNode = it.Value();
-      for (auto& prop : pNode->m_Properties)
+      if (prop.m_Value.IsA<ezUuid>())
       {
-        if (prop.m_Value.IsA<ezUuid>())
+        const ezUuid& guid = prop.m_Value.Get<ezUuid>();
+        if (!reachableNodes.Insert(guid))
         {
-          const ezUuid& guid = prop.m_Value.Get<ezUuid>();
-          if (!reachableNodes.Contains(guid))
-          {
-            inProgress.Insert(guid);
-          }
+          inProgress.PushBack(guid);
         }
-        // Arrays may be of uuids
-        else if (prop.m_Value.IsA<ezVariantArray>())
+      }
+      // Arrays may be of uuids
+      else if (prop.m_Value.IsA<ezVariantArray>())
+      {
+        const ezVariantArray& values = prop.m_Value.Get<ezVariantArray>();
+        for (auto& subValue : values)
         {
-          const ezVariantArray& values = prop.m_Value.Get<ezVariantArray>();
-          for (auto& subValue : values)
+          if (subValue.IsA<ezUuid>())
           {
-            if (subValue.IsA<ezUuid>())
+            const ezUuid& guid = subValue.Get<ezUuid>();
+            if (!reachableNodes.Insert(guid))
             {
-              const ezUuid& guid = subValue.Get<ezUuid>();
-              if (!reachableNodes.Contains(guid))
-              {
-                inProgress.Insert(guid);
-              }
+              inProgress.PushBack(guid);
             }
           }
         }
       }
     }
-    // Even if 'current' is not in the graph add it anyway to early out if it is found again.
-    reachableNodes.Insert(current);
-    inProgress.Remove(current);
   }
 
   // Determine nodes to be removed by subtracting valid ones from all nodes.
-  ezSet<ezUuid> removeSet;
-  for (auto it = GetAllNodes().GetIterator(); it.IsValid(); ++it)
+  ezDynamicArray<ezUuid> removeList;
+  for (auto it = m_Nodes.GetIterator(); it.IsValid(); ++it)
   {
-    removeSet.Insert(it.Key());
+    if (!reachableNodes.Contains(it.Key()))
+    {
+      removeList.PushBack(it.Key());
+    }
   }
-  removeSet.Difference(reachableNodes);
 
   // Remove nodes.
-  for (const ezUuid& guid : removeSet)
+  for (const ezUuid& guid : removeList)
   {
     RemoveNode(guid);
   }
@@ -434,6 +481,7 @@ void ezAbstractObjectGraph::PruneGraph(const ezUuid& rootGuid)
 ezAbstractObjectNode* ezAbstractObjectGraph::CopyNodeIntoGraph(const ezAbstractObjectNode* pNode)
 {
   auto pNewNode = AddNode(pNode->GetGuid(), pNode->GetType(), pNode->GetTypeVersion(), pNode->GetNodeName());
+  pNewNode->m_Properties.Reserve(pNode->m_Properties.GetCount());
 
   for (const auto& props : pNode->GetProperties())
     pNewNode->AddProperty(props.m_szPropertyName, props.m_Value);
@@ -446,47 +494,52 @@ void ezAbstractObjectGraph::CreateDiffWithBaseGraph(const ezAbstractObjectGraph&
 {
   out_DiffResult.Clear();
 
+  // the hash tables have no stable order, the diff lists the nodes sorted by guid to be reproducible
+  ezDynamicArray<const ezAbstractObjectNode*> baseNodes;
+  base.GetAllNodesSortedByGuid(baseNodes);
+
+  ezDynamicArray<const ezAbstractObjectNode*> nodes;
+  GetAllNodesSortedByGuid(nodes);
+
   // check whether any nodes have been deleted
   {
-    for (auto itNodeBase = base.GetAllNodes().GetIterator(); itNodeBase.IsValid(); ++itNodeBase)
+    for (const ezAbstractObjectNode* pBaseNode : baseNodes)
     {
-      if (GetNode(itNodeBase.Key()) == nullptr)
+      if (!m_Nodes.Contains(pBaseNode->m_Guid))
       {
         // does not exist in this graph -> has been deleted from base
-        ezAbstractGraphDiffOperation op;
-        op.m_Node = itNodeBase.Key();
+        ezAbstractGraphDiffOperation& op = out_DiffResult.ExpandAndGetRef();
+        op.m_Node = pBaseNode->m_Guid;
         op.m_Operation = ezAbstractGraphDiffOperation::Op::NodeRemoved;
-        op.m_sProperty = itNodeBase.Value()->m_szType;
-        op.m_Value = itNodeBase.Value()->m_szNodeName;
-
-        out_DiffResult.PushBack(op);
+        op.m_sProperty = pBaseNode->m_szType;
+        op.m_Value = pBaseNode->m_szNodeName;
       }
     }
   }
 
   // check whether any nodes have been added
   {
-    for (auto itNodeThis = GetAllNodes().GetIterator(); itNodeThis.IsValid(); ++itNodeThis)
+    for (const ezAbstractObjectNode* pNode : nodes)
     {
-      if (base.GetNode(itNodeThis.Key()) == nullptr)
+      if (!base.m_Nodes.Contains(pNode->m_Guid))
       {
         // does not exist in base graph -> has been added
-        ezAbstractGraphDiffOperation op;
-        op.m_Node = itNodeThis.Key();
-        op.m_Operation = ezAbstractGraphDiffOperation::Op::NodeAdded;
-        op.m_sProperty = itNodeThis.Value()->m_szType;
-        op.m_Value = itNodeThis.Value()->m_szNodeName;
-
-        out_DiffResult.PushBack(op);
+        {
+          ezAbstractGraphDiffOperation& op = out_DiffResult.ExpandAndGetRef();
+          op.m_Node = pNode->m_Guid;
+          op.m_Operation = ezAbstractGraphDiffOperation::Op::NodeAdded;
+          op.m_sProperty = pNode->m_szType;
+          op.m_Value = pNode->m_szNodeName;
+        }
 
         // set all properties
-        for (const auto& prop : itNodeThis.Value()->GetProperties())
+        for (const auto& prop : pNode->m_Properties)
         {
+          ezAbstractGraphDiffOperation& op = out_DiffResult.ExpandAndGetRef();
+          op.m_Node = pNode->m_Guid;
           op.m_Operation = ezAbstractGraphDiffOperation::Op::PropertyChanged;
           op.m_sProperty = prop.m_szPropertyName;
           op.m_Value = prop.m_Value;
-
-          out_DiffResult.PushBack(op);
         }
       }
     }
@@ -494,41 +547,33 @@ void ezAbstractObjectGraph::CreateDiffWithBaseGraph(const ezAbstractObjectGraph&
 
   // check whether any properties have been modified
   {
-    for (auto itNodeThis = GetAllNodes().GetIterator(); itNodeThis.IsValid(); ++itNodeThis)
+    for (const ezAbstractObjectNode* pNode : nodes)
     {
-      const auto pBaseNode = base.GetNode(itNodeThis.Key());
-
+      const ezAbstractObjectNode* pBaseNode = base.GetNode(pNode->m_Guid);
       if (pBaseNode == nullptr)
         continue;
 
-      for (const ezAbstractObjectNode::Property& prop : itNodeThis.Value()->GetProperties())
-      {
-        bool bDifferent = true;
+      const ezUInt32 uiNumProperties = pNode->m_Properties.GetCount();
+      const ezUInt32 uiNumBaseProperties = pBaseNode->m_Properties.GetCount();
 
-        for (const ezAbstractObjectNode::Property& baseProp : pBaseNode->GetProperties())
-        {
-          if (ezStringUtils::IsEqual(baseProp.m_szPropertyName, prop.m_szPropertyName))
-          {
-            if (baseProp.m_Value == prop.m_Value)
-            {
-              bDifferent = false;
-              break;
-            }
+      for (ezUInt32 i = 0; i < uiNumProperties; ++i)
+      {
+        const ezAbstractObjectNode::Property& prop = pNode->m_Properties[i];
 
-            bDifferent = true;
-            break;
-          }
-        }
+        // Both graphs are usually written by the same code, so the properties are almost always in the same order.
+        const ezAbstractObjectNode::Property* pBaseProp = nullptr;
+        if (i < uiNumBaseProperties && ezStringUtils::IsEqual(pBaseNode->m_Properties[i].m_szPropertyName, prop.m_szPropertyName))
+          pBaseProp = &pBaseNode->m_Properties[i];
+        else
+          pBaseProp = pBaseNode->FindProperty(prop.m_szPropertyName);
 
-        if (bDifferent)
+        if (pBaseProp == nullptr || pBaseProp->m_Value != prop.m_Value)
         {
-          ezAbstractGraphDiffOperation op;
-          op.m_Node = itNodeThis.Key();
+          ezAbstractGraphDiffOperation& op = out_DiffResult.ExpandAndGetRef();
+          op.m_Node = pNode->m_Guid;
           op.m_Operation = ezAbstractGraphDiffOperation::Op::PropertyChanged;
           op.m_sProperty = prop.m_szPropertyName;
           op.m_Value = prop.m_Value;
-
-          out_DiffResult.PushBack(op);
         }
       }
     }
@@ -578,29 +623,47 @@ void ezAbstractObjectGraph::MergeDiffs(const ezDeque<ezAbstractGraphDiffOperatio
 {
   struct Prop
   {
-    Prop() {}
-    Prop(ezUuid node, ezStringView sProperty)
-    {
-      m_Node = node;
-      m_sProperty = sProperty;
-    }
     ezUuid m_Node;
     ezStringView m_sProperty;
+  };
 
-    bool operator<(const Prop& rhs) const
+  struct PropHash
+  {
+    EZ_ALWAYS_INLINE static ezUInt32 Hash(const Prop& key)
     {
-      if (m_Node == rhs.m_Node)
-        return m_sProperty < rhs.m_sProperty;
-
-      return m_Node < rhs.m_Node;
+      return ezHashingUtils::xxHash32(key.m_sProperty.GetStartPointer(), key.m_sProperty.GetElementCount(), ezHashHelper<ezUuid>::Hash(key.m_Node));
     }
 
-    bool operator==(const Prop& rhs) const { return m_Node == rhs.m_Node && m_sProperty == rhs.m_sProperty; }
+    EZ_ALWAYS_INLINE static bool Equal(const Prop& a, const Prop& b) { return a.m_Node == b.m_Node && a.m_sProperty == b.m_sProperty; }
+  };
+
+  struct PropChange
+  {
+    Prop m_Key;
+    ezHybridArray<const ezAbstractGraphDiffOperation*, 2> m_Operations;
+  };
+
+  // property changes are merged in the order in which they are first encountered, the hash table only finds them
+  ezDynamicArray<PropChange> propChanges;
+  ezHashTable<Prop, ezUInt32, PropHash> propChangeIndices;
+  propChangeIndices.Reserve(lhs.GetCount() + rhs.GetCount());
+
+  auto AddPropChange = [&](const ezAbstractGraphDiffOperation& op) {
+    Prop key;
+    key.m_Node = op.m_Node;
+    key.m_sProperty = op.m_sProperty;
+
+    ezUInt32 uiIndex = propChanges.GetCount();
+    if (!propChangeIndices.TryGetValue(key, uiIndex))
+    {
+      propChangeIndices.Insert(key, uiIndex);
+      propChanges.ExpandAndGetRef().m_Key = key;
+    }
+    propChanges[uiIndex].m_Operations.PushBack(&op);
   };
 
-  ezMap<Prop, ezHybridArray<const ezAbstractGraphDiffOperation*, 2>> propChanges;
-  ezSet<ezUuid> removed;
-  ezMap<ezUuid, ezUInt32> added;
+  ezHashSet<ezUuid> removed;
+  ezHashTable<ezUuid, ezUInt32> added;
   for (const ezAbstractGraphDiffOperation& op : lhs)
   {
     if (op.m_Operation == ezAbstractGraphDiffOperation::Op::NodeRemoved)
@@ -615,8 +678,7 @@ void ezAbstractObjectGraph::MergeDiffs(const ezDeque<ezAbstractGraphDiffOperatio
     }
     else if (op.m_Operation == ezAbstractGraphDiffOperation::Op::PropertyChanged)
     {
-      auto it = propChanges.FindOrAdd(Prop(op.m_Node, op.m_sProperty));
-      it.Value().PushBack(&op);
+      AddPropChange(op);
     }
   }
   for (const ezAbstractGraphDiffOperation& op : rhs)
@@ -628,9 +690,10 @@ void ezAbstractObjectGraph::MergeDiffs(const ezDeque<ezAbstractGraphDiffOperatio
     }
     else if (op.m_Operation == ezAbstractGraphDiffOperation::Op::NodeAdded)
     {
-      if (added.Contains(op.m_Node))
+      ezUInt32 uiLeftIndex = 0;
+      if (added.TryGetValue(op.m_Node, uiLeftIndex))
       {
-        ezAbstractGraphDiffOperation& leftOp = out[added[op.m_Node]];
+        ezAbstractGraphDiffOperation& leftOp = out[uiLeftIndex];
         leftOp.m_sProperty = op.m_sProperty; // Take type from rhs.
       }
       else
@@ -640,15 +703,14 @@ void ezAbstractObjectGraph::MergeDiffs(const ezDeque<ezAbstractGraphDiffOperatio
     }
     else if (op.m_Operation == ezAbstractGraphDiffOperation::Op::PropertyChanged)
     {
-      auto it = propChanges.FindOrAdd(Prop(op.m_Node, op.m_sProperty));
-      it.Value().PushBack(&op);
+      AddPropChange(op);
     }
   }
 
-  for (auto it = propChanges.GetIterator(); it.IsValid(); ++it)
+  for (const PropChange& change : propChanges)
   {
-    const Prop& key = it.Key();
-    const ezHybridArray<const ezAbstractGraphDiffOperation*, 2>& value = it.Value();
+    const Prop& key = change.m_Key;
+    const ezHybridArray<const ezAbstractGraphDiffOperation*, 2>& value = change.m_Operations;
 
     if (value.GetCount() == 1)
     {
@@ -15,13 +15,14 @@ enum ezBinarySerializerVersion : ezUInt32
 
 static void WriteGraph(const ezAbstractObjectGraph* pGraph, ezStreamWriter& stream)
 {
-  const auto& Nodes = pGraph->GetAllNodes();
+  ezDynamicArray<const ezAbstractObjectNode*> Nodes;
+  pGraph->GetAllNodesSortedByGuid(Nodes);
 
   ezUInt32 uiNodes = Nodes.GetCount();
   stream << uiNodes;
-  for (auto itNode = Nodes.GetIterator(); itNode.IsValid(); ++itNode)
+  for (const ezAbstractObjectNode* pNode : Nodes)
   {
-    const auto& node = *itNode.Value();
+    const auto& node = *pNode;
     stream << node.GetGuid();
     stream << node.GetType();
     stream << node.GetTypeVersion();
@@ -62,10 +62,12 @@ static void WriteGraph(ezOpenDdlWriter& writer, const ezAbstractObjectGraph* pGr
 
   writer.BeginObject(szName);
 
-  const auto& Nodes = pGraph->GetAllNodes();
-  for (auto itNode = Nodes.GetIterator(); itNode.IsValid(); ++itNode)
+  ezDynamicArray<const ezAbstractObjectNode*> Nodes;
+  pGraph->GetAllNodesSortedByGuid(Nodes);
+
+  for (const ezAbstractObjectNode* pNode : Nodes)
   {
-    const auto& node = *itNode.Value();
+    const auto& node = *pNode;
 
     writer.BeginObject("o");
 
@@ -226,10 +226,11 @@ void ezGraphVersioning::PatchGraph(ezAbstractObjectGraph* pGraph, ezAbstractObje
     pPatch->Patch(context, pGraph, nullptr);
   }
 
-  auto& nodes = pGraph->GetAllNodes();
-  for (auto it = nodes.GetIterator(); it.IsValid(); ++it)
+  // patches may add nodes to the graph, so iterate over a copy, sorted to apply the patches in a stable order
+  ezDynamicArray<ezAbstractObjectNode*> nodes;
+  pGraph->GetAllNodesSortedByGuid(nodes);
+  for (ezAbstractObjectNode* pNode : nodes)
   {
-    ezAbstractObjectNode* pNode = it.Value();
     context.Patch(pNode);
   }
 }
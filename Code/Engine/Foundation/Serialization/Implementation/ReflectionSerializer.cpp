@@ -6,6 +6,7 @@
 #include <Foundation/Serialization/DdlSerializer.h>
 #include <Foundation/Serialization/ReflectionSerializer.h>
 #include <Foundation/Serialization/RttiConverter.h>
+#include <Foundation/Serialization/SerializationPlan.h>
 #include <Foundation/Types/ScopeExit.h>
 #include <Foundation/IO/OpenDdlReader.h>
 
@@ -377,12 +378,29 @@ namespace
 
   static void CloneProperties(const void* pObject, void* pClone, const ezRTTI* pType)
   {
-    if (pType->GetParentType())
-      CloneProperties(pObject, pClone, pType->GetParentType());
+    const ezSerializationPlan* pPlan = ezSerializationPlan::GetPlan(pType, pObject);
+    if (pPlan == nullptr)
+    {
+      if (pType->GetParentType())
+        CloneProperties(pObject, pClone, pType->GetParentType());
+
+      for (auto* pProp : pType->GetProperties())
+      {
+        CloneProperty(pObject, pClone, pProp);
+      }
+      return;
+    }
 
-    for (auto* pProp : pType->GetProperties())
+    for (const ezSerializationPlan::CloneOp& op : pPlan->GetCloneOps())
     {
-      CloneProperty(pObject, pClone, pProp);
+      if (op.m_pProperty != nullptr)
+      {
+        CloneProperty(pObject, pClone, op.m_pProperty);
+      }
+      else
+      {
+        ezMemoryUtils::RawByteCopy(static_cast<ezUInt8*>(pClone) + op.m_uiOffset, static_cast<const ezUInt8*>(pObject) + op.m_uiOffset, op.m_uiSize);
+      }
     }
   }
 }
@@ -3,6 +3,7 @@
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Reflection/ReflectionUtils.h>
 #include <Foundation/Serialization/RttiConverter.h>
+#include <Foundation/Serialization/SerializationPlan.h>
 
 ezRttiConverterReader::ezRttiConverterReader(const ezAbstractObjectGraph* pGraph, ezRttiConverterContext* pContext)
 {
@@ -33,16 +34,37 @@ void ezRttiConverterReader::ApplyPropertiesToObject(const ezAbstractObjectNode*
 {
   EZ_ASSERT_DEBUG(pNode != nullptr, "Invalid node");
 
-  if (pRtti->GetParentType() != nullptr)
-    ApplyPropertiesToObject(pNode, pRtti->GetParentType(), pObject);
+  const ezSerializationPlan* pPlan = ezSerializationPlan::GetPlan(pRtti, pObject);
+  if (pPlan == nullptr)
+  {
+    if (pRtti->GetParentType() != nullptr)
+      ApplyPropertiesToObject(pNode, pRtti->GetParentType(), pObject);
+
+    for (auto* prop : pRtti->GetProperties())
+    {
+      auto* pOtherProp = pNode->FindProperty(prop->GetPropertyName());
+      if (pOtherProp == nullptr)
+        continue;
 
-  for (auto* prop : pRtti->GetProperties())
+      ApplyProperty(pObject, prop, pOtherProp);
+    }
+    return;
+  }
+
+  for (const ezSerializationPlan::Step& step : pPlan->GetSteps())
   {
-    auto* pOtherProp = pNode->FindProperty(prop->GetPropertyName());
+    auto* pOtherProp = pNode->FindProperty(step.m_pProperty->GetPropertyName());
     if (pOtherProp == nullptr)
       continue;
 
-    ApplyProperty(pObject, prop, pOtherProp);
+    if (step.IsPod())
+    {
+      ezSerializationPlan::WritePodMember(step, pObject, pOtherProp->m_Value);
+    }
+    else
+    {
+      ApplyProperty(pObject, step.m_pProperty, pOtherProp);
+    }
   }
 }
 
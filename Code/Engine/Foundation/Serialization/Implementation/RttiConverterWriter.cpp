@@ -2,6 +2,7 @@
 
 #include <Foundation/Reflection/ReflectionUtils.h>
 #include <Foundation/Serialization/RttiConverter.h>
+#include <Foundation/Serialization/SerializationPlan.h>
 #include <Foundation/Types/ScopeExit.h>
 
 void ezRttiConverterContext::Clear()
@@ -409,12 +410,29 @@ void ezRttiConverterWriter::AddProperty(ezAbstractObjectNode* pNode, const ezAbs
 
 void ezRttiConverterWriter::AddProperties(ezAbstractObjectNode* pNode, const ezRTTI* pRtti, const void* pObject)
 {
-  if (pRtti->GetParentType())
-    AddProperties(pNode, pRtti->GetParentType(), pObject);
+  const ezSerializationPlan* pPlan = ezSerializationPlan::GetPlan(pRtti, pObject);
+  if (pPlan == nullptr)
+  {
+    if (pRtti->GetParentType())
+      AddProperties(pNode, pRtti->GetParentType(), pObject);
+
+    for (const auto* pProp : pRtti->GetProperties())
+    {
+      AddProperty(pNode, pProp, pObject);
+    }
+    return;
+  }
 
-  for (const auto* pProp : pRtti->GetProperties())
+  for (const ezSerializationPlan::Step& step : pPlan->GetSteps())
   {
-    AddProperty(pNode, pProp, pObject);
+    if (step.IsPod())
+    {
+      pNode->AddProperty(step.m_pProperty->GetPropertyName(), ezSerializationPlan::ReadPodMember(step, pObject));
+    }
+    else
+    {
+      AddProperty(pNode, step.m_pProperty, pObject);
+    }
   }
 }
 
@@ -0,0 +1,267 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Configuration/Plugin.h>
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Serialization/SerializationPlan.h>
+#include <Foundation/Threading/Lock.h>
+
+namespace
+{
+  typedef ezHashTable<const ezRTTI*, ezSerializationPlan*, ezHashHelper<const ezRTTI*>, ezStaticAllocatorWrapper> ezPlanHashTable;
+
+  static ezMutex s_PlanMutex;
+
+  /// \brief Every thread remembers the plans it used last, so that looking up a plan only takes the lock the first time.
+  ///
+  /// The cache is direct mapped, a type simply replaces whatever other type had the same slot.
+  struct CachedPlan
+  {
+    const ezRTTI* m_pRtti;
+    const ezSerializationPlan* m_pPlan;
+  };
+
+  static constexpr ezUInt32 NUM_CACHED_PLANS = 64;
+  static thread_local CachedPlan tl_CachedPlans[NUM_CACHED_PLANS];
+  static thread_local ezInt32 tl_iCachedPlansGeneration = 0;
+
+  /// \brief Incremented by ezSerializationPlan::ClearCache(), which invalidates the plan caches of all threads.
+  static ezAtomicInteger32 s_PlanGeneration;
+
+  ezPlanHashTable& GetPlans()
+  {
+    static ezPlanHashTable s_Plans;
+    return s_Plans;
+  }
+
+  /// \brief Plans that were removed from the cache. Other threads may still use them, so they are only deleted on shutdown.
+  ezDynamicArray<ezSerializationPlan*, ezStaticAllocatorWrapper>& GetRetiredPlans()
+  {
+    static ezDynamicArray<ezSerializationPlan*, ezStaticAllocatorWrapper> s_RetiredPlans;
+    return s_RetiredPlans;
+  }
+
+  void DeleteRetiredPlans()
+  {
+    EZ_LOCK(s_PlanMutex);
+
+    for (ezSerializationPlan* pPlan : GetRetiredPlans())
+    {
+      EZ_DEFAULT_DELETE(pPlan);
+    }
+
+    GetRetiredPlans().Clear();
+    GetRetiredPlans().Compact();
+  }
+
+  void PluginEventHandler(const ezPluginEvent& e)
+  {
+    // plans store pointers to properties, which are gone once the plugin that registered them is unloaded
+    if (e.m_EventType == ezPluginEvent::AfterUnloading)
+    {
+      ezSerializationPlan::ClearCache();
+    }
+  }
+
+  bool IsPodType(ezVariantType::Enum type)
+  {
+    if (type >= ezVariantType::Bool && type <= ezVariantType::Transform)
+      return true;
+
+    return type == ezVariantType::Time || type == ezVariantType::Uuid || type == ezVariantType::Angle || type == ezVariantType::ColorGamma;
+  }
+
+  struct GetSizeFunc
+  {
+    template <typename T>
+    EZ_ALWAYS_INLINE void operator()()
+    {
+      m_uiSize = sizeof(T);
+    }
+
+    ezUInt32 m_uiSize = 0;
+  };
+
+  struct ReadPodFunc
+  {
+    template <typename T>
+    EZ_ALWAYS_INLINE void operator()()
+    {
+      m_Result = *static_cast<const T*>(m_pMember);
+    }
+
+    const void* m_pMember;
+    ezVariant m_Result;
+  };
+
+  struct WritePodFunc
+  {
+    template <typename T>
+    EZ_ALWAYS_INLINE void operator()()
+    {
+      if (m_pValue->IsA<T>())
+        *static_cast<T*>(m_pMember) = m_pValue->Get<T>();
+      else
+        *static_cast<T*>(m_pMember) = m_pValue->ConvertTo<T>();
+    }
+
+    void* m_pMember;
+    const ezVariant* m_pValue;
+  };
+} // namespace
+
+// clang-format off
+EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, SerializationPlan)
+
+  BEGIN_SUBSYSTEM_DEPENDENCIES
+    "Reflection"
+  END_SUBSYSTEM_DEPENDENCIES
+
+  ON_CORESYSTEMS_STARTUP
+  {
+    ezPlugin::s_PluginEvents.AddEventHandler(PluginEventHandler);
+  }
+
+  ON_CORESYSTEMS_SHUTDOWN
+  {
+    ezPlugin::s_PluginEvents.RemoveEventHandler(PluginEventHandler);
+    ezSerializationPlan::ClearCache();
+    DeleteRetiredPlans();
+  }
+
+EZ_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+const ezSerializationPlan* ezSerializationPlan::GetPlan(const ezRTTI* pRtti, const void* pInstance)
+{
+  if (pRtti->GetTypeFlags().IsSet(ezTypeFlags::Phantom))
+    return nullptr;
+
+  const ezInt32 iGeneration = s_PlanGeneration;
+  if (tl_iCachedPlansGeneration != iGeneration)
+  {
+    ezMemoryUtils::ZeroFill(tl_CachedPlans);
+    tl_iCachedPlansGeneration = iGeneration;
+  }
+
+  CachedPlan& cached = tl_CachedPlans[ezHashHelper<const ezRTTI*>::Hash(pRtti) % NUM_CACHED_PLANS];
+  if (cached.m_pRtti == pRtti)
+    return cached.m_pPlan;
+
+  EZ_LOCK(s_PlanMutex);
+
+  ezSerializationPlan*& pPlan = GetPlans()[pRtti];
+  if (pPlan == nullptr)
+  {
+    pPlan = EZ_DEFAULT_NEW(ezSerializationPlan);
+    pPlan->Build(pRtti, pInstance);
+  }
+
+  cached.m_pRtti = pRtti;
+  cached.m_pPlan = pPlan;
+  return pPlan;
+}
+
+void ezSerializationPlan::ClearCache()
+{
+  EZ_LOCK(s_PlanMutex);
+
+  // invalidate the thread caches first, so that no thread picks up a plan from them anymore once it is retired
+  s_PlanGeneration.Increment();
+
+  // a thread that looked up a plan just before may still be using it, so the plans are only deleted on shutdown
+  for (auto it = GetPlans().GetIterator(); it.IsValid(); ++it)
+  {
+    GetRetiredPlans().PushBack(it.Value());
+  }
+
+  GetPlans().Clear();
+}
+
+ezVariant ezSerializationPlan::ReadPodMember(const Step& step, const void* pObject)
+{
+  EZ_ASSERT_DEBUG(step.IsPod(), "Property '{0}' is not a POD member", step.m_pProperty->GetPropertyName());
+
+  ReadPodFunc func;
+  func.m_pMember = static_cast<const ezUInt8*>(pObject) + step.m_uiOffset;
+
+  ezVariant::DispatchTo(func, step.m_PodType);
+  return func.m_Result;
+}
+
+void ezSerializationPlan::WritePodMember(const Step& step, void* pObject, const ezVariant& value)
+{
+  EZ_ASSERT_DEBUG(step.IsPod(), "Property '{0}' is not a POD member", step.m_pProperty->GetPropertyName());
+
+  WritePodFunc func;
+  func.m_pMember = static_cast<ezUInt8*>(pObject) + step.m_uiOffset;
+  func.m_pValue = &value;
+
+  ezVariant::DispatchTo(func, step.m_PodType);
+}
+
+void ezSerializationPlan::Build(const ezRTTI* pRtti, const void* pInstance)
+{
+  ezHybridArray<ezAbstractProperty*, 32> properties;
+  pRtti->GetAllProperties(properties);
+
+  m_Steps.Reserve(properties.GetCount());
+
+  for (ezAbstractProperty* pProp : properties)
+  {
+    Step& step = m_Steps.ExpandAndGetRef();
+    step.m_pProperty = pProp;
+
+    const ezBitflags<ezPropertyFlags> flags = pProp->GetFlags();
+    if (pProp->GetCategory() == ezPropertyCategory::Member && flags.IsSet(ezPropertyFlags::StandardType) &&
+        !flags.IsAnySet(ezPropertyFlags::Pointer | ezPropertyFlags::ReadOnly))
+    {
+      const ezRTTI* pPropType = pProp->GetSpecificType();
+      const ezVariantType::Enum type = pPropType->GetVariantType();
+
+      // only members that are accessed directly have a fixed location inside the object
+      const void* pMember = static_cast<ezAbstractMemberProperty*>(pProp)->GetPropertyPointer(pInstance);
+
+      if (IsPodType(type) && pMember != nullptr)
+      {
+        GetSizeFunc sizeFunc;
+        ezVariant::DispatchTo(sizeFunc, type);
+
+        const ezUInt64 uiOffset = static_cast<const ezUInt8*>(pMember) - static_cast<const ezUInt8*>(pInstance);
+
+        if (sizeFunc.m_uiSize == pPropType->GetTypeSize() && uiOffset + sizeFunc.m_uiSize <= pRtti->GetTypeSize())
+        {
+          step.m_uiOffset = static_cast<ezUInt32>(uiOffset);
+          step.m_uiSize = sizeFunc.m_uiSize;
+          step.m_PodType = type;
+        }
+      }
+    }
+
+    if (flags.IsSet(ezPropertyFlags::ReadOnly))
+      continue;
+
+    if (step.IsPod())
+    {
+      // members that directly follow the previous one are copied together
+      if (!m_CloneOps.IsEmpty() && m_CloneOps.PeekBack().m_pProperty == nullptr &&
+          m_CloneOps.PeekBack().m_uiOffset + m_CloneOps.PeekBack().m_uiSize == step.m_uiOffset)
+      {
+        m_CloneOps.PeekBack().m_uiSize += step.m_uiSize;
+      }
+      else
+      {
+        CloneOp& op = m_CloneOps.ExpandAndGetRef();
+        op.m_uiOffset = step.m_uiOffset;
+        op.m_uiSize = step.m_uiSize;
+      }
+    }
+    else
+    {
+      CloneOp& op = m_CloneOps.ExpandAndGetRef();
+      op.m_pProperty = pProp;
+    }
+  }
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Serialization_Implementation_SerializationPlan);
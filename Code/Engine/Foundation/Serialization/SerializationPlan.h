@@ -0,0 +1,64 @@
+#pragma once
+
+#include <Foundation/Reflection/Reflection.h>
+
+/// \brief A flattened description of all properties of a reflected type and its base types, which is built once per type and cached.
+///
+/// Properties that are members of a plain old data standard type (numbers, vectors, colors, matrices, ezTime, ezUuid, ...) and are accessed
+/// directly (EZ_MEMBER_PROPERTY) are recorded with their offset inside the object. They can be read and written without going through the
+/// virtual property interface, and members that are adjacent in memory are copied with a single memcpy when cloning.
+/// All other properties are still handled through the property interface.
+///
+/// The plan only changes how the values are accessed, the data that ezRttiConverterWriter produces is exactly the same as without a plan.
+///
+/// Plans are cached until a plugin is unloaded. Phantom types never get a plan, since their properties can change at any time.
+class EZ_FOUNDATION_DLL ezSerializationPlan
+{
+public:
+  struct Step
+  {
+    ezAbstractProperty* m_pProperty = nullptr;
+    ezUInt32 m_uiOffset = 0;                                  ///< The offset of the member inside the object, only for POD members.
+    ezUInt32 m_uiSize = 0;                                    ///< The size of the member, only for POD members.
+    ezVariantType::Enum m_PodType = ezVariantType::Invalid; ///< Invalid, if the property has to be accessed through the property interface.
+
+    EZ_ALWAYS_INLINE bool IsPod() const { return m_PodType != ezVariantType::Invalid; }
+  };
+
+  struct CloneOp
+  {
+    ezAbstractProperty* m_pProperty = nullptr; ///< If set, the property is cloned through the property interface, otherwise the memory is copied.
+    ezUInt32 m_uiOffset = 0;
+    ezUInt32 m_uiSize = 0;
+  };
+
+  /// \brief Returns the plan for the given type, which is built first, if necessary. Returns nullptr for phantom types.
+  ///
+  /// \a pInstance must be an instance of the type, it is only used to determine the offsets of the members when the plan is built.
+  /// Each thread caches the plans it used recently, only the first lookup of a type on a thread has to lock the shared cache.
+  static const ezSerializationPlan* GetPlan(const ezRTTI* pRtti, const void* pInstance);
+
+  /// \brief Removes all plans from the cache, the next GetPlan() call for a type builds a new plan.
+  ///
+  /// Plans that were already returned by GetPlan() stay valid until the Foundation library shuts down, since other threads may still be
+  /// using them.
+  static void ClearCache();
+
+  /// \brief All properties of the type and its base types, in the same order as ezRTTI::GetAllProperties() returns them.
+  ezArrayPtr<const Step> GetSteps() const { return m_Steps; }
+
+  /// \brief The operations that copy all writable properties from one object to another, in the order of the properties.
+  ezArrayPtr<const CloneOp> GetCloneOps() const { return m_CloneOps; }
+
+  /// \brief Returns the value of a POD member.
+  static ezVariant ReadPodMember(const Step& step, const void* pObject);
+
+  /// \brief Sets the value of a POD member. The value is converted to the type of the member, if necessary.
+  static void WritePodMember(const Step& step, void* pObject, const ezVariant& value);
+
+private:
+  void Build(const ezRTTI* pRtti, const void* pInstance);
+
+  ezDynamicArray<Step> m_Steps;
+  ezDynamicArray<CloneOp> m_CloneOps;
+};
@@ -79,6 +79,9 @@ void ezCrashHandler_WriteMiniDump::SetDumpFilePath(const char* szAppName, ezBitf
 
 void ezCrashHandler_WriteMiniDump::HandleCrash(void* pOsSpecificData)
 {
+  // write out what was logged asynchronously so far, it likely explains the crash
+  ezGlobalLog::FlushAsyncLogging();
+
   bool crashDumpWritten = false;
   if (!m_sDumpFilePath.IsEmpty())
   {
@@ -108,6 +111,8 @@ void ezCrashHandler_WriteMiniDump::HandleCrash(void* pOsSpecificData)
   {
     ezLog::Error("Application crashed. Crash-dump written to '{}'.", m_sDumpFilePath);
   }
+
+  ezGlobalLog::FlushAsyncLogging();
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,244 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Threading/MutexProfiling.h>
+
+#if EZ_ENABLED(EZ_USE_MUTEX_PROFILING)
+
+#  include <Foundation/Profiling/Profiling.h>
+#  include <Foundation/System/StackTracer.h>
+#  include <Foundation/Threading/AtomicUtils.h>
+#  include <Foundation/Threading/ThreadUtils.h>
+
+namespace
+{
+  // These are zero initialized before any constructor runs, so named mutexes may also be global variables.
+  ezMutexProfilingStats s_Stats[ezMutexProfiling::MAX_NAMED_MUTEXES];
+  ezInt32 s_iNumStats = 0;
+
+  // A mutex can't be used to protect the registration of mutexes, so this is a simple spin lock.
+  ezInt32 s_iRegistrationLock = 0;
+
+  void AcquireSpinLock(ezInt32& iLock)
+  {
+    while (!ezAtomicUtils::TestAndSet(iLock, 0, 1))
+    {
+      ezThreadUtils::YieldTimeSlice();
+    }
+  }
+
+  void ReleaseSpinLock(ezInt32& iLock)
+  {
+    ezAtomicUtils::Set(iLock, 0);
+  }
+
+  // ezAtomicUtils only works on signed integers, the stats use unsigned counters and doubles to be easier to read
+
+  EZ_ALWAYS_INLINE void AtomicIncrement(ezUInt64& ref_uiDest)
+  {
+    ezAtomicUtils::Increment(reinterpret_cast<volatile ezInt64&>(ref_uiDest));
+  }
+
+  EZ_ALWAYS_INLINE void AtomicSet(double& ref_fDest, double fValue)
+  {
+    ezAtomicUtils::Set(reinterpret_cast<volatile ezInt64&>(ref_fDest), static_cast<ezInt64>(ezInt64DoubleUnion(fValue).i));
+  }
+
+  EZ_ALWAYS_INLINE double AtomicRead(const double& fSrc)
+  {
+    return ezInt64DoubleUnion(static_cast<ezUInt64>(ezAtomicUtils::Read(reinterpret_cast<volatile const ezInt64&>(fSrc)))).f;
+  }
+
+  void AtomicAdd(double& ref_fDest, double fValue)
+  {
+    volatile ezInt64& iDest = reinterpret_cast<volatile ezInt64&>(ref_fDest);
+
+    while (true)
+    {
+      const ezInt64 iOld = ezAtomicUtils::Read(iDest);
+      const ezInt64DoubleUnion newValue(ezInt64DoubleUnion(static_cast<ezUInt64>(iOld)).f + fValue);
+
+      if (ezAtomicUtils::TestAndSet(iDest, iOld, static_cast<ezInt64>(newValue.i)))
+        return;
+    }
+  }
+
+  void AtomicMax(double& ref_fDest, double fValue)
+  {
+    volatile ezInt64& iDest = reinterpret_cast<volatile ezInt64&>(ref_fDest);
+
+    while (true)
+    {
+      const ezInt64 iOld = ezAtomicUtils::Read(iDest);
+      if (ezInt64DoubleUnion(static_cast<ezUInt64>(iOld)).f >= fValue)
+        return;
+
+      if (ezAtomicUtils::TestAndSet(iDest, iOld, static_cast<ezInt64>(ezInt64DoubleUnion(fValue).i)))
+        return;
+    }
+  }
+} // namespace
+
+ezMutexProfilingStats* ezMutexProfiling::Register(const char* szName)
+{
+  AcquireSpinLock(s_iRegistrationLock);
+
+  ezMutexProfilingStats* pStats = nullptr;
+
+  // mutexes with the same name share their stats, this also keeps the stats of mutexes that get destroyed and re-created
+  for (ezInt32 i = 0; i < s_iNumStats; ++i)
+  {
+    if (ezStringUtils::IsEqual(s_Stats[i].m_szName, szName))
+    {
+      pStats = &s_Stats[i];
+      break;
+    }
+  }
+
+  if (pStats == nullptr && s_iNumStats < static_cast<ezInt32>(MAX_NAMED_MUTEXES))
+  {
+    pStats = &s_Stats[s_iNumStats];
+    pStats->m_szName = szName;
+    ezStringUtils::snprintf(pStats->m_szWaitScopeName, ezMutexProfilingStats::SCOPE_NAME_SIZE, "Lock Wait: %s", szName);
+    ezStringUtils::snprintf(pStats->m_szHoldScopeName, ezMutexProfilingStats::SCOPE_NAME_SIZE, "Lock Held: %s", szName);
+
+    // only publish the entry once it is fully initialized
+    ezAtomicUtils::Increment(s_iNumStats);
+  }
+
+  ReleaseSpinLock(s_iRegistrationLock);
+
+  return pStats;
+}
+
+ezArrayPtr<const ezMutexProfilingStats> ezMutexProfiling::GetAllStats()
+{
+  return ezArrayPtr<const ezMutexProfilingStats>(s_Stats, static_cast<ezUInt32>(ezAtomicUtils::Read(s_iNumStats)));
+}
+
+void ezMutexProfiling::ResetStats()
+{
+  const ezInt32 iNumStats = ezAtomicUtils::Read(s_iNumStats);
+
+  for (ezInt32 i = 0; i < iNumStats; ++i)
+  {
+    ezMutexProfilingStats& stats = s_Stats[i];
+    ezAtomicUtils::Set(reinterpret_cast<volatile ezInt64&>(stats.m_uiAcquisitions), 0);
+    ezAtomicUtils::Set(reinterpret_cast<volatile ezInt64&>(stats.m_uiContentions), 0);
+    AtomicSet(stats.m_fTotalWaitTime, 0.0);
+    AtomicSet(stats.m_fTotalHoldTime, 0.0);
+    AtomicSet(stats.m_fMaxHoldTime, 0.0);
+
+    AcquireSpinLock(stats.m_iSlowestWaitLock);
+    AtomicSet(stats.m_fMaxWaitTime, 0.0);
+    stats.m_uiSlowestWaitStackTraceLength = 0;
+    ReleaseSpinLock(stats.m_iSlowestWaitLock);
+  }
+}
+
+const ezMutexProfilingStats* ezMutexProfiling::GetStats(const char* szName)
+{
+  for (const ezMutexProfilingStats& stats : GetAllStats())
+  {
+    if (ezStringUtils::IsEqual(stats.m_szName, szName))
+      return &stats;
+  }
+
+  return nullptr;
+}
+
+ezUInt32 ezMutexProfiling::GetSlowestWaitStackTrace(const ezMutexProfilingStats& stats, ezArrayPtr<void*> out_StackTrace)
+{
+  ezMutexProfilingStats& mutableStats = const_cast<ezMutexProfilingStats&>(stats);
+
+  AcquireSpinLock(mutableStats.m_iSlowestWaitLock);
+
+  const ezUInt32 uiLength = ezMath::Min(stats.m_uiSlowestWaitStackTraceLength, out_StackTrace.GetCount());
+  ezMemoryUtils::Copy(out_StackTrace.GetPtr(), stats.m_SlowestWaitStackTrace, uiLength);
+
+  ReleaseSpinLock(mutableStats.m_iSlowestWaitLock);
+
+  return uiLength;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezMutex::ezMutex(const char* szProfilingName)
+  : ezMutex()
+{
+  m_pProfilingStats = ezMutexProfiling::Register(szProfilingName);
+}
+
+void ezMutex::LockProfiled()
+{
+  if (!TryLockImpl())
+  {
+    const ezTime startTime = ezTime::Now();
+    LockImpl();
+    const ezTime endTime = ezTime::Now();
+
+    // holding this mutex does not protect the stats, other mutexes with the same name update them concurrently
+    const double fWaitTime = (endTime - startTime).GetSeconds();
+    AtomicIncrement(m_pProfilingStats->m_uiContentions);
+    AtomicAdd(m_pProfilingStats->m_fTotalWaitTime, fWaitTime);
+
+    // only the stack of the longest wait is kept, so taking the lock becomes rare quickly
+    if (fWaitTime > AtomicRead(m_pProfilingStats->m_fMaxWaitTime))
+    {
+      AcquireSpinLock(m_pProfilingStats->m_iSlowestWaitLock);
+
+      if (fWaitTime > m_pProfilingStats->m_fMaxWaitTime)
+      {
+        AtomicSet(m_pProfilingStats->m_fMaxWaitTime, fWaitTime);
+
+        ezArrayPtr<void*> stackTrace(m_pProfilingStats->m_SlowestWaitStackTrace);
+        m_pProfilingStats->m_uiSlowestWaitStackTraceLength = ezStackTracer::GetStackTrace(stackTrace);
+      }
+
+      ReleaseSpinLock(m_pProfilingStats->m_iSlowestWaitLock);
+    }
+
+    ezProfilingSystem::AddCPUScope(m_pProfilingStats->m_szWaitScopeName, nullptr, startTime, endTime);
+  }
+
+  AtomicIncrement(m_pProfilingStats->m_uiAcquisitions);
+
+  if (m_iLockCount == 1)
+  {
+    m_LockTime = ezTime::Now();
+  }
+}
+
+bool ezMutex::TryLockProfiled()
+{
+  if (!TryLockImpl())
+    return false;
+
+  AtomicIncrement(m_pProfilingStats->m_uiAcquisitions);
+
+  if (m_iLockCount == 1)
+  {
+    m_LockTime = ezTime::Now();
+  }
+
+  return true;
+}
+
+void ezMutex::UnlockProfiled()
+{
+  if (m_iLockCount == 1)
+  {
+    const ezTime endTime = ezTime::Now();
+    const double fHoldTime = (endTime - m_LockTime).GetSeconds();
+
+    AtomicAdd(m_pProfilingStats->m_fTotalHoldTime, fHoldTime);
+    AtomicMax(m_pProfilingStats->m_fMaxHoldTime, fHoldTime);
+
+    ezProfilingSystem::AddCPUScope(m_pProfilingStats->m_szHoldScopeName, nullptr, m_LockTime, endTime);
+  }
+
+  UnlockImpl();
+}
+
+#endif
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Threading_Implementation_MutexProfiling);
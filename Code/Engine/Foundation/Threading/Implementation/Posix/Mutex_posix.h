@@ -15,13 +15,13 @@ EZ_ALWAYS_INLINE ezMutex::~ezMutex()
   pthread_mutex_destroy(&m_Handle);
 }
 
-EZ_ALWAYS_INLINE void ezMutex::Lock()
+EZ_ALWAYS_INLINE void ezMutex::LockImpl()
 {
   pthread_mutex_lock(&m_Handle);
   ++m_iLockCount;
 }
 
-EZ_ALWAYS_INLINE bool ezMutex::TryLock()
+EZ_ALWAYS_INLINE bool ezMutex::TryLockImpl()
 {
   if (pthread_mutex_trylock(&m_Handle) == 0)
   {
@@ -31,7 +31,7 @@ EZ_ALWAYS_INLINE bool ezMutex::TryLock()
 
   return false;
 }
-EZ_ALWAYS_INLINE void ezMutex::Unlock()
+EZ_ALWAYS_INLINE void ezMutex::UnlockImpl()
 {
   --m_iLockCount;
   pthread_mutex_unlock(&m_Handle);
@@ -46,6 +46,11 @@ void ezTask::Run(ezUInt32 uiInvocation)
 
     EZ_PROFILE_SCOPE(scopeName.GetData());
 
+    if (ezProfilingSystem::IsStreamingCapture() && m_BelongsToGroup.IsValid())
+    {
+      ezProfilingSystem::AddFlowEvent(ezProfilingSystem::FlowEventType::Step, m_BelongsToGroup.GetProfilingFlowId());
+    }
+
     if (m_bUsesMultiplicity)
     {
       ExecuteWithMultiplicity(uiInvocation);
@@ -32,6 +32,12 @@ void ezTaskGroup::Reuse(ezTaskPriority::Enum priority, ezOnTaskGroupFinishedCall
   m_OnFinishedCallback = callback;
 }
 
+ezUInt64 ezTaskGroupID::GetProfilingFlowId() const
+{
+  // the index identifies the group object, the counter identifies the current use of it
+  return (static_cast<ezUInt64>(m_pTaskGroup->m_uiTaskGroupIndex) << 32) | m_uiGroupCounter;
+}
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
 void ezTaskGroup::DebugCheckTaskGroup(ezTaskGroupID groupID, ezMutex& mutex)
 {
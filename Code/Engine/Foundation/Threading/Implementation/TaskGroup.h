@@ -16,6 +16,7 @@ public:
 
 private:
   friend class ezTaskSystem;
+  friend class ezTaskGroupID;
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
   static void DebugCheckTaskGroup(ezTaskGroupID groupID, ezMutex& mutex);
@@ -6,7 +6,7 @@
 #include <Foundation/Threading/Implementation/TaskWorkerThread.h>
 #include <Foundation/Threading/TaskSystem.h>
 
-ezMutex ezTaskSystem::s_TaskSystemMutex;
+ezMutex ezTaskSystem::s_TaskSystemMutex("ezTaskSystem");
 ezUniquePtr<ezTaskSystemState> ezTaskSystem::s_State;
 ezUniquePtr<ezTaskSystemThreadState> ezTaskSystem::s_ThreadState;
 
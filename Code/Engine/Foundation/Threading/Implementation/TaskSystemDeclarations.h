@@ -111,6 +111,9 @@ public:
   /// \brief Resets the GroupID into an invalid state.
   EZ_ALWAYS_INLINE void Invalidate() { m_pTaskGroup = nullptr; }
 
+  /// \brief Returns a number that identifies this specific use of the task group. Used to connect its tasks in profiling captures.
+  ezUInt64 GetProfilingFlowId() const;
+
   EZ_ALWAYS_INLINE bool operator==(const ezTaskGroupID& other) const { return m_pTaskGroup == other.m_pTaskGroup && m_uiGroupCounter == other.m_uiGroupCounter; }
   EZ_ALWAYS_INLINE bool operator!=(const ezTaskGroupID& other) const { return m_pTaskGroup != other.m_pTaskGroup || m_uiGroupCounter != other.m_uiGroupCounter; }
   EZ_ALWAYS_INLINE bool operator<(const ezTaskGroupID& other) const
@@ -111,6 +111,17 @@ void ezTaskSystem::StartTaskGroup(ezTaskGroupID groupID)
     }
   }
 
+  if (ezProfilingSystem::IsStreamingCapture())
+  {
+    const ezUInt64 uiFlowId = groupID.GetProfilingFlowId();
+    ezProfilingSystem::AddFlowEvent(ezProfilingSystem::FlowEventType::Start, uiFlowId);
+
+    for (const ezTaskGroupID& dependency : groupID.m_pTaskGroup->m_DependsOnGroups)
+    {
+      ezProfilingSystem::AddFlowDependency(uiFlowId, dependency.GetProfilingFlowId());
+    }
+  }
+
   if (iActiveDependencies == 0)
   {
     ScheduleGroupTasks(groupID.m_pTaskGroup, false);
@@ -47,6 +47,14 @@ void ezTaskSystem::TaskHasFinished(const ezSharedPtr<ezTask>& pTask, ezTaskGroup
       pGroup->m_uiGroupCounter += 2;
     }
 
+    if (ezProfilingSystem::IsStreamingCapture())
+    {
+      ezTaskGroupID id;
+      id.m_pTaskGroup = pGroup;
+      id.m_uiGroupCounter = groupCounter;
+      ezProfilingSystem::AddFlowEvent(ezProfilingSystem::FlowEventType::Finish, id.GetProfilingFlowId());
+    }
+
     // wake up all threads that are waiting for this group
     pGroup->m_CondVarGroupFinished.SignalAll();
 
@@ -28,19 +28,19 @@ extern "C"
 #  endif
 }
 
-inline void ezMutex::Lock()
+inline void ezMutex::LockImpl()
 {
   ezWinEnterCriticalSection(&m_Handle);
   ++m_iLockCount;
 }
 
-inline void ezMutex::Unlock()
+inline void ezMutex::UnlockImpl()
 {
   --m_iLockCount;
   ezWinLeaveCriticalSection(&m_Handle);
 }
 
-inline bool ezMutex::TryLock()
+inline bool ezMutex::TryLockImpl()
 {
   if (ezWinTryEnterCriticalSection(&m_Handle) != 0)
   {
@@ -55,19 +55,19 @@ inline bool ezMutex::TryLock()
 
 #  include <Foundation/Basics/Platform/Win/IncludeWindows.h>
 
-inline void ezMutex::Lock()
+inline void ezMutex::LockImpl()
 {
   EnterCriticalSection((CRITICAL_SECTION*)&m_Handle);
   ++m_iLockCount;
 }
 
-inline void ezMutex::Unlock()
+inline void ezMutex::UnlockImpl()
 {
   --m_iLockCount;
   LeaveCriticalSection((CRITICAL_SECTION*)&m_Handle);
 }
 
-inline bool ezMutex::TryLock()
+inline bool ezMutex::TryLockImpl()
 {
   if (TryEnterCriticalSection((CRITICAL_SECTION*)&m_Handle) != 0)
   {
@@ -3,6 +3,12 @@
 #include <Foundation/Basics.h>
 #include <Foundation/Threading/Implementation/ThreadingDeclarations.h>
 
+#if EZ_ENABLED(EZ_USE_MUTEX_PROFILING)
+#  include <Foundation/Time/Time.h>
+
+struct ezMutexProfilingStats;
+#endif
+
 /// \brief Provides a simple mechanism for mutual exclusion to prevent multiple threads from accessing a shared resource simultaneously.
 ///
 /// This can be used to protect code that is not thread-safe against race conditions.
@@ -13,6 +19,13 @@ class EZ_FOUNDATION_DLL ezMutex
 
 public:
   ezMutex();
+
+  /// \brief Creates a mutex with a name, under which its wait time, hold time and contention are recorded, if EZ_USE_MUTEX_PROFILING is enabled.
+  ///
+  /// The name must stay valid for the lifetime of the process, typically it is a string literal.
+  /// Mutexes with the same name share their statistics. See ezMutexProfiling.
+  explicit ezMutex(const char* szProfilingName);
+
   ~ezMutex();
 
   /// \brief Acquires an exclusive lock for this mutex object
@@ -35,8 +48,21 @@ public:
   ezMutexHandle& GetMutexHandle() { return m_Handle; }
 
 private:
+  void LockImpl();
+  bool TryLockImpl();
+  void UnlockImpl();
+
   ezMutexHandle m_Handle;
   ezInt32 m_iLockCount = 0;
+
+#if EZ_ENABLED(EZ_USE_MUTEX_PROFILING)
+  void LockProfiled();
+  bool TryLockProfiled();
+  void UnlockProfiled();
+
+  ezMutexProfilingStats* m_pProfilingStats = nullptr;
+  ezTime m_LockTime;
+#endif
 };
 
 /// \brief A dummy mutex that does no locking.
@@ -65,3 +91,50 @@ public:
 #else
 #  error "Mutex is not implemented on current platform"
 #endif
+
+#if EZ_DISABLED(EZ_USE_MUTEX_PROFILING)
+
+EZ_ALWAYS_INLINE ezMutex::ezMutex(const char* szProfilingName)
+  : ezMutex()
+{
+}
+
+#endif
+
+EZ_ALWAYS_INLINE void ezMutex::Lock()
+{
+#if EZ_ENABLED(EZ_USE_MUTEX_PROFILING)
+  if (m_pProfilingStats != nullptr)
+  {
+    LockProfiled();
+    return;
+  }
+#endif
+
+  LockImpl();
+}
+
+EZ_ALWAYS_INLINE bool ezMutex::TryLock()
+{
+#if EZ_ENABLED(EZ_USE_MUTEX_PROFILING)
+  if (m_pProfilingStats != nullptr)
+  {
+    return TryLockProfiled();
+  }
+#endif
+
+  return TryLockImpl();
+}
+
+EZ_ALWAYS_INLINE void ezMutex::Unlock()
+{
+#if EZ_ENABLED(EZ_USE_MUTEX_PROFILING)
+  if (m_pProfilingStats != nullptr)
+  {
+    UnlockProfiled();
+    return;
+  }
+#endif
+
+  UnlockImpl();
+}
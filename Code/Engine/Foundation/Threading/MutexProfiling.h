@@ -0,0 +1,70 @@
+#pragma once
+
+#include <Foundation/Threading/Mutex.h>
+
+#if EZ_ENABLED(EZ_USE_MUTEX_PROFILING)
+
+/// \brief The recorded statistics of all mutexes with the same name.
+///
+/// Since different mutexes may share the same stats, all values are updated atomically. Reading them from another thread may return
+/// slightly outdated values. Use ezMutexProfiling::GetSlowestWaitStackTrace() to get a consistent copy of the stack trace.
+struct ezMutexProfilingStats
+{
+  EZ_DECLARE_POD_TYPE();
+
+  static constexpr ezUInt32 MAX_STACK_TRACE_LENGTH = 32;
+  static constexpr ezUInt32 SCOPE_NAME_SIZE = 40;
+
+  const char* m_szName;
+  ezUInt64 m_uiAcquisitions; ///< How often the mutex was locked, recursive locks are counted as well.
+  ezUInt64 m_uiContentions;  ///< How often a thread had to wait, because another thread held the mutex.
+  double m_fTotalWaitTime;   ///< In seconds, the sum of all waits.
+  double m_fMaxWaitTime;     ///< In seconds, the longest wait.
+  double m_fTotalHoldTime;   ///< In seconds, the sum of all durations for which the mutex was held, measured from the outermost lock to its unlock.
+  double m_fMaxHoldTime;     ///< In seconds, the longest duration for which the mutex was held.
+
+  /// \brief The call stack of the thread that had to wait the longest, see ezStackTracer::ResolveStackTrace().
+  void* m_SlowestWaitStackTrace[MAX_STACK_TRACE_LENGTH];
+  ezUInt32 m_uiSlowestWaitStackTraceLength;
+
+  /// \brief Spin lock that protects m_fMaxWaitTime and the stack trace, so that they always belong together.
+  ezInt32 m_iSlowestWaitLock;
+
+  char m_szWaitScopeName[SCOPE_NAME_SIZE];
+  char m_szHoldScopeName[SCOPE_NAME_SIZE];
+};
+
+/// \brief Gives access to the statistics of named mutexes, when EZ_USE_MUTEX_PROFILING is enabled.
+///
+/// Only mutexes that were given a name in their constructor are instrumented, all others behave exactly as without the profiling mode.
+/// Waits for and holds of a named mutex are also added as scopes to ezProfilingSystem, if they are longer than its discard threshold.
+/// Since the hold time is measured from lock to unlock, it includes the time that a thread spends waiting on an ezConditionVariable.
+///
+/// When EZ_USE_MUTEX_PROFILING is disabled, naming a mutex has no effect and there is no overhead at all.
+class EZ_FOUNDATION_DLL ezMutexProfiling
+{
+public:
+  /// \brief The maximum number of different mutex names. Mutexes with further names are not recorded.
+  static constexpr ezUInt32 MAX_NAMED_MUTEXES = 128;
+
+  /// \brief Returns the statistics of all named mutexes.
+  static ezArrayPtr<const ezMutexProfilingStats> GetAllStats();
+
+  /// \brief Resets the statistics of all named mutexes, e.g. to only look at a certain period of time.
+  static void ResetStats();
+
+  /// \brief Returns the statistics of the mutexes with the given name, or nullptr if there is no such mutex.
+  static const ezMutexProfilingStats* GetStats(const char* szName);
+
+  /// \brief Copies the call stack of the slowest wait into out_StackTrace and returns the number of entries that were written.
+  ///
+  /// The stack trace may be replaced at any time by another thread, this function makes sure that it is not read while that happens.
+  static ezUInt32 GetSlowestWaitStackTrace(const ezMutexProfilingStats& stats, ezArrayPtr<void*> out_StackTrace);
+
+private:
+  friend class ezMutex;
+
+  static ezMutexProfilingStats* Register(const char* szName);
+};
+
+#endif
@@ -42,6 +42,14 @@
 #  define EZ_USE_ALLOCATION_STACK_TRACING EZ_OFF
 #endif
 
+#ifdef BUILDSYSTEM_USE_MUTEX_PROFILING
+#  undef EZ_USE_MUTEX_PROFILING
+#  define EZ_USE_MUTEX_PROFILING EZ_ON
+#else
+#  undef EZ_USE_MUTEX_PROFILING
+#  define EZ_USE_MUTEX_PROFILING EZ_OFF
+#endif
+
 
 
 #if !defined(BUILDSYSTEM_IGNORE_USERCONFIG_HEADER)
@@ -79,4 +87,8 @@
 //#undef EZ_USE_GUARDED_ALLOCATIONS
 //#define EZ_USE_GUARDED_ALLOCATIONS EZ_ON
 
+// Uncomment to record wait time, hold time and contention of named mutexes, see ezMutexProfiling.
+//#undef EZ_USE_MUTEX_PROFILING
+//#define EZ_USE_MUTEX_PROFILING EZ_ON
+
 #endif
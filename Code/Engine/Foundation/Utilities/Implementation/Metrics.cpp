@@ -0,0 +1,283 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Utilities/Metrics.h>
+#include <Foundation/Utilities/Stats.h>
+
+namespace
+{
+  enum MetricType : ezUInt32
+  {
+    Counter,
+    Gauge,
+    Histogram
+  };
+
+  struct MetricEntry
+  {
+    ezInternal::ezMetricValues m_Values;
+
+    ezString m_sName; ///< Empty, if the entry is not in use.
+    ezUInt32 m_uiType = 0;
+    ezUInt32 m_uiRefCount = 0;
+
+    /// The bucket counts at the previous update, histograms only publish what was recorded since then.
+    ezInt64 m_PreviousBucketCounts[ezInternal::ezMetricValues::MAX_HISTOGRAM_BUCKETS];
+
+    /// The names of the stats that this metric publishes and their last published values, so unchanged values can be skipped.
+    ezHybridArray<ezString, 1> m_StatNames;
+    ezHybridArray<ezVariant, 1> m_PublishedValues;
+  };
+
+  static ezMutex s_MetricsMutex;
+  static ezDeque<MetricEntry> s_Metrics;
+  static ezDynamicArray<ezUInt32> s_FreeMetricIndices;
+
+  static void PublishStat(MetricEntry& entry, ezUInt32 uiStat, const ezVariant& value)
+  {
+    if (entry.m_PublishedValues[uiStat] == value)
+      return;
+
+    entry.m_PublishedValues[uiStat] = value;
+    ezStats::SetStat(entry.m_StatNames[uiStat], value);
+  }
+
+  static void PublishHistogram(MetricEntry& entry)
+  {
+    ezInternal::ezMetricValues& values = entry.m_Values;
+
+    ezInt64 bucketCounts[ezInternal::ezMetricValues::MAX_HISTOGRAM_BUCKETS];
+    ezInt64 iTotalCount = 0;
+
+    for (ezUInt32 i = 0; i < values.m_uiNumBuckets; ++i)
+    {
+      const ezInt64 iCount = ezAtomicUtils::Read(values.m_BucketCounts[i]);
+      bucketCounts[i] = iCount - entry.m_PreviousBucketCounts[i];
+      entry.m_PreviousBucketCounts[i] = iCount;
+
+      iTotalCount += bucketCounts[i];
+    }
+
+    // stat 0 is the total count, followed by one stat per bucket and the three percentiles
+    PublishStat(entry, 0, iTotalCount);
+
+    for (ezUInt32 i = 0; i < values.m_uiNumBuckets; ++i)
+    {
+      PublishStat(entry, 1 + i, bucketCounts[i]);
+    }
+
+    const ezInt64 iPercentiles[] = {50, 90, 99};
+    for (ezUInt32 p = 0; p < EZ_ARRAY_SIZE(iPercentiles); ++p)
+    {
+      const ezUInt32 uiStat = 1 + values.m_uiNumBuckets + p;
+
+      if (iTotalCount == 0)
+      {
+        PublishStat(entry, uiStat, "-");
+        continue;
+      }
+
+      // the rank of the value that is the percentile, rounded up
+      const ezInt64 iRank = (iTotalCount * iPercentiles[p] + 99) / 100;
+
+      ezUInt32 uiBucket = 0;
+      for (ezInt64 iSum = bucketCounts[0]; iSum < iRank; iSum += bucketCounts[uiBucket])
+      {
+        ++uiBucket;
+      }
+
+      ezStringBuilder sBucket;
+      if (uiBucket + 1 < values.m_uiNumBuckets)
+        sBucket.Format("<= {0}", values.m_BucketUpperBounds[uiBucket]);
+      else
+        sBucket.Format("> {0}", values.m_BucketUpperBounds[values.m_uiNumBuckets - 2]);
+
+      PublishStat(entry, uiStat, sBucket.GetData());
+    }
+  }
+} // namespace
+
+ezMetricCounter ezMetrics::RegisterCounter(const char* szName)
+{
+  ezMetricCounter counter;
+  counter.m_pValues = Register(szName, MetricType::Counter, ezArrayPtr<const double>(), counter.m_uiIndex);
+  return counter;
+}
+
+ezMetricGauge ezMetrics::RegisterGauge(const char* szName)
+{
+  ezMetricGauge gauge;
+  gauge.m_pValues = Register(szName, MetricType::Gauge, ezArrayPtr<const double>(), gauge.m_uiIndex);
+  return gauge;
+}
+
+ezMetricHistogram ezMetrics::RegisterHistogram(const char* szName, ezArrayPtr<const double> bucketUpperBounds)
+{
+  ezMetricHistogram histogram;
+  histogram.m_pValues = Register(szName, MetricType::Histogram, bucketUpperBounds, histogram.m_uiIndex);
+  return histogram;
+}
+
+void ezMetrics::Unregister(ezMetricCounter& counter)
+{
+  if (counter.m_pValues == nullptr)
+    return;
+
+  Unregister(counter.m_uiIndex);
+  counter.m_pValues = nullptr;
+}
+
+void ezMetrics::Unregister(ezMetricGauge& gauge)
+{
+  if (gauge.m_pValues == nullptr)
+    return;
+
+  Unregister(gauge.m_uiIndex);
+  gauge.m_pValues = nullptr;
+}
+
+void ezMetrics::Unregister(ezMetricHistogram& histogram)
+{
+  if (histogram.m_pValues == nullptr)
+    return;
+
+  Unregister(histogram.m_uiIndex);
+  histogram.m_pValues = nullptr;
+}
+
+void ezMetrics::UpdateStats()
+{
+  EZ_LOCK(s_MetricsMutex);
+
+  for (MetricEntry& entry : s_Metrics)
+  {
+    if (entry.m_uiRefCount == 0)
+      continue;
+
+    if (entry.m_uiType == MetricType::Histogram)
+    {
+      PublishHistogram(entry);
+    }
+    else
+    {
+      PublishStat(entry, 0, ezAtomicUtils::Read(entry.m_Values.m_iValue));
+    }
+  }
+}
+
+ezInternal::ezMetricValues* ezMetrics::Register(const char* szName, ezUInt32 uiType, ezArrayPtr<const double> bucketUpperBounds, ezUInt32& out_uiIndex)
+{
+  EZ_ASSERT_DEV(!ezStringUtils::IsNullOrEmpty(szName), "Metrics need a name");
+  EZ_ASSERT_DEV(bucketUpperBounds.GetCount() < ezInternal::ezMetricValues::MAX_HISTOGRAM_BUCKETS, "Histograms support at most {0} bucket upper bounds", ezInternal::ezMetricValues::MAX_HISTOGRAM_BUCKETS - 1);
+
+  EZ_LOCK(s_MetricsMutex);
+
+  for (ezUInt32 i = 0; i < s_Metrics.GetCount(); ++i)
+  {
+    MetricEntry& entry = s_Metrics[i];
+
+    if (entry.m_uiRefCount > 0 && entry.m_sName == szName)
+    {
+      EZ_ASSERT_DEV(entry.m_uiType == uiType, "Metric '{0}' was already registered with a different type", szName);
+
+      ++entry.m_uiRefCount;
+      out_uiIndex = i;
+      return &entry.m_Values;
+    }
+  }
+
+  if (s_FreeMetricIndices.IsEmpty())
+  {
+    out_uiIndex = s_Metrics.GetCount();
+    s_Metrics.ExpandAndGetRef();
+  }
+  else
+  {
+    out_uiIndex = s_FreeMetricIndices.PeekBack();
+    s_FreeMetricIndices.PopBack();
+  }
+
+  MetricEntry& entry = s_Metrics[out_uiIndex];
+  entry.m_sName = szName;
+  entry.m_uiType = uiType;
+  entry.m_uiRefCount = 1;
+
+  ezInternal::ezMetricValues& values = entry.m_Values;
+  values.m_iValue = 0;
+
+  if (uiType == MetricType::Histogram)
+  {
+    EZ_ASSERT_DEV(!bucketUpperBounds.IsEmpty(), "Histogram '{0}' needs at least one bucket upper bound", szName);
+
+    values.m_uiNumBuckets = bucketUpperBounds.GetCount() + 1;
+
+    ezStringBuilder sStatName;
+    sStatName.Format("{0}/Count", szName);
+    entry.m_StatNames.PushBack(sStatName);
+
+    for (ezUInt32 i = 0; i < values.m_uiNumBuckets; ++i)
+    {
+      values.m_BucketCounts[i] = 0;
+      entry.m_PreviousBucketCounts[i] = 0;
+
+      if (i < bucketUpperBounds.GetCount())
+      {
+        EZ_ASSERT_DEV(i == 0 || bucketUpperBounds[i - 1] < bucketUpperBounds[i], "The bucket upper bounds of histogram '{0}' are not sorted", szName);
+
+        values.m_BucketUpperBounds[i] = bucketUpperBounds[i];
+        sStatName.Format("{0}/Buckets/<= {1}", szName, bucketUpperBounds[i]);
+      }
+      else
+      {
+        sStatName.Format("{0}/Buckets/> {1}", szName, bucketUpperBounds[i - 1]);
+      }
+
+      entry.m_StatNames.PushBack(sStatName);
+    }
+
+    sStatName.Format("{0}/P50", szName);
+    entry.m_StatNames.PushBack(sStatName);
+    sStatName.Format("{0}/P90", szName);
+    entry.m_StatNames.PushBack(sStatName);
+    sStatName.Format("{0}/P99", szName);
+    entry.m_StatNames.PushBack(sStatName);
+  }
+  else
+  {
+    values.m_uiNumBuckets = 0;
+    entry.m_StatNames.PushBack(szName);
+  }
+
+  entry.m_PublishedValues.SetCount(entry.m_StatNames.GetCount());
+
+  return &values;
+}
+
+void ezMetrics::Unregister(ezUInt32 uiIndex)
+{
+  EZ_LOCK(s_MetricsMutex);
+
+  MetricEntry& entry = s_Metrics[uiIndex];
+  EZ_ASSERT_DEV(entry.m_uiRefCount > 0, "Metric was unregistered too often");
+
+  if (--entry.m_uiRefCount > 0)
+    return;
+
+  for (ezUInt32 i = 0; i < entry.m_StatNames.GetCount(); ++i)
+  {
+    if (entry.m_PublishedValues[i].IsValid())
+    {
+      ezStats::RemoveStat(entry.m_StatNames[i]);
+    }
+  }
+
+  entry.m_sName.Clear();
+  entry.m_StatNames.Clear();
+  entry.m_PublishedValues.Clear();
+
+  s_FreeMetricIndices.PushBack(uiIndex);
+}
+
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Utilities_Implementation_Metrics);
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Threading/AtomicUtils.h>
+#include <Foundation/Types/ArrayPtr.h>
+
+namespace ezInternal
+{
+  /// \brief The values of a registered metric. These are the only parts of a metric that are touched when it is updated.
+  struct ezMetricValues
+  {
+    enum
+    {
+      MAX_HISTOGRAM_BUCKETS = 16
+    };
+
+    ezInt64 m_iValue = 0;
+    ezUInt32 m_uiNumBuckets = 0;
+    double m_BucketUpperBounds[MAX_HISTOGRAM_BUCKETS - 1];
+    ezInt64 m_BucketCounts[MAX_HISTOGRAM_BUCKETS];
+  };
+} // namespace ezInternal
+
+/// \brief Handle to a counter, which only ever goes up, e.g. the number of spawned objects. See ezMetrics::RegisterCounter().
+///
+/// An invalid handle can be used as well, updating it does nothing.
+class ezMetricCounter
+{
+public:
+  EZ_ALWAYS_INLINE void Increment() { Add(1); }
+
+  EZ_ALWAYS_INLINE void Add(ezInt64 iValue)
+  {
+    if (m_pValues != nullptr)
+      ezAtomicUtils::Add(m_pValues->m_iValue, iValue);
+  }
+
+  EZ_ALWAYS_INLINE bool IsValid() const { return m_pValues != nullptr; }
+
+private:
+  friend class ezMetrics;
+
+  ezInternal::ezMetricValues* m_pValues = nullptr;
+  ezUInt32 m_uiIndex = 0;
+};
+
+/// \brief Handle to a gauge, which holds a current value, e.g. the number of alive objects. See ezMetrics::RegisterGauge().
+///
+/// An invalid handle can be used as well, updating it does nothing.
+class ezMetricGauge
+{
+public:
+  EZ_ALWAYS_INLINE void Set(ezInt64 iValue)
+  {
+    if (m_pValues != nullptr)
+      ezAtomicUtils::Set(m_pValues->m_iValue, iValue);
+  }
+
+  EZ_ALWAYS_INLINE void Add(ezInt64 iValue)
+  {
+    if (m_pValues != nullptr)
+      ezAtomicUtils::Add(m_pValues->m_iValue, iValue);
+  }
+
+  EZ_ALWAYS_INLINE bool IsValid() const { return m_pValues != nullptr; }
+
+private:
+  friend class ezMetrics;
+
+  ezInternal::ezMetricValues* m_pValues = nullptr;
+  ezUInt32 m_uiIndex = 0;
+};
+
+/// \brief Handle to a histogram, which counts how many recorded values fall into each of a fixed set of buckets, e.g. the duration of
+/// an operation. See ezMetrics::RegisterHistogram().
+///
+/// An invalid handle can be used as well, updating it does nothing.
+class ezMetricHistogram
+{
+public:
+  EZ_ALWAYS_INLINE void Record(double fValue)
+  {
+    if (m_pValues == nullptr)
+      return;
+
+    // the last bucket takes all values that are larger than the largest upper bound
+    ezUInt32 uiBucket = 0;
+    while (uiBucket + 1 < m_pValues->m_uiNumBuckets && fValue > m_pValues->m_BucketUpperBounds[uiBucket])
+    {
+      ++uiBucket;
+    }
+
+    ezAtomicUtils::Increment(m_pValues->m_BucketCounts[uiBucket]);
+  }
+
+  EZ_ALWAYS_INLINE bool IsValid() const { return m_pValues != nullptr; }
+
+private:
+  friend class ezMetrics;
+
+  ezInternal::ezMetricValues* m_pValues = nullptr;
+  ezUInt32 m_uiIndex = 0;
+};
+
+/// \brief Registered metrics, which can be updated from any thread without taking a lock, formatting a string or looking anything up.
+///
+/// A metric is registered once under a name and then updated through the returned handle, which only does a single atomic operation.
+/// Once per frame ezMetrics::UpdateStats() publishes the current values of all metrics through ezStats, which also makes them show up in
+/// ezInspector. Only values that have changed are passed on to ezStats.
+///
+/// Counters and gauges are published under their name. Histograms are published as a group with the name of the histogram, which contains
+/// the number of values recorded since the previous update, the number of values per bucket and the upper bounds of the buckets
+/// that contain the 50th, 90th and 99th percentile.
+///
+/// Registering a metric with a name that is already in use returns a handle to the same metric. A metric is removed from ezStats, once
+/// all handles to it have been unregistered.
+class EZ_FOUNDATION_DLL ezMetrics
+{
+public:
+  /// \brief Registers a counter. See ezStats::SetStat() for the format of the name.
+  static ezMetricCounter RegisterCounter(const char* szName);
+
+  /// \brief Registers a gauge. See ezStats::SetStat() for the format of the name.
+  static ezMetricGauge RegisterGauge(const char* szName);
+
+  /// \brief Registers a histogram with the given bucket upper bounds, which must be sorted in ascending order.
+  ///
+  /// A value belongs to the first bucket whose upper bound is larger or equal. An additional bucket takes all values that are larger than
+  /// the last upper bound. At most ezInternal::ezMetricValues::MAX_HISTOGRAM_BUCKETS - 1 upper bounds are supported.
+  static ezMetricHistogram RegisterHistogram(const char* szName, ezArrayPtr<const double> bucketUpperBounds);
+
+  /// \brief Unregisters the metric and invalidates the handle.
+  static void Unregister(ezMetricCounter& counter);
+
+  /// \brief Unregisters the metric and invalidates the handle.
+  static void Unregister(ezMetricGauge& gauge);
+
+  /// \brief Unregisters the metric and invalidates the handle.
+  static void Unregister(ezMetricHistogram& histogram);
+
+  /// \brief Publishes the values of all metrics through ezStats. Typically called once per frame, e.g. by ezGameApplicationBase.
+  static void UpdateStats();
+
+private:
+  static ezInternal::ezMetricValues* Register(const char* szName, ezUInt32 uiType, ezArrayPtr<const double> bucketUpperBounds, ezUInt32& out_uiIndex);
+  static void Unregister(ezUInt32 uiIndex);
+};
@@ -66,6 +66,7 @@ EZ_STATICLINK_LIBRARY(GameEngine)
   EZ_STATICLINK_REFERENCE(GameEngine_Physics_Implementation_CollisionFilter);
   EZ_STATICLINK_REFERENCE(GameEngine_Physics_Implementation_SurfaceResource);
   EZ_STATICLINK_REFERENCE(GameEngine_Physics_Implementation_SurfaceResourceDescriptor);
+  EZ_STATICLINK_REFERENCE(GameEngine_Prefabs_Implementation_PrefabPoolWorldModule);
   EZ_STATICLINK_REFERENCE(GameEngine_Prefabs_Implementation_PrefabReferenceComponent);
   EZ_STATICLINK_REFERENCE(GameEngine_Prefabs_Implementation_PrefabResource);
   EZ_STATICLINK_REFERENCE(GameEngine_Prefabs_Implementation_SpawnComponent);
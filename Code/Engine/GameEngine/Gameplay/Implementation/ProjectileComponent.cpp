@@ -7,6 +7,7 @@
 #include <GameEngine/Gameplay/ProjectileComponent.h>
 #include <GameEngine/Interfaces/PhysicsWorldModule.h>
 #include <GameEngine/Messages/DamageMessage.h>
+#include <GameEngine/Prefabs/PrefabPoolWorldModule.h>
 #include <GameEngine/Prefabs/PrefabResource.h>
 
 // clang-format off
@@ -102,7 +103,7 @@ void ezProjectileComponent::Update()
     ezVec3 vNewPosition;
 
     // gravity
-    if (m_fGravityMultiplier != 0.0f && m_fMetersPerSecond > 0.0f) // mps == 0 for attached state
+    if (m_fGravityMultiplier != 0.0f && !m_bAttached)
     {
       const ezVec3 vGravity = pPhysicsInterface->GetGravity() * m_fGravityMultiplier;
 
@@ -124,7 +125,7 @@ void ezProjectileComponent::Update()
 
       if (iInteraction == -1)
       {
-        GetWorld()->DeleteObjectDelayed(GetOwner()->GetHandle());
+        ezPrefabPoolWorldModule::RecycleOrDeleteObjectDelayed(GetWorld(), GetOwner()->GetHandle());
         vNewPosition = castResult.m_vPosition;
       }
       else
@@ -177,7 +178,7 @@ void ezProjectileComponent::Update()
 
         if (interaction.m_Reaction == ezProjectileReaction::Absorb)
         {
-          GetWorld()->DeleteObjectDelayed(GetOwner()->GetHandle());
+          ezPrefabPoolWorldModule::RecycleOrDeleteObjectDelayed(GetWorld(), GetOwner()->GetHandle());
           vNewPosition = castResult.m_vPosition;
         }
         else if (interaction.m_Reaction == ezProjectileReaction::Reflect)
@@ -200,7 +201,7 @@ void ezProjectileComponent::Update()
         }
         else if (interaction.m_Reaction == ezProjectileReaction::Attach)
         {
-          m_fMetersPerSecond = 0.0f;
+          m_bAttached = true;
           vNewPosition = castResult.m_vPosition;
 
           ezGameObject* pObject;
@@ -340,6 +341,7 @@ void ezProjectileComponent::OnSimulationStarted()
     msg.m_uiUsageStringHash = ezTempHashedString::ComputeHash("Suicide");
 
     PostMessage(msg, m_MaxLifetime);
+    m_TimeOfDeath = GetWorld()->GetClock().GetAccumulatedTime() + m_MaxLifetime;
 
     // make sure the prefab is available when the projectile dies
     if (m_hTimeoutPrefab.IsValid())
@@ -348,6 +350,8 @@ void ezProjectileComponent::OnSimulationStarted()
     }
   }
 
+  // this is called again when a pooled instance is reused
+  m_bAttached = false;
   m_vVelocity = GetOwner()->GetGlobalDirForwards() * m_fMetersPerSecond;
 }
 
@@ -356,6 +360,10 @@ void ezProjectileComponent::OnTriggered(ezMsgComponentInternalTrigger& msg)
   if (msg.m_uiUsageStringHash != ezTempHashedString::ComputeHash("Suicide"))
     return;
 
+  // the object was recycled through a prefab pool and restarted in the meantime
+  if (GetWorld()->GetClock().GetAccumulatedTime() < m_TimeOfDeath)
+    return;
+
   if (m_hTimeoutPrefab.IsValid())
   {
     ezResourceLock<ezPrefabResource> pPrefab(m_hTimeoutPrefab, ezResourceAcquireMode::AllowLoadingFallback);
@@ -364,7 +372,7 @@ void ezProjectileComponent::OnTriggered(ezMsgComponentInternalTrigger& msg)
       *GetWorld(), GetOwner()->GetGlobalTransform(), ezGameObjectHandle(), nullptr, &GetOwner()->GetTeamID(), nullptr, false);
   }
 
-  GetWorld()->DeleteObjectDelayed(GetOwner()->GetHandle());
+  ezPrefabPoolWorldModule::RecycleOrDeleteObjectDelayed(GetWorld(), GetOwner()->GetHandle());
 }
 
 
@@ -6,6 +6,7 @@
 #include <Core/WorldSerializer/WorldWriter.h>
 #include <Foundation/Serialization/AbstractObjectGraph.h>
 #include <GameEngine/Gameplay/TimedDeathComponent.h>
+#include <GameEngine/Prefabs/PrefabPoolWorldModule.h>
 #include <GameEngine/Prefabs/PrefabResource.h>
 
 // clang-format off
@@ -68,6 +69,7 @@ void ezTimedDeathComponent::OnSimulationStarted()
     ezTime::Seconds(pWorld->GetRandomNumberGenerator().DoubleInRange(m_MinDelay.GetSeconds(), m_DelayRange.GetSeconds()));
 
   PostMessage(msg, tKill);
+  m_TimeOfDeath = pWorld->GetClock().GetAccumulatedTime() + tKill;
 
   // make sure the prefab is available when the component dies
   if (m_hTimeoutPrefab.IsValid())
@@ -81,6 +83,10 @@ void ezTimedDeathComponent::OnTriggered(ezMsgComponentInternalTrigger& msg)
   if (msg.m_uiUsageStringHash != ezTempHashedString::ComputeHash("Suicide"))
     return;
 
+  // the object was recycled through a prefab pool and restarted in the meantime
+  if (GetWorld()->GetClock().GetAccumulatedTime() < m_TimeOfDeath)
+    return;
+
   if (m_hTimeoutPrefab.IsValid())
   {
     ezResourceLock<ezPrefabResource> pPrefab(m_hTimeoutPrefab, ezResourceAcquireMode::AllowLoadingFallback);
@@ -89,7 +95,7 @@ void ezTimedDeathComponent::OnTriggered(ezMsgComponentInternalTrigger& msg)
       *GetWorld(), GetOwner()->GetGlobalTransform(), ezGameObjectHandle(), nullptr, &GetOwner()->GetTeamID(), nullptr, false);
   }
 
-  GetWorld()->DeleteObjectDelayed(GetOwner()->GetHandle());
+  ezPrefabPoolWorldModule::RecycleOrDeleteObjectDelayed(GetWorld(), GetOwner()->GetHandle());
 }
 
 void ezTimedDeathComponent::SetTimeoutPrefab(const char* szPrefab)
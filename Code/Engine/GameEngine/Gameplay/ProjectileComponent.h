@@ -99,4 +99,6 @@ private:
     const ezVec3& vNormal, const ezVec3& vDirection, const char* szInteraction);
 
   ezVec3 m_vVelocity;
+  bool m_bAttached = false;
+  ezTime m_TimeOfDeath; ///< Used to ignore timeouts from a previous life of a pooled instance
 };
@@ -48,4 +48,5 @@ protected:
   void OnTriggered(ezMsgComponentInternalTrigger& msg);
 
   ezPrefabResourceHandle m_hTimeoutPrefab; ///< Spawned when the component is killed due to the timeout
+  ezTime m_TimeOfDeath;                    ///< Used to ignore timeouts from a previous life of a pooled instance
 };
@@ -0,0 +1,291 @@
+#include <GameEnginePCH.h>
+
+#include <GameEngine/Prefabs/PrefabPoolWorldModule.h>
+
+// clang-format off
+EZ_IMPLEMENT_MESSAGE_TYPE(ezMsgPrefabInstanceReset);
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezMsgPrefabInstanceReset, 1, ezRTTIDefaultAllocator<ezMsgPrefabInstanceReset>)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+EZ_IMPLEMENT_WORLD_MODULE(ezPrefabPoolWorldModule);
+
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezPrefabPoolWorldModule, 1, ezRTTINoAllocator)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+ezPrefabPoolWorldModule::ezPrefabPoolWorldModule(ezWorld* pWorld)
+  : ezWorldModule(pWorld)
+{
+}
+
+ezPrefabPoolWorldModule::~ezPrefabPoolWorldModule() = default;
+
+void ezPrefabPoolWorldModule::Initialize()
+{
+  auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezPrefabPoolWorldModule::ReturnQueuedInstances, this);
+  desc.m_Phase = ezWorldModule::UpdateFunctionDesc::Phase::PostTransform;
+
+  RegisterUpdateFunction(desc);
+}
+
+void ezPrefabPoolWorldModule::WorldClear()
+{
+  // all pooled objects are deleted together with the rest of the world
+  m_Pools.Clear();
+  m_PrefabToPool.Clear();
+  m_Instances.Clear();
+  m_ReturnQueue.Clear();
+  m_uiInstanceCountForNextPurge = 64;
+}
+
+void ezPrefabPoolWorldModule::SetPoolSize(const ezPrefabResourceHandle& hPrefab, ezUInt32 uiMaxPooledInstances)
+{
+  ezUInt32 uiPool = ezInvalidIndex;
+  if (!m_PrefabToPool.TryGetValue(hPrefab, uiPool))
+  {
+    if (uiMaxPooledInstances == 0)
+      return;
+
+    uiPool = m_Pools.GetCount();
+    m_Pools.ExpandAndGetRef().m_hPrefab = hPrefab;
+    m_PrefabToPool.Insert(hPrefab, uiPool);
+  }
+
+  Pool& pool = m_Pools[uiPool];
+  pool.m_uiMaxPooledInstances = uiMaxPooledInstances;
+
+  while (pool.m_FreeInstances.GetCount() > uiMaxPooledInstances)
+  {
+    DeleteInstance(pool.m_FreeInstances.PeekBack());
+    pool.m_FreeInstances.PopBack();
+  }
+
+  // reserve everything up front, so that spawning and recycling does not need to allocate anymore once the pool is warm
+  pool.m_FreeInstances.Reserve(uiMaxPooledInstances);
+  m_Instances.Reserve(m_Instances.GetCount() + uiMaxPooledInstances);
+  m_ReturnQueue.Reserve(m_ReturnQueue.GetCount() + uiMaxPooledInstances);
+}
+
+ezUInt32 ezPrefabPoolWorldModule::GetPoolSize(const ezPrefabResourceHandle& hPrefab) const
+{
+  ezUInt32 uiPool = ezInvalidIndex;
+  if (!m_PrefabToPool.TryGetValue(hPrefab, uiPool))
+    return 0;
+
+  return m_Pools[uiPool].m_uiMaxPooledInstances;
+}
+
+ezPrefabPoolWorldModule::Stats ezPrefabPoolWorldModule::GetStats(const ezPrefabResourceHandle& hPrefab) const
+{
+  ezUInt32 uiPool = ezInvalidIndex;
+  if (!m_PrefabToPool.TryGetValue(hPrefab, uiPool))
+    return Stats();
+
+  Stats stats = m_Pools[uiPool].m_Stats;
+  stats.m_uiPooled = m_Pools[uiPool].m_FreeInstances.GetCount();
+  return stats;
+}
+
+ezGameObjectHandle ezPrefabPoolWorldModule::InstantiatePrefab(
+  const ezPrefabResourceHandle& hPrefab, const ezTransform& rootTransform, const ezGameObjectHandle& hParent, const ezUInt16* pOverrideTeamID)
+{
+  ezUInt32 uiPool = ezInvalidIndex;
+  if (m_PrefabToPool.TryGetValue(hPrefab, uiPool) && m_Pools[uiPool].m_uiMaxPooledInstances == 0)
+  {
+    uiPool = ezInvalidIndex;
+  }
+
+  if (uiPool != ezInvalidIndex)
+  {
+    Pool& pool = m_Pools[uiPool];
+
+    while (!pool.m_FreeInstances.IsEmpty())
+    {
+      const ezGameObjectHandle hObject = pool.m_FreeInstances.PeekBack();
+      pool.m_FreeInstances.PopBack();
+
+      ezGameObject* pObject = nullptr;
+      if (!GetWorld()->TryGetObject(hObject, pObject))
+      {
+        // the instance was deleted by someone else while it was waiting in the pool
+        m_Instances.Remove(hObject);
+        continue;
+      }
+
+      Instance* pInstance = nullptr;
+      m_Instances.TryGetValue(hObject, pInstance);
+      pInstance->m_bInPool = false;
+
+      ezTransform tLocal;
+      tLocal.SetGlobalTransform(rootTransform, pInstance->m_RootOffset);
+
+      // the transform and team have to be in place before the components start simulating again
+      if (!hParent.IsInvalidated())
+      {
+        pObject->SetParent(hParent, ezGameObject::TransformPreservation::PreserveLocal);
+      }
+
+      pObject->SetLocalPosition(tLocal.m_vPosition);
+      pObject->SetLocalRotation(tLocal.m_qRotation);
+      pObject->SetLocalScaling(tLocal.m_vScale);
+      pObject->SetLocalUniformScaling(1.0f);
+
+      if (pOverrideTeamID != nullptr)
+      {
+        pObject->SetTeamID(*pOverrideTeamID);
+      }
+
+      pObject->SetActiveFlag(true);
+
+      ezMsgPrefabInstanceReset msg;
+      pObject->SendMessageRecursive(msg);
+
+      ++pool.m_Stats.m_uiHits;
+      return hObject;
+    }
+
+    ++pool.m_Stats.m_uiMisses;
+  }
+
+  ezHybridArray<ezGameObject*, 8> createdRootObjects;
+
+  {
+    ezResourceLock<ezPrefabResource> pResource(hPrefab, ezResourceAcquireMode::AllowLoadingFallback);
+
+    // pooled instances are moved around when they are reused, so they must not be static
+    pResource->InstantiatePrefab(*GetWorld(), rootTransform, hParent, &createdRootObjects, pOverrideTeamID, nullptr, uiPool != ezInvalidIndex);
+  }
+
+  if (createdRootObjects.IsEmpty())
+    return ezGameObjectHandle();
+
+  if (uiPool != ezInvalidIndex)
+  {
+    if (createdRootObjects.GetCount() == 1)
+    {
+      // the pool is not informed when an instance is deleted without going through RecycleOrDeleteObjectDelayed(), new instances are
+      // only added here, so this is the place to clean up
+      if (m_Instances.GetCount() >= m_uiInstanceCountForNextPurge)
+      {
+        PurgeDeletedInstances();
+      }
+
+      Instance& instance = m_Instances[createdRootObjects[0]->GetHandle()];
+      instance.m_uiPool = uiPool;
+      instance.m_RootOffset.SetLocalTransform(rootTransform, createdRootObjects[0]->GetLocalTransform());
+    }
+    else
+    {
+      ezLog::Warning("Prefab '{0}' has {1} root objects and cannot be pooled. Pooling is disabled for it.", hPrefab.GetResourceID(),
+        createdRootObjects.GetCount());
+
+      m_Pools[uiPool].m_uiMaxPooledInstances = 0;
+    }
+  }
+
+  return createdRootObjects[0]->GetHandle();
+}
+
+void ezPrefabPoolWorldModule::RecycleOrDeleteObjectDelayed(const ezGameObjectHandle& hObject)
+{
+  Instance* pInstance = nullptr;
+  if (!m_Instances.TryGetValue(hObject, pInstance))
+  {
+    GetWorld()->DeleteObjectDelayed(hObject);
+    return;
+  }
+
+  if (pInstance->m_bInPool || pInstance->m_bReturnQueued)
+    return;
+
+  pInstance->m_bReturnQueued = true;
+  m_ReturnQueue.PushBack(hObject);
+}
+
+// static
+void ezPrefabPoolWorldModule::RecycleOrDeleteObjectDelayed(ezWorld* pWorld, const ezGameObjectHandle& hObject)
+{
+  if (ezPrefabPoolWorldModule* pPool = pWorld->GetModule<ezPrefabPoolWorldModule>())
+  {
+    pPool->RecycleOrDeleteObjectDelayed(hObject);
+  }
+  else
+  {
+    pWorld->DeleteObjectDelayed(hObject);
+  }
+}
+
+void ezPrefabPoolWorldModule::ReturnQueuedInstances(const ezWorldModule::UpdateContext& context)
+{
+  for (const ezGameObjectHandle& hObject : m_ReturnQueue)
+  {
+    Instance* pInstance = nullptr;
+    if (!m_Instances.TryGetValue(hObject, pInstance))
+      continue;
+
+    pInstance->m_bReturnQueued = false;
+
+    ezGameObject* pObject = nullptr;
+    if (!GetWorld()->TryGetObject(hObject, pObject))
+    {
+      m_Instances.Remove(hObject);
+      continue;
+    }
+
+    Pool& pool = m_Pools[pInstance->m_uiPool];
+
+    if (pool.m_FreeInstances.GetCount() >= pool.m_uiMaxPooledInstances)
+    {
+      ++pool.m_Stats.m_uiDiscarded;
+      DeleteInstance(hObject);
+      continue;
+    }
+
+    pObject->SetActiveFlag(false);
+
+    // detach the instance from whatever it was attached to, so that it isn't deleted together with its parent
+    pObject->SetParent(ezGameObjectHandle(), ezGameObject::TransformPreservation::PreserveGlobal);
+
+    pInstance->m_bInPool = true;
+    pool.m_FreeInstances.PushBack(hObject);
+
+    ++pool.m_Stats.m_uiRecycled;
+  }
+
+  m_ReturnQueue.Clear();
+}
+
+void ezPrefabPoolWorldModule::DeleteInstance(const ezGameObjectHandle& hObject)
+{
+  m_Instances.Remove(hObject);
+  GetWorld()->DeleteObjectDelayed(hObject);
+}
+
+void ezPrefabPoolWorldModule::PurgeDeletedInstances()
+{
+  ezGameObject* pObject = nullptr;
+
+  for (auto it = m_Instances.GetIterator(); it.IsValid();)
+  {
+    if (GetWorld()->TryGetObject(it.Key(), pObject))
+      ++it;
+    else
+      it = m_Instances.Remove(it);
+  }
+
+  for (Pool& pool : m_Pools)
+  {
+    for (ezUInt32 i = pool.m_FreeInstances.GetCount(); i > 0; --i)
+    {
+      if (!GetWorld()->TryGetObject(pool.m_FreeInstances[i - 1], pObject))
+      {
+        pool.m_FreeInstances.RemoveAtAndCopy(i - 1);
+      }
+    }
+  }
+
+  // only purge again once the number of instances has doubled, so that the cost is amortized over the instantiations
+  m_uiInstanceCountForNextPurge = ezMath::Max(2 * m_Instances.GetCount(), 64u);
+}
+
+EZ_STATICLINK_FILE(GameEngine, GameEngine_Prefabs_Implementation_PrefabPoolWorldModule);
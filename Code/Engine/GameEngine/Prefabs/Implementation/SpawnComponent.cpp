@@ -3,12 +3,13 @@
 #include <Core/Messages/TriggerMessage.h>
 #include <Core/WorldSerializer/WorldWriter.h>
 #include <Foundation/Serialization/AbstractObjectGraph.h>
+#include <GameEngine/Prefabs/PrefabPoolWorldModule.h>
 #include <GameEngine/Prefabs/SpawnComponent.h>
 
 //////////////////////////////////////////////////////////////////////////
 
 // clang-format off
-EZ_BEGIN_COMPONENT_TYPE(ezSpawnComponent, 2, ezComponentMode::Static)
+EZ_BEGIN_COMPONENT_TYPE(ezSpawnComponent, 3, ezComponentMode::Static)
 {
   EZ_BEGIN_PROPERTIES
   {
@@ -19,6 +20,7 @@ EZ_BEGIN_COMPONENT_TYPE(ezSpawnComponent, 2, ezComponentMode::Static)
     EZ_MEMBER_PROPERTY("MinDelay", m_MinDelay)->AddAttributes(new ezClampValueAttribute(ezTime(), ezVariant()), new ezDefaultValueAttribute(ezTime::Seconds(1.0))),
     EZ_MEMBER_PROPERTY("DelayRange", m_DelayRange)->AddAttributes(new ezClampValueAttribute(ezTime(), ezVariant())),
     EZ_MEMBER_PROPERTY("Deviation", m_MaxDeviation)->AddAttributes(new ezClampValueAttribute(ezAngle(), ezAngle::Degree(179.0))),
+    EZ_MEMBER_PROPERTY("PoolSize", m_uiPoolSize),
   }
   EZ_END_PROPERTIES;
   EZ_BEGIN_ATTRIBUTES
@@ -50,6 +52,8 @@ ezSpawnComponent::~ezSpawnComponent() = default;
 
 void ezSpawnComponent::OnSimulationStarted()
 {
+  SetupPool();
+
   if (m_SpawnFlags.IsAnySet(ezSpawnComponentFlags::SpawnAtStart))
   {
     m_SpawnFlags.Remove(ezSpawnComponentFlags::SpawnAtStart);
@@ -94,8 +98,36 @@ bool ezSpawnComponent::SpawnOnce(const ezVec3& vLocalOffset)
 }
 
 
+void ezSpawnComponent::SetupPool()
+{
+  if (m_uiPoolSize == 0 || !m_hPrefab.IsValid())
+    return;
+
+  ezPrefabPoolWorldModule* pPool = GetWorld()->GetOrCreateModule<ezPrefabPoolWorldModule>();
+
+  // several spawners may share the same prefab, the largest pool wins
+  pPool->SetPoolSize(m_hPrefab, ezMath::Max<ezUInt32>(pPool->GetPoolSize(m_hPrefab), m_uiPoolSize));
+}
+
 void ezSpawnComponent::DoSpawn(const ezTransform& tLocalSpawn)
 {
+  if (ezPrefabPoolWorldModule* pPool = GetWorld()->GetModule<ezPrefabPoolWorldModule>())
+  {
+    if (m_SpawnFlags.IsAnySet(ezSpawnComponentFlags::AttachAsChild))
+    {
+      pPool->InstantiatePrefab(m_hPrefab, tLocalSpawn, GetOwner()->GetHandle(), &GetOwner()->GetTeamID());
+    }
+    else
+    {
+      ezTransform tGlobalSpawn;
+      tGlobalSpawn.SetGlobalTransform(GetOwner()->GetGlobalTransform(), tLocalSpawn);
+
+      pPool->InstantiatePrefab(m_hPrefab, tGlobalSpawn, ezGameObjectHandle(), &GetOwner()->GetTeamID());
+    }
+
+    return;
+  }
+
   ezResourceLock<ezPrefabResource> pResource(m_hPrefab, ezResourceAcquireMode::AllowLoadingFallback);
 
   if (m_SpawnFlags.IsAnySet(ezSpawnComponentFlags::AttachAsChild))
@@ -140,12 +172,15 @@ void ezSpawnComponent::SerializeComponent(ezWorldWriter& stream) const
   s << m_DelayRange;
   s << m_MaxDeviation;
   s << m_LastManualSpawn;
+
+  // Version 3
+  s << m_uiPoolSize;
 }
 
 void ezSpawnComponent::DeserializeComponent(ezWorldReader& stream)
 {
   SUPER::DeserializeComponent(stream);
-  // const ezUInt32 uiVersion = stream.GetComponentTypeVersion(GetStaticRTTI());
+  const ezUInt32 uiVersion = stream.GetComponentTypeVersion(GetStaticRTTI());
 
   auto& s = stream.GetStream();
 
@@ -159,6 +194,11 @@ void ezSpawnComponent::DeserializeComponent(ezWorldReader& stream)
   s >> m_DelayRange;
   s >> m_MaxDeviation;
   s >> m_LastManualSpawn;
+
+  if (uiVersion >= 3)
+  {
+    s >> m_uiPoolSize;
+  }
 }
 
 bool ezSpawnComponent::CanTriggerManualSpawn() const
@@ -232,6 +272,11 @@ void ezSpawnComponent::SetAttachAsChild(bool b)
 void ezSpawnComponent::SetPrefab(const ezPrefabResourceHandle& hPrefab)
 {
   m_hPrefab = hPrefab;
+
+  if (IsActiveAndSimulating())
+  {
+    SetupPool();
+  }
 }
 
 void ezSpawnComponent::OnTriggered(ezMsgComponentInternalTrigger& msg)
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <Core/World/World.h>
+#include <Core/World/WorldModule.h>
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/Containers/HashTable.h>
+#include <GameEngine/GameEngineDLL.h>
+#include <GameEngine/Prefabs/PrefabResource.h>
+
+/// \brief Sent recursively to a pooled prefab instance after it was taken out of the pool and activated again.
+///
+/// Reactivating an object already restarts the simulation of its components (OnSimulationStarted() is called again),
+/// so this message only needs to be handled by components that keep additional state, which would otherwise leak from the
+/// previous life of the instance into the next one.
+struct EZ_GAMEENGINE_DLL ezMsgPrefabInstanceReset : public ezMessage
+{
+  EZ_DECLARE_MESSAGE_TYPE(ezMsgPrefabInstanceReset, ezMessage);
+};
+
+/// \brief Keeps deactivated instances of frequently spawned prefabs around and hands them out again, instead of
+/// instantiating and deleting the full object hierarchy every time.
+///
+/// Pooling is opt-in per prefab: only prefabs for which SetPoolSize() was called with a non-zero size are pooled.
+/// Everything else is instantiated and deleted as usual, so code can always go through InstantiatePrefab() and
+/// RecycleOrDeleteObjectDelayed() without knowing whether a pool exists.
+///
+/// Only prefabs with a single root object can be pooled. Instances are returned to the pool at the end of the frame, similar to
+/// ezWorld::DeleteObjectDelayed(). Once a pool is warm, taking an instance from it and returning it does not allocate.
+class EZ_GAMEENGINE_DLL ezPrefabPoolWorldModule : public ezWorldModule
+{
+  EZ_DECLARE_WORLD_MODULE();
+  EZ_ADD_DYNAMIC_REFLECTION(ezPrefabPoolWorldModule, ezWorldModule);
+
+public:
+  ezPrefabPoolWorldModule(ezWorld* pWorld);
+  ~ezPrefabPoolWorldModule();
+
+  struct Stats
+  {
+    ezUInt32 m_uiHits = 0;      ///< How often an instance could be taken from the pool.
+    ezUInt32 m_uiMisses = 0;    ///< How often a new instance had to be created.
+    ezUInt32 m_uiRecycled = 0;  ///< How often an instance was returned to the pool.
+    ezUInt32 m_uiDiscarded = 0; ///< How often an instance was deleted, because the pool was already full.
+    ezUInt32 m_uiPooled = 0;    ///< How many instances are currently waiting in the pool.
+  };
+
+  /// \brief Enables pooling for the given prefab and sets how many deactivated instances are kept at most.
+  ///
+  /// A size of zero disables pooling for the prefab. Instances that exceed the new size are deleted.
+  void SetPoolSize(const ezPrefabResourceHandle& hPrefab, ezUInt32 uiMaxPooledInstances);
+
+  /// \brief Returns the maximum number of pooled instances for the given prefab, zero if it is not pooled.
+  ezUInt32 GetPoolSize(const ezPrefabResourceHandle& hPrefab) const;
+
+  /// \brief Returns the statistics for the given prefab. All values are zero, if the prefab is not pooled.
+  Stats GetStats(const ezPrefabResourceHandle& hPrefab) const;
+
+  /// \brief Takes an instance of the given prefab from the pool, or instantiates a new one, if the pool is empty or the prefab is
+  /// not pooled.
+  ///
+  /// Returns the handle of the root object of the instance. For prefabs that are not pooled and have multiple root objects, the
+  /// first one is returned.
+  ezGameObjectHandle InstantiatePrefab(const ezPrefabResourceHandle& hPrefab, const ezTransform& rootTransform,
+    const ezGameObjectHandle& hParent = ezGameObjectHandle(), const ezUInt16* pOverrideTeamID = nullptr);
+
+  /// \brief Returns the given object to its pool at the end of the frame. Objects that were not taken from a pool are deleted.
+  void RecycleOrDeleteObjectDelayed(const ezGameObjectHandle& hObject);
+
+  /// \brief Same as the member function, but falls back to ezWorld::DeleteObjectDelayed() if the world has no prefab pool.
+  static void RecycleOrDeleteObjectDelayed(ezWorld* pWorld, const ezGameObjectHandle& hObject);
+
+protected:
+  virtual void Initialize() override;
+  virtual void WorldClear() override;
+
+private:
+  struct Pool
+  {
+    ezPrefabResourceHandle m_hPrefab;
+    ezUInt32 m_uiMaxPooledInstances = 0;
+    ezDynamicArray<ezGameObjectHandle> m_FreeInstances;
+    Stats m_Stats;
+  };
+
+  struct Instance
+  {
+    ezUInt32 m_uiPool = 0;
+    bool m_bInPool = false;
+    bool m_bReturnQueued = false;
+    ezTransform m_RootOffset; ///< The local transform of the root object inside the prefab.
+  };
+
+  void ReturnQueuedInstances(const ezWorldModule::UpdateContext& context);
+  void DeleteInstance(const ezGameObjectHandle& hObject);
+  void PurgeDeletedInstances();
+
+  ezDeque<Pool> m_Pools;
+  ezHashTable<ezPrefabResourceHandle, ezUInt32> m_PrefabToPool;
+  ezHashTable<ezGameObjectHandle, Instance> m_Instances;
+  ezDynamicArray<ezGameObjectHandle> m_ReturnQueue;
+
+  /// \brief Instances that are deleted directly (e.g. together with their parent) are only removed from m_Instances once it has grown to
+  /// this size.
+  ezUInt32 m_uiInstanceCountForNextPurge = 64;
+};
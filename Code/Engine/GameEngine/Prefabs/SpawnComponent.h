@@ -95,12 +95,18 @@ public:
   /// The spawned object's orientation may deviate by this amount around the X axis. 180° is completely random orientation.
   ezAngle m_MaxDeviation; // [ property ]
 
+  /// If non-zero, spawned instances are recycled through the world's ezPrefabPoolWorldModule and up to this many deactivated instances
+  /// are kept around. The spawned objects must be removed through ezPrefabPoolWorldModule::RecycleOrDeleteObjectDelayed() for this
+  /// to have an effect.
+  ezUInt16 m_uiPoolSize = 0; // [ property ]
+
 
 protected:
   ezBitflags<ezSpawnComponentFlags> m_SpawnFlags;
 
   virtual void DoSpawn(const ezTransform& tLocalSpawn);
   bool SpawnOnce(const ezVec3& vLocalOffset);
+  void SetupPool();
   void OnTriggered(ezMsgComponentInternalTrigger& msg);
 
   ezTime m_LastManualSpawn;
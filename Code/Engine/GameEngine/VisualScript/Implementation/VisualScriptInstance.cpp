@@ -3,6 +3,7 @@
 #include <Core/Messages/EventMessage.h>
 #include <Core/World/Declarations.h>
 #include <Core/World/GameObject.h>
+#include <Core/World/World.h>
 #include <Foundation/Communication/Message.h>
 #include <Foundation/Reflection/ReflectionUtils.h>
 #include <Foundation/Strings/HashedString.h>
@@ -62,6 +63,48 @@ bool ezVisualScriptAssignComponent(const void* src, void* dst)
   return res;
 }
 
+namespace
+{
+  /// Places the nodes of one script instance consecutively in ezVisualScriptInstance::m_NodeData.
+  /// Everything that does not fit into the block comes from the default allocator.
+  class ezVisualScriptNodeAllocator : public ezAllocatorBase
+  {
+  public:
+    ezVisualScriptNodeAllocator(ezArrayPtr<ezUInt8> block)
+      : m_Block(block)
+    {
+    }
+
+    virtual void* Allocate(size_t uiSize, size_t uiAlign, ezMemoryUtils::DestructorFunction destructorFunc) override
+    {
+      const size_t uiOffset = ezMemoryUtils::AlignSize<size_t>(m_uiUsed, uiAlign);
+
+      if (uiAlign > ezVisualScriptResourceDescriptor::NodeDataAlignment || uiOffset + uiSize > m_Block.GetCount())
+        return ezFoundation::GetDefaultAllocator()->Allocate(uiSize, uiAlign, destructorFunc);
+
+      m_uiUsed = uiOffset + uiSize;
+      return m_Block.GetPtr() + uiOffset;
+    }
+
+    virtual void Deallocate(void* ptr) override
+    {
+      // the block itself is freed by the script instance
+      if (ptr < m_Block.GetPtr() || ptr >= m_Block.GetEndPtr())
+      {
+        ezFoundation::GetDefaultAllocator()->Deallocate(ptr);
+      }
+    }
+
+    virtual size_t AllocatedSize(const void* ptr) override { return 0; }
+    virtual ezAllocatorId GetId() const override { return ezAllocatorId(); }
+    virtual Stats GetStats() const override { return Stats(); }
+
+  private:
+    ezArrayPtr<ezUInt8> m_Block;
+    size_t m_uiUsed = 0;
+  };
+} // namespace
+
 ezVisualScriptInstance::ezVisualScriptInstance()
 {
   SetupPinDataTypeConversions();
@@ -93,49 +136,37 @@ ezVisualScriptInstance::~ezVisualScriptInstance()
 
 void ezVisualScriptInstance::Clear()
 {
+  ezVisualScriptNodeAllocator nodeAllocator(m_NodeData);
+
   for (ezUInt32 i = 0; i < m_Nodes.GetCount(); ++i)
   {
-    m_Nodes[i]->GetDynamicRTTI()->GetAllocator()->Deallocate(m_Nodes[i]);
+    m_Nodes[i]->GetDynamicRTTI()->GetAllocator()->Deallocate(m_Nodes[i], &nodeAllocator);
+  }
+
+  if (!m_NodeData.IsEmpty())
+  {
+    ezFoundation::GetAlignedAllocator()->Deallocate(m_NodeData.GetPtr());
+    m_NodeData.Clear();
   }
 
   m_pWorld = nullptr;
+  m_pDescriptor = nullptr;
+  m_uiResourceChangeCounter = 0;
   m_Nodes.Clear();
-  m_ExecutionConnections.Clear();
-  m_DataConnections.Clear();
+  m_DataTargetPins.Clear();
   m_LocalVariables.Clear();
   m_hScriptResource.Invalidate();
 }
 
 
-void ezVisualScriptInstance::ComputeNodeDependencies()
-{
-  m_NodeDependencies.SetCount(m_Nodes.GetCount());
-
-  for (auto it = m_DataConnections.GetIterator(); it.IsValid(); ++it)
-  {
-    const ezVisualScriptPinConnectionID src = it.Key();
-
-    const ezUInt16 uiSourceNode = (src >> 16) & 0xFFFF;
-
-    if (m_Nodes[uiSourceNode]->IsManuallyStepped())
-      continue;
-
-    const ezHybridArray<DataPinConnection, 2>& dst = it.Value();
-
-    for (const DataPinConnection& target : dst)
-    {
-      m_NodeDependencies[target.m_uiTargetNode].PushBack(uiSourceNode);
-    }
-  }
-}
-
-
 void ezVisualScriptInstance::ExecuteDependentNodes(ezUInt16 uiNode)
 {
-  const auto& dep = m_NodeDependencies[uiNode];
-  for (ezUInt32 i = 0; i < dep.GetCount(); ++i)
+  const auto& layout = m_pDescriptor->m_NodeLayouts[uiNode];
+  const ezUInt16* pDependencies = m_pDescriptor->m_NodeDependencies.GetData() + layout.m_uiFirstDependency;
+
+  for (ezUInt32 i = 0; i < layout.m_uiNumDependencies; ++i)
   {
-    const ezUInt16 uiDependency = dep[i];
+    const ezUInt16 uiDependency = pDependencies[i];
     auto* pNode = m_Nodes[uiDependency];
 
     // recurse to the most dependent nodes first
@@ -154,9 +185,9 @@ void ezVisualScriptInstance::Configure(const ezVisualScriptResourceHandle& hScri
 
   ezResourceLock<ezVisualScriptResource> pScript(hScript, ezResourceAcquireMode::BlockTillLoaded);
   const auto& resource = pScript->GetDescriptor();
-  m_pMessageHandlers = &resource.m_MessageHandlers;
 
   m_hScriptResource = hScript;
+  m_uiResourceChangeCounter = pScript->GetCurrentResourceChangeCounter();
 
   if (pOwner)
   {
@@ -166,28 +197,36 @@ void ezVisualScriptInstance::Configure(const ezVisualScriptResourceHandle& hScri
 
   m_Nodes.Reserve(resource.m_Nodes.GetCount());
 
+  if (resource.m_uiNodeDataSize > 0)
+  {
+    void* pNodeData = ezFoundation::GetAlignedAllocator()->Allocate(resource.m_uiNodeDataSize, ezVisualScriptResourceDescriptor::NodeDataAlignment);
+    m_NodeData = ezArrayPtr<ezUInt8>(static_cast<ezUInt8*>(pNodeData), resource.m_uiNodeDataSize);
+  }
+
+  ezVisualScriptNodeAllocator nodeAllocator(m_NodeData);
+
   for (ezUInt32 n = 0; n < resource.m_Nodes.GetCount(); ++n)
   {
     const auto& node = resource.m_Nodes[n];
 
     if (node.m_isFunctionCall)
     {
-      CreateFunctionCallNode(n, resource);
+      CreateFunctionCallNode(n, resource, &nodeAllocator);
     }
     else if (node.m_pType->IsDerivedFrom<ezMessage>())
     {
       if (node.m_isMsgSender)
       {
-        CreateFunctionMessageNode(n, resource);
+        CreateFunctionMessageNode(n, resource, &nodeAllocator);
       }
       else if (node.m_isMsgHandler)
       {
-        CreateEventMessageNode(n, resource);
+        CreateEventMessageNode(n, resource, &nodeAllocator);
       }
     }
     else if (node.m_pType->IsDerivedFrom<ezVisualScriptNode>())
     {
-      CreateVisualScriptNode(n, resource);
+      CreateVisualScriptNode(n, resource, &nodeAllocator);
     }
     else
     {
@@ -197,20 +236,16 @@ void ezVisualScriptInstance::Configure(const ezVisualScriptResourceHandle& hScri
     }
   }
 
-  m_ExecutionConnections.Reserve(resource.m_ExecutionPaths.GetCount());
+  // everything else about the connections is shared, only where the values end up is different for every instance
+  m_DataTargetPins.SetCountUninitialized(resource.m_DataTargets.GetCount());
 
-  for (const auto& con : resource.m_ExecutionPaths)
+  for (ezUInt32 i = 0; i < resource.m_DataTargets.GetCount(); ++i)
   {
-    ConnectExecutionPins(con.m_uiSourceNode, con.m_uiOutputPin, con.m_uiTargetNode, con.m_uiInputPin);
+    const auto& target = resource.m_DataTargets[i];
+    m_DataTargetPins[i] = m_Nodes[target.m_uiTargetNode]->GetInputPinDataPointer(target.m_uiTargetPin);
   }
 
-  for (const auto& con : resource.m_DataPaths)
-  {
-    ConnectDataPins(con.m_uiSourceNode, con.m_uiOutputPin, (ezVisualScriptDataPinType::Enum)con.m_uiOutputPinType, con.m_uiTargetNode,
-      con.m_uiInputPin, (ezVisualScriptDataPinType::Enum)con.m_uiInputPinType);
-  }
-
-  ComputeNodeDependencies();
+  m_pDescriptor = &resource;
 
   // initialize local variables
   {
@@ -227,13 +262,13 @@ void ezVisualScriptInstance::Configure(const ezVisualScriptResourceHandle& hScri
 }
 
 
-void ezVisualScriptInstance::CreateVisualScriptNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource)
+void ezVisualScriptInstance::CreateVisualScriptNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource, ezAllocatorBase* pAllocator)
 {
   EZ_ASSERT_DEBUG(uiNodeIdx < ezMath::MaxValue<ezUInt16>(), "Max supported node index is 16 bit.");
 
   const auto& node = resource.m_Nodes[uiNodeIdx];
 
-  ezVisualScriptNode* pNode = node.m_pType->GetAllocator()->Allocate<ezVisualScriptNode>();
+  ezVisualScriptNode* pNode = node.m_pType->GetAllocator()->Allocate<ezVisualScriptNode>(pAllocator);
   pNode->m_uiNodeID = static_cast<ezUInt16>(uiNodeIdx);
 
   // assign all property values
@@ -253,14 +288,14 @@ void ezVisualScriptInstance::CreateVisualScriptNode(ezUInt32 uiNodeIdx, const ez
   m_Nodes.PushBack(pNode);
 }
 
-void ezVisualScriptInstance::CreateFunctionMessageNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource)
+void ezVisualScriptInstance::CreateFunctionMessageNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource, ezAllocatorBase* pAllocator)
 {
   EZ_ASSERT_DEBUG(uiNodeIdx < ezMath::MaxValue<ezUInt16>(), "Max supported node index is 16 bit.");
 
   const auto& node = resource.m_Nodes[uiNodeIdx];
 
   ezVisualScriptNode_MessageSender* pNode =
-    ezGetStaticRTTI<ezVisualScriptNode_MessageSender>()->GetAllocator()->Allocate<ezVisualScriptNode_MessageSender>();
+    ezGetStaticRTTI<ezVisualScriptNode_MessageSender>()->GetAllocator()->Allocate<ezVisualScriptNode_MessageSender>(pAllocator);
   pNode->m_uiNodeID = static_cast<ezUInt16>(uiNodeIdx);
 
   pNode->m_pMessageToSend = node.m_pType->GetAllocator()->Allocate<ezMessage>();
@@ -299,13 +334,13 @@ void ezVisualScriptInstance::CreateFunctionMessageNode(ezUInt32 uiNodeIdx, const
 }
 
 
-void ezVisualScriptInstance::CreateEventMessageNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource)
+void ezVisualScriptInstance::CreateEventMessageNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource, ezAllocatorBase* pAllocator)
 {
   EZ_ASSERT_DEBUG(uiNodeIdx < ezMath::MaxValue<ezUInt16>(), "Max supported node index is 16 bit.");
 
   const auto& node = resource.m_Nodes[uiNodeIdx];
 
-  ezVisualScriptNode_GenericEvent* pNode = ezGetStaticRTTI<ezVisualScriptNode_GenericEvent>()->GetAllocator()->Allocate<ezVisualScriptNode_GenericEvent>();
+  ezVisualScriptNode_GenericEvent* pNode = ezGetStaticRTTI<ezVisualScriptNode_GenericEvent>()->GetAllocator()->Allocate<ezVisualScriptNode_GenericEvent>(pAllocator);
   pNode->m_uiNodeID = static_cast<ezUInt16>(uiNodeIdx);
 
   pNode->m_sEventType = node.m_sTypeName;
@@ -339,13 +374,13 @@ ezAbstractFunctionProperty* ezVisualScriptInstance::SearchForScriptableFunctionO
   return nullptr;
 }
 
-void ezVisualScriptInstance::CreateFunctionCallNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource)
+void ezVisualScriptInstance::CreateFunctionCallNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource, ezAllocatorBase* pAllocator)
 {
   EZ_ASSERT_DEBUG(uiNodeIdx < ezMath::MaxValue<ezUInt16>(), "Max supported node index is 16 bit.");
 
   const auto& node = resource.m_Nodes[uiNodeIdx];
 
-  ezVisualScriptNode_FunctionCall* pNode = ezGetStaticRTTI<ezVisualScriptNode_FunctionCall>()->GetAllocator()->Allocate<ezVisualScriptNode_FunctionCall>();
+  ezVisualScriptNode_FunctionCall* pNode = ezGetStaticRTTI<ezVisualScriptNode_FunctionCall>()->GetAllocator()->Allocate<ezVisualScriptNode_FunctionCall>(pAllocator);
   pNode->m_uiNodeID = static_cast<ezUInt16>(uiNodeIdx);
 
   pNode->m_pExpectedType = node.m_pType;
@@ -408,8 +443,33 @@ void ezVisualScriptInstance::CreateFunctionCallNode(ezUInt32 uiNodeIdx, const ez
   m_Nodes.PushBack(pNode);
 }
 
+void ezVisualScriptInstance::ReconfigureIfScriptChanged()
+{
+  if (m_pDescriptor == nullptr)
+    return;
+
+  {
+    ezResourceLock<ezVisualScriptResource> pScript(m_hScriptResource, ezResourceAcquireMode::PointerOnly);
+
+    if (pScript->GetCurrentResourceChangeCounter() == m_uiResourceChangeCounter)
+      return;
+  }
+
+  ezGameObject* pOwner = nullptr;
+  if (m_pWorld != nullptr)
+  {
+    m_pWorld->TryGetObject(m_hOwner, pOwner);
+  }
+
+  // the nodes and connections of this instance don't match the descriptor anymore
+  ezVisualScriptResourceHandle hScript = m_hScriptResource;
+  Configure(hScript, pOwner);
+}
+
 void ezVisualScriptInstance::ExecuteScript(ezVisualScriptInstanceActivity* pActivity /*= nullptr*/)
 {
+  ReconfigureIfScriptChanged();
+
   m_pActivity = pActivity;
 
   if (m_pActivity != nullptr)
@@ -436,16 +496,19 @@ void ezVisualScriptInstance::ExecuteScript(ezVisualScriptInstanceActivity* pActi
 
 bool ezVisualScriptInstance::HandleMessage(ezMessage& msg)
 {
-  if (m_pMessageHandlers == nullptr)
+  ReconfigureIfScriptChanged();
+
+  if (m_pDescriptor == nullptr)
     return false;
 
-  ezUInt32 uiFirstHandler = m_pMessageHandlers->LowerBound(msg.GetId());
+  const auto& messageHandlers = m_pDescriptor->m_MessageHandlers;
+  ezUInt32 uiFirstHandler = messageHandlers.LowerBound(msg.GetId());
 
   bool bHandled = false;
 
-  while (uiFirstHandler < m_pMessageHandlers->GetCount())
+  while (uiFirstHandler < messageHandlers.GetCount())
   {
-    const auto& data = (*m_pMessageHandlers).GetPair(uiFirstHandler);
+    const auto& data = messageHandlers.GetPair(uiFirstHandler);
     if (data.key != msg.GetId())
       break;
 
@@ -459,44 +522,34 @@ bool ezVisualScriptInstance::HandleMessage(ezMessage& msg)
   return bHandled;
 }
 
-void ezVisualScriptInstance::ConnectExecutionPins(ezUInt16 uiSourceNode, ezUInt8 uiOutputSlot, ezUInt16 uiTargetNode, ezUInt8 uiTargetPin)
+void ezVisualScriptInstance::SetOutputPinValue(const ezVisualScriptNode* pNode, ezUInt8 uiPin, const void* pValue)
 {
-  auto& con = m_ExecutionConnections[((ezUInt32)uiSourceNode << 16) | (ezUInt32)uiOutputSlot];
-  con.m_uiTargetNode = uiTargetNode;
-  con.m_uiTargetPin = uiTargetPin;
-}
+  const auto& layout = m_pDescriptor->m_NodeLayouts[pNode->m_uiNodeID];
 
-void ezVisualScriptInstance::ConnectDataPins(ezUInt16 uiSourceNode, ezUInt8 uiSourcePin, ezVisualScriptDataPinType::Enum sourcePinType,
-  ezUInt16 uiTargetNode, ezUInt8 uiTargetPin, ezVisualScriptDataPinType::Enum targetPinType)
-{
-  DataPinConnection& con = m_DataConnections[((ezUInt32)uiSourceNode << 16) | (ezUInt32)uiSourcePin].ExpandAndGetRef();
-  con.m_uiTargetNode = uiTargetNode;
-  con.m_uiTargetPin = uiTargetPin;
-  con.m_pTargetData = m_Nodes[uiTargetNode]->GetInputPinDataPointer(uiTargetPin);
-  con.m_AssignFunc = FindDataPinAssignFunction(sourcePinType, targetPinType);
-}
+  if (uiPin >= layout.m_uiNumDataOutputs)
+    return;
 
-void ezVisualScriptInstance::SetOutputPinValue(const ezVisualScriptNode* pNode, ezUInt8 uiPin, const void* pValue)
-{
-  const ezUInt32 uiConnectionID = ((ezUInt32)pNode->m_uiNodeID << 16) | (ezUInt32)uiPin;
+  const auto& output = m_pDescriptor->m_DataOutputs[layout.m_uiFirstDataOutput + uiPin];
 
-  ezHybridArray<DataPinConnection, 2>* TargetNodeAndPins;
-  if (!m_DataConnections.TryGetValue(uiConnectionID, TargetNodeAndPins))
+  if (output.m_uiNumTargets == 0)
     return;
 
-  for (const DataPinConnection& TargetNodeAndPin : *TargetNodeAndPins)
+  for (ezUInt32 i = output.m_uiFirstTarget; i < output.m_uiFirstTarget + output.m_uiNumTargets; ++i)
   {
-    if (TargetNodeAndPin.m_AssignFunc)
+    const auto& target = m_pDescriptor->m_DataTargets[i];
+
+    if (target.m_AssignFunc)
     {
-      if (TargetNodeAndPin.m_AssignFunc(pValue, TargetNodeAndPin.m_pTargetData))
+      if (target.m_AssignFunc(pValue, m_DataTargetPins[i]))
       {
-        m_Nodes[TargetNodeAndPin.m_uiTargetNode]->m_bInputValuesChanged = true;
+        m_Nodes[target.m_uiTargetNode]->m_bInputValuesChanged = true;
       }
     }
   }
 
   if (m_pActivity != nullptr)
   {
+    const ezVisualScriptPinConnectionID uiConnectionID = ((ezUInt32)pNode->m_uiNodeID << 16) | (ezUInt32)uiPin;
     m_pActivity->m_ActiveDataConnections.PushBack(uiConnectionID);
   }
 }
@@ -508,10 +561,14 @@ Otherwise visual script graph execution can end up in an endless recursion with
 Override ezVisualScriptNode::IsManuallyStepped() for type '{}' if necessary.",
     pNode->GetDynamicRTTI()->GetTypeName());
 
-  const ezUInt32 uiConnectionID = ((ezUInt32)pNode->m_uiNodeID << 16) | (ezUInt32)uiNthTarget;
+  const auto& layout = m_pDescriptor->m_NodeLayouts[pNode->m_uiNodeID];
+
+  if (uiNthTarget >= layout.m_uiNumExecutionOutputs)
+    return;
+
+  const auto& TargetNode = m_pDescriptor->m_ExecutionTargets[layout.m_uiFirstExecutionOutput + uiNthTarget];
 
-  ExecPinConnection TargetNode;
-  if (!m_ExecutionConnections.TryGetValue(uiConnectionID, TargetNode))
+  if (TargetNode.m_uiTargetNode == 0xFFFF)
     return;
 
   auto* pTargetNode = m_Nodes[TargetNode.m_uiTargetNode];
@@ -523,6 +580,7 @@ Override ezVisualScriptNode::IsManuallyStepped() for type '{}' if necessary.",
 
   if (m_pActivity != nullptr)
   {
+    const ezVisualScriptNodeConnectionID uiConnectionID = ((ezUInt32)pNode->m_uiNodeID << 16) | (ezUInt32)uiNthTarget;
     m_pActivity->m_ActiveExecutionConnections.PushBack(uiConnectionID);
   }
 }
@@ -549,10 +607,10 @@ ezVisualScriptDataPinAssignFunc ezVisualScriptInstance::FindDataPinAssignFunctio
 
 bool ezVisualScriptInstance::HandlesEventMessage(const ezEventMessage& msg) const
 {
-  if (m_pMessageHandlers == nullptr)
+  if (m_pDescriptor == nullptr)
     return false;
 
-  return m_pMessageHandlers->LowerBound(msg.GetId()) != ezInvalidIndex;
+  return m_pDescriptor->m_MessageHandlers.LowerBound(msg.GetId()) != ezInvalidIndex;
 }
 
 
@@ -4,6 +4,7 @@
 #include <Core/Messages/EventMessage.h>
 #include <Core/WorldSerializer/WorldReader.h>
 #include <GameEngine/VisualScript/Nodes/VisualScriptMessageNodes.h>
+#include <GameEngine/VisualScript/VisualScriptInstance.h>
 #include <GameEngine/VisualScript/VisualScriptNode.h>
 #include <GameEngine/VisualScript/VisualScriptResource.h>
 
@@ -71,6 +72,7 @@ void ezVisualScriptResource::UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage)
 EZ_RESOURCE_IMPLEMENT_CREATEABLE(ezVisualScriptResource, ezVisualScriptResourceDescriptor)
 {
   m_Descriptor = descriptor;
+  m_Descriptor.PrecomputeExecutionLayout();
 
   ezResourceLoadDesc res;
   res.m_uiQualityLevelsDiscardable = 0;
@@ -206,6 +208,7 @@ void ezVisualScriptResourceDescriptor::Load(ezStreamReader& stream)
   }
 
   PrecomputeMessageHandlers();
+  PrecomputeExecutionLayout();
 }
 
 void ezVisualScriptResourceDescriptor::Save(ezStreamWriter& stream) const
@@ -333,6 +336,146 @@ void ezVisualScriptResourceDescriptor::PrecomputeMessageHandlers()
   }
 }
 
+void ezVisualScriptResourceDescriptor::PrecomputeExecutionLayout()
+{
+  ezVisualScriptInstance::SetupPinDataTypeConversions();
+
+  const ezUInt32 uiNumNodes = m_Nodes.GetCount();
+
+  m_NodeLayouts.SetCountUninitialized(uiNumNodes);
+  ezMemoryUtils::ZeroFill(m_NodeLayouts.GetData(), uiNumNodes);
+
+  // nodes that are executed on demand are the only ones that other nodes depend on
+  ezDynamicArray<bool> isManuallyStepped;
+  isManuallyStepped.SetCount(uiNumNodes);
+
+  m_uiNodeDataSize = 0;
+
+  for (ezUInt32 uiNode = 0; uiNode < uiNumNodes; ++uiNode)
+  {
+    const auto& node = m_Nodes[uiNode];
+
+    // the type that ezVisualScriptInstance::Configure() creates for this node
+    const ezRTTI* pInstanceType = nullptr;
+
+    if (node.m_isFunctionCall || node.m_isMsgSender || node.m_isMsgHandler)
+    {
+      isManuallyStepped[uiNode] = true;
+
+      if (node.m_isFunctionCall)
+        pInstanceType = ezGetStaticRTTI<ezVisualScriptNode_FunctionCall>();
+      else if (node.m_isMsgSender)
+        pInstanceType = ezGetStaticRTTI<ezVisualScriptNode_MessageSender>();
+      else
+        pInstanceType = ezGetStaticRTTI<ezVisualScriptNode_GenericEvent>();
+    }
+    else if (node.m_pType != nullptr && node.m_pType->IsDerivedFrom<ezVisualScriptNode>())
+    {
+      ezVisualScriptNode* pNode = node.m_pType->GetAllocator()->Allocate<ezVisualScriptNode>();
+      isManuallyStepped[uiNode] = pNode->IsManuallyStepped();
+      node.m_pType->GetAllocator()->Deallocate(pNode);
+
+      pInstanceType = node.m_pType;
+    }
+
+    if (pInstanceType != nullptr)
+    {
+      m_uiNodeDataSize += ezMemoryUtils::AlignSize<ezUInt32>(pInstanceType->GetTypeSize(), NodeDataAlignment);
+    }
+  }
+
+  // count the output pins of every node
+  for (const auto& con : m_ExecutionPaths)
+  {
+    auto& layout = m_NodeLayouts[con.m_uiSourceNode];
+    layout.m_uiNumExecutionOutputs = ezMath::Max<ezUInt8>(layout.m_uiNumExecutionOutputs, con.m_uiOutputPin + 1);
+  }
+
+  for (const auto& con : m_DataPaths)
+  {
+    auto& layout = m_NodeLayouts[con.m_uiSourceNode];
+    layout.m_uiNumDataOutputs = ezMath::Max<ezUInt8>(layout.m_uiNumDataOutputs, con.m_uiOutputPin + 1);
+
+    if (!isManuallyStepped[con.m_uiSourceNode])
+    {
+      ++m_NodeLayouts[con.m_uiTargetNode].m_uiNumDependencies;
+    }
+  }
+
+  ezUInt32 uiNumExecutionOutputs = 0;
+  ezUInt32 uiNumDataOutputs = 0;
+  ezUInt32 uiNumDependencies = 0;
+
+  for (auto& layout : m_NodeLayouts)
+  {
+    layout.m_uiFirstExecutionOutput = uiNumExecutionOutputs;
+    layout.m_uiFirstDataOutput = uiNumDataOutputs;
+    layout.m_uiFirstDependency = uiNumDependencies;
+
+    uiNumExecutionOutputs += layout.m_uiNumExecutionOutputs;
+    uiNumDataOutputs += layout.m_uiNumDataOutputs;
+    uiNumDependencies += layout.m_uiNumDependencies;
+
+    // filled in again below
+    layout.m_uiNumDependencies = 0;
+  }
+
+  // execution pins only have a single target
+  m_ExecutionTargets.SetCountUninitialized(uiNumExecutionOutputs);
+  for (auto& target : m_ExecutionTargets)
+  {
+    target.m_uiTargetNode = 0xFFFF;
+    target.m_uiTargetPin = 0;
+  }
+
+  for (const auto& con : m_ExecutionPaths)
+  {
+    auto& target = m_ExecutionTargets[m_NodeLayouts[con.m_uiSourceNode].m_uiFirstExecutionOutput + con.m_uiOutputPin];
+    target.m_uiTargetNode = con.m_uiTargetNode;
+    target.m_uiTargetPin = con.m_uiInputPin;
+  }
+
+  // data pins may be connected to any number of targets, which are stored consecutively per output pin
+  m_DataOutputs.SetCountUninitialized(uiNumDataOutputs);
+  ezMemoryUtils::ZeroFill(m_DataOutputs.GetData(), uiNumDataOutputs);
+
+  for (const auto& con : m_DataPaths)
+  {
+    ++m_DataOutputs[m_NodeLayouts[con.m_uiSourceNode].m_uiFirstDataOutput + con.m_uiOutputPin].m_uiNumTargets;
+  }
+
+  ezUInt32 uiNumDataTargets = 0;
+  for (auto& output : m_DataOutputs)
+  {
+    output.m_uiFirstTarget = uiNumDataTargets;
+    uiNumDataTargets += output.m_uiNumTargets;
+    output.m_uiNumTargets = 0;
+  }
+
+  m_DataTargets.SetCountUninitialized(uiNumDataTargets);
+  m_NodeDependencies.SetCountUninitialized(uiNumDependencies);
+
+  for (const auto& con : m_DataPaths)
+  {
+    auto& output = m_DataOutputs[m_NodeLayouts[con.m_uiSourceNode].m_uiFirstDataOutput + con.m_uiOutputPin];
+
+    auto& target = m_DataTargets[output.m_uiFirstTarget + output.m_uiNumTargets];
+    target.m_uiTargetNode = con.m_uiTargetNode;
+    target.m_uiTargetPin = con.m_uiInputPin;
+    target.m_AssignFunc = ezVisualScriptInstance::FindDataPinAssignFunction(
+      (ezVisualScriptDataPinType::Enum)con.m_uiOutputPinType, (ezVisualScriptDataPinType::Enum)con.m_uiInputPinType);
+
+    ++output.m_uiNumTargets;
+
+    if (!isManuallyStepped[con.m_uiSourceNode])
+    {
+      auto& layout = m_NodeLayouts[con.m_uiTargetNode];
+      m_NodeDependencies[layout.m_uiFirstDependency + layout.m_uiNumDependencies] = con.m_uiSourceNode;
+      ++layout.m_uiNumDependencies;
+    }
+  }
+}
+
 
 
 EZ_STATICLINK_FILE(GameEngine, GameEngine_VisualScript_Implementation_VisualScriptResource);
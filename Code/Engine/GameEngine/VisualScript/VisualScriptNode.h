@@ -143,6 +143,9 @@ struct EZ_GAMEENGINE_DLL ezVisualScriptDataPinType
 
 EZ_DECLARE_REFLECTABLE_TYPE(EZ_GAMEENGINE_DLL, ezVisualScriptDataPinType);
 
+/// \brief Assigns the value of an output pin to a connected input pin. Returns true, if the value of the input pin changed.
+typedef bool (*ezVisualScriptDataPinAssignFunc)(const void* src, void* dst);
+
 class EZ_GAMEENGINE_DLL ezVisScriptDataPinInAttribute : public ezPropertyAttribute
 {
   EZ_ADD_DYNAMIC_REFLECTION(ezVisScriptDataPinInAttribute, ezPropertyAttribute);
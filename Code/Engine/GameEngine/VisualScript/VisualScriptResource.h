@@ -4,6 +4,7 @@
 #include <Foundation/Containers/ArrayMap.h>
 #include <Foundation/Reflection/Reflection.h>
 #include <GameEngine/GameEngineDLL.h>
+#include <GameEngine/VisualScript/VisualScriptNode.h>
 
 typedef ezTypedResourceHandle<class ezVisualScriptResource> ezVisualScriptResourceHandle;
 
@@ -14,6 +15,10 @@ struct EZ_GAMEENGINE_DLL ezVisualScriptResourceDescriptor
   void Save(ezStreamWriter& stream) const;
   void PrecomputeMessageHandlers();
 
+  /// \brief Compiles the nodes and connections into the flat execution layout (m_NodeLayouts etc.), which is shared by all instances of
+  /// the script.
+  void PrecomputeExecutionLayout();
+
   struct Node
   {
     Node()
@@ -74,6 +79,44 @@ struct EZ_GAMEENGINE_DLL ezVisualScriptResourceDescriptor
     double m_Value = 0;
   };
 
+  /// \brief Where to find the outgoing connections and dependencies of one node in the flat arrays below.
+  struct NodeLayout
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiFirstExecutionOutput; ///< Index into m_ExecutionTargets, one entry per output execution pin.
+    ezUInt32 m_uiFirstDataOutput;      ///< Index into m_DataOutputs, one entry per output data pin.
+    ezUInt32 m_uiFirstDependency;      ///< Index into m_NodeDependencies.
+    ezUInt16 m_uiNumDependencies;
+    ezUInt8 m_uiNumExecutionOutputs;
+    ezUInt8 m_uiNumDataOutputs;
+  };
+
+  struct ExecutionTarget
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt16 m_uiTargetNode; ///< 0xFFFF if the output pin is not connected.
+    ezUInt8 m_uiTargetPin;
+  };
+
+  struct DataOutput
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiFirstTarget; ///< Index into m_DataTargets.
+    ezUInt32 m_uiNumTargets;
+  };
+
+  struct DataTarget
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt16 m_uiTargetNode;
+    ezUInt8 m_uiTargetPin;
+    ezVisualScriptDataPinAssignFunc m_AssignFunc;
+  };
+
   ezDynamicArray<Node> m_Nodes;
   ezDynamicArray<ExecutionConnection> m_ExecutionPaths;
   ezDynamicArray<DataConnection> m_DataPaths;
@@ -81,6 +124,18 @@ struct EZ_GAMEENGINE_DLL ezVisualScriptResourceDescriptor
   ezDeque<Property> m_Properties;
   ezDynamicArray<LocalParameterBool> m_BoolParameters;
   ezDynamicArray<LocalParameterNumber> m_NumberParameters;
+
+  // Execution layout, computed from the connections above by PrecomputeExecutionLayout().
+  // Script instances only index into these arrays and never modify them.
+  ezDynamicArray<NodeLayout> m_NodeLayouts;
+  ezDynamicArray<ExecutionTarget> m_ExecutionTargets;
+  ezDynamicArray<DataOutput> m_DataOutputs;
+  ezDynamicArray<DataTarget> m_DataTargets;
+  ezDynamicArray<ezUInt16> m_NodeDependencies; ///< Nodes that have to be executed before a node, because they feed its input data pins.
+
+  /// The nodes of a script instance are stored consecutively in one block of this size, with every node aligned to NodeDataAlignment.
+  static constexpr ezUInt32 NodeDataAlignment = 16;
+  ezUInt32 m_uiNodeDataSize = 0;
 };
 
 class EZ_GAMEENGINE_DLL ezVisualScriptResource : public ezResource
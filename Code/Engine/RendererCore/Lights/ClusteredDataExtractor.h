@@ -1,6 +1,8 @@
 #pragma once
 
 #include <RendererCore/Pipeline/Extractor.h>
+#include <Foundation/SimdMath/SimdBSphere.h>
+#include <Foundation/SimdMath/SimdMat4f.h>
 #include <Foundation/Types/UniquePtr.h>
 
 struct ezPerLightData;
@@ -17,9 +19,9 @@ public:
 
   enum
   {
-    MAX_LIGHT_DATA = 1024,
-    MAX_DECAL_DATA = 1024,
-    MAX_ITEMS_PER_CLUSTER = 256
+    MAX_LIGHT_DATA = 0xFFFF, ///< Upper limit given by the 16 bit indices in the cluster item list, the actual limit is set via cvar 'r_MaxLights'
+    MAX_DECAL_DATA = 0xFFFF, ///< Upper limit given by the 16 bit indices in the cluster item list, the actual limit is set via cvar 'r_MaxDecals'
+    MAX_ITEMS_PER_CLUSTER = 256, ///< Maximum number of lights and of decals in a single cluster, further items are not added to that cluster
   };
 
   ezArrayPtr<ezPerLightData> m_LightData;
@@ -47,22 +49,76 @@ public:
     ezExtractedRenderData& extractedRenderData) override;
 
 private:
-  void FillItemListAndClusterData(ezClusteredDataCPU* pData);
+  struct ClusterRange
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt8 m_uiMinX;
+    ezUInt8 m_uiMaxX;
+    ezUInt8 m_uiMinY;
+    ezUInt8 m_uiMaxY;
+    ezUInt8 m_uiMinZ;
+    ezUInt8 m_uiMaxZ;
+  };
+
+  struct PointLight
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezSimdBSphere m_Sphere;
+    ClusterRange m_Range;
+    ezUInt32 m_uiLightIndex;
+  };
 
-  template <ezUInt32 MaxData>
-  struct TempCluster
+  struct SpotLight
   {
     EZ_DECLARE_POD_TYPE();
 
-    ezUInt32 m_BitMask[MaxData / 32];
+    ezSimdVec4f m_PositionAndRange;
+    ezSimdVec4f m_ForwardDir;
+    ezSimdVec4f m_SinCosAngle;
+    ClusterRange m_Range;
+    ezUInt32 m_uiLightIndex;
   };
 
+  struct Decal
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezSimdMat4f m_WorldToDecal;
+    ClusterRange m_Range;
+    ezUInt32 m_uiDecalIndex;
+  };
+
+  void CollectLights(const ezView& view, const ezExtractedRenderData& extractedRenderData, const ezSimdMat4f& viewMatrix, const ezSimdMat4f& projectionMatrix, ezClusteredDataCPU* pData);
+  void CollectDecals(const ezExtractedRenderData& extractedRenderData, const ezSimdMat4f& viewProjectionMatrix);
+
+  /// \brief Bins all lights and decals into the clusters of the given depth slices and fills the per slice item lists.
+  ///
+  /// Every depth slice only touches its own clusters, so different slices can be processed in parallel.
+  void BinSlices(ezUInt32 uiStartSlice, ezUInt32 uiEndSlice, ezClusteredDataCPU* pData);
+  void FillItemListAndClusterData(ezClusteredDataCPU* pData);
+
   ezDynamicArray<ezPerLightData, ezAlignedAllocatorWrapper> m_TempLightData;
   ezDynamicArray<ezPerDecalData, ezAlignedAllocatorWrapper> m_TempDecalData;
-  ezDynamicArray<TempCluster<ezClusteredDataCPU::MAX_LIGHT_DATA>> m_TempLightsClusters;
-  ezDynamicArray<TempCluster<ezClusteredDataCPU::MAX_DECAL_DATA>> m_TempDecalsClusters;
-  ezDynamicArray<ezUInt32> m_TempClusterItemList;
+
+  // Lights and decals sorted by type, so that binning does not need to check the type per item
+  ezDynamicArray<PointLight, ezAlignedAllocatorWrapper> m_PointLights;
+  ezDynamicArray<SpotLight, ezAlignedAllocatorWrapper> m_SpotLights;
+  ezDynamicArray<ezUInt32> m_DirLights;
+  ezDynamicArray<Decal, ezAlignedAllocatorWrapper> m_Decals;
+
+  // One bit per light or decal for every cluster, m_uiNumLightBlocks or m_uiNumDecalBlocks ezUInt32 per cluster
+  ezUInt32 m_uiNumLightBlocks = 0;
+  ezUInt32 m_uiNumDecalBlocks = 0;
+  ezDynamicArray<ezUInt32> m_TempLightsClusters;
+  ezDynamicArray<ezUInt32> m_TempDecalsClusters;
+
+  ezDynamicArray<ezDynamicArray<ezUInt32>> m_TempSliceItemLists;
 
   ezDynamicArray<ezSimdBSphere, ezAlignedAllocatorWrapper> m_ClusterBoundingSpheres;
-};
 
+  // The limit warnings are only logged once, until the number of lights or decals drops below the limit again
+  bool m_bLightLimitWarningShown = false;
+  bool m_bDecalLimitWarningShown = false;
+};
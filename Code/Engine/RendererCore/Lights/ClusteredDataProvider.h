@@ -24,7 +24,15 @@ public:
   ezDecalAtlasResourceHandle m_hDecalAtlas;
   ezGALSamplerStateHandle m_hDecalAtlasSampler;
 
+  /// \brief Grows the light, decal and cluster item buffers if they are too small for the given number of elements.
+  void EnsureBufferSizes(ezUInt32 uiNumLights, ezUInt32 uiNumDecals, ezUInt32 uiNumClusterItems);
+
   void BindResources(ezRenderContext* pRenderContext);
+
+private:
+  ezUInt32 m_uiLightDataCapacity = 0;
+  ezUInt32 m_uiDecalDataCapacity = 0;
+  ezUInt32 m_uiClusterItemCapacity = 0;
 };
 
 class EZ_RENDERERCORE_DLL ezClusteredDataProvider : public ezFrameDataProvider<ezClusteredDataGPU>
@@ -3,6 +3,7 @@
 #include <Core/Graphics/Camera.h>
 #include <Foundation/Configuration/CVar.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Components/FogComponent.h>
 #include <RendererCore/Debug/DebugRenderer.h>
 #include <RendererCore/Lights/AmbientLightComponent.h>
@@ -11,6 +12,9 @@
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 #include <RendererCore/Pipeline/View.h>
 
+ezCVarInt CVarMaxLights("r_MaxLights", 4096, ezCVarFlags::Default, "Maximum number of lights per view, further lights are discarded");
+ezCVarInt CVarMaxDecals("r_MaxDecals", 1024, ezCVarFlags::Default, "Maximum number of decals per view, further decals are discarded");
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
 ezCVarBool CVarVisClusteredData("r_VisClusteredData", false, ezCVarFlags::Default, "Enables debug visualization of clustered light data");
 ezCVarInt CVarVisClusterDepthSlice("r_VisClusterDepthSlice", -1, ezCVarFlags::Default,
@@ -151,8 +155,7 @@ ezClusteredDataExtractor::ezClusteredDataExtractor(const char* szName)
 {
   m_DependsOn.PushBack(ezMakeHashedString("ezVisibleObjectsExtractor"));
 
-  m_TempLightsClusters.SetCountUninitialized(NUM_CLUSTERS);
-  m_TempDecalsClusters.SetCountUninitialized(NUM_CLUSTERS);
+  m_TempSliceItemLists.SetCount(NUM_CLUSTERS_Z);
   m_ClusterBoundingSpheres.SetCountUninitialized(NUM_CLUSTERS);
 }
 
@@ -178,223 +181,358 @@ void ezClusteredDataExtractor::PostSortAndBatch(const ezView& view, const ezDyna
 
   // Lights
   {
-    m_TempLightData.Clear();
-    ezMemoryUtils::ZeroFill(m_TempLightsClusters.GetData(), NUM_CLUSTERS);
+    CollectLights(view, extractedRenderData, viewMatrix, projectionMatrix, pData);
+
+    pData->m_LightData = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezPerLightData, m_TempLightData.GetCount());
+    pData->m_LightData.CopyFrom(m_TempLightData);
+
+    pData->m_uiSkyIrradianceIndex = view.GetWorld()->GetIndex();
+  }
+
+  // Decals
+  {
+    CollectDecals(extractedRenderData, viewProjectionMatrix);
+
+    pData->m_DecalData = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezPerDecalData, m_TempDecalData.GetCount());
+    pData->m_DecalData.CopyFrom(m_TempDecalData);
+  }
+
+  // Binning
+  {
+    m_uiNumLightBlocks = (m_TempLightData.GetCount() + 31) / 32;
+    m_uiNumDecalBlocks = (m_TempDecalData.GetCount() + 31) / 32;
+
+    m_TempLightsClusters.SetCountUninitialized(NUM_CLUSTERS * m_uiNumLightBlocks);
+    m_TempDecalsClusters.SetCountUninitialized(NUM_CLUSTERS * m_uiNumDecalBlocks);
+
+    ezTaskSystem::ParallelForIndexed(
+      0, NUM_CLUSTERS_Z, [this, pData](ezUInt32 uiStartSlice, ezUInt32 uiEndSlice) { BinSlices(uiStartSlice, uiEndSlice, pData); },
+      "ClusteredLightBinning");
+  }
 
-    auto batchList = extractedRenderData.GetRenderDataBatchesWithCategory(ezDefaultRenderDataCategories::Light);
-    const ezUInt32 uiBatchCount = batchList.GetBatchCount();
-    for (ezUInt32 i = 0; i < uiBatchCount; ++i)
+  FillItemListAndClusterData(pData);
+
+  extractedRenderData.AddFrameData(pData);
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  VisualizeClusteredData(view, pData, m_ClusterBoundingSpheres);
+#endif
+}
+
+void ezClusteredDataExtractor::CollectLights(const ezView& view, const ezExtractedRenderData& extractedRenderData, const ezSimdMat4f& viewMatrix,
+  const ezSimdMat4f& projectionMatrix, ezClusteredDataCPU* pData)
+{
+  m_TempLightData.Clear();
+  m_PointLights.Clear();
+  m_SpotLights.Clear();
+  m_DirLights.Clear();
+
+  const ezUInt32 uiMaxLights = ezMath::Clamp<ezInt32>(CVarMaxLights, 0, ezClusteredDataCPU::MAX_LIGHT_DATA);
+  bool bLimitReached = false;
+
+  // All render data in a batch has the same type, so the type only needs to be checked once per batch
+  auto batchList = extractedRenderData.GetRenderDataBatchesWithCategory(ezDefaultRenderDataCategories::Light);
+  const ezUInt32 uiBatchCount = batchList.GetBatchCount();
+  for (ezUInt32 i = 0; i < uiBatchCount; ++i)
+  {
+    const ezRenderDataBatch& batch = batchList.GetBatch(i);
+
+    const ezRenderData* pFirstData = batch.GetFirstData<ezRenderData>();
+    if (pFirstData == nullptr)
+      continue;
+
+    const ezRTTI* pType = pFirstData->GetDynamicRTTI();
+
+    if (pType->IsDerivedFrom<ezFogRenderData>())
     {
-      const ezRenderDataBatch& batch = batchList.GetBatch(i);
+      const ezCamera* pCamera = view.GetCullingCamera();
 
-      for (auto it = batch.GetIterator<ezRenderData>(); it.IsValid(); ++it)
+      for (auto it = batch.GetIterator<ezFogRenderData>(); it.IsValid(); ++it)
       {
-        const ezUInt32 uiLightIndex = m_TempLightData.GetCount();
+        const ezFogRenderData* pFogRenderData = it;
 
-        if (uiLightIndex == ezClusteredDataCPU::MAX_LIGHT_DATA)
+        float fogBaseHeight = pFogRenderData->m_GlobalTransform.m_vPosition.z;
+        float fogHeightFalloff = pFogRenderData->m_fHeightFalloff > 0.0f ? ezMath::Ln(0.0001f) / pFogRenderData->m_fHeightFalloff : 0.0f;
+
+        float fogAtCameraPos = fogHeightFalloff * (pCamera->GetPosition().z - fogBaseHeight);
+        if (fogAtCameraPos >= 80.0f) // Prevent infs
         {
-          ezLog::Warning("Maximum number of lights reached ({0}). Further lights will be discarded.", ezClusteredDataCPU::MAX_LIGHT_DATA);
-          break;
+          fogHeightFalloff = 0.0f;
         }
 
-        if (auto pPointLightRenderData = ezDynamicCast<const ezPointLightRenderData*>(it))
-        {
-          FillPointLightData(m_TempLightData.ExpandAndGetRef(), pPointLightRenderData);
+        pData->m_fFogHeight = -fogHeightFalloff * fogBaseHeight;
+        pData->m_fFogHeightFalloff = fogHeightFalloff;
+        pData->m_fFogDensityAtCameraPos = ezMath::Exp(ezMath::Clamp(fogAtCameraPos, -80.0f, 80.0f)); // Prevent infs
+        pData->m_fFogDensity = pFogRenderData->m_fDensity;
 
-          ezSimdBSphere pointLightSphere = ezSimdBSphere(ezSimdConversion::ToVec3(pPointLightRenderData->m_GlobalTransform.m_vPosition),
-                                                         pPointLightRenderData->m_fRange);
-          RasterizePointLight(pointLightSphere, uiLightIndex, viewMatrix, projectionMatrix, m_TempLightsClusters.GetData(),
-                              m_ClusterBoundingSpheres.GetData());
+        pData->m_FogColor = pFogRenderData->m_Color;
+      }
 
-          if (false)
-          {
-            ezSimdBBox ssb = GetScreenSpaceBounds(pointLightSphere, viewMatrix, projectionMatrix);
-            float minX = ((float)ssb.m_Min.x() * 0.5f + 0.5f) * view.GetViewport().width;
-            float maxX = ((float)ssb.m_Max.x() * 0.5f + 0.5f) * view.GetViewport().width;
-            float minY = ((float)ssb.m_Max.y() * -0.5f + 0.5f) * view.GetViewport().height;
-            float maxY = ((float)ssb.m_Min.y() * -0.5f + 0.5f) * view.GetViewport().height;
-
-            ezRectFloat rect(minX, minY, maxX - minX, maxY - minY);
-            ezDebugRenderer::Draw2DRectangle(view.GetHandle(), rect, 0.0f, ezColor::Blue.WithAlpha(0.3f));
-          }
-        }
-        else if (auto pSpotLightRenderData = ezDynamicCast<const ezSpotLightRenderData*>(it))
-        {
-          FillSpotLightData(m_TempLightData.ExpandAndGetRef(), pSpotLightRenderData);
+      continue;
+    }
 
-          ezAngle halfAngle = pSpotLightRenderData->m_OuterSpotAngle / 2.0f;
+    const bool bPointLights = pType->IsDerivedFrom<ezPointLightRenderData>();
+    const bool bSpotLights = pType->IsDerivedFrom<ezSpotLightRenderData>();
+    const bool bDirLights = pType->IsDerivedFrom<ezDirectionalLightRenderData>();
+    EZ_ASSERT_DEV(bPointLights || bSpotLights || bDirLights, "Unsupported light type '{0}'", pType->GetTypeName());
 
-          BoundingCone cone;
-          cone.m_PositionAndRange = ezSimdConversion::ToVec3(pSpotLightRenderData->m_GlobalTransform.m_vPosition);
-          cone.m_PositionAndRange.SetW(pSpotLightRenderData->m_fRange);
-          cone.m_ForwardDir = ezSimdConversion::ToVec3(pSpotLightRenderData->m_GlobalTransform.m_qRotation * ezVec3(1.0f, 0.0f, 0.0f));
-          cone.m_SinCosAngle = ezSimdVec4f(ezMath::Sin(halfAngle), ezMath::Cos(halfAngle), 0.0f);
-          RasterizeSpotLight(cone, uiLightIndex, viewMatrix, projectionMatrix, m_TempLightsClusters.GetData(),
-                             m_ClusterBoundingSpheres.GetData());
-        }
-        else if (auto pDirLightRenderData = ezDynamicCast<const ezDirectionalLightRenderData*>(it))
-        {
-          FillDirLightData(m_TempLightData.ExpandAndGetRef(), pDirLightRenderData);
+    for (auto it = batch.GetIterator<ezLightRenderData>(); it.IsValid(); ++it)
+    {
+      const ezUInt32 uiLightIndex = m_TempLightData.GetCount();
 
-          RasterizeDirLight(pDirLightRenderData, uiLightIndex, m_TempLightsClusters.GetArrayPtr());
-        }
-        else if (auto pFogRenderData = ezDynamicCast<const ezFogRenderData*>(it))
-        {
-          float fogBaseHeight = pFogRenderData->m_GlobalTransform.m_vPosition.z;
-          float fogHeightFalloff = pFogRenderData->m_fHeightFalloff > 0.0f ? ezMath::Ln(0.0001f) / pFogRenderData->m_fHeightFalloff : 0.0f;
+      if (uiLightIndex == uiMaxLights)
+      {
+        bLimitReached = true;
+        break;
+      }
 
-          float fogAtCameraPos = fogHeightFalloff * (pCamera->GetPosition().z - fogBaseHeight);
-          if (fogAtCameraPos >= 80.0f) // Prevent infs
-          {
-            fogHeightFalloff = 0.0f;
-          }
+      const ezLightRenderData* pLightRenderData = it;
 
-          pData->m_fFogHeight = -fogHeightFalloff * fogBaseHeight;
-          pData->m_fFogHeightFalloff = fogHeightFalloff;
-          pData->m_fFogDensityAtCameraPos = ezMath::Exp(ezMath::Clamp(fogAtCameraPos, -80.0f, 80.0f)); // Prevent infs
-          pData->m_fFogDensity = pFogRenderData->m_fDensity;
+      if (bPointLights)
+      {
+        auto pPointLightRenderData = static_cast<const ezPointLightRenderData*>(pLightRenderData);
+        FillPointLightData(m_TempLightData.ExpandAndGetRef(), pPointLightRenderData);
 
-          pData->m_FogColor = pFogRenderData->m_Color;
-        }
-        else
-        {
-          EZ_ASSERT_NOT_IMPLEMENTED;
-        }
+        auto& pointLight = m_PointLights.ExpandAndGetRef();
+        pointLight.m_Sphere = ezSimdBSphere(ezSimdConversion::ToVec3(pPointLightRenderData->m_GlobalTransform.m_vPosition), pPointLightRenderData->m_fRange);
+        pointLight.m_uiLightIndex = uiLightIndex;
+
+        GetClusterRange(GetScreenSpaceBounds(pointLight.m_Sphere, viewMatrix, projectionMatrix), pointLight.m_Range);
       }
-    }
+      else if (bSpotLights)
+      {
+        auto pSpotLightRenderData = static_cast<const ezSpotLightRenderData*>(pLightRenderData);
+        FillSpotLightData(m_TempLightData.ExpandAndGetRef(), pSpotLightRenderData);
 
-    pData->m_LightData = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezPerLightData, m_TempLightData.GetCount());
-    pData->m_LightData.CopyFrom(m_TempLightData);
+        ezAngle halfAngle = pSpotLightRenderData->m_OuterSpotAngle / 2.0f;
 
-    pData->m_uiSkyIrradianceIndex = view.GetWorld()->GetIndex();
+        auto& spotLight = m_SpotLights.ExpandAndGetRef();
+        spotLight.m_PositionAndRange = ezSimdConversion::ToVec3(pSpotLightRenderData->m_GlobalTransform.m_vPosition);
+        spotLight.m_PositionAndRange.SetW(pSpotLightRenderData->m_fRange);
+        spotLight.m_ForwardDir = ezSimdConversion::ToVec3(pSpotLightRenderData->m_GlobalTransform.m_qRotation * ezVec3(1.0f, 0.0f, 0.0f));
+        spotLight.m_SinCosAngle = ezSimdVec4f(ezMath::Sin(halfAngle), ezMath::Cos(halfAngle), 0.0f);
+        spotLight.m_uiLightIndex = uiLightIndex;
+
+        GetClusterRange(GetScreenSpaceBounds(GetSpotLightBoundingSphere(spotLight), viewMatrix, projectionMatrix), spotLight.m_Range);
+      }
+      else if (bDirLights)
+      {
+        FillDirLightData(m_TempLightData.ExpandAndGetRef(), static_cast<const ezDirectionalLightRenderData*>(pLightRenderData));
+
+        m_DirLights.PushBack(uiLightIndex);
+      }
+    }
   }
 
-  // Decals
+  if (bLimitReached && !m_bLightLimitWarningShown)
+  {
+    ezLog::Warning("Maximum number of lights reached ({0}). Further lights will be discarded.", uiMaxLights);
+  }
+
+  m_bLightLimitWarningShown = bLimitReached;
+}
+
+void ezClusteredDataExtractor::CollectDecals(const ezExtractedRenderData& extractedRenderData, const ezSimdMat4f& viewProjectionMatrix)
+{
+  m_TempDecalData.Clear();
+  m_Decals.Clear();
+
+  const ezUInt32 uiMaxDecals = ezMath::Clamp<ezInt32>(CVarMaxDecals, 0, ezClusteredDataCPU::MAX_DECAL_DATA);
+  bool bLimitReached = false;
+
+  auto batchList = extractedRenderData.GetRenderDataBatchesWithCategory(ezDefaultRenderDataCategories::Decal);
+  const ezUInt32 uiBatchCount = batchList.GetBatchCount();
+  for (ezUInt32 i = 0; i < uiBatchCount; ++i)
   {
-    m_TempDecalData.Clear();
-    ezMemoryUtils::ZeroFill(m_TempDecalsClusters.GetData(), NUM_CLUSTERS);
+    const ezRenderDataBatch& batch = batchList.GetBatch(i);
+
+    const ezRenderData* pFirstData = batch.GetFirstData<ezRenderData>();
+    if (pFirstData == nullptr)
+      continue;
+
+    if (!pFirstData->IsInstanceOf<ezDecalRenderData>())
+    {
+      EZ_ASSERT_NOT_IMPLEMENTED;
+      continue;
+    }
 
-    auto batchList = extractedRenderData.GetRenderDataBatchesWithCategory(ezDefaultRenderDataCategories::Decal);
-    const ezUInt32 uiBatchCount = batchList.GetBatchCount();
-    for (ezUInt32 i = 0; i < uiBatchCount; ++i)
+    for (auto it = batch.GetIterator<ezDecalRenderData>(); it.IsValid(); ++it)
     {
-      const ezRenderDataBatch& batch = batchList.GetBatch(i);
+      const ezUInt32 uiDecalIndex = m_TempDecalData.GetCount();
 
-      for (auto it = batch.GetIterator<ezRenderData>(); it.IsValid(); ++it)
+      if (uiDecalIndex == uiMaxDecals)
       {
-        const ezUInt32 uiDecalIndex = m_TempDecalData.GetCount();
+        bLimitReached = true;
+        break;
+      }
 
-        if (uiDecalIndex == ezClusteredDataCPU::MAX_DECAL_DATA)
-        {
-          ezLog::Warning("Maximum number of decals reached ({0}). Further decals will be discarded.", ezClusteredDataCPU::MAX_DECAL_DATA);
-          break;
-        }
+      const ezDecalRenderData* pDecalRenderData = it;
+      FillDecalData(m_TempDecalData.ExpandAndGetRef(), pDecalRenderData);
 
-        if (auto pDecalRenderData = ezDynamicCast<const ezDecalRenderData*>(it))
-        {
-          FillDecalData(m_TempDecalData.ExpandAndGetRef(), pDecalRenderData);
+      ezSimdMat4f decalToWorld = ezSimdConversion::ToTransform(pDecalRenderData->m_GlobalTransform).GetAsMat4();
 
-          RasterizeDecal(pDecalRenderData, uiDecalIndex, viewProjectionMatrix, m_TempDecalsClusters.GetData(),
-                         m_ClusterBoundingSpheres.GetData());
-        }
-        else
-        {
-          EZ_ASSERT_NOT_IMPLEMENTED;
-        }
-      }
-    }
+      auto& decal = m_Decals.ExpandAndGetRef();
+      decal.m_WorldToDecal = decalToWorld.GetInverse();
+      decal.m_uiDecalIndex = uiDecalIndex;
 
-    pData->m_DecalData = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezPerDecalData, m_TempDecalData.GetCount());
-    pData->m_DecalData.CopyFrom(m_TempDecalData);
+      GetClusterRange(GetDecalScreenSpaceBounds(decalToWorld, viewProjectionMatrix), decal.m_Range);
+    }
   }
 
-  FillItemListAndClusterData(pData);
-
-  extractedRenderData.AddFrameData(pData);
+  if (bLimitReached && !m_bDecalLimitWarningShown)
+  {
+    ezLog::Warning("Maximum number of decals reached ({0}). Further decals will be discarded.", uiMaxDecals);
+  }
 
-#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-  VisualizeClusteredData(view, pData, m_ClusterBoundingSpheres);
-#endif
+  m_bDecalLimitWarningShown = bLimitReached;
 }
 
 namespace
 {
-  ezUInt32 PackIndex(ezUInt32 uiLightIndex, ezUInt32 uiDecalIndex) { return uiDecalIndex << 10 | uiLightIndex; }
+  ezUInt32 PackIndex(ezUInt32 uiLightIndex, ezUInt32 uiDecalIndex) { return uiDecalIndex << DECAL_SHIFT | uiLightIndex; }
 }
 
-void ezClusteredDataExtractor::FillItemListAndClusterData(ezClusteredDataCPU* pData)
+void ezClusteredDataExtractor::BinSlices(ezUInt32 uiStartSlice, ezUInt32 uiEndSlice, ezClusteredDataCPU* pData)
 {
-  m_TempClusterItemList.Clear();
+  const ezUInt32 uiStartCluster = uiStartSlice * NUM_CLUSTERS_XY;
+  const ezUInt32 uiEndCluster = uiEndSlice * NUM_CLUSTERS_XY;
+
+  const ezUInt32 uiNumLightBlocks = m_uiNumLightBlocks;
+  const ezUInt32 uiNumDecalBlocks = m_uiNumDecalBlocks;
 
-  const ezUInt32 uiNumLights = m_TempLightData.GetCount();
-  const ezUInt32 uiMaxLightBlockIndex = (uiNumLights + 31) / 32;
+  ezUInt32* pLightsClusters = m_TempLightsClusters.GetData();
+  ezUInt32* pDecalsClusters = m_TempDecalsClusters.GetData();
+  const ezSimdBSphere* pClusterBoundingSpheres = m_ClusterBoundingSpheres.GetData();
 
-  const ezUInt32 uiNumDecals = m_TempDecalData.GetCount();
-  const ezUInt32 uiMaxDecalBlockIndex = (uiNumDecals + 31) / 32;
+  ezMemoryUtils::ZeroFill(pLightsClusters + uiStartCluster * uiNumLightBlocks, (uiEndCluster - uiStartCluster) * uiNumLightBlocks);
+  ezMemoryUtils::ZeroFill(pDecalsClusters + uiStartCluster * uiNumDecalBlocks, (uiEndCluster - uiStartCluster) * uiNumDecalBlocks);
 
-  for (ezUInt32 i = 0; i < NUM_CLUSTERS; ++i)
+  // Rasterize
   {
-    ezUInt32 uiOffset = m_TempClusterItemList.GetCount();
-    ezUInt32 uiLightCount = 0;
+    for (const auto& pointLight : m_PointLights)
+    {
+      FillClusters(pointLight.m_Range, uiStartSlice, uiEndSlice, pointLight.m_uiLightIndex, uiNumLightBlocks, pLightsClusters,
+        [&](ezUInt32 uiClusterIndex) { return pointLight.m_Sphere.Overlaps(pClusterBoundingSpheres[uiClusterIndex]); });
+    }
 
-    // Lights
+    for (const auto& spotLight : m_SpotLights)
     {
-      auto& tempCluster = m_TempLightsClusters[i];
-      for (ezUInt32 uiBlockIndex = 0; uiBlockIndex < uiMaxLightBlockIndex; ++uiBlockIndex)
-      {
-        ezUInt32 mask = tempCluster.m_BitMask[uiBlockIndex];
+      FillClusters(spotLight.m_Range, uiStartSlice, uiEndSlice, spotLight.m_uiLightIndex, uiNumLightBlocks, pLightsClusters,
+        [&](ezUInt32 uiClusterIndex) { return SpotLightOverlaps(spotLight, pClusterBoundingSpheres[uiClusterIndex]); });
+    }
 
-        while (mask > 0)
-        {
-          ezUInt32 uiLightIndex = ezMath::FirstBitLow(mask);
-          mask &= ~(1 << uiLightIndex);
+    for (ezUInt32 uiLightIndex : m_DirLights)
+    {
+      const ezUInt32 uiBlockIndex = uiLightIndex / 32;
+      const ezUInt32 uiMask = 1u << (uiLightIndex - uiBlockIndex * 32);
 
-          uiLightIndex += uiBlockIndex * 32;
-          m_TempClusterItemList.PushBack(uiLightIndex);
-          ++uiLightCount;
-        }
+      for (ezUInt32 i = uiStartCluster; i < uiEndCluster; ++i)
+      {
+        pLightsClusters[i * uiNumLightBlocks + uiBlockIndex] |= uiMask;
       }
     }
 
-    ezUInt32 uiDecalCount = 0;
+    for (const auto& decal : m_Decals)
+    {
+      FillClusters(decal.m_Range, uiStartSlice, uiEndSlice, decal.m_uiDecalIndex, uiNumDecalBlocks, pDecalsClusters,
+        [&](ezUInt32 uiClusterIndex) { return DecalOverlaps(decal.m_WorldToDecal, pClusterBoundingSpheres[uiClusterIndex]); });
+    }
+  }
 
-    // Decals
+  // Fill the item lists of the slices, the offsets are relative to the start of the slice and are fixed up later
+  for (ezUInt32 uiSlice = uiStartSlice; uiSlice < uiEndSlice; ++uiSlice)
+  {
+    auto& itemList = m_TempSliceItemLists[uiSlice];
+    itemList.Clear();
+
+    const ezUInt32 uiSliceStartCluster = uiSlice * NUM_CLUSTERS_XY;
+    for (ezUInt32 i = uiSliceStartCluster; i < uiSliceStartCluster + NUM_CLUSTERS_XY; ++i)
     {
-      auto& tempCluster = m_TempDecalsClusters[i];
-      for (ezUInt32 uiBlockIndex = 0; uiBlockIndex < uiMaxDecalBlockIndex; ++uiBlockIndex)
-      {
-        ezUInt32 mask = tempCluster.m_BitMask[uiBlockIndex];
+      ezUInt32 uiOffset = itemList.GetCount();
+      ezUInt32 uiLightCount = 0;
 
-        while (mask > 0)
+      // Lights
+      {
+        const ezUInt32* pBitMask = pLightsClusters + i * uiNumLightBlocks;
+        for (ezUInt32 uiBlockIndex = 0; uiBlockIndex < uiNumLightBlocks; ++uiBlockIndex)
         {
-          ezUInt32 uiDecalIndex = ezMath::FirstBitLow(mask);
-          mask &= ~(1 << uiDecalIndex);
-
-          uiDecalIndex += uiBlockIndex * 32;
+          ezUInt32 mask = pBitMask[uiBlockIndex];
 
-          if (uiDecalCount < uiLightCount)
+          while (mask > 0 && uiLightCount < ezClusteredDataCPU::MAX_ITEMS_PER_CLUSTER)
           {
-            auto& item = m_TempClusterItemList[uiOffset + uiDecalCount];
-            item = PackIndex(item, uiDecalIndex);
+            ezUInt32 uiLightIndex = ezMath::FirstBitLow(mask);
+            mask &= ~(1u << uiLightIndex);
+
+            uiLightIndex += uiBlockIndex * 32;
+            itemList.PushBack(uiLightIndex);
+            ++uiLightCount;
           }
-          else
+        }
+      }
+
+      ezUInt32 uiDecalCount = 0;
+
+      // Decals
+      {
+        const ezUInt32* pBitMask = pDecalsClusters + i * uiNumDecalBlocks;
+        for (ezUInt32 uiBlockIndex = 0; uiBlockIndex < uiNumDecalBlocks; ++uiBlockIndex)
+        {
+          ezUInt32 mask = pBitMask[uiBlockIndex];
+
+          while (mask > 0 && uiDecalCount < ezClusteredDataCPU::MAX_ITEMS_PER_CLUSTER)
           {
-            auto& item = m_TempClusterItemList.ExpandAndGetRef();
-            item = PackIndex(0, uiDecalIndex);
-          }
+            ezUInt32 uiDecalIndex = ezMath::FirstBitLow(mask);
+            mask &= ~(1u << uiDecalIndex);
+
+            uiDecalIndex += uiBlockIndex * 32;
+
+            if (uiDecalCount < uiLightCount)
+            {
+              auto& item = itemList[uiOffset + uiDecalCount];
+              item = PackIndex(item, uiDecalIndex);
+            }
+            else
+            {
+              auto& item = itemList.ExpandAndGetRef();
+              item = PackIndex(0, uiDecalIndex);
+            }
 
-          ++uiDecalCount;
+            ++uiDecalCount;
+          }
         }
       }
+
+      auto& clusterData = pData->m_ClusterData[i];
+      clusterData.offset = uiOffset;
+      clusterData.counts = PackIndex(uiLightCount, uiDecalCount);
     }
+  }
+}
 
-    auto& clusterData = pData->m_ClusterData[i];
-    clusterData.offset = uiOffset;
-    clusterData.counts = PackIndex(uiLightCount, uiDecalCount);
+void ezClusteredDataExtractor::FillItemListAndClusterData(ezClusteredDataCPU* pData)
+{
+  ezUInt32 uiTotalItemCount = 0;
+  for (const auto& itemList : m_TempSliceItemLists)
+  {
+    uiTotalItemCount += itemList.GetCount();
   }
 
-  pData->m_ClusterItemList = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezUInt32, m_TempClusterItemList.GetCount());
-  pData->m_ClusterItemList.CopyFrom(m_TempClusterItemList);
+  pData->m_ClusterItemList = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezUInt32, uiTotalItemCount);
+
+  ezUInt32 uiSliceOffset = 0;
+  for (ezUInt32 uiSlice = 0; uiSlice < NUM_CLUSTERS_Z; ++uiSlice)
+  {
+    const auto& itemList = m_TempSliceItemLists[uiSlice];
+    pData->m_ClusterItemList.GetSubArray(uiSliceOffset, itemList.GetCount()).CopyFrom(itemList);
+
+    const ezUInt32 uiSliceStartCluster = uiSlice * NUM_CLUSTERS_XY;
+    for (ezUInt32 i = uiSliceStartCluster; i < uiSliceStartCluster + NUM_CLUSTERS_XY; ++i)
+    {
+      pData->m_ClusterData[i].offset += uiSliceOffset;
+    }
+
+    uiSliceOffset += itemList.GetCount();
+  }
 }
 
 
@@ -11,48 +11,58 @@
 #include <RendererCore/Textures/TextureUtils.h>
 #include <RendererFoundation/Profiling/Profiling.h>
 
-ezClusteredDataGPU::ezClusteredDataGPU()
+namespace
 {
-  ezGALDevice* pDevice = ezGALDevice::GetDefaultDevice();
+  enum
+  {
+    INITIAL_LIGHT_DATA = 1024,
+    INITIAL_DECAL_DATA = 1024,
+    INITIAL_ITEMS_PER_CLUSTER = 256
+  };
 
+  /// \brief Creates a structured buffer for at least uiMinCount elements if the current one is too small.
+  void EnsureStructuredBufferSize(ezGALBufferHandle& hBuffer, ezUInt32& inout_uiCapacity, ezUInt32 uiMinCount, ezUInt32 uiStructSize)
   {
-    ezGALBufferCreationDescription desc;
+    if (!hBuffer.IsInvalidated() && uiMinCount <= inout_uiCapacity)
+      return;
 
-    {
-      desc.m_uiStructSize = sizeof(ezPerLightData);
-      desc.m_uiTotalSize = desc.m_uiStructSize * ezClusteredDataCPU::MAX_LIGHT_DATA;
-      desc.m_BufferType = ezGALBufferType::Generic;
-      desc.m_bUseAsStructuredBuffer = true;
-      desc.m_bAllowShaderResourceView = true;
-      desc.m_ResourceAccess.m_bImmutable = false;
-
-      m_hLightDataBuffer = pDevice->CreateBuffer(desc);
-    }
+    ezGALDevice* pDevice = ezGALDevice::GetDefaultDevice();
 
+    if (!hBuffer.IsInvalidated())
     {
-      desc.m_uiStructSize = sizeof(ezPerDecalData);
-      desc.m_uiTotalSize = desc.m_uiStructSize * ezClusteredDataCPU::MAX_DECAL_DATA;
-      desc.m_BufferType = ezGALBufferType::Generic;
-      desc.m_bUseAsStructuredBuffer = true;
-      desc.m_bAllowShaderResourceView = true;
-      desc.m_ResourceAccess.m_bImmutable = false;
-
-      m_hDecalDataBuffer = pDevice->CreateBuffer(desc);
+      pDevice->DestroyBuffer(hBuffer);
     }
 
-    {
-      desc.m_uiStructSize = sizeof(ezPerClusterData);
-      desc.m_uiTotalSize = desc.m_uiStructSize * NUM_CLUSTERS;
+    inout_uiCapacity = ezMath::Max(inout_uiCapacity, ezMath::PowerOfTwo_Ceil(uiMinCount));
 
-      m_hClusterDataBuffer = pDevice->CreateBuffer(desc);
-    }
+    ezGALBufferCreationDescription desc;
+    desc.m_uiStructSize = uiStructSize;
+    desc.m_uiTotalSize = desc.m_uiStructSize * inout_uiCapacity;
+    desc.m_BufferType = ezGALBufferType::Generic;
+    desc.m_bUseAsStructuredBuffer = true;
+    desc.m_bAllowShaderResourceView = true;
+    desc.m_ResourceAccess.m_bImmutable = false;
+
+    hBuffer = pDevice->CreateBuffer(desc);
+  }
+} // namespace
 
-    {
-      desc.m_uiStructSize = sizeof(ezUInt32);
-      desc.m_uiTotalSize = desc.m_uiStructSize * ezClusteredDataCPU::MAX_ITEMS_PER_CLUSTER * NUM_CLUSTERS;
+ezClusteredDataGPU::ezClusteredDataGPU()
+{
+  ezGALDevice* pDevice = ezGALDevice::GetDefaultDevice();
 
-      m_hClusterItemBuffer = pDevice->CreateBuffer(desc);
-    }
+  EnsureBufferSizes(INITIAL_LIGHT_DATA, INITIAL_DECAL_DATA, INITIAL_ITEMS_PER_CLUSTER * NUM_CLUSTERS);
+
+  {
+    ezGALBufferCreationDescription desc;
+    desc.m_uiStructSize = sizeof(ezPerClusterData);
+    desc.m_uiTotalSize = desc.m_uiStructSize * NUM_CLUSTERS;
+    desc.m_BufferType = ezGALBufferType::Generic;
+    desc.m_bUseAsStructuredBuffer = true;
+    desc.m_bAllowShaderResourceView = true;
+    desc.m_ResourceAccess.m_bImmutable = false;
+
+    m_hClusterDataBuffer = pDevice->CreateBuffer(desc);
   }
 
   m_hConstantBuffer = ezRenderContext::CreateConstantBufferStorage<ezClusteredDataConstants>();
@@ -96,6 +106,13 @@ ezClusteredDataGPU::~ezClusteredDataGPU()
   ezRenderContext::DeleteConstantBufferStorage(m_hConstantBuffer);
 }
 
+void ezClusteredDataGPU::EnsureBufferSizes(ezUInt32 uiNumLights, ezUInt32 uiNumDecals, ezUInt32 uiNumClusterItems)
+{
+  EnsureStructuredBufferSize(m_hLightDataBuffer, m_uiLightDataCapacity, uiNumLights, sizeof(ezPerLightData));
+  EnsureStructuredBufferSize(m_hDecalDataBuffer, m_uiDecalDataCapacity, uiNumDecals, sizeof(ezPerDecalData));
+  EnsureStructuredBufferSize(m_hClusterItemBuffer, m_uiClusterItemCapacity, uiNumClusterItems, sizeof(ezUInt32));
+}
+
 void ezClusteredDataGPU::BindResources(ezRenderContext* pRenderContext)
 {
   ezGALDevice* pDevice = ezGALDevice::GetDefaultDevice();
@@ -146,6 +163,8 @@ void* ezClusteredDataProvider::UpdateData(const ezRenderViewContext& renderViewC
 
   if (auto pData = extractedData.GetFrameData<ezClusteredDataCPU>())
   {
+    m_Data.EnsureBufferSizes(pData->m_LightData.GetCount(), pData->m_DecalData.GetCount(), pData->m_ClusterItemList.GetCount());
+
     // Update buffer
     if (!pData->m_ClusterItemList.IsEmpty())
     {
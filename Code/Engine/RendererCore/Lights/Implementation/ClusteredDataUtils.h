@@ -245,9 +245,9 @@ namespace
     return ezSimdBBox(mi, ma);
   }
 
-  template <typename Cluster, typename IntersectionFunc>
-  EZ_FORCE_INLINE void FillCluster(const ezSimdBBox& screenSpaceBounds, ezUInt32 uiBlockIndex, ezUInt32 uiMask, Cluster* clusters,
-    IntersectionFunc func)
+  /// \brief Computes the range of clusters that is covered by the given screen space bounds.
+  template <typename Range>
+  EZ_FORCE_INLINE void GetClusterRange(const ezSimdBBox& screenSpaceBounds, Range& out_Range)
   {
     ezSimdVec4f scale = ezSimdVec4f(0.5f * NUM_CLUSTERS_X, -0.5f * NUM_CLUSTERS_Y, 1.0f, 1.0f);
     ezSimdVec4f bias = ezSimdVec4f(0.5f * NUM_CLUSTERS_X, 0.5f * NUM_CLUSTERS_Y, 0.0f, 0.0f);
@@ -261,55 +261,47 @@ namespace
     minXY_maxXY = minXY_maxXY.CompMin(maxClusterIndex - ezSimdVec4i(1));
     minXY_maxXY = minXY_maxXY.CompMax(ezSimdVec4i::ZeroVector());
 
-    ezUInt32 xMin = minXY_maxXY.x();
-    ezUInt32 yMin = minXY_maxXY.w();
+    out_Range.m_uiMinX = static_cast<ezUInt8>(minXY_maxXY.x());
+    out_Range.m_uiMinY = static_cast<ezUInt8>(minXY_maxXY.w());
 
-    ezUInt32 xMax = minXY_maxXY.z();
-    ezUInt32 yMax = minXY_maxXY.y();
+    out_Range.m_uiMaxX = static_cast<ezUInt8>(minXY_maxXY.z());
+    out_Range.m_uiMaxY = static_cast<ezUInt8>(minXY_maxXY.y());
 
-    ezUInt32 zMin = GetSliceIndexFromDepth(screenSpaceBounds.m_Min.z());
-    ezUInt32 zMax = GetSliceIndexFromDepth(screenSpaceBounds.m_Max.z());
+    out_Range.m_uiMinZ = static_cast<ezUInt8>(GetSliceIndexFromDepth(screenSpaceBounds.m_Min.z()));
+    out_Range.m_uiMaxZ = static_cast<ezUInt8>(GetSliceIndexFromDepth(screenSpaceBounds.m_Max.z()));
+  }
+
+  /// \brief Sets the bit of the given item in all clusters of the range that lie within the depth slices [uiStartSlice, uiEndSlice)
+  /// and pass the intersection test. Every cluster stores uiNumBlocks bit mask blocks in pClusterBitMasks.
+  template <typename Range, typename IntersectionFunc>
+  EZ_FORCE_INLINE void FillClusters(const Range& range, ezUInt32 uiStartSlice, ezUInt32 uiEndSlice, ezUInt32 uiItemIndex, ezUInt32 uiNumBlocks,
+    ezUInt32* pClusterBitMasks, IntersectionFunc func)
+  {
+    const ezUInt32 zMin = ezMath::Max<ezUInt32>(range.m_uiMinZ, uiStartSlice);
+    const ezUInt32 zMax = ezMath::Min<ezUInt32>(range.m_uiMaxZ + 1, uiEndSlice);
+
+    const ezUInt32 uiBlockIndex = uiItemIndex / 32;
+    const ezUInt32 uiMask = 1u << (uiItemIndex - uiBlockIndex * 32);
 
-    for (ezUInt32 z = zMin; z <= zMax; ++z)
+    for (ezUInt32 z = zMin; z < zMax; ++z)
     {
-      for (ezUInt32 y = yMin; y <= yMax; ++y)
+      for (ezUInt32 y = range.m_uiMinY; y <= range.m_uiMaxY; ++y)
       {
-        for (ezUInt32 x = xMin; x <= xMax; ++x)
+        for (ezUInt32 x = range.m_uiMinX; x <= range.m_uiMaxX; ++x)
         {
           ezUInt32 uiClusterIndex = GetClusterIndexFromCoord(x, y, z);
           if (func(uiClusterIndex))
           {
-            clusters[uiClusterIndex].m_BitMask[uiBlockIndex] |= uiMask;
+            pClusterBitMasks[uiClusterIndex * uiNumBlocks + uiBlockIndex] |= uiMask;
           }
         }
       }
     }
   }
 
-  template <typename Cluster>
-  void RasterizePointLight(const ezSimdBSphere& pointLightSphere, ezUInt32 uiLightIndex, const ezSimdMat4f& viewMatrix,
-    const ezSimdMat4f& projectionMatrix, Cluster* clusters, ezSimdBSphere* clusterBoundingSpheres)
-  {
-    ezSimdBBox screenSpaceBounds = GetScreenSpaceBounds(pointLightSphere, viewMatrix, projectionMatrix);
-
-    const ezUInt32 uiBlockIndex = uiLightIndex / 32;
-    const ezUInt32 uiMask = 1 << (uiLightIndex - uiBlockIndex * 32);
-
-    FillCluster(screenSpaceBounds, uiBlockIndex, uiMask, clusters,
-      [&](ezUInt32 uiClusterIndex) { return pointLightSphere.Overlaps(clusterBoundingSpheres[uiClusterIndex]); });
-  }
-
-  struct BoundingCone
-  {
-    ezSimdBSphere m_BoundingSphere;
-    ezSimdVec4f m_PositionAndRange;
-    ezSimdVec4f m_ForwardDir;
-    ezSimdVec4f m_SinCosAngle;
-  };
-
-  template <typename Cluster>
-  void RasterizeSpotLight(const BoundingCone& spotLightCone, ezUInt32 uiLightIndex, const ezSimdMat4f& viewMatrix,
-    const ezSimdMat4f& projectionMatrix, Cluster* clusters, ezSimdBSphere* clusterBoundingSpheres)
+  /// \brief Calculates a bounding sphere around a spot light cone, used to get the min and max bounds.
+  template <typename Cone>
+  EZ_FORCE_INLINE ezSimdBSphere GetSpotLightBoundingSphere(const Cone& spotLightCone)
   {
     ezSimdVec4f position = spotLightCone.m_PositionAndRange;
     ezSimdFloat range = spotLightCone.m_PositionAndRange.w();
@@ -317,7 +309,6 @@ namespace
     ezSimdFloat sinAngle = spotLightCone.m_SinCosAngle.x();
     ezSimdFloat cosAngle = spotLightCone.m_SinCosAngle.y();
 
-    // First calculate a bounding sphere around the cone to get min and max bounds
     ezSimdVec4f bSphereCenter;
     ezSimdFloat bSphereRadius;
     if (sinAngle > 0.707107f) // sin(45)
@@ -331,48 +322,34 @@ namespace
       bSphereCenter = position + forwardDir * bSphereRadius;
     }
 
-    ezSimdBSphere spotLightSphere(bSphereCenter, bSphereRadius);
-    ezSimdBBox screenSpaceBounds = GetScreenSpaceBounds(spotLightSphere, viewMatrix, projectionMatrix);
-
-    const ezUInt32 uiBlockIndex = uiLightIndex / 32;
-    const ezUInt32 uiMask = 1 << (uiLightIndex - uiBlockIndex * 32);
-
-    FillCluster(screenSpaceBounds, uiBlockIndex, uiMask, clusters, [&](ezUInt32 uiClusterIndex) {
-      ezSimdBSphere clusterSphere = clusterBoundingSpheres[uiClusterIndex];
-      ezSimdFloat clusterRadius = clusterSphere.GetRadius();
+    return ezSimdBSphere(bSphereCenter, bSphereRadius);
+  }
 
-      ezSimdVec4f toConePos = clusterSphere.m_CenterAndRadius - position;
-      ezSimdFloat projected = forwardDir.Dot<3>(toConePos);
-      ezSimdFloat distToConeSq = toConePos.Dot<3>(toConePos);
-      ezSimdFloat distClosestP = cosAngle * (distToConeSq - projected * projected).GetSqrt() - projected * sinAngle;
+  template <typename Cone>
+  EZ_FORCE_INLINE bool SpotLightOverlaps(const Cone& spotLightCone, const ezSimdBSphere& clusterSphere)
+  {
+    ezSimdVec4f position = spotLightCone.m_PositionAndRange;
+    ezSimdFloat range = spotLightCone.m_PositionAndRange.w();
+    ezSimdVec4f forwardDir = spotLightCone.m_ForwardDir;
+    ezSimdFloat sinAngle = spotLightCone.m_SinCosAngle.x();
+    ezSimdFloat cosAngle = spotLightCone.m_SinCosAngle.y();
 
-      bool angleCull = distClosestP > clusterRadius;
-      bool frontCull = projected > clusterRadius + range;
-      bool backCull = projected < -clusterRadius;
+    ezSimdFloat clusterRadius = clusterSphere.GetRadius();
 
-      return !(angleCull || frontCull || backCull);
-    });
-  }
+    ezSimdVec4f toConePos = clusterSphere.m_CenterAndRadius - position;
+    ezSimdFloat projected = forwardDir.Dot<3>(toConePos);
+    ezSimdFloat distToConeSq = toConePos.Dot<3>(toConePos);
+    ezSimdFloat distClosestP = cosAngle * (distToConeSq - projected * projected).GetSqrt() - projected * sinAngle;
 
-  template <typename Cluster>
-  void RasterizeDirLight(const ezDirectionalLightRenderData* pDirLightRenderData, ezUInt32 uiLightIndex, ezArrayPtr<Cluster> clusters)
-  {
-    const ezUInt32 uiBlockIndex = uiLightIndex / 32;
-    const ezUInt32 uiMask = 1 << (uiLightIndex - uiBlockIndex * 32);
+    bool angleCull = distClosestP > clusterRadius;
+    bool frontCull = projected > clusterRadius + range;
+    bool backCull = projected < -clusterRadius;
 
-    for (ezUInt32 i = 0; i < clusters.GetCount(); ++i)
-    {
-      clusters[i].m_BitMask[uiBlockIndex] |= uiMask;
-    }
+    return !(angleCull || frontCull || backCull);
   }
 
-  template <typename Cluster>
-  void RasterizeDecal(const ezDecalRenderData* pDecalRenderData, ezUInt32 uiDecalIndex, const ezSimdMat4f& viewProjectionMatrix,
-    Cluster* clusters, ezSimdBSphere* clusterBoundingSpheres)
+  EZ_FORCE_INLINE ezSimdBBox GetDecalScreenSpaceBounds(const ezSimdMat4f& decalToWorld, const ezSimdMat4f& viewProjectionMatrix)
   {
-    ezSimdMat4f decalToWorld = ezSimdConversion::ToTransform(pDecalRenderData->m_GlobalTransform).GetAsMat4();
-    ezSimdMat4f worldToDecal = decalToWorld.GetInverse();
-
     ezVec3 corners[8];
     ezBoundingBox(ezVec3(-1), ezVec3(1)).GetCorners(corners);
 
@@ -400,17 +377,16 @@ namespace
       screenSpaceBounds.m_Max = ezSimdVec4f(1.0f).GetCombined<ezSwizzle::XYZW>(screenSpaceBounds.m_Max);
     }
 
+    return screenSpaceBounds;
+  }
+
+  EZ_FORCE_INLINE bool DecalOverlaps(const ezSimdMat4f& worldToDecal, ezSimdBSphere clusterSphere)
+  {
     ezSimdVec4f decalHalfExtents = ezSimdVec4f(1.0f);
     ezSimdBBox localDecalBounds = ezSimdBBox(-decalHalfExtents, decalHalfExtents);
 
-    const ezUInt32 uiBlockIndex = uiDecalIndex / 32;
-    const ezUInt32 uiMask = 1 << (uiDecalIndex - uiBlockIndex * 32);
-
-    FillCluster(screenSpaceBounds, uiBlockIndex, uiMask, clusters, [&](ezUInt32 uiClusterIndex) {
-      ezSimdBSphere clusterSphere = clusterBoundingSpheres[uiClusterIndex];
-      clusterSphere.Transform(worldToDecal);
+    clusterSphere.Transform(worldToDecal);
 
-      return localDecalBounds.Overlaps(clusterSphere);
-    });
+    return localDecalBounds.Overlaps(clusterSphere);
   }
 } // namespace
@@ -401,6 +401,102 @@ ezBoundingBoxSphere ezMeshBufferResourceDescriptor::ComputeBounds() const
   return bounds;
 }
 
+ezResult ezMeshBufferResourceDescriptor::OptimizeVertexOrder(ezArrayPtr<const ezUInt32> primitiveRangeStarts, float& out_fAcmrBefore,
+  float& out_fAcmrAfter)
+{
+  if (m_Topology != ezGALPrimitiveTopology::Triangles || !HasIndexBuffer())
+    return EZ_FAILURE;
+
+  const ezUInt32 uiNumIndices = GetPrimitiveCount() * 3;
+
+  ezDynamicArray<ezUInt32> indices;
+  indices.SetCountUninitialized(uiNumIndices);
+
+  if (Uses32BitIndices())
+  {
+    ezMemoryUtils::Copy(indices.GetData(), reinterpret_cast<const ezUInt32*>(m_IndexBufferData.GetData()), uiNumIndices);
+  }
+  else
+  {
+    const ezUInt16* pIndices = reinterpret_cast<const ezUInt16*>(m_IndexBufferData.GetData());
+    for (ezUInt32 i = 0; i < uiNumIndices; ++i)
+    {
+      indices[i] = pIndices[i];
+    }
+  }
+
+  out_fAcmrBefore = ezMeshBufferUtils::ComputeAcmr(indices, m_uiVertexCount);
+
+  // the overdraw optimization needs the positions, meshes without a usable position stream only get the cache optimization
+  ezDynamicArray<ezVec3> positions;
+  for (const ezVertexStreamInfo& stream : m_VertexDeclaration.m_VertexStreams)
+  {
+    if (stream.m_Semantic == ezGALVertexAttributeSemantic::Position && stream.m_Format == ezGALResourceFormat::XYZFloat)
+    {
+      positions.SetCountUninitialized(m_uiVertexCount);
+      for (ezUInt32 v = 0; v < m_uiVertexCount; ++v)
+      {
+        positions[v] = *reinterpret_cast<const ezVec3*>(&m_VertexStreamData[v * m_uiVertexSize + stream.m_uiOffset]);
+      }
+      break;
+    }
+  }
+
+  ezHybridArray<ezUInt32, 16> rangeStarts;
+  rangeStarts.PushBackRange(primitiveRangeStarts);
+  rangeStarts.PushBack(0);
+  rangeStarts.PushBack(GetPrimitiveCount());
+  rangeStarts.Sort();
+
+  for (ezUInt32 i = 1; i < rangeStarts.GetCount(); ++i)
+  {
+    const ezUInt32 uiFirstPrimitive = ezMath::Min(rangeStarts[i - 1], GetPrimitiveCount());
+    const ezUInt32 uiEndPrimitive = ezMath::Min(rangeStarts[i], GetPrimitiveCount());
+
+    if (uiEndPrimitive > uiFirstPrimitive)
+    {
+      ezArrayPtr<ezUInt32> rangeIndices = indices.GetArrayPtr().GetSubArray(uiFirstPrimitive * 3, (uiEndPrimitive - uiFirstPrimitive) * 3);
+
+      ezMeshBufferUtils::OptimizeVertexCache(rangeIndices, m_uiVertexCount);
+
+      if (!positions.IsEmpty())
+      {
+        ezMeshBufferUtils::OptimizeOverdraw(positions, rangeIndices);
+      }
+    }
+  }
+
+  ezDynamicArray<ezUInt32> vertexRemap;
+  ezMeshBufferUtils::OptimizeVertexFetch(indices, m_uiVertexCount, vertexRemap);
+
+  out_fAcmrAfter = ezMeshBufferUtils::ComputeAcmr(indices, m_uiVertexCount);
+
+  ezDynamicArray<ezUInt8> vertexData;
+  vertexData.SetCountUninitialized(m_VertexStreamData.GetCount());
+
+  for (ezUInt32 v = 0; v < m_uiVertexCount; ++v)
+  {
+    ezMemoryUtils::Copy(&vertexData[vertexRemap[v] * m_uiVertexSize], &m_VertexStreamData[v * m_uiVertexSize], m_uiVertexSize);
+  }
+
+  m_VertexStreamData = std::move(vertexData);
+
+  if (Uses32BitIndices())
+  {
+    ezMemoryUtils::Copy(reinterpret_cast<ezUInt32*>(m_IndexBufferData.GetData()), indices.GetData(), uiNumIndices);
+  }
+  else
+  {
+    ezUInt16* pIndices = reinterpret_cast<ezUInt16*>(m_IndexBufferData.GetData());
+    for (ezUInt32 i = 0; i < uiNumIndices; ++i)
+    {
+      pIndices[i] = static_cast<ezUInt16>(indices[i]);
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
 //////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////
@@ -1,5 +1,6 @@
 #include <RendererCorePCH.h>
 
+#include <Foundation/Math/BoundingBox.h>
 #include <Foundation/Math/Float16.h>
 #include <RendererCore/Meshes/MeshBufferUtils.h>
 
@@ -314,3 +315,771 @@ ezResult ezMeshBufferUtils::DecodeToVec4(ezArrayPtr<const ezUInt8> source, ezGAL
       return EZ_FAILURE;
   }
 }
+
+namespace
+{
+  /// \brief The sum of squared distances to a set of planes, stored as a symmetric 4x4 matrix.
+  struct Quadric
+  {
+    double m_fA2 = 0, m_fAB = 0, m_fAC = 0, m_fAD = 0;
+    double m_fB2 = 0, m_fBC = 0, m_fBD = 0;
+    double m_fC2 = 0, m_fCD = 0;
+    double m_fD2 = 0;
+    double m_fWeight = 0;
+
+    void AddPlane(const ezVec3& vNormal, float fDistance, double fWeight)
+    {
+      const double a = vNormal.x, b = vNormal.y, c = vNormal.z, d = fDistance;
+
+      m_fA2 += fWeight * a * a;
+      m_fAB += fWeight * a * b;
+      m_fAC += fWeight * a * c;
+      m_fAD += fWeight * a * d;
+      m_fB2 += fWeight * b * b;
+      m_fBC += fWeight * b * c;
+      m_fBD += fWeight * b * d;
+      m_fC2 += fWeight * c * c;
+      m_fCD += fWeight * c * d;
+      m_fD2 += fWeight * d * d;
+      m_fWeight += fWeight;
+    }
+
+    void operator+=(const Quadric& q)
+    {
+      m_fA2 += q.m_fA2;
+      m_fAB += q.m_fAB;
+      m_fAC += q.m_fAC;
+      m_fAD += q.m_fAD;
+      m_fB2 += q.m_fB2;
+      m_fBC += q.m_fBC;
+      m_fBD += q.m_fBD;
+      m_fC2 += q.m_fC2;
+      m_fCD += q.m_fCD;
+      m_fD2 += q.m_fD2;
+      m_fWeight += q.m_fWeight;
+    }
+
+    /// \brief Returns the area weighted average of the squared distances of the point to all planes.
+    double ComputeError(const Quadric& other, const ezVec3& vPos) const
+    {
+      const double x = vPos.x, y = vPos.y, z = vPos.z;
+
+      const double fError = (m_fA2 + other.m_fA2) * x * x + 2.0 * (m_fAB + other.m_fAB) * x * y + 2.0 * (m_fAC + other.m_fAC) * x * z +
+                            2.0 * (m_fAD + other.m_fAD) * x + (m_fB2 + other.m_fB2) * y * y + 2.0 * (m_fBC + other.m_fBC) * y * z +
+                            2.0 * (m_fBD + other.m_fBD) * y + (m_fC2 + other.m_fC2) * z * z + 2.0 * (m_fCD + other.m_fCD) * z +
+                            (m_fD2 + other.m_fD2);
+
+      const double fWeight = m_fWeight + other.m_fWeight;
+      return fWeight > 0.0 ? ezMath::Max(fError, 0.0) / fWeight : 0.0;
+    }
+  };
+
+  struct EdgeCollapse
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    double m_fError;
+    ezUInt32 m_uiFrom;
+    ezUInt32 m_uiTo;
+  };
+
+  EZ_ALWAYS_INLINE ezUInt64 MakeEdgeKey(ezUInt32 a, ezUInt32 b)
+  {
+    return a < b ? (static_cast<ezUInt64>(a) << 32) | b : (static_cast<ezUInt64>(b) << 32) | a;
+  }
+
+  EZ_ALWAYS_INLINE ezVec3 ComputeTriangleNormal(const ezVec3& p0, const ezVec3& p1, const ezVec3& p2)
+  {
+    return (p1 - p0).CrossRH(p2 - p0);
+  }
+} // namespace
+
+void ezMeshBufferUtils::SimplifyTriangles(ezArrayPtr<const ezVec3> positions, ezArrayPtr<const ezUInt32> indices,
+  ezUInt32 uiTargetTriangleCount, float fMaxError, ezDynamicArray<ezUInt32>& out_Indices)
+{
+  EZ_ASSERT_DEV(indices.GetCount() % 3 == 0, "The index count ({0}) is not a multiple of three.", indices.GetCount());
+
+  out_Indices = indices;
+
+  const ezUInt32 uiNumVertices = positions.GetCount();
+  ezUInt32 uiNumTriangles = out_Indices.GetCount() / 3;
+
+  if (uiNumTriangles <= uiTargetTriangleCount)
+    return;
+
+  ezDynamicArray<bool> locked;
+  locked.SetCount(uiNumVertices);
+
+  // several vertices at the same position form an attribute seam (e.g. texture coordinates or hard normals), removing one of them
+  // would tear the surface apart
+  {
+    ezDynamicArray<ezUInt32> sortedVertices;
+    sortedVertices.SetCountUninitialized(uiNumVertices);
+    for (ezUInt32 i = 0; i < uiNumVertices; ++i)
+    {
+      sortedVertices[i] = i;
+    }
+
+    sortedVertices.Sort([&](ezUInt32 lhs, ezUInt32 rhs) -> bool {
+      const ezVec3& a = positions[lhs];
+      const ezVec3& b = positions[rhs];
+      if (a.x != b.x)
+        return a.x < b.x;
+      if (a.y != b.y)
+        return a.y < b.y;
+      return a.z < b.z;
+    });
+
+    for (ezUInt32 i = 1; i < uiNumVertices; ++i)
+    {
+      if (positions[sortedVertices[i - 1]] == positions[sortedVertices[i]])
+      {
+        locked[sortedVertices[i - 1]] = true;
+        locked[sortedVertices[i]] = true;
+      }
+    }
+  }
+
+  ezDynamicArray<ezUInt64> edges;
+  edges.Reserve(out_Indices.GetCount());
+
+  // edges that are used by only one triangle lie on an open border, which has to stay where it is
+  {
+    for (ezUInt32 t = 0; t < out_Indices.GetCount(); t += 3)
+    {
+      edges.PushBack(MakeEdgeKey(out_Indices[t + 0], out_Indices[t + 1]));
+      edges.PushBack(MakeEdgeKey(out_Indices[t + 1], out_Indices[t + 2]));
+      edges.PushBack(MakeEdgeKey(out_Indices[t + 2], out_Indices[t + 0]));
+    }
+
+    edges.Sort();
+
+    for (ezUInt32 i = 0; i < edges.GetCount();)
+    {
+      ezUInt32 uiEnd = i + 1;
+      while (uiEnd < edges.GetCount() && edges[uiEnd] == edges[i])
+        ++uiEnd;
+
+      if (uiEnd - i == 1)
+      {
+        locked[static_cast<ezUInt32>(edges[i] >> 32)] = true;
+        locked[static_cast<ezUInt32>(edges[i] & 0xFFFFFFFF)] = true;
+      }
+
+      i = uiEnd;
+    }
+  }
+
+  ezDynamicArray<Quadric> quadrics;
+  quadrics.SetCount(uiNumVertices);
+
+  ezBoundingBox bounds;
+  bounds.SetInvalid();
+
+  for (ezUInt32 t = 0; t < out_Indices.GetCount(); t += 3)
+  {
+    const ezVec3& p0 = positions[out_Indices[t + 0]];
+    const ezVec3& p1 = positions[out_Indices[t + 1]];
+    const ezVec3& p2 = positions[out_Indices[t + 2]];
+
+    bounds.ExpandToInclude(p0);
+    bounds.ExpandToInclude(p1);
+    bounds.ExpandToInclude(p2);
+
+    ezVec3 vNormal = ComputeTriangleNormal(p0, p1, p2);
+    const float fLength = vNormal.GetLength();
+
+    if (fLength <= 0.0f)
+      continue;
+
+    vNormal /= fLength;
+
+    // weighting with the area keeps large flat regions from being dominated by many small triangles
+    const float fDistance = -vNormal.Dot(p0);
+    const double fArea = fLength * 0.5;
+
+    quadrics[out_Indices[t + 0]].AddPlane(vNormal, fDistance, fArea);
+    quadrics[out_Indices[t + 1]].AddPlane(vNormal, fDistance, fArea);
+    quadrics[out_Indices[t + 2]].AddPlane(vNormal, fDistance, fArea);
+  }
+
+  const double fMaxErrorAbs = static_cast<double>(fMaxError) * (bounds.m_vMax - bounds.m_vMin).GetLength();
+  const double fMaxErrorSquared = fMaxErrorAbs * fMaxErrorAbs;
+
+  ezDynamicArray<ezUInt32> adjacencyOffsets;
+  ezDynamicArray<ezUInt32> adjacency;
+  ezDynamicArray<EdgeCollapse> collapses;
+  ezDynamicArray<bool> touched;
+  ezDynamicArray<ezUInt32> remap;
+  remap.SetCountUninitialized(uiNumVertices);
+
+  // every pass collapses a set of independent edges, cheapest first, and then rebuilds the index buffer
+  while (uiNumTriangles > uiTargetTriangleCount)
+  {
+    // vertex to triangle adjacency
+    {
+      adjacencyOffsets.Clear();
+      adjacencyOffsets.SetCount(uiNumVertices + 1);
+
+      for (ezUInt32 uiIndex : out_Indices)
+      {
+        adjacencyOffsets[uiIndex + 1]++;
+      }
+
+      for (ezUInt32 i = 0; i < uiNumVertices; ++i)
+      {
+        adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+      }
+
+      adjacency.SetCountUninitialized(out_Indices.GetCount());
+
+      for (ezUInt32 i = 0; i < out_Indices.GetCount(); ++i)
+      {
+        adjacency[adjacencyOffsets[out_Indices[i]]++] = i / 3;
+      }
+
+      // the fill loop advanced every offset to the start of the next vertex, shift them back
+      for (ezUInt32 i = uiNumVertices; i > 0; --i)
+      {
+        adjacencyOffsets[i] = adjacencyOffsets[i - 1];
+      }
+
+      adjacencyOffsets[0] = 0;
+    }
+
+    // collapse candidates, in both directions of every edge
+    {
+      edges.Clear();
+
+      for (ezUInt32 t = 0; t < out_Indices.GetCount(); t += 3)
+      {
+        edges.PushBack(MakeEdgeKey(out_Indices[t + 0], out_Indices[t + 1]));
+        edges.PushBack(MakeEdgeKey(out_Indices[t + 1], out_Indices[t + 2]));
+        edges.PushBack(MakeEdgeKey(out_Indices[t + 2], out_Indices[t + 0]));
+      }
+
+      edges.Sort();
+
+      collapses.Clear();
+
+      for (ezUInt32 i = 0; i < edges.GetCount(); ++i)
+      {
+        if (i > 0 && edges[i] == edges[i - 1])
+          continue;
+
+        const ezUInt32 a = static_cast<ezUInt32>(edges[i] >> 32);
+        const ezUInt32 b = static_cast<ezUInt32>(edges[i] & 0xFFFFFFFF);
+
+        if (!locked[a])
+        {
+          collapses.PushBack({quadrics[a].ComputeError(quadrics[b], positions[b]), a, b});
+        }
+
+        if (!locked[b])
+        {
+          collapses.PushBack({quadrics[b].ComputeError(quadrics[a], positions[a]), b, a});
+        }
+      }
+
+      collapses.Sort([](const EdgeCollapse& lhs, const EdgeCollapse& rhs) -> bool { return lhs.m_fError < rhs.m_fError; });
+    }
+
+    touched.Clear();
+    touched.SetCount(uiNumVertices);
+
+    for (ezUInt32 i = 0; i < uiNumVertices; ++i)
+    {
+      remap[i] = i;
+    }
+
+    ezUInt32 uiNumCollapsed = 0;
+    ezUInt32 uiTrianglesLeft = uiNumTriangles;
+
+    for (const EdgeCollapse& collapse : collapses)
+    {
+      if (collapse.m_fError > fMaxErrorSquared || uiTrianglesLeft <= uiTargetTriangleCount)
+        break;
+
+      const ezUInt32 uiFrom = collapse.m_uiFrom;
+      const ezUInt32 uiTo = collapse.m_uiTo;
+
+      if (touched[uiFrom] || touched[uiTo])
+        continue;
+
+      // the remaining triangles around the removed vertex must not flip over
+      bool bFlips = false;
+      ezUInt32 uiRemoved = 0;
+
+      for (ezUInt32 a = adjacencyOffsets[uiFrom]; a < adjacencyOffsets[uiFrom + 1]; ++a)
+      {
+        const ezUInt32* pTriangle = &out_Indices[adjacency[a] * 3];
+
+        if (pTriangle[0] == uiTo || pTriangle[1] == uiTo || pTriangle[2] == uiTo)
+        {
+          ++uiRemoved;
+          continue;
+        }
+
+        const ezVec3& p0 = positions[pTriangle[0] == uiFrom ? uiTo : pTriangle[0]];
+        const ezVec3& p1 = positions[pTriangle[1] == uiFrom ? uiTo : pTriangle[1]];
+        const ezVec3& p2 = positions[pTriangle[2] == uiFrom ? uiTo : pTriangle[2]];
+
+        const ezVec3 vOldNormal = ComputeTriangleNormal(positions[pTriangle[0]], positions[pTriangle[1]], positions[pTriangle[2]]);
+
+        if (vOldNormal.Dot(ComputeTriangleNormal(p0, p1, p2)) <= 0.0f)
+        {
+          bFlips = true;
+          break;
+        }
+      }
+
+      if (bFlips)
+        continue;
+
+      // any triangle around the removed vertex changes, so none of its vertices may take part in another collapse in this pass
+      for (ezUInt32 a = adjacencyOffsets[uiFrom]; a < adjacencyOffsets[uiFrom + 1]; ++a)
+      {
+        const ezUInt32* pTriangle = &out_Indices[adjacency[a] * 3];
+        touched[pTriangle[0]] = true;
+        touched[pTriangle[1]] = true;
+        touched[pTriangle[2]] = true;
+      }
+
+      remap[uiFrom] = uiTo;
+      quadrics[uiTo] += quadrics[uiFrom];
+
+      uiTrianglesLeft -= ezMath::Min(uiRemoved, uiTrianglesLeft);
+      ++uiNumCollapsed;
+    }
+
+    if (uiNumCollapsed == 0)
+      break;
+
+    // apply the collapses and drop the triangles that became degenerate
+    ezUInt32 uiWrite = 0;
+    for (ezUInt32 t = 0; t < out_Indices.GetCount(); t += 3)
+    {
+      const ezUInt32 a = remap[out_Indices[t + 0]];
+      const ezUInt32 b = remap[out_Indices[t + 1]];
+      const ezUInt32 c = remap[out_Indices[t + 2]];
+
+      if (a == b || b == c || c == a)
+        continue;
+
+      out_Indices[uiWrite + 0] = a;
+      out_Indices[uiWrite + 1] = b;
+      out_Indices[uiWrite + 2] = c;
+      uiWrite += 3;
+    }
+
+    out_Indices.SetCountUninitialized(uiWrite);
+    uiNumTriangles = uiWrite / 3;
+  }
+}
+
+namespace
+{
+  constexpr ezUInt32 s_uiVertexCacheSize = 32;
+
+  /// \brief The vertex score from Tom Forsyth's "Linear-Speed Vertex Cache Optimisation".
+  float ComputeVertexCacheScore(ezInt32 iCachePosition, ezUInt32 uiNumRemainingTriangles)
+  {
+    if (uiNumRemainingTriangles == 0)
+      return -1.0f;
+
+    float fScore = 0.0f;
+
+    if (iCachePosition >= 0)
+    {
+      if (iCachePosition < 3)
+      {
+        // the vertices of the last triangle get a fixed score, otherwise the optimizer prefers strips, which are bad for the cache
+        fScore = 0.75f;
+      }
+      else
+      {
+        const float fScale = 1.0f / (s_uiVertexCacheSize - 3);
+        fScore = ezMath::Pow(1.0f - (iCachePosition - 3) * fScale, 1.5f);
+      }
+    }
+
+    // vertices with few remaining triangles are preferred, so that they are finished and do not stay around as lone triangles
+    return fScore + 2.0f * ezMath::Pow(static_cast<float>(uiNumRemainingTriangles), -0.5f);
+  }
+} // namespace
+
+void ezMeshBufferUtils::OptimizeVertexCache(ezArrayPtr<ezUInt32> inout_Indices, ezUInt32 uiNumVertices)
+{
+  EZ_ASSERT_DEV(inout_Indices.GetCount() % 3 == 0, "The index count ({0}) is not a multiple of three.", inout_Indices.GetCount());
+
+  const ezUInt32 uiNumTriangles = inout_Indices.GetCount() / 3;
+
+  if (uiNumTriangles == 0)
+    return;
+
+  // vertex to triangle adjacency, the first numRemaining entries of every vertex are the triangles that have not been emitted yet
+  ezDynamicArray<ezUInt32> adjacencyOffsets;
+  adjacencyOffsets.SetCount(uiNumVertices + 1);
+
+  for (ezUInt32 uiIndex : inout_Indices)
+  {
+    adjacencyOffsets[uiIndex + 1]++;
+  }
+
+  for (ezUInt32 i = 0; i < uiNumVertices; ++i)
+  {
+    adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+  }
+
+  ezDynamicArray<ezUInt32> numRemaining;
+  numRemaining.SetCount(uiNumVertices);
+
+  ezDynamicArray<ezUInt32> adjacency;
+  adjacency.SetCountUninitialized(inout_Indices.GetCount());
+
+  for (ezUInt32 i = 0; i < inout_Indices.GetCount(); ++i)
+  {
+    const ezUInt32 v = inout_Indices[i];
+    adjacency[adjacencyOffsets[v] + numRemaining[v]++] = i / 3;
+  }
+
+  ezDynamicArray<ezInt32> cachePositions;
+  cachePositions.SetCountUninitialized(uiNumVertices);
+
+  ezDynamicArray<float> vertexScores;
+  vertexScores.SetCountUninitialized(uiNumVertices);
+
+  for (ezUInt32 v = 0; v < uiNumVertices; ++v)
+  {
+    cachePositions[v] = -1;
+    vertexScores[v] = ComputeVertexCacheScore(-1, numRemaining[v]);
+  }
+
+  ezDynamicArray<float> triangleScores;
+  triangleScores.SetCountUninitialized(uiNumTriangles);
+
+  ezDynamicArray<bool> emitted;
+  emitted.SetCount(uiNumTriangles);
+
+  ezUInt32 uiBestTriangle = 0;
+
+  for (ezUInt32 t = 0; t < uiNumTriangles; ++t)
+  {
+    const ezUInt32* pTriangle = &inout_Indices[t * 3];
+    triangleScores[t] = vertexScores[pTriangle[0]] + vertexScores[pTriangle[1]] + vertexScores[pTriangle[2]];
+
+    if (triangleScores[t] > triangleScores[uiBestTriangle])
+      uiBestTriangle = t;
+  }
+
+  ezDynamicArray<ezUInt32> sortedIndices;
+  sortedIndices.Reserve(inout_Indices.GetCount());
+
+  // the cache temporarily holds three more entries, the vertices that were pushed out by the last triangle
+  ezUInt32 cache[s_uiVertexCacheSize + 3];
+  ezUInt32 newCache[s_uiVertexCacheSize + 3];
+  ezUInt32 uiCacheCount = 0;
+
+  ezUInt32 uiNextUnemitted = 0;
+
+  for (ezUInt32 uiNumEmitted = 0; uiNumEmitted < uiNumTriangles; ++uiNumEmitted)
+  {
+    if (uiBestTriangle == ezInvalidIndex)
+    {
+      // nothing in the cache is connected to any remaining triangle, continue with the next one in the original order
+      while (emitted[uiNextUnemitted])
+        ++uiNextUnemitted;
+
+      uiBestTriangle = uiNextUnemitted;
+    }
+
+    const ezUInt32* pTriangle = &inout_Indices[uiBestTriangle * 3];
+    emitted[uiBestTriangle] = true;
+
+    ezUInt32 uiNewCacheCount = 0;
+
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      const ezUInt32 v = pTriangle[i];
+      sortedIndices.PushBack(v);
+      newCache[uiNewCacheCount++] = v;
+
+      // remove the triangle from the vertex's list of remaining triangles
+      ezUInt32* pAdjacency = &adjacency[adjacencyOffsets[v]];
+      for (ezUInt32 a = 0; a < numRemaining[v]; ++a)
+      {
+        if (pAdjacency[a] == uiBestTriangle)
+        {
+          pAdjacency[a] = pAdjacency[numRemaining[v] - 1];
+          --numRemaining[v];
+          break;
+        }
+      }
+    }
+
+    for (ezUInt32 i = 0; i < uiCacheCount; ++i)
+    {
+      const ezUInt32 v = cache[i];
+
+      if (v != pTriangle[0] && v != pTriangle[1] && v != pTriangle[2])
+        newCache[uiNewCacheCount++] = v;
+    }
+
+    for (ezUInt32 i = 0; i < uiNewCacheCount; ++i)
+    {
+      const ezUInt32 v = newCache[i];
+      cachePositions[v] = (i < s_uiVertexCacheSize) ? static_cast<ezInt32>(i) : -1;
+      vertexScores[v] = ComputeVertexCacheScore(cachePositions[v], numRemaining[v]);
+    }
+
+    // only the triangles around the cached vertices changed their score, the best one of them is emitted next
+    uiBestTriangle = ezInvalidIndex;
+    float fBestScore = -1.0f;
+
+    for (ezUInt32 i = 0; i < uiNewCacheCount; ++i)
+    {
+      const ezUInt32 v = newCache[i];
+
+      for (ezUInt32 a = 0; a < numRemaining[v]; ++a)
+      {
+        const ezUInt32 t = adjacency[adjacencyOffsets[v] + a];
+        const ezUInt32* pOther = &inout_Indices[t * 3];
+
+        triangleScores[t] = vertexScores[pOther[0]] + vertexScores[pOther[1]] + vertexScores[pOther[2]];
+
+        if (triangleScores[t] > fBestScore)
+        {
+          fBestScore = triangleScores[t];
+          uiBestTriangle = t;
+        }
+      }
+    }
+
+    uiCacheCount = ezMath::Min(uiNewCacheCount, s_uiVertexCacheSize);
+    ezMemoryUtils::Copy(cache, newCache, uiCacheCount);
+  }
+
+  ezMemoryUtils::Copy(inout_Indices.GetPtr(), sortedIndices.GetData(), sortedIndices.GetCount());
+}
+
+void ezMeshBufferUtils::OptimizeVertexFetch(ezArrayPtr<ezUInt32> inout_Indices, ezUInt32 uiNumVertices, ezDynamicArray<ezUInt32>& out_VertexRemap)
+{
+  out_VertexRemap.SetCountUninitialized(uiNumVertices);
+
+  for (ezUInt32 v = 0; v < uiNumVertices; ++v)
+  {
+    out_VertexRemap[v] = ezInvalidIndex;
+  }
+
+  ezUInt32 uiNextVertex = 0;
+
+  for (ezUInt32& uiIndex : inout_Indices)
+  {
+    if (out_VertexRemap[uiIndex] == ezInvalidIndex)
+    {
+      out_VertexRemap[uiIndex] = uiNextVertex++;
+    }
+
+    uiIndex = out_VertexRemap[uiIndex];
+  }
+
+  for (ezUInt32 v = 0; v < uiNumVertices; ++v)
+  {
+    if (out_VertexRemap[v] == ezInvalidIndex)
+    {
+      out_VertexRemap[v] = uiNextVertex++;
+    }
+  }
+}
+
+float ezMeshBufferUtils::ComputeAcmr(ezArrayPtr<const ezUInt32> indices, ezUInt32 uiNumVertices, ezUInt32 uiCacheSize)
+{
+  if (indices.GetCount() < 3)
+    return 0.0f;
+
+  // a vertex is in the FIFO cache if fewer than uiCacheSize other vertices were added since it was added itself
+  ezDynamicArray<ezUInt32> cacheTimestamps;
+  cacheTimestamps.SetCount(uiNumVertices);
+
+  ezUInt32 uiTimestamp = uiCacheSize + 1;
+  ezUInt32 uiNumMisses = 0;
+
+  for (ezUInt32 uiIndex : indices)
+  {
+    if (uiTimestamp - cacheTimestamps[uiIndex] > uiCacheSize)
+    {
+      cacheTimestamps[uiIndex] = uiTimestamp++;
+      ++uiNumMisses;
+    }
+  }
+
+  return static_cast<float>(uiNumMisses) / (indices.GetCount() / 3);
+}
+
+namespace
+{
+  constexpr ezUInt32 s_uiOverdrawCacheSize = 16;
+
+  /// \brief Adds the vertices of a triangle to a simulated FIFO cache and returns how many of them were not in the cache yet.
+  ezUInt32 UpdateFifoCache(const ezUInt32* pTriangle, ezDynamicArray<ezUInt32>& inout_CacheTimestamps, ezUInt32& inout_uiTimestamp)
+  {
+    ezUInt32 uiNumMisses = 0;
+
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      if (inout_uiTimestamp - inout_CacheTimestamps[pTriangle[i]] > s_uiOverdrawCacheSize)
+      {
+        inout_CacheTimestamps[pTriangle[i]] = inout_uiTimestamp++;
+        ++uiNumMisses;
+      }
+    }
+
+    return uiNumMisses;
+  }
+} // namespace
+
+void ezMeshBufferUtils::OptimizeOverdraw(ezArrayPtr<const ezVec3> positions, ezArrayPtr<ezUInt32> inout_Indices, float fMaxAcmrIncrease)
+{
+  const ezUInt32 uiNumTriangles = inout_Indices.GetCount() / 3;
+  if (uiNumTriangles < 2)
+    return;
+
+  ezDynamicArray<ezUInt32> cacheTimestamps;
+  cacheTimestamps.SetCount(positions.GetCount());
+  ezUInt32 uiTimestamp = s_uiOverdrawCacheSize + 1;
+
+  auto ResetCache = [&]() { uiTimestamp += s_uiOverdrawCacheSize + 1; };
+
+  // a triangle whose vertices all miss the cache starts a new patch of the mesh, the vertex cache order is kept within each patch
+  ezDynamicArray<ezUInt32> patchStarts;
+  for (ezUInt32 t = 0; t < uiNumTriangles; ++t)
+  {
+    if (UpdateFifoCache(&inout_Indices[t * 3], cacheTimestamps, uiTimestamp) == 3 || t == 0)
+    {
+      patchStarts.PushBack(t);
+    }
+  }
+
+  // split the patches into smaller clusters, as long as each cluster alone is not much worse for the cache than its whole patch
+  ezDynamicArray<ezUInt32> clusterStarts;
+  for (ezUInt32 p = 0; p < patchStarts.GetCount(); ++p)
+  {
+    const ezUInt32 uiStart = patchStarts[p];
+    const ezUInt32 uiEnd = (p + 1 < patchStarts.GetCount()) ? patchStarts[p + 1] : uiNumTriangles;
+
+    ResetCache();
+    ezUInt32 uiPatchMisses = 0;
+    for (ezUInt32 t = uiStart; t < uiEnd; ++t)
+    {
+      uiPatchMisses += UpdateFifoCache(&inout_Indices[t * 3], cacheTimestamps, uiTimestamp);
+    }
+
+    const float fClusterThreshold = fMaxAcmrIncrease * uiPatchMisses / (uiEnd - uiStart);
+
+    clusterStarts.PushBack(uiStart);
+
+    ResetCache();
+    ezUInt32 uiClusterMisses = 0;
+    ezUInt32 uiClusterTriangles = 0;
+    for (ezUInt32 t = uiStart; t < uiEnd; ++t)
+    {
+      uiClusterMisses += UpdateFifoCache(&inout_Indices[t * 3], cacheTimestamps, uiTimestamp);
+      ++uiClusterTriangles;
+
+      if (static_cast<float>(uiClusterMisses) / uiClusterTriangles <= fClusterThreshold)
+      {
+        clusterStarts.PushBack(t + 1);
+
+        ResetCache();
+        uiClusterMisses = 0;
+        uiClusterTriangles = 0;
+      }
+    }
+
+    // the last cluster is usually too small to be any good for the cache, so it is merged with the one before
+    if (clusterStarts.PeekBack() != uiStart)
+    {
+      clusterStarts.PopBack();
+    }
+  }
+
+  // clusters that face away from the center of the mesh are likely to occlude the others, so they are drawn first
+  ezVec3 vMeshCenter = ezVec3::ZeroVector();
+  for (ezUInt32 uiIndex : inout_Indices)
+  {
+    vMeshCenter += positions[uiIndex];
+  }
+  vMeshCenter /= static_cast<float>(inout_Indices.GetCount());
+
+  struct Cluster
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiStart;
+    ezUInt32 m_uiEnd;
+    float m_fSortKey;
+  };
+
+  ezDynamicArray<Cluster> clusters;
+  clusters.Reserve(clusterStarts.GetCount());
+
+  for (ezUInt32 c = 0; c < clusterStarts.GetCount(); ++c)
+  {
+    Cluster& cluster = clusters.ExpandAndGetRef();
+    cluster.m_uiStart = clusterStarts[c];
+    cluster.m_uiEnd = (c + 1 < clusterStarts.GetCount()) ? clusterStarts[c + 1] : uiNumTriangles;
+
+    ezVec3 vCenter = ezVec3::ZeroVector();
+    ezVec3 vNormal = ezVec3::ZeroVector();
+    float fArea = 0.0f;
+
+    for (ezUInt32 t = cluster.m_uiStart; t < cluster.m_uiEnd; ++t)
+    {
+      const ezVec3& p0 = positions[inout_Indices[t * 3 + 0]];
+      const ezVec3& p1 = positions[inout_Indices[t * 3 + 1]];
+      const ezVec3& p2 = positions[inout_Indices[t * 3 + 2]];
+
+      // the length of the cross product is twice the triangle area, which weights larger triangles more
+      const ezVec3 vTriangleNormal = (p1 - p0).CrossRH(p2 - p0);
+      const float fTriangleArea = vTriangleNormal.GetLength();
+
+      vCenter += (p0 + p1 + p2) * (fTriangleArea / 3.0f);
+      vNormal += vTriangleNormal;
+      fArea += fTriangleArea;
+    }
+
+    if (fArea > 0.0f)
+    {
+      vCenter /= fArea;
+    }
+
+    vNormal.NormalizeIfNotZero(ezVec3::ZeroVector()).IgnoreResult();
+
+    cluster.m_fSortKey = (vCenter - vMeshCenter).Dot(vNormal);
+  }
+
+  // a stable sort keeps the original order of clusters that are equally good occluders
+  ezDynamicArray<ezUInt32> order;
+  order.SetCountUninitialized(clusters.GetCount());
+  for (ezUInt32 c = 0; c < clusters.GetCount(); ++c)
+  {
+    order[c] = c;
+  }
+
+  order.Sort([&](ezUInt32 lhs, ezUInt32 rhs) -> bool {
+    if (clusters[lhs].m_fSortKey != clusters[rhs].m_fSortKey)
+      return clusters[lhs].m_fSortKey > clusters[rhs].m_fSortKey;
+
+    return lhs < rhs;
+  });
+
+  ezDynamicArray<ezUInt32> sortedIndices;
+  sortedIndices.Reserve(inout_Indices.GetCount());
+
+  for (ezUInt32 c : order)
+  {
+    sortedIndices.PushBackRange(inout_Indices.GetSubArray(clusters[c].m_uiStart * 3, (clusters[c].m_uiEnd - clusters[c].m_uiStart) * 3));
+  }
+
+  ezMemoryUtils::Copy(inout_Indices.GetPtr(), sortedIndices.GetData(), sortedIndices.GetCount());
+}
@@ -131,27 +131,52 @@ void ezMeshComponent::OnMsgExtractGeometry(ezMsgExtractGeometry& msg) const
     // vert.m_TexCoord.SetZero();
   }
 
-  const bool bFlipTriangles = ezGraphicsUtils::IsTriangleFlipRequired(transform.GetAsMat4().GetRotationalPart());
-  if (bFlipTriangles)
+  // simplified LODs are stored behind the full detail mesh in the same index buffer, only the full detail mesh is extracted
+  ezHybridArray<ezMeshResourceDescriptor::SubMesh, 8> ranges;
   {
-    if (mb.Uses32BitIndices())
+    const ezMeshResourceDescriptor& desc = pCpuMesh->GetDescriptor();
+
+    if (desc.GetLods().IsEmpty())
     {
-      FillIndices<ezUInt32, true>(mb.GetIndexBufferData().GetData(), mb.GetPrimitiveCount(), uiVertexIdxOffset, geo);
+      auto& range = ranges.ExpandAndGetRef();
+      range.m_uiFirstPrimitive = 0;
+      range.m_uiPrimitiveCount = mb.GetPrimitiveCount();
     }
     else
     {
-      FillIndices<ezUInt16, true>(mb.GetIndexBufferData().GetData(), mb.GetPrimitiveCount(), uiVertexIdxOffset, geo);
+      const auto& lod = desc.GetLods()[0];
+      ranges.PushBackRange(desc.GetSubMeshes().GetSubArray(lod.m_uiFirstSubMesh, lod.m_uiNumSubMeshes));
     }
   }
-  else
+
+  const bool bFlipTriangles = ezGraphicsUtils::IsTriangleFlipRequired(transform.GetAsMat4().GetRotationalPart());
+  const ezUInt32 uiIndexSize = mb.Uses32BitIndices() ? sizeof(ezUInt32) : sizeof(ezUInt16);
+
+  for (const auto& range : ranges)
   {
-    if (mb.Uses32BitIndices())
+    const ezUInt8* pIndices = mb.GetIndexBufferData().GetData() + range.m_uiFirstPrimitive * 3 * uiIndexSize;
+
+    if (bFlipTriangles)
     {
-      FillIndices<ezUInt32, false>(mb.GetIndexBufferData().GetData(), mb.GetPrimitiveCount(), uiVertexIdxOffset, geo);
+      if (mb.Uses32BitIndices())
+      {
+        FillIndices<ezUInt32, true>(pIndices, range.m_uiPrimitiveCount, uiVertexIdxOffset, geo);
+      }
+      else
+      {
+        FillIndices<ezUInt16, true>(pIndices, range.m_uiPrimitiveCount, uiVertexIdxOffset, geo);
+      }
     }
     else
     {
-      FillIndices<ezUInt16, false>(mb.GetIndexBufferData().GetData(), mb.GetPrimitiveCount(), uiVertexIdxOffset, geo);
+      if (mb.Uses32BitIndices())
+      {
+        FillIndices<ezUInt32, false>(pIndices, range.m_uiPrimitiveCount, uiVertexIdxOffset, geo);
+      }
+      else
+      {
+        FillIndices<ezUInt16, false>(pIndices, range.m_uiPrimitiveCount, uiVertexIdxOffset, geo);
+      }
     }
   }
 }
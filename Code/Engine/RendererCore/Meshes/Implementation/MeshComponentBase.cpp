@@ -2,11 +2,15 @@
 
 #include <Core/WorldSerializer/WorldReader.h>
 #include <Core/WorldSerializer/WorldWriter.h>
+#include <Foundation/Configuration/CVar.h>
 #include <RendererCore/Meshes/MeshComponentBase.h>
 #include <RendererCore/Messages/SetColorMessage.h>
+#include <RendererCore/Pipeline/View.h>
 #include <RendererCore/RenderWorld/RenderWorld.h>
 #include <RendererFoundation/Device/Device.h>
 
+ezCVarFloat CVarMeshLodBias("r_MeshLodBias", 0.0f, ezCVarFlags::Save, "Mesh LOD bias, every step halves the screen size at which LODs switch");
+
 //////////////////////////////////////////////////////////////////////////
 
 // clang-format off
@@ -160,15 +164,49 @@ ezResult ezMeshComponentBase::GetLocalBounds(ezBoundingBoxSphere& bounds, bool&
   return EZ_FAILURE;
 }
 
+namespace
+{
+  /// \brief Returns the fraction of the view's height that is covered by the bounding sphere.
+  float ComputeScreenSize(const ezView* pView, const ezBoundingBoxSphere& bounds)
+  {
+    const ezCamera* pCamera = pView->GetCullingCamera();
+    const float fAspectRatio = pView->GetViewport().width / pView->GetViewport().height;
+
+    if (pCamera->IsOrthographic())
+    {
+      return 2.0f * bounds.m_fSphereRadius / pCamera->GetDimensionY(fAspectRatio);
+    }
+
+    const float fDistance = (bounds.m_vCenter - pCamera->GetCenterPosition()).GetLength();
+
+    // the camera is inside the sphere
+    if (fDistance <= bounds.m_fSphereRadius)
+      return ezMath::MaxValue<float>();
+
+    return bounds.m_fSphereRadius / (fDistance * ezMath::Tan(pCamera->GetFovY(fAspectRatio) * 0.5f));
+  }
+} // namespace
+
 void ezMeshComponentBase::OnMsgExtractRenderData(ezMsgExtractRenderData& msg) const
 {
   if (!m_hMesh.IsValid())
     return;
 
   ezResourceLock<ezMeshResource> pMesh(m_hMesh, ezResourceAcquireMode::AllowLoadingFallback);
-  ezArrayPtr<const ezMeshResourceDescriptor::SubMesh> parts = pMesh->GetSubMeshes();
 
-  for (ezUInt32 uiPartIndex = 0; uiPartIndex < parts.GetCount(); ++uiPartIndex)
+  ezUInt32 uiLod = 0;
+  const bool bHasLods = pMesh->GetLods().GetCount() > 1;
+
+  if (bHasLods && msg.m_pView != nullptr)
+  {
+    const float fScreenSize = ComputeScreenSize(msg.m_pView, GetOwner()->GetGlobalBounds());
+    uiLod = pMesh->SelectLod(fScreenSize * ezMath::Pow(2.0f, -CVarMeshLodBias));
+  }
+
+  const ezUInt32 uiFirstPart = pMesh->GetLods()[uiLod].m_uiFirstSubMesh;
+  ezArrayPtr<const ezMeshResourceDescriptor::SubMesh> parts = pMesh->GetAllSubMeshes();
+
+  for (ezUInt32 uiPartIndex = uiFirstPart; uiPartIndex < uiFirstPart + pMesh->GetLods()[uiLod].m_uiNumSubMeshes; ++uiPartIndex)
   {
     const ezUInt32 uiMaterialIndex = parts[uiPartIndex].m_uiMaterialIndex;
     ezMaterialResourceHandle hMaterial;
@@ -192,7 +230,8 @@ void ezMeshComponentBase::OnMsgExtractRenderData(ezMsgExtractRenderData& msg) co
       pRenderData->FillBatchIdAndSortingKey();
     }
 
-    bool bDontCacheYet = false;
+    // the selected LOD depends on the view, so the render data must not be reused in another frame
+    bool bDontCacheYet = bHasLods;
 
     // Determine render data category.
     ezRenderData::Category category = m_RenderDataCategory;
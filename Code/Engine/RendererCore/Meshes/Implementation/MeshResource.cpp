@@ -17,6 +17,23 @@ ezMeshResource::ezMeshResource()
   : ezResource(DoUpdate::OnAnyThread, 1)
 {
   m_Bounds.SetInvalid();
+
+  m_Lods.SetCount(1);
+  m_Lods[0].m_fScreenSize = 1.0f;
+  m_Lods[0].m_uiFirstSubMesh = 0;
+  m_Lods[0].m_uiNumSubMeshes = 0;
+}
+
+ezUInt32 ezMeshResource::SelectLod(float fScreenSize) const
+{
+  ezUInt32 uiLod = 0;
+
+  while (uiLod + 1 < m_Lods.GetCount() && fScreenSize < m_Lods[uiLod + 1].m_fScreenSize)
+  {
+    ++uiLod;
+  }
+
+  return uiLod;
 }
 
 ezResourceLoadDesc ezMeshResource::UnloadData(Unload WhatToUnload)
@@ -30,6 +47,8 @@ ezResourceLoadDesc ezMeshResource::UnloadData(Unload WhatToUnload)
   // if (WhatToUnload == Unload::AllQualityLevels)
   {
     m_SubMeshes.Clear();
+    m_Lods.SetCount(1);
+    m_Lods[0].m_uiNumSubMeshes = 0;
     m_hMeshBuffer.Invalidate();
     m_Materials.Clear();
 
@@ -75,7 +94,8 @@ ezResourceLoadDesc ezMeshResource::UpdateContent(ezStreamReader* Stream)
 void ezMeshResource::UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage)
 {
   out_NewMemoryUsage.m_uiMemoryCPU =
-    sizeof(ezMeshResource) + (ezUInt32)m_SubMeshes.GetHeapMemoryUsage() + (ezUInt32)m_Materials.GetHeapMemoryUsage();
+    sizeof(ezMeshResource) + (ezUInt32)m_SubMeshes.GetHeapMemoryUsage() + (ezUInt32)m_Lods.GetHeapMemoryUsage() +
+    (ezUInt32)m_Materials.GetHeapMemoryUsage();
   out_NewMemoryUsage.m_uiMemoryGPU = 0;
 }
 
@@ -99,6 +119,18 @@ EZ_RESOURCE_IMPLEMENT_CREATEABLE(ezMeshResource, ezMeshResourceDescriptor)
 
   m_SubMeshes = descriptor.GetSubMeshes();
 
+  if (descriptor.GetLods().IsEmpty())
+  {
+    m_Lods.SetCount(1);
+    m_Lods[0].m_fScreenSize = 1.0f;
+    m_Lods[0].m_uiFirstSubMesh = 0;
+    m_Lods[0].m_uiNumSubMeshes = m_SubMeshes.GetCount();
+  }
+  else
+  {
+    m_Lods = descriptor.GetLods();
+  }
+
   m_Materials.Clear();
   m_Materials.Reserve(descriptor.GetMaterials().GetCount());
 
@@ -4,6 +4,7 @@
 #include <Foundation/IO/ChunkStream.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <RendererCore/Meshes/MeshBufferUtils.h>
 #include <RendererCore/Meshes/MeshResourceDescriptor.h>
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
@@ -23,6 +24,7 @@ void ezMeshResourceDescriptor::Clear()
   m_Materials.Clear();
   m_MeshBufferDescriptor.Clear();
   m_SubMeshes.Clear();
+  m_Lods.Clear();
 }
 
 ezMeshBufferResourceDescriptor& ezMeshResourceDescriptor::MeshBufferDesc()
@@ -55,6 +57,11 @@ ezArrayPtr<const ezMeshResourceDescriptor::SubMesh> ezMeshResourceDescriptor::Ge
   return m_SubMeshes;
 }
 
+ezArrayPtr<const ezMeshResourceDescriptor::LodLevel> ezMeshResourceDescriptor::GetLods() const
+{
+  return m_Lods;
+}
+
 const ezBoundingBoxSphere& ezMeshResourceDescriptor::GetBounds() const
 {
   return m_Bounds;
@@ -88,6 +95,161 @@ void ezMeshResourceDescriptor::SetMaterial(ezUInt32 uiMaterialIndex, const char*
   m_Materials[uiMaterialIndex].m_sPath = szPathToMaterial;
 }
 
+ezResult ezMeshResourceDescriptor::GenerateLods(ezArrayPtr<const float> lodScreenSizes, float fTriangleRatio)
+{
+  EZ_ASSERT_DEV(fTriangleRatio > 0.0f && fTriangleRatio < 1.0f, "Invalid triangle ratio {0}", fTriangleRatio);
+
+  if (m_hMeshBuffer.IsValid() || !m_MeshBufferDescriptor.HasIndexBuffer() ||
+      m_MeshBufferDescriptor.GetTopology() != ezGALPrimitiveTopology::Triangles)
+  {
+    ezLog::Error("LODs can only be generated for indexed triangle meshes");
+    return EZ_FAILURE;
+  }
+
+  if (!m_Lods.IsEmpty())
+  {
+    ezLog::Error("The mesh already has LODs");
+    return EZ_FAILURE;
+  }
+
+  for (ezUInt32 i = 0; i < lodScreenSizes.GetCount(); ++i)
+  {
+    const float fPrevScreenSize = (i == 0) ? 1.0f : lodScreenSizes[i - 1];
+
+    if (lodScreenSizes[i] <= 0.0f || lodScreenSizes[i] >= fPrevScreenSize)
+    {
+      ezLog::Error("LOD screen sizes must be distinct, in descending order and between 1 and 0, exclusively");
+      return EZ_FAILURE;
+    }
+  }
+
+  if (lodScreenSizes.IsEmpty() || m_SubMeshes.IsEmpty())
+    return EZ_SUCCESS;
+
+  const ezVertexStreamInfo* pPositionStream = nullptr;
+  for (const ezVertexStreamInfo& stream : m_MeshBufferDescriptor.GetVertexDeclaration().m_VertexStreams)
+  {
+    if (stream.m_Semantic == ezGALVertexAttributeSemantic::Position && stream.m_Format == ezGALResourceFormat::XYZFloat)
+    {
+      pPositionStream = &stream;
+      break;
+    }
+  }
+
+  if (pPositionStream == nullptr)
+  {
+    ezLog::Error("LODs can only be generated for meshes with a float position stream");
+    return EZ_FAILURE;
+  }
+
+  const ezUInt32 uiVertexCount = m_MeshBufferDescriptor.GetVertexCount();
+  const ezUInt32 uiVertexSize = m_MeshBufferDescriptor.GetVertexDataSize();
+  const ezUInt8* pVertexData = m_MeshBufferDescriptor.GetVertexBufferData().GetData() + pPositionStream->m_uiOffset;
+
+  ezDynamicArray<ezVec3> positions;
+  positions.SetCountUninitialized(uiVertexCount);
+
+  for (ezUInt32 i = 0; i < uiVertexCount; ++i)
+  {
+    positions[i] = *reinterpret_cast<const ezVec3*>(pVertexData + i * uiVertexSize);
+  }
+
+  const bool b32BitIndices = m_MeshBufferDescriptor.Uses32BitIndices();
+  const ezUInt32 uiBaseIndexCount = m_MeshBufferDescriptor.GetPrimitiveCount() * 3;
+
+  ezDynamicArray<ezUInt32> indices;
+  indices.SetCountUninitialized(uiBaseIndexCount);
+
+  if (b32BitIndices)
+  {
+    ezMemoryUtils::Copy(indices.GetData(), reinterpret_cast<const ezUInt32*>(m_MeshBufferDescriptor.GetIndexBufferData().GetData()), uiBaseIndexCount);
+  }
+  else
+  {
+    const ezUInt16* pIndices = reinterpret_cast<const ezUInt16*>(m_MeshBufferDescriptor.GetIndexBufferData().GetData());
+    for (ezUInt32 i = 0; i < uiBaseIndexCount; ++i)
+    {
+      indices[i] = pIndices[i];
+    }
+  }
+
+  LodLevel& baseLod = m_Lods.ExpandAndGetRef();
+  baseLod.m_fScreenSize = 1.0f;
+  baseLod.m_uiFirstSubMesh = 0;
+  baseLod.m_uiNumSubMeshes = m_SubMeshes.GetCount();
+
+  ezDynamicArray<ezUInt32> simplifiedIndices;
+
+  for (float fScreenSize : lodScreenSizes)
+  {
+    const LodLevel prevLod = m_Lods.PeekBack();
+
+    LodLevel lod;
+    lod.m_fScreenSize = fScreenSize;
+    lod.m_uiFirstSubMesh = m_SubMeshes.GetCount();
+    lod.m_uiNumSubMeshes = prevLod.m_uiNumSubMeshes;
+
+    const ezUInt32 uiPrevIndexCount = indices.GetCount();
+    ezUInt32 uiPrevTriangleCount = 0;
+    ezUInt32 uiTriangleCount = 0;
+
+    // every LOD is simplified from the previous one, which keeps the LODs consistent with each other
+    for (ezUInt32 i = 0; i < prevLod.m_uiNumSubMeshes; ++i)
+    {
+      const SubMesh prevSubMesh = m_SubMeshes[prevLod.m_uiFirstSubMesh + i];
+      const ezUInt32 uiTargetTriangleCount = static_cast<ezUInt32>(prevSubMesh.m_uiPrimitiveCount * fTriangleRatio);
+
+      ezMeshBufferUtils::SimplifyTriangles(positions, indices.GetArrayPtr().GetSubArray(prevSubMesh.m_uiFirstPrimitive * 3, prevSubMesh.m_uiPrimitiveCount * 3),
+        uiTargetTriangleCount, ezMath::MaxValue<float>(), simplifiedIndices);
+
+      // the simplification leaves the triangles in a poor order and the mesh is usually optimized before the LODs are generated,
+      // the vertex fetch order is not optimized, because all LODs share the vertex buffer of the full detail mesh
+      ezMeshBufferUtils::OptimizeVertexCache(simplifiedIndices, uiVertexCount);
+      ezMeshBufferUtils::OptimizeOverdraw(positions, simplifiedIndices);
+
+      SubMesh& subMesh = m_SubMeshes.ExpandAndGetRef();
+      subMesh = prevSubMesh;
+      subMesh.m_uiFirstPrimitive = indices.GetCount() / 3;
+      subMesh.m_uiPrimitiveCount = simplifiedIndices.GetCount() / 3;
+
+      indices.PushBackRange(simplifiedIndices);
+
+      uiPrevTriangleCount += prevSubMesh.m_uiPrimitiveCount;
+      uiTriangleCount += subMesh.m_uiPrimitiveCount;
+    }
+
+    if (uiTriangleCount >= uiPrevTriangleCount)
+    {
+      // the remaining triangles are all on borders or seams, further LODs would only duplicate data
+      m_SubMeshes.SetCount(lod.m_uiFirstSubMesh);
+      indices.SetCount(uiPrevIndexCount);
+      break;
+    }
+
+    m_Lods.PushBack(lod);
+  }
+
+  ezDynamicArray<ezUInt8>& indexData = m_MeshBufferDescriptor.GetIndexBufferData();
+
+  if (b32BitIndices)
+  {
+    indexData.SetCountUninitialized(indices.GetCount() * sizeof(ezUInt32));
+    ezMemoryUtils::Copy(reinterpret_cast<ezUInt32*>(indexData.GetData()), indices.GetData(), indices.GetCount());
+  }
+  else
+  {
+    indexData.SetCountUninitialized(indices.GetCount() * sizeof(ezUInt16));
+
+    ezUInt16* pIndices = reinterpret_cast<ezUInt16*>(indexData.GetData());
+    for (ezUInt32 i = uiBaseIndexCount; i < indices.GetCount(); ++i)
+    {
+      pIndices[i] = static_cast<ezUInt16>(indices[i]);
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
 ezResult ezMeshResourceDescriptor::Save(const char* szFile)
 {
   EZ_LOG_BLOCK("ezMeshResourceDescriptor::Save", szFile);
@@ -222,6 +384,22 @@ void ezMeshResourceDescriptor::Save(ezStreamWriter& stream)
     chunk.EndChunk();
   }
 
+  if (!m_Lods.IsEmpty())
+  {
+    chunk.BeginChunk("LODs", 1);
+
+    chunk << m_Lods.GetCount();
+
+    for (const LodLevel& lod : m_Lods)
+    {
+      chunk << lod.m_fScreenSize;
+      chunk << lod.m_uiFirstSubMesh;
+      chunk << lod.m_uiNumSubMeshes;
+    }
+
+    chunk.EndChunk();
+  }
+
   if (m_hSkeleton.IsValid())
   {
     chunk.BeginChunk("Animation", 2);
@@ -464,6 +642,25 @@ ezResult ezMeshResourceDescriptor::Load(ezStreamReader& stream)
         chunk.ReadBytes(m_MeshBufferDescriptor.GetIndexBufferData().GetData(), m_MeshBufferDescriptor.GetIndexBufferData().GetCount());
     }
 
+    if (ci.m_sChunkName == "LODs")
+    {
+      if (ci.m_uiChunkVersion != 1)
+      {
+        ezLog::Error("Version of chunk '{0}' is invalid ({1})", ci.m_sChunkName, ci.m_uiChunkVersion);
+        return EZ_FAILURE;
+      }
+
+      chunk >> count;
+      m_Lods.SetCountUninitialized(count);
+
+      for (LodLevel& lod : m_Lods)
+      {
+        chunk >> lod.m_fScreenSize;
+        chunk >> lod.m_uiFirstSubMesh;
+        chunk >> lod.m_uiNumSubMeshes;
+      }
+    }
+
     if (ci.m_sChunkName == "Animation")
     {
       if (ci.m_uiChunkVersion == 2)
@@ -1,6 +1,7 @@
 
 #pragma once
 
+#include <Foundation/Containers/DynamicArray.h>
 #include <RendererCore/RendererCoreDLL.h>
 #include <RendererFoundation/Resources/ResourceFormats.h>
 
@@ -72,6 +73,36 @@ struct EZ_RENDERERCORE_DLL ezMeshBufferUtils
   static ezResult DecodeToVec2(ezArrayPtr<const ezUInt8> source, ezGALResourceFormat::Enum sourceFormat, ezVec2& dest);
   static ezResult DecodeToVec3(ezArrayPtr<const ezUInt8> source, ezGALResourceFormat::Enum sourceFormat, ezVec3& dest);
   static ezResult DecodeToVec4(ezArrayPtr<const ezUInt8> source, ezGALResourceFormat::Enum sourceFormat, ezVec4& dest);
+
+  /// \brief Reduces the number of triangles in an indexed triangle list by collapsing edges, cheapest quadric error first.
+  ///
+  /// Vertices are only moved onto other existing vertices, so the result references a subset of the original vertices and can share
+  /// their vertex buffer. Vertices on open borders and on attribute seams (several vertices at the same position) are never removed.
+  /// Simplification stops once uiTargetTriangleCount is reached or the next collapse would move the surface further than fMaxError,
+  /// which is given relative to the size of the mesh.
+  static void SimplifyTriangles(ezArrayPtr<const ezVec3> positions, ezArrayPtr<const ezUInt32> indices, ezUInt32 uiTargetTriangleCount,
+    float fMaxError, ezDynamicArray<ezUInt32>& out_Indices);
+
+  /// \brief Reorders the triangles of an indexed triangle list so that vertices are reused while they are still in the post-transform cache.
+  ///
+  /// Uses Tom Forsyth's linear-speed vertex cache optimization. The winding of each triangle is preserved.
+  static void OptimizeVertexCache(ezArrayPtr<ezUInt32> inout_Indices, ezUInt32 uiNumVertices);
+
+  /// \brief Renumbers the vertices in the order in which the indices first reference them, which makes vertex fetches more coherent.
+  ///
+  /// out_VertexRemap maps every old vertex index to its new index. Unreferenced vertices are moved to the end.
+  static void OptimizeVertexFetch(ezArrayPtr<ezUInt32> inout_Indices, ezUInt32 uiNumVertices, ezDynamicArray<ezUInt32>& out_VertexRemap);
+
+  /// \brief Computes the average number of vertex shader invocations per triangle (ACMR) for a FIFO post-transform cache of the given size.
+  ///
+  /// The result is between 3 (no vertex is ever reused) and about 0.5 (the best case for large regular grids).
+  static float ComputeAcmr(ezArrayPtr<const ezUInt32> indices, ezUInt32 uiNumVertices, ezUInt32 uiCacheSize = 16);
+
+  /// \brief Reorders the triangles such that those which likely occlude the rest of the mesh are drawn first, which reduces overdraw.
+  ///
+  /// The indices should already be optimized for the vertex cache. They are split into clusters whose ACMR is at most
+  /// fMaxAcmrIncrease times the ACMR of the part of the mesh they come from, and only whole clusters are reordered.
+  static void OptimizeOverdraw(ezArrayPtr<const ezVec3> positions, ezArrayPtr<ezUInt32> inout_Indices, float fMaxAcmrIncrease = 1.05f);
 };
 
 #include <RendererCore/Meshes/Implementation/MeshBufferUtils_inl.h>
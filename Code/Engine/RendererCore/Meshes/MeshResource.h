@@ -14,8 +14,20 @@ class EZ_RENDERERCORE_DLL ezMeshResource : public ezResource
 public:
   ezMeshResource();
 
-  /// \brief Returns the array of sub-meshes in this mesh.
-  ezArrayPtr<const ezMeshResourceDescriptor::SubMesh> GetSubMeshes() const { return m_SubMeshes; }
+  /// \brief Returns the array of sub-meshes of the given level of detail.
+  ezArrayPtr<const ezMeshResourceDescriptor::SubMesh> GetSubMeshes(ezUInt32 uiLod = 0) const
+  {
+    return m_SubMeshes.GetArrayPtr().GetSubArray(m_Lods[uiLod].m_uiFirstSubMesh, m_Lods[uiLod].m_uiNumSubMeshes);
+  }
+
+  /// \brief Returns the sub-meshes of all levels of detail. Render data references sub-meshes by their index into this array.
+  ezArrayPtr<const ezMeshResourceDescriptor::SubMesh> GetAllSubMeshes() const { return m_SubMeshes; }
+
+  /// \brief Returns the levels of detail of this mesh. There is always at least one.
+  ezArrayPtr<const ezMeshResourceDescriptor::LodLevel> GetLods() const { return m_Lods; }
+
+  /// \brief Returns the level of detail to use when the mesh's bounding sphere covers the given fraction of the screen height.
+  ezUInt32 SelectLod(float fScreenSize) const;
 
   /// \brief Returns the mesh buffer that is used by this resource.
   const ezMeshBufferResourceHandle& GetMeshBuffer() const { return m_hMeshBuffer; }
@@ -35,6 +47,7 @@ private:
   virtual void UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage) override;
 
   ezDynamicArray<ezMeshResourceDescriptor::SubMesh> m_SubMeshes;
+  ezHybridArray<ezMeshResourceDescriptor::LodLevel, 4> m_Lods;
   ezMeshBufferResourceHandle m_hMeshBuffer;
   ezDynamicArray<ezMaterialResourceHandle> m_Materials;
   ezSkeletonResourceHandle m_hSkeleton;
@@ -25,6 +25,16 @@ public:
     ezString m_sPath;
   };
 
+  /// \brief A level of detail is a range of sub-meshes that replaces all sub-meshes of the previous level.
+  struct LodLevel
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    float m_fScreenSize;       ///< The LOD is used as long as the bounding sphere covers at least this fraction of the screen height.
+    ezUInt32 m_uiFirstSubMesh;
+    ezUInt32 m_uiNumSubMeshes;
+  };
+
   ezMeshResourceDescriptor();
 
   void Clear();
@@ -51,6 +61,17 @@ public:
 
   ezArrayPtr<const SubMesh> GetSubMeshes() const;
 
+  /// \brief Returns the levels of detail. Empty, if GenerateLods() was never called, in which case all sub-meshes belong to a single LOD.
+  ezArrayPtr<const LodLevel> GetLods() const;
+
+  /// \brief Generates a chain of simplified LODs from the current sub-meshes.
+  ///
+  /// Each LOD reduces the triangle count of the previous one by fTriangleRatio and is used as long as the mesh covers at least the
+  /// given fraction of the screen height. The simplified triangles are appended to the index buffer and share the vertex buffer with
+  /// the original mesh. Generation stops early once the simplification cannot remove any more triangles.
+  /// Only works for indexed triangle meshes that do not use an existing mesh buffer.
+  ezResult GenerateLods(ezArrayPtr<const float> lodScreenSizes, float fTriangleRatio);
+
   void ComputeBounds();
   const ezBoundingBoxSphere& GetBounds() const;
 
@@ -61,6 +82,7 @@ private:
 
   ezHybridArray<Material, 8> m_Materials;
   ezHybridArray<SubMesh, 8> m_SubMeshes;
+  ezHybridArray<LodLevel, 4> m_Lods;
   ezMeshBufferResourceDescriptor m_MeshBufferDescriptor;
   ezMeshBufferResourceHandle m_hMeshBuffer;
   ezSkeletonResourceHandle m_hSkeleton;
@@ -65,6 +65,11 @@ public:
   void AddRenderData(const ezRenderData* pRenderData, ezRenderData::Category category);
   void AddFrameData(const ezRenderData* pFrameData);
 
+  /// \brief Appends all render data and frame data of another ezExtractedRenderData, e.g. of a chunk that was extracted on another thread.
+  ///
+  /// The sorting keys are taken over as they are, so both must have been extracted with the same camera.
+  void AppendRenderData(const ezExtractedRenderData& other);
+
   void SortAndBatch();
 
   void Clear();
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <RendererCore/Pipeline/ExtractedRenderData.h>
 #include <RendererCore/Pipeline/RenderData.h>
+#include <Foundation/Containers/Deque.h>
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/AtomicInteger.h>
 
 class EZ_RENDERERCORE_DLL ezExtractor : public ezReflectedClass
 {
@@ -30,6 +33,8 @@ protected:
   bool FilterByViewTags(const ezView& view, const ezGameObject* pObject) const;
 
   /// \brief extracts the render data for the given object.
+  ///
+  /// This function may be called from multiple threads at the same time, as long as every thread uses its own message and extracted render data.
   void ExtractRenderData(const ezView& view, const ezGameObject* pObject, ezMsgExtractRenderData& msg, ezExtractedRenderData& extractedRenderData) const;
 
 private:
@@ -43,12 +48,17 @@ protected:
   ezHybridArray<ezHashedString, 4> m_DependsOn;
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-  mutable ezUInt32 m_uiNumCachedRenderData;
-  mutable ezUInt32 m_uiNumUncachedRenderData;
+  mutable ezAtomicInteger32 m_uiNumCachedRenderData;
+  mutable ezAtomicInteger32 m_uiNumUncachedRenderData;
 #endif
 };
 
 
+/// \brief Extracts the render data of all visible objects.
+///
+/// Large numbers of visible objects are split into chunks that are extracted in parallel (see cvar 'r_ParallelExtraction').
+/// Each chunk writes into its own ezExtractedRenderData which are then merged into the view's data before sorting and batching.
+/// Thus all ezMsgExtractRenderData handlers must be safe to be called concurrently for different objects of the same view.
 class EZ_RENDERERCORE_DLL ezVisibleObjectsExtractor : public ezExtractor
 {
   EZ_ADD_DYNAMIC_REFLECTION(ezVisibleObjectsExtractor, ezExtractor);
@@ -57,6 +67,12 @@ public:
 
   virtual void Extract(const ezView& view, const ezDynamicArray<const ezGameObject*>& visibleObjects,
     ezExtractedRenderData& extractedRenderData) override;
+
+private:
+  void ExtractChunk(const ezView& view, ezArrayPtr<const ezGameObject* const> objects, ezExtractedRenderData& extractedRenderData) const;
+
+  /// Per chunk extraction results, kept alive across frames to reuse their allocations.
+  ezDeque<ezExtractedRenderData> m_ChunkData;
 };
 
 class EZ_RENDERERCORE_DLL ezSelectedObjectsExtractor : public ezExtractor
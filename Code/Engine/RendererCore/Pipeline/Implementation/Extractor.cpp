@@ -7,8 +7,11 @@
 #include <Core/World/World.h>
 #include <Core/World/SpatialSystem_RegularGrid.h>
 #include <Foundation/Configuration/CVar.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 
+ezCVarBool CVarParallelExtraction("r_ParallelExtraction", true, ezCVarFlags::Default, "Extracts the visible objects of a single view on multiple threads");
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   ezCVarBool CVarVisBounds("r_VisBounds", false, ezCVarFlags::Default, "Enables debug visualization of object bounds");
   ezCVarBool CVarVisLocalBBox("r_VisLocalBBox", false, ezCVarFlags::Default, "Enables debug visualization of object local bounding box");
@@ -22,6 +25,11 @@
 
 namespace
 {
+  enum
+  {
+    ExtractionChunkSize = 256 ///< Number of visible objects that are extracted by one task.
+  };
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   void VisualizeSpatialData(const ezView& view)
   {
@@ -234,8 +242,8 @@ void ezExtractor::ExtractRenderData(const ezView& view, const ezGameObject* pObj
   }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-  m_uiNumCachedRenderData += msg.m_ExtractedRenderData.GetCount() - uiNumUncachedRenderData;
-  m_uiNumUncachedRenderData += uiNumUncachedRenderData;
+  m_uiNumCachedRenderData.Add(msg.m_ExtractedRenderData.GetCount() - uiNumUncachedRenderData);
+  m_uiNumUncachedRenderData.Add(uiNumUncachedRenderData);
 #endif
 }
 
@@ -263,9 +271,6 @@ ezVisibleObjectsExtractor::ezVisibleObjectsExtractor(const char* szName)
 void ezVisibleObjectsExtractor::Extract(const ezView& view, const ezDynamicArray<const ezGameObject*>& visibleObjects,
   ezExtractedRenderData& extractedRenderData)
 {
-  ezMsgExtractRenderData msg;
-  msg.m_pView = &view;
-
   EZ_LOCK(view.GetWorld()->GetReadMarker());
 
   #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
@@ -275,20 +280,45 @@ void ezVisibleObjectsExtractor::Extract(const ezView& view, const ezDynamicArray
     m_uiNumUncachedRenderData = 0;
   #endif
 
-  for (auto pObject : visibleObjects)
+  const ezUInt32 uiNumObjects = visibleObjects.GetCount();
+  const ezUInt32 uiNumChunks = (uiNumObjects + ExtractionChunkSize - 1) / ExtractionChunkSize;
+
+  if (!CVarParallelExtraction || uiNumChunks < 2)
   {
-    ExtractRenderData(view, pObject, msg, extractedRenderData);
+    ExtractChunk(view, visibleObjects.GetArrayPtr(), extractedRenderData);
+  }
+  else
+  {
+    while (m_ChunkData.GetCount() < uiNumChunks)
+    {
+      m_ChunkData.ExpandAndGetRef();
+    }
 
-    #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-      if (CVarVisBounds || CVarVisLocalBBox || CVarVisSpatialData)
-      {
-        if ((CVarVisObjectName.GetValue().IsEmpty() || ezStringUtils::FindSubString_NoCase(pObject->GetName(), CVarVisObjectName.GetValue()) != nullptr) &&
-          !CVarVisObjectSelection)
+    for (ezUInt32 i = 0; i < uiNumChunks; ++i)
+    {
+      m_ChunkData[i].Clear();
+      m_ChunkData[i].SetCamera(extractedRenderData.GetCamera());
+    }
+
+    // The world is locked for reading by this thread, which is sufficient for the worker threads to read from it as well.
+    ezTaskSystem::ParallelForIndexed(
+      0, uiNumChunks,
+      [&](ezUInt32 uiStartChunk, ezUInt32 uiEndChunk) {
+        for (ezUInt32 uiChunk = uiStartChunk; uiChunk < uiEndChunk; ++uiChunk)
         {
-          VisualizeObject(view, pObject);
+          const ezUInt32 uiStartIndex = uiChunk * ExtractionChunkSize;
+          const ezUInt32 uiCount = ezMath::Min<ezUInt32>(ExtractionChunkSize, uiNumObjects - uiStartIndex);
+
+          ExtractChunk(view, visibleObjects.GetArrayPtr().GetSubArray(uiStartIndex, uiCount), m_ChunkData[uiChunk]);
         }
-      }
-    #endif
+      },
+      "ExtractVisibleObjects");
+
+    // merge in chunk order, so that the result does not depend on the task scheduling
+    for (ezUInt32 i = 0; i < uiNumChunks; ++i)
+    {
+      extractedRenderData.AppendRenderData(m_ChunkData[i]);
+    }
   }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
@@ -302,15 +332,37 @@ void ezVisibleObjectsExtractor::Extract(const ezView& view, const ezDynamicArray
 
     ezDebugRenderer::Draw2DText(hView, "Extraction Stats", ezVec2I32(10, 200), ezColor::LimeGreen);
 
-    sb.Format("Num Cached Render Data: {0}", m_uiNumCachedRenderData);
+    sb.Format("Num Cached Render Data: {0}", (ezInt32)m_uiNumCachedRenderData);
     ezDebugRenderer::Draw2DText(hView, sb, ezVec2I32(10, 220), ezColor::LimeGreen);
 
-    sb.Format("Num Uncached Render Data: {0}", m_uiNumUncachedRenderData);
+    sb.Format("Num Uncached Render Data: {0}", (ezInt32)m_uiNumUncachedRenderData);
     ezDebugRenderer::Draw2DText(hView, sb, ezVec2I32(10, 240), ezColor::LimeGreen);
   }
 #endif
 }
 
+void ezVisibleObjectsExtractor::ExtractChunk(const ezView& view, ezArrayPtr<const ezGameObject* const> objects, ezExtractedRenderData& extractedRenderData) const
+{
+  ezMsgExtractRenderData msg;
+  msg.m_pView = &view;
+
+  for (auto pObject : objects)
+  {
+    ExtractRenderData(view, pObject, msg, extractedRenderData);
+
+    #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+      if (CVarVisBounds || CVarVisLocalBBox || CVarVisSpatialData)
+      {
+        if ((CVarVisObjectName.GetValue().IsEmpty() || ezStringUtils::FindSubString_NoCase(pObject->GetName(), CVarVisObjectName.GetValue()) != nullptr) &&
+          !CVarVisObjectSelection)
+        {
+          VisualizeObject(view, pObject);
+        }
+      }
+    #endif
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezSelectedObjectsExtractor, 1, ezRTTINoAllocator)
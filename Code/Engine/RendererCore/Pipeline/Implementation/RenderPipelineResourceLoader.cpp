@@ -148,10 +148,11 @@ ezRenderPipelineResourceLoader::CreateRenderPipeline(const ezRenderPipelineResou
 
   ezRttiConverterReader rttiConverter(&graph, &context);
 
-  auto& nodes = graph.GetAllNodes();
-  for (auto it = nodes.GetIterator(); it.IsValid(); ++it)
+  // the passes are added to the pipeline in this order, so it has to be stable
+  ezDynamicArray<const ezAbstractObjectNode*> nodes;
+  graph.GetAllNodesSortedByGuid(nodes);
+  for (auto pNode : nodes)
   {
-    auto pNode = it.Value();
     ezRTTI* pType = ezRTTI::FindTypeByName(pNode->GetType());
     if (pType && pType->IsDerivedFrom<ezRenderPipelinePass>())
     {
@@ -176,9 +177,8 @@ ezRenderPipelineResourceLoader::CreateRenderPipeline(const ezRenderPipelineResou
 
   ezStringBuilder tmp;
 
-  for (auto it = nodes.GetIterator(); it.IsValid(); ++it)
+  for (auto* pNode : nodes)
   {
-    auto* pNode = it.Value();
     const ezUuid& guid = pNode->GetGuid();
 
     auto objectSoure = context.GetObjectByGUID(guid);
@@ -247,10 +247,13 @@ void ezRenderPipelineResourceLoader::CreateRenderPipelineResourceDescriptor(cons
 
   auto pType = ezGetStaticRTTI<RenderPipelineResourceLoaderNodeDataInternal>();
   RenderPipelineResourceLoaderNodeDataInternal data;
-  auto& nodes = graph.GetAllNodes();
-  for (auto it = nodes.GetIterator(); it.IsValid(); ++it)
+
+  // the connections are added as sub-objects, so the node table may grow while the nodes are processed
+  ezDynamicArray<ezAbstractObjectNode*> nodes;
+  graph.GetAllNodesSortedByGuid(nodes);
+
+  for (auto* pNode : nodes)
   {
-    auto* pNode = it.Value();
     const ezUuid& guid = pNode->GetGuid();
 
     auto objectSoure = context.GetObjectByGUID(guid);
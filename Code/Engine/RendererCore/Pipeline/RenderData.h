@@ -103,6 +103,10 @@ struct EZ_RENDERERCORE_DLL ezDefaultRenderDataCategories
 
 #define ezInvalidRenderDataCategory ezRenderData::Category()
 
+/// \brief Sent to the visible objects of a view to collect their render data.
+///
+/// The message is sent to different objects of the same view from multiple threads at the same time (see ezVisibleObjectsExtractor).
+/// Handlers must therefore only read from the world and must not modify shared state without proper synchronization.
 struct EZ_RENDERERCORE_DLL ezMsgExtractRenderData : public ezMessage
 {
   EZ_DECLARE_MESSAGE_TYPE(ezMsgExtractRenderData, ezMessage);
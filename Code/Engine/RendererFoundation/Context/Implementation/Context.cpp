@@ -466,6 +466,8 @@ void ezGALContext::SetBlendState(ezGALBlendStateHandle hBlendState, const ezColo
   SetBlendStatePlatform(pBlendState, BlendFactor, uiSampleMask);
 
   m_State.m_hBlendState = hBlendState;
+  m_State.m_BlendFactor = BlendFactor;
+  m_State.m_uiSampleMask = uiSampleMask;
 
   CountStateChange();
 }
@@ -485,6 +487,7 @@ void ezGALContext::SetDepthStencilState(ezGALDepthStencilStateHandle hDepthStenc
   SetDepthStencilStatePlatform(pDepthStencilState, uiStencilRefValue);
 
   m_State.m_hDepthStencilState = hDepthStencilState;
+  m_State.m_uiStencilRefValue = uiStencilRefValue;
 
   CountStateChange();
 }
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Strings/String.h>
+#include <RendererNull/RendererNullDLL.h>
+
+/// \brief The kinds of commands that are recorded by the null context.
+struct ezGALNullCommandType
+{
+  enum Enum
+  {
+    Clear,
+    ClearUnorderedAccessView,
+    Draw,
+    DrawIndexed,
+    DrawIndexedInstanced,
+    DrawIndexedInstancedIndirect,
+    DrawInstanced,
+    DrawInstancedIndirect,
+    DrawAuto,
+    Dispatch,
+    DispatchIndirect,
+
+    SetShader,
+    SetIndexBuffer,
+    SetVertexBuffer,
+    SetVertexDeclaration,
+    SetPrimitiveTopology,
+    SetConstantBuffer,
+    SetSamplerState,
+    SetResourceView,
+    SetRenderTargetSetup,
+    SetUnorderedAccessView,
+    SetBlendState,
+    SetDepthStencilState,
+    SetRasterizerState,
+    SetViewport,
+    SetScissorRect,
+    SetStreamOutBuffer,
+
+    CopyBuffer,
+    CopyBufferRegion,
+    UpdateBuffer,
+    CopyTexture,
+    CopyTextureRegion,
+    UpdateTexture,
+    ResolveTexture,
+    ReadbackTexture,
+    GenerateMipMaps,
+
+    ENUM_COUNT,
+
+    FirstDrawCommand = Clear,
+    LastDrawCommand = DispatchIndirect,
+    FirstStateCommand = SetShader,
+    LastStateCommand = SetStreamOutBuffer,
+    FirstTransferCommand = CopyBuffer,
+    LastTransferCommand = GenerateMipMaps,
+  };
+};
+
+/// \brief A single recorded command.
+struct ezGALNullCommand
+{
+  EZ_DECLARE_POD_TYPE();
+
+  ezGALNullCommandType::Enum m_Type;
+  ezUInt32 m_uiMarker; ///< Index of the innermost marker that was active when the command was recorded, ezInvalidIndex if there was none.
+  ezUInt32 m_uiElementCount; ///< Number of vertices, indices or thread groups (times instances) for draws and dispatches.
+  ezUInt32 m_uiByteCount; ///< Number of bytes that were transferred by upload and copy commands.
+};
+
+/// \brief Statistics that are accumulated per marker name.
+///
+/// Commands count towards all markers that are on the marker stack when they are recorded, so a pass marker includes the commands of
+/// all nested markers.
+struct ezGALNullMarkerStatistics
+{
+  ezUInt32 m_uiDrawCalls = 0; ///< Draws and dispatches
+  ezUInt32 m_uiStateChanges = 0;
+  ezUInt64 m_uiBytesTransferred = 0;
+};
+
+/// \brief Records what is submitted to an ezGALContextNull, to count draws per pass and to detect regressions in tests and benchmarks.
+///
+/// Per type counters and per marker statistics are always updated. The individual commands are only stored when enabled with
+/// SetRecordCommands() since that adds noticeable overhead when benchmarking millions of commands.
+class EZ_RENDERERNULL_DLL ezGALNullCommandLog
+{
+public:
+  ezGALNullCommandLog();
+  ~ezGALNullCommandLog();
+
+  /// \brief Resets all counters, markers and recorded commands.
+  void Clear();
+
+  void SetRecordCommands(bool bRecord) { m_bRecordCommands = bRecord; }
+  bool GetRecordCommands() const { return m_bRecordCommands; }
+
+  /// \brief Returns how often a command of the given type was recorded.
+  ezUInt32 GetCommandCount(ezGALNullCommandType::Enum type) const { return m_CommandCounts[type]; }
+
+  /// \brief Returns the number of all draw, dispatch and clear commands.
+  ezUInt32 GetDrawCallCount() const;
+
+  /// \brief Returns the number of all state changes that reached the platform layer, i.e. excluding the redundant ones.
+  ezUInt32 GetStateChangeCount() const;
+
+  /// \brief Returns the number of bytes that were uploaded or copied.
+  ezUInt64 GetBytesTransferred() const { return m_uiBytesTransferred; }
+
+  /// \brief Returns the statistics of the given marker, or nullptr if no marker with that name was ever pushed.
+  const ezGALNullMarkerStatistics* GetMarkerStatistics(const char* szMarker) const;
+
+  /// \brief Returns the name of the marker with the given index, see ezGALNullCommand::m_uiMarker.
+  const char* GetMarkerName(ezUInt32 uiMarker) const { return m_Markers[uiMarker].m_sName; }
+
+  /// \brief Returns the recorded commands, empty if recording was not enabled.
+  ezArrayPtr<const ezGALNullCommand> GetCommands() const { return m_Commands; }
+
+  void PushMarker(const char* szMarker);
+  void PopMarker();
+
+  void Record(ezGALNullCommandType::Enum type, ezUInt32 uiElementCount = 0, ezUInt32 uiByteCount = 0);
+
+private:
+  struct Marker
+  {
+    ezString m_sName;
+    ezGALNullMarkerStatistics m_Statistics;
+  };
+
+  bool m_bRecordCommands = false;
+
+  ezUInt32 m_CommandCounts[ezGALNullCommandType::ENUM_COUNT];
+  ezUInt64 m_uiBytesTransferred = 0;
+
+  ezDynamicArray<Marker> m_Markers;
+  ezHashTable<ezString, ezUInt32> m_MarkerIndices;
+  ezDynamicArray<ezUInt32> m_MarkerStack;
+
+  ezDynamicArray<ezGALNullCommand> m_Commands;
+};
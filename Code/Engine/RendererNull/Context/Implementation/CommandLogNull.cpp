@@ -0,0 +1,110 @@
+#include <RendererNullPCH.h>
+
+#include <RendererNull/Context/CommandLogNull.h>
+
+ezGALNullCommandLog::ezGALNullCommandLog()
+{
+  ezMemoryUtils::ZeroFill(m_CommandCounts, ezGALNullCommandType::ENUM_COUNT);
+}
+
+ezGALNullCommandLog::~ezGALNullCommandLog() = default;
+
+void ezGALNullCommandLog::Clear()
+{
+  ezMemoryUtils::ZeroFill(m_CommandCounts, ezGALNullCommandType::ENUM_COUNT);
+  m_uiBytesTransferred = 0;
+
+  m_Markers.Clear();
+  m_MarkerIndices.Clear();
+  m_MarkerStack.Clear();
+
+  m_Commands.Clear();
+}
+
+ezUInt32 ezGALNullCommandLog::GetDrawCallCount() const
+{
+  ezUInt32 uiCount = 0;
+  for (ezUInt32 i = ezGALNullCommandType::FirstDrawCommand; i <= ezGALNullCommandType::LastDrawCommand; ++i)
+  {
+    uiCount += m_CommandCounts[i];
+  }
+
+  return uiCount;
+}
+
+ezUInt32 ezGALNullCommandLog::GetStateChangeCount() const
+{
+  ezUInt32 uiCount = 0;
+  for (ezUInt32 i = ezGALNullCommandType::FirstStateCommand; i <= ezGALNullCommandType::LastStateCommand; ++i)
+  {
+    uiCount += m_CommandCounts[i];
+  }
+
+  return uiCount;
+}
+
+const ezGALNullMarkerStatistics* ezGALNullCommandLog::GetMarkerStatistics(const char* szMarker) const
+{
+  ezUInt32 uiIndex = 0;
+  if (m_MarkerIndices.TryGetValue(szMarker, uiIndex))
+  {
+    return &m_Markers[uiIndex].m_Statistics;
+  }
+
+  return nullptr;
+}
+
+void ezGALNullCommandLog::PushMarker(const char* szMarker)
+{
+  ezUInt32 uiIndex = m_Markers.GetCount();
+
+  ezUInt32* pIndex = nullptr;
+  if (m_MarkerIndices.TryGetValue(szMarker, pIndex))
+  {
+    uiIndex = *pIndex;
+  }
+  else
+  {
+    m_MarkerIndices.Insert(szMarker, uiIndex);
+    m_Markers.ExpandAndGetRef().m_sName = szMarker;
+  }
+
+  m_MarkerStack.PushBack(uiIndex);
+}
+
+void ezGALNullCommandLog::PopMarker()
+{
+  EZ_ASSERT_DEV(!m_MarkerStack.IsEmpty(), "PopMarker called without a matching PushMarker");
+
+  m_MarkerStack.PopBack();
+}
+
+void ezGALNullCommandLog::Record(ezGALNullCommandType::Enum type, ezUInt32 uiElementCount, ezUInt32 uiByteCount)
+{
+  ++m_CommandCounts[type];
+  m_uiBytesTransferred += uiByteCount;
+
+  const bool bDrawCall = type >= ezGALNullCommandType::FirstDrawCommand && type <= ezGALNullCommandType::LastDrawCommand;
+  const bool bStateChange = type >= ezGALNullCommandType::FirstStateCommand && type <= ezGALNullCommandType::LastStateCommand;
+
+  for (ezUInt32 uiMarker : m_MarkerStack)
+  {
+    auto& stats = m_Markers[uiMarker].m_Statistics;
+    stats.m_uiDrawCalls += bDrawCall ? 1 : 0;
+    stats.m_uiStateChanges += bStateChange ? 1 : 0;
+    stats.m_uiBytesTransferred += uiByteCount;
+  }
+
+  if (m_bRecordCommands)
+  {
+    auto& command = m_Commands.ExpandAndGetRef();
+    command.m_Type = type;
+    command.m_uiMarker = m_MarkerStack.IsEmpty() ? ezInvalidIndex : m_MarkerStack.PeekBack();
+    command.m_uiElementCount = uiElementCount;
+    command.m_uiByteCount = uiByteCount;
+  }
+}
+
+
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Context_Implementation_CommandLogNull);
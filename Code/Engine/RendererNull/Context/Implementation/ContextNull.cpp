@@ -0,0 +1,277 @@
+#include <RendererNullPCH.h>
+
+#include <RendererFoundation/Device/Device.h>
+#include <RendererFoundation/Resources/Buffer.h>
+#include <RendererFoundation/Resources/Texture.h>
+#include <RendererNull/Context/ContextNull.h>
+#include <RendererNull/Device/DeviceNull.h>
+
+ezGALContextNull::ezGALContextNull(ezGALDevice* pDevice)
+  : ezGALContext(pDevice)
+{
+}
+
+ezGALContextNull::~ezGALContextNull() = default;
+
+// Draw functions
+
+void ezGALContextNull::ClearPlatform(const ezColor& ClearColor, ezUInt32 uiRenderTargetClearMask, bool bClearDepth, bool bClearStencil, float fDepthClear, ezUInt8 uiStencilClear)
+{
+  m_CommandLog.Record(ezGALNullCommandType::Clear);
+}
+
+void ezGALContextNull::ClearUnorderedAccessViewPlatform(const ezGALUnorderedAccessView* pUnorderedAccessView, ezVec4 clearValues)
+{
+  m_CommandLog.Record(ezGALNullCommandType::ClearUnorderedAccessView);
+}
+
+void ezGALContextNull::ClearUnorderedAccessViewPlatform(const ezGALUnorderedAccessView* pUnorderedAccessView, ezVec4U32 clearValues)
+{
+  m_CommandLog.Record(ezGALNullCommandType::ClearUnorderedAccessView);
+}
+
+void ezGALContextNull::DrawPlatform(ezUInt32 uiVertexCount, ezUInt32 uiStartVertex)
+{
+  m_CommandLog.Record(ezGALNullCommandType::Draw, uiVertexCount);
+}
+
+void ezGALContextNull::DrawIndexedPlatform(ezUInt32 uiIndexCount, ezUInt32 uiStartIndex)
+{
+  m_CommandLog.Record(ezGALNullCommandType::DrawIndexed, uiIndexCount);
+}
+
+void ezGALContextNull::DrawIndexedInstancedPlatform(ezUInt32 uiIndexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartIndex)
+{
+  m_CommandLog.Record(ezGALNullCommandType::DrawIndexedInstanced, uiIndexCountPerInstance * uiInstanceCount);
+}
+
+void ezGALContextNull::DrawIndexedInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  m_CommandLog.Record(ezGALNullCommandType::DrawIndexedInstancedIndirect);
+}
+
+void ezGALContextNull::DrawInstancedPlatform(ezUInt32 uiVertexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartVertex)
+{
+  m_CommandLog.Record(ezGALNullCommandType::DrawInstanced, uiVertexCountPerInstance * uiInstanceCount);
+}
+
+void ezGALContextNull::DrawInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  m_CommandLog.Record(ezGALNullCommandType::DrawInstancedIndirect);
+}
+
+void ezGALContextNull::DrawAutoPlatform()
+{
+  m_CommandLog.Record(ezGALNullCommandType::DrawAuto);
+}
+
+void ezGALContextNull::BeginStreamOutPlatform() {}
+
+void ezGALContextNull::EndStreamOutPlatform() {}
+
+// Dispatch
+
+void ezGALContextNull::DispatchPlatform(ezUInt32 uiThreadGroupCountX, ezUInt32 uiThreadGroupCountY, ezUInt32 uiThreadGroupCountZ)
+{
+  m_CommandLog.Record(ezGALNullCommandType::Dispatch, uiThreadGroupCountX * uiThreadGroupCountY * uiThreadGroupCountZ);
+}
+
+void ezGALContextNull::DispatchIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  m_CommandLog.Record(ezGALNullCommandType::DispatchIndirect);
+}
+
+// State setting functions
+
+void ezGALContextNull::SetShaderPlatform(const ezGALShader* pShader)
+{
+  m_CommandLog.Record(ezGALNullCommandType::SetShader);
+}
+
+void ezGALContextNull::SetIndexBufferPlatform(const ezGALBuffer* pIndexBuffer)
+{
+  m_CommandLog.Record(ezGALNullCommandType::SetIndexBuffer);
+}
+
+void ezGALContextNull::SetVertexBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pVertexBuffer)
+{
+  m_CommandLog.Record(ezGALNullCommandType::SetVertexBuffer);
+}
+
+void ezGALContextNull::SetVertexDeclarationPlatform(const ezGALVertexDeclaration* pVertexDeclaration)
+{
+  m_CommandLog.Record(ezGALNullCommandType::SetVertexDeclaration);
+}
+
+void ezGALContextNull::SetPrimitiveTopologyPlatform(ezGALPrimitiveTopology::Enum Topology)
+{
+  m_CommandLog.Record(ezGALNullCommandType::SetPrimitiveTopology);
+}
+
+void ezGALContextNull::SetConstantBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pBuffer)
+{
+  m_CommandLog.Record(ezGALNullCommandType::SetConstantBuffer);
+}
+
+void ezGALContextNull::SetSamplerStatePlatform(ezGALShaderStage::Enum Stage, ezUInt32 uiSlot, const ezGALSamplerState* pSamplerState)
+{
+  m_CommandLog.Record(ezGALNullCommandType::SetSamplerState);
+}
+
+void ezGALContextNull::SetResourceViewPlatform(ezGALShaderStage::Enum Stage, ezUInt32 uiSlot, const ezGALResourceView* pResourceView)
+{
+  m_CommandLog.Record(ezGALNullCommandType::SetResourceView);
+}
+
+void ezGALContextNull::SetRenderTargetSetupPlatform(ezArrayPtr<const ezGALRenderTargetView*> pRenderTargetViews, const ezGALRenderTargetView* pDepthStencilView)
+{
+  m_CommandLog.Record(ezGALNullCommandType::SetRenderTargetSetup);
+}
+
+void ezGALContextNull::SetUnorderedAccessViewPlatform(ezUInt32 uiSlot, const ezGALUnorderedAccessView* pUnorderedAccessView)
+{
+  m_CommandLog.Record(ezGALNullCommandType::SetUnorderedAccessView);
+}
+
+void ezGALContextNull::SetBlendStatePlatform(const ezGALBlendState* pBlendState, const ezColor& BlendFactor, ezUInt32 uiSampleMask)
+{
+  m_CommandLog.Record(ezGALNullCommandType::SetBlendState);
+}
+
+void ezGALContextNull::SetDepthStencilStatePlatform(const ezGALDepthStencilState* pDepthStencilState, ezUInt8 uiStencilRefValue)
+{
+  m_CommandLog.Record(ezGALNullCommandType::SetDepthStencilState);
+}
+
+void ezGALContextNull::SetRasterizerStatePlatform(const ezGALRasterizerState* pRasterizerState)
+{
+  m_CommandLog.Record(ezGALNullCommandType::SetRasterizerState);
+}
+
+void ezGALContextNull::SetViewportPlatform(const ezRectFloat& rect, float fMinDepth, float fMaxDepth)
+{
+  m_CommandLog.Record(ezGALNullCommandType::SetViewport);
+}
+
+void ezGALContextNull::SetScissorRectPlatform(const ezRectU32& rect)
+{
+  m_CommandLog.Record(ezGALNullCommandType::SetScissorRect);
+}
+
+void ezGALContextNull::SetStreamOutBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pBuffer, ezUInt32 uiOffset)
+{
+  m_CommandLog.Record(ezGALNullCommandType::SetStreamOutBuffer);
+}
+
+// Fence & Query functions
+
+void ezGALContextNull::InsertFencePlatform(const ezGALFence* pFence) {}
+
+bool ezGALContextNull::IsFenceReachedPlatform(const ezGALFence* pFence)
+{
+  // nothing is ever executed asynchronously
+  return true;
+}
+
+void ezGALContextNull::WaitForFencePlatform(const ezGALFence* pFence) {}
+
+void ezGALContextNull::BeginQueryPlatform(const ezGALQuery* pQuery) {}
+
+void ezGALContextNull::EndQueryPlatform(const ezGALQuery* pQuery) {}
+
+ezResult ezGALContextNull::GetQueryResultPlatform(const ezGALQuery* pQuery, ezUInt64& uiQueryResult)
+{
+  uiQueryResult = 0;
+  return EZ_SUCCESS;
+}
+
+// Timestamp functions
+
+void ezGALContextNull::InsertTimestampPlatform(ezGALTimestampHandle hTimestamp)
+{
+  static_cast<ezGALDeviceNull*>(GetDevice())->SetTimestamp(hTimestamp, ezTime::Now());
+}
+
+// Resource update functions
+
+void ezGALContextNull::CopyBufferPlatform(const ezGALBuffer* pDestination, const ezGALBuffer* pSource)
+{
+  m_CommandLog.Record(ezGALNullCommandType::CopyBuffer, 0, pSource->GetSize());
+}
+
+void ezGALContextNull::CopyBufferRegionPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, const ezGALBuffer* pSource, ezUInt32 uiSourceOffset, ezUInt32 uiByteCount)
+{
+  m_CommandLog.Record(ezGALNullCommandType::CopyBufferRegion, 0, uiByteCount);
+}
+
+void ezGALContextNull::UpdateBufferPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, ezArrayPtr<const ezUInt8> pSourceData, ezGALUpdateMode::Enum updateMode)
+{
+  m_CommandLog.Record(ezGALNullCommandType::UpdateBuffer, 0, pSourceData.GetCount());
+}
+
+void ezGALContextNull::CopyTexturePlatform(const ezGALTexture* pDestination, const ezGALTexture* pSource)
+{
+  const ezUInt64 uiSize = GetDevice()->GetMemoryConsumptionForTexture(pSource->GetDescription());
+  m_CommandLog.Record(ezGALNullCommandType::CopyTexture, 0, static_cast<ezUInt32>(uiSize));
+}
+
+void ezGALContextNull::CopyTextureRegionPlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource, const ezVec3U32& DestinationPoint, const ezGALTexture* pSource, const ezGALTextureSubresource& SourceSubResource, const ezBoundingBoxu32& Box)
+{
+  const ezUInt32 uiBitsPerElement = ezGALResourceFormat::GetBitsPerElement(pSource->GetDescription().m_Format);
+  const ezVec3U32 vSize = Box.m_vMax - Box.m_vMin;
+  m_CommandLog.Record(ezGALNullCommandType::CopyTextureRegion, 0, vSize.x * vSize.y * vSize.z * uiBitsPerElement / 8);
+}
+
+void ezGALContextNull::UpdateTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource, const ezBoundingBoxu32& DestinationBox, const ezGALSystemMemoryDescription& pSourceData)
+{
+  const ezUInt32 uiBitsPerElement = ezGALResourceFormat::GetBitsPerElement(pDestination->GetDescription().m_Format);
+  const ezVec3U32 vSize = DestinationBox.m_vMax - DestinationBox.m_vMin;
+  m_CommandLog.Record(ezGALNullCommandType::UpdateTexture, 0, vSize.x * vSize.y * vSize.z * uiBitsPerElement / 8);
+}
+
+void ezGALContextNull::ResolveTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource, const ezGALTexture* pSource, const ezGALTextureSubresource& SourceSubResource)
+{
+  m_CommandLog.Record(ezGALNullCommandType::ResolveTexture);
+}
+
+void ezGALContextNull::ReadbackTexturePlatform(const ezGALTexture* pTexture)
+{
+  const ezUInt64 uiSize = GetDevice()->GetMemoryConsumptionForTexture(pTexture->GetDescription());
+  m_CommandLog.Record(ezGALNullCommandType::ReadbackTexture, 0, static_cast<ezUInt32>(uiSize));
+}
+
+void ezGALContextNull::CopyTextureReadbackResultPlatform(const ezGALTexture* pTexture, const ezArrayPtr<ezGALSystemMemoryDescription>* pData)
+{
+  // Nothing has been rendered, so the result is just black.
+  for (const ezGALSystemMemoryDescription& memDesc : *pData)
+  {
+    ezMemoryUtils::ZeroFill(static_cast<ezUInt8*>(memDesc.m_pData), memDesc.m_uiSlicePitch);
+  }
+}
+
+void ezGALContextNull::GenerateMipMapsPlatform(const ezGALResourceView* pResourceView)
+{
+  m_CommandLog.Record(ezGALNullCommandType::GenerateMipMaps);
+}
+
+// Misc
+
+void ezGALContextNull::FlushPlatform() {}
+
+// Debug helper functions
+
+void ezGALContextNull::PushMarkerPlatform(const char* szMarker)
+{
+  m_CommandLog.PushMarker(szMarker);
+}
+
+void ezGALContextNull::PopMarkerPlatform()
+{
+  m_CommandLog.PopMarker();
+}
+
+void ezGALContextNull::InsertEventMarkerPlatform(const char* szMarker) {}
+
+
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Context_Implementation_ContextNull);
@@ -0,0 +1,399 @@
+#include <RendererNullPCH.h>
+
+#include <RendererNull/Context/ContextNull.h>
+#include <RendererNull/Device/DeviceNull.h>
+#include <RendererNull/Device/SwapChainNull.h>
+#include <RendererNull/Resources/ResourcesNull.h>
+#include <RendererNull/Shader/ShaderNull.h>
+#include <RendererNull/State/StateNull.h>
+
+ezGALDeviceNull::ezGALDeviceNull(const ezGALDeviceCreationDescription& Description)
+  : ezGALDevice(Description)
+{
+}
+
+ezGALDeviceNull::~ezGALDeviceNull() = default;
+
+ezGALContextNull* ezGALDeviceNull::GetNullContext() const
+{
+  return static_cast<ezGALContextNull*>(m_pPrimaryContext);
+}
+
+// Init & shutdown functions
+
+ezResult ezGALDeviceNull::InitPlatform()
+{
+  m_pPrimaryContext = EZ_NEW(&m_Allocator, ezGALContextNull, this);
+
+  // use the same conventions as the DX11 device, so that everything that is computed on the CPU is identical
+  ezClipSpaceDepthRange::Default = ezClipSpaceDepthRange::ZeroToOne;
+
+  m_Timestamps.SetCount(1024);
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALDeviceNull::ShutdownPlatform()
+{
+  m_Timestamps.Clear();
+
+  EZ_DELETE(&m_Allocator, m_pPrimaryContext);
+
+  return EZ_SUCCESS;
+}
+
+// State creation functions
+
+ezGALBlendState* ezGALDeviceNull::CreateBlendStatePlatform(const ezGALBlendStateCreationDescription& Description)
+{
+  ezGALBlendStateNull* pBlendState = EZ_NEW(&m_Allocator, ezGALBlendStateNull, Description);
+
+  if (!pBlendState->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pBlendState);
+    return nullptr;
+  }
+
+  return pBlendState;
+}
+
+void ezGALDeviceNull::DestroyBlendStatePlatform(ezGALBlendState* pBlendState)
+{
+  ezGALBlendStateNull* pNullBlendState = static_cast<ezGALBlendStateNull*>(pBlendState);
+  pNullBlendState->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pNullBlendState);
+}
+
+ezGALDepthStencilState* ezGALDeviceNull::CreateDepthStencilStatePlatform(const ezGALDepthStencilStateCreationDescription& Description)
+{
+  ezGALDepthStencilStateNull* pDepthStencilState = EZ_NEW(&m_Allocator, ezGALDepthStencilStateNull, Description);
+
+  if (!pDepthStencilState->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pDepthStencilState);
+    return nullptr;
+  }
+
+  return pDepthStencilState;
+}
+
+void ezGALDeviceNull::DestroyDepthStencilStatePlatform(ezGALDepthStencilState* pDepthStencilState)
+{
+  ezGALDepthStencilStateNull* pNullDepthStencilState = static_cast<ezGALDepthStencilStateNull*>(pDepthStencilState);
+  pNullDepthStencilState->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pNullDepthStencilState);
+}
+
+ezGALRasterizerState* ezGALDeviceNull::CreateRasterizerStatePlatform(const ezGALRasterizerStateCreationDescription& Description)
+{
+  ezGALRasterizerStateNull* pRasterizerState = EZ_NEW(&m_Allocator, ezGALRasterizerStateNull, Description);
+
+  if (!pRasterizerState->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pRasterizerState);
+    return nullptr;
+  }
+
+  return pRasterizerState;
+}
+
+void ezGALDeviceNull::DestroyRasterizerStatePlatform(ezGALRasterizerState* pRasterizerState)
+{
+  ezGALRasterizerStateNull* pNullRasterizerState = static_cast<ezGALRasterizerStateNull*>(pRasterizerState);
+  pNullRasterizerState->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pNullRasterizerState);
+}
+
+ezGALSamplerState* ezGALDeviceNull::CreateSamplerStatePlatform(const ezGALSamplerStateCreationDescription& Description)
+{
+  ezGALSamplerStateNull* pSamplerState = EZ_NEW(&m_Allocator, ezGALSamplerStateNull, Description);
+
+  if (!pSamplerState->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pSamplerState);
+    return nullptr;
+  }
+
+  return pSamplerState;
+}
+
+void ezGALDeviceNull::DestroySamplerStatePlatform(ezGALSamplerState* pSamplerState)
+{
+  ezGALSamplerStateNull* pNullSamplerState = static_cast<ezGALSamplerStateNull*>(pSamplerState);
+  pNullSamplerState->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pNullSamplerState);
+}
+
+// Resource creation functions
+
+ezGALShader* ezGALDeviceNull::CreateShaderPlatform(const ezGALShaderCreationDescription& Description)
+{
+  ezGALShaderNull* pShader = EZ_NEW(&m_Allocator, ezGALShaderNull, Description);
+
+  if (!pShader->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pShader);
+    return nullptr;
+  }
+
+  return pShader;
+}
+
+void ezGALDeviceNull::DestroyShaderPlatform(ezGALShader* pShader)
+{
+  ezGALShaderNull* pNullShader = static_cast<ezGALShaderNull*>(pShader);
+  pNullShader->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pNullShader);
+}
+
+ezGALBuffer* ezGALDeviceNull::CreateBufferPlatform(const ezGALBufferCreationDescription& Description, ezArrayPtr<const ezUInt8> pInitialData)
+{
+  ezGALBufferNull* pBuffer = EZ_NEW(&m_Allocator, ezGALBufferNull, Description);
+
+  if (!pBuffer->InitPlatform(this, pInitialData).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pBuffer);
+    return nullptr;
+  }
+
+  return pBuffer;
+}
+
+void ezGALDeviceNull::DestroyBufferPlatform(ezGALBuffer* pBuffer)
+{
+  ezGALBufferNull* pNullBuffer = static_cast<ezGALBufferNull*>(pBuffer);
+  pNullBuffer->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pNullBuffer);
+}
+
+ezGALTexture* ezGALDeviceNull::CreateTexturePlatform(const ezGALTextureCreationDescription& Description, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData)
+{
+  ezGALTextureNull* pTexture = EZ_NEW(&m_Allocator, ezGALTextureNull, Description);
+
+  if (!pTexture->InitPlatform(this, pInitialData).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pTexture);
+    return nullptr;
+  }
+
+  return pTexture;
+}
+
+void ezGALDeviceNull::DestroyTexturePlatform(ezGALTexture* pTexture)
+{
+  ezGALTextureNull* pNullTexture = static_cast<ezGALTextureNull*>(pTexture);
+  pNullTexture->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pNullTexture);
+}
+
+ezGALResourceView* ezGALDeviceNull::CreateResourceViewPlatform(ezGALResourceBase* pResource, const ezGALResourceViewCreationDescription& Description)
+{
+  ezGALResourceViewNull* pResourceView = EZ_NEW(&m_Allocator, ezGALResourceViewNull, pResource, Description);
+
+  if (!pResourceView->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pResourceView);
+    return nullptr;
+  }
+
+  return pResourceView;
+}
+
+void ezGALDeviceNull::DestroyResourceViewPlatform(ezGALResourceView* pResourceView)
+{
+  ezGALResourceViewNull* pNullResourceView = static_cast<ezGALResourceViewNull*>(pResourceView);
+  pNullResourceView->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pNullResourceView);
+}
+
+ezGALRenderTargetView* ezGALDeviceNull::CreateRenderTargetViewPlatform(ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description)
+{
+  ezGALRenderTargetViewNull* pRenderTargetView = EZ_NEW(&m_Allocator, ezGALRenderTargetViewNull, pTexture, Description);
+
+  if (!pRenderTargetView->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pRenderTargetView);
+    return nullptr;
+  }
+
+  return pRenderTargetView;
+}
+
+void ezGALDeviceNull::DestroyRenderTargetViewPlatform(ezGALRenderTargetView* pRenderTargetView)
+{
+  ezGALRenderTargetViewNull* pNullRenderTargetView = static_cast<ezGALRenderTargetViewNull*>(pRenderTargetView);
+  pNullRenderTargetView->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pNullRenderTargetView);
+}
+
+ezGALUnorderedAccessView* ezGALDeviceNull::CreateUnorderedAccessViewPlatform(ezGALResourceBase* pResource, const ezGALUnorderedAccessViewCreationDescription& Description)
+{
+  ezGALUnorderedAccessViewNull* pUnorderedAccessView = EZ_NEW(&m_Allocator, ezGALUnorderedAccessViewNull, pResource, Description);
+
+  if (!pUnorderedAccessView->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pUnorderedAccessView);
+    return nullptr;
+  }
+
+  return pUnorderedAccessView;
+}
+
+void ezGALDeviceNull::DestroyUnorderedAccessViewPlatform(ezGALUnorderedAccessView* pUnorderedAccessView)
+{
+  ezGALUnorderedAccessViewNull* pNullUnorderedAccessView = static_cast<ezGALUnorderedAccessViewNull*>(pUnorderedAccessView);
+  pNullUnorderedAccessView->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pNullUnorderedAccessView);
+}
+
+// Other rendering creation functions
+
+ezGALSwapChain* ezGALDeviceNull::CreateSwapChainPlatform(const ezGALSwapChainCreationDescription& Description)
+{
+  ezGALSwapChainNull* pSwapChain = EZ_NEW(&m_Allocator, ezGALSwapChainNull, Description);
+
+  if (!pSwapChain->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pSwapChain);
+    return nullptr;
+  }
+
+  return pSwapChain;
+}
+
+void ezGALDeviceNull::DestroySwapChainPlatform(ezGALSwapChain* pSwapChain)
+{
+  ezGALSwapChainNull* pNullSwapChain = static_cast<ezGALSwapChainNull*>(pSwapChain);
+  pNullSwapChain->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pNullSwapChain);
+}
+
+ezGALFence* ezGALDeviceNull::CreateFencePlatform()
+{
+  ezGALFenceNull* pFence = EZ_NEW(&m_Allocator, ezGALFenceNull);
+
+  if (!pFence->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pFence);
+    return nullptr;
+  }
+
+  return pFence;
+}
+
+void ezGALDeviceNull::DestroyFencePlatform(ezGALFence* pFence)
+{
+  ezGALFenceNull* pNullFence = static_cast<ezGALFenceNull*>(pFence);
+  pNullFence->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pNullFence);
+}
+
+ezGALQuery* ezGALDeviceNull::CreateQueryPlatform(const ezGALQueryCreationDescription& Description)
+{
+  ezGALQueryNull* pQuery = EZ_NEW(&m_Allocator, ezGALQueryNull, Description);
+
+  if (!pQuery->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pQuery);
+    return nullptr;
+  }
+
+  return pQuery;
+}
+
+void ezGALDeviceNull::DestroyQueryPlatform(ezGALQuery* pQuery)
+{
+  ezGALQueryNull* pNullQuery = static_cast<ezGALQueryNull*>(pQuery);
+  pNullQuery->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pNullQuery);
+}
+
+ezGALVertexDeclaration* ezGALDeviceNull::CreateVertexDeclarationPlatform(const ezGALVertexDeclarationCreationDescription& Description)
+{
+  ezGALVertexDeclarationNull* pVertexDeclaration = EZ_NEW(&m_Allocator, ezGALVertexDeclarationNull, Description);
+
+  if (!pVertexDeclaration->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pVertexDeclaration);
+    return nullptr;
+  }
+
+  return pVertexDeclaration;
+}
+
+void ezGALDeviceNull::DestroyVertexDeclarationPlatform(ezGALVertexDeclaration* pVertexDeclaration)
+{
+  ezGALVertexDeclarationNull* pNullVertexDeclaration = static_cast<ezGALVertexDeclarationNull*>(pVertexDeclaration);
+  pNullVertexDeclaration->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pNullVertexDeclaration);
+}
+
+// Timestamp functions
+
+ezGALTimestampHandle ezGALDeviceNull::GetTimestampPlatform()
+{
+  ezUInt32 uiIndex = m_uiNextTimestamp;
+  m_uiNextTimestamp = (m_uiNextTimestamp + 1) % m_Timestamps.GetCount();
+  return {uiIndex, m_uiFrameCounter};
+}
+
+ezResult ezGALDeviceNull::GetTimestampResultPlatform(ezGALTimestampHandle hTimestamp, ezTime& result)
+{
+  result = m_Timestamps[static_cast<ezUInt32>(hTimestamp.m_uiIndex)];
+  return EZ_SUCCESS;
+}
+
+void ezGALDeviceNull::SetTimestamp(ezGALTimestampHandle hTimestamp, ezTime time)
+{
+  m_Timestamps[static_cast<ezUInt32>(hTimestamp.m_uiIndex)] = time;
+}
+
+// Swap chain functions
+
+void ezGALDeviceNull::PresentPlatform(ezGALSwapChain* pSwapChain, bool bVSync) {}
+
+// Misc functions
+
+void ezGALDeviceNull::BeginFramePlatform() {}
+
+void ezGALDeviceNull::EndFramePlatform()
+{
+  ++m_uiFrameCounter;
+}
+
+void ezGALDeviceNull::SetPrimarySwapChainPlatform(ezGALSwapChain* pSwapChain) {}
+
+void ezGALDeviceNull::FillCapabilitiesPlatform()
+{
+  m_Capabilities.m_sAdapterName = "Null Device";
+  m_Capabilities.m_bHardwareAccelerated = false;
+
+  m_Capabilities.m_bMultithreadedResourceCreation = true;
+  m_Capabilities.m_bNoOverwriteBufferUpdate = true;
+
+  for (ezUInt32 stage = 0; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
+  {
+    m_Capabilities.m_bShaderStageSupported[stage] = true;
+  }
+
+  m_Capabilities.m_bInstancing = true;
+  m_Capabilities.m_b32BitIndices = true;
+  m_Capabilities.m_bIndirectDraw = true;
+  m_Capabilities.m_bStreamOut = true;
+  m_Capabilities.m_uiMaxConstantBuffers = 14;
+  m_Capabilities.m_bTextureArrays = true;
+  m_Capabilities.m_bCubemapArrays = true;
+  m_Capabilities.m_bB5G6R5Textures = true;
+  m_Capabilities.m_uiMaxTextureDimension = 16384;
+  m_Capabilities.m_uiMaxCubemapDimension = 16384;
+  m_Capabilities.m_uiMax3DTextureDimension = 2048;
+  m_Capabilities.m_uiMaxAnisotropy = 16;
+  m_Capabilities.m_uiMaxRendertargets = 8;
+  m_Capabilities.m_uiUAVCount = 64;
+  m_Capabilities.m_bAlphaToCoverage = true;
+  m_Capabilities.m_bConservativeRasterization = true;
+}
+
+
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Device_Implementation_DeviceNull);
@@ -0,0 +1,41 @@
+#include <RendererNullPCH.h>
+
+#include <RendererFoundation/Device/Device.h>
+#include <RendererNull/Device/SwapChainNull.h>
+#include <System/Window/Window.h>
+
+ezGALSwapChainNull::ezGALSwapChainNull(const ezGALSwapChainCreationDescription& Description)
+  : ezGALSwapChain(Description)
+{
+}
+
+ezGALSwapChainNull::~ezGALSwapChainNull() = default;
+
+ezResult ezGALSwapChainNull::InitPlatform(ezGALDevice* pDevice)
+{
+  ezGALTextureCreationDescription TexDesc;
+  TexDesc.m_uiWidth = m_Description.m_pWindow->GetClientAreaSize().width;
+  TexDesc.m_uiHeight = m_Description.m_pWindow->GetClientAreaSize().height;
+  TexDesc.m_SampleCount = m_Description.m_SampleCount;
+  TexDesc.m_Format = m_Description.m_BackBufferFormat;
+  TexDesc.m_bAllowShaderResourceView = false;
+  TexDesc.m_bCreateRenderTarget = true;
+  TexDesc.m_ResourceAccess.m_bImmutable = true;
+  TexDesc.m_ResourceAccess.m_bReadBack = m_Description.m_bAllowScreenshots;
+
+  m_hBackBufferTexture = pDevice->CreateTexture(TexDesc);
+
+  return m_hBackBufferTexture.IsInvalidated() ? EZ_FAILURE : EZ_SUCCESS;
+}
+
+ezResult ezGALSwapChainNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  pDevice->DestroyTexture(m_hBackBufferTexture);
+  m_hBackBufferTexture.Invalidate();
+
+  return ezGALSwapChain::DeInitPlatform(pDevice);
+}
+
+
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Device_Implementation_SwapChainNull);
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <RendererFoundation/Device/SwapChain.h>
+#include <RendererNull/RendererNullDLL.h>
+
+/// \brief A swap chain that only provides a back buffer texture of the window's size, nothing is ever shown on screen.
+class EZ_RENDERERNULL_DLL ezGALSwapChainNull : public ezGALSwapChain
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALSwapChainNull(const ezGALSwapChainCreationDescription& Description);
+
+  virtual ~ezGALSwapChainNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
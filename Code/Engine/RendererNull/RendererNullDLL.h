@@ -0,0 +1,15 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <RendererFoundation/RendererFoundationDLL.h>
+
+// Configure the DLL Import/Export Define
+#if EZ_ENABLED(EZ_COMPILE_ENGINE_AS_DLL)
+  #ifdef BUILDSYSTEM_BUILDING_RENDERERNULL_LIB
+    #define EZ_RENDERERNULL_DLL __declspec(dllexport)
+  #else
+    #define EZ_RENDERERNULL_DLL __declspec(dllimport)
+  #endif
+#else
+  #define EZ_RENDERERNULL_DLL
+#endif
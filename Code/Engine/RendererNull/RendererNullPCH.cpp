@@ -0,0 +1,15 @@
+#include <RendererNullPCH.h>
+
+EZ_STATICLINK_LIBRARY(RendererNull)
+{
+  if (bReturn)
+    return;
+
+  EZ_STATICLINK_REFERENCE(RendererNull_Context_Implementation_CommandLogNull);
+  EZ_STATICLINK_REFERENCE(RendererNull_Context_Implementation_ContextNull);
+  EZ_STATICLINK_REFERENCE(RendererNull_Device_Implementation_DeviceNull);
+  EZ_STATICLINK_REFERENCE(RendererNull_Device_Implementation_SwapChainNull);
+  EZ_STATICLINK_REFERENCE(RendererNull_Resources_Implementation_ResourcesNull);
+  EZ_STATICLINK_REFERENCE(RendererNull_Shader_Implementation_ShaderNull);
+  EZ_STATICLINK_REFERENCE(RendererNull_State_Implementation_StateNull);
+}
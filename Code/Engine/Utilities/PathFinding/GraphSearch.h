@@ -1,8 +1,12 @@
 #pragma once
 
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Math/Math.h>
-#include <Utilities/UtilitiesDLL.h>
+#include <Foundation/Types/Delegate.h>
+#include <Foundation/Types/UniquePtr.h>
 #include <Utilities/PathFinding/PathState.h>
+#include <Utilities/UtilitiesDLL.h>
 
 /// \brief Implements a directed breadth-first search through a graph (A*).
 ///
@@ -11,6 +15,13 @@
 ///
 /// PathStateType must be derived from ezPathState and can be used for keeping track of certain state along a path and to modify
 /// the path search dynamically.
+///
+/// The open list is an indexed binary min-heap (keyed by ezPathState::m_fEstimatedCostToTarget) that supports decrease-key,
+/// so expanding a node is O(log n) in the size of the open list. All visited states are stored in one flat array.
+/// By default graph node indices are mapped to states through a hash table. If the node indices of the graph are known to lie in
+/// [0; N), SetDenseNodeIndexRange() switches to a plain lookup array, which is considerably faster for grid-like graphs.
+///
+/// FindPathsParallel() runs many independent path requests in parallel on the ezTaskSystem.
 template <typename PathStateType>
 class ezPathSearch
 {
@@ -30,9 +41,37 @@ public:
     const PathStateType* m_pPathState;
   };
 
+  /// \brief Describes one path request for FindPathsParallel(). The result members are filled out by the path search.
+  struct PathRequest
+  {
+    ezInt64 m_iStartNodeIndex = 0;
+    ezInt64 m_iTargetNodeIndex = 0;
+    PathStateType m_StartState;
+    float m_fMaxPathCost = ezMath::Infinity<float>();
+
+    /// \brief Whether a path was found.
+    ezResult m_Result = EZ_FAILURE;
+
+    /// \brief The nodes along the found path, including the start and target node.
+    ezDynamicArray<ezInt64> m_Path;
+
+    /// \brief The m_fCostToNode of the target node, if a path was found.
+    float m_fPathCost = 0.0f;
+  };
+
+  /// \brief Used by FindPathsParallel() to create one ezPathStateGenerator per task, since generators typically carry state.
+  typedef ezDelegate<ezUniquePtr<ezPathStateGenerator<PathStateType>>()> CreateStateGeneratorCallback;
+
   /// \brief Sets the ezPathStateGenerator that should be used by this ezPathSearch object.
   void SetPathStateGenerator(ezPathStateGenerator<PathStateType>* pStateGenerator) { m_pStateGenerator = pStateGenerator; }
 
+  /// \brief Tells the path search that all graph node indices lie in the range [0; uiNumNodes).
+  ///
+  /// This allows the search to map node indices to states through a flat array instead of a hash table.
+  /// The array is allocated once and reused for all following searches. Pass 0 to switch back to hash table lookups, which works
+  /// with arbitrary node indices.
+  void SetDenseNodeIndexRange(ezUInt32 uiNumNodes);
+
   /// \brief Searches for a path that starts at the graph node \a iStartNodeIndex with the start state \a StartState and shall terminate
   /// when the graph node \a iTargetNodeIndex was reached.
   ///
@@ -53,21 +92,63 @@ public:
   ezResult FindClosest(ezInt64 iStartNodeIndex, const PathStateType& StartState, IsSearchedObjectCallback Callback,
                        ezDeque<PathResultData>& out_Path, float fMaxPathCost = ezMath::Infinity<float>());
 
+  /// \brief Runs all \a requests in parallel on the ezTaskSystem and blocks until all of them are finished.
+  ///
+  /// Every task creates its own ezPathSearch and uses \a createStateGenerator to get its own ezPathStateGenerator,
+  /// so the generators do not need to be thread-safe, but they must only read shared graph data.
+  /// If \a uiDenseNodeIndexRange is non-zero, it is passed to SetDenseNodeIndexRange() of every task's path search.
+  static void FindPathsParallel(ezArrayPtr<PathRequest> requests, CreateStateGeneratorCallback createStateGenerator, ezUInt32 uiDenseNodeIndexRange = 0);
+
   /// \brief Needs to be called by the used ezPathStateGenerator to add nodes to evaluate.
   void AddPathNode(ezInt64 iNodeIndex, const PathStateType& NewState);
 
 private:
+  struct StateEntry
+  {
+    PathStateType m_State;
+    ezInt64 m_iNodeIndex;
+
+    /// Position of this state in m_OpenList, ezInvalidIndex once it was expanded.
+    ezUInt32 m_uiOpenListIndex;
+  };
+
+  struct OpenListEntry
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    float m_fEstimatedCostToTarget;
+    ezUInt32 m_uiStateIndex;
+  };
+
   void ClearPathStates();
-  ezInt64 FindBestNodeToExpand(PathStateType*& out_pPathState);
-  void FillOutPathResult(ezInt64 iEndNodeIndex, ezDeque<PathResultData>& out_Path);
+  ezUInt32 FindStateIndex(ezInt64 iNodeIndex) const;
+  ezUInt32 CreateState(ezInt64 iNodeIndex, const PathStateType& State);
+  void StartSearch(ezInt64 iStartNodeIndex, const PathStateType& StartState);
+
+  void OpenListInsert(ezUInt32 uiStateIndex);
+  void OpenListUpdate(ezUInt32 uiHeapIndex);
+  void OpenListMoveUp(ezUInt32 uiHeapIndex);
+  void OpenListMoveDown(ezUInt32 uiHeapIndex);
+  void OpenListSet(ezUInt32 uiHeapIndex, const OpenListEntry& entry);
+
+  ezUInt32 FindBestNodeToExpand();
+  void FillOutPathResult(ezUInt32 uiEndStateIndex, ezDeque<PathResultData>& out_Path);
+
+  ezPathStateGenerator<PathStateType>* m_pStateGenerator = nullptr;
+
+  /// All states that were reached during the current search. A deque is used so that pointers to states remain valid.
+  ezDeque<StateEntry> m_PathStates;
 
-  ezPathStateGenerator<PathStateType>* m_pStateGenerator;
+  /// Maps node indices to indices in m_PathStates, used when no dense node index range is set.
+  ezHashTable<ezInt64, ezUInt32> m_NodeToState;
 
-  ezHashTable<ezInt64, PathStateType> m_PathStates;
+  /// Maps node indices to indices in m_PathStates, used when a dense node index range is set.
+  ezDynamicArray<ezUInt32> m_DenseNodeToState;
 
-  ezDeque<ezInt64> m_StateQueue;
+  /// Binary min-heap of the states that still need to be expanded.
+  ezDynamicArray<OpenListEntry> m_OpenList;
 
-  ezInt64 m_iCurNodeIndex;
+  ezInt64 m_iCurNodeIndex = 0;
   PathStateType m_CurState;
 };
 
@@ -1,60 +1,204 @@
 #pragma once
 
+#include <Foundation/Threading/TaskSystem.h>
+
+template <typename PathStateType>
+void ezPathSearch<PathStateType>::SetDenseNodeIndexRange(ezUInt32 uiNumNodes)
+{
+  m_NodeToState.Clear();
+  m_DenseNodeToState.Clear();
+
+  if (uiNumNodes > 0)
+  {
+    m_DenseNodeToState.SetCountUninitialized(uiNumNodes);
+
+    for (ezUInt32& uiState : m_DenseNodeToState)
+    {
+      uiState = ezInvalidIndex;
+    }
+  }
+
+  m_PathStates.Clear();
+  m_OpenList.Clear();
+}
+
 template <typename PathStateType>
 void ezPathSearch<PathStateType>::ClearPathStates()
 {
+  if (!m_DenseNodeToState.IsEmpty())
+  {
+    // only reset the entries that were touched by the previous search, instead of the whole lookup array
+    for (const StateEntry& entry : m_PathStates)
+    {
+      m_DenseNodeToState[static_cast<ezUInt32>(entry.m_iNodeIndex)] = ezInvalidIndex;
+    }
+  }
+  else
+  {
+    m_NodeToState.Clear();
+  }
+
   m_PathStates.Clear();
-  m_StateQueue.Clear();
+  m_OpenList.Clear();
+}
+
+template <typename PathStateType>
+EZ_ALWAYS_INLINE ezUInt32 ezPathSearch<PathStateType>::FindStateIndex(ezInt64 iNodeIndex) const
+{
+  if (!m_DenseNodeToState.IsEmpty())
+  {
+    EZ_ASSERT_DEBUG(iNodeIndex >= 0 && iNodeIndex < m_DenseNodeToState.GetCount(), "Node index {0} is outside the dense node index range.", iNodeIndex);
+    return m_DenseNodeToState[static_cast<ezUInt32>(iNodeIndex)];
+  }
+
+  ezUInt32 uiStateIndex = ezInvalidIndex;
+  m_NodeToState.TryGetValue(iNodeIndex, uiStateIndex);
+  return uiStateIndex;
 }
 
 template <typename PathStateType>
-ezInt64 ezPathSearch<PathStateType>::FindBestNodeToExpand(PathStateType*& out_pPathState)
+ezUInt32 ezPathSearch<PathStateType>::CreateState(ezInt64 iNodeIndex, const PathStateType& State)
 {
-  float fLowestEstimation = ezMath::Infinity<float>();
-  out_pPathState = nullptr;
-  ezUInt32 iBestInQueue = 0;
+  const ezUInt32 uiStateIndex = m_PathStates.GetCount();
 
-  for (ezUInt32 i = 0; i < m_StateQueue.GetCount(); ++i)
+  StateEntry& entry = m_PathStates.ExpandAndGetRef();
+  entry.m_State = State;
+  entry.m_iNodeIndex = iNodeIndex;
+  entry.m_uiOpenListIndex = ezInvalidIndex;
+
+  if (!m_DenseNodeToState.IsEmpty())
+  {
+    EZ_ASSERT_DEBUG(iNodeIndex >= 0 && iNodeIndex < m_DenseNodeToState.GetCount(), "Node index {0} is outside the dense node index range.", iNodeIndex);
+    m_DenseNodeToState[static_cast<ezUInt32>(iNodeIndex)] = uiStateIndex;
+  }
+  else
   {
-    const ezInt64 iNodeIndex = m_StateQueue[i];
+    m_NodeToState.Insert(iNodeIndex, uiStateIndex);
+  }
 
-    PathStateType* pState = &m_PathStates[iNodeIndex];
+  return uiStateIndex;
+}
 
-    if (pState->m_fEstimatedCostToTarget < fLowestEstimation)
-    {
-      fLowestEstimation = pState->m_fEstimatedCostToTarget;
-      out_pPathState = pState;
-      iBestInQueue = i;
-    }
+template <typename PathStateType>
+EZ_ALWAYS_INLINE void ezPathSearch<PathStateType>::OpenListSet(ezUInt32 uiHeapIndex, const OpenListEntry& entry)
+{
+  m_OpenList[uiHeapIndex] = entry;
+  m_PathStates[entry.m_uiStateIndex].m_uiOpenListIndex = uiHeapIndex;
+}
+
+template <typename PathStateType>
+void ezPathSearch<PathStateType>::OpenListMoveUp(ezUInt32 uiHeapIndex)
+{
+  const OpenListEntry entry = m_OpenList[uiHeapIndex];
+
+  while (uiHeapIndex > 0)
+  {
+    const ezUInt32 uiParent = (uiHeapIndex - 1) / 2;
+
+    if (m_OpenList[uiParent].m_fEstimatedCostToTarget <= entry.m_fEstimatedCostToTarget)
+      break;
+
+    OpenListSet(uiHeapIndex, m_OpenList[uiParent]);
+    uiHeapIndex = uiParent;
+  }
+
+  OpenListSet(uiHeapIndex, entry);
+}
+
+template <typename PathStateType>
+void ezPathSearch<PathStateType>::OpenListMoveDown(ezUInt32 uiHeapIndex)
+{
+  const OpenListEntry entry = m_OpenList[uiHeapIndex];
+  const ezUInt32 uiCount = m_OpenList.GetCount();
+
+  while (true)
+  {
+    ezUInt32 uiChild = uiHeapIndex * 2 + 1;
+
+    if (uiChild >= uiCount)
+      break;
+
+    // pick the cheaper of the two children
+    if (uiChild + 1 < uiCount && m_OpenList[uiChild + 1].m_fEstimatedCostToTarget < m_OpenList[uiChild].m_fEstimatedCostToTarget)
+      ++uiChild;
+
+    if (entry.m_fEstimatedCostToTarget <= m_OpenList[uiChild].m_fEstimatedCostToTarget)
+      break;
+
+    OpenListSet(uiHeapIndex, m_OpenList[uiChild]);
+    uiHeapIndex = uiChild;
   }
 
-  EZ_ASSERT_DEV(out_pPathState != nullptr, "Implementation Error");
+  OpenListSet(uiHeapIndex, entry);
+}
+
+template <typename PathStateType>
+void ezPathSearch<PathStateType>::OpenListInsert(ezUInt32 uiStateIndex)
+{
+  OpenListEntry& entry = m_OpenList.ExpandAndGetRef();
+  entry.m_fEstimatedCostToTarget = m_PathStates[uiStateIndex].m_State.m_fEstimatedCostToTarget;
+  entry.m_uiStateIndex = uiStateIndex;
 
-  const ezInt64 iBestNodeIndex = m_StateQueue[iBestInQueue];
-  m_StateQueue.RemoveAtAndSwap(iBestInQueue);
+  OpenListMoveUp(m_OpenList.GetCount() - 1);
+}
 
-  return iBestNodeIndex;
+template <typename PathStateType>
+void ezPathSearch<PathStateType>::OpenListUpdate(ezUInt32 uiHeapIndex)
+{
+  OpenListEntry& entry = m_OpenList[uiHeapIndex];
+  const float fOldEstimation = entry.m_fEstimatedCostToTarget;
+  entry.m_fEstimatedCostToTarget = m_PathStates[entry.m_uiStateIndex].m_State.m_fEstimatedCostToTarget;
+
+  // the estimation usually goes down (decrease-key), but a state generator is allowed to change its heuristic along the way
+  if (entry.m_fEstimatedCostToTarget < fOldEstimation)
+    OpenListMoveUp(uiHeapIndex);
+  else
+    OpenListMoveDown(uiHeapIndex);
 }
 
 template <typename PathStateType>
-void ezPathSearch<PathStateType>::FillOutPathResult(ezInt64 iEndNodeIndex, ezDeque<PathResultData>& out_Path)
+ezUInt32 ezPathSearch<PathStateType>::FindBestNodeToExpand()
+{
+  EZ_ASSERT_DEV(!m_OpenList.IsEmpty(), "Implementation Error");
+
+  const ezUInt32 uiBestState = m_OpenList[0].m_uiStateIndex;
+  m_PathStates[uiBestState].m_uiOpenListIndex = ezInvalidIndex;
+
+  const ezUInt32 uiLast = m_OpenList.GetCount() - 1;
+
+  if (uiLast > 0)
+  {
+    m_OpenList[0] = m_OpenList[uiLast];
+    m_OpenList.PopBack();
+    OpenListMoveDown(0);
+  }
+  else
+  {
+    m_OpenList.PopBack();
+  }
+
+  return uiBestState;
+}
+
+template <typename PathStateType>
+void ezPathSearch<PathStateType>::FillOutPathResult(ezUInt32 uiEndStateIndex, ezDeque<PathResultData>& out_Path)
 {
   out_Path.Clear();
 
   while (true)
   {
-    const PathStateType* pCurState = &m_PathStates[iEndNodeIndex];
+    const StateEntry& curState = m_PathStates[uiEndStateIndex];
 
     PathResultData r;
-    r.m_iNodeIndex = iEndNodeIndex;
-    r.m_pPathState = pCurState;
+    r.m_iNodeIndex = curState.m_iNodeIndex;
+    r.m_pPathState = &curState.m_State;
 
     out_Path.PushFront(r);
 
-    if (iEndNodeIndex == pCurState->m_iReachedThroughNode)
+    if (curState.m_iNodeIndex == curState.m_State.m_iReachedThroughNode)
       return;
 
-    iEndNodeIndex = pCurState->m_iReachedThroughNode;
+    uiEndStateIndex = FindStateIndex(curState.m_State.m_iReachedThroughNode);
   }
 }
 
@@ -69,28 +213,47 @@ void ezPathSearch<PathStateType>::AddPathNode(ezInt64 iNodeIndex, const PathStat
   // ezArgF(m_pCurPathState->m_fEstimatedCostToTarget, 2), ezArgF(NewState.m_fEstimatedCostToTarget, 2));
   EZ_ASSERT_DEV(NewState.m_fEstimatedCostToTarget >= NewState.m_fCostToNode, "Unrealistic expectations will get you nowhere.");
 
-  PathStateType* pExistingState;
+  const ezUInt32 uiExistingState = FindStateIndex(iNodeIndex);
 
-  if (m_PathStates.TryGetValue(iNodeIndex, pExistingState))
+  if (uiExistingState != ezInvalidIndex)
   {
-    // state already exists in the hash table, and has a lower cost -> ignore the new state
-    if (pExistingState->m_fCostToNode <= NewState.m_fCostToNode)
+    StateEntry& existing = m_PathStates[uiExistingState];
+
+    // state already exists, and has a lower cost -> ignore the new state
+    if (existing.m_State.m_fCostToNode <= NewState.m_fCostToNode)
       return;
 
     // incoming state is better than the existing state -> update existing state
-    *pExistingState = NewState;
-    pExistingState->m_iReachedThroughNode = m_iCurNodeIndex;
+    existing.m_State = NewState;
+    existing.m_State.m_iReachedThroughNode = m_iCurNodeIndex;
+
+    // if the state is still waiting to be expanded, move it to its new place in the queue
+    if (existing.m_uiOpenListIndex != ezInvalidIndex)
+    {
+      OpenListUpdate(existing.m_uiOpenListIndex);
+    }
+
     return;
   }
 
   // the state has not been reached before -> insert it
-  pExistingState = &m_PathStates[iNodeIndex];
-
-  *pExistingState = NewState;
-  pExistingState->m_iReachedThroughNode = m_iCurNodeIndex;
+  const ezUInt32 uiNewState = CreateState(iNodeIndex, NewState);
+  m_PathStates[uiNewState].m_State.m_iReachedThroughNode = m_iCurNodeIndex;
 
   // put it into the queue of states that still need to be expanded
-  m_StateQueue.PushBack(iNodeIndex);
+  OpenListInsert(uiNewState);
+}
+
+template <typename PathStateType>
+void ezPathSearch<PathStateType>::StartSearch(ezInt64 iStartNodeIndex, const PathStateType& StartState)
+{
+  const ezUInt32 uiFirstState = CreateState(iStartNodeIndex, StartState);
+
+  // make sure the first state references itself, as that is a termination criterion
+  m_PathStates[uiFirstState].m_State.m_iReachedThroughNode = iStartNodeIndex;
+
+  // put the start state into the to-be-expanded queue
+  OpenListInsert(uiFirstState);
 }
 
 template <typename PathStateType>
@@ -103,13 +266,11 @@ ezResult ezPathSearch<PathStateType>::FindPath(ezInt64 iStartNodeIndex, const Pa
 
   if (iStartNodeIndex == iTargetNodeIndex)
   {
-    m_PathStates.Reserve(1);
-
-    m_PathStates[iTargetNodeIndex] = StartState;
+    const ezUInt32 uiState = CreateState(iTargetNodeIndex, StartState);
 
     PathResultData r;
     r.m_iNodeIndex = iTargetNodeIndex;
-    r.m_pPathState = &m_PathStates[iTargetNodeIndex];
+    r.m_pPathState = &m_PathStates[uiState].m_State;
 
     out_Path.Clear();
     out_Path.PushBack(r);
@@ -117,29 +278,27 @@ ezResult ezPathSearch<PathStateType>::FindPath(ezInt64 iStartNodeIndex, const Pa
     return EZ_SUCCESS;
   }
 
-  m_PathStates.Reserve(10000);
-
-  PathStateType& FirstState = m_PathStates[iStartNodeIndex];
+  if (m_DenseNodeToState.IsEmpty())
+  {
+    m_NodeToState.Reserve(10000);
+  }
 
-  m_pStateGenerator->StartSearch(iStartNodeIndex, &FirstState, iTargetNodeIndex);
+  m_pStateGenerator->StartSearch(iStartNodeIndex, &StartState, iTargetNodeIndex);
 
-  // make sure the first state references itself, as that is a termination criterion
-  FirstState = StartState;
-  FirstState.m_iReachedThroughNode = iStartNodeIndex;
-
-  // put the start state into the to-be-expanded queue
-  m_StateQueue.PushBack(iStartNodeIndex);
+  StartSearch(iStartNodeIndex, StartState);
 
   // while the queue is not empty, expand the next node and see where that gets us
-  while (!m_StateQueue.IsEmpty())
+  while (!m_OpenList.IsEmpty())
   {
-    PathStateType* pCurState;
-    m_iCurNodeIndex = FindBestNodeToExpand(pCurState);
+    const ezUInt32 uiCurState = FindBestNodeToExpand();
+    const StateEntry& curEntry = m_PathStates[uiCurState];
+
+    m_iCurNodeIndex = curEntry.m_iNodeIndex;
 
     // we have reached the target node, generate the final path result
     if (m_iCurNodeIndex == iTargetNodeIndex)
     {
-      FillOutPathResult(m_iCurNodeIndex, out_Path);
+      FillOutPathResult(uiCurState, out_Path);
       m_pStateGenerator->SearchFinished(EZ_SUCCESS);
       return EZ_SUCCESS;
     }
@@ -147,13 +306,13 @@ ezResult ezPathSearch<PathStateType>::FindPath(ezInt64 iStartNodeIndex, const Pa
     // The heuristic may overestimate how much it takes to reach the destination
     // thus even though the heuristic tells us we may not be able to make it, we cannot rely on that, but need to look at
     // the actual costs
-    if (pCurState->m_fCostToNode >= fMaxPathCost)
+    if (curEntry.m_State.m_fCostToNode >= fMaxPathCost)
     {
       m_pStateGenerator->SearchFinished(EZ_FAILURE);
       return EZ_FAILURE;
     }
 
-    m_CurState = *pCurState;
+    m_CurState = curEntry.m_State;
 
     // let the generate append all the nodes that we can reach from here
     m_pStateGenerator->GenerateAdjacentStates(m_iCurNodeIndex, m_CurState, this);
@@ -172,29 +331,27 @@ ezResult ezPathSearch<PathStateType>::FindClosest(ezInt64 iStartNodeIndex, const
 
   ClearPathStates();
 
-  m_PathStates.Reserve(10000);
-
-  PathStateType& FirstState = m_PathStates[iStartNodeIndex];
+  if (m_DenseNodeToState.IsEmpty())
+  {
+    m_NodeToState.Reserve(10000);
+  }
 
-  m_pStateGenerator->StartSearchForClosest(iStartNodeIndex, &FirstState);
+  m_pStateGenerator->StartSearchForClosest(iStartNodeIndex, &StartState);
 
-  // make sure the first state references itself, as that is a termination criterion
-  FirstState = StartState;
-  FirstState.m_iReachedThroughNode = iStartNodeIndex;
-
-  // put the start state into the to-be-expanded queue
-  m_StateQueue.PushBack(iStartNodeIndex);
+  StartSearch(iStartNodeIndex, StartState);
 
   // while the queue is not empty, expand the next node and see where that gets us
-  while (!m_StateQueue.IsEmpty())
+  while (!m_OpenList.IsEmpty())
   {
-    PathStateType* pCurState;
-    m_iCurNodeIndex = FindBestNodeToExpand(pCurState);
+    const ezUInt32 uiCurState = FindBestNodeToExpand();
+    const StateEntry& curEntry = m_PathStates[uiCurState];
+
+    m_iCurNodeIndex = curEntry.m_iNodeIndex;
 
     // we have reached the target node, generate the final path result
-    if (Callback(m_iCurNodeIndex, *pCurState))
+    if (Callback(m_iCurNodeIndex, curEntry.m_State))
     {
-      FillOutPathResult(m_iCurNodeIndex, out_Path);
+      FillOutPathResult(uiCurState, out_Path);
       m_pStateGenerator->SearchFinished(EZ_SUCCESS);
       return EZ_SUCCESS;
     }
@@ -202,13 +359,13 @@ ezResult ezPathSearch<PathStateType>::FindClosest(ezInt64 iStartNodeIndex, const
     // The heuristic may overestimate how much it takes to reach the destination
     // thus even though the heuristic tells us we may not be able to make it, we cannot rely on that, but need to look at
     // the actual costs
-    if (pCurState->m_fCostToNode >= fMaxPathCost)
+    if (curEntry.m_State.m_fCostToNode >= fMaxPathCost)
     {
       m_pStateGenerator->SearchFinished(EZ_FAILURE);
       return EZ_FAILURE;
     }
 
-    m_CurState = *pCurState;
+    m_CurState = curEntry.m_State;
 
     // let the generate append all the nodes that we can reach from here
     m_pStateGenerator->GenerateAdjacentStates(m_iCurNodeIndex, m_CurState, this);
@@ -218,3 +375,45 @@ ezResult ezPathSearch<PathStateType>::FindClosest(ezInt64 iStartNodeIndex, const
   return EZ_FAILURE;
 }
 
+template <typename PathStateType>
+void ezPathSearch<PathStateType>::FindPathsParallel(ezArrayPtr<PathRequest> requests, CreateStateGeneratorCallback createStateGenerator, ezUInt32 uiDenseNodeIndexRange /*= 0*/)
+{
+  ezParallelForParams params;
+  params.uiBinSize = 4;
+
+  ezTaskSystem::ParallelForIndexed(
+    0, requests.GetCount(),
+    [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      ezUniquePtr<ezPathStateGenerator<PathStateType>> pGenerator = createStateGenerator();
+
+      ezPathSearch<PathStateType> search;
+      search.SetPathStateGenerator(pGenerator.Borrow());
+
+      if (uiDenseNodeIndexRange > 0)
+      {
+        search.SetDenseNodeIndexRange(uiDenseNodeIndexRange);
+      }
+
+      ezDeque<PathResultData> path;
+
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        PathRequest& request = requests[i];
+        request.m_Path.Clear();
+        request.m_fPathCost = 0.0f;
+        request.m_Result = search.FindPath(request.m_iStartNodeIndex, request.m_StartState, request.m_iTargetNodeIndex, path, request.m_fMaxPathCost);
+
+        if (request.m_Result.Failed())
+          continue;
+
+        request.m_Path.Reserve(path.GetCount());
+        for (const PathResultData& step : path)
+        {
+          request.m_Path.PushBack(step.m_iNodeIndex);
+        }
+
+        request.m_fPathCost = path.PeekBack().m_pPathState->m_fCostToNode;
+      }
+    },
+    "ezPathSearch::FindPathsParallel", params);
+}
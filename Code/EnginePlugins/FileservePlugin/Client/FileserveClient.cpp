@@ -4,8 +4,11 @@
 #include <FileservePlugin/Fileserver/ClientContext.h>
 #include <Foundation/Communication/GlobalEvent.h>
 #include <Foundation/Communication/RemoteInterfaceEnet.h>
+#include <Foundation/Containers/Set.h>
+#include <Foundation/IO/CompressedStreamZstd.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/IO/FileSystem/Implementation/DataDirType.h>
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Types/ScopeExit.h>
 #include <Foundation/Utilities/CommandLineUtils.h>
@@ -48,6 +51,8 @@ ezFileserveClient::ezFileserveClient()
   if (ezCommandLineUtils::GetGlobalInstance()->GetBoolOption("-fs_off"))
     s_bEnableFileserve = false;
 
+  m_PrefetchTimeout = ezTime::Seconds(ezCommandLineUtils::GetGlobalInstance()->GetFloatOption("-fs_prefetch_timeout", m_PrefetchTimeout.GetSeconds()));
+
   m_CurrentTime = ezTime::Now();
 }
 
@@ -74,6 +79,9 @@ void ezFileserveClient::ClearState()
   m_CurFileRequestGuid = ezUuid();
   m_sCurFileRequest.Clear();
   m_Download.Clear();
+  m_PrefetchFiles.Clear();
+  m_bReceivedServerVersion = false;
+  m_uiServerProtocolVersion = 0;
 }
 
 ezResult ezFileserveClient::EnsureConnected(ezTime timeout)
@@ -126,7 +134,10 @@ ezResult ezFileserveClient::EnsureConnected(ezTime timeout)
       ezLog::Success("Connected to ezFileserver '{0}", m_sServerConnectionAddress);
       m_Network->SetMessageHandler('FSRV', ezMakeDelegate(&ezFileserveClient::NetworkMsgHandler, this));
 
-      m_Network->Send('FSRV', 'HELO'); // be friendly
+      // be friendly and tell the server which requests we might send
+      ezRemoteMessage msg('FSRV', 'HELO');
+      msg.GetWriter() << ezFileserveClientContext::s_uiProtocolVersion;
+      m_Network->Send(ezRemoteTransmitMode::Reliable, msg);
     }
 
     m_bFailedToConnect = false;
@@ -156,6 +167,12 @@ void ezFileserveClient::UpdateClient()
   m_Network->ExecuteAllMessageHandlers();
 }
 
+void ezFileserveClient::SetPrefetchTimeout(ezTime timeout)
+{
+  EZ_LOCK(m_Mutex);
+  m_PrefetchTimeout = timeout;
+}
+
 void ezFileserveClient::AddServerAddressToTry(const char* szAddress)
 {
   EZ_LOCK(m_Mutex);
@@ -350,6 +367,31 @@ void ezFileserveClient::NetworkMsgHandler(ezRemoteMessage& msg)
     return;
   }
 
+  if (msg.GetMessageID() == 'PRFD')
+  {
+    HandlePrefetchTransferMsg(msg);
+    return;
+  }
+
+  if (msg.GetMessageID() == 'PRFF')
+  {
+    HandlePrefetchFileFinishedMsg(msg);
+    return;
+  }
+
+  if (msg.GetMessageID() == 'PRFE')
+  {
+    HandlePrefetchFinishedMsg(msg);
+    return;
+  }
+
+  if (msg.GetMessageID() == 'HELO')
+  {
+    msg.GetReader() >> m_uiServerProtocolVersion;
+    m_bReceivedServerVersion = true;
+    return;
+  }
+
   static bool s_bReloadResources = false;
 
   if (msg.GetMessageID() == 'RLDR')
@@ -404,6 +446,9 @@ ezUInt16 ezFileserveClient::MountDataDirectory(const char* szDataDirectory, cons
   dd.m_sMountPoint = sMountPoint;
   dd.m_bMounted = true;
 
+  // the next file access validates everything that is cached for this data directory in one go
+  m_bPrefetchCachedFiles = true;
+
   return uiDataDirID;
 }
 
@@ -502,13 +547,21 @@ void ezFileserveClient::HandleFileTransferFinishedMsg(ezRemoteMessage& msg)
   ezUInt16 uiFoundInDataDir = 0;
   msg.GetReader() >> uiFoundInDataDir;
 
+  UpdateFileCache(m_sCurFileRequest, fileState, iFileTimeStamp, uiFileHash, uiFoundInDataDir);
+}
+
+void ezFileserveClient::UpdateFileCache(
+  const char* szFile, ezFileserveFileState fileState, ezInt64 iFileTimeStamp, ezUInt64 uiFileHash, ezUInt16 uiFoundInDataDir)
+{
+  EZ_LOCK(m_Mutex);
+
   if (uiFoundInDataDir == 0xffff) // file does not exist on server in any data dir
   {
-    m_FileDataDir[m_sCurFileRequest] = 0; // placeholder
+    m_FileDataDir[szFile] = 0; // placeholder
 
     for (ezUInt32 i = 0; i < m_MountedDataDirs.GetCount(); ++i)
     {
-      auto& ref = m_MountedDataDirs[i].m_CacheStatus[m_sCurFileRequest];
+      auto& ref = m_MountedDataDirs[i].m_CacheStatus[szFile];
       ref.m_FileHash = 0;
       ref.m_TimeStamp = 0;
       ref.m_LastCheck = m_CurrentTime;
@@ -518,9 +571,9 @@ void ezFileserveClient::HandleFileTransferFinishedMsg(ezRemoteMessage& msg)
   }
   else
   {
-    m_FileDataDir[m_sCurFileRequest] = uiFoundInDataDir;
+    m_FileDataDir[szFile] = uiFoundInDataDir;
 
-    auto& ref = m_MountedDataDirs[uiFoundInDataDir].m_CacheStatus[m_sCurFileRequest];
+    auto& ref = m_MountedDataDirs[uiFoundInDataDir].m_CacheStatus[szFile];
     ref.m_FileHash = uiFileHash;
     ref.m_TimeStamp = iFileTimeStamp;
     ref.m_LastCheck = m_CurrentTime;
@@ -532,7 +585,7 @@ void ezFileserveClient::HandleFileTransferFinishedMsg(ezRemoteMessage& msg)
 
   const ezString& sMountPoint = m_MountedDataDirs[uiFoundInDataDir].m_sMountPoint;
   ezStringBuilder sCachedFile, sCachedMetaFile;
-  BuildPathInCache(m_sCurFileRequest, sMountPoint, &sCachedFile, &sCachedMetaFile);
+  BuildPathInCache(szFile, sMountPoint, &sCachedFile, &sCachedMetaFile);
 
   if (fileState == ezFileserveFileState::NonExistant)
   {
@@ -555,6 +608,107 @@ void ezFileserveClient::HandleFileTransferFinishedMsg(ezRemoteMessage& msg)
   }
 }
 
+void ezFileserveClient::HandlePrefetchTransferMsg(ezRemoteMessage& msg)
+{
+  EZ_LOCK(m_Mutex);
+  {
+    ezUuid prefetchGuid;
+    msg.GetReader() >> prefetchGuid;
+
+    if (prefetchGuid != m_CurFileRequestGuid)
+      return;
+  }
+
+  ezUInt32 uiChunkSize = 0;
+  msg.GetReader() >> uiChunkSize;
+
+  if (uiChunkSize > 0)
+  {
+    const ezUInt32 uiStartPos = m_Download.GetCount();
+    m_Download.SetCountUninitialized(uiStartPos + uiChunkSize);
+    msg.GetReader().ReadBytes(&m_Download[uiStartPos], uiChunkSize);
+  }
+}
+
+void ezFileserveClient::HandlePrefetchFileFinishedMsg(ezRemoteMessage& msg)
+{
+  EZ_LOCK(m_Mutex);
+  {
+    ezUuid prefetchGuid;
+    msg.GetReader() >> prefetchGuid;
+
+    if (prefetchGuid != m_CurFileRequestGuid)
+      return;
+  }
+
+  // the data of the next file is accumulated from scratch
+  EZ_SCOPE_EXIT(m_Download.Clear());
+
+  ezUInt32 uiFile = 0;
+  msg.GetReader() >> uiFile;
+
+  ezFileserveFileState fileState;
+  {
+    ezInt8 iFileStatus = 0;
+    msg.GetReader() >> iFileStatus;
+    fileState = (ezFileserveFileState)iFileStatus;
+  }
+
+  ezInt64 iFileTimeStamp = 0;
+  msg.GetReader() >> iFileTimeStamp;
+
+  ezUInt64 uiFileHash = 0;
+  msg.GetReader() >> uiFileHash;
+
+  ezUInt16 uiFoundInDataDir = 0;
+  msg.GetReader() >> uiFoundInDataDir;
+
+  ezUInt8 uiCompression = 0;
+  msg.GetReader() >> uiCompression;
+
+  ezUInt32 uiFileSize = 0;
+  msg.GetReader() >> uiFileSize;
+
+  if (uiFile >= m_PrefetchFiles.GetCount())
+    return;
+
+  if (uiCompression != 0)
+  {
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+    m_DecompressedDownload.SetCountUninitialized(uiFileSize);
+
+    ezRawMemoryStreamReader memoryReader(m_Download);
+    ezCompressedStreamReaderZstd zstdReader(&memoryReader);
+
+    if (zstdReader.ReadBytes(m_DecompressedDownload.GetData(), uiFileSize) != uiFileSize)
+    {
+      // leave the cache as it is, the file will be requested again when it is accessed
+      ezLog::Error("Failed to decompress prefetched file '{0}'", m_PrefetchFiles[uiFile]);
+      return;
+    }
+
+    m_Download.Swap(m_DecompressedDownload);
+#else
+    EZ_REPORT_FAILURE("The server sent compressed data, although compression is not supported.");
+    return;
+#endif
+  }
+
+  UpdateFileCache(m_PrefetchFiles[uiFile], fileState, iFileTimeStamp, uiFileHash, uiFoundInDataDir);
+}
+
+void ezFileserveClient::HandlePrefetchFinishedMsg(ezRemoteMessage& msg)
+{
+  EZ_LOCK(m_Mutex);
+
+  ezUuid prefetchGuid;
+  msg.GetReader() >> prefetchGuid;
+
+  if (prefetchGuid != m_CurFileRequestGuid)
+    return;
+
+  m_bDownloading = false;
+}
 
 void ezFileserveClient::WriteMetaFile(ezStringBuilder sCachedMetaFile, ezInt64 iFileTimeStamp, ezUInt64 uiFileHash)
 {
@@ -606,6 +760,16 @@ ezResult ezFileserveClient::DownloadFile(ezUInt16 uiDataDirID, const char* szFil
   if (!m_Network->IsConnectedToServer())
     return EZ_FAILURE;
 
+  if (m_bPrefetchCachedFiles)
+  {
+    m_bPrefetchCachedFiles = false;
+
+    if (m_PrefetchTimeout.IsPositive())
+    {
+      PrefetchCachedFiles();
+    }
+  }
+
   bool bCachedYet = false;
   auto itFileDataDir = m_FileDataDir.FindOrAdd(szFile, &bCachedYet);
   if (!bCachedYet)
@@ -677,6 +841,169 @@ ezResult ezFileserveClient::DownloadFile(ezUInt16 uiDataDirID, const char* szFil
   }
 }
 
+ezResult ezFileserveClient::PrefetchFiles(const ezArrayPtr<const ezString>& files)
+{
+  EZ_LOCK(m_Mutex);
+  if (m_bDownloading)
+  {
+    ezLog::Warning("Trying to prefetch files over fileserve while another file is already downloading. Prefetch is ignored.");
+    return EZ_FAILURE;
+  }
+
+  if (m_Network == nullptr || !m_Network->IsConnectedToServer())
+    return EZ_FAILURE;
+
+  m_PrefetchFiles.Clear();
+  m_PrefetchFiles.Reserve(files.GetCount());
+
+  for (const ezString& sFile : files)
+  {
+    bool bCachedYet = false;
+    auto itFileDataDir = m_FileDataDir.FindOrAdd(sFile, &bCachedYet);
+    if (!bCachedYet)
+    {
+      FillFileStatusCache(sFile);
+    }
+
+    const FileCacheStatus& CacheStatus = m_MountedDataDirs[itFileDataDir.Value()].m_CacheStatus[sFile];
+
+    if (m_CurrentTime - CacheStatus.m_LastCheck < ezTime::Seconds(5.0f))
+      continue;
+
+    m_PrefetchFiles.PushBack(sFile);
+  }
+
+  if (m_PrefetchFiles.IsEmpty())
+    return EZ_SUCCESS;
+
+  if (!m_bReceivedServerVersion)
+  {
+    // the server answers 'HELO' right after connecting, if it doesn't, it is an old version that does not know 'PREF'
+    const ezTime tStart = ezTime::Now();
+    const ezTime handshakeTimeout = ezMath::Min(m_PrefetchTimeout, ezTime::Seconds(2));
+
+    while (!m_bReceivedServerVersion && ezTime::Now() - tStart < handshakeTimeout)
+    {
+      m_Network->UpdateRemoteInterface();
+      m_Network->ExecuteAllMessageHandlers();
+    }
+
+    m_bReceivedServerVersion = true;
+  }
+
+  if (m_uiServerProtocolVersion < 1)
+  {
+    ezLog::Dev("The fileserver does not support prefetching, files are requested individually.");
+    m_PrefetchFiles.Clear();
+    return EZ_FAILURE;
+  }
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  const bool bCompressionSupported = true;
+#else
+  const bool bCompressionSupported = false;
+#endif
+
+  m_Download.Clear();
+  m_CurFileRequestGuid.CreateNewUuid();
+  m_bDownloading = true;
+
+  ezRemoteMessage msg('FSRV', 'PREF');
+  msg.GetWriter() << m_CurFileRequestGuid;
+  msg.GetWriter() << bCompressionSupported;
+  msg.GetWriter() << m_PrefetchFiles.GetCount();
+
+  for (const ezString& sFile : m_PrefetchFiles)
+  {
+    const ezUInt16 uiDataDir = m_FileDataDir[sFile];
+    const FileCacheStatus& CacheStatus = m_MountedDataDirs[uiDataDir].m_CacheStatus[sFile];
+
+    msg.GetWriter() << uiDataDir;
+    msg.GetWriter() << sFile;
+    msg.GetWriter() << CacheStatus.m_TimeStamp;
+    msg.GetWriter() << CacheStatus.m_FileHash;
+  }
+
+  m_Network->Send(ezRemoteTransmitMode::Reliable, msg);
+
+  // the server streams back the results for all files, which are written to the cache as they arrive
+  ezTime tLastAnswer = ezTime::Now();
+
+  while (m_bDownloading)
+  {
+    m_Network->UpdateRemoteInterface();
+
+    if (m_Network->ExecuteAllMessageHandlers() > 0)
+    {
+      tLastAnswer = ezTime::Now();
+    }
+    else if (ezTime::Now() - tLastAnswer > m_PrefetchTimeout || !m_Network->IsConnectedToServer())
+    {
+      ezLog::Warning("Fileserve prefetch got no answer for {0} seconds, the remaining files are requested individually.",
+        ezArgF((ezTime::Now() - tLastAnswer).GetSeconds(), 1));
+
+      // late answers to the prefetch must be ignored, the files they belong to have not been checked and are requested again
+      m_CurFileRequestGuid = ezUuid();
+      m_bDownloading = false;
+      m_bPrefetchCachedFiles = false;
+      m_Download.Clear();
+      m_PrefetchFiles.Clear();
+      return EZ_FAILURE;
+    }
+  }
+
+  m_PrefetchFiles.Clear();
+  return EZ_SUCCESS;
+}
+
+void ezFileserveClient::PrefetchCachedFiles()
+{
+#if EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS)
+  EZ_LOCK(m_Mutex);
+
+  ezSet<ezString> cachedFiles;
+  ezStringBuilder sMetaFolder, sFile;
+
+  // every file that was downloaded in a previous session has a meta file in the cache
+  for (const DataDir& dd : m_MountedDataDirs)
+  {
+    if (!dd.m_bMounted)
+      continue;
+
+    sMetaFolder = m_sFileserveCacheMetaFolder;
+    sMetaFolder.AppendPath(dd.m_sMountPoint);
+
+    ezFileSystemIterator it;
+    if (it.StartSearch(sMetaFolder, ezFileSystemIteratorFlags::ReportFilesRecursive).Failed())
+      continue;
+
+    do
+    {
+      sFile = it.GetCurrentPath();
+      sFile.AppendPath(it.GetStats().m_sName);
+
+      if (sFile.MakeRelativeTo(sMetaFolder).Succeeded())
+      {
+        cachedFiles.Insert(sFile);
+      }
+    } while (it.Next().Succeeded());
+  }
+
+  if (cachedFiles.IsEmpty())
+    return;
+
+  ezDynamicArray<ezString> files;
+  files.Reserve(cachedFiles.GetCount());
+
+  for (auto it = cachedFiles.GetIterator(); it.IsValid(); ++it)
+  {
+    files.PushBack(it.Key());
+  }
+
+  PrefetchFiles(files);
+#endif
+}
+
 void ezFileserveClient::DetermineCacheStatus(ezUInt16 uiDataDirID, const char* szFile, FileCacheStatus& out_Status) const
 {
   EZ_LOCK(m_Mutex);
@@ -12,6 +12,8 @@ namespace ezDataDirectory
   class FileserveType;
 }
 
+enum class ezFileserveFileState;
+
 /// \brief Singleton that represents the client side part of a fileserve connection
 ///
 /// Whether the fileserve plugin will be enabled is controled by ezFileserveClient::s_bEnableFileserve
@@ -22,6 +24,7 @@ namespace ezDataDirectory
 /// and especially before any data directories get mounted.
 ///
 /// The timeout for connecting to the server can be configured through the command line option "-fs_timeout seconds"
+/// The timeout for prefetching cached files can be configured through the command line option "-fs_prefetch_timeout seconds".
 /// The server to connect to can be configured through command line option "-fs_server address".
 /// The default address is "localhost:1042".
 class EZ_FILESERVEPLUGIN_DLL ezFileserveClient
@@ -79,6 +82,27 @@ public:
   /// \brief Adds an address that should be tried for connecting with the server.
   void AddServerAddressToTry(const char* szAddress);
 
+  /// \brief Checks all given files with the server in one request, instead of doing one round trip per file.
+  ///
+  /// The server streams back only the files that changed (zstd compressed, if supported) and the cache is updated accordingly.
+  /// Afterwards requests for these files can be answered from the cache directly. Files that were checked recently are skipped.
+  /// This is done automatically for all files in the local cache, when a file is accessed for the first time after a data directory
+  /// was mounted. That only helps when the cache is warm, on the first run with an empty cache every file is still requested individually.
+  ///
+  /// Fails if the server does not support prefetching, or if it stops answering for longer than the prefetch timeout.
+  /// Files that were not prefetched are requested individually when they are accessed.
+  ezResult PrefetchFiles(const ezArrayPtr<const ezString>& files);
+
+  /// \brief Sets how long a prefetch may go without any answer from the server, before the client falls back to per-file requests.
+  ///
+  /// A zero timeout disables the automatic prefetch of cached files. The default is 10 seconds.
+  void SetPrefetchTimeout(ezTime timeout);
+
+  /// \brief Allows to enable the file serving functionality again, after it was disabled.
+  ///
+  /// Creating an ezFileserver disables the client, this is only needed when a client and a server run in the same process, e.g. in tests.
+  static void EnableFileserveClient() { s_bEnableFileserve = true; }
+
 private:
   friend class ezDataDirectory::FileserveType;
 
@@ -112,6 +136,11 @@ private:
   void NetworkMsgHandler(ezRemoteMessage& msg);
   void HandleFileTransferMsg(ezRemoteMessage& msg);
   void HandleFileTransferFinishedMsg(ezRemoteMessage& msg);
+  void HandlePrefetchTransferMsg(ezRemoteMessage& msg);
+  void HandlePrefetchFileFinishedMsg(ezRemoteMessage& msg);
+  void HandlePrefetchFinishedMsg(ezRemoteMessage& msg);
+  void UpdateFileCache(const char* szFile, ezFileserveFileState fileState, ezInt64 iFileTimeStamp, ezUInt64 uiFileHash, ezUInt16 uiFoundInDataDir);
+  void PrefetchCachedFiles();
   static void WriteMetaFile(ezStringBuilder sCachedMetaFile, ezInt64 iFileTimeStamp, ezUInt64 uiFileHash);
   void WriteDownloadToDisk(ezStringBuilder sCachedFile);
   ezResult DownloadFile(ezUInt16 uiDataDirID, const char* szFile, bool bForceThisDataDir, ezStringBuilder* out_pFullPath);
@@ -131,10 +160,16 @@ private:
   bool m_bDownloading = false;
   bool m_bFailedToConnect = false;
   bool m_bWaitingForUploadFinished = false;
+  bool m_bPrefetchCachedFiles = false;
+  bool m_bReceivedServerVersion = false;
+  ezUInt8 m_uiServerProtocolVersion = 0;
+  ezTime m_PrefetchTimeout = ezTime::Seconds(10);
   ezUuid m_CurFileRequestGuid;
   ezStringBuilder m_sCurFileRequest;
   ezUniquePtr<ezRemoteInterface> m_Network;
   ezDynamicArray<ezUInt8> m_Download;
+  ezDynamicArray<ezUInt8> m_DecompressedDownload;
+  ezDynamicArray<ezString> m_PrefetchFiles;
   ezTime m_CurrentTime;
   ezHybridArray<ezString, 4> m_TryServerAddresses;
 
@@ -17,6 +17,10 @@ enum class ezFileserveFileState
 class EZ_FILESERVEPLUGIN_DLL ezFileserveClientContext
 {
 public:
+  /// \brief The version of the fileserve protocol, which client and server exchange through 'HELO' when they connect.
+  ///
+  /// Version 1 added the batched prefetch request ('PREF'). Clients and servers without a version only know the per-file requests.
+  static constexpr ezUInt8 s_uiProtocolVersion = 1;
 
   struct DataDir
   {
@@ -38,6 +42,7 @@ public:
 
   bool m_bLostConnection = false;
   ezUInt32 m_uiApplicationID = 0;
+  ezUInt8 m_uiProtocolVersion = 0;
   ezHybridArray<DataDir, 8> m_MountedDataDirs;
 };
 
@@ -4,7 +4,9 @@
 #include <FileservePlugin/Fileserver/Fileserver.h>
 #include <Foundation/Algorithm/HashingUtils.h>
 #include <Foundation/Communication/RemoteInterfaceEnet.h>
+#include <Foundation/IO/CompressedStreamZstd.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Utilities/CommandLineUtils.h>
 
 EZ_IMPLEMENT_SINGLETON(ezFileserver);
@@ -83,7 +85,22 @@ void ezFileserver::NetworkMsgHandler(ezRemoteMessage& msg)
   auto& client = DetermineClient(msg);
 
   if (msg.GetMessageID() == 'HELO')
+  {
+    // a new client session, which may reuse the application ID of a previous one, numbers its data directories from zero again
+    client.m_MountedDataDirs.Clear();
+
+    // old clients send no version and don't expect an answer
+    if (msg.GetMessageSize() >= sizeof(ezUInt8))
+    {
+      msg.GetReader() >> client.m_uiProtocolVersion;
+
+      ezRemoteMessage ret('FSRV', 'HELO');
+      ret.GetWriter() << ezFileserveClientContext::s_uiProtocolVersion;
+      m_Network->Send(ezRemoteTransmitMode::Reliable, ret);
+    }
+
     return;
+  }
 
   if (msg.GetMessageID() == 'RUTR')
   {
@@ -102,6 +119,12 @@ void ezFileserver::NetworkMsgHandler(ezRemoteMessage& msg)
     return;
   }
 
+  if (msg.GetMessageID() == 'PREF')
+  {
+    HandlePrefetchRequest(client, msg);
+    return;
+  }
+
   if (msg.GetMessageID() == 'UPLH')
   {
     HandleUploadFileHeader(client, msg);
@@ -334,6 +357,138 @@ void ezFileserver::HandleFileRequest(ezFileserveClientContext& client, ezRemoteM
   }
 }
 
+void ezFileserver::HandlePrefetchRequest(ezFileserveClientContext& client, ezRemoteMessage& msg)
+{
+  ezUuid prefetchGuid;
+  msg.GetReader() >> prefetchGuid;
+
+  bool bCompressionSupported = false;
+  msg.GetReader() >> bCompressionSupported;
+
+  ezUInt32 uiNumFiles = 0;
+  msg.GetReader() >> uiNumFiles;
+
+  ezFileserverEvent e;
+  e.m_uiClientID = client.m_uiApplicationID;
+
+  {
+    e.m_Type = ezFileserverEvent::Type::PrefetchRequest;
+    e.m_uiSizeTotal = uiNumFiles;
+    m_Events.Broadcast(e);
+  }
+
+  ezUInt32 uiBytesSent = 0;
+  ezStringBuilder sRequestedFile;
+
+  // all answers are sent without waiting for the client, the client only waits for the final 'PRFE' message
+  for (ezUInt32 uiFile = 0; uiFile < uiNumFiles; ++uiFile)
+  {
+    ezUInt16 uiDataDirID = 0;
+    msg.GetReader() >> uiDataDirID;
+    msg.GetReader() >> sRequestedFile;
+
+    ezFileserveClientContext::FileStatus status;
+    msg.GetReader() >> status.m_iTimestamp;
+    msg.GetReader() >> status.m_uiHash;
+
+    const ezFileserveFileState filestate = client.GetFileStatus(uiDataDirID, sRequestedFile, status, m_SendToClient, false);
+
+    e.m_szPath = sRequestedFile;
+    e.m_uiSentTotal = 0;
+
+    {
+      e.m_Type = ezFileserverEvent::Type::FileDownloadRequest;
+      e.m_uiSizeTotal = m_SendToClient.GetCount();
+      e.m_FileState = filestate;
+      m_Events.Broadcast(e);
+    }
+
+    ezUInt8 uiCompression = 0; // 0 = uncompressed, 1 = zstd
+    ezUInt32 uiFileSize = 0;
+
+    if (filestate == ezFileserveFileState::Different)
+    {
+      uiFileSize = m_SendToClient.GetCount();
+      const ezDynamicArray<ezUInt8>* pSendData = &m_SendToClient;
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+      if (bCompressionSupported && uiFileSize > 0)
+      {
+        m_SendToClientCompressed.Clear();
+
+        ezMemoryStreamContainerWrapperStorage<ezDynamicArray<ezUInt8>> storage(&m_SendToClientCompressed);
+        ezMemoryStreamWriter memoryWriter(&storage);
+        ezCompressedStreamWriterZstd zstdWriter(&memoryWriter, ezCompressedStreamWriterZstd::Compression::Fastest);
+        zstdWriter.WriteBytes(m_SendToClient.GetData(), uiFileSize);
+        zstdWriter.FinishCompressedStream();
+
+        // many asset types are already compressed, don't make the client decompress them for nothing
+        if (m_SendToClientCompressed.GetCount() < uiFileSize)
+        {
+          pSendData = &m_SendToClientCompressed;
+          uiCompression = 1;
+        }
+      }
+#endif
+
+      const ezDynamicArray<ezUInt8>& sendData = *pSendData;
+      ezUInt32 uiNextByte = 0;
+
+      while (uiNextByte < sendData.GetCount())
+      {
+        const ezUInt32 uiChunkSize = ezMath::Min<ezUInt32>(1024 * 16, sendData.GetCount() - uiNextByte);
+
+        ezRemoteMessage ret;
+        ret.GetWriter() << prefetchGuid;
+        ret.GetWriter() << uiChunkSize;
+        ret.GetWriter().WriteBytes(&sendData[uiNextByte], uiChunkSize);
+
+        ret.SetMessageID('FSRV', 'PRFD');
+        m_Network->Send(ezRemoteTransmitMode::Reliable, ret);
+
+        uiNextByte += uiChunkSize;
+      }
+
+      uiBytesSent += sendData.GetCount();
+    }
+
+    {
+      ezRemoteMessage ret('FSRV', 'PRFF');
+      ret.GetWriter() << prefetchGuid;
+      ret.GetWriter() << uiFile;
+      ret.GetWriter() << (ezInt8)filestate;
+      ret.GetWriter() << status.m_iTimestamp;
+      ret.GetWriter() << status.m_uiHash;
+      ret.GetWriter() << uiDataDirID;
+      ret.GetWriter() << uiCompression;
+      ret.GetWriter() << uiFileSize;
+
+      m_Network->Send(ezRemoteTransmitMode::Reliable, ret);
+    }
+
+    {
+      e.m_Type = ezFileserverEvent::Type::FileDownloadFinished;
+      m_Events.Broadcast(e);
+    }
+  }
+
+  {
+    ezRemoteMessage ret('FSRV', 'PRFE');
+    ret.GetWriter() << prefetchGuid;
+
+    m_Network->Send(ezRemoteTransmitMode::Reliable, ret);
+  }
+
+  {
+    e.m_Type = ezFileserverEvent::Type::PrefetchFinished;
+    e.m_szPath = nullptr;
+    e.m_FileState = ezFileserveFileState::None;
+    e.m_uiSizeTotal = uiNumFiles;
+    e.m_uiSentTotal = uiBytesSent;
+    m_Events.Broadcast(e);
+  }
+}
+
 void ezFileserver::HandleDeleteFileRequest(ezFileserveClientContext& client, ezRemoteMessage& msg)
 {
   ezUInt16 uiDataDirID = 0xffff;
@@ -20,6 +20,9 @@ void RemoveCVarEventHandler();
 void AddMemoryEventHandler();
 void RemoveMemoryEventHandler();
 
+void AddMutexEventHandler();
+void RemoveMutexEventHandler();
+
 void AddInputEventHandler();
 void RemoveInputEventHandler();
 
@@ -65,6 +68,7 @@ EZ_BEGIN_SUBSYSTEM_DECLARATION(InspectorPlugin, InspectorPluginMain)
     AddCVarEventHandler();
     AddReflectionEventHandler();
     AddMemoryEventHandler();
+    AddMutexEventHandler();
     AddInputEventHandler();
     AddPluginEventHandler();
     AddGlobalEventHandler();
@@ -85,6 +89,7 @@ EZ_BEGIN_SUBSYSTEM_DECLARATION(InspectorPlugin, InspectorPluginMain)
     RemoveGlobalEventHandler();
     RemovePluginEventHandler();
     RemoveInputEventHandler();
+    RemoveMutexEventHandler();
     RemoveMemoryEventHandler();
     RemoveReflectionEventHandler();
     RemoveCVarEventHandler();
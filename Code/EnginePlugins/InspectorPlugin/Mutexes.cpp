@@ -0,0 +1,106 @@
+#include <InspectorPluginPCH.h>
+
+#include <Foundation/Communication/Telemetry.h>
+#include <Foundation/Threading/MutexProfiling.h>
+#include <Foundation/Utilities/Stats.h>
+
+#include <GameEngine/GameApplication/GameApplicationBase.h>
+
+#if EZ_ENABLED(EZ_USE_MUTEX_PROFILING)
+
+#  include <Foundation/System/StackTracer.h>
+
+namespace MutexesDetail
+{
+  static ezHashTable<const char*, double> s_ReportedMaxWaitTime;
+
+  static void BroadcastMutexStats()
+  {
+    ezStringBuilder sStatName;
+    ezStringBuilder sStackTrace;
+
+    // the stats of all named mutexes end up in the stats table of the Inspector
+    for (const ezMutexProfilingStats& stats : ezMutexProfiling::GetAllStats())
+    {
+      sStatName.Format("Mutexes/{0}/Acquisitions", stats.m_szName);
+      ezStats::SetStat(sStatName, stats.m_uiAcquisitions);
+
+      sStatName.Format("Mutexes/{0}/Contentions", stats.m_szName);
+      ezStats::SetStat(sStatName, stats.m_uiContentions);
+
+      sStatName.Format("Mutexes/{0}/Wait Time", stats.m_szName);
+      ezStats::SetStat(sStatName, ezTime::Seconds(stats.m_fTotalWaitTime));
+
+      sStatName.Format("Mutexes/{0}/Max Wait Time", stats.m_szName);
+      ezStats::SetStat(sStatName, ezTime::Seconds(stats.m_fMaxWaitTime));
+
+      sStatName.Format("Mutexes/{0}/Hold Time", stats.m_szName);
+      ezStats::SetStat(sStatName, ezTime::Seconds(stats.m_fTotalHoldTime));
+
+      sStatName.Format("Mutexes/{0}/Max Hold Time", stats.m_szName);
+      ezStats::SetStat(sStatName, ezTime::Seconds(stats.m_fMaxHoldTime));
+
+      // resolving a stack trace is expensive, so only do it when the slowest wait has changed
+      double& fReportedMaxWaitTime = s_ReportedMaxWaitTime[stats.m_szName];
+      if (fReportedMaxWaitTime != stats.m_fMaxWaitTime && stats.m_uiSlowestWaitStackTraceLength > 0)
+      {
+        fReportedMaxWaitTime = stats.m_fMaxWaitTime;
+
+        void* stackTraceBuffer[ezMutexProfilingStats::MAX_STACK_TRACE_LENGTH];
+        const ezUInt32 uiLength = ezMutexProfiling::GetSlowestWaitStackTrace(stats, ezArrayPtr<void*>(stackTraceBuffer));
+
+        sStackTrace.Clear();
+        ezArrayPtr<void*> stackTrace(stackTraceBuffer, uiLength);
+        ezStackTracer::ResolveStackTrace(stackTrace, [&](const char* szText) { sStackTrace.Append(szText); });
+
+        sStatName.Format("Mutexes/{0}/Slowest Wait Stack", stats.m_szName);
+        ezStats::SetStat(sStatName, sStackTrace.GetData());
+      }
+    }
+  }
+
+  static void PerframeUpdateHandler(const ezGameApplicationExecutionEvent& e)
+  {
+    if (!ezTelemetry::IsConnectedToClient())
+      return;
+
+    switch (e.m_Type)
+    {
+      case ezGameApplicationExecutionEvent::Type::AfterPresent:
+        BroadcastMutexStats();
+        break;
+
+      default:
+        break;
+    }
+  }
+} // namespace MutexesDetail
+
+#endif
+
+void AddMutexEventHandler()
+{
+#if EZ_ENABLED(EZ_USE_MUTEX_PROFILING)
+  if (ezGameApplicationBase::GetGameApplicationBaseInstance() != nullptr)
+  {
+    ezGameApplicationBase::GetGameApplicationBaseInstance()->m_ExecutionEvents.AddEventHandler(MutexesDetail::PerframeUpdateHandler);
+  }
+#endif
+}
+
+void RemoveMutexEventHandler()
+{
+#if EZ_ENABLED(EZ_USE_MUTEX_PROFILING)
+  if (ezGameApplicationBase::GetGameApplicationBaseInstance() != nullptr)
+  {
+    ezGameApplicationBase::GetGameApplicationBaseInstance()->m_ExecutionEvents.RemoveEventHandler(MutexesDetail::PerframeUpdateHandler);
+  }
+
+  MutexesDetail::s_ReportedMaxWaitTime.Clear();
+  MutexesDetail::s_ReportedMaxWaitTime.Compact();
+#endif
+}
+
+
+
+EZ_STATICLINK_FILE(InspectorPlugin, InspectorPlugin_Mutexes);
@@ -46,12 +46,12 @@ void ezKrautRenderer::RenderBatch(
   ezResourceLock<ezMeshResource> pMesh(pRenderData->m_hMesh, ezResourceAcquireMode::AllowLoadingFallback);
 
   // This can happen when the resource has been reloaded and now has fewer sub-meshes.
-  if (pMesh->GetSubMeshes().GetCount() <= pRenderData->m_uiSubMeshIndex)
+  if (pMesh->GetAllSubMeshes().GetCount() <= pRenderData->m_uiSubMeshIndex)
     return;
 
   TempTreeCB treeConstants(pRenderContext);
 
-  const auto& subMesh = pMesh->GetSubMeshes()[pRenderData->m_uiSubMeshIndex];
+  const auto& subMesh = pMesh->GetAllSubMeshes()[pRenderData->m_uiSubMeshIndex];
 
   ezInstanceData* pInstanceData = pPass->GetPipeline()->GetFrameDataProvider<ezInstanceDataProvider>()->GetData(renderViewContext);
   pInstanceData->BindResources(pRenderContext);
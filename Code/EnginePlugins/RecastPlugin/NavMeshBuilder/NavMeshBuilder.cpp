@@ -2,6 +2,8 @@
 
 #include <Core/Utils/WorldGeoExtractionUtil.h>
 #include <Core/World/World.h>
+#include <Foundation/Algorithm/HashStream.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Stopwatch.h>
 #include <Foundation/Types/ScopeExit.h>
 #include <Foundation/Utilities/Progress.h>
@@ -28,6 +30,7 @@ EZ_BEGIN_STATIC_REFLECTED_TYPE(ezRecastConfig, ezNoBase, 1, ezRTTIDefaultAllocat
     EZ_MEMBER_PROPERTY("SampleErrorFactor", m_fDetailMeshSampleErrorFactor)->AddAttributes(new ezDefaultValueAttribute(1.0f)),
     EZ_MEMBER_PROPERTY("MaxSimplification", m_fMaxSimplificationError)->AddAttributes(new ezDefaultValueAttribute(1.3f)),
     EZ_MEMBER_PROPERTY("MaxEdgeLength", m_fMaxEdgeLength)->AddAttributes(new ezDefaultValueAttribute(4.0f)),
+    EZ_MEMBER_PROPERTY("TileSize", m_fTileSize)->AddAttributes(new ezDefaultValueAttribute(0.0f), new ezClampValueAttribute(0.0f, ezVariant())),
   }
   EZ_END_PROPERTIES;
 }
@@ -81,7 +84,7 @@ ezResult ezRecastNavMeshBuilder::ExtractWorldGeometry(const ezWorld& world, ezWo
 }
 
 ezResult ezRecastNavMeshBuilder::Build(const ezRecastConfig& config, const ezWorldGeoExtractionUtil::Geometry& geo,
-  ezRecastNavMeshResourceDescriptor& out_NavMeshDesc, ezProgress& progress)
+  ezRecastNavMeshResourceDescriptor& out_NavMeshDesc, ezProgress& progress, const ezRecastNavMeshResourceDescriptor* pPreviousNavMesh)
 {
   EZ_LOG_BLOCK("ezRecastNavMeshBuilder::Build");
 
@@ -93,6 +96,7 @@ ezResult ezRecastNavMeshBuilder::Build(const ezRecastConfig& config, const ezWor
 
   Clear();
   out_NavMeshDesc.Clear();
+  m_uiNumBuiltTiles = 0;
 
   ezUniquePtr<ezRcBuildContext> recastContext = EZ_DEFAULT_NEW(ezRcBuildContext);
   m_pRecastContext = recastContext.Borrow();
@@ -116,9 +120,17 @@ ezResult ezRecastNavMeshBuilder::Build(const ezRecastConfig& config, const ezWor
   if (!pg.BeginNextStep("Build Poly Mesh"))
     return EZ_FAILURE;
 
+  if (config.m_fTileSize > 0.0f)
+  {
+    return BuildTiledNavMesh(config, out_NavMeshDesc, progress, pPreviousNavMesh);
+  }
+
+  rcConfig cfg;
+  FillOutConfig(cfg, config, m_BoundingBox);
+
   out_NavMeshDesc.m_pNavMeshPolygons = EZ_DEFAULT_NEW(rcPolyMesh);
 
-  if (BuildRecastPolyMesh(config, *out_NavMeshDesc.m_pNavMeshPolygons, progress).Failed())
+  if (BuildRecastPolyMesh(m_pRecastContext, cfg, m_Vertices, m_Triangles, m_TriangleAreaIDs, *out_NavMeshDesc.m_pNavMeshPolygons, progress).Failed())
     return EZ_FAILURE;
 
   if (!pg.BeginNextStep("Build NavMesh"))
@@ -127,6 +139,268 @@ ezResult ezRecastNavMeshBuilder::Build(const ezRecastConfig& config, const ezWor
   if (BuildDetourNavMeshData(config, *out_NavMeshDesc.m_pNavMeshPolygons, out_NavMeshDesc.m_DetourNavmeshData).Failed())
     return EZ_FAILURE;
 
+  m_uiNumBuiltTiles = 1;
+  return EZ_SUCCESS;
+}
+
+ezResult ezRecastNavMeshBuilder::BuildTiledNavMesh(const ezRecastConfig& config, ezRecastNavMeshResourceDescriptor& out_NavMeshDesc,
+  ezProgress& progress, const ezRecastNavMeshResourceDescriptor* pPreviousNavMesh)
+{
+  ezProgressRange pgRange("Build Tiles", 3, true, &progress);
+  pgRange.SetStepWeighting(0, 0.05f);
+  pgRange.SetStepWeighting(1, 0.9f);
+  pgRange.SetStepWeighting(2, 0.05f);
+
+  if (!pgRange.BeginNextStep("Assign Triangles To Tiles"))
+    return EZ_FAILURE;
+
+  rcConfig baseCfg;
+  FillOutConfig(baseCfg, config, m_BoundingBox);
+
+  baseCfg.tileSize = ezMath::Max((int)(config.m_fTileSize / baseCfg.cs), 8);
+  baseCfg.borderSize = baseCfg.walkableRadius + 3;
+  baseCfg.width = baseCfg.tileSize + baseCfg.borderSize * 2;
+  baseCfg.height = baseCfg.tileSize + baseCfg.borderSize * 2;
+
+  const float fTileWorldSize = baseCfg.tileSize * baseCfg.cs;
+  const float fBorderWorldSize = baseCfg.borderSize * baseCfg.cs;
+
+  // the tile grid is anchored at multiples of the tile size, so that tile coordinates stay the same when the world bounds change
+  const ezVec3 vOrigin(ezMath::Floor(m_BoundingBox.m_vMin.x / fTileWorldSize) * fTileWorldSize, m_BoundingBox.m_vMin.y,
+    ezMath::Floor(m_BoundingBox.m_vMin.z / fTileWorldSize) * fTileWorldSize);
+
+  const ezInt32 iTilesX = ezMath::Max(1, (ezInt32)ezMath::Ceil((m_BoundingBox.m_vMax.x - vOrigin.x) / fTileWorldSize));
+  const ezInt32 iTilesZ = ezMath::Max(1, (ezInt32)ezMath::Ceil((m_BoundingBox.m_vMax.z - vOrigin.z) / fTileWorldSize));
+  const ezInt32 iTileOffsetX = (ezInt32)ezMath::Floor(vOrigin.x / fTileWorldSize);
+  const ezInt32 iTileOffsetZ = (ezInt32)ezMath::Floor(vOrigin.z / fTileWorldSize);
+
+  // Detour tile references are limited to 22 bits for the tile and polygon index together
+  const ezUInt32 uiTileBits = ezMath::Min<ezUInt32>(ezMath::Log2i(ezMath::PowerOfTwo_Ceil((ezUInt32)(iTilesX * iTilesZ))), 14);
+  const ezUInt32 uiPolyBits = 22 - uiTileBits;
+
+  if ((ezUInt32)(iTilesX * iTilesZ) > (1u << uiTileBits))
+  {
+    ezLog::Error("The navmesh would need {0} tiles, which is more than the supported {1}. Increase the tile size.", iTilesX * iTilesZ, 1u << uiTileBits);
+    return EZ_FAILURE;
+  }
+
+  struct TileInput
+  {
+    ezInt32 m_iTileX;
+    ezInt32 m_iTileY;
+    ezUInt64 m_uiInputHash = 0;
+    ezDynamicArray<ezUInt32> m_Triangles;
+    const ezRecastNavMeshTile* m_pPreviousTile = nullptr;
+    ezRecastNavMeshTile m_Result;
+    bool m_bFailed = false;
+  };
+
+  ezDynamicArray<TileInput> tiles;
+  tiles.SetCount(iTilesX * iTilesZ);
+
+  for (ezInt32 z = 0; z < iTilesZ; ++z)
+  {
+    for (ezInt32 x = 0; x < iTilesX; ++x)
+    {
+      tiles[z * iTilesX + x].m_iTileX = iTileOffsetX + x;
+      tiles[z * iTilesX + x].m_iTileY = iTileOffsetZ + z;
+    }
+  }
+
+  // sort all triangles into every tile that they overlap (including the tile border)
+  for (ezUInt32 t = 0; t < m_Triangles.GetCount(); ++t)
+  {
+    const Triangle& tri = m_Triangles[t];
+    const ezVec3& v0 = m_Vertices[tri.m_VertexIdx[0]];
+    const ezVec3& v1 = m_Vertices[tri.m_VertexIdx[1]];
+    const ezVec3& v2 = m_Vertices[tri.m_VertexIdx[2]];
+
+    const float fMinX = ezMath::Min(v0.x, v1.x, v2.x) - fBorderWorldSize - vOrigin.x;
+    const float fMaxX = ezMath::Max(v0.x, v1.x, v2.x) + fBorderWorldSize - vOrigin.x;
+    const float fMinZ = ezMath::Min(v0.z, v1.z, v2.z) - fBorderWorldSize - vOrigin.z;
+    const float fMaxZ = ezMath::Max(v0.z, v1.z, v2.z) + fBorderWorldSize - vOrigin.z;
+
+    const ezInt32 iMinX = ezMath::Clamp((ezInt32)ezMath::Floor(fMinX / fTileWorldSize), 0, iTilesX - 1);
+    const ezInt32 iMaxX = ezMath::Clamp((ezInt32)ezMath::Floor(fMaxX / fTileWorldSize), 0, iTilesX - 1);
+    const ezInt32 iMinZ = ezMath::Clamp((ezInt32)ezMath::Floor(fMinZ / fTileWorldSize), 0, iTilesZ - 1);
+    const ezInt32 iMaxZ = ezMath::Clamp((ezInt32)ezMath::Floor(fMaxZ / fTileWorldSize), 0, iTilesZ - 1);
+
+    for (ezInt32 z = iMinZ; z <= iMaxZ; ++z)
+    {
+      for (ezInt32 x = iMinX; x <= iMaxX; ++x)
+      {
+        tiles[z * iTilesX + x].m_Triangles.PushBack(t);
+      }
+    }
+  }
+
+  // hash the input of every tile, to find out which tiles can be taken from the previous build
+  ezUInt64 uiConfigHash = 0;
+  {
+    ezHashStreamWriter64 configHash;
+    config.Serialize(configHash).IgnoreResult();
+    uiConfigHash = configHash.GetHashValue();
+  }
+
+  const bool bPreviousIsCompatible = pPreviousNavMesh != nullptr && !pPreviousNavMesh->m_Tiles.IsEmpty() &&
+                                     pPreviousNavMesh->m_fTileWorldSize == fTileWorldSize &&
+                                     pPreviousNavMesh->m_uiMaxPolysPerTile == (1u << uiPolyBits);
+
+  ezDynamicArray<TileInput*> tilesToBuild;
+
+  for (TileInput& tile : tiles)
+  {
+    if (tile.m_Triangles.IsEmpty())
+      continue;
+
+    ezHashStreamWriter64 inputHash(uiConfigHash);
+    inputHash << tile.m_iTileX;
+    inputHash << tile.m_iTileY;
+
+    for (ezUInt32 t : tile.m_Triangles)
+    {
+      const Triangle& tri = m_Triangles[t];
+      inputHash << m_Vertices[tri.m_VertexIdx[0]];
+      inputHash << m_Vertices[tri.m_VertexIdx[1]];
+      inputHash << m_Vertices[tri.m_VertexIdx[2]];
+    }
+
+    tile.m_uiInputHash = inputHash.GetHashValue();
+
+    if (bPreviousIsCompatible)
+    {
+      for (const ezRecastNavMeshTile& prevTile : pPreviousNavMesh->m_Tiles)
+      {
+        if (prevTile.m_iTileX == tile.m_iTileX && prevTile.m_iTileY == tile.m_iTileY && prevTile.m_uiInputHash == tile.m_uiInputHash)
+        {
+          tile.m_pPreviousTile = &prevTile;
+          break;
+        }
+      }
+    }
+
+    if (tile.m_pPreviousTile == nullptr)
+    {
+      tilesToBuild.PushBack(&tile);
+    }
+  }
+
+  m_uiNumBuiltTiles = tilesToBuild.GetCount();
+
+  if (!pgRange.BeginNextStep("Build Tiles"))
+    return EZ_FAILURE;
+
+  ezLog::Debug("Building {0} of {1} navmesh tiles", tilesToBuild.GetCount(), tiles.GetCount());
+
+  ezTaskSystem::ParallelForIndexed(
+    0, tilesToBuild.GetCount(),
+    [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      // every task needs its own Recast context and progress, neither of them is thread-safe
+      ezRcBuildContext context;
+      ezProgress tileProgress;
+
+      ezDynamicArray<Triangle> tileTriangles;
+      ezDynamicArray<ezUInt8> tileAreaIDs;
+
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        if (progress.WasCanceled())
+          return;
+
+        TileInput& tile = *tilesToBuild[i];
+
+        tileTriangles.Clear();
+        tileTriangles.Reserve(tile.m_Triangles.GetCount());
+
+        ezBoundingBox tileBounds;
+        tileBounds.SetInvalid();
+
+        for (ezUInt32 t : tile.m_Triangles)
+        {
+          const Triangle& tri = m_Triangles[t];
+          tileTriangles.PushBack(tri);
+
+          tileBounds.ExpandToInclude(m_Vertices[tri.m_VertexIdx[0]]);
+          tileBounds.ExpandToInclude(m_Vertices[tri.m_VertexIdx[1]]);
+          tileBounds.ExpandToInclude(m_Vertices[tri.m_VertexIdx[2]]);
+        }
+
+        tileAreaIDs.Clear();
+        tileAreaIDs.SetCount(tileTriangles.GetCount());
+
+        rcConfig cfg = baseCfg;
+        cfg.bmin[0] = vOrigin.x + (tile.m_iTileX - iTileOffsetX) * fTileWorldSize - fBorderWorldSize;
+        cfg.bmin[1] = tileBounds.m_vMin.y;
+        cfg.bmin[2] = vOrigin.z + (tile.m_iTileY - iTileOffsetZ) * fTileWorldSize - fBorderWorldSize;
+        cfg.bmax[0] = cfg.bmin[0] + fTileWorldSize + 2.0f * fBorderWorldSize;
+        cfg.bmax[1] = tileBounds.m_vMax.y;
+        cfg.bmax[2] = cfg.bmin[2] + fTileWorldSize + 2.0f * fBorderWorldSize;
+
+        tile.m_Result.m_iTileX = tile.m_iTileX;
+        tile.m_Result.m_iTileY = tile.m_iTileY;
+        tile.m_Result.m_uiInputHash = tile.m_uiInputHash;
+        tile.m_Result.m_pTilePolygons = EZ_DEFAULT_NEW(rcPolyMesh);
+
+        if (BuildRecastPolyMesh(&context, cfg, m_Vertices, tileTriangles, tileAreaIDs, *tile.m_Result.m_pTilePolygons, tileProgress).Failed())
+        {
+          tile.m_bFailed = true;
+          continue;
+        }
+
+        // tiles without any walkable area are kept without data, so that the next incremental build can skip them as well
+        if (tile.m_Result.m_pTilePolygons->npolys == 0)
+        {
+          EZ_DEFAULT_DELETE(tile.m_Result.m_pTilePolygons);
+          continue;
+        }
+
+        if (BuildDetourNavMeshData(config, *tile.m_Result.m_pTilePolygons, tile.m_Result.m_DetourTileData, tile.m_iTileX, tile.m_iTileY).Failed())
+        {
+          tile.m_bFailed = true;
+        }
+      }
+    },
+    "ezRecastNavMeshBuilder::BuildTiles");
+
+  if (!pgRange.BeginNextStep("Assemble Tiles"))
+    return EZ_FAILURE;
+
+  out_NavMeshDesc.m_vTileOrigin = vOrigin;
+  out_NavMeshDesc.m_fTileWorldSize = fTileWorldSize;
+  out_NavMeshDesc.m_uiMaxTiles = 1u << uiTileBits;
+  out_NavMeshDesc.m_uiMaxPolysPerTile = 1u << uiPolyBits;
+
+  for (TileInput& tile : tiles)
+  {
+    if (tile.m_bFailed)
+    {
+      ezLog::Error("Failed to build navmesh tile ({0}, {1})", tile.m_iTileX, tile.m_iTileY);
+      return EZ_FAILURE;
+    }
+
+    if (tile.m_pPreviousTile != nullptr)
+    {
+      const ezRecastNavMeshTile& prevTile = *tile.m_pPreviousTile;
+      ezRecastNavMeshTile& newTile = out_NavMeshDesc.m_Tiles.ExpandAndGetRef();
+      newTile.m_iTileX = prevTile.m_iTileX;
+      newTile.m_iTileY = prevTile.m_iTileY;
+      newTile.m_uiInputHash = prevTile.m_uiInputHash;
+      newTile.m_DetourTileData = prevTile.m_DetourTileData;
+
+      if (prevTile.m_pTilePolygons != nullptr)
+      {
+        // the previous navmesh stays untouched, so the polygons need to be copied
+        newTile.m_pTilePolygons = ezRecastNavMeshTile::ClonePolyMesh(*prevTile.m_pTilePolygons);
+      }
+    }
+    else if (!tile.m_Triangles.IsEmpty())
+    {
+      out_NavMeshDesc.m_Tiles.PushBack(std::move(tile.m_Result));
+    }
+  }
+
+  out_NavMeshDesc.MergeTilePolygons();
+
   return EZ_SUCCESS;
 }
 
@@ -261,16 +535,13 @@ void ezRecastNavMeshBuilder::FillOutConfig(rcConfig& cfg, const ezRecastConfig&
   rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
 }
 
-ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& config, rcPolyMesh& out_PolyMesh, ezProgress& progress)
+ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(ezRcBuildContext* pContext, const rcConfig& cfg, ezArrayPtr<const ezVec3> vertices,
+  ezArrayPtr<const Triangle> triangles, ezArrayPtr<ezUInt8> triangleAreaIDs, rcPolyMesh& out_PolyMesh, ezProgress& progress)
 {
   ezProgressRange pgRange("Build Poly Mesh", 13, true, &progress);
 
-  rcConfig cfg;
-  FillOutConfig(cfg, config, m_BoundingBox);
-
-  ezRcBuildContext* pContext = m_pRecastContext;
-  const float* pVertices = &m_Vertices[0].x;
-  const ezInt32* pTriangles = &m_Triangles[0].m_VertexIdx[0];
+  const float* pVertices = &vertices[0].x;
+  const ezInt32* pTriangles = &triangles[0].m_VertexIdx[0];
 
   rcHeightfield* heightfield = rcAllocHeightfield();
   EZ_SCOPE_EXIT(rcFreeHeightField(heightfield));
@@ -289,12 +560,12 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
 
   // TODO Instead of this, it should use area IDs and then clear the non-walkable triangles
   rcMarkWalkableTriangles(
-    pContext, cfg.walkableSlopeAngle, pVertices, m_Vertices.GetCount(), pTriangles, m_Triangles.GetCount(), m_TriangleAreaIDs.GetData());
+    pContext, cfg.walkableSlopeAngle, pVertices, vertices.GetCount(), pTriangles, triangles.GetCount(), triangleAreaIDs.GetPtr());
 
   if (!pgRange.BeginNextStep("Rasterize Triangles"))
     return EZ_FAILURE;
 
-  if (!rcRasterizeTriangles(pContext, pVertices, m_Vertices.GetCount(), pTriangles, m_TriangleAreaIDs.GetData(), m_Triangles.GetCount(),
+  if (!rcRasterizeTriangles(pContext, pVertices, vertices.GetCount(), pTriangles, triangleAreaIDs.GetPtr(), triangles.GetCount(),
         *heightfield, cfg.walkableClimb))
   {
     pContext->log(RC_LOG_ERROR, "Could not rasterize triangles");
@@ -371,7 +642,7 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
         return EZ_FAILURE;
 
       // Partition the walkable surface into simple regions without holes.
-      if (!rcBuildRegions(pContext, *compactHeightfield, 0, cfg.minRegionArea, cfg.mergeRegionArea))
+      if (!rcBuildRegions(pContext, *compactHeightfield, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea))
       {
         pContext->log(RC_LOG_ERROR, "Could not build watershed regions.");
         return EZ_FAILURE;
@@ -440,7 +711,8 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
   return EZ_SUCCESS;
 }
 
-ezResult ezRecastNavMeshBuilder::BuildDetourNavMeshData(const ezRecastConfig& config, const rcPolyMesh& polyMesh, ezDataBuffer& NavmeshData)
+ezResult ezRecastNavMeshBuilder::BuildDetourNavMeshData(
+  const ezRecastConfig& config, const rcPolyMesh& polyMesh, ezDataBuffer& NavmeshData, ezInt32 iTileX, ezInt32 iTileY)
 {
   dtNavMeshCreateParams params;
   ezMemoryUtils::ZeroFill(&params, 1);
@@ -460,6 +732,8 @@ ezResult ezRecastNavMeshBuilder::BuildDetourNavMeshData(const ezRecastConfig& co
   params.cs = config.m_fCellSize;
   params.ch = config.m_fCellHeight;
   params.buildBvTree = true;
+  params.tileX = iTileX;
+  params.tileY = iTileY;
 
   ezUInt8* navData = nullptr;
   ezInt32 navDataSize = 0;
@@ -479,7 +753,7 @@ ezResult ezRecastNavMeshBuilder::BuildDetourNavMeshData(const ezRecastConfig& co
 
 ezResult ezRecastConfig::Serialize(ezStreamWriter& stream) const
 {
-  stream.WriteVersion(1);
+  stream.WriteVersion(2);
 
   stream << m_fAgentHeight;
   stream << m_fAgentRadius;
@@ -493,13 +767,14 @@ ezResult ezRecastConfig::Serialize(ezStreamWriter& stream) const
   stream << m_fRegionMergeSize;
   stream << m_fDetailMeshSampleDistanceFactor;
   stream << m_fDetailMeshSampleErrorFactor;
+  stream << m_fTileSize;
 
   return EZ_SUCCESS;
 }
 
 ezResult ezRecastConfig::Deserialize(ezStreamReader& stream)
 {
-  stream.ReadVersion(1);
+  const ezTypeVersion version = stream.ReadVersion(2);
 
   stream >> m_fAgentHeight;
   stream >> m_fAgentRadius;
@@ -514,5 +789,10 @@ ezResult ezRecastConfig::Deserialize(ezStreamReader& stream)
   stream >> m_fDetailMeshSampleDistanceFactor;
   stream >> m_fDetailMeshSampleErrorFactor;
 
+  if (version >= 2)
+  {
+    stream >> m_fTileSize;
+  }
+
   return EZ_SUCCESS;
 }
@@ -6,6 +6,7 @@
 #include <RecastPlugin/RecastPluginDLL.h>
 
 class ezRcBuildContext;
+struct rcConfig;
 struct rcPolyMesh;
 struct rcPolyMeshDetail;
 class ezWorld;
@@ -30,6 +31,11 @@ struct EZ_RECASTPLUGIN_DLL ezRecastConfig
   float m_fDetailMeshSampleDistanceFactor = 1.0f;
   float m_fDetailMeshSampleErrorFactor = 1.0f;
 
+  /// \brief If larger than zero, the navmesh is split into square tiles of (roughly) this size in world units.
+  ///
+  /// Tiles are built in parallel and can be rebuilt individually, when only the geometry of some tiles changed.
+  float m_fTileSize = 0.0f;
+
   ezResult Serialize(ezStreamWriter& stream) const;
   ezResult Deserialize(ezStreamReader& stream);
 };
@@ -46,18 +52,33 @@ public:
 
   static ezResult ExtractWorldGeometry(const ezWorld& world, ezWorldGeoExtractionUtil::Geometry& out_worldGeo);
 
+  /// \brief Builds the navmesh from the given geometry.
+  ///
+  /// If ezRecastConfig::m_fTileSize is positive, a tiled navmesh is built and the tiles are generated in parallel on the ezTaskSystem.
+  /// In that case \a pPreviousNavMesh may point to the result of a previous tiled build. All tiles whose input geometry and
+  /// configuration did not change since then are copied over from it, and only the modified tiles are rebuilt.
   ezResult Build(const ezRecastConfig& config, const ezWorldGeoExtractionUtil::Geometry& worldGeo,
-    ezRecastNavMeshResourceDescriptor& out_NavMeshDesc, ezProgress& progress);
+    ezRecastNavMeshResourceDescriptor& out_NavMeshDesc, ezProgress& progress, const ezRecastNavMeshResourceDescriptor* pPreviousNavMesh = nullptr);
+
+  /// \brief Returns how many tiles the last call to Build() actually had to generate. Tiles that were taken from the previous navmesh are
+  /// not included.
+  ezUInt32 GetNumBuiltTiles() const { return m_uiNumBuiltTiles; }
 
 private:
+  struct Triangle;
+
   static void FillOutConfig(struct rcConfig& cfg, const ezRecastConfig& config, const ezBoundingBox& bbox);
 
   void Clear();
   void ReserveMemory(const ezWorldGeoExtractionUtil::Geometry& desc);
   void GenerateTriangleMeshFromDescription(const ezWorldGeoExtractionUtil::Geometry& desc);
   void ComputeBoundingBox();
-  ezResult BuildRecastPolyMesh(const ezRecastConfig& config, rcPolyMesh& out_PolyMesh, ezProgress& progress);
-  static ezResult BuildDetourNavMeshData(const ezRecastConfig& config, const rcPolyMesh& polyMesh, ezDataBuffer& NavmeshData);
+  ezResult BuildTiledNavMesh(const ezRecastConfig& config, ezRecastNavMeshResourceDescriptor& out_NavMeshDesc, ezProgress& progress,
+    const ezRecastNavMeshResourceDescriptor* pPreviousNavMesh);
+  static ezResult BuildRecastPolyMesh(ezRcBuildContext* pContext, const rcConfig& cfg, ezArrayPtr<const ezVec3> vertices,
+    ezArrayPtr<const Triangle> triangles, ezArrayPtr<ezUInt8> triangleAreaIDs, rcPolyMesh& out_PolyMesh, ezProgress& progress);
+  static ezResult BuildDetourNavMeshData(const ezRecastConfig& config, const rcPolyMesh& polyMesh, ezDataBuffer& NavmeshData,
+    ezInt32 iTileX = 0, ezInt32 iTileY = 0);
 
   struct Triangle
   {
@@ -77,4 +98,5 @@ private:
   ezDynamicArray<Triangle> m_Triangles;
   ezDynamicArray<ezUInt8> m_TriangleAreaIDs;
   ezRcBuildContext* m_pRecastContext = nullptr;
+  ezUInt32 m_uiNumBuiltTiles = 0;
 };
@@ -16,6 +16,134 @@ EZ_RESOURCE_IMPLEMENT_COMMON_CODE(ezRecastNavMeshResource);
 
 //////////////////////////////////////////////////////////////////////////
 
+static ezResult WritePolyMesh(ezStreamWriter& stream, const rcPolyMesh& mesh)
+{
+  EZ_CHECK_AT_COMPILETIME_MSG(sizeof(rcPolyMesh) == sizeof(void*) * 5 + sizeof(int) * 14, "rcPolyMesh data structure has changed");
+
+  stream << (int)mesh.nverts;
+  stream << (int)mesh.npolys;
+  stream << (int)mesh.npolys; // do not use mesh.maxpolys
+  stream << (int)mesh.nvp;
+  stream << (float)mesh.bmin[0];
+  stream << (float)mesh.bmin[1];
+  stream << (float)mesh.bmin[2];
+  stream << (float)mesh.bmax[0];
+  stream << (float)mesh.bmax[1];
+  stream << (float)mesh.bmax[2];
+  stream << (float)mesh.cs;
+  stream << (float)mesh.ch;
+  stream << (int)mesh.borderSize;
+  stream << (float)mesh.maxEdgeError;
+
+  EZ_ASSERT_DEBUG(mesh.maxpolys >= mesh.npolys, "Invalid navmesh polygon count");
+
+  EZ_SUCCEED_OR_RETURN(stream.WriteBytes(mesh.verts, sizeof(ezUInt16) * mesh.nverts * 3));
+  EZ_SUCCEED_OR_RETURN(stream.WriteBytes(mesh.polys, sizeof(ezUInt16) * mesh.npolys * mesh.nvp * 2));
+  EZ_SUCCEED_OR_RETURN(stream.WriteBytes(mesh.regs, sizeof(ezUInt16) * mesh.npolys));
+  EZ_SUCCEED_OR_RETURN(stream.WriteBytes(mesh.flags, sizeof(ezUInt16) * mesh.npolys));
+  EZ_SUCCEED_OR_RETURN(stream.WriteBytes(mesh.areas, sizeof(ezUInt8) * mesh.npolys));
+
+  return EZ_SUCCESS;
+}
+
+static rcPolyMesh* ReadPolyMesh(ezStreamReader& stream)
+{
+  EZ_CHECK_AT_COMPILETIME_MSG(sizeof(rcPolyMesh) == sizeof(void*) * 5 + sizeof(int) * 14, "rcPolyMesh data structure has changed");
+
+  rcPolyMesh* pMesh = EZ_DEFAULT_NEW(rcPolyMesh);
+
+  auto& mesh = *pMesh;
+
+  stream >> mesh.nverts;
+  stream >> mesh.npolys;
+  stream >> mesh.maxpolys;
+  stream >> mesh.nvp;
+  stream >> mesh.bmin[0];
+  stream >> mesh.bmin[1];
+  stream >> mesh.bmin[2];
+  stream >> mesh.bmax[0];
+  stream >> mesh.bmax[1];
+  stream >> mesh.bmax[2];
+  stream >> mesh.cs;
+  stream >> mesh.ch;
+  stream >> mesh.borderSize;
+  stream >> mesh.maxEdgeError;
+
+  EZ_ASSERT_DEBUG(mesh.maxpolys >= mesh.npolys, "Invalid navmesh polygon count");
+
+  mesh.verts = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.nverts * 3, RC_ALLOC_PERM);
+  mesh.polys = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.maxpolys * mesh.nvp * 2, RC_ALLOC_PERM);
+  mesh.regs = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.maxpolys, RC_ALLOC_PERM);
+  mesh.flags = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.maxpolys, RC_ALLOC_PERM);
+  mesh.areas = (ezUInt8*)rcAlloc(sizeof(ezUInt8) * mesh.maxpolys, RC_ALLOC_PERM);
+
+  stream.ReadBytes(mesh.verts, sizeof(ezUInt16) * mesh.nverts * 3);
+  stream.ReadBytes(mesh.polys, sizeof(ezUInt16) * mesh.maxpolys * mesh.nvp * 2);
+  stream.ReadBytes(mesh.regs, sizeof(ezUInt16) * mesh.maxpolys);
+  stream.ReadBytes(mesh.flags, sizeof(ezUInt16) * mesh.maxpolys);
+  stream.ReadBytes(mesh.areas, sizeof(ezUInt8) * mesh.maxpolys);
+
+  return pMesh;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezRecastNavMeshTile::ezRecastNavMeshTile() = default;
+ezRecastNavMeshTile::ezRecastNavMeshTile(ezRecastNavMeshTile&& rhs)
+{
+  *this = std::move(rhs);
+}
+
+ezRecastNavMeshTile::~ezRecastNavMeshTile()
+{
+  EZ_DEFAULT_DELETE(m_pTilePolygons);
+}
+
+void ezRecastNavMeshTile::operator=(ezRecastNavMeshTile&& rhs)
+{
+  m_iTileX = rhs.m_iTileX;
+  m_iTileY = rhs.m_iTileY;
+  m_uiInputHash = rhs.m_uiInputHash;
+  m_DetourTileData = std::move(rhs.m_DetourTileData);
+
+  EZ_DEFAULT_DELETE(m_pTilePolygons);
+  m_pTilePolygons = rhs.m_pTilePolygons;
+  rhs.m_pTilePolygons = nullptr;
+}
+
+rcPolyMesh* ezRecastNavMeshTile::ClonePolyMesh(const rcPolyMesh& mesh)
+{
+  rcPolyMesh* pClone = EZ_DEFAULT_NEW(rcPolyMesh);
+  auto& clone = *pClone;
+
+  clone.nverts = mesh.nverts;
+  clone.npolys = mesh.npolys;
+  clone.maxpolys = mesh.npolys;
+  clone.nvp = mesh.nvp;
+  rcVcopy(clone.bmin, mesh.bmin);
+  rcVcopy(clone.bmax, mesh.bmax);
+  clone.cs = mesh.cs;
+  clone.ch = mesh.ch;
+  clone.borderSize = mesh.borderSize;
+  clone.maxEdgeError = mesh.maxEdgeError;
+
+  clone.verts = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.nverts * 3, RC_ALLOC_PERM);
+  clone.polys = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.npolys * mesh.nvp * 2, RC_ALLOC_PERM);
+  clone.regs = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.npolys, RC_ALLOC_PERM);
+  clone.flags = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.npolys, RC_ALLOC_PERM);
+  clone.areas = (ezUInt8*)rcAlloc(sizeof(ezUInt8) * mesh.npolys, RC_ALLOC_PERM);
+
+  ezMemoryUtils::Copy(clone.verts, mesh.verts, mesh.nverts * 3);
+  ezMemoryUtils::Copy(clone.polys, mesh.polys, mesh.npolys * mesh.nvp * 2);
+  ezMemoryUtils::Copy(clone.regs, mesh.regs, mesh.npolys);
+  ezMemoryUtils::Copy(clone.flags, mesh.flags, mesh.npolys);
+  ezMemoryUtils::Copy(clone.areas, mesh.areas, mesh.npolys);
+
+  return pClone;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 ezRecastNavMeshResourceDescriptor::ezRecastNavMeshResourceDescriptor() = default;
 ezRecastNavMeshResourceDescriptor::ezRecastNavMeshResourceDescriptor(ezRecastNavMeshResourceDescriptor&& rhs)
 {
@@ -31,54 +159,106 @@ void ezRecastNavMeshResourceDescriptor::operator=(ezRecastNavMeshResourceDescrip
 {
   m_DetourNavmeshData = std::move(rhs.m_DetourNavmeshData);
 
+  EZ_DEFAULT_DELETE(m_pNavMeshPolygons);
   m_pNavMeshPolygons = rhs.m_pNavMeshPolygons;
   rhs.m_pNavMeshPolygons = nullptr;
+
+  m_Tiles = std::move(rhs.m_Tiles);
+  m_vTileOrigin = rhs.m_vTileOrigin;
+  m_fTileWorldSize = rhs.m_fTileWorldSize;
+  m_uiMaxTiles = rhs.m_uiMaxTiles;
+  m_uiMaxPolysPerTile = rhs.m_uiMaxPolysPerTile;
 }
 
 void ezRecastNavMeshResourceDescriptor::Clear()
 {
   m_DetourNavmeshData.Clear();
   EZ_DEFAULT_DELETE(m_pNavMeshPolygons);
+
+  m_Tiles.Clear();
+  m_vTileOrigin.SetZero();
+  m_fTileWorldSize = 0.0f;
+  m_uiMaxTiles = 0;
+  m_uiMaxPolysPerTile = 0;
+}
+
+void ezRecastNavMeshResourceDescriptor::MergeTilePolygons()
+{
+  EZ_DEFAULT_DELETE(m_pNavMeshPolygons);
+
+  ezHybridArray<rcPolyMesh*, 64> tileMeshes;
+  ezUInt32 uiNumVertices = 0;
+
+  for (auto& tile : m_Tiles)
+  {
+    if (tile.m_pTilePolygons != nullptr)
+    {
+      tileMeshes.PushBack(tile.m_pTilePolygons);
+      uiNumVertices += tile.m_pTilePolygons->nverts;
+    }
+  }
+
+  if (tileMeshes.IsEmpty())
+    return;
+
+  // rcPolyMesh uses 16 bit vertex indices
+  if (uiNumVertices >= 0xFFFF)
+  {
+    ezLog::Warning("The navmesh is too large to merge all tile polygons ({0} vertices). Navmesh visualization is not available.", uiNumVertices);
+    return;
+  }
+
+  rcContext context(false);
+  m_pNavMeshPolygons = EZ_DEFAULT_NEW(rcPolyMesh);
+
+  if (!rcMergePolyMeshes(&context, tileMeshes.GetData(), (int)tileMeshes.GetCount(), *m_pNavMeshPolygons))
+  {
+    ezLog::Warning("Failed to merge the navmesh tile polygons. Navmesh visualization is not available.");
+    EZ_DEFAULT_DELETE(m_pNavMeshPolygons);
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////
 
 ezResult ezRecastNavMeshResourceDescriptor::Serialize(ezStreamWriter& stream) const
 {
-  stream.WriteVersion(1);
+  stream.WriteVersion(2);
   EZ_SUCCEED_OR_RETURN(stream.WriteArray(m_DetourNavmeshData));
 
-  const bool hasPolygons = m_pNavMeshPolygons != nullptr;
+  // for tiled navmeshes the merged polygons are recreated from the tiles on load
+  const bool hasPolygons = m_pNavMeshPolygons != nullptr && m_Tiles.IsEmpty();
   stream << hasPolygons;
 
   if (hasPolygons)
   {
-    EZ_CHECK_AT_COMPILETIME_MSG(sizeof(rcPolyMesh) == sizeof(void*) * 5 + sizeof(int) * 14, "rcPolyMesh data structure has changed");
-
-    const auto& mesh = *m_pNavMeshPolygons;
-
-    stream << (int)mesh.nverts;
-    stream << (int)mesh.npolys;
-    stream << (int)mesh.npolys; // do not use mesh.maxpolys
-    stream << (int)mesh.nvp;
-    stream << (float)mesh.bmin[0];
-    stream << (float)mesh.bmin[1];
-    stream << (float)mesh.bmin[2];
-    stream << (float)mesh.bmax[0];
-    stream << (float)mesh.bmax[1];
-    stream << (float)mesh.bmax[2];
-    stream << (float)mesh.cs;
-    stream << (float)mesh.ch;
-    stream << (int)mesh.borderSize;
-    stream << (float)mesh.maxEdgeError;
-
-    EZ_ASSERT_DEBUG(mesh.maxpolys >= mesh.npolys, "Invalid navmesh polygon count");
-
-    EZ_SUCCEED_OR_RETURN(stream.WriteBytes(mesh.verts, sizeof(ezUInt16) * mesh.nverts * 3));
-    EZ_SUCCEED_OR_RETURN(stream.WriteBytes(mesh.polys, sizeof(ezUInt16) * mesh.npolys * mesh.nvp * 2));
-    EZ_SUCCEED_OR_RETURN(stream.WriteBytes(mesh.regs, sizeof(ezUInt16) * mesh.npolys));
-    EZ_SUCCEED_OR_RETURN(stream.WriteBytes(mesh.flags, sizeof(ezUInt16) * mesh.npolys));
-    EZ_SUCCEED_OR_RETURN(stream.WriteBytes(mesh.areas, sizeof(ezUInt8) * mesh.npolys));
+    EZ_SUCCEED_OR_RETURN(WritePolyMesh(stream, *m_pNavMeshPolygons));
+  }
+
+  // version 2
+  stream << m_Tiles.GetCount();
+
+  if (!m_Tiles.IsEmpty())
+  {
+    stream << m_vTileOrigin;
+    stream << m_fTileWorldSize;
+    stream << m_uiMaxTiles;
+    stream << m_uiMaxPolysPerTile;
+
+    for (const auto& tile : m_Tiles)
+    {
+      stream << tile.m_iTileX;
+      stream << tile.m_iTileY;
+      stream << tile.m_uiInputHash;
+      EZ_SUCCEED_OR_RETURN(stream.WriteArray(tile.m_DetourTileData));
+
+      const bool hasTilePolygons = tile.m_pTilePolygons != nullptr;
+      stream << hasTilePolygons;
+
+      if (hasTilePolygons)
+      {
+        EZ_SUCCEED_OR_RETURN(WritePolyMesh(stream, *tile.m_pTilePolygons));
+      }
+    }
   }
 
   return EZ_SUCCESS;
@@ -88,7 +268,7 @@ ezResult ezRecastNavMeshResourceDescriptor::Deserialize(ezStreamReader& stream)
 {
   Clear();
 
-  const ezTypeVersion version = stream.ReadVersion(1);
+  const ezTypeVersion version = stream.ReadVersion(2);
   EZ_SUCCEED_OR_RETURN(stream.ReadArray(m_DetourNavmeshData));
 
   bool hasPolygons = false;
@@ -96,39 +276,41 @@ ezResult ezRecastNavMeshResourceDescriptor::Deserialize(ezStreamReader& stream)
 
   if (hasPolygons)
   {
-    EZ_CHECK_AT_COMPILETIME_MSG(sizeof(rcPolyMesh) == sizeof(void*) * 5 + sizeof(int) * 14, "rcPolyMesh data structure has changed");
-
-    m_pNavMeshPolygons = EZ_DEFAULT_NEW(rcPolyMesh);
-
-    auto& mesh = *m_pNavMeshPolygons;
-
-    stream >> mesh.nverts;
-    stream >> mesh.npolys;
-    stream >> mesh.maxpolys;
-    stream >> mesh.nvp;
-    stream >> mesh.bmin[0];
-    stream >> mesh.bmin[1];
-    stream >> mesh.bmin[2];
-    stream >> mesh.bmax[0];
-    stream >> mesh.bmax[1];
-    stream >> mesh.bmax[2];
-    stream >> mesh.cs;
-    stream >> mesh.ch;
-    stream >> mesh.borderSize;
-    stream >> mesh.maxEdgeError;
-
-    EZ_ASSERT_DEBUG(mesh.maxpolys >= mesh.npolys, "Invalid navmesh polygon count");
-
-    mesh.verts = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.nverts * 3, RC_ALLOC_PERM);
-    mesh.polys = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.maxpolys * mesh.nvp * 2, RC_ALLOC_PERM);
-    mesh.regs = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.maxpolys, RC_ALLOC_PERM);
-    mesh.areas = (ezUInt8*)rcAlloc(sizeof(ezUInt8) * mesh.maxpolys, RC_ALLOC_PERM);
-
-    stream.ReadBytes(mesh.verts, sizeof(ezUInt16) * mesh.nverts * 3);
-    stream.ReadBytes(mesh.polys, sizeof(ezUInt16) * mesh.maxpolys * mesh.nvp * 2);
-    stream.ReadBytes(mesh.regs, sizeof(ezUInt16) * mesh.maxpolys);
-    stream.ReadBytes(mesh.flags, sizeof(ezUInt16) * mesh.maxpolys);
-    stream.ReadBytes(mesh.areas, sizeof(ezUInt8) * mesh.maxpolys);
+    m_pNavMeshPolygons = ReadPolyMesh(stream);
+  }
+
+  if (version >= 2)
+  {
+    ezUInt32 uiNumTiles = 0;
+    stream >> uiNumTiles;
+
+    if (uiNumTiles > 0)
+    {
+      stream >> m_vTileOrigin;
+      stream >> m_fTileWorldSize;
+      stream >> m_uiMaxTiles;
+      stream >> m_uiMaxPolysPerTile;
+
+      m_Tiles.SetCount(uiNumTiles);
+
+      for (auto& tile : m_Tiles)
+      {
+        stream >> tile.m_iTileX;
+        stream >> tile.m_iTileY;
+        stream >> tile.m_uiInputHash;
+        EZ_SUCCEED_OR_RETURN(stream.ReadArray(tile.m_DetourTileData));
+
+        bool hasTilePolygons = false;
+        stream >> hasTilePolygons;
+
+        if (hasTilePolygons)
+        {
+          tile.m_pTilePolygons = ReadPolyMesh(stream);
+        }
+      }
+
+      MergeTilePolygons();
+    }
   }
 
   return EZ_SUCCESS;
@@ -156,6 +338,7 @@ ezResourceLoadDesc ezRecastNavMeshResource::UnloadData(Unload WhatToUnload)
   res.m_State = ezResourceState::Unloaded;
 
   m_DetourNavmeshData.Clear();
+  m_DetourTileData.Clear();
   EZ_DEFAULT_DELETE(m_pNavMesh);
   EZ_DEFAULT_DELETE(m_pNavMeshPolygons);
 
@@ -195,6 +378,13 @@ void ezRecastNavMeshResource::UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage)
 {
   out_NewMemoryUsage.m_uiMemoryCPU = sizeof(ezRecastNavMeshResource);
   out_NewMemoryUsage.m_uiMemoryCPU += m_DetourNavmeshData.GetHeapMemoryUsage();
+  out_NewMemoryUsage.m_uiMemoryCPU += m_DetourTileData.GetHeapMemoryUsage();
+
+  for (const auto& tileData : m_DetourTileData)
+  {
+    out_NewMemoryUsage.m_uiMemoryCPU += tileData.GetHeapMemoryUsage();
+  }
+
   out_NewMemoryUsage.m_uiMemoryCPU += m_pNavMesh != nullptr ? sizeof(dtNavMesh) : 0;
   out_NewMemoryUsage.m_uiMemoryCPU += m_pNavMeshPolygons != nullptr ? sizeof(rcPolyMesh) : 0;
   out_NewMemoryUsage.m_uiMemoryGPU = 0;
@@ -216,7 +406,45 @@ ezResourceLoadDesc ezRecastNavMeshResource::CreateResource(ezRecastNavMeshResour
 
   // the dtNavMesh does not need to free the data, the resource owns it
   const int dtMeshFlags = 0;
-  m_pNavMesh->init(m_DetourNavmeshData.GetData(), m_DetourNavmeshData.GetCount(), dtMeshFlags);
+
+  if (descriptor.m_Tiles.IsEmpty())
+  {
+    m_pNavMesh->init(m_DetourNavmeshData.GetData(), m_DetourNavmeshData.GetCount(), dtMeshFlags);
+    return res;
+  }
+
+  dtNavMeshParams params;
+  // the tile coordinates are absolute, so Detour has to compute them relative to the origin as well
+  params.orig[0] = 0.0f;
+  params.orig[1] = descriptor.m_vTileOrigin.y;
+  params.orig[2] = 0.0f;
+  params.tileWidth = descriptor.m_fTileWorldSize;
+  params.tileHeight = descriptor.m_fTileWorldSize;
+  params.maxTiles = descriptor.m_uiMaxTiles;
+  params.maxPolys = descriptor.m_uiMaxPolysPerTile;
+
+  if (dtStatusFailed(m_pNavMesh->init(&params)))
+  {
+    ezLog::Error("Failed to initialize the tiled navmesh.");
+    res.m_State = ezResourceState::LoadedResourceMissing;
+    return res;
+  }
+
+  m_DetourTileData.Reserve(descriptor.m_Tiles.GetCount());
+
+  for (auto& tile : descriptor.m_Tiles)
+  {
+    if (tile.m_DetourTileData.IsEmpty())
+      continue;
+
+    ezDataBuffer& tileData = m_DetourTileData.ExpandAndGetRef();
+    tileData = std::move(tile.m_DetourTileData);
+
+    if (dtStatusFailed(m_pNavMesh->addTile(tileData.GetData(), tileData.GetCount(), dtMeshFlags, 0, nullptr)))
+    {
+      ezLog::Error("Failed to add navmesh tile ({0}, {1}).", tile.m_iTileX, tile.m_iTileY);
+    }
+  }
 
   return res;
 }
@@ -8,6 +8,35 @@ class dtNavMesh;
 
 typedef ezTypedResourceHandle<class ezRecastNavMeshResource> ezRecastNavMeshResourceHandle;
 
+/// \brief One tile of a tiled navmesh.
+struct EZ_RECASTPLUGIN_DLL ezRecastNavMeshTile
+{
+  ezRecastNavMeshTile();
+  ezRecastNavMeshTile(const ezRecastNavMeshTile& rhs) = delete;
+  ezRecastNavMeshTile(ezRecastNavMeshTile&& rhs);
+  ~ezRecastNavMeshTile();
+  void operator=(ezRecastNavMeshTile&& rhs);
+  void operator=(const ezRecastNavMeshTile& rhs) = delete;
+
+  /// \brief Absolute tile coordinates, i.e. the tile grid always starts at the origin of the Recast coordinate system.
+  ezInt32 m_iTileX = 0;
+  ezInt32 m_iTileY = 0;
+
+  /// \brief Hash over the input geometry and configuration that was used to build this tile. Used to detect which tiles need to be rebuilt.
+  ezUInt64 m_uiInputHash = 0;
+
+  /// \brief Data that was created by dtCreateNavMeshData() and will be used for dtNavMesh::addTile()
+  ///
+  /// Empty for tiles that have input geometry but no walkable area. Those are still stored, so that incremental builds don't regenerate them.
+  ezDataBuffer m_DetourTileData;
+
+  /// \brief The polygons of this tile, used to build ezRecastNavMeshResourceDescriptor::m_pNavMeshPolygons
+  rcPolyMesh* m_pTilePolygons = nullptr;
+
+  /// \brief Creates a deep copy of the given polygon mesh.
+  static rcPolyMesh* ClonePolyMesh(const rcPolyMesh& mesh);
+};
+
 struct EZ_RECASTPLUGIN_DLL ezRecastNavMeshResourceDescriptor
 {
   ezRecastNavMeshResourceDescriptor();
@@ -21,10 +50,28 @@ struct EZ_RECASTPLUGIN_DLL ezRecastNavMeshResourceDescriptor
   ezDataBuffer m_DetourNavmeshData;
 
   /// \brief Optional, if available the navmesh can be visualized at runtime
+  ///
+  /// For tiled navmeshes this is merged from the polygons of all tiles. It may be null if the merged mesh would be too large.
   rcPolyMesh* m_pNavMeshPolygons = nullptr;
 
+  /// \name Tiled navmesh data. If m_Tiles is empty, m_DetourNavmeshData contains a single tile navmesh.
+  ///@{
+
+  ezDynamicArray<ezRecastNavMeshTile> m_Tiles;
+
+  /// \brief The minimum corner of the tiles that were built (in Recast coordinates). Always a multiple of the tile size on the x and z axis.
+  ezVec3 m_vTileOrigin = ezVec3::ZeroVector();
+  float m_fTileWorldSize = 0.0f;
+  ezUInt32 m_uiMaxTiles = 0;
+  ezUInt32 m_uiMaxPolysPerTile = 0;
+
+  ///@}
+
   void Clear();
 
+  /// \brief Merges the polygons of all tiles into m_pNavMeshPolygons.
+  void MergeTilePolygons();
+
   ezResult Serialize(ezStreamWriter& stream) const;
   ezResult Deserialize(ezStreamReader& stream);
 };
@@ -48,6 +95,7 @@ private:
   virtual void UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage) override;
 
   ezDataBuffer m_DetourNavmeshData;
+  ezDynamicArray<ezDataBuffer> m_DetourTileData;
   dtNavMesh* m_pNavMesh = nullptr;
   rcPolyMesh* m_pNavMeshPolygons = nullptr;
 };
@@ -25,6 +25,8 @@ ezResourceLoadDesc ezScriptCompendiumResource::UnloadData(Unload WhatToUnload)
   ld.m_uiQualityLevelsLoadable = 0;
 
   m_Desc.m_PathToSource.Clear();
+  m_Desc.m_AssetGuidToInfo.Clear();
+  m_Desc.m_PathToBytecode.Clear();
 
   return ld;
 }
@@ -60,7 +62,14 @@ ezResourceLoadDesc ezScriptCompendiumResource::UpdateContent(ezStreamReader* pSt
 
 void ezScriptCompendiumResource::UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage)
 {
-  out_NewMemoryUsage.m_uiMemoryCPU = (ezUInt32)sizeof(ezScriptCompendiumResource) + (ezUInt32)m_Desc.m_PathToSource.GetHeapMemoryUsage();
+  out_NewMemoryUsage.m_uiMemoryCPU = (ezUInt32)sizeof(ezScriptCompendiumResource) + (ezUInt32)m_Desc.m_PathToSource.GetHeapMemoryUsage() +
+                                     (ezUInt32)m_Desc.m_PathToBytecode.GetHeapMemoryUsage();
+
+  for (auto it : m_Desc.m_PathToBytecode)
+  {
+    out_NewMemoryUsage.m_uiMemoryCPU += (ezUInt32)it.Value().m_Bytecode.GetHeapMemoryUsage();
+  }
+
   out_NewMemoryUsage.m_uiMemoryGPU = 0;
 }
 
@@ -68,17 +77,18 @@ void ezScriptCompendiumResource::UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsa
 
 ezResult ezScriptCompendiumResourceDesc::Serialize(ezStreamWriter& stream) const
 {
-  stream.WriteVersion(2);
+  stream.WriteVersion(3);
 
   EZ_SUCCEED_OR_RETURN(stream.WriteMap(m_PathToSource));
   EZ_SUCCEED_OR_RETURN(stream.WriteMap(m_AssetGuidToInfo));
+  EZ_SUCCEED_OR_RETURN(stream.WriteMap(m_PathToBytecode));
 
   return EZ_SUCCESS;
 }
 
 ezResult ezScriptCompendiumResourceDesc::Deserialize(ezStreamReader& stream)
 {
-  ezTypeVersion version = stream.ReadVersion(2);
+  ezTypeVersion version = stream.ReadVersion(3);
 
   EZ_SUCCEED_OR_RETURN(stream.ReadMap(m_PathToSource));
 
@@ -87,6 +97,11 @@ ezResult ezScriptCompendiumResourceDesc::Deserialize(ezStreamReader& stream)
     EZ_SUCCEED_OR_RETURN(stream.ReadMap(m_AssetGuidToInfo));
   }
 
+  if (version >= 3)
+  {
+    EZ_SUCCEED_OR_RETURN(stream.ReadMap(m_PathToBytecode));
+  }
+
   return EZ_SUCCESS;
 }
 
@@ -107,3 +122,23 @@ ezResult ezScriptCompendiumResourceDesc::ComponentTypeInfo::Deserialize(ezStream
   EZ_SUCCEED_OR_RETURN(stream.ReadString(m_sComponentFilePath));
   return EZ_SUCCESS;
 }
+
+ezResult ezScriptCompendiumResourceDesc::ModuleBytecode::Serialize(ezStreamWriter& stream) const
+{
+  stream.WriteVersion(1);
+
+  stream << m_uiSourceHash;
+  stream << m_uiBytecodeVersion;
+  EZ_SUCCEED_OR_RETURN(stream.WriteArray(m_Bytecode));
+  return EZ_SUCCESS;
+}
+
+ezResult ezScriptCompendiumResourceDesc::ModuleBytecode::Deserialize(ezStreamReader& stream)
+{
+  ezTypeVersion version = stream.ReadVersion(1);
+
+  stream >> m_uiSourceHash;
+  stream >> m_uiBytecodeVersion;
+  EZ_SUCCEED_OR_RETURN(stream.ReadArray(m_Bytecode));
+  return EZ_SUCCESS;
+}
@@ -23,6 +23,22 @@ struct EZ_TYPESCRIPTPLUGIN_DLL ezScriptCompendiumResourceDesc
 
   ezMap<ezUuid, ComponentTypeInfo> m_AssetGuidToInfo;
 
+  /// \brief Precompiled Duktape bytecode of a module, so that it doesn't need to be parsed and compiled at runtime.
+  ///
+  /// The bytecode is only used if it was compiled from the exact same source (m_uiSourceHash is the xxHash64 of the JavaScript code)
+  /// and by the same Duktape build (see ezDuktapeHelper::GetBytecodeVersion()). Otherwise the module is compiled from source.
+  struct ModuleBytecode
+  {
+    ezUInt64 m_uiSourceHash = 0;
+    ezUInt32 m_uiBytecodeVersion = 0;
+    ezDynamicArray<ezUInt8> m_Bytecode;
+
+    ezResult Serialize(ezStreamWriter& stream) const;
+    ezResult Deserialize(ezStreamReader& stream);
+  };
+
+  ezMap<ezString, ModuleBytecode> m_PathToBytecode;
+
   ezResult Serialize(ezStreamWriter& stream) const;
   ezResult Deserialize(ezStreamReader& stream);
 };
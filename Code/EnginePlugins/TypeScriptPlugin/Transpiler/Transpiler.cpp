@@ -25,11 +25,19 @@ void ezTypeScriptTranspiler::StartLoadTranspiler()
   if (m_LoadTaskGroup.IsValid())
     return;
 
-  ezSharedPtr<ezTask> pTask = EZ_DEFAULT_NEW(ezDelegateTask<void>, "", [this]() //
+  // compiling typescriptServices.js takes a long time, so its bytecode is cached in the output folder
+  ezStringBuilder sBytecodeCacheFile;
+  if (!m_sOutputFolder.IsEmpty())
+  {
+    sBytecodeCacheFile = m_sOutputFolder;
+    sBytecodeCacheFile.AppendPath("typescriptServices.ezDukBytecode");
+  }
+
+  ezSharedPtr<ezTask> pTask = EZ_DEFAULT_NEW(ezDelegateTask<void>, "", [this, sBytecodeCacheFile]() //
     {
       EZ_PROFILE_SCOPE("Load TypeScript Transpiler");
 
-      if (m_Transpiler.ExecuteFile("typescriptServices.js").Failed())
+      if (LoadTypeScriptServices(sBytecodeCacheFile).Failed())
       {
         ezLog::Error("typescriptServices.js could not be loaded");
       }
@@ -41,6 +49,66 @@ void ezTypeScriptTranspiler::StartLoadTranspiler()
   m_LoadTaskGroup = ezTaskSystem::StartSingleTask(pTask, ezTaskPriority::LongRunning);
 }
 
+ezResult ezTypeScriptTranspiler::LoadTypeScriptServices(const char* szBytecodeCacheFile)
+{
+  ezStringBuilder source;
+
+  {
+    ezFileReader file;
+    EZ_SUCCEED_OR_RETURN(file.Open("typescriptServices.js"));
+
+    source.ReadAll(file);
+  }
+
+  const ezUInt64 uiSourceHash = ezHashingUtils::xxHash64(source.GetData(), source.GetElementCount());
+  const ezUInt32 uiBytecodeVersion = ezDuktapeHelper::GetBytecodeVersion();
+
+  ezDynamicArray<ezUInt8> bytecode;
+
+  if (!ezStringUtils::IsNullOrEmpty(szBytecodeCacheFile))
+  {
+    ezFileReader file;
+    if (file.Open(szBytecodeCacheFile).Succeeded())
+    {
+      ezUInt8 uiFileVersion = 0;
+      ezUInt64 uiCachedSourceHash = 0;
+      ezUInt32 uiCachedBytecodeVersion = 0;
+
+      file >> uiFileVersion;
+      file >> uiCachedSourceHash;
+      file >> uiCachedBytecodeVersion;
+
+      if (uiFileVersion == 1 && uiCachedSourceHash == uiSourceHash && uiCachedBytecodeVersion == uiBytecodeVersion &&
+          file.ReadArray(bytecode).Succeeded())
+      {
+        if (m_Transpiler.ExecuteBytecode(bytecode, "typescriptServices.js").Succeeded())
+          return EZ_SUCCESS;
+
+        ezLog::Warning("Cached bytecode of typescriptServices.js could not be executed, compiling it from source.");
+      }
+    }
+  }
+
+  EZ_SUCCEED_OR_RETURN(m_Transpiler.CompileStringToBytecode(source, bytecode, "typescriptServices.js"));
+  EZ_SUCCEED_OR_RETURN(m_Transpiler.ExecuteBytecode(bytecode, "typescriptServices.js"));
+
+  if (!ezStringUtils::IsNullOrEmpty(szBytecodeCacheFile))
+  {
+    ezFileWriter file;
+    if (file.Open(szBytecodeCacheFile).Succeeded())
+    {
+      const ezUInt8 uiFileVersion = 1;
+
+      file << uiFileVersion;
+      file << uiSourceHash;
+      file << uiBytecodeVersion;
+      file.WriteArray(bytecode);
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
 void ezTypeScriptTranspiler::FinishLoadTranspiler()
 {
   StartLoadTranspiler();
@@ -172,6 +240,22 @@ ezResult ezTypeScriptTranspiler::TranspileFileAndStoreJS(const char* szFile, ezS
   return EZ_SUCCESS;
 }
 
+ezResult ezTypeScriptTranspiler::CompileModuleToBytecode(const char* szJsSource, const char* szModuleName, ezDynamicArray<ezUInt8>& out_Bytecode)
+{
+  EZ_LOG_BLOCK("CompileModuleToBytecode", szModuleName);
+
+  FinishLoadTranspiler();
+
+  EZ_PROFILE_SCOPE("Compile JavaScript Module");
+
+  // this has to match the wrapper that duk_module_duktape puts around the module source and how it compiles it,
+  // evaluating the code yields the module function
+  ezStringBuilder sWrapped;
+  sWrapped.Append("(function(require,exports,module){", szJsSource, "\n})");
+
+  return m_Transpiler.CompileStringToBytecode(sWrapped, out_Bytecode, szModuleName, true);
+}
+
 void ezTypeScriptTranspiler::SetModifyTsBeforeTranspilationCallback(ezDelegate<void(ezStringBuilder&)> callback)
 {
   m_ModifyTsBeforeTranspilationCB = callback;
@@ -18,9 +18,16 @@ public:
   ezResult TranspileString(const char* szString, ezStringBuilder& out_Result);
   ezResult TranspileFile(const char* szFile, ezUInt64 uiSkipIfFileHash, ezStringBuilder& out_Result, ezUInt64& out_uiFileHash);
   ezResult TranspileFileAndStoreJS(const char* szFile, ezStringBuilder& out_Result);
+
+  /// \brief Compiles transpiled JavaScript into Duktape bytecode, the same way Duktape compiles a 'required' module.
+  ///
+  /// The result can be stored in ezScriptCompendiumResourceDesc::m_PathToBytecode.
+  ezResult CompileModuleToBytecode(const char* szJsSource, const char* szModuleName, ezDynamicArray<ezUInt8>& out_Bytecode);
   void SetModifyTsBeforeTranspilationCallback(ezDelegate<void(ezStringBuilder&)> callback);
 
 private:
+  ezResult LoadTypeScriptServices(const char* szBytecodeCacheFile);
+
   ezDelegate<void(ezStringBuilder&)> m_ModifyTsBeforeTranspilationCB;
   ezString m_sOutputFolder;
   ezTaskGroupID m_LoadTaskGroup;
@@ -3,6 +3,8 @@
 #include <Core/ResourceManager/ResourceManager.h>
 #include <Core/World/World.h>
 #include <Duktape/duktape.h>
+#include <Foundation/Configuration/Plugin.h>
+#include <Foundation/Configuration/Startup.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Reflection/ReflectionUtils.h>
 #include <TypeScriptPlugin/TsBinding/TsBinding.h>
@@ -11,6 +13,8 @@ static ezHashTable<duk_context*, ezTypeScriptBinding*> s_DukToBinding;
 
 ezSet<const ezRTTI*> ezTypeScriptBinding::s_RequiredEnums;
 ezSet<const ezRTTI*> ezTypeScriptBinding::s_RequiredFlags;
+ezMutex ezTypeScriptBinding::s_PropertySyncMutex;
+ezMap<const ezRTTI*, ezDynamicArray<ezTypeScriptBinding::PropertySync>> ezTypeScriptBinding::s_PropertySyncInfo;
 
 static int __CPP_Time_Get(duk_context* pDuk)
 {
@@ -292,30 +296,114 @@ bool ezTypeScriptBinding::DukPushStashObject(duk_context* pDuk, ezUInt32 uiStash
   }
 }
 
-void ezTypeScriptBinding::SyncTsObjectEzTsObject(duk_context* pDuk, const ezRTTI* pRtti, void* pObject, ezInt32 iObjIdx)
+namespace
 {
-  ezHybridArray<ezAbstractProperty*, 32> properties;
-  pRtti->GetAllProperties(properties);
+  template <typename Type>
+  EZ_ALWAYS_INLINE Type GetMemberValue(const ezAbstractMemberProperty* pMember, const void* pObject)
+  {
+    Type value;
+    pMember->GetValuePtr(pObject, &value);
+    return value;
+  }
 
-  for (ezAbstractProperty* pProp : properties)
+  template <typename Type>
+  EZ_ALWAYS_INLINE void SetMemberValue(ezAbstractMemberProperty* pMember, void* pObject, Type value)
   {
-    if (pProp->GetCategory() != ezPropertyCategory::Member)
-      continue;
+    pMember->SetValuePtr(pObject, &value);
+  }
 
-    ezAbstractMemberProperty* pMember = static_cast<ezAbstractMemberProperty*>(pProp);
+  template <typename Type>
+  EZ_ALWAYS_INLINE bool IsDefaultValue(const ezVariant& defaultValue, const Type& value)
+  {
+    return defaultValue.Get<Type>() == value;
+  }
 
-    const ezVariant value = ezTypeScriptBinding::GetVariantProperty(pDuk, pProp->GetPropertyName(), iObjIdx, pMember->GetSpecificType());
+  /// \brief Whether the generated TS class declares the property and initializes it to exactly this value.
+  ///
+  /// See GenerateConstructorString(). Vec4 has no TS type yet and matrices and transforms are always default constructed,
+  /// so their default value on the C++ side may differ from the one in TS.
+  bool IsDefaultValueInTs(const ezVariant& defaultValue)
+  {
+    switch (defaultValue.GetType())
+    {
+      case ezVariant::Type::Bool:
+      case ezVariant::Type::Int8:
+      case ezVariant::Type::UInt8:
+      case ezVariant::Type::Int16:
+      case ezVariant::Type::UInt16:
+      case ezVariant::Type::Int32:
+      case ezVariant::Type::UInt32:
+      case ezVariant::Type::Int64:
+      case ezVariant::Type::UInt64:
+      case ezVariant::Type::Float:
+      case ezVariant::Type::Double:
+      case ezVariant::Type::String:
+      case ezVariant::Type::StringView:
+      case ezVariant::Type::Color:
+      case ezVariant::Type::ColorGamma:
+      case ezVariant::Type::Vector2:
+      case ezVariant::Type::Vector3:
+      case ezVariant::Type::Vector2I:
+      case ezVariant::Type::Vector3I:
+      case ezVariant::Type::Vector2U:
+      case ezVariant::Type::Vector3U:
+      case ezVariant::Type::Quaternion:
+      case ezVariant::Type::Time:
+      case ezVariant::Type::Angle:
+        return true;
+
+      default:
+        return false;
+    }
+  }
 
-    if (value.IsValid())
+  void PluginEventHandler(const ezPluginEvent& e)
+  {
+    // the sync info stores pointers to properties, which are gone once the plugin that registered them is unloaded
+    if (e.m_EventType == ezPluginEvent::AfterUnloading)
     {
-      ezReflectionUtils::SetMemberPropertyValue(pMember, pObject, value);
+      ezTypeScriptBinding::ClearPropertySyncInfo();
     }
   }
+} // namespace
+
+// clang-format off
+EZ_BEGIN_SUBSYSTEM_DECLARATION(TypeScript, PropertySync)
+
+  BEGIN_SUBSYSTEM_DEPENDENCIES
+    "Foundation",
+    "Core"
+  END_SUBSYSTEM_DEPENDENCIES
+
+  ON_CORESYSTEMS_STARTUP
+  {
+    ezPlugin::s_PluginEvents.AddEventHandler(PluginEventHandler);
+  }
+
+  ON_CORESYSTEMS_SHUTDOWN
+  {
+    ezPlugin::s_PluginEvents.RemoveEventHandler(PluginEventHandler);
+    ezTypeScriptBinding::ClearPropertySyncInfo();
+  }
+
+EZ_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+void ezTypeScriptBinding::ClearPropertySyncInfo()
+{
+  EZ_LOCK(s_PropertySyncMutex);
+  s_PropertySyncInfo.Clear();
 }
 
-void ezTypeScriptBinding::SyncEzObjectToTsObject(duk_context* pDuk, const ezRTTI* pRtti, const void* pObject, ezInt32 iObjIdx)
+const ezDynamicArray<ezTypeScriptBinding::PropertySync>& ezTypeScriptBinding::GetPropertySyncInfo(const ezRTTI* pRtti)
 {
-  ezDuktapeHelper duk(pDuk);
+  EZ_LOCK(s_PropertySyncMutex);
+
+  bool bExisted = false;
+  auto it = s_PropertySyncInfo.FindOrAdd(pRtti, &bExisted);
+
+  if (bExisted)
+    return it.Value();
 
   ezHybridArray<ezAbstractProperty*, 32> properties;
   pRtti->GetAllProperties(properties);
@@ -326,23 +414,197 @@ void ezTypeScriptBinding::SyncEzObjectToTsObject(duk_context* pDuk, const ezRTTI
       continue;
 
     ezAbstractMemberProperty* pMember = static_cast<ezAbstractMemberProperty*>(pProp);
-
     const ezRTTI* pType = pMember->GetSpecificType();
 
-    if (pType->GetTypeFlags().IsAnySet(ezTypeFlags::IsEnum | ezTypeFlags::Bitflags))
-    {
-      const ezVariant val = ezReflectionUtils::GetMemberPropertyValue(pMember, pObject);
+    if (!pType->GetTypeFlags().IsAnySet(ezTypeFlags::IsEnum | ezTypeFlags::Bitflags) && pType->GetVariantType() == ezVariant::Type::Invalid)
+      continue;
 
-      SetVariantProperty(duk, pMember->GetPropertyName(), -1, val);
+    PropertySync& sync = it.Value().ExpandAndGetRef();
+    sync.m_pMember = pMember;
+    sync.m_DefaultValue = ezReflectionUtils::GetDefaultValue(pMember);
+
+    // the generated TS code initializes most members with the same default values (see GenerateMessagePropertiesCode())
+    sync.m_bTsHasDefaultValue = IsDefaultValueInTs(sync.m_DefaultValue);
+
+    if (pMember->GetFlags().IsAnySet(ezPropertyFlags::Pointer | ezPropertyFlags::IsEnum | ezPropertyFlags::Bitflags))
+      continue;
+
+    if (pType == ezGetStaticRTTI<bool>())
+      sync.m_Type = PropertySync::Type::Bool;
+    else if (pType == ezGetStaticRTTI<float>())
+      sync.m_Type = PropertySync::Type::Float;
+    else if (pType == ezGetStaticRTTI<ezVec3>())
+      sync.m_Type = PropertySync::Type::Vec3;
+    else if (pType == ezGetStaticRTTI<ezQuat>())
+      sync.m_Type = PropertySync::Type::Quat;
+    else if (pType == ezGetStaticRTTI<ezColor>())
+      sync.m_Type = PropertySync::Type::Color;
+  }
+
+  return it.Value();
+}
+
+void ezTypeScriptBinding::SyncTsObjectEzTsObject(duk_context* pDuk, const ezRTTI* pRtti, void* pObject, ezInt32 iObjIdx)
+{
+  ezDuktapeHelper duk(pDuk);
+
+  iObjIdx = duk_require_normalize_index(pDuk, iObjIdx);
+
+  for (const PropertySync& sync : GetPropertySyncInfo(pRtti))
+  {
+    ezAbstractMemberProperty* pMember = sync.m_pMember;
+
+    if (pMember->GetFlags().IsSet(ezPropertyFlags::ReadOnly))
+      continue;
+
+    if (!duk_get_prop_string(pDuk, iObjIdx, pMember->GetPropertyName())) // [ value ]
+    {
+      duk_pop(pDuk); // [ ]
+      continue;
     }
-    else
+
+    switch (sync.m_Type)
     {
-      if (pType->GetVariantType() == ezVariant::Type::Invalid)
-        continue;
+      case PropertySync::Type::Bool:
+      {
+        const bool value = duk.GetBoolValue(-1);
+        if (value != GetMemberValue<bool>(pMember, pObject))
+          SetMemberValue(pMember, pObject, value);
+        break;
+      }
+
+      case PropertySync::Type::Float:
+      {
+        const float value = duk.GetFloatValue(-1);
+        if (value != GetMemberValue<float>(pMember, pObject))
+          SetMemberValue(pMember, pObject, value);
+        break;
+      }
+
+      case PropertySync::Type::Vec3:
+      {
+        const ezVec3 value = GetVec3(pDuk, -1);
+        if (value != GetMemberValue<ezVec3>(pMember, pObject))
+          SetMemberValue(pMember, pObject, value);
+        break;
+      }
+
+      case PropertySync::Type::Quat:
+      {
+        const ezQuat value = GetQuat(pDuk, -1);
+        if (value != GetMemberValue<ezQuat>(pMember, pObject))
+          SetMemberValue(pMember, pObject, value);
+        break;
+      }
+
+      case PropertySync::Type::Color:
+      {
+        const ezColor value = GetColor(pDuk, -1);
+        if (value != GetMemberValue<ezColor>(pMember, pObject))
+          SetMemberValue(pMember, pObject, value);
+        break;
+      }
+
+      case PropertySync::Type::Variant:
+      {
+        const ezVariant value = GetVariant(pDuk, -1, pMember->GetSpecificType());
+        if (value.IsValid() && value != ezReflectionUtils::GetMemberPropertyValue(pMember, pObject))
+          ezReflectionUtils::SetMemberPropertyValue(pMember, pObject, value);
+        break;
+      }
+    }
 
-      const ezVariant val = ezReflectionUtils::GetMemberPropertyValue(pMember, pObject);
+    duk_pop(pDuk); // [ ]
+  }
+
+  EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, 0);
+}
 
-      SetVariantProperty(duk, pMember->GetPropertyName(), -1, val);
+void ezTypeScriptBinding::SyncEzObjectToTsObject(duk_context* pDuk, const ezRTTI* pRtti, const void* pObject, ezInt32 iObjIdx, bool bTsObjectIsDefault /*= false*/)
+{
+  ezDuktapeHelper duk(pDuk);
+
+  iObjIdx = duk_require_normalize_index(pDuk, iObjIdx);
+
+  for (const PropertySync& sync : GetPropertySyncInfo(pRtti))
+  {
+    const ezAbstractMemberProperty* pMember = sync.m_pMember;
+    const char* szName = pMember->GetPropertyName();
+
+    // when the TS object still has its default values, unchanged properties don't need to be transferred at all,
+    // and math types can be written into the existing TS objects, since they aren't shared with anyone yet
+    const bool bSkipDefault = bTsObjectIsDefault && sync.m_bTsHasDefaultValue;
+
+    switch (sync.m_Type)
+    {
+      case PropertySync::Type::Bool:
+      {
+        const bool value = GetMemberValue<bool>(pMember, pObject);
+        if (!bSkipDefault || !IsDefaultValue(sync.m_DefaultValue, value))
+          duk.SetBoolProperty(szName, value, iObjIdx);
+        break;
+      }
+
+      case PropertySync::Type::Float:
+      {
+        const float value = GetMemberValue<float>(pMember, pObject);
+        if (!bSkipDefault || !IsDefaultValue(sync.m_DefaultValue, value))
+          duk.SetNumberProperty(szName, value, iObjIdx);
+        break;
+      }
+
+      case PropertySync::Type::Vec3:
+      {
+        const ezVec3 value = GetMemberValue<ezVec3>(pMember, pObject);
+        if (!bSkipDefault)
+        {
+          PushVec3(pDuk, value);                      // [ value ]
+          duk_put_prop_string(pDuk, iObjIdx, szName); // [ ]
+        }
+        else if (!IsDefaultValue(sync.m_DefaultValue, value))
+        {
+          SetVec3Property(pDuk, szName, iObjIdx, value);
+        }
+        break;
+      }
+
+      case PropertySync::Type::Quat:
+      {
+        const ezQuat value = GetMemberValue<ezQuat>(pMember, pObject);
+        if (!bSkipDefault)
+        {
+          PushQuat(pDuk, value);                      // [ value ]
+          duk_put_prop_string(pDuk, iObjIdx, szName); // [ ]
+        }
+        else if (!IsDefaultValue(sync.m_DefaultValue, value))
+        {
+          SetQuatProperty(pDuk, szName, iObjIdx, value);
+        }
+        break;
+      }
+
+      case PropertySync::Type::Color:
+      {
+        const ezColor value = GetMemberValue<ezColor>(pMember, pObject);
+        if (!bSkipDefault)
+        {
+          PushColor(pDuk, value);                     // [ value ]
+          duk_put_prop_string(pDuk, iObjIdx, szName); // [ ]
+        }
+        else if (!IsDefaultValue(sync.m_DefaultValue, value))
+        {
+          SetColorProperty(pDuk, szName, iObjIdx, value);
+        }
+        break;
+      }
+
+      case PropertySync::Type::Variant:
+      {
+        const ezVariant value = ezReflectionUtils::GetMemberPropertyValue(pMember, pObject);
+        if (!bSkipDefault || value != sync.m_DefaultValue)
+          SetVariantProperty(pDuk, szName, iObjIdx, value);
+        break;
+      }
     }
   }
 
@@ -9,6 +9,7 @@
 #include <Foundation/Configuration/CVar.h>
 #include <Foundation/Containers/HashTable.h>
 #include <Foundation/Math/Declarations.h>
+#include <Foundation/Threading/Mutex.h>
 #include <Foundation/Types/Uuid.h>
 #include <GameEngine/Console/ConsoleFunction.h>
 #include <TypeScriptPlugin/Resources/ScriptCompendiumResource.h>
@@ -129,15 +130,51 @@ public:
 
   static const PropertyBinding* FindPropertyBinding(ezUInt32 uiHash);
 
-  static void SyncEzObjectToTsObject(duk_context* pDuk, const ezRTTI* pRtti, const void* pObject, ezInt32 iObjIdx);
+  /// \brief Copies the reflected member properties of pObject into the TS object at iObjIdx.
+  ///
+  /// If bTsObjectIsDefault is set, the TS object must have been constructed just now, so that all its properties still have their
+  /// default values. Properties that have their default value on the C++ side as well are skipped then, and math types are written
+  /// into the already existing TS objects, instead of allocating new ones.
+  static void SyncEzObjectToTsObject(duk_context* pDuk, const ezRTTI* pRtti, const void* pObject, ezInt32 iObjIdx, bool bTsObjectIsDefault = false);
+
+  /// \brief Copies the properties of the TS object at iObjIdx into the reflected member properties of pObject.
+  ///
+  /// Only properties whose value differs from the current value in pObject are written.
   static void SyncTsObjectEzTsObject(duk_context* pDuk, const ezRTTI* pRtti, void* pObject, ezInt32 iObjIdx);
 
+  /// \brief Discards the cached property sync info of all types. Done automatically whenever a plugin is unloaded.
+  static void ClearPropertySyncInfo();
+
 private:
   static ezUInt32 ComputePropertyBindingHash(const ezRTTI* pType, ezAbstractMemberProperty* pMember);
   static void SetupRttiPropertyBindings();
 
   static ezHashTable<ezUInt32, PropertyBinding> s_BoundProperties;
 
+  struct PropertySync
+  {
+    enum class Type : ezUInt8
+    {
+      Variant, ///< Goes through ezVariant, used for all types without a fast path.
+      Bool,
+      Float,
+      Vec3,
+      Quat,
+      Color,
+    };
+
+    ezAbstractMemberProperty* m_pMember = nullptr;
+    Type m_Type = Type::Variant;
+    bool m_bTsHasDefaultValue = false; ///< Whether the generated TS class initializes the property to m_DefaultValue.
+    ezVariant m_DefaultValue;
+  };
+
+  /// \brief Returns the properties of the given type that are synchronized with TS, computed only once per type.
+  static const ezDynamicArray<PropertySync>& GetPropertySyncInfo(const ezRTTI* pRtti);
+
+  static ezMutex s_PropertySyncMutex;
+  static ezMap<const ezRTTI*, ezDynamicArray<PropertySync>> s_PropertySyncInfo;
+
   ///@}
   /// \name Message Binding
   ///@{
@@ -624,7 +624,7 @@ static int __CPP_GameObject_SendMessage(duk_context* pDuk)
     if (duk.GetBoolValue(4)) // expect the message to have result values
     {
       // sync msg back to TS
-      ezTypeScriptBinding::SyncEzObjectToTsObject(pDuk, pMsg->GetDynamicRTTI(), pMsg.Borrow(), 1);
+      ezTypeScriptBinding::SyncEzObjectToTsObject(pDuk, pMsg->GetDynamicRTTI(), pMsg.Borrow(), 2);
     }
   }
   else // PostMessage
@@ -275,7 +275,7 @@ void ezTypeScriptBinding::DukPutMessage(duk_context* pDuk, const ezMessage& msg)
   duk_remove(duk, -2);                              // [ global msg ]
   duk_remove(duk, -2);                              // [ msg ]
 
-  SyncEzObjectToTsObject(pDuk, pRtti, &msg, -1);
+  SyncEzObjectToTsObject(pDuk, pRtti, &msg, -1, true);
 
   EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, +1);
 }
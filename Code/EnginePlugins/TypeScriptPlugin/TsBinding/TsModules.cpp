@@ -116,7 +116,8 @@ int ezTypeScriptBinding::DukSearchModule(duk_context* pDuk)
     EZ_DUK_RETURN_AND_VERIFY_STACK(duk, duk.ReturnCustom(), +1);
   }
 
-  auto it = pCompendium->GetDescriptor().m_PathToSource.Find(sRequestedFile);
+  const auto& desc = pCompendium->GetDescriptor();
+  auto it = desc.m_PathToSource.Find(sRequestedFile);
 
   if (!it.IsValid())
   {
@@ -125,5 +126,48 @@ int ezTypeScriptBinding::DukSearchModule(duk_context* pDuk)
     EZ_DUK_RETURN_AND_VERIFY_STACK(duk, duk.ReturnCustom(), +1);
   }
 
+  auto itBytecode = desc.m_PathToBytecode.Find(sRequestedFile);
+  if (itBytecode.IsValid() && itBytecode.Value().m_uiBytecodeVersion == ezDuktapeHelper::GetBytecodeVersion() &&
+      itBytecode.Value().m_uiSourceHash == ezHashingUtils::xxHash64(it.Value().GetData(), it.Value().GetElementCount()))
+  {
+    // the module was precompiled, so instead of returning the source for Duktape to compile, run the module function directly
+    // and return nothing, which tells Duktape that the module has already filled out its exports
+    const ezDynamicArray<ezUInt8>& bytecode = itBytecode.Value().m_Bytecode;
+
+    void* pBuffer = duk_push_fixed_buffer(pDuk, bytecode.GetCount()); // [ buffer ]
+    ezMemoryUtils::Copy(static_cast<ezUInt8*>(pBuffer), bytecode.GetData(), bytecode.GetCount());
+    duk_load_function(pDuk); // [ program ]
+
+    if (duk_pcall(pDuk, 0) != DUK_EXEC_SUCCESS) // [ modfunc/error ]
+    {
+      duk_throw(pDuk);
+    }
+
+    // duk_module_duktape names the module function after module.name or the last component of the module ID, which shows up in stack traces
+    duk_push_string(pDuk, "name");             // [ modfunc "name" ]
+    if (!duk_get_prop_string(pDuk, 3, "name")) // [ modfunc "name" name/undefined ]
+    {
+      duk_pop(pDuk); // [ modfunc "name" ]
+
+      const char* szModuleID = duk_get_string(pDuk, 0);
+      const char* szLastComponent = ezStringUtils::FindLastSubString(szModuleID, "/");
+      duk_push_string(pDuk, szLastComponent != nullptr ? szLastComponent + 1 : szModuleID); // [ modfunc "name" name ]
+    }
+    duk_def_prop(pDuk, -3, DUK_DEFPROP_HAVE_VALUE | DUK_DEFPROP_FORCE); // [ modfunc ]
+
+    duk_dup(pDuk, 2);                        // [ modfunc exports ]
+    duk_dup(pDuk, 1);                        // [ modfunc exports require ]
+    duk_get_prop_string(pDuk, 3, "exports"); // [ modfunc exports require module.exports ]
+    duk_dup(pDuk, 3);                        // [ modfunc exports require module.exports module ]
+
+    if (duk_pcall_method(pDuk, 3) != DUK_EXEC_SUCCESS) // [ result/error ]
+    {
+      duk_throw(pDuk);
+    }
+
+    duk_pop(pDuk); // [ ]
+    EZ_DUK_RETURN_AND_VERIFY_STACK(duk, duk.ReturnVoid(), 0);
+  }
+
   EZ_DUK_RETURN_AND_VERIFY_STACK(duk, duk.ReturnString(it.Value()), +1);
 }
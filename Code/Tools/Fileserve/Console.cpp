@@ -87,6 +87,14 @@ void ezFileserverApp::FileserverEventHandlerConsole(const ezFileserverEvent& e)
       ezLog::Info("Upload finished: {0}", e.m_szPath);
       break;
 
+    case ezFileserverEvent::Type::PrefetchRequest:
+      ezLog::Info("Prefetch request: {0} files", e.m_uiSizeTotal);
+      break;
+
+    case ezFileserverEvent::Type::PrefetchFinished:
+      ezLog::Info("Prefetch done: {0} bytes sent", e.m_uiSentTotal);
+      break;
+
     default:
       break;
   }
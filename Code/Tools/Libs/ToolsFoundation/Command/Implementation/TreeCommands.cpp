@@ -260,10 +260,11 @@ ezStatus ezPasteObjectsCommand::DoInternal(bool bRedo)
 
     ezHybridArray<ezDocument::PasteInfo, 16> ToBePasted;
 
-    auto& nodes = graph.GetAllNodes();
-    for (auto it = nodes.GetIterator(); it.IsValid(); ++it)
+    // the objects are pasted in this order, so it has to be stable
+    ezDynamicArray<const ezAbstractObjectNode*> nodes;
+    graph.GetAllNodesSortedByGuid(nodes);
+    for (auto* pNode : nodes)
     {
-      auto* pNode = it.Value();
       if (ezStringUtils::IsEqual(pNode->GetNodeName(), "root"))
       {
         auto* pNewObject = reader.CreateObjectFromNode(pNode);
@@ -266,16 +266,17 @@ void ezDocumentNodeManager::MoveNode(const ezDocumentObject* pObject, const ezVe
 
 void ezDocumentNodeManager::AttachMetaDataBeforeSaving(ezAbstractObjectGraph& graph) const
 {
-  auto& AllNodes = graph.GetAllNodes();
+  // the connections are added as sub-objects, so the node table may grow while the nodes are processed
+  ezDynamicArray<ezAbstractObjectNode*> AllNodes;
+  graph.GetAllNodesSortedByGuid(AllNodes);
 
   auto pType = ezGetStaticRTTI<DOcumentNodeManagerNodeDataInternal>();
   DOcumentNodeManagerNodeDataInternal data;
   ezRttiConverterContext context;
   ezRttiConverterWriter rttiConverter(&graph, &context, true, true);
 
-  for (auto it = AllNodes.GetIterator(); it.IsValid(); ++it)
+  for (auto* pNode : AllNodes)
   {
-    auto* pNode = it.Value();
     const ezUuid& guid = pNode->GetGuid();
 
     auto it2 = m_ObjectToNode.Find(guid);
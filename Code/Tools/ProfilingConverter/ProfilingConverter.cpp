@@ -0,0 +1,178 @@
+#include <Foundation/Application/Application.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Logging/ConsoleWriter.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Logging/VisualStudioWriter.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Utilities/CommandLineUtils.h>
+
+/* ezProfilingConverter command line options:
+
+Converts captures that were written with ezProfilingSystem::StartStreamingCapture() into the JSON trace event format,
+which can be opened in chrome://tracing or other trace viewers.
+
+"path/to/capture" "path/to/another/capture" ...
+-out "path/to/file.json"
+
+Multiple captures, e.g. of different processes, are merged into one JSON file.
+
+If no -out is specified, the output is written next to the first input file, with the file extension 'json'.
+
+Example:
+
+ezProfilingConverter.exe "C:\Capture.ezProfiling"
+  will convert the capture into "C:\Capture.json"
+
+*/
+
+class ezProfilingConverter : public ezApplication
+{
+public:
+  typedef ezApplication SUPER;
+
+  ezDynamicArray<ezString> m_sInputs;
+  ezString m_sOutput;
+
+  ezProfilingConverter()
+    : ezApplication("ProfilingConverter")
+  {
+  }
+
+  ezResult ParseArguments()
+  {
+    if (GetArgumentCount() <= 1)
+    {
+      ezLog::Error("No arguments given");
+      return EZ_FAILURE;
+    }
+
+    ezCommandLineUtils& cmd = *ezCommandLineUtils::GetGlobalInstance();
+
+    m_sOutput = cmd.GetStringOption("-out");
+
+    for (ezUInt32 a = 1; a < GetArgumentCount(); ++a)
+    {
+      const char* szArg = GetArgument(a);
+
+      if (ezStringUtils::IsEqual_NoCase(szArg, "-out"))
+      {
+        // skip the output path
+        ++a;
+        continue;
+      }
+
+      m_sInputs.PushBack(ezOSFile::MakePathAbsoluteWithCWD(szArg));
+
+      if (!ezOSFile::ExistsFile(m_sInputs.PeekBack()))
+      {
+        ezLog::Error("Input file does not exist: '{}'", m_sInputs.PeekBack());
+        return EZ_FAILURE;
+      }
+    }
+
+    if (m_sInputs.IsEmpty())
+    {
+      ezLog::Error("No input files given");
+      return EZ_FAILURE;
+    }
+
+    if (m_sOutput.IsEmpty())
+    {
+      ezStringBuilder sOutput = m_sInputs[0];
+      sOutput.ChangeFileExtension("json");
+      m_sOutput = sOutput;
+    }
+
+    m_sOutput = ezOSFile::MakePathAbsoluteWithCWD(m_sOutput);
+
+    ezLog::Info("Inputs:");
+
+    for (const auto& input : m_sInputs)
+    {
+      ezLog::Info("  '{}'", input);
+    }
+
+    ezLog::Info("Output: '{}'", m_sOutput);
+
+    return EZ_SUCCESS;
+  }
+
+  virtual void AfterCoreSystemsStartup() override
+  {
+    // Add the empty data directory to access files via absolute paths
+    ezFileSystem::AddDataDirectory("", "App", ":", ezFileSystem::AllowWrites);
+
+    ezGlobalLog::AddLogWriter(ezLogWriter::Console::LogMessageHandler);
+    ezGlobalLog::AddLogWriter(ezLogWriter::VisualStudio::LogMessageHandler);
+  }
+
+  virtual void BeforeCoreSystemsShutdown() override
+  {
+    // prevent further output during shutdown
+    ezGlobalLog::RemoveLogWriter(ezLogWriter::Console::LogMessageHandler);
+    ezGlobalLog::RemoveLogWriter(ezLogWriter::VisualStudio::LogMessageHandler);
+
+    SUPER::BeforeCoreSystemsShutdown();
+  }
+
+  ezResult Convert()
+  {
+    ezDynamicArray<ezProfilingSystem::ProfilingData> captures;
+    captures.SetCount(m_sInputs.GetCount());
+
+    ezHybridArray<const ezProfilingSystem::ProfilingData*, 8> captureRefs;
+
+    for (ezUInt32 i = 0; i < m_sInputs.GetCount(); ++i)
+    {
+      ezFileReader file;
+      if (file.Open(m_sInputs[i]).Failed())
+      {
+        ezLog::Error("Failed to open '{}'", m_sInputs[i]);
+        return EZ_FAILURE;
+      }
+
+      if (ezProfilingSystem::ReadStreamingCapture(file, captures[i]).Failed())
+      {
+        ezLog::Error("Failed to read the capture '{}'", m_sInputs[i]);
+        return EZ_FAILURE;
+      }
+
+      captureRefs.PushBack(&captures[i]);
+    }
+
+    ezProfilingSystem::ProfilingData merged;
+    ezProfilingSystem::ProfilingData::Merge(merged, captureRefs);
+
+    ezFileWriter file;
+    if (file.Open(m_sOutput).Failed())
+    {
+      ezLog::Error("Failed to open '{}' for writing", m_sOutput);
+      return EZ_FAILURE;
+    }
+
+    return merged.Write(file);
+  }
+
+  virtual ApplicationExecution Run() override
+  {
+    if (ParseArguments().Failed())
+    {
+      SetReturnCode(1);
+      return ezApplication::Quit;
+    }
+
+    if (Convert().Failed())
+    {
+      ezLog::Error("Converting the captures failed");
+      SetReturnCode(2);
+    }
+
+    return ezApplication::Quit;
+  }
+};
+
+EZ_CONSOLEAPP_ENTRY_POINT(ezProfilingConverter);
@@ -129,6 +129,93 @@ namespace
   EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(TestResource, 1, ezRTTIDefaultAllocator<TestResource>)
   EZ_END_DYNAMIC_REFLECTED_TYPE;
 
+  typedef ezTypedResourceHandle<class QualityLevelResource> QualityLevelResourceHandle;
+
+  /// Every quality level takes exactly 1000 bytes, the first load brings in all of them, every further load one more.
+  class QualityLevelResource : public ezResource
+  {
+    EZ_ADD_DYNAMIC_REFLECTION(QualityLevelResource, ezResource);
+    EZ_RESOURCE_DECLARE_COMMON_CODE(QualityLevelResource);
+
+  public:
+    static constexpr ezUInt8 s_uiMaxLevels = 4;
+    static constexpr ezUInt64 s_uiLevelMemory = 1000;
+
+    QualityLevelResource()
+      : ezResource(ezResource::DoUpdate::OnAnyThread, 1)
+    {
+    }
+
+    ezUInt8 GetNumLevels() const { return m_uiNumLevels; }
+
+  protected:
+    ezResourceLoadDesc GetLoadDesc() const
+    {
+      ezResourceLoadDesc ld;
+      ld.m_State = m_uiNumLevels > 0 ? ezResourceState::Loaded : ezResourceState::Unloaded;
+      ld.m_uiQualityLevelsDiscardable = m_uiNumLevels > 0 ? m_uiNumLevels - 1 : 0;
+      ld.m_uiQualityLevelsLoadable = s_uiMaxLevels - m_uiNumLevels;
+      return ld;
+    }
+
+    virtual ezResourceLoadDesc UnloadData(Unload WhatToUnload) override
+    {
+      if (WhatToUnload == Unload::AllQualityLevels)
+        m_uiNumLevels = 0;
+      else if (m_uiNumLevels > 1)
+        --m_uiNumLevels;
+
+      return GetLoadDesc();
+    }
+
+    virtual ezResourceLoadDesc UpdateContent(ezStreamReader* Stream) override
+    {
+      m_uiNumLevels = m_uiNumLevels == 0 ? s_uiMaxLevels : ezMath::Min<ezUInt8>(m_uiNumLevels + 1, s_uiMaxLevels);
+      return GetLoadDesc();
+    }
+
+    virtual void UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage) override
+    {
+      out_NewMemoryUsage.m_uiMemoryCPU = m_uiNumLevels * s_uiLevelMemory;
+      out_NewMemoryUsage.m_uiMemoryGPU = 0;
+    }
+
+  private:
+    ezUInt8 m_uiNumLevels = 0;
+  };
+
+  EZ_RESOURCE_IMPLEMENT_COMMON_CODE(QualityLevelResource);
+  EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(QualityLevelResource, 1, ezRTTIDefaultAllocator<QualityLevelResource>)
+  EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+  ezTime g_FrameTime;
+
+  void NextFrame()
+  {
+    // the acquire time stamps are taken from the frame update, every frame gets its own time stamp
+    g_FrameTime += ezTime::Milliseconds(100);
+    ezResourceManager::PerFrameUpdate(g_FrameTime);
+  }
+
+  void WaitForLoading()
+  {
+    while (ezResourceManager::IsAnyLoadingInProgress())
+    {
+      ezThreadUtils::Sleep(ezTime::Milliseconds(10));
+    }
+  }
+
+  void Acquire(const QualityLevelResourceHandle& hResource)
+  {
+    ezResourceLock<QualityLevelResource> pResource(hResource, ezResourceAcquireMode::BlockTillLoaded);
+  }
+
+  ezUInt8 GetNumLevels(const QualityLevelResourceHandle& hResource)
+  {
+    ezResourceLock<QualityLevelResource> pResource(hResource, ezResourceAcquireMode::PointerOnly);
+    return pResource->GetNumLevels();
+  }
+
 } // namespace
 
 EZ_CREATE_SIMPLE_TEST(ResourceManager, Basics)
@@ -289,3 +376,131 @@ EZ_CREATE_SIMPLE_TEST(ResourceManager, NestedLoading)
     EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), 0);
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(ResourceManager, MemoryBudgets)
+{
+  TestResourceTypeLoader TypeLoader;
+  ezResourceManager::SetResourceTypeLoader<QualityLevelResource>(&TypeLoader);
+  EZ_SCOPE_EXIT(ezResourceManager::SetResourceTypeLoader<QualityLevelResource>(nullptr));
+  EZ_SCOPE_EXIT(ezResourceManager::SetMemoryBudgetForResourceType<QualityLevelResource>(0, 0));
+
+  const ezRTTI* pType = ezGetStaticRTTI<QualityLevelResource>();
+  g_FrameTime = ezTime::Now();
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Discard and Reload")
+  {
+    QualityLevelResourceHandle hResources[4];
+
+    ezStringBuilder sResourceID;
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(hResources); ++i)
+    {
+      sResourceID.Format("QualityLevels-{}", i);
+      hResources[i] = ezResourceManager::LoadResource<QualityLevelResource>(sResourceID);
+
+      // resource 0 is acquired first and thus least recently
+      NextFrame();
+      Acquire(hResources[i]);
+      EZ_TEST_INT(GetNumLevels(hResources[i]), QualityLevelResource::s_uiMaxLevels);
+    }
+
+    // resource 1 is the least important one, no matter when it was acquired
+    {
+      ezResourceLock<QualityLevelResource> pResource(hResources[1], ezResourceAcquireMode::PointerOnly);
+      pResource->SetPriority(ezResourcePriority::VeryLow);
+    }
+
+    ezResourceManager::SetMemoryBudgetForResourceType<QualityLevelResource>(12000, 0);
+    NextFrame();
+
+    // 4000 bytes over budget: all discardable levels of resource 1 go first, then one level of resource 0
+    ezResourceManager::MemoryBudgetStats stats = ezResourceManager::GetMemoryBudgetStats(pType);
+    EZ_TEST_INT(stats.m_uiQualityLevelsDiscarded, 4);
+    EZ_TEST_INT(stats.m_uiMemoryCPU, 12000);
+    EZ_TEST_BOOL(!stats.IsOverBudget());
+    EZ_TEST_INT(GetNumLevels(hResources[0]), 3);
+    EZ_TEST_INT(GetNumLevels(hResources[1]), 1);
+    EZ_TEST_INT(GetNumLevels(hResources[2]), 4);
+    EZ_TEST_INT(GetNumLevels(hResources[3]), 4);
+
+    // the global stats include every resource type, even without a global budget
+    EZ_TEST_BOOL(ezResourceManager::GetMemoryBudgetStats().m_uiMemoryCPU >= 12000);
+    EZ_TEST_INT(ezResourceManager::GetMemoryBudgetStats().m_uiQualityLevelsDiscarded, 4);
+
+    // acquiring a reduced resource does not load its discarded levels again, as long as there is no room in the budget
+    Acquire(hResources[0]);
+    NextFrame();
+    Acquire(hResources[0]);
+    WaitForLoading();
+
+    stats = ezResourceManager::GetMemoryBudgetStats(pType);
+    EZ_TEST_INT(stats.m_uiQualityLevelsDiscarded, 0);
+    EZ_TEST_INT(stats.m_uiQualityLevelsRequested, 0);
+    EZ_TEST_INT(GetNumLevels(hResources[0]), 3);
+
+    // with more room, only the resource that is still in use gets a level back
+    ezResourceManager::SetMemoryBudgetForResourceType<QualityLevelResource>(14000, 0);
+    NextFrame();
+    WaitForLoading();
+
+    EZ_TEST_INT(ezResourceManager::GetMemoryBudgetStats(pType).m_uiQualityLevelsRequested, 1);
+    EZ_TEST_INT(GetNumLevels(hResources[0]), 4);
+    EZ_TEST_INT(GetNumLevels(hResources[1]), 1);
+
+    // once resource 1 is used again, it gets levels back until the budget is full
+    NextFrame();
+    Acquire(hResources[1]);
+
+    ezUInt32 uiRequested = 0;
+    for (ezUInt32 i = 0; i < 4; ++i)
+    {
+      NextFrame();
+      WaitForLoading();
+      uiRequested += ezResourceManager::GetMemoryBudgetStats(pType).m_uiQualityLevelsRequested;
+    }
+
+    EZ_TEST_INT(uiRequested, 1);
+    EZ_TEST_INT(GetNumLevels(hResources[1]), 2);
+    EZ_TEST_INT(ezResourceManager::GetMemoryBudgetStats(pType).m_uiMemoryCPU, 14000);
+
+    // without a budget, the resources go back to loading all their levels on acquire
+    ezResourceManager::SetMemoryBudgetForResourceType<QualityLevelResource>(0, 0);
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      Acquire(hResources[1]);
+      WaitForLoading();
+    }
+
+    EZ_TEST_INT(GetNumLevels(hResources[1]), QualityLevelResource::s_uiMaxLevels);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Locked Resources")
+  {
+    ezResourceManager::FreeAllUnusedResources();
+
+    QualityLevelResourceHandle hResource = ezResourceManager::LoadResource<QualityLevelResource>("QualityLevels-Locked");
+    NextFrame();
+    Acquire(hResource);
+    EZ_TEST_INT(GetNumLevels(hResource), QualityLevelResource::s_uiMaxLevels);
+
+    {
+      // a resource that is in use keeps its quality levels, even when the budget is exceeded
+      ezResourceLock<QualityLevelResource> pResource(hResource, ezResourceAcquireMode::PointerOnly);
+
+      ezResourceManager::SetMemoryBudgetForResourceType<QualityLevelResource>(1000, 0);
+      NextFrame();
+
+      EZ_TEST_INT(ezResourceManager::GetMemoryBudgetStats(pType).m_uiQualityLevelsDiscarded, 0);
+      EZ_TEST_INT(pResource->GetNumLevels(), QualityLevelResource::s_uiMaxLevels);
+    }
+
+    NextFrame();
+
+    EZ_TEST_INT(ezResourceManager::GetMemoryBudgetStats(pType).m_uiQualityLevelsDiscarded, 3);
+    EZ_TEST_INT(GetNumLevels(hResource), 1);
+
+    ezResourceManager::SetMemoryBudgetForResourceType<QualityLevelResource>(0, 0);
+  }
+
+  ezResourceManager::FreeAllUnusedResources();
+  EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<QualityLevelResource>()->GetCount(), 0);
+}
@@ -136,6 +136,76 @@ EZ_CREATE_SIMPLE_TEST(Scripting, DuktapeWrapper)
     EZ_TEST_BOOL(duk.ExecuteString("Print(\"do stuff\")").Failed());
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Bytecode")
+  {
+    ezDynamicArray<ezUInt8> bytecode;
+
+    {
+      ezDuktapeContext duk("DukTest");
+      EZ_TEST_RESULT(duk.CompileStringToBytecode("function Square(x) { return x * x; } var result = Square(7);", bytecode));
+      EZ_TEST_BOOL(!bytecode.IsEmpty());
+
+      // compiling must not execute anything
+      duk_eval_string(duk.GetContext(), "typeof Square");
+      EZ_TEST_STRING(duk_get_string(duk.GetContext(), -1), "undefined");
+      duk_pop(duk.GetContext());
+    }
+
+    // the bytecode does not depend on the context that compiled it
+    ezDuktapeContext duk("DukTest");
+    EZ_TEST_RESULT(duk.ExecuteBytecode(bytecode));
+
+    duk_eval_string(duk.GetContext(), "result + Square(2)");
+    EZ_TEST_INT(duk_get_int(duk.GetContext(), -1), 53);
+    duk_pop(duk.GetContext());
+
+    EZ_TEST_BOOL(ezDuktapeHelper::GetBytecodeVersion() != 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Bytecode (eval)")
+  {
+    ezDuktapeContext duk("DukTest");
+
+    ezDynamicArray<ezUInt8> bytecode;
+    EZ_TEST_RESULT(duk.CompileStringToBytecode("var programVar = 1;", bytecode));
+    EZ_TEST_RESULT(duk.ExecuteBytecode(bytecode));
+
+    EZ_TEST_RESULT(duk.CompileStringToBytecode("var evalVar = 1;", bytecode, "eval", true));
+    EZ_TEST_RESULT(duk.ExecuteBytecode(bytecode));
+
+    // variables declared by eval code can be deleted, the ones declared by a program can't
+    duk_eval_string(duk.GetContext(), "(delete evalVar) && !(delete programVar)");
+    EZ_TEST_BOOL(duk_get_boolean(duk.GetContext(), -1));
+    duk_pop(duk.GetContext());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Bytecode (error)")
+  {
+    ezDuktapeContext duk("DukTest");
+
+    ezTestLogInterface log;
+    ezTestLogSystemScope logSystemScope(&log);
+
+    ezDynamicArray<ezUInt8> bytecode;
+
+    log.ExpectMessage("SyntaxError: parse error (line 1)", ezLogMsgType::ErrorMsg);
+    EZ_TEST_BOOL(duk.CompileStringToBytecode(" == invalid code == ", bytecode).Failed());
+
+    EZ_TEST_RESULT(duk.CompileStringToBytecode("var result = 42;", bytecode));
+    bytecode[0] = ~bytecode[0];
+
+    log.ExpectMessage("TypeError: invalid bytecode", ezLogMsgType::ErrorMsg, 2);
+    EZ_TEST_BOOL(duk.ExecuteBytecode(bytecode).Failed());
+    EZ_TEST_BOOL(duk.ExecuteBytecode(ezArrayPtr<const ezUInt8>()).Failed());
+
+    log.ExpectMessage("Error: thrown from bytecode", ezLogMsgType::ErrorMsg);
+    EZ_TEST_RESULT(duk.CompileStringToBytecode("throw new Error('thrown from bytecode');", bytecode));
+    EZ_TEST_BOOL(duk.ExecuteBytecode(bytecode).Failed());
+
+    // a failed load or execution must leave the stack balanced
+    EZ_TEST_INT(duk_get_top(duk.GetContext()), 0);
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "ExecuteFile")
   {
     ezDuktapeContext duk("DukTest");
@@ -5,6 +5,7 @@
 #include <EditorFramework/Assets/AssetCurator.h>
 #include <ToolsFoundation/Object/ObjectAccessorBase.h>
 #include <EditorFramework/Assets/AssetDocument.h>
+#include <Foundation/Threading/DelegateTask.h>
 
 static ezEditorAssetDocumentTest s_GameEngineTestBasics;
 
@@ -17,6 +18,7 @@ void ezEditorAssetDocumentTest::SetupSubTests()
 {
   AddSubTest("Async Save", SubTests::ST_AsyncSave);
   AddSubTest("Save on Transform", SubTests::ST_SaveOnTransform);
+  AddSubTest("Hash Tracked Files", SubTests::ST_HashTrackedFiles);
 }
 
 ezResult ezEditorAssetDocumentTest::InitializeTest()
@@ -48,6 +50,9 @@ ezTestAppRun ezEditorAssetDocumentTest::RunSubTest(ezInt32 iIdentifier, ezUInt32
     case SubTests::ST_SaveOnTransform:
       SaveOnTransform();
       break;
+    case SubTests::ST_HashTrackedFiles:
+      HashTrackedFiles();
+      break;
   }
   return ezTestAppRun::Quit;
 }
@@ -153,3 +158,53 @@ void ezEditorAssetDocumentTest::SaveOnTransform()
   }
   pDoc->GetDocumentManager()->CloseDocument(pDoc);
 }
+
+void ezEditorAssetDocumentTest::HashTrackedFiles()
+{
+  ezAssetCurator* pCurator = ezAssetCurator::GetSingleton();
+  ezUuid assetGuid;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Create Document")
+  {
+    ezStringBuilder sName = m_sProjectPath;
+    sName.AppendPath("mesh3.ezMeshAsset");
+    ezAssetDocument* pDoc = static_cast<ezAssetDocument*>(m_pApplication->m_pEditorApp->CreateDocument(sName, ezDocumentFlags::None));
+    if (EZ_TEST_BOOL(pDoc != nullptr).Failed())
+      return;
+
+    ezObjectAccessorBase* pAcc = pDoc->GetObjectAccessor();
+    ezDocumentObject* pMeshAsset = pDoc->GetObjectManager()->GetRootObject()->GetChildren()[0];
+    pAcc->StartTransaction("Edit Mesh");
+    EZ_TEST_BOOL(pAcc->SetValue(pMeshAsset, "MeshFile", "Meshes/Cube.obj").Succeeded());
+    pAcc->FinishTransaction();
+
+    EZ_TEST_BOOL(pDoc->SaveDocument().Succeeded());
+    assetGuid = pDoc->GetGuid();
+    pDoc->GetDocumentManager()->CloseDocument(pDoc);
+    ProcessEvents();
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Check File System")
+  {
+    const ezUInt64 uiHash = pCurator->GetAssetDependencyHash(assetGuid);
+    EZ_TEST_BOOL(uiHash != 0);
+
+    // the tracked files are hashed without holding the curator lock, so the curator stays responsive in the meantime
+    ezSharedPtr<ezDelegateTask<void>> pTask = EZ_DEFAULT_NEW(ezDelegateTask<void>, "CheckFileSystem", [pCurator]() { pCurator->CheckFileSystem(); });
+    ezTaskGroupID id = ezTaskSystem::StartSingleTask(pTask, ezTaskPriority::LongRunning);
+
+    while (!ezTaskSystem::IsTaskGroupFinished(id))
+    {
+      pCurator->GetAssetDependencyHash(assetGuid);
+    }
+
+    ezTaskSystem::WaitForGroup(id);
+
+    // the hashes that were computed in parallel have to match a full recomputation
+    ezUInt64 uiAssetHash = 0;
+    ezUInt64 uiThumbHash = 0;
+    pCurator->IsAssetUpToDate(assetGuid, nullptr, nullptr, uiAssetHash, uiThumbHash, true);
+    EZ_TEST_BOOL(uiAssetHash == uiHash);
+    EZ_TEST_BOOL(pCurator->GetAssetDependencyHash(assetGuid) == uiHash);
+  }
+}
@@ -0,0 +1,298 @@
+#include <FileservePluginTestPCH.h>
+
+#include <FileservePlugin/Client/FileserveClient.h>
+#include <FileservePlugin/Client/FileserveDataDir.h>
+#include <FileservePlugin/Fileserver/Fileserver.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Threading/ThreadUtils.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <Foundation/Time/Timestamp.h>
+#include <TestFramework/Utilities/TestLogInterface.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Fileserve);
+
+namespace
+{
+  constexpr ezUInt32 s_uiNumFiles = 200;
+  constexpr ezUInt16 s_uiPort = 1043;
+
+  /// The client blocks while it waits for answers, so the server needs its own thread.
+  class ServerThread : public ezThread
+  {
+  public:
+    ezAtomicBool m_bStop;
+    ezAtomicBool m_bPause;
+    ezAtomicBool m_bIsPaused;
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      while (!m_bStop)
+      {
+        if (m_bPause)
+        {
+          // simulates a server that is stuck, it catches up with all requests afterwards
+          m_bIsPaused = true;
+          ezThreadUtils::Sleep(ezTime::Seconds(1));
+          m_bIsPaused = false;
+          m_bPause = false;
+        }
+
+        if (!ezFileserver::GetSingleton()->UpdateServer())
+        {
+          ezThreadUtils::YieldTimeSlice();
+        }
+      }
+
+      return 0;
+    }
+  };
+
+  void WriteServerFile(const char* szServerDir, ezUInt32 uiFile, const char* szVersion)
+  {
+    ezStringBuilder sPath, sLine, sContent;
+    sPath.Format("{0}/File{1}.txt", szServerDir, uiFile);
+
+    sLine.Format("File {0}, version {1}\n", uiFile, szVersion);
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      sContent.Append(sLine.GetData());
+    }
+
+    ezOSFile file;
+    if (file.Open(sPath, ezFileOpenMode::Write).Succeeded())
+    {
+      file.Write(sContent.GetData(), sContent.GetElementCount());
+    }
+  }
+
+  /// The server detects changes through the modification time, which has a resolution of one second on some platforms.
+  void ChangeServerFile(const char* szServerDir, ezUInt32 uiFile, const char* szVersion)
+  {
+    const ezInt64 iStartSecond = ezTimestamp::CurrentTimestamp().GetInt64(ezSIUnitOfTime::Second);
+
+    while (ezTimestamp::CurrentTimestamp().GetInt64(ezSIUnitOfTime::Second) <= iStartSecond)
+    {
+      ezThreadUtils::Sleep(ezTime::Milliseconds(50));
+    }
+
+    WriteServerFile(szServerDir, uiFile, szVersion);
+  }
+
+  void CheckClientFile(ezUInt32 uiFile, const char* szVersion)
+  {
+    ezStringBuilder sPath, sLine;
+    sPath.Format(":fileserve/File{0}.txt", uiFile);
+    sLine.Format("File {0}, version {1}\n", uiFile, szVersion);
+
+    ezFileReader file;
+    if (EZ_TEST_BOOL_MSG(file.Open(sPath).Succeeded(), "Could not read '%s'", sPath.GetData()).Failed())
+      return;
+
+    ezStringBuilder sContent;
+    sContent.ReadAll(file);
+
+    EZ_TEST_INT(sContent.GetElementCount(), sLine.GetElementCount() * 100);
+    EZ_TEST_BOOL(sContent.StartsWith(sLine));
+  }
+
+  struct ServerStats
+  {
+    ezAtomicInteger32 m_iMounts;
+    ezAtomicInteger32 m_iFileRequests;
+    ezAtomicInteger32 m_iPrefetchRequests;
+
+    void Reset()
+    {
+      m_iMounts = 0;
+      m_iFileRequests = 0;
+      m_iPrefetchRequests = 0;
+    }
+
+    void FileserverEventHandler(const ezFileserverEvent& e)
+    {
+      switch (e.m_Type)
+      {
+        case ezFileserverEvent::Type::MountDataDir:
+          m_iMounts.Increment();
+          break;
+
+        // prefetched files are reported as file requests as well
+        case ezFileserverEvent::Type::FileDownloadRequest:
+          if (ezStringUtils::StartsWith(e.m_szPath, "File"))
+            m_iFileRequests.Increment();
+          break;
+
+        case ezFileserverEvent::Type::PrefetchRequest:
+          m_iPrefetchRequests.Increment();
+          break;
+
+        default:
+          break;
+      }
+    }
+  };
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Fileserve, Prefetch)
+{
+  ezStringBuilder sServerDir = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sServerDir.AppendPath("FileserveServer");
+
+  if (EZ_TEST_BOOL(ezOSFile::CreateDirectoryStructure(sServerDir).Succeeded()).Failed())
+    return;
+
+  for (ezUInt32 i = 0; i < s_uiNumFiles; ++i)
+  {
+    WriteServerFile(sServerDir, i, "A");
+  }
+
+  // the server maps the data directory that the client mounts to this folder
+  ezFileSystem::SetSpecialDirectory("fileservetest", sServerDir);
+  ezFileSystem::RegisterDataDirectoryFactory(ezDataDirectory::FileserveType::Factory, 100.0f);
+
+  ServerStats stats;
+
+  ezFileserver server;
+  server.m_Events.AddEventHandler(ezMakeDelegate(&ServerStats::FileserverEventHandler, &stats));
+  server.SetPort(s_uiPort);
+  server.StartServer();
+
+  // creating the server switched the client off
+  ezFileserveClient::EnableFileserveClient();
+
+  ServerThread serverThread;
+  serverThread.Start();
+
+  ezStringBuilder sAddress;
+  sAddress.Format("localhost:{0}", s_uiPort);
+
+  ezDynamicArray<ezString> files;
+  for (ezUInt32 i = 0; i < s_uiNumFiles; ++i)
+  {
+    ezStringBuilder sFile;
+    sFile.Format("File{0}.txt", i);
+    files.PushBack(sFile);
+  }
+
+  // simulates one run of an application, which reads all files through fileserve
+  auto RunSession = [&](bool bPrefetch, ezTime prefetchTimeout, const char* szVersion, bool bClearCache, bool bPauseServer) -> ezTime {
+    stats.Reset();
+
+    ezFileserveClient client;
+    client.AddServerAddressToTry(sAddress);
+    client.SetPrefetchTimeout(prefetchTimeout);
+
+    if (EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(">fileservetest/", "FileserveTest", "fileserve").Succeeded()).Failed())
+      return ezTime::Zero();
+
+    if (bClearCache)
+    {
+      ezStringBuilder sCacheFolder = ezFileSystem::FindDataDirectoryWithRoot("fileserve")->GetRedirectedDataDirectoryPath();
+      sCacheFolder.Trim(nullptr, "/");
+
+      const ezStringBuilder sMountPoint = sCacheFolder.GetFileName();
+      ezStringBuilder sMetaFolder = ezOSFile::GetUserDataFolder("ezFileserve/Meta");
+      sMetaFolder.AppendPath(sMountPoint);
+
+      ezStringBuilder sPath;
+      for (const ezString& sFile : files)
+      {
+        sPath = sCacheFolder;
+        sPath.AppendPath(sFile);
+        ezOSFile::DeleteFile(sPath).IgnoreResult();
+
+        sPath = sMetaFolder;
+        sPath.AppendPath(sFile);
+        ezOSFile::DeleteFile(sPath).IgnoreResult();
+      }
+    }
+
+    if (bPauseServer)
+    {
+      // the handshake must be done, so that the client sends the prefetch request
+      while (stats.m_iMounts == 0)
+      {
+        ezThreadUtils::YieldTimeSlice();
+      }
+
+      serverThread.m_bPause = true;
+
+      while (!serverThread.m_bIsPaused)
+      {
+        ezThreadUtils::YieldTimeSlice();
+      }
+    }
+
+    ezStopwatch sw;
+
+    if (bPrefetch)
+    {
+      // applications would do this for the files they need at startup, the timeout makes this fail when the server is stuck
+      EZ_TEST_BOOL(client.PrefetchFiles(files).Succeeded() != bPauseServer);
+    }
+
+    for (ezUInt32 i = 0; i < s_uiNumFiles; ++i)
+    {
+      CheckClientFile(i, (i == 0) ? szVersion : "A");
+    }
+
+    const ezTime duration = sw.GetRunningTotal();
+
+    ezFileSystem::RemoveDataDirectoryGroup("FileserveTest");
+    return duration;
+  };
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Cold Cache")
+  {
+    RunSession(false, ezTime::Seconds(10), "A", true, false);
+
+    // the automatic prefetch only checks files that are in the cache already, so every file is requested individually
+    EZ_TEST_INT(stats.m_iPrefetchRequests, 0);
+    EZ_TEST_INT(stats.m_iFileRequests, s_uiNumFiles);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Warm Cache")
+  {
+    const ezTime tPerFile = RunSession(false, ezTime::Zero(), "A", false, false);
+
+    EZ_TEST_INT(stats.m_iPrefetchRequests, 0);
+    EZ_TEST_INT(stats.m_iFileRequests, s_uiNumFiles);
+
+    ChangeServerFile(sServerDir, 0, "B");
+
+    const ezTime tPrefetch = RunSession(true, ezTime::Seconds(10), "B", false, false);
+
+    // all files are validated in one request and afterwards served from the cache, including the changed one
+    EZ_TEST_INT(stats.m_iPrefetchRequests, 1);
+    EZ_TEST_INT(stats.m_iFileRequests, s_uiNumFiles);
+
+    ezLog::Info("Reading {0} cached files over loopback: {1} ms with per-file requests, {2} ms with prefetch", s_uiNumFiles,
+      ezArgF(tPerFile.GetMilliseconds(), 1), ezArgF(tPrefetch.GetMilliseconds(), 1));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Timeout")
+  {
+    ChangeServerFile(sServerDir, 0, "C");
+
+    ezTestLogInterface log;
+    ezTestLogSystemScope logSystemScope(&log);
+    log.ExpectMessage("Fileserve prefetch got no answer", ezLogMsgType::WarningMsg);
+
+    const ezTime tDuration = RunSession(true, ezTime::Seconds(0.25), "C", false, true);
+    EZ_TEST_BOOL(tDuration >= ezTime::Seconds(0.25));
+
+    // the client gave up on the prefetch and requested every file individually
+    EZ_TEST_INT(stats.m_iPrefetchRequests, 1);
+    EZ_TEST_INT(stats.m_iFileRequests, 2 * s_uiNumFiles);
+  }
+
+  serverThread.m_bStop = true;
+  serverThread.Join();
+
+  server.StopServer();
+  server.m_Events.RemoveEventHandler(ezMakeDelegate(&ServerStats::FileserverEventHandler, &stats));
+}
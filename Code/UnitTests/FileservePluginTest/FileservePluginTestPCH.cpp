@@ -0,0 +1 @@
+#include <FileservePluginTestPCH.h>
@@ -870,6 +870,12 @@ EZ_CREATE_SIMPLE_TEST(Basics, Variant)
 
     EZ_TEST_BOOL(va.IsNumber() == false);
     EZ_TEST_BOOL(va.IsFloatingPoint() == false);
+
+    // copies share the array, but NaN elements still make them unequal
+    a2.PushBack(ezMath::NaN<float>());
+    ezVariant vNaN(a2);
+    ezVariant vNaNCopy = vNaN;
+    EZ_TEST_BOOL(vNaN != vNaNCopy);
   }
 
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "ezVariantDictionary")
@@ -0,0 +1,273 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Communication/IpcChannel.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Threading/ThreadUtils.h>
+#include <Foundation/Time/Time.h>
+
+#if EZ_ENABLED(EZ_PLATFORM_WINDOWS_DESKTOP) || EZ_ENABLED(EZ_PLATFORM_LINUX)
+
+namespace
+{
+  class ezIpcChannelTestMsg : public ezProcessMessage
+  {
+    EZ_ADD_DYNAMIC_REFLECTION(ezIpcChannelTestMsg, ezProcessMessage);
+
+  public:
+    ezUInt32 m_uiIndex = 0;
+    ezDataBuffer m_Data;
+  };
+
+  // clang-format off
+  EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezIpcChannelTestMsg, 1, ezRTTIDefaultAllocator<ezIpcChannelTestMsg>)
+  {
+    EZ_BEGIN_PROPERTIES
+    {
+      EZ_MEMBER_PROPERTY("Index", m_uiIndex),
+      EZ_MEMBER_PROPERTY("Data", m_Data),
+    }
+    EZ_END_PROPERTIES;
+  }
+  EZ_END_DYNAMIC_REFLECTED_TYPE;
+  // clang-format on
+
+  bool SendTestMessage(ezIpcChannel* pChannel, ezUInt32 uiIndex, ezUInt32 uiDataSize)
+  {
+    ezIpcChannelTestMsg msg;
+    msg.m_uiIndex = uiIndex;
+    msg.m_Data.SetCountUninitialized(uiDataSize);
+
+    for (ezUInt32 i = 0; i < uiDataSize; ++i)
+    {
+      msg.m_Data[i] = static_cast<ezUInt8>(i + uiIndex);
+    }
+
+    return pChannel->Send(&msg);
+  }
+
+  struct ChannelReceiver
+  {
+    ChannelReceiver(ezIpcChannel* pChannel)
+      : m_pChannel(pChannel)
+    {
+      m_pChannel->m_MessageEvent.AddEventHandler(ezMakeDelegate(&ChannelReceiver::OnMessage, this));
+    }
+
+    ~ChannelReceiver() { m_pChannel->m_MessageEvent.RemoveEventHandler(ezMakeDelegate(&ChannelReceiver::OnMessage, this)); }
+
+    void OnMessage(const ezProcessMessage* pMsg)
+    {
+      const ezIpcChannelTestMsg* pTestMsg = ezDynamicCast<const ezIpcChannelTestMsg*>(pMsg);
+      if (pTestMsg == nullptr)
+        return;
+
+      m_bInOrder &= (pTestMsg->m_uiIndex == m_uiReceived);
+      ++m_uiReceived;
+
+      for (ezUInt32 i = 0; i < pTestMsg->m_Data.GetCount(); ++i)
+      {
+        m_bDataValid &= (pTestMsg->m_Data[i] == static_cast<ezUInt8>(i + pTestMsg->m_uiIndex));
+      }
+    }
+
+    bool WaitFor(ezUInt32 uiNumMessages)
+    {
+      const ezTime tTimeout = ezTime::Now() + ezTime::Seconds(10);
+
+      while (m_uiReceived < uiNumMessages)
+      {
+        if (!m_pChannel->ProcessMessages())
+        {
+          if (ezTime::Now() > tTimeout)
+            return false;
+
+          ezThreadUtils::YieldTimeSlice();
+        }
+      }
+
+      return true;
+    }
+
+    ezIpcChannel* m_pChannel = nullptr;
+    ezUInt32 m_uiReceived = 0;
+    bool m_bInOrder = true;
+    bool m_bDataValid = true;
+  };
+
+  bool WaitForConnection(ezIpcChannel* pServer, ezIpcChannel* pClient)
+  {
+    const ezTime tTimeout = ezTime::Now() + ezTime::Seconds(10);
+
+    while (!pServer->IsConnected() || !pClient->IsConnected())
+    {
+      if (ezTime::Now() > tTimeout)
+        return false;
+
+      ezThreadUtils::Sleep(ezTime::Milliseconds(1));
+    }
+
+    return true;
+  }
+
+  void TestChannel(const char* szChannelType, ezIpcChannel* pServer, ezIpcChannel* pClient)
+  {
+    if (EZ_TEST_BOOL(pServer != nullptr && pClient != nullptr).Failed())
+      return;
+
+    pServer->Connect();
+    pClient->Connect();
+
+    if (EZ_TEST_BOOL(WaitForConnection(pServer, pClient)).Failed())
+      return;
+
+    ChannelReceiver serverReceiver(pServer);
+    ChannelReceiver clientReceiver(pClient);
+
+    // small messages go through the ring buffer, the large ones through the arena on Linux
+    const ezUInt32 uiMessageSizes[] = {0, 1, 100, 4 * 1024, 64 * 1024, 256 * 1024, 3 * 1024 * 1024, 7};
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(uiMessageSizes); ++i)
+    {
+      SendTestMessage(pServer, i, uiMessageSizes[i]);
+    }
+
+    EZ_TEST_BOOL(clientReceiver.WaitFor(EZ_ARRAY_SIZE(uiMessageSizes)));
+    EZ_TEST_BOOL(clientReceiver.m_bInOrder);
+    EZ_TEST_BOOL(clientReceiver.m_bDataValid);
+
+    // round trip latency
+    const ezUInt32 uiNumRoundTrips = 200;
+    serverReceiver.m_uiReceived = 0;
+    clientReceiver.m_uiReceived = 0;
+
+    const ezTime tRoundTripStart = ezTime::Now();
+
+    for (ezUInt32 i = 0; i < uiNumRoundTrips; ++i)
+    {
+      SendTestMessage(pServer, i, 16);
+      if (!clientReceiver.WaitFor(i + 1))
+        break;
+
+      SendTestMessage(pClient, i, 16);
+      if (!serverReceiver.WaitFor(i + 1))
+        break;
+    }
+
+    const ezTime tRoundTrip = (ezTime::Now() - tRoundTripStart) / static_cast<double>(uiNumRoundTrips);
+
+    EZ_TEST_INT(serverReceiver.m_uiReceived, uiNumRoundTrips);
+    EZ_TEST_BOOL(serverReceiver.m_bInOrder);
+
+    // bandwidth with small and with large messages
+    ezTime tBandwidth[2];
+    const ezUInt32 uiBandwidthMessageSizes[2] = {4 * 1024, 1024 * 1024};
+    const ezUInt32 uiBandwidthMessageCount[2] = {2000, 32};
+
+    for (ezUInt32 uiTest = 0; uiTest < 2; ++uiTest)
+    {
+      clientReceiver.m_uiReceived = 0;
+
+      const ezTime tStart = ezTime::Now();
+
+      for (ezUInt32 i = 0; i < uiBandwidthMessageCount[uiTest]; ++i)
+      {
+        SendTestMessage(pServer, i, uiBandwidthMessageSizes[uiTest]);
+      }
+
+      EZ_TEST_BOOL(clientReceiver.WaitFor(uiBandwidthMessageCount[uiTest]));
+      tBandwidth[uiTest] = ezTime::Now() - tStart;
+    }
+
+    EZ_TEST_BOOL(clientReceiver.m_bInOrder);
+    EZ_TEST_BOOL(clientReceiver.m_bDataValid);
+
+    auto GetMegaBytesPerSecond = [&](ezUInt32 uiTest) {
+      return (uiBandwidthMessageSizes[uiTest] * uiBandwidthMessageCount[uiTest]) / (1024.0 * 1024.0) / tBandwidth[uiTest].GetSeconds();
+    };
+
+    ezLog::Info("[test]{0}: round trip {1}us, bandwidth {2}MB/s with 4KB messages, {3}MB/s with 1MB messages", szChannelType,
+      ezArgF(tRoundTrip.GetMicroseconds(), 1), ezArgF(GetMegaBytesPerSecond(0), 1), ezArgF(GetMegaBytesPerSecond(1), 1));
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Communication, IpcChannel)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Pipe Channel")
+  {
+    ezStringBuilder sAddress;
+    sAddress.Format("ezIpcChannelTest-{0}", ezArgU(static_cast<ezUInt64>(ezTime::Now().GetNanoseconds()), 16, false, 16));
+
+    ezIpcChannel* pServer = ezIpcChannel::CreatePipeChannel(sAddress, ezIpcChannel::Mode::Server);
+    ezIpcChannel* pClient = ezIpcChannel::CreatePipeChannel(sAddress, ezIpcChannel::Mode::Client);
+
+    TestChannel("Pipe channel", pServer, pClient);
+
+#  if EZ_ENABLED(EZ_PLATFORM_LINUX)
+    // the server notices when the client goes away
+    EZ_DEFAULT_DELETE(pClient);
+
+    const ezTime tTimeout = ezTime::Now() + ezTime::Seconds(10);
+    while (pServer->IsConnected() && ezTime::Now() < tTimeout)
+    {
+      ezThreadUtils::Sleep(ezTime::Milliseconds(1));
+    }
+
+    EZ_TEST_BOOL(!pServer->IsConnected());
+#  endif
+
+    EZ_DEFAULT_DELETE(pClient);
+    EZ_DEFAULT_DELETE(pServer);
+
+#  if EZ_ENABLED(EZ_PLATFORM_LINUX)
+    // nothing is left behind in shared memory
+    ezStringBuilder sSharedMemoryPath;
+    sSharedMemoryPath.Format("/dev/shm/ez-ipc-{0}", sAddress);
+    EZ_TEST_BOOL(!ezOSFile::ExistsFile(sSharedMemoryPath));
+#  endif
+  }
+
+#  if EZ_ENABLED(EZ_PLATFORM_LINUX)
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Client before Server")
+  {
+    ezStringBuilder sAddress;
+    sAddress.Format("ezIpcChannelTest-{0}", ezArgU(static_cast<ezUInt64>(ezTime::Now().GetNanoseconds()), 16, false, 16));
+
+    // the client keeps trying to connect until the server is there
+    ezIpcChannel* pClient = ezIpcChannel::CreatePipeChannel(sAddress, ezIpcChannel::Mode::Client);
+    pClient->Connect();
+
+    ezThreadUtils::Sleep(ezTime::Milliseconds(200));
+    EZ_TEST_BOOL(!pClient->IsConnected());
+
+    ezIpcChannel* pServer = ezIpcChannel::CreatePipeChannel(sAddress, ezIpcChannel::Mode::Server);
+    pServer->Connect();
+
+    if (EZ_TEST_BOOL(WaitForConnection(pServer, pClient)).Succeeded())
+    {
+      ChannelReceiver serverReceiver(pServer);
+      SendTestMessage(pClient, 0, 100);
+
+      EZ_TEST_BOOL(serverReceiver.WaitFor(1));
+      EZ_TEST_BOOL(serverReceiver.m_bDataValid);
+    }
+
+    EZ_DEFAULT_DELETE(pClient);
+    EZ_DEFAULT_DELETE(pServer);
+  }
+#  endif
+
+#  ifdef BUILDSYSTEM_ENABLE_ENET_SUPPORT
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Network Channel")
+  {
+    ezIpcChannel* pServer = ezIpcChannel::CreateNetworkChannel("localhost:1051", ezIpcChannel::Mode::Server);
+    ezIpcChannel* pClient = ezIpcChannel::CreateNetworkChannel("localhost:1051", ezIpcChannel::Mode::Client);
+
+    TestChannel("Network channel", pServer, pClient);
+
+    EZ_DEFAULT_DELETE(pClient);
+    EZ_DEFAULT_DELETE(pServer);
+  }
+#  endif
+}
+
+#endif
@@ -0,0 +1,188 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Containers/IndexedPriorityQueue.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+  struct QueuedObject
+  {
+    ezUInt32 m_uiQueueIndex = ezInvalidIndex;
+    float m_fPriority = 0.0f;
+  };
+
+  struct QueuedObjectIndex
+  {
+    static void SetIndex(QueuedObject* pObject, ezUInt32 uiIndex) { pObject->m_uiQueueIndex = uiIndex; }
+  };
+
+  using TestQueue = ezIndexedPriorityQueue<float, QueuedObject*, QueuedObjectIndex>;
+
+  bool IsQueueValid(const TestQueue& queue)
+  {
+    for (ezUInt32 i = 0; i < queue.GetCount(); ++i)
+    {
+      if (queue[i].m_Value->m_uiQueueIndex != i)
+        return false;
+
+      if (i > 0 && queue[i].m_Key < queue[(i - 1) / 2].m_Key)
+        return false;
+    }
+
+    return true;
+  }
+
+  bool PopsInOrder(TestQueue& queue)
+  {
+    bool bInOrder = true;
+    float fLastKey = -1.0f;
+
+    while (!queue.IsEmpty())
+    {
+      const float fKey = queue.PeekTop().m_Key;
+      bInOrder &= (fKey >= fLastKey) && (fKey == queue.PeekTop().m_Value->m_fPriority);
+      fLastKey = fKey;
+
+      QueuedObject* pObject = queue.PeekTop().m_Value;
+      queue.PopTop();
+      bInOrder &= (pObject->m_uiQueueIndex == ezInvalidIndex);
+    }
+
+    return bInOrder;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Containers, IndexedPriorityQueue)
+{
+  ezRandom rnd;
+  rnd.Initialize(42);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Insert / PopTop")
+  {
+    QueuedObject objects[100];
+    TestQueue queue;
+
+    EZ_TEST_BOOL(queue.IsEmpty());
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(objects); ++i)
+    {
+      objects[i].m_fPriority = static_cast<float>(rnd.UIntInRange(50));
+      queue.Insert(objects[i].m_fPriority, &objects[i]);
+    }
+
+    EZ_TEST_INT(queue.GetCount(), EZ_ARRAY_SIZE(objects));
+    EZ_TEST_BOOL(IsQueueValid(queue));
+    EZ_TEST_BOOL(PopsInOrder(queue));
+    EZ_TEST_BOOL(queue.IsEmpty());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Remove / SetKey")
+  {
+    QueuedObject objects[100];
+    TestQueue queue;
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(objects); ++i)
+    {
+      objects[i].m_fPriority = static_cast<float>(i);
+      queue.Insert(objects[i].m_fPriority, &objects[i]);
+    }
+
+    // remove every third object through its stored index
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(objects); i += 3)
+    {
+      queue.Remove(objects[i].m_uiQueueIndex);
+      EZ_TEST_INT(objects[i].m_uiQueueIndex, ezInvalidIndex);
+    }
+
+    EZ_TEST_INT(queue.GetCount(), 66);
+    EZ_TEST_BOOL(IsQueueValid(queue));
+
+    // move the last object to the top and the top object to the end
+    objects[98].m_fPriority = -1.0f;
+    queue.SetKey(objects[98].m_uiQueueIndex, -1.0f);
+    EZ_TEST_BOOL(queue.PeekTop().m_Value == &objects[98]);
+
+    objects[1].m_fPriority = 1000.0f;
+    queue.SetKey(objects[1].m_uiQueueIndex, 1000.0f);
+    EZ_TEST_BOOL(IsQueueValid(queue));
+
+    EZ_TEST_BOOL(PopsInOrder(queue));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Clear")
+  {
+    QueuedObject objects[10];
+    TestQueue queue;
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(objects); ++i)
+    {
+      queue.Insert(0.0f, &objects[i]);
+    }
+
+    queue.Clear();
+    EZ_TEST_BOOL(queue.IsEmpty());
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(objects); ++i)
+    {
+      EZ_TEST_INT(objects[i].m_uiQueueIndex, ezInvalidIndex);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Stress Test")
+  {
+    // roughly what the resource manager sees while streaming in a level
+    const ezUInt32 uiNumObjects = 20000;
+
+    ezDynamicArray<QueuedObject> objects;
+    objects.SetCount(uiNumObjects);
+
+    TestQueue queue;
+    ezUInt32 uiNumOperations = 0;
+
+    ezTime t0 = ezTime::Now();
+
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      objects[i].m_fPriority = rnd.FloatInRange(0.0f, 100.0f);
+      queue.Insert(objects[i].m_fPriority, &objects[i]);
+    }
+    uiNumOperations += uiNumObjects;
+
+    for (ezUInt32 i = 0; i < uiNumObjects * 4; ++i)
+    {
+      QueuedObject& object = objects[rnd.UIntInRange(uiNumObjects)];
+
+      if (object.m_uiQueueIndex == ezInvalidIndex)
+      {
+        queue.Insert(object.m_fPriority, &object);
+      }
+      else if ((i & 3) == 0)
+      {
+        queue.Remove(object.m_uiQueueIndex);
+      }
+      else
+      {
+        object.m_fPriority = rnd.FloatInRange(0.0f, 100.0f);
+        queue.SetKey(object.m_uiQueueIndex, object.m_fPriority);
+      }
+
+      ++uiNumOperations;
+    }
+
+    ezTime t1 = ezTime::Now();
+
+    EZ_TEST_BOOL(IsQueueValid(queue));
+
+    uiNumOperations += queue.GetCount();
+
+    ezTime t2 = ezTime::Now();
+    EZ_TEST_BOOL(PopsInOrder(queue));
+    ezTime t3 = ezTime::Now();
+
+    const ezTime duration = (t1 - t0) + (t3 - t2);
+
+    ezLog::Info("[test]Indexed priority queue: {0} operations/s ({1} operations in {2}ms)", ezArgF(uiNumOperations / duration.GetSeconds(), 0),
+      uiNumOperations, ezArgF(duration.GetMilliseconds(), 2));
+  }
+}
@@ -0,0 +1,89 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/IO/TextInputBuffer.h>
+
+EZ_CREATE_SIMPLE_TEST(IO, TextInputBuffer)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ReadByte")
+  {
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      writer << static_cast<ezUInt8>('a' + (i % 26));
+    }
+
+    ezMemoryStreamReader reader(&storage);
+
+    // a small block size, so that the buffer has to be refilled several times
+    ezTextInputBuffer buffer;
+    buffer.SetInputStream(&reader, 16);
+
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      EZ_TEST_INT(buffer.ReadByte(), 'a' + (i % 26));
+    }
+
+    EZ_TEST_INT(buffer.ReadByte(), '\0');
+    EZ_TEST_INT(buffer.ReadByte(), '\0');
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ScanWhiteSpace")
+  {
+    const char* szText = " \t\r\n                                      \n  x    ";
+    const ezUInt32 uiLength = ezStringUtils::GetStringElementCount(szText);
+    const ezUInt8* pText = reinterpret_cast<const ezUInt8*>(szText);
+
+    EZ_TEST_INT(ezTextInputBuffer::ScanWhiteSpace(pText, uiLength), uiLength - 5);
+    EZ_TEST_INT(ezTextInputBuffer::ScanWhiteSpace(pText, 3), 3);
+    EZ_TEST_INT(ezTextInputBuffer::ScanWhiteSpace(pText + uiLength - 5, 5), 0);
+    EZ_TEST_INT(ezTextInputBuffer::ScanWhiteSpace(pText + uiLength - 4, 4), 4);
+
+    // '\0' is not whitespace
+    const ezUInt8 data[] = {' ', ' ', '\0', ' '};
+    EZ_TEST_INT(ezTextInputBuffer::ScanWhiteSpace(data, 4), 2);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ScanStringCharacters")
+  {
+    const char* szText = "a string that is longer than sixteen characters\\\" and \"";
+    const ezUInt32 uiLength = ezStringUtils::GetStringElementCount(szText);
+    const ezUInt8* pText = reinterpret_cast<const ezUInt8*>(szText);
+
+    EZ_TEST_INT(ezTextInputBuffer::ScanStringCharacters(pText, uiLength), 47);
+    EZ_TEST_INT(ezTextInputBuffer::ScanStringCharacters(pText + 48, uiLength - 48), 0);
+    EZ_TEST_INT(ezTextInputBuffer::ScanStringCharacters(pText + 49, uiLength - 49), 5);
+    EZ_TEST_INT(ezTextInputBuffer::ScanStringCharacters(pText, 10), 10);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "SkipBufferedBytes")
+  {
+    const char* szText = "ab\ncd\n\nefg";
+
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    writer.WriteBytes(szText, ezStringUtils::GetStringElementCount(szText));
+
+    ezMemoryStreamReader reader(&storage);
+
+    ezTextInputBuffer buffer;
+    buffer.SetInputStream(&reader);
+
+    EZ_TEST_INT(buffer.ReadByte(), 'a');
+    EZ_TEST_INT(buffer.GetNumBufferedBytes(), 9);
+
+    ezUInt32 uiLine = 1;
+    ezUInt32 uiColumn = 1;
+    buffer.SkipBufferedBytes(7, uiLine, uiColumn);
+
+    EZ_TEST_INT(uiLine, 4);
+    EZ_TEST_INT(uiColumn, 1);
+    EZ_TEST_INT(buffer.ReadByte(), 'f');
+
+    buffer.SkipBufferedBytes(1, uiLine, uiColumn);
+    EZ_TEST_INT(uiColumn, 2);
+    EZ_TEST_INT(buffer.ReadByte(), '\0');
+  }
+}
@@ -254,3 +254,241 @@ EZ_CREATE_SIMPLE_TEST(Logging, GlobalTestLog)
     }
   }
 }
+
+namespace
+{
+  static ezMutex s_AsyncLogMutex;
+  static ezStringBuilder s_sAsyncLogResult;
+  static ezUInt32 s_uiAsyncLogMessages = 0;
+  static ezUInt32 s_uiAsyncLogDropWarnings = 0;
+
+  void AsyncLogWriter(const ezLoggingEventData& le)
+  {
+    EZ_LOCK(s_AsyncLogMutex);
+
+    if (le.m_EventType == ezLogMsgType::WarningMsg && ezStringUtils::FindSubString(le.m_szText, "were dropped") != nullptr)
+    {
+      ++s_uiAsyncLogDropWarnings;
+      return;
+    }
+
+    if (!ezStringUtils::IsEqual(le.m_szTag, "AsyncTest"))
+    {
+      // repetition info has no tag
+      if (le.m_szText == nullptr || ezStringUtils::FindSubString(le.m_szText, "Last message repeated") == nullptr)
+        return;
+    }
+
+    ++s_uiAsyncLogMessages;
+
+    switch (le.m_EventType)
+    {
+      case ezLogMsgType::BeginGroup:
+        s_sAsyncLogResult.Append(">", le.m_szText, "\n");
+        break;
+      case ezLogMsgType::EndGroup:
+        s_sAsyncLogResult.Append("<", le.m_szText, "\n");
+        break;
+      case ezLogMsgType::WarningMsg:
+        s_sAsyncLogResult.Append("W:", le.m_szText, "\n");
+        break;
+      case ezLogMsgType::InfoMsg:
+        s_sAsyncLogResult.Append("I:", le.m_szText, "\n");
+        break;
+      default:
+        break;
+    }
+  }
+
+  class AsyncLogThread : public ezThread
+  {
+  public:
+    ezUInt32 m_uiNumUniqueMessages = 0;
+    const char* m_szMessage = nullptr;
+
+    virtual ezUInt32 Run() override
+    {
+      if (m_szMessage != nullptr)
+      {
+        ezLog::Info("[AsyncTest]{}", m_szMessage);
+        return 0;
+      }
+
+      if (m_uiNumUniqueMessages > 0)
+      {
+        for (ezUInt32 i = 0; i < m_uiNumUniqueMessages; ++i)
+        {
+          ezLog::Info("[AsyncTest]Unique message {}", i);
+        }
+
+        return 0;
+      }
+
+      EZ_LOG_BLOCK("Block", "AsyncTest");
+
+      ezLog::Info("[AsyncTest]Before the storm");
+
+      for (ezUInt32 i = 0; i < 100; ++i)
+      {
+        ezLog::Warning("[AsyncTest]Maximum number of lights reached");
+      }
+
+      ezLog::Info("[AsyncTest]After the storm");
+      return 0;
+    }
+  };
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Logging, AsyncLog)
+{
+  ezGlobalLog::AddLogWriter(&AsyncLogWriter);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Blocks and Duplicates")
+  {
+    s_sAsyncLogResult.Clear();
+
+    ezAsyncLogSettings settings;
+    settings.m_DuplicateInterval = ezTime::Seconds(60);
+    ezGlobalLog::StartAsyncLogging(settings);
+    EZ_TEST_BOOL(ezGlobalLog::IsAsyncLogging());
+
+    const ezUInt32 uiSuppressed = ezGlobalLog::GetSuppressedDuplicateCount();
+
+    AsyncLogThread thread;
+    thread.Start();
+    thread.Join();
+
+    ezGlobalLog::FlushAsyncLogging();
+
+    EZ_TEST_INT(ezGlobalLog::GetSuppressedDuplicateCount() - uiSuppressed, 99);
+
+    EZ_LOCK(s_AsyncLogMutex);
+    EZ_TEST_STRING(s_sAsyncLogResult, "\
+>Block\n\
+I:Before the storm\n\
+W:Maximum number of lights reached\n\
+W:Last message repeated 99 more times.\n\
+I:After the storm\n\
+<Block\n\
+");
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Stop")
+  {
+    s_sAsyncLogResult.Clear();
+
+    AsyncLogThread thread;
+    thread.Start();
+    thread.Join();
+
+    // stopping passes on everything, including the repetition count of the last message
+    ezGlobalLog::StopAsyncLogging();
+    EZ_TEST_BOOL(!ezGlobalLog::IsAsyncLogging());
+
+    EZ_LOCK(s_AsyncLogMutex);
+    EZ_TEST_BOOL(s_sAsyncLogResult.FindSubString("I:After the storm") != nullptr);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Dropped Messages")
+  {
+    s_uiAsyncLogMessages = 0;
+    s_uiAsyncLogDropWarnings = 0;
+
+    ezAsyncLogSettings settings;
+    settings.m_uiBufferSizePerThread = 1024;
+    settings.m_DuplicateInterval.SetZero();
+    ezGlobalLog::StartAsyncLogging(settings);
+
+    const ezUInt32 uiDropped = ezGlobalLog::GetDroppedMessageCount();
+
+    AsyncLogThread thread;
+    thread.m_uiNumUniqueMessages = 1000;
+    thread.Start();
+    thread.Join();
+
+    ezGlobalLog::StopAsyncLogging();
+
+    // whether messages are dropped depends on the timing, but every message is either passed on or counted
+    const ezUInt32 uiNumDropped = ezGlobalLog::GetDroppedMessageCount() - uiDropped;
+
+    EZ_LOCK(s_AsyncLogMutex);
+    EZ_TEST_INT(s_uiAsyncLogMessages + uiNumDropped, 1000);
+    EZ_TEST_BOOL((uiNumDropped > 0) == (s_uiAsyncLogDropWarnings > 0));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Stop While Logging")
+  {
+    s_uiAsyncLogMessages = 0;
+    s_uiAsyncLogDropWarnings = 0;
+
+    ezAsyncLogSettings settings;
+    settings.m_uiBufferSizePerThread = 1024 * 1024;
+    settings.m_DuplicateInterval.SetZero();
+    ezGlobalLog::StartAsyncLogging(settings);
+
+    const ezUInt32 uiDropped = ezGlobalLog::GetDroppedMessageCount();
+
+    AsyncLogThread thread;
+    thread.m_uiNumUniqueMessages = 10000;
+    thread.Start();
+
+    // messages that are logged while stopping are either drained or passed on synchronously, but never lost
+    ezGlobalLog::StopAsyncLogging();
+    thread.Join();
+
+    EZ_TEST_INT(ezGlobalLog::GetDroppedMessageCount() - uiDropped, 0);
+
+    EZ_LOCK(s_AsyncLogMutex);
+    EZ_TEST_INT(s_uiAsyncLogMessages, 10000);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Buffer Reuse")
+  {
+    ezStringBuilder sLongMessage;
+    for (ezUInt32 i = 0; i < 1000; ++i)
+    {
+      sLongMessage.Append("x");
+    }
+
+    auto RunThread = [](const char* szMessage) {
+      AsyncLogThread thread;
+      thread.m_szMessage = szMessage;
+      thread.Start();
+      thread.Join();
+
+      ezGlobalLog::FlushAsyncLogging();
+    };
+
+    ezAsyncLogSettings settings;
+    settings.m_uiBufferSizePerThread = 1024 * 1024;
+    settings.m_DuplicateInterval = ezTime::Seconds(60);
+    ezGlobalLog::StartAsyncLogging(settings);
+    RunThread("Same message");
+    ezGlobalLog::StopAsyncLogging();
+
+    s_sAsyncLogResult.Clear();
+
+    settings.m_uiBufferSizePerThread = 1024;
+    ezGlobalLog::StartAsyncLogging(settings);
+
+    // the buffer of the first thread has the wrong size and is freed, the buffers of the following threads are reused
+    RunThread("Same message");
+    RunThread("Same message");
+
+    // long messages are cut to a quarter of the new buffer size
+    RunThread(sLongMessage);
+
+    ezGlobalLog::StopAsyncLogging();
+
+    // a reused buffer doesn't treat the first message of the new thread as a repetition
+    sLongMessage.Shrink(0, 1000 - 256);
+
+    ezStringBuilder sExpected;
+    sExpected.Append("I:Same message\n", "I:Same message\n", "I:", sLongMessage, "\n");
+
+    EZ_LOCK(s_AsyncLogMutex);
+    EZ_TEST_STRING(s_sAsyncLogResult, sExpected);
+  }
+
+  ezGlobalLog::RemoveLogWriter(&AsyncLogWriter);
+}
@@ -1,11 +1,15 @@
 #include <FoundationTestPCH.h>
 
 #include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Containers/FlatHashTable.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Containers/Map.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Reflection/Reflection.h>
 #include <Foundation/Strings/String.h>
 #include <Foundation/Time/Time.h>
 
+#include <unordered_map>
 #include <vector>
 
 namespace
@@ -75,7 +79,70 @@ namespace
 
   ezUInt32 SomeBigObject::constructionCount = 0;
   ezUInt32 SomeBigObject::destructionCount = 0;
-}
+
+  template <typename MapType>
+  EZ_ALWAYS_INLINE void MapInsert(MapType& map, ezUInt32 uiKey, ezUInt32 uiValue)
+  {
+    map.Insert(uiKey, uiValue);
+  }
+
+  template <typename MapType>
+  EZ_ALWAYS_INLINE bool MapContains(const MapType& map, ezUInt32 uiKey)
+  {
+    return map.Contains(uiKey);
+  }
+
+  template <typename MapType>
+  EZ_ALWAYS_INLINE void MapRemove(MapType& map, ezUInt32 uiKey)
+  {
+    map.Remove(uiKey);
+  }
+
+  EZ_ALWAYS_INLINE void MapInsert(std::unordered_map<ezUInt32, ezUInt32>& map, ezUInt32 uiKey, ezUInt32 uiValue) { map.emplace(uiKey, uiValue); }
+
+  EZ_ALWAYS_INLINE bool MapContains(const std::unordered_map<ezUInt32, ezUInt32>& map, ezUInt32 uiKey) { return map.find(uiKey) != map.end(); }
+
+  EZ_ALWAYS_INLINE void MapRemove(std::unordered_map<ezUInt32, ezUInt32>& map, ezUInt32 uiKey) { map.erase(uiKey); }
+
+  /// Measures insertion, lookup of existing and missing keys and removal of all keys and logs the time per operation in nanoseconds.
+  template <typename MapType>
+  void MeasureMap(const char* szName, const ezDynamicArray<ezUInt32>& keys, ezUInt32 uiCount)
+  {
+    MapType map;
+    ezUInt32 uiFound = 0;
+
+    const ezTime t0 = ezTime::Now();
+
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      MapInsert(map, keys[i], i);
+    }
+
+    const ezTime t1 = ezTime::Now();
+
+    // the second half of the keys was never inserted
+    for (ezUInt32 i = 0; i < uiCount * 2; ++i)
+    {
+      uiFound += MapContains(map, keys[i]) ? 1 : 0;
+    }
+
+    const ezTime t2 = ezTime::Now();
+
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      MapRemove(map, keys[i]);
+    }
+
+    const ezTime t3 = ezTime::Now();
+
+    EZ_TEST_INT(uiFound, uiCount);
+
+    const double fCount = static_cast<double>(uiCount);
+    ezLog::Info("[test]{0} size = {1}: insert {2}ns, lookup {3}ns, remove {4}ns", szName, uiCount,
+      ezArgF((t1 - t0).GetNanoseconds() / fCount, 1), ezArgF((t2 - t1).GetNanoseconds() / (fCount * 2), 1),
+      ezArgF((t3 - t2).GetNanoseconds() / fCount, 1));
+  }
+} // namespace
 
 // Enable when needed
 #define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
@@ -426,4 +493,29 @@ EZ_CREATE_SIMPLE_TEST(Performance, Container)
                   ezArgF((t1 - t0).GetMilliseconds() / static_cast<double>(NUM_SAMPLES), 4), sum);
     }
   }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Hash Maps<ezUInt32, ezUInt32>")
+  {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+    const ezUInt32 uiMaxCount = 100 * 1000;
+#else
+    const ezUInt32 uiMaxCount = 10 * 1000 * 1000;
+#endif
+
+    // unique pseudo random keys, multiplying with an odd number is a bijection
+    ezDynamicArray<ezUInt32> keys;
+    keys.SetCountUninitialized(uiMaxCount * 2);
+    for (ezUInt32 i = 0; i < keys.GetCount(); ++i)
+    {
+      keys[i] = (i ^ 0x5bd1e995u) * 0x9E3779B1u;
+    }
+
+    for (ezUInt32 uiCount = 1000; uiCount <= uiMaxCount; uiCount *= 10)
+    {
+      MeasureMap<ezFlatHashTable<ezUInt32, ezUInt32>>("ezFlatHashTable", keys, uiCount);
+      MeasureMap<ezHashTable<ezUInt32, ezUInt32>>("ezHashTable", keys, uiCount);
+      MeasureMap<ezMap<ezUInt32, ezUInt32>>("ezMap", keys, uiCount);
+      MeasureMap<std::unordered_map<ezUInt32, ezUInt32>>("std::unordered_map", keys, uiCount);
+    }
+  }
 }
@@ -0,0 +1,335 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Reflection/Reflection.h>
+#include <Foundation/Serialization/AbstractObjectGraph.h>
+#include <Foundation/Serialization/ReflectionSerializer.h>
+#include <Foundation/Serialization/SerializationPlan.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+  enum SerializationConstants
+  {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+    NUM_SERIALIZED_OBJECTS = 1000 * 10,
+#else
+    NUM_SERIALIZED_OBJECTS = 1000 * 100,
+#endif
+  };
+} // namespace
+
+class ezSerializationPerfObject : public ezReflectedClass
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ezSerializationPerfObject, ezReflectedClass);
+
+public:
+  void Init(ezUInt32 i)
+  {
+    m_vPosition.Set((float)i, 1.0f, 2.0f);
+    m_qRotation.SetIdentity();
+    m_vScale.Set(1.0f, 2.0f, (float)i);
+    m_Color = ezColor(0.5f, 0.25f, (float)i, 1.0f);
+    m_iInt = i;
+    m_uiUInt64 = i * 3;
+    m_fFloat = i * 0.5f;
+    m_bBool = (i & 1) != 0;
+    m_Time = ezTime::Seconds(i);
+
+    ezStringBuilder sName;
+    sName.Format("Object {0}", i);
+    m_sName = sName;
+
+    m_iAccessor = -(ezInt32)i;
+  }
+
+  bool operator==(const ezSerializationPerfObject& rhs) const
+  {
+    return m_vPosition == rhs.m_vPosition && m_qRotation == rhs.m_qRotation && m_vScale == rhs.m_vScale && m_Color == rhs.m_Color &&
+           m_iInt == rhs.m_iInt && m_uiUInt64 == rhs.m_uiUInt64 && m_fFloat == rhs.m_fFloat && m_bBool == rhs.m_bBool &&
+           m_Time == rhs.m_Time && m_sName == rhs.m_sName && m_iAccessor == rhs.m_iAccessor;
+  }
+
+  ezVec3 m_vPosition = ezVec3::ZeroVector();
+  ezQuat m_qRotation = ezQuat::IdentityQuaternion();
+  ezVec3 m_vScale = ezVec3::ZeroVector();
+  ezColor m_Color;
+  ezInt32 m_iInt = 0;
+  ezUInt64 m_uiUInt64 = 0;
+  float m_fFloat = 0.0f;
+  bool m_bBool = false;
+  ezTime m_Time;
+  ezString m_sName;
+
+  void SetAccessor(ezInt32 i) { m_iAccessor = i; }
+  ezInt32 GetAccessor() const { return m_iAccessor; }
+
+private:
+  ezInt32 m_iAccessor = 0;
+};
+
+// clang-format off
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezSerializationPerfObject, 1, ezRTTIDefaultAllocator<ezSerializationPerfObject>)
+{
+  EZ_BEGIN_PROPERTIES
+  {
+    EZ_MEMBER_PROPERTY("Position", m_vPosition),
+    EZ_MEMBER_PROPERTY("Rotation", m_qRotation),
+    EZ_MEMBER_PROPERTY("Scale", m_vScale),
+    EZ_MEMBER_PROPERTY("Color", m_Color),
+    EZ_MEMBER_PROPERTY("Int", m_iInt),
+    EZ_MEMBER_PROPERTY("UInt64", m_uiUInt64),
+    EZ_MEMBER_PROPERTY("Float", m_fFloat),
+    EZ_MEMBER_PROPERTY("Bool", m_bBool),
+    EZ_MEMBER_PROPERTY("Time", m_Time),
+    EZ_MEMBER_PROPERTY("Name", m_sName),
+    EZ_ACCESSOR_PROPERTY("Accessor", GetAccessor, SetAccessor),
+  }
+  EZ_END_PROPERTIES;
+}
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+namespace
+{
+  enum
+  {
+    NUM_GRAPH_NODE_PROPERTIES = 7
+  };
+
+  /// Builds a tree of game object like nodes. With bModified set, every tenth node is moved, one in a hundred is removed and as many
+  /// new nodes are added.
+  void BuildPerfGraph(ezAbstractObjectGraph& graph, ezUInt32 uiNumNodes, bool bModified)
+  {
+    ezStringBuilder sName;
+
+    auto AddNode = [&](ezUInt32 i, float fOffset) {
+      ezAbstractObjectNode* pNode = graph.AddNode(ezUuid::StableUuidForInt(i), "ezGameObject", 1);
+
+      sName.Format("Object {0}", i);
+      pNode->AddProperty("Name", sName.GetData());
+      pNode->AddProperty("Active", true);
+      pNode->AddProperty("LocalPosition", ezVec3((float)i + fOffset, 1.0f, 2.0f));
+      pNode->AddProperty("LocalRotation", ezQuat::IdentityQuaternion());
+      pNode->AddProperty("LocalScaling", ezVec3(1.0f));
+
+      ezVariantArray children;
+      for (ezUInt32 uiChild = i * 2 + 1; uiChild <= i * 2 + 2 && uiChild < uiNumNodes; ++uiChild)
+        children.PushBack(ezUuid::StableUuidForInt(uiChild));
+      pNode->AddProperty("Children", children);
+      pNode->AddProperty("Components", ezVariantArray());
+    };
+
+    for (ezUInt32 i = 0; i < uiNumNodes; ++i)
+    {
+      if (bModified && i % 100 == 50)
+        continue;
+
+      AddNode(i, (bModified && i % 10 == 1) ? 0.5f : 0.0f);
+    }
+
+    if (bModified)
+    {
+      for (ezUInt32 i = 0; i < uiNumNodes / 100; ++i)
+        AddNode(uiNumNodes + i, 0.0f);
+    }
+  }
+
+  /// Clears the serialization plan cache over and over, until it is stopped.
+  class ClearPlanCacheThread : public ezThread
+  {
+  public:
+    ClearPlanCacheThread()
+      : ezThread("Clear Plan Cache")
+    {
+    }
+
+    virtual ezUInt32 Run()
+    {
+      while (m_iStop == 0)
+      {
+        ezSerializationPlan::ClearCache();
+        m_iNumClears.Increment();
+        ezThreadUtils::YieldTimeSlice();
+      }
+
+      return 0;
+    }
+
+    ezAtomicInteger32 m_iStop;
+    ezAtomicInteger32 m_iNumClears;
+  };
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Performance, Serialization)
+{
+  ezDynamicArray<ezSerializationPerfObject> objects;
+  objects.SetCount(NUM_SERIALIZED_OBJECTS);
+
+  for (ezUInt32 i = 0; i < NUM_SERIALIZED_OBJECTS; ++i)
+  {
+    objects[i].Init(i);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Binary Serialization")
+  {
+    ezMemoryStreamStorage storage;
+
+    ezTime t0 = ezTime::Now();
+
+    {
+      ezMemoryStreamWriter writer(&storage);
+      for (ezUInt32 i = 0; i < NUM_SERIALIZED_OBJECTS; ++i)
+      {
+        ezReflectionSerializer::WriteObjectToBinary(writer, ezGetStaticRTTI<ezSerializationPerfObject>(), &objects[i]);
+      }
+    }
+
+    ezTime t1 = ezTime::Now();
+
+    ezDynamicArray<ezSerializationPerfObject> readObjects;
+    readObjects.SetCount(NUM_SERIALIZED_OBJECTS);
+
+    {
+      ezMemoryStreamReader reader(&storage);
+      for (ezUInt32 i = 0; i < NUM_SERIALIZED_OBJECTS; ++i)
+      {
+        ezReflectionSerializer::ReadObjectPropertiesFromBinary(reader, *ezGetStaticRTTI<ezSerializationPerfObject>(), &readObjects[i]);
+      }
+    }
+
+    ezTime t2 = ezTime::Now();
+
+    bool bEqual = true;
+    for (ezUInt32 i = 0; i < NUM_SERIALIZED_OBJECTS; ++i)
+    {
+      bEqual &= (readObjects[i] == objects[i]);
+    }
+    EZ_TEST_BOOL(bEqual);
+
+    ezLog::Info("[test]Binary Serialization: Write {0}ms, Read {1}ms ({2} objects, {3} bytes)", ezArgF((t1 - t0).GetMilliseconds(), 2),
+                ezArgF((t2 - t1).GetMilliseconds(), 2), NUM_SERIALIZED_OBJECTS, storage.GetStorageSize());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Clone")
+  {
+    ezDynamicArray<ezSerializationPerfObject> clones;
+    clones.SetCount(NUM_SERIALIZED_OBJECTS);
+
+    ezTime t0 = ezTime::Now();
+
+    for (ezUInt32 i = 0; i < NUM_SERIALIZED_OBJECTS; ++i)
+    {
+      ezReflectionSerializer::Clone(&objects[i], &clones[i], ezGetStaticRTTI<ezSerializationPerfObject>());
+    }
+
+    ezTime t1 = ezTime::Now();
+
+    bool bEqual = true;
+    for (ezUInt32 i = 0; i < NUM_SERIALIZED_OBJECTS; ++i)
+    {
+      bEqual &= (clones[i] == objects[i]);
+    }
+    EZ_TEST_BOOL(bEqual);
+
+    ezLog::Info("[test]Clone: {0}ms ({1} objects)", ezArgF((t1 - t0).GetMilliseconds(), 2), NUM_SERIALIZED_OBJECTS);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Clear Plan Cache")
+  {
+    // plans that one thread uses must stay valid while another thread clears the cache
+    ClearPlanCacheThread clearThread;
+    clearThread.Start();
+
+    ezSerializationPerfObject clone;
+    bool bEqual = true;
+
+    for (ezUInt32 uiRound = 0; uiRound < 100 || clearThread.m_iNumClears < 10; ++uiRound)
+    {
+      for (ezUInt32 i = 0; i < 100; ++i)
+      {
+        ezReflectionSerializer::Clone(&objects[i], &clone, ezGetStaticRTTI<ezSerializationPerfObject>());
+        bEqual &= (clone == objects[i]);
+      }
+    }
+
+    clearThread.m_iStop = 1;
+    clearThread.Join();
+
+    EZ_TEST_BOOL(bEqual);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Graph Diff")
+  {
+    ezAbstractObjectGraph baseGraph;
+    ezAbstractObjectGraph graph;
+
+    ezTime t0 = ezTime::Now();
+
+    BuildPerfGraph(baseGraph, NUM_SERIALIZED_OBJECTS, false);
+    BuildPerfGraph(graph, NUM_SERIALIZED_OBJECTS, true);
+
+    ezTime t1 = ezTime::Now();
+
+    ezDeque<ezAbstractGraphDiffOperation> diff;
+    graph.CreateDiffWithBaseGraph(baseGraph, diff);
+
+    ezTime t2 = ezTime::Now();
+
+    const ezUInt32 uiNumRemoved = NUM_SERIALIZED_OBJECTS / 100;
+    const ezUInt32 uiNumAdded = NUM_SERIALIZED_OBJECTS / 100;
+    const ezUInt32 uiNumChanged = NUM_SERIALIZED_OBJECTS / 10;
+    EZ_TEST_INT(diff.GetCount(), uiNumRemoved + uiNumAdded * (1 + NUM_GRAPH_NODE_PROPERTIES) + uiNumChanged);
+
+    // the diff must not depend on the order of the hash tables, each section is sorted by guid
+    {
+      bool bSorted = true;
+      ezUuid lastRemoved, lastAdded, lastChanged;
+      for (const ezAbstractGraphDiffOperation& op : diff)
+      {
+        switch (op.m_Operation)
+        {
+          case ezAbstractGraphDiffOperation::Op::NodeRemoved:
+            bSorted &= !lastRemoved.IsValid() || lastRemoved < op.m_Node;
+            lastRemoved = op.m_Node;
+            break;
+
+          case ezAbstractGraphDiffOperation::Op::NodeAdded:
+            bSorted &= !lastAdded.IsValid() || lastAdded < op.m_Node;
+            lastAdded = op.m_Node;
+            break;
+
+          case ezAbstractGraphDiffOperation::Op::PropertyChanged:
+            // the properties of added nodes directly follow their NodeAdded operation
+            if (op.m_Node == lastAdded)
+              break;
+            bSorted &= !lastChanged.IsValid() || !(op.m_Node < lastChanged);
+            lastChanged = op.m_Node;
+            break;
+        }
+      }
+      EZ_TEST_BOOL(bSorted);
+    }
+
+    ezDeque<ezAbstractGraphDiffOperation> mergedDiff;
+    baseGraph.MergeDiffs(diff, diff, mergedDiff);
+
+    ezTime t3 = ezTime::Now();
+
+    EZ_TEST_INT(mergedDiff.GetCount(), diff.GetCount());
+
+    baseGraph.ApplyDiff(mergedDiff);
+
+    ezTime t4 = ezTime::Now();
+
+    EZ_TEST_INT(baseGraph.GetAllNodes().GetCount(), graph.GetAllNodes().GetCount());
+
+    graph.CreateDiffWithBaseGraph(baseGraph, diff);
+    EZ_TEST_BOOL(diff.IsEmpty());
+
+    ezLog::Info("[test]Graph Diff: Build {0}ms, Diff {1}ms, Merge {2}ms, Apply {3}ms ({4} nodes)", ezArgF((t1 - t0).GetMilliseconds(), 2),
+      ezArgF((t2 - t1).GetMilliseconds(), 2), ezArgF((t3 - t2).GetMilliseconds(), 2), ezArgF((t4 - t3).GetMilliseconds(), 2), NUM_SERIALIZED_OBJECTS);
+  }
+}
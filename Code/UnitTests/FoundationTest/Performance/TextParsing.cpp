@@ -0,0 +1,163 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/JSONParser.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/IO/OpenDdlParser.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+  enum TextParsingConstants
+  {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+    NUM_PARSED_OBJECTS = 1000 * 5,
+#else
+    NUM_PARSED_OBJECTS = 1000 * 100,
+#endif
+  };
+
+  /// Only counts what it encounters, so that the time is spent in the parser itself.
+  class CountingDdlParser : public ezOpenDdlParser
+  {
+  public:
+    ezResult Parse(ezStreamReader& stream)
+    {
+      SetLogInterface(ezLog::GetThreadLocalLogSystem());
+      SetInputStream(stream);
+      return ParseAll();
+    }
+
+    ezUInt32 m_uiNumObjects = 0;
+    ezUInt32 m_uiNumValues = 0;
+
+  protected:
+    virtual void OnBeginObject(const char* szType, const char* szName, bool bGlobalName) override { ++m_uiNumObjects; }
+    virtual void OnEndObject() override {}
+    virtual void OnBeginPrimitiveList(ezOpenDdlPrimitiveType type, const char* szName, bool bGlobalName) override {}
+    virtual void OnEndPrimitiveList() override {}
+    virtual void OnPrimitiveBool(ezUInt32 count, const bool* pData, bool bThisIsAll) override { m_uiNumValues += count; }
+    virtual void OnPrimitiveInt8(ezUInt32 count, const ezInt8* pData, bool bThisIsAll) override { m_uiNumValues += count; }
+    virtual void OnPrimitiveInt16(ezUInt32 count, const ezInt16* pData, bool bThisIsAll) override { m_uiNumValues += count; }
+    virtual void OnPrimitiveInt32(ezUInt32 count, const ezInt32* pData, bool bThisIsAll) override { m_uiNumValues += count; }
+    virtual void OnPrimitiveInt64(ezUInt32 count, const ezInt64* pData, bool bThisIsAll) override { m_uiNumValues += count; }
+    virtual void OnPrimitiveUInt8(ezUInt32 count, const ezUInt8* pData, bool bThisIsAll) override { m_uiNumValues += count; }
+    virtual void OnPrimitiveUInt16(ezUInt32 count, const ezUInt16* pData, bool bThisIsAll) override { m_uiNumValues += count; }
+    virtual void OnPrimitiveUInt32(ezUInt32 count, const ezUInt32* pData, bool bThisIsAll) override { m_uiNumValues += count; }
+    virtual void OnPrimitiveUInt64(ezUInt32 count, const ezUInt64* pData, bool bThisIsAll) override { m_uiNumValues += count; }
+    virtual void OnPrimitiveFloat(ezUInt32 count, const float* pData, bool bThisIsAll) override { m_uiNumValues += count; }
+    virtual void OnPrimitiveDouble(ezUInt32 count, const double* pData, bool bThisIsAll) override { m_uiNumValues += count; }
+    virtual void OnPrimitiveString(ezUInt32 count, const ezStringView* pData, bool bThisIsAll) override { m_uiNumValues += count; }
+  };
+
+  class CountingJsonParser : public ezJSONParser
+  {
+  public:
+    void Parse(ezStreamReader& stream)
+    {
+      SetLogInterface(ezLog::GetThreadLocalLogSystem());
+      SetInputStream(stream);
+      ParseAll();
+    }
+
+    ezUInt32 m_uiNumObjects = 0;
+    ezUInt32 m_uiNumValues = 0;
+
+  private:
+    virtual bool OnVariable(const char* szVarName) override { return true; }
+    virtual void OnReadValue(const char* szValue) override { ++m_uiNumValues; }
+    virtual void OnReadValue(double fValue) override { ++m_uiNumValues; }
+    virtual void OnReadValue(bool bValue) override { ++m_uiNumValues; }
+    virtual void OnReadValueNULL() override { ++m_uiNumValues; }
+    virtual void OnBeginObject() override { ++m_uiNumObjects; }
+    virtual void OnEndObject() override {}
+    virtual void OnBeginArray() override {}
+    virtual void OnEndArray() override {}
+  };
+
+  double GetThroughput(ezUInt32 uiNumBytes, ezTime duration)
+  {
+    return (uiNumBytes / (1024.0 * 1024.0)) / duration.GetSeconds();
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Performance, TextParsing)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "OpenDDL")
+  {
+    ezMemoryStreamStorage storage;
+
+    {
+      ezMemoryStreamWriter writer(&storage);
+      ezStringBuilder sObject, sNumber;
+
+      for (ezUInt32 i = 0; i < NUM_PARSED_OBJECTS; ++i)
+      {
+        sNumber.Format("{0}", i);
+
+        sObject.Set("Object %obj", sNumber, "\n{\n");
+        sObject.Append("  string %Name{\"Object number ", sNumber, " with a somewhat longer name\"}\n");
+        sObject.Append("  float %Position{", sNumber, ".5, 2.25, -3.125, 4, 5.5, 6.75, 7, 8.125}\n");
+        sObject.Append("  int32 %Values{", sNumber, ", 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}\n");
+        sObject.Append("  // a comment that has to be skipped\n}\n");
+
+        writer.WriteBytes(sObject.GetData(), sObject.GetElementCount());
+      }
+    }
+
+    CountingDdlParser parser;
+    ezMemoryStreamReader reader(&storage);
+
+    ezTime t0 = ezTime::Now();
+    EZ_TEST_BOOL(parser.Parse(reader).Succeeded());
+    ezTime t1 = ezTime::Now();
+
+    EZ_TEST_INT(parser.m_uiNumObjects, NUM_PARSED_OBJECTS);
+    EZ_TEST_INT(parser.m_uiNumValues, NUM_PARSED_OBJECTS * (1 + 8 + 16));
+
+    ezLog::Info("[test]OpenDDL Parsing: {0} MB/s ({1} bytes in {2}ms)", ezArgF(GetThroughput(storage.GetStorageSize(), t1 - t0), 2),
+                storage.GetStorageSize(), ezArgF((t1 - t0).GetMilliseconds(), 2));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "JSON")
+  {
+    ezMemoryStreamStorage storage;
+
+    {
+      ezMemoryStreamWriter writer(&storage);
+      ezStringBuilder sObject, sNumber;
+
+      sObject = "{\n  \"objects\" :\n  [\n";
+      writer.WriteBytes(sObject.GetData(), sObject.GetElementCount());
+
+      for (ezUInt32 i = 0; i < NUM_PARSED_OBJECTS; ++i)
+      {
+        sNumber.Format("{0}", i);
+
+        sObject.Set("    {\n      \"name\" : \"Object number ", sNumber, " with a somewhat longer name\",\n");
+        sObject.Append("      \"position\" : [", sNumber, ".5, 2.25, -3.125, 4, 5.5, 6.75, 7, 8.125],\n");
+        sObject.Append("      \"visible\" : true\n    }");
+        sObject.Append(i + 1 < NUM_PARSED_OBJECTS ? ",\n" : "\n");
+
+        writer.WriteBytes(sObject.GetData(), sObject.GetElementCount());
+      }
+
+      sObject = "  ]\n}\n";
+      writer.WriteBytes(sObject.GetData(), sObject.GetElementCount());
+    }
+
+    CountingJsonParser parser;
+    ezMemoryStreamReader reader(&storage);
+
+    ezTime t0 = ezTime::Now();
+    parser.Parse(reader);
+    ezTime t1 = ezTime::Now();
+
+    EZ_TEST_INT(parser.m_uiNumObjects, NUM_PARSED_OBJECTS + 1);
+    EZ_TEST_INT(parser.m_uiNumValues, NUM_PARSED_OBJECTS * (1 + 8 + 1));
+
+    ezLog::Info("[test]JSON Parsing: {0} MB/s ({1} bytes in {2}ms)", ezArgF(GetThroughput(storage.GetStorageSize(), t1 - t0), 2),
+                storage.GetStorageSize(), ezArgF((t1 - t0).GetMilliseconds(), 2));
+  }
+}
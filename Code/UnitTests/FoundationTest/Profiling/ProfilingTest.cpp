@@ -2,8 +2,11 @@
 
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/DelegateTask.h>
 #include <Foundation/Threading/ThreadUtils.h>
+#include <TestFramework/Utilities/TestLogInterface.h>
 
 namespace
 {
@@ -53,3 +56,170 @@ EZ_CREATE_SIMPLE_TEST(Profiling, Profiling)
     WriteOutProfilingCapture(":output/profilingScopes.json");
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(Profiling, StreamingCapture)
+{
+  ezMemoryStreamStorage storage;
+  ezUInt64 uiTaskFlowId = 0;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Capture")
+  {
+    ezMemoryStreamWriter writer(&storage);
+
+    EZ_TEST_BOOL(ezProfilingSystem::StartStreamingCapture(writer).Succeeded());
+    EZ_TEST_BOOL(ezProfilingSystem::IsStreamingCapture());
+    EZ_TEST_BOOL(ezProfilingSystem::StartStreamingCapture(writer).Failed());
+
+    ezProfilingSystem::StartNewFrame();
+
+    {
+      EZ_PROFILE_SCOPE("Streaming Outer");
+
+      const ezTime endTime = ezTime::Now() + ezTime::Milliseconds(1);
+      while (ezTime::Now() < endTime)
+      {
+      }
+    }
+
+    ezProfilingSystem::AddCounterValue("Streaming Counter", 42.0);
+
+    ezSharedPtr<ezTask> pTask0 = EZ_DEFAULT_NEW(ezDelegateTask<void>, "Streaming Task 0", []() { ezThreadUtils::Sleep(ezTime::Milliseconds(1)); });
+    ezSharedPtr<ezTask> pTask1 = EZ_DEFAULT_NEW(ezDelegateTask<void>, "Streaming Task 1", []() { ezThreadUtils::Sleep(ezTime::Milliseconds(1)); });
+
+    ezTaskGroupID group0 = ezTaskSystem::StartSingleTask(pTask0, ezTaskPriority::ThisFrame);
+    ezTaskGroupID group1 = ezTaskSystem::StartSingleTask(pTask1, ezTaskPriority::ThisFrame, group0);
+    uiTaskFlowId = group1.GetProfilingFlowId();
+    ezTaskSystem::WaitForGroup(group1);
+
+    ezProfilingSystem::StartNewFrame();
+
+    EZ_TEST_BOOL(ezProfilingSystem::StopStreamingCapture().Succeeded());
+    EZ_TEST_BOOL(!ezProfilingSystem::IsStreamingCapture());
+    EZ_TEST_BOOL(ezProfilingSystem::StopStreamingCapture().Failed());
+
+    // not recorded anymore
+    ezProfilingSystem::AddCounterValue("Streaming Counter", 1.0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Read")
+  {
+    ezMemoryStreamReader reader(&storage);
+
+    ezProfilingSystem::ProfilingData data;
+    EZ_TEST_BOOL(ezProfilingSystem::ReadStreamingCapture(reader, data).Succeeded());
+
+    EZ_TEST_INT(data.m_uiFrameCount, 2);
+    EZ_TEST_INT(data.m_FrameStartTimes.GetCount(), 2);
+
+    const ezUInt64 uiMainThreadId = (ezUInt64)ezThreadUtils::GetCurrentThreadID();
+
+    bool bFoundScope = false;
+    bool bFoundTaskScope = false;
+    for (const auto& eventBuffer : data.m_AllEventBuffers)
+    {
+      for (const auto& scope : eventBuffer.m_Data)
+      {
+        if (ezStringUtils::IsEqual(scope.m_szName, "Streaming Outer"))
+        {
+          bFoundScope = true;
+          EZ_TEST_INT(eventBuffer.m_uiThreadId, uiMainThreadId);
+          EZ_TEST_BOOL(scope.m_szFunctionName != nullptr);
+          EZ_TEST_BOOL(scope.m_EndTime - scope.m_BeginTime >= ezTime::Milliseconds(1));
+        }
+
+        bFoundTaskScope |= ezStringUtils::IsEqual(scope.m_szName, "Streaming Task 1");
+      }
+    }
+    EZ_TEST_BOOL(bFoundScope);
+    EZ_TEST_BOOL(bFoundTaskScope);
+
+    bool bFoundCounter = false;
+    bool bFoundMemoryCounter = false;
+    for (const auto& value : data.m_CounterValues)
+    {
+      if (ezStringUtils::IsEqual(value.m_szName, "Streaming Counter"))
+      {
+        EZ_TEST_BOOL(!bFoundCounter);
+        EZ_TEST_DOUBLE(value.m_fValue, 42.0, 0.0);
+        bFoundCounter = true;
+      }
+
+      bFoundMemoryCounter |= ezStringUtils::StartsWith(value.m_szName, "Memory/");
+    }
+    EZ_TEST_BOOL(bFoundCounter);
+    EZ_TEST_BOOL(bFoundMemoryCounter);
+
+    ezUInt32 uiTaskFlowEvents[3] = {};
+    ezUInt32 uiDependencyFlowEvents = 0;
+    ezHashSet<ezUInt64> taskGroupFlowIds;
+    for (const auto& flowEvent : data.m_FlowEvents)
+    {
+      if (ezStringUtils::IsEqual(flowEvent.m_szName, "Task Group"))
+      {
+        taskGroupFlowIds.Insert(flowEvent.m_uiFlowId);
+
+        if (flowEvent.m_uiFlowId == uiTaskFlowId)
+          ++uiTaskFlowEvents[(int)flowEvent.m_Type];
+      }
+    }
+    for (const auto& flowEvent : data.m_FlowEvents)
+    {
+      if (ezStringUtils::IsEqual(flowEvent.m_szName, "Task Group Dependency"))
+      {
+        ++uiDependencyFlowEvents;
+        EZ_TEST_BOOL(!taskGroupFlowIds.Contains(flowEvent.m_uiFlowId));
+      }
+    }
+    EZ_TEST_INT(uiTaskFlowEvents[(int)ezProfilingSystem::FlowEventType::Start], 1);
+    EZ_TEST_INT(uiTaskFlowEvents[(int)ezProfilingSystem::FlowEventType::Step], 1);
+    EZ_TEST_INT(uiTaskFlowEvents[(int)ezProfilingSystem::FlowEventType::Finish], 1);
+    EZ_TEST_INT(uiDependencyFlowEvents, 2);
+
+    ezMemoryStreamStorage jsonStorage;
+    ezMemoryStreamWriter jsonWriter(&jsonStorage);
+    EZ_TEST_BOOL(data.Write(jsonWriter).Succeeded());
+    jsonWriter.WriteBytes("", 1).IgnoreResult();
+
+    const char* szJson = reinterpret_cast<const char*>(jsonStorage.GetData());
+    EZ_TEST_BOOL(ezStringUtils::FindSubString(szJson, "\"Streaming Outer\"") != nullptr);
+    EZ_TEST_BOOL(ezStringUtils::FindSubString(szJson, "\"ph\":\"s\"") != nullptr);
+    EZ_TEST_BOOL(ezStringUtils::FindSubString(szJson, "\"ph\":\"C\"") != nullptr);
+
+    // flow IDs are only unique per capture, the flows of merged captures must not be connected with each other
+    const ezProfilingSystem::ProfilingData* inputs[] = {&data, &data};
+    ezProfilingSystem::ProfilingData merged;
+    ezProfilingSystem::ProfilingData::Merge(merged, ezMakeArrayPtr(inputs));
+
+    const ezUInt32 uiNumFlowEvents = data.m_FlowEvents.GetCount();
+    if (EZ_TEST_INT(merged.m_FlowEvents.GetCount(), uiNumFlowEvents * 2).Succeeded())
+    {
+      ezHashSet<ezUInt64> firstCaptureFlowIds;
+      for (ezUInt32 i = 0; i < uiNumFlowEvents; ++i)
+      {
+        firstCaptureFlowIds.Insert(merged.m_FlowEvents[i].m_uiFlowId);
+      }
+
+      for (ezUInt32 i = 0; i < uiNumFlowEvents; ++i)
+      {
+        const auto& flowEvent = merged.m_FlowEvents[uiNumFlowEvents + i];
+        EZ_TEST_BOOL(!firstCaptureFlowIds.Contains(flowEvent.m_uiFlowId));
+        EZ_TEST_BOOL(flowEvent.m_Type == data.m_FlowEvents[i].m_Type);
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Invalid Data")
+  {
+    ezMemoryStreamStorage invalidStorage;
+    ezMemoryStreamWriter writer(&invalidStorage);
+    writer << "Not a capture";
+
+    ezTestLogInterface log;
+    ezTestLogSystemScope logSystemScope(&log);
+    log.ExpectMessage("Not a streaming profiling capture", ezLogMsgType::ErrorMsg);
+
+    ezMemoryStreamReader reader(&invalidStorage);
+    ezProfilingSystem::ProfilingData data;
+    EZ_TEST_BOOL(ezProfilingSystem::ReadStreamingCapture(reader, data).Failed());
+  }
+}
@@ -0,0 +1,191 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/MutexProfiling.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Threading/ThreadUtils.h>
+
+namespace
+{
+  class MutexTestThread : public ezThread
+  {
+  public:
+    MutexTestThread()
+      : ezThread("Mutex Test Thread")
+    {
+    }
+
+    ezMutex* m_pMutex = nullptr;
+    bool m_bTryLock = false;
+    bool m_bAcquired = false;
+
+    virtual ezUInt32 Run()
+    {
+      if (m_bTryLock)
+      {
+        m_bAcquired = m_pMutex->TryLock();
+      }
+      else
+      {
+        m_pMutex->Lock();
+        m_bAcquired = true;
+      }
+
+      if (m_bAcquired)
+      {
+        m_pMutex->Unlock();
+      }
+
+      return 0;
+    }
+  };
+
+#if EZ_ENABLED(EZ_USE_MUTEX_PROFILING)
+  /// \brief Uses its own mutex, which shares its stats with the mutexes of the other threads, because they all have the same name.
+  class MutexProfilingTestThread : public ezThread
+  {
+  public:
+    MutexProfilingTestThread()
+      : ezThread("Mutex Profiling Test Thread")
+    {
+    }
+
+    virtual ezUInt32 Run()
+    {
+      ezMutex mutex("MutexTestShared");
+
+      for (ezUInt32 i = 0; i < 10000; ++i)
+      {
+        mutex.Lock();
+        mutex.Unlock();
+      }
+
+      return 0;
+    }
+  };
+#endif
+
+  void TestMutex(ezMutex& mutex)
+  {
+    EZ_TEST_BOOL(!mutex.IsLocked());
+
+    {
+      EZ_LOCK(mutex);
+      EZ_TEST_BOOL(mutex.IsLocked());
+
+      // recursive locking
+      EZ_TEST_BOOL(mutex.TryLock());
+      mutex.Lock();
+      mutex.Unlock();
+      mutex.Unlock();
+      EZ_TEST_BOOL(mutex.IsLocked());
+
+      // another thread can't acquire the mutex
+      MutexTestThread thread;
+      thread.m_pMutex = &mutex;
+      thread.m_bTryLock = true;
+      thread.Start();
+      thread.Join();
+      EZ_TEST_BOOL(!thread.m_bAcquired);
+    }
+
+    EZ_TEST_BOOL(!mutex.IsLocked());
+
+    MutexTestThread thread;
+    thread.m_pMutex = &mutex;
+    thread.m_bTryLock = true;
+    thread.Start();
+    thread.Join();
+    EZ_TEST_BOOL(thread.m_bAcquired);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Threading, Mutex)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Unnamed Mutex")
+  {
+    ezMutex mutex;
+    TestMutex(mutex);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Named Mutex")
+  {
+    ezMutex mutex("MutexTest");
+    TestMutex(mutex);
+  }
+
+#if EZ_ENABLED(EZ_USE_MUTEX_PROFILING)
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Profiling")
+  {
+    ezMutex mutex("MutexTest");
+    ezMutex mutex2("MutexTest");
+
+    const ezMutexProfilingStats* pStats = ezMutexProfiling::GetStats("MutexTest");
+    EZ_TEST_BOOL(pStats != nullptr);
+    EZ_TEST_BOOL(ezMutexProfiling::GetStats("MutexTest_DoesNotExist") == nullptr);
+
+    ezMutexProfiling::ResetStats();
+    EZ_TEST_INT(pStats->m_uiAcquisitions, 0);
+
+    // mutexes with the same name share their stats
+    mutex.Lock();
+    mutex.Lock();
+    mutex.Unlock();
+    mutex.Unlock();
+    mutex2.Lock();
+    mutex2.Unlock();
+    EZ_TEST_INT(pStats->m_uiAcquisitions, 3);
+    EZ_TEST_INT(pStats->m_uiContentions, 0);
+
+    {
+      MutexTestThread thread;
+      thread.m_pMutex = &mutex;
+
+      mutex.Lock();
+      thread.Start();
+      ezThreadUtils::Sleep(ezTime::Milliseconds(50));
+      mutex.Unlock();
+
+      thread.Join();
+      EZ_TEST_BOOL(thread.m_bAcquired);
+    }
+
+    EZ_TEST_INT(pStats->m_uiAcquisitions, 5);
+    EZ_TEST_INT(pStats->m_uiContentions, 1);
+    EZ_TEST_BOOL(pStats->m_fTotalWaitTime > 0.0);
+    EZ_TEST_BOOL(pStats->m_fMaxWaitTime <= pStats->m_fTotalWaitTime);
+    EZ_TEST_BOOL(pStats->m_fTotalHoldTime >= 0.04);
+    EZ_TEST_BOOL(pStats->m_fMaxHoldTime >= 0.04);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Profiling Shared Stats")
+  {
+    ezMutex mutex("MutexTestShared");
+
+    const ezMutexProfilingStats* pStats = ezMutexProfiling::GetStats("MutexTestShared");
+    EZ_TEST_BOOL(pStats != nullptr);
+
+    ezMutexProfiling::ResetStats();
+
+    // different mutexes with the same name are used concurrently, none of the updates may get lost
+    MutexProfilingTestThread threads[4];
+
+    for (MutexProfilingTestThread& thread : threads)
+    {
+      thread.Start();
+    }
+
+    for (MutexProfilingTestThread& thread : threads)
+    {
+      thread.Join();
+    }
+
+    EZ_TEST_INT(pStats->m_uiAcquisitions, 40000);
+    EZ_TEST_INT(pStats->m_uiContentions, 0);
+    EZ_TEST_BOOL(pStats->m_fMaxHoldTime <= pStats->m_fTotalHoldTime);
+
+    void* stackTrace[ezMutexProfilingStats::MAX_STACK_TRACE_LENGTH];
+    EZ_TEST_INT(ezMutexProfiling::GetSlowestWaitStackTrace(*pStats, ezArrayPtr<void*>(stackTrace)), 0);
+  }
+#endif
+}
@@ -0,0 +1,108 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Utilities/Metrics.h>
+#include <Foundation/Utilities/Stats.h>
+
+EZ_CREATE_SIMPLE_TEST(Utility, Metrics)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Invalid Handles")
+  {
+    ezMetricCounter counter;
+    ezMetricGauge gauge;
+    ezMetricHistogram histogram;
+
+    EZ_TEST_BOOL(!counter.IsValid());
+    EZ_TEST_BOOL(!gauge.IsValid());
+    EZ_TEST_BOOL(!histogram.IsValid());
+
+    // these must not crash
+    counter.Increment();
+    gauge.Set(5);
+    histogram.Record(1.0);
+
+    ezMetrics::Unregister(counter);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Counter")
+  {
+    ezMetricCounter counter = ezMetrics::RegisterCounter("MetricsTest/Counter");
+    EZ_TEST_BOOL(counter.IsValid());
+
+    ezMetrics::UpdateStats();
+    EZ_TEST_INT(ezStats::GetStat("MetricsTest/Counter").ConvertTo<ezInt64>(), 0);
+
+    ezTaskSystem::ParallelForIndexed(0, 1000, [&](ezUInt32 uiStart, ezUInt32 uiEnd) {
+      for (ezUInt32 i = uiStart; i < uiEnd; ++i)
+      {
+        counter.Increment();
+      }
+    });
+    counter.Add(10);
+
+    // nothing is published until the next update
+    EZ_TEST_INT(ezStats::GetStat("MetricsTest/Counter").ConvertTo<ezInt64>(), 0);
+
+    ezMetrics::UpdateStats();
+    EZ_TEST_INT(ezStats::GetStat("MetricsTest/Counter").ConvertTo<ezInt64>(), 1010);
+
+    ezMetrics::Unregister(counter);
+    EZ_TEST_BOOL(!counter.IsValid());
+    EZ_TEST_BOOL(!ezStats::GetAllStats().Contains("MetricsTest/Counter"));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Gauge")
+  {
+    // registering the same name twice returns the same metric
+    ezMetricGauge gauge1 = ezMetrics::RegisterGauge("MetricsTest/Gauge");
+    ezMetricGauge gauge2 = ezMetrics::RegisterGauge("MetricsTest/Gauge");
+
+    gauge1.Set(42);
+    gauge2.Add(-2);
+
+    ezMetrics::UpdateStats();
+    EZ_TEST_INT(ezStats::GetStat("MetricsTest/Gauge").ConvertTo<ezInt64>(), 40);
+
+    // the stat stays until all handles are unregistered
+    ezMetrics::Unregister(gauge1);
+    ezMetrics::UpdateStats();
+    EZ_TEST_INT(ezStats::GetStat("MetricsTest/Gauge").ConvertTo<ezInt64>(), 40);
+
+    ezMetrics::Unregister(gauge2);
+    EZ_TEST_BOOL(!ezStats::GetAllStats().Contains("MetricsTest/Gauge"));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Histogram")
+  {
+    const double bounds[] = {1.0, 10.0, 100.0};
+    ezMetricHistogram histogram = ezMetrics::RegisterHistogram("MetricsTest/Histogram", bounds);
+
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      histogram.Record(i);
+    }
+
+    histogram.Record(1000.0);
+
+    ezMetrics::UpdateStats();
+    EZ_TEST_INT(ezStats::GetStat("MetricsTest/Histogram/Count").ConvertTo<ezInt64>(), 101);
+    EZ_TEST_INT(ezStats::GetStat("MetricsTest/Histogram/Buckets/<= 1").ConvertTo<ezInt64>(), 2);
+    EZ_TEST_INT(ezStats::GetStat("MetricsTest/Histogram/Buckets/<= 10").ConvertTo<ezInt64>(), 9);
+    EZ_TEST_INT(ezStats::GetStat("MetricsTest/Histogram/Buckets/<= 100").ConvertTo<ezInt64>(), 89);
+    EZ_TEST_INT(ezStats::GetStat("MetricsTest/Histogram/Buckets/> 100").ConvertTo<ezInt64>(), 1);
+    EZ_TEST_STRING(ezStats::GetStat("MetricsTest/Histogram/P50").ConvertTo<ezString>(), "<= 100");
+    EZ_TEST_STRING(ezStats::GetStat("MetricsTest/Histogram/P99").ConvertTo<ezString>(), "<= 100");
+
+    // histograms only publish what was recorded since the previous update
+    histogram.Record(0.5);
+    ezMetrics::UpdateStats();
+    EZ_TEST_INT(ezStats::GetStat("MetricsTest/Histogram/Count").ConvertTo<ezInt64>(), 1);
+    EZ_TEST_INT(ezStats::GetStat("MetricsTest/Histogram/Buckets/<= 1").ConvertTo<ezInt64>(), 1);
+    EZ_TEST_INT(ezStats::GetStat("MetricsTest/Histogram/Buckets/> 100").ConvertTo<ezInt64>(), 0);
+    EZ_TEST_STRING(ezStats::GetStat("MetricsTest/Histogram/P90").ConvertTo<ezString>(), "<= 1");
+
+    ezMetrics::Unregister(histogram);
+    EZ_TEST_BOOL(!ezStats::GetAllStats().Contains("MetricsTest/Histogram/Count"));
+    EZ_TEST_BOOL(!ezStats::GetAllStats().Contains("MetricsTest/Histogram/P50"));
+  }
+}
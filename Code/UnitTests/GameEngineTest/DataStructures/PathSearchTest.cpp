@@ -0,0 +1,241 @@
+#include <GameEngineTestPCH.h>
+
+#include <Foundation/Math/Random.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <Utilities/DataStructures/GameGrid.h>
+#include <Utilities/PathFinding/GraphSearch.h>
+
+namespace PathSearchTestDetail
+{
+  using Grid = ezGameGrid<ezUInt8>;
+
+  /// \brief Expands the 4 direct neighbors of a grid cell, cells with a value of 0 are blocked.
+  class GridStateGenerator : public ezPathStateGenerator<ezPathState>
+  {
+  public:
+    GridStateGenerator(const Grid& grid)
+      : m_Grid(grid)
+    {
+    }
+
+    virtual void StartSearch(ezInt64 iStartNodeIndex, const ezPathState* pStartState, ezInt64 iTargetNodeIndex) override
+    {
+      m_vTarget = m_Grid.ConvertCellIndexToCoordinate(static_cast<ezUInt32>(iTargetNodeIndex));
+    }
+
+    virtual void GenerateAdjacentStates(ezInt64 iNodeIndex, const ezPathState& StartState, ezPathSearch<ezPathState>* pPathSearch) override
+    {
+      const ezVec2I32 vCell = m_Grid.ConvertCellIndexToCoordinate(static_cast<ezUInt32>(iNodeIndex));
+      const ezVec2I32 offsets[4] = {ezVec2I32(1, 0), ezVec2I32(-1, 0), ezVec2I32(0, 1), ezVec2I32(0, -1)};
+
+      for (const ezVec2I32& offset : offsets)
+      {
+        const ezVec2I32 vNeighbor = vCell + offset;
+
+        if (!m_Grid.IsValidCellCoordinate(vNeighbor) || m_Grid.GetCell(vNeighbor) == 0)
+          continue;
+
+        ezPathState state;
+        state.m_fCostToNode = StartState.m_fCostToNode + m_Grid.GetCell(vNeighbor);
+        state.m_fEstimatedCostToTarget =
+          state.m_fCostToNode + (float)(ezMath::Abs(m_vTarget.x - vNeighbor.x) + ezMath::Abs(m_vTarget.y - vNeighbor.y));
+
+        pPathSearch->AddPathNode(m_Grid.ConvertCellCoordinateToIndex(vNeighbor), state);
+      }
+    }
+
+  private:
+    const Grid& m_Grid;
+    ezVec2I32 m_vTarget = ezVec2I32(0, 0);
+  };
+
+  static void CreateGrid(Grid& grid, ezUInt16 uiSize, ezUInt32 uiSeed)
+  {
+    ezRandom rng;
+    rng.Initialize(uiSeed);
+
+    grid.CreateGrid(uiSize, uiSize);
+
+    for (ezUInt32 i = 0; i < grid.GetNumCells(); ++i)
+    {
+      // ~20% blocked cells, the rest with varying costs between 1 and 4
+      grid.GetCell(i) = rng.UIntInRange(10) < 2 ? 0 : static_cast<ezUInt8>(1 + rng.UIntInRange(4));
+    }
+  }
+
+  static void CreateRequests(const Grid& grid, ezUInt32 uiNumRequests, ezUInt32 uiSeed, ezDynamicArray<ezPathSearch<ezPathState>::PathRequest>& out_Requests)
+  {
+    ezRandom rng;
+    rng.Initialize(uiSeed);
+
+    out_Requests.SetCount(uiNumRequests);
+
+    for (auto& request : out_Requests)
+    {
+      do
+      {
+        request.m_iStartNodeIndex = rng.UIntInRange(grid.GetNumCells());
+      } while (grid.GetCell(static_cast<ezUInt32>(request.m_iStartNodeIndex)) == 0);
+
+      do
+      {
+        request.m_iTargetNodeIndex = rng.UIntInRange(grid.GetNumCells());
+      } while (grid.GetCell(static_cast<ezUInt32>(request.m_iTargetNodeIndex)) == 0);
+    }
+  }
+
+  static ezUniquePtr<ezPathStateGenerator<ezPathState>> CreateGenerator(const Grid* pGrid)
+  {
+    return EZ_DEFAULT_NEW(GridStateGenerator, *pGrid);
+  }
+} // namespace PathSearchTestDetail
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+static const ezTestBlock::Enum EnableInRelease = ezTestBlock::DisabledNoWarning;
+#else
+static const ezTestBlock::Enum EnableInRelease = ezTestBlock::Enabled;
+#endif
+
+EZ_CREATE_SIMPLE_TEST(DataStructures, PathSearch)
+{
+  using namespace PathSearchTestDetail;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindPath")
+  {
+    // 5x5 grid with a wall in the middle column that is only open at the top
+    Grid grid;
+    grid.CreateGrid(5, 5);
+    for (ezUInt32 i = 0; i < grid.GetNumCells(); ++i)
+      grid.GetCell(i) = 1;
+    for (ezInt32 y = 0; y < 4; ++y)
+      grid.GetCell(ezVec2I32(2, y)) = 0;
+
+    GridStateGenerator generator(grid);
+
+    ezPathSearch<ezPathState> search;
+    search.SetPathStateGenerator(&generator);
+
+    ezDeque<ezPathSearch<ezPathState>::PathResultData> path;
+
+    for (ezUInt32 uiDense : {0u, grid.GetNumCells()})
+    {
+      search.SetDenseNodeIndexRange(uiDense);
+
+      EZ_TEST_BOOL(search.FindPath(grid.ConvertCellCoordinateToIndex(ezVec2I32(0, 0)), ezPathState(),
+                     grid.ConvertCellCoordinateToIndex(ezVec2I32(4, 0)), path)
+                     .Succeeded());
+
+      // 4 steps up, 4 steps right, 4 steps down
+      EZ_TEST_INT(path.GetCount(), 13);
+      EZ_TEST_INT(path.PeekFront().m_iNodeIndex, grid.ConvertCellCoordinateToIndex(ezVec2I32(0, 0)));
+      EZ_TEST_INT(path.PeekBack().m_iNodeIndex, grid.ConvertCellCoordinateToIndex(ezVec2I32(4, 0)));
+      EZ_TEST_FLOAT(path.PeekBack().m_pPathState->m_fCostToNode, 12.0f, 0.0f);
+
+      for (ezUInt32 i = 1; i < path.GetCount(); ++i)
+      {
+        EZ_TEST_INT(path[i].m_pPathState->m_iReachedThroughNode, path[i - 1].m_iNodeIndex);
+      }
+
+      // close the wall entirely
+      grid.GetCell(ezVec2I32(2, 4)) = 0;
+      EZ_TEST_BOOL(search.FindPath(grid.ConvertCellCoordinateToIndex(ezVec2I32(0, 0)), ezPathState(),
+                     grid.ConvertCellCoordinateToIndex(ezVec2I32(4, 0)), path)
+                     .Failed());
+      grid.GetCell(ezVec2I32(2, 4)) = 1;
+
+      // cost limit
+      EZ_TEST_BOOL(search.FindPath(grid.ConvertCellCoordinateToIndex(ezVec2I32(0, 0)), ezPathState(),
+                     grid.ConvertCellCoordinateToIndex(ezVec2I32(4, 0)), path, 10.0f)
+                     .Failed());
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Dense / Sparse / Parallel")
+  {
+    Grid grid;
+    CreateGrid(grid, 64, 17);
+
+    ezDynamicArray<ezPathSearch<ezPathState>::PathRequest> requests;
+    CreateRequests(grid, 64, 23, requests);
+
+    GridStateGenerator generator(grid);
+
+    ezPathSearch<ezPathState> sparseSearch;
+    sparseSearch.SetPathStateGenerator(&generator);
+
+    ezPathSearch<ezPathState> denseSearch;
+    denseSearch.SetPathStateGenerator(&generator);
+    denseSearch.SetDenseNodeIndexRange(grid.GetNumCells());
+
+    ezPathSearch<ezPathState>::FindPathsParallel(
+      requests, [&grid]() { return CreateGenerator(&grid); }, grid.GetNumCells());
+
+    ezDeque<ezPathSearch<ezPathState>::PathResultData> sparsePath, densePath;
+
+    for (const auto& request : requests)
+    {
+      const ezResult sparseRes = sparseSearch.FindPath(request.m_iStartNodeIndex, ezPathState(), request.m_iTargetNodeIndex, sparsePath);
+      const ezResult denseRes = denseSearch.FindPath(request.m_iStartNodeIndex, ezPathState(), request.m_iTargetNodeIndex, densePath);
+
+      EZ_TEST_BOOL(sparseRes.Succeeded() == denseRes.Succeeded());
+      EZ_TEST_BOOL(sparseRes.Succeeded() == request.m_Result.Succeeded());
+
+      if (sparseRes.Failed())
+        continue;
+
+      // the heuristic is admissible, so all variants must find paths with the optimal cost
+      const float fCost = sparsePath.PeekBack().m_pPathState->m_fCostToNode;
+      EZ_TEST_FLOAT(densePath.PeekBack().m_pPathState->m_fCostToNode, fCost, 0.0f);
+      EZ_TEST_FLOAT(request.m_fPathCost, fCost, 0.0f);
+      EZ_TEST_INT(request.m_Path.PeekBack(), request.m_iTargetNodeIndex);
+      EZ_TEST_INT(request.m_Path[0], request.m_iStartNodeIndex);
+    }
+  }
+
+  EZ_TEST_BLOCK(EnableInRelease, "Profile 1000 paths on a 512x512 grid")
+  {
+    Grid grid;
+    CreateGrid(grid, 512, 42);
+
+    ezDynamicArray<ezPathSearch<ezPathState>::PathRequest> requests;
+    CreateRequests(grid, 1000, 7, requests);
+
+    GridStateGenerator generator(grid);
+    ezDeque<ezPathSearch<ezPathState>::PathResultData> path;
+
+    {
+      ezPathSearch<ezPathState> search;
+      search.SetPathStateGenerator(&generator);
+
+      ezStopwatch sw;
+      for (const auto& request : requests)
+      {
+        search.FindPath(request.m_iStartNodeIndex, ezPathState(), request.m_iTargetNodeIndex, path).IgnoreResult();
+      }
+
+      ezTestFramework::Output(ezTestOutput::Duration, "Serial, hash table states: %.2fms", sw.GetRunningTotal().GetMilliseconds());
+    }
+
+    {
+      ezPathSearch<ezPathState> search;
+      search.SetPathStateGenerator(&generator);
+      search.SetDenseNodeIndexRange(grid.GetNumCells());
+
+      ezStopwatch sw;
+      for (const auto& request : requests)
+      {
+        search.FindPath(request.m_iStartNodeIndex, ezPathState(), request.m_iTargetNodeIndex, path).IgnoreResult();
+      }
+
+      ezTestFramework::Output(ezTestOutput::Duration, "Serial, dense states: %.2fms", sw.GetRunningTotal().GetMilliseconds());
+    }
+
+    {
+      ezStopwatch sw;
+      ezPathSearch<ezPathState>::FindPathsParallel(
+        requests, [&grid]() { return CreateGenerator(&grid); }, grid.GetNumCells());
+
+      ezTestFramework::Output(ezTestOutput::Duration, "Parallel, dense states: %.2fms", sw.GetRunningTotal().GetMilliseconds());
+    }
+  }
+}
@@ -0,0 +1,332 @@
+#include <GameEngineTestPCH.h>
+
+#ifdef BUILDSYSTEM_ENABLE_RECAST_SUPPORT
+
+#  include <Foundation/IO/MemoryStream.h>
+#  include <Foundation/Time/Stopwatch.h>
+#  include <Foundation/Utilities/Progress.h>
+#  include <Recast/DetourNavMesh.h>
+#  include <Recast/DetourNavMeshQuery.h>
+#  include <RecastPlugin/NavMeshBuilder/NavMeshBuilder.h>
+#  include <RecastPlugin/Resources/RecastNavMeshResource.h>
+#  include <RecastPlugin/Utils/RcMath.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Navigation);
+
+namespace RecastNavMeshBuildTestDetail
+{
+  /// \brief Creates a slightly bumpy ground plane of uiSize x uiSize meters with a regular grid of boxes on top of it.
+  static void CreateTestGeometry(ezWorldGeoExtractionUtil::Geometry& geo, ezUInt32 uiSize, const ezVec3& vOffset = ezVec3::ZeroVector())
+  {
+    const ezUInt32 uiQuads = uiSize / 2;
+    const float fQuadSize = (float)uiSize / uiQuads;
+
+    for (ezUInt32 y = 0; y <= uiQuads; ++y)
+    {
+      for (ezUInt32 x = 0; x <= uiQuads; ++x)
+      {
+        auto& vtx = geo.m_Vertices.ExpandAndGetRef();
+        vtx.m_vPosition.Set(x * fQuadSize, y * fQuadSize, 0.2f * ezMath::Sin(ezAngle::Radian(x * 0.3f)) * ezMath::Cos(ezAngle::Radian(y * 0.2f)));
+        vtx.m_vPosition += vOffset;
+      }
+    }
+
+    for (ezUInt32 y = 0; y < uiQuads; ++y)
+    {
+      for (ezUInt32 x = 0; x < uiQuads; ++x)
+      {
+        const ezUInt32 v0 = y * (uiQuads + 1) + x;
+        const ezUInt32 v1 = v0 + 1;
+        const ezUInt32 v2 = v0 + uiQuads + 1;
+        const ezUInt32 v3 = v2 + 1;
+
+        auto& t0 = geo.m_Triangles.ExpandAndGetRef();
+        t0.m_uiVertexIndices[0] = v0;
+        t0.m_uiVertexIndices[1] = v1;
+        t0.m_uiVertexIndices[2] = v3;
+
+        auto& t1 = geo.m_Triangles.ExpandAndGetRef();
+        t1.m_uiVertexIndices[0] = v0;
+        t1.m_uiVertexIndices[1] = v3;
+        t1.m_uiVertexIndices[2] = v2;
+      }
+    }
+
+    for (ezUInt32 y = 5; y < uiSize; y += 10)
+    {
+      for (ezUInt32 x = 5; x < uiSize; x += 10)
+      {
+        auto& box = geo.m_BoxShapes.ExpandAndGetRef();
+        box.m_vPosition = ezVec3((float)x, (float)y, 1.0f) + vOffset;
+        box.m_qRotation.SetFromAxisAndAngle(ezVec3(0, 0, 1), ezAngle::Degree((float)(x + y)));
+        box.m_vHalfExtents.Set(1.5f, 1.0f, 1.0f);
+      }
+    }
+  }
+
+  static ezResult CreateDetourNavMesh(ezRecastNavMeshResourceDescriptor& desc, dtNavMesh& out_NavMesh)
+  {
+    // same setup as ezRecastNavMeshResource::CreateResource
+    dtNavMeshParams params;
+    params.orig[0] = 0.0f;
+    params.orig[1] = desc.m_vTileOrigin.y;
+    params.orig[2] = 0.0f;
+    params.tileWidth = desc.m_fTileWorldSize;
+    params.tileHeight = desc.m_fTileWorldSize;
+    params.maxTiles = desc.m_uiMaxTiles;
+    params.maxPolys = desc.m_uiMaxPolysPerTile;
+
+    if (dtStatusFailed(out_NavMesh.init(&params)))
+      return EZ_FAILURE;
+
+    for (auto& tile : desc.m_Tiles)
+    {
+      if (tile.m_DetourTileData.IsEmpty())
+        continue;
+
+      if (dtStatusFailed(out_NavMesh.addTile(tile.m_DetourTileData.GetData(), tile.m_DetourTileData.GetCount(), 0, 0, nullptr)))
+        return EZ_FAILURE;
+    }
+
+    return EZ_SUCCESS;
+  }
+} // namespace RecastNavMeshBuildTestDetail
+
+#  if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+static const ezTestBlock::Enum EnableInRelease = ezTestBlock::DisabledNoWarning;
+#  else
+static const ezTestBlock::Enum EnableInRelease = ezTestBlock::Enabled;
+#  endif
+
+EZ_CREATE_SIMPLE_TEST(Navigation, RecastNavMeshBuild)
+{
+  using namespace RecastNavMeshBuildTestDetail;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Tiled Build")
+  {
+    ezWorldGeoExtractionUtil::Geometry geo;
+    CreateTestGeometry(geo, 64);
+
+    ezRecastConfig config;
+    config.m_fTileSize = 16.0f;
+
+    ezProgress progress;
+    ezRecastNavMeshBuilder builder;
+    ezRecastNavMeshResourceDescriptor desc;
+
+    EZ_TEST_BOOL(builder.Build(config, geo, desc, progress).Succeeded());
+    EZ_TEST_BOOL(desc.m_DetourNavmeshData.IsEmpty());
+    EZ_TEST_BOOL(desc.m_Tiles.GetCount() >= 16);
+    EZ_TEST_INT(builder.GetNumBuiltTiles(), desc.m_Tiles.GetCount());
+    EZ_TEST_BOOL(desc.m_pNavMeshPolygons != nullptr);
+
+    dtNavMesh navMesh;
+    EZ_TEST_BOOL(CreateDetourNavMesh(desc, navMesh).Succeeded());
+
+    // round-trip through the serialized format
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    EZ_TEST_BOOL(desc.Serialize(writer).Succeeded());
+
+    ezRecastNavMeshResourceDescriptor desc2;
+    ezMemoryStreamReader reader(&storage);
+    EZ_TEST_BOOL(desc2.Deserialize(reader).Succeeded());
+    EZ_TEST_INT(desc2.m_Tiles.GetCount(), desc.m_Tiles.GetCount());
+    EZ_TEST_BOOL(desc2.m_pNavMeshPolygons != nullptr);
+
+    for (ezUInt32 i = 0; i < desc.m_Tiles.GetCount(); ++i)
+    {
+      EZ_TEST_BOOL(desc2.m_Tiles[i].m_DetourTileData == desc.m_Tiles[i].m_DetourTileData);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Incremental Build")
+  {
+    ezWorldGeoExtractionUtil::Geometry geo;
+    CreateTestGeometry(geo, 64);
+
+    ezRecastConfig config;
+    config.m_fTileSize = 16.0f;
+
+    ezProgress progress;
+    ezRecastNavMeshBuilder builder;
+    ezRecastNavMeshResourceDescriptor desc;
+    EZ_TEST_BOOL(builder.Build(config, geo, desc, progress).Succeeded());
+
+    // nothing changed -> nothing needs to be built
+    ezRecastNavMeshResourceDescriptor desc2;
+    EZ_TEST_BOOL(builder.Build(config, geo, desc2, progress, &desc).Succeeded());
+    EZ_TEST_INT(builder.GetNumBuiltTiles(), 0);
+    EZ_TEST_INT(desc2.m_Tiles.GetCount(), desc.m_Tiles.GetCount());
+
+    // move one box in the middle of a tile -> only the tiles that overlap it (plus their border) are rebuilt
+    geo.m_BoxShapes[0].m_vPosition.z += 0.5f;
+
+    ezRecastNavMeshResourceDescriptor desc3;
+    EZ_TEST_BOOL(builder.Build(config, geo, desc3, progress, &desc2).Succeeded());
+    EZ_TEST_BOOL(builder.GetNumBuiltTiles() > 0);
+    EZ_TEST_BOOL(builder.GetNumBuiltTiles() <= 4);
+    EZ_TEST_INT(desc3.m_Tiles.GetCount(), desc.m_Tiles.GetCount());
+
+    dtNavMesh navMesh;
+    EZ_TEST_BOOL(CreateDetourNavMesh(desc3, navMesh).Succeeded());
+
+    // a different configuration invalidates all tiles
+    config.m_fAgentRadius = 0.4f;
+    ezRecastNavMeshResourceDescriptor desc4;
+    EZ_TEST_BOOL(builder.Build(config, geo, desc4, progress, &desc3).Succeeded());
+    EZ_TEST_INT(builder.GetNumBuiltTiles(), desc4.m_Tiles.GetCount());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Empty Tiles")
+  {
+    ezWorldGeoExtractionUtil::Geometry geo;
+    CreateTestGeometry(geo, 64);
+
+    // a vertical wall far away from the ground, its tiles have geometry but no walkable area
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      auto& vtx = geo.m_Vertices.ExpandAndGetRef();
+      vtx.m_vPosition.Set(100.0f, i == 1 ? 4.0f : 0.0f, i == 2 ? 4.0f : 0.0f);
+    }
+
+    auto& wall = geo.m_Triangles.ExpandAndGetRef();
+    wall.m_uiVertexIndices[0] = geo.m_Vertices.GetCount() - 3;
+    wall.m_uiVertexIndices[1] = geo.m_Vertices.GetCount() - 2;
+    wall.m_uiVertexIndices[2] = geo.m_Vertices.GetCount() - 1;
+
+    ezRecastConfig config;
+    config.m_fTileSize = 16.0f;
+
+    ezProgress progress;
+    ezRecastNavMeshBuilder builder;
+    ezRecastNavMeshResourceDescriptor desc;
+    EZ_TEST_BOOL(builder.Build(config, geo, desc, progress).Succeeded());
+
+    ezUInt32 uiEmptyTiles = 0;
+    for (const auto& tile : desc.m_Tiles)
+    {
+      if (tile.m_DetourTileData.IsEmpty())
+      {
+        EZ_TEST_BOOL(tile.m_pTilePolygons == nullptr);
+        ++uiEmptyTiles;
+      }
+    }
+
+    EZ_TEST_BOOL(uiEmptyTiles > 0);
+
+    dtNavMesh navMesh;
+    EZ_TEST_BOOL(CreateDetourNavMesh(desc, navMesh).Succeeded());
+
+    // the empty tiles are cached like all others
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    EZ_TEST_BOOL(desc.Serialize(writer).Succeeded());
+
+    ezRecastNavMeshResourceDescriptor desc2;
+    ezMemoryStreamReader reader(&storage);
+    EZ_TEST_BOOL(desc2.Deserialize(reader).Succeeded());
+
+    ezRecastNavMeshResourceDescriptor desc3;
+    EZ_TEST_BOOL(builder.Build(config, geo, desc3, progress, &desc2).Succeeded());
+    EZ_TEST_INT(builder.GetNumBuiltTiles(), 0);
+    EZ_TEST_INT(desc3.m_Tiles.GetCount(), desc.m_Tiles.GetCount());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Negative Coordinates")
+  {
+    // the world min is neither at the origin nor on a tile boundary
+    const ezVec3 vOffset(-100.0f, -70.0f, -3.0f);
+
+    ezWorldGeoExtractionUtil::Geometry geo;
+    CreateTestGeometry(geo, 64, vOffset);
+
+    ezRecastConfig config;
+    config.m_fTileSize = 16.0f;
+
+    ezProgress progress;
+    ezRecastNavMeshBuilder builder;
+    ezRecastNavMeshResourceDescriptor desc;
+    EZ_TEST_BOOL(builder.Build(config, geo, desc, progress).Succeeded());
+    EZ_TEST_BOOL(desc.m_Tiles.GetCount() >= 16);
+
+    for (const auto& tile : desc.m_Tiles)
+    {
+      EZ_TEST_BOOL(tile.m_iTileX < 0);
+      EZ_TEST_BOOL(tile.m_iTileY < 0);
+    }
+
+    dtNavMesh navMesh;
+    EZ_TEST_BOOL(CreateDetourNavMesh(desc, navMesh).Succeeded());
+
+    dtNavMeshQuery query;
+    EZ_TEST_BOOL(dtStatusSucceed(query.init(&navMesh, 512)));
+
+    dtQueryFilter filter;
+    const ezVec3 vExtents(0.5f, 2.0f, 0.5f);
+
+    // two points on the ground, far enough apart to be in different tiles, and not inside any of the boxes
+    const ezVec3 vStart = ezVec3(1.0f, 1.0f, 0.0f) + vOffset;
+    const ezVec3 vEnd = ezVec3(62.0f, 58.0f, 0.0f) + vOffset;
+
+    ezRcPos rcStart = vStart;
+    ezRcPos rcEnd = vEnd;
+    ezRcPos rcNearestStart, rcNearestEnd;
+    dtPolyRef startPoly = 0, endPoly = 0;
+
+    EZ_TEST_BOOL(dtStatusSucceed(query.findNearestPoly(rcStart, &vExtents.x, &filter, &startPoly, rcNearestStart)));
+    EZ_TEST_BOOL(dtStatusSucceed(query.findNearestPoly(rcEnd, &vExtents.x, &filter, &endPoly, rcNearestEnd)));
+    EZ_TEST_BOOL(startPoly != 0);
+    EZ_TEST_BOOL(endPoly != 0);
+    EZ_TEST_BOOL(startPoly != endPoly);
+    EZ_TEST_VEC3(ezVec3(rcNearestStart).GetAsVec2().GetAsVec3(0), vStart.GetAsVec2().GetAsVec3(0), 0.5f);
+    EZ_TEST_VEC3(ezVec3(rcNearestEnd).GetAsVec2().GetAsVec3(0), vEnd.GetAsVec2().GetAsVec3(0), 0.5f);
+
+    dtPolyRef path[256];
+    int iPathLength = 0;
+    EZ_TEST_BOOL(dtStatusSucceed(query.findPath(startPoly, endPoly, rcNearestStart, rcNearestEnd, &filter, path, &iPathLength, EZ_ARRAY_SIZE(path))));
+    EZ_TEST_BOOL(iPathLength > 1);
+
+    if (iPathLength > 0)
+    {
+      // a complete path ends in the target polygon, a partial one would not
+      EZ_TEST_BOOL(path[iPathLength - 1] == endPoly);
+    }
+  }
+
+  EZ_TEST_BLOCK(EnableInRelease, "Profile 256m x 256m")
+  {
+    ezWorldGeoExtractionUtil::Geometry geo;
+    CreateTestGeometry(geo, 256);
+
+    ezProgress progress;
+    ezRecastNavMeshBuilder builder;
+
+    {
+      ezRecastConfig config;
+      ezRecastNavMeshResourceDescriptor desc;
+
+      ezStopwatch sw;
+      builder.Build(config, geo, desc, progress).IgnoreResult();
+      ezTestFramework::Output(ezTestOutput::Duration, "Single navmesh: %.2fms", sw.GetRunningTotal().GetMilliseconds());
+    }
+
+    {
+      ezRecastConfig config;
+      config.m_fTileSize = 32.0f;
+      ezRecastNavMeshResourceDescriptor desc, desc2;
+
+      ezStopwatch sw;
+      builder.Build(config, geo, desc, progress).IgnoreResult();
+      ezTestFramework::Output(ezTestOutput::Duration, "Tiled navmesh (%u tiles): %.2fms", desc.m_Tiles.GetCount(), sw.Checkpoint().GetMilliseconds());
+
+      geo.m_BoxShapes[geo.m_BoxShapes.GetCount() / 2].m_vPosition.z += 0.5f;
+
+      builder.Build(config, geo, desc2, progress, &desc).IgnoreResult();
+      ezTestFramework::Output(
+        ezTestOutput::Duration, "Tiled navmesh, incremental (%u tiles rebuilt): %.2fms", builder.GetNumBuiltTiles(), sw.Checkpoint().GetMilliseconds());
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,279 @@
+#include <GameEngineTestPCH.h>
+
+#include <Core/ResourceManager/ResourceManager.h>
+#include <Core/ResourceManager/ResourceTypeLoader.h>
+#include <Core/WorldSerializer/WorldWriter.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <GameEngine/Gameplay/ProjectileComponent.h>
+#include <GameEngine/Gameplay/TimedDeathComponent.h>
+#include <GameEngine/Prefabs/PrefabPoolWorldModule.h>
+#include <GameEngine/Prefabs/SpawnComponent.h>
+
+namespace
+{
+  /// A single root object that kills itself after one second, both through a timed death and a projectile component.
+  ezPrefabResourceHandle CreateSuicidePrefab(const char* szResourceID)
+  {
+    ezUniquePtr<ezResourceLoaderFromMemory> loader(EZ_DEFAULT_NEW(ezResourceLoaderFromMemory));
+    loader->m_ModificationTimestamp = ezTimestamp::CurrentTimestamp();
+    loader->m_sResourceDescription = szResourceID;
+
+    {
+      ezWorldDesc worldDesc("PrefabSource");
+      ezWorld world(worldDesc);
+      EZ_LOCK(world.GetWriteMarker());
+
+      ezGameObjectDesc desc;
+      desc.m_bDynamic = true;
+      ezGameObject* pObject = nullptr;
+      world.CreateObject(desc, pObject);
+
+      ezTimedDeathComponent* pTimedDeath = nullptr;
+      ezTimedDeathComponent::CreateComponent(pObject, pTimedDeath);
+      pTimedDeath->m_MinDelay = ezTime::Seconds(1.0);
+      pTimedDeath->m_DelayRange = ezTime::Seconds(0.0);
+
+      ezProjectileComponent* pProjectile = nullptr;
+      ezProjectileComponent::CreateComponent(pObject, pProjectile);
+      pProjectile->m_fMetersPerSecond = 0.0f;
+      pProjectile->m_MaxLifetime = ezTime::Seconds(1.0);
+
+      // the same format that the standard file reader and the prefab asset transform produce
+      ezMemoryStreamWriter stream(&loader->m_CustomData);
+      stream << ezString(szResourceID);
+
+      ezAssetFileHeader header;
+      header.SetFileHashAndVersion(0, 1);
+      header.Write(stream);
+
+      const char szSceneTag[16] = "[ezBinaryScene]";
+      stream.WriteBytes(szSceneTag, sizeof(char) * 16);
+
+      ezWorldWriter writer;
+      writer.WriteWorld(stream, world);
+    }
+
+    ezPrefabResourceHandle hPrefab = ezResourceManager::LoadResource<ezPrefabResource>(szResourceID);
+    ezResourceManager::UpdateResourceWithCustomLoader(hPrefab, std::move(loader));
+    ezResourceManager::ForceLoadResourceNow(hPrefab);
+
+    return hPrefab;
+  }
+
+  void UpdateWorldUntil(ezWorld& world, ezTime time)
+  {
+    while (world.GetClock().GetAccumulatedTime() < time)
+    {
+      world.Update();
+    }
+  }
+
+  ezGameObject* GetSingleChild(ezGameObject* pParent)
+  {
+    if (pParent->GetChildCount() != 1)
+      return nullptr;
+
+    return &(*pParent->GetChildren());
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Prefabs);
+
+EZ_CREATE_SIMPLE_TEST(Prefabs, PrefabPool)
+{
+  ezPrefabResourceHandle hPrefab = CreateSuicidePrefab("PrefabPoolTest_Spawned");
+  ezPrefabResourceHandle hOtherPrefab = CreateSuicidePrefab("PrefabPoolTest_Other");
+
+  EZ_TEST_BOOL(ezResourceManager::GetLoadingState(hPrefab) == ezResourceState::Loaded);
+
+  ezWorldDesc worldDesc("PrefabPoolTest");
+  ezWorld world(worldDesc);
+  EZ_LOCK(world.GetWriteMarker());
+
+  world.SetWorldSimulationEnabled(true);
+  world.GetClock().SetFixedTimeStep(ezTime::Seconds(0.1));
+
+  ezGameObjectDesc desc;
+  desc.m_bDynamic = true;
+  desc.m_LocalPosition.Set(10, 0, 0);
+  ezGameObject* pSpawner = nullptr;
+  world.CreateObject(desc, pSpawner);
+
+  ezSpawnComponent* pSpawn = nullptr;
+  ezSpawnComponent::CreateComponent(pSpawner, pSpawn);
+  pSpawn->SetPrefab(hPrefab);
+  pSpawn->SetAttachAsChild(true);
+  pSpawn->m_uiPoolSize = 2;
+
+  world.Update();
+
+  ezPrefabPoolWorldModule* pPool = world.GetModule<ezPrefabPoolWorldModule>();
+  ezGameObjectHandle hInstance;
+  ezTime tFirstSpawn;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Setup")
+  {
+    if (EZ_TEST_BOOL(pPool != nullptr).Failed())
+      return;
+
+    EZ_TEST_INT(pPool->GetPoolSize(hPrefab), 2);
+    EZ_TEST_INT(pPool->GetPoolSize(hOtherPrefab), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Spawn")
+  {
+    tFirstSpawn = world.GetClock().GetAccumulatedTime();
+
+    EZ_TEST_BOOL(pSpawn->TriggerManualSpawn(true));
+
+    ezGameObject* pInstance = GetSingleChild(pSpawner);
+    if (EZ_TEST_BOOL(pInstance != nullptr).Failed())
+      return;
+
+    hInstance = pInstance->GetHandle();
+    EZ_TEST_BOOL(pInstance->IsActive());
+
+    const auto stats = pPool->GetStats(hPrefab);
+    EZ_TEST_INT(stats.m_uiHits, 0);
+    EZ_TEST_INT(stats.m_uiMisses, 1);
+    EZ_TEST_INT(stats.m_uiRecycled, 0);
+    EZ_TEST_INT(stats.m_uiPooled, 0);
+
+    world.Update();
+
+    // mess with the instance, none of this may survive recycling
+    ezQuat qRotation;
+    qRotation.SetFromAxisAndAngle(ezVec3(0, 0, 1), ezAngle::Degree(90));
+    pInstance->SetLocalPosition(ezVec3(5, 5, 5));
+    pInstance->SetLocalRotation(qRotation);
+    pInstance->SetLocalScaling(ezVec3(2.0f));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Recycle")
+  {
+    UpdateWorldUntil(world, tFirstSpawn + ezTime::Seconds(0.5));
+
+    pPool->RecycleOrDeleteObjectDelayed(hInstance);
+
+    // instances are only returned at the end of the frame
+    EZ_TEST_INT(pPool->GetStats(hPrefab).m_uiRecycled, 0);
+
+    world.Update();
+
+    const auto stats = pPool->GetStats(hPrefab);
+    EZ_TEST_INT(stats.m_uiRecycled, 1);
+    EZ_TEST_INT(stats.m_uiDiscarded, 0);
+    EZ_TEST_INT(stats.m_uiPooled, 1);
+
+    ezGameObject* pInstance = nullptr;
+    EZ_TEST_BOOL(world.TryGetObject(hInstance, pInstance));
+    EZ_TEST_BOOL(!pInstance->IsActive());
+    EZ_TEST_BOOL(pInstance->GetParent() == nullptr);
+    EZ_TEST_INT(pSpawner->GetChildCount(), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Respawn")
+  {
+    EZ_TEST_BOOL(pSpawn->TriggerManualSpawn(true, ezVec3(0, 0, 1)));
+
+    ezGameObject* pInstance = GetSingleChild(pSpawner);
+    if (EZ_TEST_BOOL(pInstance != nullptr).Failed())
+      return;
+
+    EZ_TEST_BOOL(pInstance->GetHandle() == hInstance);
+    EZ_TEST_BOOL(pInstance->IsActive());
+
+    EZ_TEST_VEC3(pInstance->GetLocalPosition(), ezVec3(0, 0, 1), 0.0001f);
+    EZ_TEST_BOOL(pInstance->GetLocalRotation().IsEqualRotation(ezQuat::IdentityQuaternion(), 0.0001f));
+    EZ_TEST_VEC3(pInstance->GetLocalScaling(), ezVec3(1.0f), 0.0001f);
+
+    const auto stats = pPool->GetStats(hPrefab);
+    EZ_TEST_INT(stats.m_uiHits, 1);
+    EZ_TEST_INT(stats.m_uiMisses, 1);
+    EZ_TEST_INT(stats.m_uiPooled, 0);
+
+    world.Update();
+
+    EZ_TEST_VEC3(pInstance->GetGlobalPosition(), ezVec3(10, 0, 1), 0.0001f);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Time of death")
+  {
+    const ezTime tRespawn = world.GetClock().GetAccumulatedTime();
+
+    // the timeouts from the first life have passed, but they must not kill the respawned instance
+    UpdateWorldUntil(world, tFirstSpawn + ezTime::Seconds(1.2));
+    EZ_TEST_BOOL(tRespawn + ezTime::Seconds(1.0) > world.GetClock().GetAccumulatedTime());
+
+    ezGameObject* pInstance = GetSingleChild(pSpawner);
+    EZ_TEST_BOOL(pInstance != nullptr && pInstance->GetHandle() == hInstance && pInstance->IsActive());
+    EZ_TEST_INT(pPool->GetStats(hPrefab).m_uiRecycled, 1);
+
+    // the timeouts from the second life kill it and return it to the pool
+    UpdateWorldUntil(world, tRespawn + ezTime::Seconds(1.5));
+
+    EZ_TEST_INT(pSpawner->GetChildCount(), 0);
+    EZ_TEST_BOOL(world.TryGetObject(hInstance, pInstance));
+    EZ_TEST_BOOL(!pInstance->IsActive());
+
+    const auto stats = pPool->GetStats(hPrefab);
+    EZ_TEST_INT(stats.m_uiRecycled, 2);
+    EZ_TEST_INT(stats.m_uiPooled, 1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Discard")
+  {
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      pSpawn->TriggerManualSpawn(true);
+    }
+
+    EZ_TEST_INT(pSpawner->GetChildCount(), 3);
+
+    for (auto it = pSpawner->GetChildren(); it.IsValid(); ++it)
+    {
+      pPool->RecycleOrDeleteObjectDelayed(it->GetHandle());
+    }
+
+    world.Update();
+
+    // the pool only holds two instances, the third one is deleted
+    const auto stats = pPool->GetStats(hPrefab);
+    EZ_TEST_INT(stats.m_uiHits, 2);
+    EZ_TEST_INT(stats.m_uiMisses, 3);
+    EZ_TEST_INT(stats.m_uiRecycled, 4);
+    EZ_TEST_INT(stats.m_uiDiscarded, 1);
+    EZ_TEST_INT(stats.m_uiPooled, 2);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Purge deleted instances")
+  {
+    // delete the pooled instances directly, the pool is not informed about this
+    ezDynamicArray<ezGameObjectHandle> pooled;
+    for (auto it = world.GetObjects(); it.IsValid(); ++it)
+    {
+      if (!it->IsActive())
+        pooled.PushBack(it->GetHandle());
+    }
+
+    EZ_TEST_INT(pooled.GetCount(), 2);
+
+    for (const ezGameObjectHandle& hObject : pooled)
+    {
+      world.DeleteObjectNow(hObject);
+    }
+
+    EZ_TEST_INT(pPool->GetStats(hPrefab).m_uiPooled, 2);
+
+    // creating enough instances of any pooled prefab eventually cleans up the dead ones
+    pPool->SetPoolSize(hOtherPrefab, 1);
+
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      pPool->InstantiatePrefab(hOtherPrefab, ezTransform::IdentityTransform());
+    }
+
+    EZ_TEST_INT(pPool->GetStats(hOtherPrefab).m_uiMisses, 100);
+    EZ_TEST_INT(pPool->GetStats(hPrefab).m_uiPooled, 0);
+  }
+}
@@ -0,0 +1,212 @@
+#include <GameEngineTestPCH.h>
+
+#include <Core/Assets/AssetFileHeader.h>
+#include <Core/ResourceManager/ResourceManager.h>
+#include <Core/ResourceManager/ResourceTypeLoader.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Time/Time.h>
+#include <GameEngine/VisualScript/Nodes/VisualScriptMathNodes.h>
+#include <GameEngine/VisualScript/Nodes/VisualScriptMessageNodes.h>
+#include <GameEngine/VisualScript/Nodes/VisualScriptVariableNodes.h>
+#include <GameEngine/VisualScript/VisualScriptInstance.h>
+#include <GameEngine/VisualScript/VisualScriptResource.h>
+
+namespace
+{
+  /// Every update: Counter = Counter * 1 + Increment
+  ezVisualScriptResourceDescriptor CreateCounterScript(double fIncrement)
+  {
+    ezVisualScriptResourceDescriptor desc;
+
+    auto AddNode = [&](const ezRTTI* pType) -> ezUInt16 {
+      auto& node = desc.m_Nodes.ExpandAndGetRef();
+      node.m_pType = pType;
+      node.m_sTypeName = pType->GetTypeName();
+      node.m_uiFirstProperty = static_cast<ezUInt16>(desc.m_Properties.GetCount());
+      return static_cast<ezUInt16>(desc.m_Nodes.GetCount() - 1);
+    };
+
+    auto AddProperty = [&](const char* szName, const ezVariant& value) {
+      auto& prop = desc.m_Properties.ExpandAndGetRef();
+      prop.m_sName = szName;
+      prop.m_Value = value;
+      ++desc.m_Nodes.PeekBack().m_uiNumProperties;
+    };
+
+    const ezUInt16 uiUpdate = AddNode(ezGetStaticRTTI<ezVisualScriptNode_ScriptUpdateEvent>());
+
+    const ezUInt16 uiGetCounter = AddNode(ezGetStaticRTTI<ezVisualScriptNode_Number>());
+    AddProperty("Name", "Counter");
+
+    const ezUInt16 uiGetIncrement = AddNode(ezGetStaticRTTI<ezVisualScriptNode_Number>());
+    AddProperty("Name", "Increment");
+
+    const ezUInt16 uiMultiplyAdd = AddNode(ezGetStaticRTTI<ezVisualScriptNode_MultiplyAdd>());
+
+    const ezUInt16 uiStoreCounter = AddNode(ezGetStaticRTTI<ezVisualScriptNode_StoreNumber>());
+    AddProperty("Name", "Counter");
+
+    {
+      auto& con = desc.m_ExecutionPaths.ExpandAndGetRef();
+      con.m_uiSourceNode = uiUpdate;
+      con.m_uiOutputPin = 0;
+      con.m_uiTargetNode = uiStoreCounter;
+      con.m_uiInputPin = 0;
+    }
+
+    auto Connect = [&](ezUInt16 uiSourceNode, ezUInt16 uiTargetNode, ezUInt8 uiTargetPin) {
+      auto& con = desc.m_DataPaths.ExpandAndGetRef();
+      con.m_uiSourceNode = uiSourceNode;
+      con.m_uiOutputPin = 0;
+      con.m_uiOutputPinType = ezVisualScriptDataPinType::Number;
+      con.m_uiTargetNode = uiTargetNode;
+      con.m_uiInputPin = uiTargetPin;
+      con.m_uiInputPinType = ezVisualScriptDataPinType::Number;
+    };
+
+    Connect(uiGetCounter, uiMultiplyAdd, 0);
+    Connect(uiGetIncrement, uiMultiplyAdd, 2);
+    Connect(uiMultiplyAdd, uiStoreCounter, 0);
+
+    {
+      auto& param = desc.m_NumberParameters.ExpandAndGetRef();
+      param.m_sName.Assign("Counter");
+      param.m_Value = 0.0;
+    }
+
+    {
+      auto& param = desc.m_NumberParameters.ExpandAndGetRef();
+      param.m_sName.Assign("Increment");
+      param.m_Value = fIncrement;
+    }
+
+    return desc;
+  }
+
+  /// Loads the script like the visual script asset transform would have written it, which allows to reload it later.
+  void LoadScriptFromMemory(const ezVisualScriptResourceHandle& hScript, const ezVisualScriptResourceDescriptor& desc)
+  {
+    ezUniquePtr<ezResourceLoaderFromMemory> loader(EZ_DEFAULT_NEW(ezResourceLoaderFromMemory));
+    loader->m_ModificationTimestamp = ezTimestamp::CurrentTimestamp();
+    loader->m_sResourceDescription = hScript.GetResourceID();
+
+    ezMemoryStreamWriter stream(&loader->m_CustomData);
+    stream << hScript.GetResourceID();
+
+    ezAssetFileHeader header;
+    header.SetFileHashAndVersion(0, 1);
+    header.Write(stream);
+
+    desc.Save(stream);
+
+    ezResourceManager::UpdateResourceWithCustomLoader(hScript, std::move(loader));
+    ezResourceManager::ForceLoadResourceNow(hScript);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST_GROUP(VisualScript);
+
+EZ_CREATE_SIMPLE_TEST(VisualScript, Instances)
+{
+  ezVisualScriptResourceHandle hScript = ezResourceManager::CreateResource<ezVisualScriptResource>("VisualScriptTest_Counter", CreateCounterScript(2.0));
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Shared layout")
+  {
+    ezResourceLock<ezVisualScriptResource> pScript(hScript, ezResourceAcquireMode::BlockTillLoaded);
+    const auto& desc = pScript->GetDescriptor();
+
+    EZ_TEST_INT(desc.m_NodeLayouts.GetCount(), 5);
+    EZ_TEST_INT(desc.m_ExecutionTargets.GetCount(), 1);
+    EZ_TEST_INT(desc.m_ExecutionTargets[0].m_uiTargetNode, 4);
+    EZ_TEST_INT(desc.m_DataOutputs.GetCount(), 3);
+    EZ_TEST_INT(desc.m_DataTargets.GetCount(), 3);
+
+    // the multiply-add node depends on both variables, storing the result depends on the multiply-add node
+    EZ_TEST_INT(desc.m_NodeLayouts[3].m_uiNumDependencies, 2);
+    EZ_TEST_INT(desc.m_NodeLayouts[4].m_uiNumDependencies, 1);
+    EZ_TEST_INT(desc.m_NodeDependencies[desc.m_NodeLayouts[4].m_uiFirstDependency], 3);
+
+    // all nodes of an instance are stored in one block
+    EZ_TEST_BOOL(desc.m_uiNodeDataSize >= sizeof(ezVisualScriptNode_MultiplyAdd) + sizeof(ezVisualScriptNode_StoreNumber));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Execute")
+  {
+    ezVisualScriptInstance script1;
+    ezVisualScriptInstance script2;
+    script1.Configure(hScript, nullptr);
+    script2.Configure(hScript, nullptr);
+
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      script1.ExecuteScript();
+    }
+
+    script2.ExecuteScript();
+
+    double fCounter = 0;
+    script1.GetLocalVariables().RetrieveDouble("Counter", fCounter);
+    EZ_TEST_DOUBLE(fCounter, 6.0, 0.0);
+
+    // the instances share the script, but not the state
+    script2.GetLocalVariables().RetrieveDouble("Counter", fCounter);
+    EZ_TEST_DOUBLE(fCounter, 2.0, 0.0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Reload")
+  {
+    ezVisualScriptResourceHandle hReloadedScript = ezResourceManager::LoadResource<ezVisualScriptResource>("VisualScriptTest_Reload");
+    LoadScriptFromMemory(hReloadedScript, CreateCounterScript(2.0));
+
+    ezVisualScriptInstance script;
+    script.Configure(hReloadedScript, nullptr);
+    script.ExecuteScript();
+
+    double fCounter = 0;
+    script.GetLocalVariables().RetrieveDouble("Counter", fCounter);
+    EZ_TEST_DOUBLE(fCounter, 2.0, 0.0);
+
+    // the instance must not keep using the replaced descriptor, it starts over with the new script
+    LoadScriptFromMemory(hReloadedScript, CreateCounterScript(5.0));
+
+    script.ExecuteScript();
+
+    script.GetLocalVariables().RetrieveDouble("Counter", fCounter);
+    EZ_TEST_DOUBLE(fCounter, 5.0, 0.0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Benchmark")
+  {
+    const ezUInt32 uiNumInstances = 10000;
+    const ezUInt32 uiNumUpdates = 10;
+
+    ezDynamicArray<ezVisualScriptInstance> scripts;
+
+    ezTime t0 = ezTime::Now();
+
+    scripts.SetCount(uiNumInstances);
+    for (auto& script : scripts)
+    {
+      script.Configure(hScript, nullptr);
+    }
+
+    ezTime t1 = ezTime::Now();
+
+    for (ezUInt32 uiUpdate = 0; uiUpdate < uiNumUpdates; ++uiUpdate)
+    {
+      for (auto& script : scripts)
+      {
+        script.ExecuteScript();
+      }
+    }
+
+    ezTime t2 = ezTime::Now();
+
+    double fCounter = 0;
+    scripts.PeekBack().GetLocalVariables().RetrieveDouble("Counter", fCounter);
+    EZ_TEST_DOUBLE(fCounter, 2.0 * uiNumUpdates, 0.0);
+
+    ezLog::Info("[test]{0} visual script instances: configure {1}ms, {2} updates {3}ms", uiNumInstances, ezArgF((t1 - t0).GetMilliseconds(), 2),
+      uiNumUpdates, ezArgF((t2 - t1).GetMilliseconds(), 2));
+  }
+}
@@ -0,0 +1,419 @@
+#include <RendererTestPCH.h>
+
+#include "ExtractionTest.h"
+#include <Core/World/World.h>
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Memory/FrameAllocator.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <RendererCore/Lights/ClusteredDataExtractor.h>
+#include <RendererCore/Lights/DirectionalLightComponent.h>
+#include <RendererCore/Lights/PointLightComponent.h>
+#include <RendererCore/Lights/SpotLightComponent.h>
+#include <RendererCore/Meshes/MeshComponentBase.h>
+#include <RendererCore/Pipeline/ExtractedRenderData.h>
+#include <RendererCore/Pipeline/Extractor.h>
+#include <RendererCore/Pipeline/View.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
+#include <RendererFoundation/Shader/ShaderUtils.h>
+#include <TestFramework/Utilities/TestLogInterface.h>
+
+#include <RendererCore/../../../Data/Base/Shaders/Common/LightData.h>
+
+namespace ExtractionTestDetail
+{
+  typedef ezComponentManager<class ExtractionTestComponent, ezBlockStorageType::Compact> ExtractionTestComponentManager;
+
+  /// \brief Creates one mesh render data per extraction, with a sorting key that is unique per object.
+  class ExtractionTestComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(ExtractionTestComponent, ezComponent, ExtractionTestComponentManager);
+
+  public:
+    void OnMsgExtractRenderData(ezMsgExtractRenderData& msg) const
+    {
+      ezMeshRenderData* pRenderData = ezCreateRenderDataForThisFrame<ezMeshRenderData>(GetOwner());
+      pRenderData->m_GlobalTransform = GetOwner()->GetGlobalTransform();
+      pRenderData->m_GlobalBounds = GetOwner()->GetGlobalBounds();
+      pRenderData->m_uiSortingKey = m_uiSortingKey;
+      pRenderData->m_uiBatchId = m_uiSortingKey % 16;
+
+      const ezRenderData::Category category = (m_uiSortingKey % 3) == 0 ? ezDefaultRenderDataCategories::LitTransparent : ezDefaultRenderDataCategories::LitOpaque;
+      msg.AddRenderData(pRenderData, category, ezRenderData::Caching::Never);
+    }
+
+    ezUInt32 m_uiSortingKey = 0;
+  };
+
+  // clang-format off
+  EZ_BEGIN_COMPONENT_TYPE(ExtractionTestComponent, 1, ezComponentMode::Dynamic)
+  {
+    EZ_BEGIN_MESSAGEHANDLERS
+    {
+      EZ_MESSAGE_HANDLER(ezMsgExtractRenderData, OnMsgExtractRenderData)
+    }
+    EZ_END_MESSAGEHANDLERS;
+  }
+  EZ_END_COMPONENT_TYPE;
+  // clang-format on
+
+  static void CreateObjects(ezWorld& world, ezUInt32 uiNumObjects, ezDynamicArray<const ezGameObject*>& out_Objects)
+  {
+    EZ_LOCK(world.GetWriteMarker());
+
+    ExtractionTestComponentManager* pManager = world.GetOrCreateComponentManager<ExtractionTestComponentManager>();
+
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      ezGameObjectDesc desc;
+      desc.m_bDynamic = true;
+      desc.m_LocalPosition.Set((float)(i % 100), (float)(i / 100), 0.0f);
+
+      ezGameObject* pObject = nullptr;
+      world.CreateObject(desc, pObject);
+
+      ExtractionTestComponent* pComponent = nullptr;
+      pManager->CreateComponent(pObject, pComponent);
+      pComponent->m_uiSortingKey = i;
+
+      out_Objects.PushBack(pObject);
+    }
+
+    // initializes the new components
+    world.Update();
+  }
+
+  static void Extract(const ezView& view, ezVisibleObjectsExtractor& extractor, const ezDynamicArray<const ezGameObject*>& objects, bool bParallel,
+    ezExtractedRenderData& out_ExtractedRenderData)
+  {
+    ezCVarBool* pCVar = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("r_ParallelExtraction"));
+    *pCVar = bParallel;
+
+    out_ExtractedRenderData.Clear();
+    extractor.Extract(view, objects, out_ExtractedRenderData);
+    out_ExtractedRenderData.SortAndBatch();
+  }
+
+  static void CollectOwners(const ezExtractedRenderData& extractedRenderData, ezRenderData::Category category, ezDynamicArray<ezGameObjectHandle>& out_Owners)
+  {
+    out_Owners.Clear();
+
+    ezRenderDataBatchList batchList = extractedRenderData.GetRenderDataBatchesWithCategory(category);
+    for (ezUInt32 uiBatch = 0; uiBatch < batchList.GetBatchCount(); ++uiBatch)
+    {
+      const ezRenderDataBatch batch = batchList.GetBatch(uiBatch);
+      for (auto it = batch.GetIterator<ezRenderData>(); it.IsValid(); ++it)
+      {
+        out_Owners.PushBack(it->m_hOwner);
+      }
+    }
+  }
+
+  /// \brief Adds one directional light and a mix of point and spot lights in front of the camera.
+  static void AddLights(ezUInt32 uiNumLights, ezExtractedRenderData& out_ExtractedRenderData)
+  {
+    ezRandom rng;
+    rng.Initialize(42);
+
+    auto pDirLight = ezCreateRenderDataForThisFrame<ezDirectionalLightRenderData>(nullptr);
+    pDirLight->m_GlobalTransform.SetIdentity();
+    out_ExtractedRenderData.AddRenderData(pDirLight, ezDefaultRenderDataCategories::Light);
+
+    for (ezUInt32 i = 1; i < uiNumLights; ++i)
+    {
+      ezLightRenderData* pLight = nullptr;
+
+      if (i % 4 == 0)
+      {
+        auto pSpotLight = ezCreateRenderDataForThisFrame<ezSpotLightRenderData>(nullptr);
+        pSpotLight->m_fRange = (float)rng.DoubleMinMax(5.0, 20.0);
+        pSpotLight->m_InnerSpotAngle = ezAngle::Degree(20.0f);
+        pSpotLight->m_OuterSpotAngle = ezAngle::Degree(45.0f);
+        pLight = pSpotLight;
+      }
+      else
+      {
+        auto pPointLight = ezCreateRenderDataForThisFrame<ezPointLightRenderData>(nullptr);
+        pPointLight->m_fRange = (float)rng.DoubleMinMax(1.0, 10.0);
+        pLight = pPointLight;
+      }
+
+      pLight->m_GlobalTransform.SetIdentity();
+      pLight->m_GlobalTransform.m_vPosition.Set((float)rng.DoubleMinMax(5.0, 200.0), (float)rng.DoubleMinMax(-100.0, 100.0), (float)rng.DoubleMinMax(-50.0, 50.0));
+      pLight->m_LightColor = ezColor::White;
+      pLight->m_fIntensity = 1.0f;
+      pLight->m_uiShadowDataOffset = ezInvalidIndex;
+      out_ExtractedRenderData.AddRenderData(pLight, ezDefaultRenderDataCategories::Light);
+    }
+
+    out_ExtractedRenderData.SortAndBatch();
+  }
+} // namespace ExtractionTestDetail
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+static const ezTestBlock::Enum EnableInRelease = ezTestBlock::DisabledNoWarning;
+#else
+static const ezTestBlock::Enum EnableInRelease = ezTestBlock::Enabled;
+#endif
+
+ezResult ezRendererTestExtraction::InitializeSubTest(ezInt32 iIdentifier)
+{
+  if (ezGraphicsTest::InitializeSubTest(iIdentifier).Failed())
+    return EZ_FAILURE;
+
+  return SetupNullRenderer();
+}
+
+ezResult ezRendererTestExtraction::DeInitializeSubTest(ezInt32 iIdentifier)
+{
+  ezCVarBool* pCVar = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("r_ParallelExtraction"));
+  *pCVar = true;
+
+  ShutdownRenderer();
+
+  return ezGraphicsTest::DeInitializeSubTest(iIdentifier);
+}
+
+ezTestAppRun ezRendererTestExtraction::SubtestVisibleObjects()
+{
+  using namespace ExtractionTestDetail;
+
+  ezWorldDesc worldDesc("ExtractionTest");
+  ezWorld world(worldDesc);
+
+  ezView* pView = nullptr;
+  ezViewHandle hView = ezRenderWorld::CreateView("ExtractionTest", pView);
+  pView->SetWorld(&world);
+
+  ezVisibleObjectsExtractor extractor;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Serial vs Parallel")
+  {
+    ezDynamicArray<const ezGameObject*> objects;
+    CreateObjects(world, 3000, objects);
+
+    ezExtractedRenderData serialData, parallelData;
+    Extract(*pView, extractor, objects, false, serialData);
+    Extract(*pView, extractor, objects, true, parallelData);
+
+    ezDynamicArray<ezGameObjectHandle> serialOwners, parallelOwners;
+
+    for (ezRenderData::Category category : {ezDefaultRenderDataCategories::LitOpaque, ezDefaultRenderDataCategories::LitTransparent})
+    {
+      CollectOwners(serialData, category, serialOwners);
+      CollectOwners(parallelData, category, parallelOwners);
+
+      EZ_TEST_INT(serialOwners.GetCount(), category == ezDefaultRenderDataCategories::LitTransparent ? 1000 : 2000);
+      EZ_TEST_BOOL(serialOwners == parallelOwners);
+    }
+
+    // extracting again reuses the chunk data and must not accumulate anything
+    Extract(*pView, extractor, objects, true, parallelData);
+    CollectOwners(parallelData, ezDefaultRenderDataCategories::LitOpaque, parallelOwners);
+    EZ_TEST_INT(parallelOwners.GetCount(), 2000);
+
+    ezFrameAllocator::Reset();
+  }
+
+  EZ_TEST_BLOCK(EnableInRelease, "Profile 100000 objects")
+  {
+    ezDynamicArray<const ezGameObject*> objects;
+    CreateObjects(world, 100000, objects);
+
+    ezExtractedRenderData extractedRenderData;
+
+    for (bool bParallel : {false, true})
+    {
+      // warm up
+      Extract(*pView, extractor, objects, bParallel, extractedRenderData);
+      ezFrameAllocator::Reset();
+
+      ezStopwatch sw;
+      for (ezUInt32 i = 0; i < 10; ++i)
+      {
+        Extract(*pView, extractor, objects, bParallel, extractedRenderData);
+        ezFrameAllocator::Reset();
+      }
+
+      ezTestFramework::Output(ezTestOutput::Duration, "%s extraction: %.2fms per frame", bParallel ? "Parallel" : "Serial", sw.GetRunningTotal().GetMilliseconds() / 10.0);
+    }
+  }
+
+  ezRenderWorld::DeleteView(hView);
+
+  return ezTestAppRun::Quit;
+}
+
+ezTestAppRun ezRendererTestExtraction::SubtestClusteredLights()
+{
+  using namespace ExtractionTestDetail;
+
+  ezWorldDesc worldDesc("ClusteredLightsTest");
+  ezWorld world(worldDesc);
+
+  ezCamera camera;
+  camera.SetCameraMode(ezCameraMode::PerspectiveFixedFovX, 90.0f, 0.1f, 1000.0f);
+  camera.LookAt(ezVec3::ZeroVector(), ezVec3(1, 0, 0), ezVec3(0, 0, 1));
+
+  ezView* pView = nullptr;
+  ezViewHandle hView = ezRenderWorld::CreateView("ClusteredLightsTest", pView);
+  pView->SetWorld(&world);
+  pView->SetCamera(&camera);
+  pView->SetViewport(ezRectFloat(0.0f, 0.0f, 1280.0f, 720.0f));
+
+  ezCVarInt* pMaxLights = static_cast<ezCVarInt*>(ezCVar::FindCVarByName("r_MaxLights"));
+  const ezInt32 iOldMaxLights = *pMaxLights;
+
+  ezClusteredDataExtractor extractor;
+  ezDynamicArray<const ezGameObject*> visibleObjects;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Binning")
+  {
+    ezExtractedRenderData extractedRenderData;
+    extractedRenderData.SetCamera(camera);
+    AddLights(256, extractedRenderData);
+
+    extractor.PostSortAndBatch(*pView, visibleObjects, extractedRenderData);
+
+    const ezClusteredDataCPU* pData = extractedRenderData.GetFrameData<ezClusteredDataCPU>();
+    if (EZ_TEST_BOOL(pData != nullptr).Succeeded())
+    {
+      EZ_TEST_INT(pData->m_LightData.GetCount(), 256);
+
+      ezUInt32 uiNumItems = 0;
+      ezDynamicArray<bool> lightFound;
+      lightFound.SetCount(256);
+
+      for (const auto& clusterData : pData->m_ClusterData)
+      {
+        const ezUInt32 uiLightCount = GET_LIGHT_INDEX(clusterData.counts);
+
+        // the directional light affects every cluster and has the lowest index
+        EZ_TEST_BOOL(uiLightCount >= 1);
+        EZ_TEST_INT(clusterData.offset, uiNumItems);
+
+        for (ezUInt32 i = 0; i < uiLightCount; ++i)
+        {
+          lightFound[GET_LIGHT_INDEX(pData->m_ClusterItemList[clusterData.offset + i])] = true;
+        }
+
+        uiNumItems += uiLightCount;
+      }
+
+      EZ_TEST_INT(pData->m_ClusterItemList.GetCount(), uiNumItems);
+      EZ_TEST_BOOL(lightFound[0]);
+
+      ezUInt32 uiNumLightsFound = 0;
+      for (bool bFound : lightFound)
+      {
+        uiNumLightsFound += bFound ? 1 : 0;
+      }
+
+      // most lights are within the view frustum
+      EZ_TEST_BOOL(uiNumLightsFound > 128);
+    }
+
+    ezFrameAllocator::Reset();
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Light Limit")
+  {
+    *pMaxLights = 100;
+
+    ezTestLogInterface log;
+    ezTestLogSystemScope logSystemScope(&log);
+
+    // the warning is only logged again once the number of lights dropped below the limit in between
+    log.ExpectMessage("Maximum number of lights reached", ezLogMsgType::WarningMsg, 2);
+
+    for (ezUInt32 uiNumLights : {256u, 256u, 50u, 256u})
+    {
+      ezExtractedRenderData extractedRenderData;
+      extractedRenderData.SetCamera(camera);
+      AddLights(uiNumLights, extractedRenderData);
+
+      extractor.PostSortAndBatch(*pView, visibleObjects, extractedRenderData);
+
+      const ezClusteredDataCPU* pData = extractedRenderData.GetFrameData<ezClusteredDataCPU>();
+      if (EZ_TEST_BOOL(pData != nullptr).Succeeded())
+      {
+        EZ_TEST_INT(pData->m_LightData.GetCount(), ezMath::Min(uiNumLights, 100u));
+      }
+
+      ezFrameAllocator::Reset();
+    }
+
+    *pMaxLights = iOldMaxLights;
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Cluster Item Limit")
+  {
+    ezExtractedRenderData extractedRenderData;
+    extractedRenderData.SetCamera(camera);
+
+    // more lights than a single cluster can hold, all at the same spot
+    for (ezUInt32 i = 0; i < 300; ++i)
+    {
+      auto pPointLight = ezCreateRenderDataForThisFrame<ezPointLightRenderData>(nullptr);
+      pPointLight->m_GlobalTransform.SetIdentity();
+      pPointLight->m_GlobalTransform.m_vPosition.Set(50.0f, 0.0f, 0.0f);
+      pPointLight->m_fRange = 5.0f;
+      pPointLight->m_LightColor = ezColor::White;
+      pPointLight->m_fIntensity = 1.0f;
+      pPointLight->m_uiShadowDataOffset = ezInvalidIndex;
+      extractedRenderData.AddRenderData(pPointLight, ezDefaultRenderDataCategories::Light);
+    }
+
+    extractedRenderData.SortAndBatch();
+    extractor.PostSortAndBatch(*pView, visibleObjects, extractedRenderData);
+
+    const ezClusteredDataCPU* pData = extractedRenderData.GetFrameData<ezClusteredDataCPU>();
+    if (EZ_TEST_BOOL(pData != nullptr).Succeeded())
+    {
+      EZ_TEST_INT(pData->m_LightData.GetCount(), 300);
+
+      ezUInt32 uiMaxLightCount = 0;
+      for (const auto& clusterData : pData->m_ClusterData)
+      {
+        uiMaxLightCount = ezMath::Max<ezUInt32>(uiMaxLightCount, GET_LIGHT_INDEX(clusterData.counts));
+      }
+
+      EZ_TEST_INT(uiMaxLightCount, ezClusteredDataCPU::MAX_ITEMS_PER_CLUSTER);
+    }
+
+    ezFrameAllocator::Reset();
+  }
+
+  EZ_TEST_BLOCK(EnableInRelease, "Profile 256 / 4k / 16k lights")
+  {
+    *pMaxLights = 16384;
+
+    for (ezUInt32 uiNumLights : {256u, 4096u, 16384u})
+    {
+      ezExtractedRenderData extractedRenderData;
+      extractedRenderData.SetCamera(camera);
+      AddLights(uiNumLights, extractedRenderData);
+
+      // warm up
+      extractor.PostSortAndBatch(*pView, visibleObjects, extractedRenderData);
+
+      ezStopwatch sw;
+      for (ezUInt32 i = 0; i < 10; ++i)
+      {
+        extractor.PostSortAndBatch(*pView, visibleObjects, extractedRenderData);
+      }
+
+      ezTestFramework::Output(ezTestOutput::Duration, "%u lights: %.2fms per view", uiNumLights, sw.GetRunningTotal().GetMilliseconds() / 10.0);
+
+      ezFrameAllocator::Reset();
+    }
+
+    *pMaxLights = iOldMaxLights;
+  }
+
+  ezRenderWorld::DeleteView(hView);
+
+  return ezTestAppRun::Quit;
+}
+
+static ezRendererTestExtraction g_Test;
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "../TestClass/TestClass.h"
+
+/// \brief Measures and verifies the extraction of render data, nothing is rendered.
+///
+/// A null graphics device is only set up because the high level systems of the renderer need one.
+class ezRendererTestExtraction : public ezGraphicsTest
+{
+public:
+  virtual const char* GetTestName() const override { return "Extraction"; }
+
+private:
+  enum SubTests
+  {
+    ST_VisibleObjects,
+    ST_ClusteredLights,
+  };
+
+  virtual void SetupSubTests() override
+  {
+    AddSubTest("Visible Objects", SubTests::ST_VisibleObjects);
+    AddSubTest("Clustered Lights", SubTests::ST_ClusteredLights);
+  }
+
+  virtual ezResult InitializeSubTest(ezInt32 iIdentifier) override;
+  virtual ezResult DeInitializeSubTest(ezInt32 iIdentifier) override;
+
+  ezTestAppRun SubtestVisibleObjects();
+  ezTestAppRun SubtestClusteredLights();
+
+  virtual ezTestAppRun RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount) override
+  {
+    if (iIdentifier == SubTests::ST_VisibleObjects)
+      return SubtestVisibleObjects();
+
+    if (iIdentifier == SubTests::ST_ClusteredLights)
+      return SubtestClusteredLights();
+
+    return ezTestAppRun::Quit;
+  }
+};
@@ -0,0 +1,164 @@
+#include <RendererTestPCH.h>
+
+#include <Core/Graphics/Geometry.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <RendererCore/Meshes/MeshBufferUtils.h>
+#include <RendererCore/Meshes/MeshResourceDescriptor.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Meshes);
+
+namespace
+{
+  bool AreTrianglesValid(ezArrayPtr<const ezUInt32> indices, ezUInt32 uiNumVertices)
+  {
+    for (ezUInt32 t = 0; t < indices.GetCount(); t += 3)
+    {
+      const ezUInt32 a = indices[t + 0];
+      const ezUInt32 b = indices[t + 1];
+      const ezUInt32 c = indices[t + 2];
+
+      if (a >= uiNumVertices || b >= uiNumVertices || c >= uiNumVertices)
+        return false;
+
+      if (a == b || b == c || c == a)
+        return false;
+    }
+
+    return true;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Meshes, MeshLod)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "SimplifyTriangles")
+  {
+    // a flat grid keeps its border and its area, no matter how many triangles are removed
+    const ezUInt32 uiGridSize = 20;
+
+    ezDynamicArray<ezVec3> positions;
+    for (ezUInt32 y = 0; y <= uiGridSize; ++y)
+    {
+      for (ezUInt32 x = 0; x <= uiGridSize; ++x)
+      {
+        positions.PushBack(ezVec3((float)x, (float)y, 0.0f));
+      }
+    }
+
+    ezDynamicArray<ezUInt32> indices;
+    for (ezUInt32 y = 0; y < uiGridSize; ++y)
+    {
+      for (ezUInt32 x = 0; x < uiGridSize; ++x)
+      {
+        const ezUInt32 i = y * (uiGridSize + 1) + x;
+
+        indices.PushBack(i);
+        indices.PushBack(i + 1);
+        indices.PushBack(i + uiGridSize + 2);
+
+        indices.PushBack(i);
+        indices.PushBack(i + uiGridSize + 2);
+        indices.PushBack(i + uiGridSize + 1);
+      }
+    }
+
+    ezDynamicArray<ezUInt32> simplified;
+    ezMeshBufferUtils::SimplifyTriangles(positions, indices, 100, 0.01f, simplified);
+
+    EZ_TEST_BOOL(simplified.GetCount() % 3 == 0);
+    EZ_TEST_BOOL(simplified.GetCount() / 3 < indices.GetCount() / 3 / 2);
+    EZ_TEST_BOOL(AreTrianglesValid(simplified, positions.GetCount()));
+
+    float fArea = 0.0f;
+    for (ezUInt32 t = 0; t < simplified.GetCount(); t += 3)
+    {
+      const ezVec3 vNormal = (positions[simplified[t + 1]] - positions[simplified[t + 0]]).CrossRH(positions[simplified[t + 2]] - positions[simplified[t + 0]]);
+
+      EZ_TEST_BOOL(vNormal.z > 0.0f);
+      fArea += vNormal.GetLength() * 0.5f;
+    }
+
+    EZ_TEST_FLOAT(fArea, (float)(uiGridSize * uiGridSize), 0.01f);
+
+    // a zero error threshold only allows collapses that do not change the surface at all
+    ezDynamicArray<ezUInt32> unchanged;
+    positions[(uiGridSize + 1) * 10 + 10].z = 1.0f;
+    ezMeshBufferUtils::SimplifyTriangles(positions, indices, 0, 0.0f, unchanged);
+    EZ_TEST_BOOL(AreTrianglesValid(unchanged, positions.GetCount()));
+    EZ_TEST_BOOL(unchanged.GetCount() > 6);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "GenerateLods")
+  {
+    ezGeometry geom;
+    geom.AddGeodesicSphere(1.0f, 4, ezColor::White);
+
+    ezMeshResourceDescriptor desc;
+    desc.MeshBufferDesc().AddCommonStreams();
+    desc.MeshBufferDesc().AllocateStreamsFromGeometry(geom, ezGALPrimitiveTopology::Triangles);
+    desc.AddSubMesh(desc.MeshBufferDesc().GetPrimitiveCount(), 0, 0);
+    desc.ComputeBounds();
+
+    const ezUInt32 uiBaseTriangles = desc.MeshBufferDesc().GetPrimitiveCount();
+
+    // the screen sizes must be distinct, descending and below 1
+    {
+      ezMuteLog logErrorSink;
+      ezLogSystemScope logScope(&logErrorSink);
+
+      const float ascendingScreenSizes[] = {0.2f, 0.5f};
+      EZ_TEST_BOOL(desc.GenerateLods(ezMakeArrayPtr(ascendingScreenSizes), 0.5f).Failed());
+
+      const float equalScreenSizes[] = {0.5f, 0.5f};
+      EZ_TEST_BOOL(desc.GenerateLods(ezMakeArrayPtr(equalScreenSizes), 0.5f).Failed());
+
+      const float fullScreenSizes[] = {1.0f, 0.5f};
+      EZ_TEST_BOOL(desc.GenerateLods(ezMakeArrayPtr(fullScreenSizes), 0.5f).Failed());
+
+      const float zeroScreenSizes[] = {0.5f, 0.0f};
+      EZ_TEST_BOOL(desc.GenerateLods(ezMakeArrayPtr(zeroScreenSizes), 0.5f).Failed());
+
+      EZ_TEST_BOOL(desc.GetLods().IsEmpty());
+    }
+
+    const float screenSizes[] = {0.5f, 0.25f, 0.1f};
+    EZ_TEST_BOOL(desc.GenerateLods(ezMakeArrayPtr(screenSizes), 0.5f).Succeeded());
+
+    ezArrayPtr<const ezMeshResourceDescriptor::LodLevel> lods = desc.GetLods();
+    ezArrayPtr<const ezMeshResourceDescriptor::SubMesh> subMeshes = desc.GetSubMeshes();
+
+    EZ_TEST_INT(lods.GetCount(), 4);
+    EZ_TEST_FLOAT(lods[0].m_fScreenSize, 1.0f, 0.0f);
+    EZ_TEST_INT(subMeshes.GetCount(), 4);
+
+    for (ezUInt32 i = 1; i < lods.GetCount(); ++i)
+    {
+      EZ_TEST_FLOAT(lods[i].m_fScreenSize, screenSizes[i - 1], 0.0f);
+      EZ_TEST_INT(lods[i].m_uiNumSubMeshes, 1);
+
+      const ezMeshResourceDescriptor::SubMesh& prev = subMeshes[lods[i - 1].m_uiFirstSubMesh];
+      const ezMeshResourceDescriptor::SubMesh& cur = subMeshes[lods[i].m_uiFirstSubMesh];
+
+      EZ_TEST_BOOL(cur.m_uiPrimitiveCount > 0);
+      EZ_TEST_BOOL(cur.m_uiPrimitiveCount <= prev.m_uiPrimitiveCount * 0.6f);
+      EZ_TEST_INT(cur.m_uiFirstPrimitive, prev.m_uiFirstPrimitive + prev.m_uiPrimitiveCount);
+    }
+
+    // all LODs share one index buffer
+    const ezMeshResourceDescriptor::SubMesh& lastSubMesh = subMeshes[subMeshes.GetCount() - 1];
+    EZ_TEST_INT(desc.MeshBufferDesc().GetPrimitiveCount(), lastSubMesh.m_uiFirstPrimitive + lastSubMesh.m_uiPrimitiveCount);
+    EZ_TEST_INT(subMeshes[0].m_uiPrimitiveCount, uiBaseTriangles);
+
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    ezMemoryStreamReader reader(&storage);
+
+    desc.Save(writer);
+
+    ezMeshResourceDescriptor loaded;
+    EZ_TEST_BOOL(loaded.Load(reader).Succeeded());
+    EZ_TEST_INT(loaded.GetLods().GetCount(), 4);
+    EZ_TEST_INT(loaded.GetSubMeshes().GetCount(), 4);
+    EZ_TEST_FLOAT(loaded.GetLods()[2].m_fScreenSize, 0.25f, 0.0f);
+    EZ_TEST_INT(loaded.MeshBufferDesc().GetPrimitiveCount(), desc.MeshBufferDesc().GetPrimitiveCount());
+  }
+}
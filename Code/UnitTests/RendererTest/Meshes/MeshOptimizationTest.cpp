@@ -0,0 +1,152 @@
+#include <RendererTestPCH.h>
+
+#include <Core/Graphics/Geometry.h>
+#include <RendererCore/Meshes/MeshBufferResource.h>
+#include <RendererCore/Meshes/MeshBufferUtils.h>
+
+EZ_CREATE_SIMPLE_TEST(Meshes, VertexOrder)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "OptimizeVertexOrder")
+  {
+    ezGeometry geom;
+    geom.AddGeodesicSphere(1.0f, 4, ezColor::White);
+    geom.AddBox(ezVec3(1.0f), ezColor::White);
+
+    ezMeshBufferResourceDescriptor desc;
+    desc.AddCommonStreams();
+    desc.AllocateStreamsFromGeometry(geom, ezGALPrimitiveTopology::Triangles);
+
+    const ezUInt32 uiNumTriangles = desc.GetPrimitiveCount();
+    const ezUInt32 uiBoxStart = uiNumTriangles - 12;
+
+    // shuffle the triangles to simulate a badly ordered import
+    ezDynamicArray<ezUInt32> indices;
+    for (ezUInt32 t = 0; t < uiNumTriangles; ++t)
+    {
+      const ezUInt16* pIndices = reinterpret_cast<const ezUInt16*>(desc.GetIndexBufferData().GetData()) + t * 3;
+      indices.PushBack(pIndices[0]);
+      indices.PushBack(pIndices[1]);
+      indices.PushBack(pIndices[2]);
+    }
+
+    for (ezUInt32 t = 0; t < uiBoxStart; ++t)
+    {
+      const ezUInt32 uiOther = (t * 7919) % uiBoxStart;
+      desc.SetTriangleIndices(t, indices[uiOther * 3 + 0], indices[uiOther * 3 + 1], indices[uiOther * 3 + 2]);
+    }
+
+    auto CountOutwardBoxTriangles = [&]() {
+      const ezUInt16* pIndices = reinterpret_cast<const ezUInt16*>(desc.GetIndexBufferData().GetData());
+      ezUInt32 uiNumOutward = 0;
+
+      for (ezUInt32 t = uiBoxStart; t < uiNumTriangles; ++t)
+      {
+        const ezVec3 p0 = *reinterpret_cast<const ezVec3*>(desc.GetVertexData(0, pIndices[t * 3 + 0]).GetPtr());
+        const ezVec3 p1 = *reinterpret_cast<const ezVec3*>(desc.GetVertexData(0, pIndices[t * 3 + 1]).GetPtr());
+        const ezVec3 p2 = *reinterpret_cast<const ezVec3*>(desc.GetVertexData(0, pIndices[t * 3 + 2]).GetPtr());
+
+        // only box vertices may be referenced
+        EZ_TEST_FLOAT(ezMath::Abs(p0.x), 0.5f, 0.0001f);
+        EZ_TEST_FLOAT(ezMath::Abs(p1.y), 0.5f, 0.0001f);
+        EZ_TEST_FLOAT(ezMath::Abs(p2.z), 0.5f, 0.0001f);
+
+        if ((p1 - p0).CrossRH(p2 - p0).Dot(p0 + p1 + p2) > 0.0f)
+          ++uiNumOutward;
+      }
+
+      return uiNumOutward;
+    };
+
+    const ezUInt32 uiNumOutwardBefore = CountOutwardBoxTriangles();
+    const ezBoundingBoxSphere boundsBefore = desc.ComputeBounds();
+
+    const ezUInt32 rangeStarts[] = {uiBoxStart};
+    float fAcmrBefore = 0.0f;
+    float fAcmrAfter = 0.0f;
+    EZ_TEST_BOOL(desc.OptimizeVertexOrder(ezMakeArrayPtr(rangeStarts), fAcmrBefore, fAcmrAfter).Succeeded());
+
+    EZ_TEST_BOOL(fAcmrAfter < fAcmrBefore);
+    EZ_TEST_BOOL(fAcmrAfter < 1.0f);
+
+    const ezBoundingBoxSphere boundsAfter = desc.ComputeBounds();
+    EZ_TEST_VEC3(boundsAfter.m_vCenter, boundsBefore.m_vCenter, 0.0f);
+
+    // the box must still be made of the last 12 triangles, with the same winding
+    EZ_TEST_INT(CountOutwardBoxTriangles(), uiNumOutwardBefore);
+    EZ_TEST_BOOL(uiNumOutwardBefore == 0 || uiNumOutwardBefore == 12);
+
+    ezLog::Info("ACMR before: {0}, after: {1}", ezArgF(fAcmrBefore, 3), ezArgF(fAcmrAfter, 3));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "OptimizeOverdraw")
+  {
+    // the inner sphere comes first, so it would be drawn before the outer sphere that hides it
+    ezGeometry geom;
+    geom.AddGeodesicSphere(0.5f, 3, ezColor::White);
+    geom.AddGeodesicSphere(1.0f, 3, ezColor::White);
+
+    ezMeshBufferResourceDescriptor desc;
+    desc.AddCommonStreams();
+    desc.AllocateStreamsFromGeometry(geom, ezGALPrimitiveTopology::Triangles);
+
+    const ezUInt32 uiNumVertices = desc.GetVertexCount();
+    const ezUInt32 uiNumTriangles = desc.GetPrimitiveCount();
+
+    ezDynamicArray<ezVec3> positions;
+    for (ezUInt32 v = 0; v < uiNumVertices; ++v)
+    {
+      positions.PushBack(*reinterpret_cast<const ezVec3*>(desc.GetVertexData(0, v).GetPtr()));
+    }
+
+    ezDynamicArray<ezUInt32> indices;
+    const ezUInt16* pIndices = reinterpret_cast<const ezUInt16*>(desc.GetIndexBufferData().GetData());
+    for (ezUInt32 i = 0; i < uiNumTriangles * 3; ++i)
+    {
+      indices.PushBack(pIndices[i]);
+    }
+
+    ezMeshBufferUtils::OptimizeVertexCache(indices, uiNumVertices);
+    const float fAcmrBefore = ezMeshBufferUtils::ComputeAcmr(indices, uiNumVertices);
+
+    // triangles are only moved as a whole, so sorting the rotated triangles must give the same list
+    auto GetSortedTriangles = [&]() {
+      ezDynamicArray<ezVec3U32> triangles;
+      for (ezUInt32 t = 0; t < uiNumTriangles; ++t)
+      {
+        ezVec3U32 triangle(indices[t * 3 + 0], indices[t * 3 + 1], indices[t * 3 + 2]);
+        while (triangle.x > triangle.y || triangle.x > triangle.z)
+        {
+          triangle.Set(triangle.y, triangle.z, triangle.x);
+        }
+        triangles.PushBack(triangle);
+      }
+
+      triangles.Sort([](const ezVec3U32& lhs, const ezVec3U32& rhs) -> bool {
+        if (lhs.x != rhs.x)
+          return lhs.x < rhs.x;
+        if (lhs.y != rhs.y)
+          return lhs.y < rhs.y;
+        return lhs.z < rhs.z;
+      });
+
+      return triangles;
+    };
+
+    const ezDynamicArray<ezVec3U32> trianglesBefore = GetSortedTriangles();
+
+    ezMeshBufferUtils::OptimizeOverdraw(positions, indices);
+
+    const float fAcmrAfter = ezMeshBufferUtils::ComputeAcmr(indices, uiNumVertices);
+    EZ_TEST_BOOL(fAcmrAfter <= fAcmrBefore * 1.1f);
+
+    EZ_TEST_BOOL(GetSortedTriangles() == trianglesBefore);
+
+    // now all triangles of the outer sphere must come first
+    for (ezUInt32 t = 0; t < uiNumTriangles / 2; ++t)
+    {
+      EZ_TEST_FLOAT(positions[indices[t * 3]].GetLength(), 1.0f, 0.001f);
+    }
+
+    ezLog::Info("ACMR before overdraw optimization: {0}, after: {1}", ezArgF(fAcmrBefore, 3), ezArgF(fAcmrAfter, 3));
+  }
+}
@@ -0,0 +1,201 @@
+#include <RendererTestPCH.h>
+
+#include "NullDeviceTest.h"
+#include <Foundation/Time/Stopwatch.h>
+#include <RendererFoundation/Context/Context.h>
+#include <RendererNull/Context/ContextNull.h>
+#include <RendererNull/Device/DeviceNull.h>
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+static const ezTestBlock::Enum EnableInRelease = ezTestBlock::DisabledNoWarning;
+#else
+static const ezTestBlock::Enum EnableInRelease = ezTestBlock::Enabled;
+#endif
+
+ezResult ezRendererTestNullDevice::InitializeSubTest(ezInt32 iIdentifier)
+{
+  if (ezGraphicsTest::InitializeSubTest(iIdentifier).Failed())
+    return EZ_FAILURE;
+
+  if (SetupNullRenderer().Failed())
+    return EZ_FAILURE;
+
+  m_hVertexBuffer[0] = m_pDevice->CreateVertexBuffer(sizeof(ezVec3), 36);
+  m_hVertexBuffer[1] = m_pDevice->CreateVertexBuffer(sizeof(ezVec3), 36);
+  m_hIndexBuffer = m_pDevice->CreateIndexBuffer(ezGALIndexType::UShort, 36);
+  m_hConstantBuffer = m_pDevice->CreateConstantBuffer(sizeof(ObjectCB));
+
+  ezGALBlendStateCreationDescription blendDesc;
+  m_hBlendState[0] = m_pDevice->CreateBlendState(blendDesc);
+
+  blendDesc.m_RenderTargetBlendDescriptions[0].m_bBlendingEnabled = true;
+  m_hBlendState[1] = m_pDevice->CreateBlendState(blendDesc);
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezRendererTestNullDevice::DeInitializeSubTest(ezInt32 iIdentifier)
+{
+  m_pDevice->DestroyBlendState(m_hBlendState[0]);
+  m_pDevice->DestroyBlendState(m_hBlendState[1]);
+  m_pDevice->DestroyBuffer(m_hConstantBuffer);
+  m_pDevice->DestroyBuffer(m_hIndexBuffer);
+  m_pDevice->DestroyBuffer(m_hVertexBuffer[0]);
+  m_pDevice->DestroyBuffer(m_hVertexBuffer[1]);
+
+  ShutdownRenderer();
+
+  return ezGraphicsTest::DeInitializeSubTest(iIdentifier);
+}
+
+void ezRendererTestNullDevice::SubmitPass(const char* szPass, ezUInt32 uiNumDraws, ezUInt32 uiBlendState)
+{
+  ezGALContext* pContext = m_pDevice->GetPrimaryContext();
+
+  ObjectCB cb;
+  cb.m_MVP.SetIdentity();
+  cb.m_Color = ezColor::White;
+
+  pContext->PushMarker(szPass);
+
+  // same pattern as a typical render data batch: the mesh changes for every draw, the material only once per pass
+  for (ezUInt32 i = 0; i < uiNumDraws; ++i)
+  {
+    pContext->SetBlendState(m_hBlendState[uiBlendState]);
+    pContext->SetIndexBuffer(m_hIndexBuffer);
+    pContext->SetVertexBuffer(0, m_hVertexBuffer[i & 1]);
+    pContext->SetConstantBuffer(0, m_hConstantBuffer);
+    pContext->UpdateBuffer(m_hConstantBuffer, 0, ezMakeArrayPtr(reinterpret_cast<const ezUInt8*>(&cb), sizeof(ObjectCB)));
+    pContext->DrawIndexed(36, 0);
+  }
+
+  pContext->PopMarker();
+}
+
+ezTestAppRun ezRendererTestNullDevice::SubtestCommandLog()
+{
+  ezGALNullCommandLog& log = static_cast<ezGALDeviceNull*>(m_pDevice)->GetNullContext()->GetCommandLog();
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Counters")
+  {
+    log.Clear();
+
+    m_pDevice->BeginFrame();
+    SubmitPass("Opaque", 10, 0);
+    SubmitPass("Transparent", 4, 1);
+    m_pDevice->EndFrame();
+
+    EZ_TEST_INT(log.GetDrawCallCount(), 14);
+    EZ_TEST_INT(log.GetCommandCount(ezGALNullCommandType::DrawIndexed), 14);
+    EZ_TEST_INT(log.GetCommandCount(ezGALNullCommandType::UpdateBuffer), 14);
+    EZ_TEST_INT(log.GetBytesTransferred(), 14 * sizeof(ObjectCB));
+
+    // redundant state changes are filtered by ezGALContext and never reach the device
+    EZ_TEST_INT(log.GetCommandCount(ezGALNullCommandType::SetVertexBuffer), 14);
+    EZ_TEST_INT(log.GetCommandCount(ezGALNullCommandType::SetIndexBuffer), 1);
+    EZ_TEST_INT(log.GetCommandCount(ezGALNullCommandType::SetConstantBuffer), 1);
+    EZ_TEST_INT(log.GetCommandCount(ezGALNullCommandType::SetBlendState), 2);
+    EZ_TEST_INT(log.GetStateChangeCount(), 18);
+
+    EZ_TEST_BOOL(log.GetCommands().IsEmpty());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Markers")
+  {
+    log.Clear();
+
+    ezGALContext* pContext = m_pDevice->GetPrimaryContext();
+
+    m_pDevice->BeginFrame();
+    pContext->PushMarker("Frame");
+    SubmitPass("Opaque", 10, 0);
+    SubmitPass("Transparent", 4, 1);
+    SubmitPass("Opaque", 6, 0);
+    pContext->PopMarker();
+    m_pDevice->EndFrame();
+
+    const ezGALNullMarkerStatistics* pFrame = log.GetMarkerStatistics("Frame");
+    const ezGALNullMarkerStatistics* pOpaque = log.GetMarkerStatistics("Opaque");
+    const ezGALNullMarkerStatistics* pTransparent = log.GetMarkerStatistics("Transparent");
+
+    if (EZ_TEST_BOOL(pFrame != nullptr && pOpaque != nullptr && pTransparent != nullptr).Succeeded())
+    {
+      // nested markers count towards their parents, markers with the same name are accumulated
+      EZ_TEST_INT(pFrame->m_uiDrawCalls, 20);
+      EZ_TEST_INT(pOpaque->m_uiDrawCalls, 16);
+      EZ_TEST_INT(pTransparent->m_uiDrawCalls, 4);
+
+      EZ_TEST_INT(pOpaque->m_uiBytesTransferred, 16 * sizeof(ObjectCB));
+      EZ_TEST_INT(pTransparent->m_uiStateChanges, 5);
+      EZ_TEST_INT(pFrame->m_uiStateChanges, log.GetStateChangeCount());
+    }
+
+    EZ_TEST_BOOL(log.GetMarkerStatistics("Shadows") == nullptr);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Recorded Commands")
+  {
+    log.Clear();
+    log.SetRecordCommands(true);
+
+    m_pDevice->BeginFrame();
+    SubmitPass("Opaque", 3, 0);
+    m_pDevice->EndFrame();
+
+    log.SetRecordCommands(false);
+
+    ezUInt32 uiNumDraws = 0;
+    for (const ezGALNullCommand& command : log.GetCommands())
+    {
+      EZ_TEST_STRING(log.GetMarkerName(command.m_uiMarker), "Opaque");
+
+      if (command.m_Type == ezGALNullCommandType::DrawIndexed)
+      {
+        EZ_TEST_INT(command.m_uiElementCount, 36);
+        ++uiNumDraws;
+      }
+    }
+
+    EZ_TEST_INT(uiNumDraws, 3);
+    EZ_TEST_INT(log.GetCommands().GetCount(), log.GetDrawCallCount() + log.GetStateChangeCount() + 3);
+  }
+
+  return ezTestAppRun::Quit;
+}
+
+ezTestAppRun ezRendererTestNullDevice::SubtestSubmissionCost()
+{
+  ezGALNullCommandLog& log = static_cast<ezGALDeviceNull*>(m_pDevice)->GetNullContext()->GetCommandLog();
+
+  EZ_TEST_BLOCK(EnableInRelease, "Profile 100000 draws")
+  {
+    const ezUInt32 uiNumDraws = 100000;
+
+    for (bool bRecord : {false, true})
+    {
+      log.Clear();
+      log.SetRecordCommands(bRecord);
+
+      ezStopwatch sw;
+
+      m_pDevice->BeginFrame();
+      SubmitPass("Opaque", uiNumDraws / 2, 0);
+      SubmitPass("Transparent", uiNumDraws / 2, 1);
+      m_pDevice->EndFrame();
+
+      const ezTime t = sw.GetRunningTotal();
+
+      EZ_TEST_INT(log.GetDrawCallCount(), uiNumDraws);
+
+      ezTestFramework::Output(ezTestOutput::Duration, "Submission %s recording: %.2fms, %.1fns per draw", bRecord ? "with" : "without",
+        t.GetMilliseconds(), t.GetNanoseconds() / uiNumDraws);
+    }
+
+    log.SetRecordCommands(false);
+    log.Clear();
+  }
+
+  return ezTestAppRun::Quit;
+}
+
+static ezRendererTestNullDevice g_Test;
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "../TestClass/TestClass.h"
+
+/// \brief Verifies what the GAL submits to the null device and measures the CPU cost of the submission.
+class ezRendererTestNullDevice : public ezGraphicsTest
+{
+public:
+  virtual const char* GetTestName() const override { return "Null Device"; }
+
+private:
+  enum SubTests
+  {
+    ST_CommandLog,
+    ST_SubmissionCost,
+  };
+
+  virtual void SetupSubTests() override
+  {
+    AddSubTest("Command Log", SubTests::ST_CommandLog);
+    AddSubTest("Submission Cost", SubTests::ST_SubmissionCost);
+  }
+
+  virtual ezResult InitializeSubTest(ezInt32 iIdentifier) override;
+  virtual ezResult DeInitializeSubTest(ezInt32 iIdentifier) override;
+
+  ezTestAppRun SubtestCommandLog();
+  ezTestAppRun SubtestSubmissionCost();
+
+  virtual ezTestAppRun RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount) override
+  {
+    if (iIdentifier == SubTests::ST_CommandLog)
+      return SubtestCommandLog();
+
+    if (iIdentifier == SubTests::ST_SubmissionCost)
+      return SubtestSubmissionCost();
+
+    return ezTestAppRun::Quit;
+  }
+
+  void SubmitPass(const char* szPass, ezUInt32 uiNumDraws, ezUInt32 uiBlendState);
+
+  ezGALBufferHandle m_hVertexBuffer[2];
+  ezGALBufferHandle m_hIndexBuffer;
+  ezGALBufferHandle m_hConstantBuffer;
+  ezGALBlendStateHandle m_hBlendState[2];
+};
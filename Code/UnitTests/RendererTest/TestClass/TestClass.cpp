@@ -14,6 +14,7 @@
 #include <RendererCore/Shader/ShaderResource.h>
 #include <RendererCore/ShaderCompiler/ShaderManager.h>
 #include <RendererDX11/Device/DeviceDX11.h>
+#include <RendererNull/Device/DeviceNull.h>
 #include <RendererFoundation/Context/Context.h>
 #include <RendererFoundation/Device/SwapChain.h>
 
@@ -45,30 +46,36 @@ ezSizeU32 ezGraphicsTest::GetResolution() const
   return m_pWindow->GetClientAreaSize();
 }
 
-ezResult ezGraphicsTest::SetupRenderer(ezUInt32 uiResolutionX, ezUInt32 uiResolutionY)
+ezResult ezGraphicsTest::SetupDataDirectories()
 {
-  {
-    ezFileSystem::SetSpecialDirectory("testout", ezTestFramework::GetInstance()->GetAbsOutputPath());
+  ezFileSystem::SetSpecialDirectory("testout", ezTestFramework::GetInstance()->GetAbsOutputPath());
 
-    ezStringBuilder sBaseDir = ">sdk/Data/Base/";
-    ezStringBuilder sReadDir(">sdk/", ezTestFramework::GetInstance()->GetRelTestDataPath());
-    sReadDir.PathParentDirectory();
+  ezStringBuilder sBaseDir = ">sdk/Data/Base/";
+  ezStringBuilder sReadDir(">sdk/", ezTestFramework::GetInstance()->GetRelTestDataPath());
+  sReadDir.PathParentDirectory();
 
-    ezFileSystem::AddDataDirectory(">appdir/", "ShaderCache", "shadercache", ezFileSystem::AllowWrites); // for shader files
+  ezFileSystem::AddDataDirectory(">appdir/", "ShaderCache", "shadercache", ezFileSystem::AllowWrites); // for shader files
+
+  if (ezFileSystem::AddDataDirectory(sBaseDir, "Base").Failed())
+    return EZ_FAILURE;
 
-    if (ezFileSystem::AddDataDirectory(sBaseDir, "Base").Failed())
-      return EZ_FAILURE;
+  if (ezFileSystem::AddDataDirectory(">eztest/", "ImageComparisonDataDir", "imgout", ezFileSystem::AllowWrites).Failed())
+    return EZ_FAILURE;
 
-    if (ezFileSystem::AddDataDirectory(">eztest/", "ImageComparisonDataDir", "imgout", ezFileSystem::AllowWrites).Failed())
-      return EZ_FAILURE;
+  if (ezFileSystem::AddDataDirectory(sReadDir, "UnitTestData").Failed())
+    return EZ_FAILURE;
 
-    if (ezFileSystem::AddDataDirectory(sReadDir, "UnitTestData").Failed())
-      return EZ_FAILURE;
+  sReadDir.Set(">sdk/", ezTestFramework::GetInstance()->GetRelTestDataPath());
+  if (ezFileSystem::AddDataDirectory(sReadDir, "ImageComparisonDataDir").Failed())
+    return EZ_FAILURE;
 
-    sReadDir.Set(">sdk/", ezTestFramework::GetInstance()->GetRelTestDataPath());
-    if (ezFileSystem::AddDataDirectory(sReadDir, "ImageComparisonDataDir").Failed())
-      return EZ_FAILURE;
-  }
+  return EZ_SUCCESS;
+}
+
+ezResult ezGraphicsTest::SetupRenderer(ezUInt32 uiResolutionX, ezUInt32 uiResolutionY)
+{
+  if (SetupDataDirectories().Failed())
+    return EZ_FAILURE;
 
   // Create a window for rendering
   ezWindowCreationDesc WindowCreationDesc;
@@ -130,6 +137,30 @@ ezResult ezGraphicsTest::SetupRenderer(ezUInt32 uiResolutionX, ezUInt32 uiResolu
   return EZ_SUCCESS;
 }
 
+ezResult ezGraphicsTest::SetupNullRenderer()
+{
+  if (SetupDataDirectories().Failed())
+    return EZ_FAILURE;
+
+  // Create a device without a window, nothing is ever presented
+  ezGALDeviceCreationDescription DeviceInit;
+  DeviceInit.m_bCreatePrimarySwapChain = false;
+  DeviceInit.m_bDebugDevice = false;
+
+  m_pDevice = EZ_DEFAULT_NEW(ezGALDeviceNull, DeviceInit);
+
+  if (m_pDevice->Init().Failed())
+    return EZ_FAILURE;
+
+  ezGALDevice::SetDefaultDevice(m_pDevice);
+
+  m_hObjectTransformCB = ezRenderContext::CreateConstantBufferStorage<ObjectCB>();
+
+  ezStartup::StartupHighLevelSystems();
+
+  return EZ_SUCCESS;
+}
+
 void ezGraphicsTest::ShutdownRenderer()
 {
   m_hShader.Invalidate();
@@ -143,8 +174,11 @@ void ezGraphicsTest::ShutdownRenderer()
 
   if (m_pDevice)
   {
-    m_pDevice->DestroyTexture(m_hDepthStencilTexture);
-    m_hDepthStencilTexture.Invalidate();
+    if (!m_hDepthStencilTexture.IsInvalidated())
+    {
+      m_pDevice->DestroyTexture(m_hDepthStencilTexture);
+      m_hDepthStencilTexture.Invalidate();
+    }
 
     m_pDevice->Shutdown();
     EZ_DEFAULT_DELETE(m_pDevice);
@@ -36,7 +36,14 @@ protected:
   ezSizeU32 GetResolution() const;
 
 protected:
+  ezResult SetupDataDirectories();
   ezResult SetupRenderer(ezUInt32 uiResolutionX = 960, ezUInt32 uiResolutionY = 540);
+
+  /// \brief Sets up the high level renderer on top of an ezGALDeviceNull, without a window, a swap chain or any shaders.
+  ///
+  /// Use this for tests that only measure or verify what the CPU side of the renderer submits.
+  ezResult SetupNullRenderer();
+
   void ShutdownRenderer();
   void ClearScreen(const ezColor& color = ezColor::Black);
 
@@ -0,0 +1,176 @@
+#include <TypeScriptPluginTestPCH.h>
+
+#include <Core/Scripting/DuktapeContext.h>
+#include <Foundation/Time/Time.h>
+#include <TypeScriptPlugin/TsBinding/TsBinding.h>
+
+#include <Duktape/duktape.h>
+
+struct ezMsgTypeScriptSyncTest : public ezMessage
+{
+  EZ_DECLARE_MESSAGE_TYPE(ezMsgTypeScriptSyncTest, ezMessage);
+
+  float m_fValue = 0.0f;
+  bool m_bFlag = false;
+  ezInt32 m_iCount = 0;
+  ezVec3 m_vPosition = ezVec3::ZeroVector();
+  ezQuat m_qRotation = ezQuat::IdentityQuaternion();
+  ezColor m_Color = ezColor::White;
+  ezMat3 m_mScale = ezMat3(2, 0, 0, 0, 2, 0, 0, 0, 2);
+};
+
+// clang-format off
+EZ_IMPLEMENT_MESSAGE_TYPE(ezMsgTypeScriptSyncTest);
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezMsgTypeScriptSyncTest, 1, ezRTTIDefaultAllocator<ezMsgTypeScriptSyncTest>)
+{
+  EZ_BEGIN_PROPERTIES
+  {
+    EZ_MEMBER_PROPERTY("Value", m_fValue),
+    EZ_MEMBER_PROPERTY("Flag", m_bFlag),
+    EZ_MEMBER_PROPERTY("Count", m_iCount),
+    EZ_MEMBER_PROPERTY("Position", m_vPosition),
+    EZ_MEMBER_PROPERTY("Rotation", m_qRotation),
+    EZ_MEMBER_PROPERTY("Color", m_Color),
+    EZ_MEMBER_PROPERTY("Scale", m_mScale)->AddAttributes(new ezDefaultValueAttribute(ezMat3(2, 0, 0, 0, 2, 0, 0, 0, 2))),
+  }
+  EZ_END_PROPERTIES;
+}
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+namespace
+{
+  // mirrors the math classes and the message class that are generated for TypeScript
+  const char* s_szSyncTestScript = R"(
+var __Vec3 = { Vec3: function(x, y, z) { this.x = x; this.y = y; this.z = z; } };
+var __Quat = { Quat: function(x, y, z, w) { this.x = x; this.y = y; this.z = z; this.w = w; } };
+var __Color = { Color: function(r, g, b, a) { this.r = r; this.g = g; this.b = b; this.a = a; } };
+var __Mat3 = { Mat3: function() {
+  var e = (arguments.length == 9) ? arguments : [1, 0, 0, 0, 1, 0, 0, 0, 1];
+  this.m_ElementsCM = [e[0], e[3], e[6], e[1], e[4], e[7], e[2], e[5], e[8]];
+} };
+
+function MsgTypeScriptSyncTest() {
+  this.Value = 0;
+  this.Flag = false;
+  this.Count = 0;
+  this.Position = new __Vec3.Vec3(0, 0, 0);
+  this.Rotation = new __Quat.Quat(0, 0, 0, 1);
+  this.Color = new __Color.Color(1, 1, 1, 1);
+  this.Scale = new __Mat3.Mat3(); // matrices are always default constructed, independent of the default value in C++
+}
+)";
+
+  void PushNewTsMessage(ezDuktapeContext& duk)
+  {
+    duk.PushGlobalObject();                                // [ global ]
+    duk_get_prop_string(duk, -1, "MsgTypeScriptSyncTest"); // [ global ctor ]
+    duk_new(duk, 0);                                       // [ global msg ]
+    duk_remove(duk, -2);                                   // [ msg ]
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST_GROUP(TypeScript);
+
+EZ_CREATE_SIMPLE_TEST(TypeScript, PropertySync)
+{
+  const ezRTTI* pRtti = ezGetStaticRTTI<ezMsgTypeScriptSyncTest>();
+
+  ezDuktapeContext duk("TypeScriptSyncTest");
+  EZ_TEST_BOOL(duk.ExecuteString(s_szSyncTestScript).Succeeded());
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Ez to TS")
+  {
+    ezMsgTypeScriptSyncTest msg;
+    msg.m_fValue = 5.0f;
+    msg.m_iCount = 3;
+    msg.m_vPosition.Set(1, 2, 3);
+
+    for (bool bTsObjectIsDefault : {false, true})
+    {
+      PushNewTsMessage(duk);                    // [ msg ]
+      duk_get_prop_string(duk, -1, "Position"); // [ msg pos ]
+      duk_get_prop_string(duk, -2, "Rotation"); // [ msg pos rot ]
+
+      ezTypeScriptBinding::SyncEzObjectToTsObject(duk, pRtti, &msg, -3, bTsObjectIsDefault);
+
+      EZ_TEST_FLOAT(duk.GetFloatProperty("Value", 0, -3), 5.0f, 0.0f);
+      EZ_TEST_INT(duk.GetIntProperty("Count", 0, -3), 3);
+      EZ_TEST_BOOL(duk.GetBoolProperty("Flag", true, -3) == false);
+      EZ_TEST_VEC3(ezTypeScriptBinding::GetVec3Property(duk, "Position", -3), ezVec3(1, 2, 3), 0.0f);
+      EZ_TEST_BOOL(ezTypeScriptBinding::GetQuatProperty(duk, "Rotation", -3) == ezQuat::IdentityQuaternion());
+      EZ_TEST_BOOL(ezTypeScriptBinding::GetColorProperty(duk, "Color", -3, ezColor::Black) == ezColor::White);
+      EZ_TEST_BOOL(ezTypeScriptBinding::GetMat3Property(duk, "Scale", -3).IsEqual(msg.m_mScale, 0.0f));
+
+      duk_get_prop_string(duk, -3, "Position"); // [ msg pos rot pos2 ]
+      duk_get_prop_string(duk, -4, "Rotation"); // [ msg pos rot pos2 rot2 ]
+
+      // a freshly created object gets updated in place and untouched properties are skipped entirely
+      EZ_TEST_BOOL(duk_strict_equals(duk, -4, -2) == bTsObjectIsDefault);
+      EZ_TEST_BOOL(duk_strict_equals(duk, -3, -1) == bTsObjectIsDefault);
+
+      duk.PopStack(5); // [ ]
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "TS to Ez")
+  {
+    EZ_TEST_BOOL(duk.ExecuteString("var tsMsg = new MsgTypeScriptSyncTest(); tsMsg.Value = 2.5; tsMsg.Flag = true; tsMsg.Count = 7; "
+                                   "tsMsg.Position.y = 4; tsMsg.Rotation = new __Quat.Quat(0, 0, 1, 0); tsMsg.Color.g = 0;")
+                   .Succeeded());
+
+    ezMsgTypeScriptSyncTest msg;
+
+    duk.PushGlobalObject();                // [ global ]
+    duk_get_prop_string(duk, -1, "tsMsg"); // [ global msg ]
+    ezTypeScriptBinding::SyncTsObjectEzTsObject(duk, pRtti, &msg, -1);
+    duk.PopStack(2); // [ ]
+
+    EZ_TEST_FLOAT(msg.m_fValue, 2.5f, 0.0f);
+    EZ_TEST_BOOL(msg.m_bFlag);
+    EZ_TEST_INT(msg.m_iCount, 7);
+    EZ_TEST_VEC3(msg.m_vPosition, ezVec3(0, 4, 0), 0.0f);
+    EZ_TEST_BOOL(msg.m_qRotation == ezQuat(0, 0, 1, 0));
+    EZ_TEST_BOOL(msg.m_Color == ezColor(1, 0, 1, 1));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Benchmark")
+  {
+    // one message per component and frame, sent to TS and synchronized back afterwards, like a message handler with results
+    const ezUInt32 uiNumComponents = 1000;
+    const ezUInt32 uiNumFrames = 10;
+
+    ezDynamicArray<ezMsgTypeScriptSyncTest> messages;
+    messages.SetCount(uiNumComponents);
+
+    for (ezUInt32 i = 0; i < uiNumComponents; ++i)
+    {
+      messages[i].m_vPosition.Set(static_cast<float>(i), 0, 0);
+    }
+
+    ezTime tElapsed[2];
+
+    for (bool bTsObjectIsDefault : {false, true})
+    {
+      const ezTime tStart = ezTime::Now();
+
+      for (ezUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+      {
+        for (auto& msg : messages)
+        {
+          PushNewTsMessage(duk); // [ msg ]
+          ezTypeScriptBinding::SyncEzObjectToTsObject(duk, pRtti, &msg, -1, bTsObjectIsDefault);
+          ezTypeScriptBinding::SyncTsObjectEzTsObject(duk, pRtti, &msg, -1);
+          duk.PopStack(); // [ ]
+        }
+      }
+
+      tElapsed[bTsObjectIsDefault ? 1 : 0] = (ezTime::Now() - tStart) / static_cast<double>(uiNumFrames);
+    }
+
+    EZ_TEST_VEC3(messages.PeekBack().m_vPosition, ezVec3(uiNumComponents - 1.0f, 0, 0), 0.0f);
+
+    ezLog::Info("[test]Property sync of {0} components per frame: full {1}ms, skipping defaults {2}ms", uiNumComponents,
+      ezArgF(tElapsed[0].GetMilliseconds(), 2), ezArgF(tElapsed[1].GetMilliseconds(), 2));
+  }
+}
@@ -0,0 +1 @@
+#include <TypeScriptPluginTestPCH.h>
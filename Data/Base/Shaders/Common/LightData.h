@@ -129,9 +129,9 @@ CONSTANT_BUFFER(ezClusteredDataConstants, 3)
 #define NUM_CLUSTERS_XY (NUM_CLUSTERS_X * NUM_CLUSTERS_Y)
 #define NUM_CLUSTERS (NUM_CLUSTERS_X * NUM_CLUSTERS_Y * NUM_CLUSTERS_Z)
 
-#define LIGHT_BITMASK 0x3FF
-#define DECAL_SHIFT 10
-#define DECAL_BITMASK 0x3FF
+#define LIGHT_BITMASK 0xFFFF
+#define DECAL_SHIFT 16
+#define DECAL_BITMASK 0xFFFF
 
 #define GET_LIGHT_INDEX(index) (index & LIGHT_BITMASK)
 #define GET_DECAL_INDEX(index) ((index >> DECAL_SHIFT) & DECAL_BITMASK)